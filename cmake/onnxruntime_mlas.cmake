@@ -15,11 +15,16 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/platform.cpp
   ${MLAS_SRC_DIR}/threading.cpp
   ${MLAS_SRC_DIR}/sgemm.cpp
+  ${MLAS_SRC_DIR}/lora_sgmv.cpp
+  ${MLAS_SRC_DIR}/sparse_sgemm.h
+  ${MLAS_SRC_DIR}/sparse_sgemm.cpp
   ${MLAS_SRC_DIR}/halfgemm.cpp
   ${MLAS_SRC_DIR}/qgemm.cpp
   ${MLAS_SRC_DIR}/qdwconv.cpp
   ${MLAS_SRC_DIR}/convolve.cpp
   ${MLAS_SRC_DIR}/convsym.cpp
+  ${MLAS_SRC_DIR}/sconv_indirect.cpp
+  ${MLAS_SRC_DIR}/sconv_winograd.cpp
   ${MLAS_SRC_DIR}/pooling.cpp
   ${MLAS_SRC_DIR}/transpose.cpp
   ${MLAS_SRC_DIR}/reorder.cpp
@@ -41,8 +46,10 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/qdwconv_kernelsize.cpp
   ${MLAS_SRC_DIR}/qnbitgemm.h
   ${MLAS_SRC_DIR}/qnbitgemm.cpp
+  ${MLAS_SRC_DIR}/qnbitgemm_lowbit.cpp
   ${MLAS_SRC_DIR}/sqnbitgemm_q8_block.h
   ${MLAS_SRC_DIR}/flashattn.cpp
+  ${MLAS_SRC_DIR}/kv_cache_quant.cpp
   ${MLAS_SRC_DIR}/cast.cpp
   ${MLAS_SRC_DIR}/rotary_embedding.h
   ${MLAS_SRC_DIR}/rotary_embedding.cpp
@@ -203,6 +210,11 @@ function(setup_mlas_source_for_windows)
       ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx2.cpp
       ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx512.cpp
       ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx512vnni.cpp
+      ${MLAS_SRC_DIR}/sbgemm_kernel_amd64.cpp
+      ${MLAS_SRC_DIR}/sbgemm_kernel_avx2.cpp
+      ${MLAS_SRC_DIR}/sbgemm_kernel_avx512bf16.cpp
+      ${MLAS_SRC_DIR}/sparse_sgemm_kernel_avx2.cpp
+      ${MLAS_SRC_DIR}/sparse_sgemm_kernel_avx512.cpp
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAmx.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAvx2.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8U8KernelAvx2.asm
@@ -245,6 +257,9 @@ function(setup_mlas_source_for_windows)
       set_source_files_properties(${MLAS_SRC_DIR}/amd64/ConvSymKernelAvx2.asm PROPERTIES COMPILE_FLAGS "-DENABLE_CONVSYMKERNELAVX2_SAT_CHECKER")
     endif()
 
+    set_source_files_properties(${MLAS_SRC_DIR}/platform.cpp PROPERTIES COMPILE_FLAGS "-DMLAS_AVX512BF16_SUPPORTED")
+    set_source_files_properties(${MLAS_SRC_DIR}/sbgemm_kernel_amd64.cpp PROPERTIES COMPILE_FLAGS "-DMLAS_AVX512BF16_SUPPORTED")
+
     if(MSVC_VERSION GREATER_EQUAL 1933)
       target_sources(onnxruntime_mlas PRIVATE
         ${MLAS_SRC_DIR}/amd64/cvtfp16Avx.asm
@@ -646,6 +661,8 @@ else()
           ${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avx2.cpp
           ${MLAS_SRC_DIR}/intrinsics/avx2/saturation_check_avx2.cpp
           ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx2.cpp
+          ${MLAS_SRC_DIR}/sbgemm_kernel_avx2.cpp
+          ${MLAS_SRC_DIR}/sparse_sgemm_kernel_avx2.cpp
           ${MLAS_SRC_DIR}/rotary_embedding_kernel_avx2.h
           ${MLAS_SRC_DIR}/rotary_embedding_kernel_avx2.cpp
           ${MLAS_SRC_DIR}/rotary_embedding_kernel_avx2.cpp
@@ -684,6 +701,7 @@ endif()
           ${MLAS_SRC_DIR}/x86_64/QgemmU8X8KernelAvx512Core.S
           ${MLAS_SRC_DIR}/x86_64/ConvSymKernelAvx512Core.S
           ${MLAS_SRC_DIR}/sqnbitgemm_kernel_avx512.cpp
+          ${MLAS_SRC_DIR}/sparse_sgemm_kernel_avx512.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx512core} PROPERTIES COMPILE_FLAGS "-mfma -mavx512vnni -mavx512bw -mavx512dq -mavx512vl")
 
@@ -692,18 +710,33 @@ endif()
         )
         set_source_files_properties(${mlas_platform_srcs_avx512vnni} PROPERTIES COMPILE_FLAGS "-mfma -mavx512vnni -mavx512bw -mavx512dq -mavx512vl -mavx512f")
 
+        # Older compilers do not support AVX512-BF16. SBGEMM then keeps the AVX2 kernel.
+        check_cxx_compiler_flag("-mavx512bf16" HAS_AVX512BF16)
+        if(HAS_AVX512BF16)
+          set(mlas_platform_srcs_avx512bf16
+            ${MLAS_SRC_DIR}/sbgemm_kernel_avx512bf16.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_avx512bf16} PROPERTIES COMPILE_FLAGS "-mavx512bf16 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/platform.cpp PROPERTIES COMPILE_FLAGS "-DMLAS_AVX512BF16_SUPPORTED")
+          set_source_files_properties(${MLAS_SRC_DIR}/sbgemm_kernel_amd64.cpp PROPERTIES COMPILE_FLAGS "-DMLAS_AVX512BF16_SUPPORTED")
+        else()
+          set(mlas_platform_srcs_avx512bf16 )
+        endif()
+
         set(mlas_platform_srcs
           ${MLAS_SRC_DIR}/activate_fp16.cpp
           ${MLAS_SRC_DIR}/dwconv.cpp
           ${MLAS_SRC_DIR}/dgemm.cpp
           ${MLAS_SRC_DIR}/pooling_fp16.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
+          ${MLAS_SRC_DIR}/sbgemm_kernel_amd64.cpp
           ${mlas_platform_srcs_sse2}
           ${mlas_platform_srcs_avx}
           ${mlas_platform_srcs_avx2}
           ${mlas_platform_srcs_avx512f}
           ${mlas_platform_srcs_avx512core}
           ${mlas_platform_srcs_avx512vnni}
+          ${mlas_platform_srcs_avx512bf16}
         )
 
         if (NOT onnxruntime_ORT_MINIMAL_BUILD)
@@ -38,13 +38,19 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  // CPU arenas only. use -1 to allow ORT to choose the default, 0 = regular pages, 1 = transparent huge pages,
+  // 2 = explicit 2 MB huge pages, 3 = explicit 1 GB huge pages
+  int huge_pages{-1};
+  int numa_node{-1};  // CPU arenas only. use -1 to not bind the arena regions to a NUMA node
 
   bool IsValid() {
     return arena_extend_strategy >= -1 && arena_extend_strategy <= 1 &&
            initial_chunk_size_bytes >= -1 &&
            max_dead_bytes_per_chunk >= -1 &&
            initial_growth_chunk_size_bytes >= -1 &&
-           max_power_of_two_extend_bytes >= -1;
+           max_power_of_two_extend_bytes >= -1 &&
+           huge_pages >= -1 && huge_pages <= 3 &&
+           numa_node >= -1;
   }
 
   // config key names that we parse in FromKeyValuePairs
@@ -55,6 +61,8 @@ struct OrtArenaCfg {
     static constexpr const char* InitialGrowthChunkSizeBytes = "arena.initial_growth_chunk_size_bytes";
     static constexpr const char* MaxPowerOfTwoExtendBytes = "arena.max_power_of_two_extend_bytes";
     static constexpr const char* MaxMem = "arena.max_mem";
+    static constexpr const char* HugePages = "arena.huge_pages";
+    static constexpr const char* NumaNode = "arena.numa_node";
   };
 
   static onnxruntime::common::Status FromKeyValuePairs(const OrtKeyValuePairs& kvps, OrtArenaCfg& cfg);
@@ -55,6 +55,10 @@ class OpSignature;
 class RuntimeOptimizationRecordContainer;
 #endif
 
+namespace concurrency {
+class ThreadPool;
+}
+
 namespace fbs {
 struct Graph;
 struct Node;
@@ -1418,6 +1422,9 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
     // Whether to set that no proto sync is required after resolving.
     // Useful for resolving right after loading from a GraphProto.
     bool no_proto_sync_required = false;
+    // Thread pool to run the independent parts of resolving, such as checking nodes against their schema and
+    // sorting the subgraphs, in parallel (optional).
+    concurrency::ThreadPool* thread_pool = nullptr;
   };
 
   /**
@@ -1554,13 +1561,15 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 #if !defined(ORT_MINIMAL_BUILD)
   // Constructor: Given a <GraphProto> loaded from model file, construct
   // a <Graph> object. Used by Model to create a Graph instance.
+  // If thread_pool is given, the data of the initializers is converted in parallel.
   Graph(const Model& owning_model,
         ONNX_NAMESPACE::GraphProto* graph_proto,
         const std::unordered_map<std::string, int>& domain_to_version,
         Version ir_version,
         IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
         const logging::Logger& logger,
-        bool strict_shape_type_inference);
+        bool strict_shape_type_inference,
+        concurrency::ThreadPool* thread_pool = nullptr);
 
   // internal use by the Graph class only
   Graph(const Model& owning_model,
@@ -1571,7 +1580,8 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
         Graph* parent_graph,
         const Node* parent_node,
         const logging::Logger& logger,
-        bool strict_shape_type_inference);
+        bool strict_shape_type_inference,
+        concurrency::ThreadPool* thread_pool = nullptr);
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Graph);
 
@@ -1761,6 +1771,12 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // Iterate this Graph instance and all subgraphs, calling the provided function for each.
   common::Status ForThisAndAllSubgraphs(const std::vector<Graph*>& subgraphs, std::function<Status(Graph&)> func);
 
+  // Call the provided function for this Graph instance and all subgraphs, in parallel on thread_pool if given.
+  // The function must only access the Graph instance it is called for.
+  common::Status ForThisAndAllSubgraphsInParallel(const std::vector<Graph*>& subgraphs,
+                                                  concurrency::ThreadPool* thread_pool,
+                                                  const std::function<Status(Graph&)>& func);
+
   // Clear all unused initializers and NodeArgs
   void CleanUnusedInitializersAndNodeArgs(const std::unordered_set<std::string>* initializer_names_to_preserve = nullptr);
 
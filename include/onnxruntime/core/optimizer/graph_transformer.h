@@ -41,8 +41,24 @@ class GraphTransformer {
   */
   Status Apply(Graph& graph, bool& modified, const logging::Logger& logger) const;
 
+  /** Apply the in-place transformation to the provided Graph instance, only matching patterns at the given nodes of
+  the main graph. Used by GraphTransformerManager to revisit the nodes affected by earlier rewrites.
+  Transformers that do not override ApplyIncrementalImpl are applied to the whole graph.
+  @param nodes Indexes of the nodes of the main graph to match patterns at.
+  @param[out] modified Set to true if the Graph was modified.
+  @returns Status with success or error information.
+  */
+  Status ApplyIncremental(Graph& graph, const InlinedHashSet<NodeIndex>& nodes, bool& modified,
+                          const logging::Logger& logger) const;
+
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Gets the op types of the nodes that anchor the patterns this transformer matches. A transformer that returns
+  them must only match patterns that are within one edge of the anchor node, so that once the graph was transformed,
+  the transformer only needs to be applied again if a node of one of these op types changed or is next to a node
+  that changed. An empty list, the default, means the transformer may match anywhere. */
+  virtual InlinedVector<std::string> TargetOpTypes() const { return {}; }
+
  protected:
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -67,6 +83,16 @@ class GraphTransformer {
   // should suffice.
   virtual Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const = 0;
 
+  // Apply the transform to the main graph, only matching patterns at the given nodes and in their subgraphs.
+  // The default applies the transform to the whole graph.
+  virtual Status ApplyIncrementalImpl(Graph& graph, const InlinedHashSet<NodeIndex>& /*nodes*/, bool& modified,
+                                      const logging::Logger& logger) const {
+    return ApplyImpl(graph, modified, 0, logger);
+  }
+
+  // Resolve the graph after a transformation that modified it.
+  Status FinalizeApply(Graph& graph, bool modified, Status status, const logging::Logger& logger) const;
+
   const std::string name_;
   const InlinedHashSet<std::string_view> compatible_provider_types_;
 };
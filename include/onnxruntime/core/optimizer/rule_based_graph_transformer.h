@@ -53,6 +53,10 @@ class RuleBasedGraphTransformer : public GraphTransformer {
   /** Returns the total number of rules that are registered in this transformer. */
   size_t RulesCount() const;
 
+  /** Rewrite rules only match at the node they are triggered on and its neighbors, so the op types the rules are
+      registered for are the target op types of the transformer, unless a rule applies to all op types. */
+  InlinedVector<std::string> TargetOpTypes() const override;
+
  protected:
   /** Applies the given set of rewrite rules on the Node of this Graph.
       @param[in] graph The Graph.
@@ -75,8 +79,16 @@ class RuleBasedGraphTransformer : public GraphTransformer {
   // Rules that will be evaluated regardless of the op type of the node.
   InlinedVector<std::reference_wrapper<const RewriteRule>> any_op_type_rules_;
 
+  // Applies the registered rules to the node and recurses into its subgraphs.
+  common::Status ApplyRulesAndRecurse(Graph& graph, Node& node, bool& modified, int graph_level,
+                                      const logging::Logger& logger) const;
+
   // Performs a single top-down traversal of the graph and applies all registered rules.
   common::Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  // Performs a single top-down traversal of the given nodes of the graph and applies all registered rules.
+  common::Status ApplyIncrementalImpl(Graph& graph, const InlinedHashSet<NodeIndex>& nodes, bool& modified,
+                                      const logging::Logger& logger) const override;
 };
 
 }  // namespace onnxruntime
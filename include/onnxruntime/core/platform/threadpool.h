@@ -213,6 +213,23 @@ class ThreadPool {
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Limits the number of threads, including the calling thread, that the parallel loops started by the
+  // calling thread may use while the object is alive. DegreeOfParallelism reports the limited value, so code
+  // that partitions its work by the degree of parallelism, such as MLAS, splits it for the threads that will
+  // run it. A limit of 0 removes any limit. Limits may be nested, in which case the innermost one applies.
+  //
+  // The limit is used by the session to run small operators on fewer threads than the pool has, where waking
+  // up and synchronizing the other threads costs more than it saves.
+  class DegreeOfParallelismLimit {
+   public:
+    explicit DegreeOfParallelismLimit(int max_threads);
+    ~DegreeOfParallelismLimit();
+
+   private:
+    int previous_limit_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DegreeOfParallelismLimit);
+  };
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -360,6 +377,10 @@ class ThreadPool {
   // working in combination with the thread initiating the loop.
   static int DegreeOfParallelism(const ThreadPool* tp);
 
+  // Return the number of threads, including the calling thread, that a parallel loop on the pool can use,
+  // ignoring any DegreeOfParallelismLimit. This is the largest useful limit for the pool.
+  static int MaxThreadsIncludingCaller(const ThreadPool* tp);
+
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
@@ -373,6 +394,10 @@ class ThreadPool {
   // value returned by DegreeOfParallelism to code using the pool.
   int NumThreads() const;
 
+  // Returns the number of threads, including the calling thread, that a parallel loop started by the calling
+  // thread may use, taking its DegreeOfParallelismLimit into account.
+  int LimitedThreadsIncludingCaller() const;
+
   // Returns current thread id between 0 and NumThreads() - 1, if called from a
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
@@ -20,6 +20,7 @@
 #include "core/platform/threadpool.h"
 
 #include "core/session/abi_devices.h"
+#include "core/framework/env_resource_manager.h"
 #include "core/session/plugin_ep/ep_library.h"
 #include "core/session/onnxruntime_c_api.h"
 
@@ -87,6 +88,14 @@ class Environment {
     return create_global_thread_pools_;
   }
 
+  /**
+   * Returns the manager of the thread budget and the arena memory cap that the sessions in this env share.
+   * It is internally synchronized, so sessions holding a const Environment can register with it.
+   */
+  EnvResourceManager& GetResourceManager() const {
+    return *resource_manager_;
+  }
+
   /**
    * Registers an allocator for sharing between multiple sessions.
    * Return an error if an allocator with the same OrtMemoryInfo is already registered.
@@ -171,6 +180,8 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
 
+  std::unique_ptr<EnvResourceManager> resource_manager_ = std::make_unique<EnvResourceManager>();
+
   std::mutex mutex_;
 
   // shared allocators from various sources.
@@ -2979,6 +2979,10 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "huge_pages": The pages that back the regions of a CPU arena. 0 = regular pages, 1 = transparent huge pages,
+   *  2 = explicit 2 MB huge pages, 3 = explicit 1 GB huge pages. The explicit modes fall back to transparent huge
+   *  pages if no huge pages are reserved. Default is 0.
+   * "numa_node": The NUMA node that the regions of a CPU arena are placed on. Default is to not bind them to a node.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -6468,6 +6472,134 @@ struct OrtApi {
                   _In_reads_(num_tensors) OrtValue* const* dst_tensors,
                   _In_opt_ OrtSyncStream* stream,
                   _In_ size_t num_tensors);
+
+  /** \brief Create an OrtLoraAdapter that stacks the parameters of several adapters
+   *
+   * Each parameter of the new adapter is the same named parameter of all source adapters stacked along a new
+   * leading dimension, in the order of `adapters`. This allows a model that selects the adapter per request,
+   * such as one using the com.microsoft.MultiLoRA operator with a per request adapter id, to serve requests
+   * for all of the adapters in a single Run() call. Activate the stacked adapter with
+   * OrtApi::RunOptionsAddActiveLoraAdapter.
+   *
+   * All source adapters must have the same parameter names, data types and shapes, and must be created for the
+   * same model version. The parameter data is copied, except that a single adapter is stacked by referencing its
+   * memory, including a memory mapped adapter file. Either way the source adapters may be released afterwards.
+   *
+   * \param[in] adapters Array of OrtLoraAdapter instances to stack.
+   * \param[in] num_adapters Number of adapters in `adapters`. Must be greater than zero.
+   * \param[in] allocator optional pointer to a device allocator. If specified
+   *            data is copied to the device at some point before Run() is invoked. If nullptr, data stays on CPU.
+   * \param[out] out A pointer to a newly created OrtLoraAdapter instance. Must be released with
+   *                  OrtApi::ReleaseLoraAdapter.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23
+   */
+  ORT_API2_STATUS(CreateStackedLoraAdapter, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                  _In_ size_t num_adapters, _In_opt_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** out);
+
+  /** \brief Bind an ::OrtIoBinding output to an allocator
+   *
+   * The output is allocated with `allocator` on the device of its ::OrtMemoryInfo while the model runs, so the
+   * kernel producing the output writes it in place. If the output is produced on another device it is copied into
+   * a buffer from `allocator`. The buffer is freed with `allocator` when the output ::OrtValue is released.
+   *
+   * This lets a caller serve outputs with dynamic shapes from its own pool of buffers, e.g. one that keeps freed
+   * buffers in size classes and hands them out again, so that repeated runs do not allocate and free the outputs.
+   * Outputs that are not newly allocated tensors, such as a model input that is also a model output, are returned
+   * as if the output was bound with OrtApi::BindOutputToDevice.
+   *
+   * \see OrtApi::RunWithBinding
+   *
+   * \param[in] binding_ptr
+   * \param[in] name Null terminated string of the model output name
+   * \param[in] allocator Allocator to allocate the output with. It must outlive the output ::OrtValue and be thread
+   *                      safe if runs are concurrent.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23
+   */
+  ORT_API2_STATUS(BindOutputToAllocator, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                  _In_ OrtAllocator* allocator);
+
+  /** \brief Get the class labels of a columnar ZipMap output
+   *
+   * With the "optimization.zipmap_columnar_output" session config entry, a ZipMap node that produces a model
+   * output returns a float tensor of shape [N, C] instead of a sequence of N maps. Column j holds the
+   * probabilities of label j. This function returns the C labels as a 1-D tensor, which is of type string or int64
+   * depending on the classlabels_strings or classlabels_int64s attribute of the ZipMap node.
+   *
+   * The labels do not change between runs, so they only need to be fetched once per session.
+   *
+   * \param[in] session
+   * \param[in] index Must be between 0 (inclusive) and what OrtApi::SessionGetOutputCount returns (exclusive)
+   * \param[in] allocator Allocator to allocate the labels tensor with
+   * \param[out] out Newly created ::OrtValue holding the labels. Must be freed with OrtApi::ReleaseValue.
+   *                 Set to nullptr if the output is not a columnar ZipMap output.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23
+   */
+  ORT_API2_STATUS(SessionGetOutputZipMapLabels, _In_ const OrtSession* session, size_t index,
+                  _Inout_ OrtAllocator* allocator, _Outptr_result_maybenull_ OrtValue** out);
+
+  /** \brief Set the limits on the threads and the arena memory that all the sessions of an ::OrtEnv share
+   *
+   * Without limits, the sessions of an environment each use their whole intra-op thread pool and let their memory
+   * arenas grow, so a process that runs many sessions at once oversubscribes the cores and the memory.
+   *
+   * The runs in progress across all sessions share `thread_budget` in proportion to the weight of the
+   * "session.resource_priority" of their session, which is 1 for low, 2 for normal and 4 for high. Each node of a
+   * run uses at most its share at the time the node starts, and at least the thread calling Run. Sessions created
+   * afterwards with the default intra-op thread pool size get a pool of at most `thread_budget` threads.
+   *
+   * When the memory arenas of the sessions reserve more than `arena_memory_cap` bytes at the end of a run, the
+   * regions of the arenas that have no memory in use are released until the total is within the cap. Idle sessions
+   * and lower priority sessions are reclaimed first. Memory in use is never released, so the cap bounds the memory
+   * that the arenas keep between runs rather than their peak.
+   *
+   * Use OrtApi::SessionGetResourceUsage to get what each session uses.
+   *
+   * \param[in] env
+   * \param[in] thread_budget Number of intra-op threads, including the threads calling Run, that the runs of all the
+   *                          sessions may use at the same time. 0 for no limit, which is the default.
+   * \param[in] arena_memory_cap Number of bytes that the memory arenas of all the sessions may keep.
+   *                             0 for no limit, which is the default.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23
+   */
+  ORT_API2_STATUS(SetEnvResourceLimits, _Inout_ OrtEnv* env, int thread_budget, size_t arena_memory_cap);
+
+  /** \brief Get the threads and the arena memory that a session uses
+   *
+   * The usage is returned as key/value pairs with the following keys. All values are decimal integers except for
+   * the priority.
+   *   "priority": "low", "normal" or "high", from the "session.resource_priority" session config entry.
+   *   "max_threads": Threads of the intra-op thread pool of the session, including the thread calling Run.
+   *   "thread_grant": Threads that a run of the session may use at the moment under the thread budget.
+   *   "active_runs": Runs of the session in progress.
+   *   "arena_bytes_in_use": Bytes allocated from the memory arenas of the session.
+   *   "arena_bytes_reserved": Bytes that the memory arenas of the session hold.
+   *   "arena_bytes_reclaimed": Bytes released from the memory arenas of the session to keep within the memory cap.
+   *
+   * Arenas that sessions share through the environment are included in the usage of each of the sessions.
+   *
+   * \see OrtApi::SetEnvResourceLimits
+   *
+   * \param[in] session
+   * \param[out] usage Newly created ::OrtKeyValuePairs with the usage. Must be freed with
+   *                   OrtApi::ReleaseKeyValuePairs.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.23
+   */
+  ORT_API2_STATUS(SessionGetResourceUsage, _In_ const OrtSession* session, _Outptr_ OrtKeyValuePairs** usage);
 };
 
 /*
@@ -871,6 +871,8 @@ struct Env : detail::Base<OrtEnv> {
 
   Env& UpdateEnvWithCustomLogLevel(OrtLoggingLevel log_severity_level);  ///< Wraps OrtApi::UpdateEnvWithCustomLogLevel
 
+  Env& SetResourceLimits(int thread_budget, size_t arena_memory_cap);  ///< Wraps OrtApi::SetEnvResourceLimits
+
   Env& CreateAndRegisterAllocator(const OrtMemoryInfo* mem_info, const OrtArenaCfg* arena_cfg);  ///< Wraps OrtApi::CreateAndRegisterAllocator
 
   Env& CreateAndRegisterAllocatorV2(const std::string& provider_type, const OrtMemoryInfo* mem_info,
@@ -923,6 +925,15 @@ struct LoraAdapter : detail::Base<OrtLoraAdapter> {
   ///        be copied to device if required by the model at inference time.
   static LoraAdapter CreateLoraAdapterFromArray(const void* bytes, size_t num_bytes,
                                                 OrtAllocator* allocator);
+
+  /// \brief Wraps OrtApi::CreateStackedLoraAdapter
+  ///
+  /// The function stacks the parameters of several adapters so that one Run() can serve all of them.
+  /// \param adapters The adapters to stack, the position of an adapter is its index in the stacked parameters
+  /// \param allocator optional pointer to a device allocator. If nullptr, the data stays on CPU. It would still
+  ///        be copied to device if required by the model at inference time.
+  static LoraAdapter CreateStackedLoraAdapter(const std::vector<LoraAdapter>& adapters,
+                                              OrtAllocator* allocator);
 };
 
 /** \brief RunOptions
@@ -1300,6 +1311,18 @@ struct ConstSessionImpl : Base<T> {
 
   int GetOpset(const std::string& domain) const;  ///< Wraps OrtApi::SessionGetOpsetForDomain
 
+  /** \brief Returns the class labels of a columnar ZipMap output, or an empty Value if the output is not one.
+   *
+   * Wraps OrtApi::SessionGetOutputZipMapLabels
+   */
+  Value GetOutputZipMapLabels(size_t index, OrtAllocator* allocator) const;
+
+  /** \brief Returns the threads and the arena memory that the session uses.
+   *
+   * Wraps OrtApi::SessionGetResourceUsage
+   */
+  KeyValuePairs GetResourceUsage() const;
+
   // Will move before checkin if that's the case.
   std::vector<ValueInfo> GetInputs() const;
   std::vector<ValueInfo> GetOutputs() const;
@@ -2208,6 +2231,7 @@ struct IoBindingImpl : ConstIoBindingImpl<T> {
   void BindInput(const char* name, const Value&);
   void BindOutput(const char* name, const Value&);
   void BindOutput(const char* name, const OrtMemoryInfo*);
+  void BindOutput(const char* name, OrtAllocator*);  ///< Wraps OrtApi::BindOutputToAllocator
   void ClearBoundInputs();
   void ClearBoundOutputs();
   void SynchronizeInputs();
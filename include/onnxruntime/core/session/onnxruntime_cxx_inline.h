@@ -354,6 +354,11 @@ inline void IoBindingImpl<T>::BindOutput(const char* name, const OrtMemoryInfo*
   ThrowOnError(GetApi().BindOutputToDevice(this->p_, name, mem_info));
 }
 
+template <typename T>
+inline void IoBindingImpl<T>::BindOutput(const char* name, OrtAllocator* allocator) {
+  ThrowOnError(GetApi().BindOutputToAllocator(this->p_, name, allocator));
+}
+
 template <typename T>
 inline void IoBindingImpl<T>::ClearBoundInputs() {
   GetApi().ClearBoundInputs(this->p_);
@@ -656,6 +661,11 @@ inline Env& Env::UpdateEnvWithCustomLogLevel(OrtLoggingLevel log_severity_level)
   return *this;
 }
 
+inline Env& Env::SetResourceLimits(int thread_budget, size_t arena_memory_cap) {
+  ThrowOnError(GetApi().SetEnvResourceLimits(p_, thread_budget, arena_memory_cap));
+  return *this;
+}
+
 inline Env& Env::CreateAndRegisterAllocator(const OrtMemoryInfo* mem_info, const OrtArenaCfg* arena_cfg) {
   ThrowOnError(GetApi().CreateAndRegisterAllocator(p_, mem_info, arena_cfg));
   return *this;
@@ -725,6 +735,15 @@ inline LoraAdapter LoraAdapter::CreateLoraAdapterFromArray(const void* bytes, si
   return LoraAdapter{p};
 }
 
+inline LoraAdapter LoraAdapter::CreateStackedLoraAdapter(const std::vector<LoraAdapter>& adapters,
+                                                         OrtAllocator* allocator) {
+  static_assert(sizeof(LoraAdapter) == sizeof(OrtLoraAdapter*), "LoraAdapter is really just an OrtLoraAdapter* in memory, so we can reinterpret_cast safely");
+  OrtLoraAdapter* p;
+  ThrowOnError(GetApi().CreateStackedLoraAdapter(reinterpret_cast<const OrtLoraAdapter* const*>(adapters.data()),
+                                                 adapters.size(), allocator, &p));
+  return LoraAdapter{p};
+}
+
 inline RunOptions::RunOptions() {
   ThrowOnError(GetApi().CreateRunOptions(&p_));
 }
@@ -1398,6 +1417,20 @@ inline TypeInfo ConstSessionImpl<T>::GetOverridableInitializerTypeInfo(size_t in
   return TypeInfo{out};
 }
 
+template <typename T>
+inline Value ConstSessionImpl<T>::GetOutputZipMapLabels(size_t index, OrtAllocator* allocator) const {
+  OrtValue* out = nullptr;
+  ThrowOnError(GetApi().SessionGetOutputZipMapLabels(this->p_, index, allocator, &out));
+  return Value{out};
+}
+
+template <typename T>
+inline KeyValuePairs ConstSessionImpl<T>::GetResourceUsage() const {
+  OrtKeyValuePairs* out = nullptr;
+  ThrowOnError(GetApi().SessionGetResourceUsage(this->p_, &out));
+  return KeyValuePairs{out};
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 template <typename T>
 inline int ConstSessionImpl<T>::GetOpset(const std::string& domain) const {
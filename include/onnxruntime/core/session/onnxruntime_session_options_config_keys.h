@@ -24,6 +24,62 @@ static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.di
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
 
+// Backs the memory of the CPU execution provider's allocator, which includes the arena regions, the initializers and
+// the prepacked weights, with huge pages to reduce TLB misses for large weights.
+// "0": regular pages (default).
+// "1": transparent huge pages. The memory is 2 MB aligned and advised with MADV_HUGEPAGE. Linux only.
+// "2": explicit 2 MB huge pages (MAP_HUGETLB on Linux, large pages on Windows).
+// "3": explicit 1 GB huge pages (MAP_HUGETLB on Linux, large pages on Windows).
+// The explicit modes require huge pages to be reserved, e.g. with /proc/sys/vm/nr_hugepages, or the
+// SeLockMemoryPrivilege privilege on Windows, and fall back to "1" if none are available.
+static const char* const kOrtSessionOptionsCpuAllocatorHugePages = "session.cpu_allocator_huge_pages";
+
+// The NUMA node that the memory of the CPU execution provider's allocator is placed on, e.g. the node that the
+// intra-op threads are pinned to. The memory falls back to other nodes when the node is out of memory.
+// Supported on Linux and Windows. The default is "-1" (placed on the node that first touches it).
+static const char* const kOrtSessionOptionsCpuAllocatorNumaNode = "session.cpu_allocator_numa_node";
+
+// If the value is "1" and memory pattern optimization is enabled, the memory pattern is planned once with the
+// offsets and sizes of the buffers as functions of the symbolic dimensions of the graph inputs (e.g. batch size and
+// sequence length), and evaluated for the input shapes of each run. This replaces the cache of one memory pattern
+// per exact input shape, which rarely hits when the input shapes vary on every run.
+// Tensors whose size cannot be expressed with the symbolic dimensions of the graph inputs are allocated per run.
+// The default is "0".
+static const char* const kOrtSessionOptionsEnableSymbolicMemoryPattern = "session.enable_symbolic_memory_pattern";
+
+// Declares buckets for symbolic dimensions of the model, named by their dim_param, so that a session specialized
+// for static shapes is created for each bucket. The format is "<dim_param>:<size>[,<size>...][;<dim_param>:...]",
+// e.g. "sequence:128,256,512;batch:1,8" creates 6 specialized sessions.
+// Each specialized session overrides the free dimensions with the sizes of its bucket, so its graph is optimized and
+// its memory is planned for static shapes. The specialized sessions share the initializers, pre-packed weights and
+// thread pools of the session, and each has its own CPU execution provider. Shape buckets are only supported when
+// the CPU execution provider is the only one registered, and are ignored otherwise.
+// A run is dispatched to the smallest bucket that holds the sizes of its inputs. The inputs are zero padded on the
+// axes of the bucketed dimensions, and the outputs are cropped on the axes whose dim_param is a bucketed dimension.
+// The model must therefore produce the same values for the unpadded region when the inputs are zero padded,
+// e.g. by taking an attention mask input.
+// Runs whose inputs do not fit into any bucket, are not in CPU memory, or that provide pre-allocated outputs use the
+// generic session.
+// Not supported in a minimal build. The default is "" (no buckets).
+static const char* const kOrtSessionOptionsShapeBuckets = "session.shape_buckets";
+
+// Number of pipeline stages that RunAsync executes the model with. If larger than 1, the nodes are split into that
+// many stages of consecutive nodes, and each stage executes one request at a time and then hands it to the next
+// stage. Consecutive requests are therefore in flight at different stages of the model at the same time, each with
+// its own execution frame, and the throughput is limited by the slowest stage rather than the whole model.
+// The stages are balanced with the node durations measured in the first request.
+// Only supported for models whose nodes are all assigned to CPU execution providers and with sequential execution,
+// and not with "session.shape_buckets" or while profiling is enabled.
+// Otherwise RunAsync executes each request with Run on a thread of the intra-op thread pool.
+// The completion callback of a request is called on a thread of the intra-op thread pool.
+// The default is "0" (no pipelining).
+static const char* const kOrtSessionOptionsRunAsyncPipelineStages = "session.run_async_pipeline_stages";
+
+// Maximum number of RunAsync requests in flight when "session.run_async_pipeline_stages" is set.
+// Requests submitted beyond that wait until a request completes, which bounds the memory of the execution frames.
+// The default is twice the number of pipeline stages.
+static const char* const kOrtSessionOptionsRunAsyncMaxInFlight = "session.run_async_max_in_flight";
+
 // Set to 'ORT' (case sensitive) to load an ORT format model.
 // If unset, model type will default to ONNX unless inferred from filename ('.ort' == ORT format) or bytes to be ORT
 static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load_model_format";
@@ -67,10 +123,26 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Rewrite ai.onnx.ml ZipMap nodes that produce a model output into com.microsoft.ZipMapColumnar nodes.
+// "0": disable; "1": enable. The default is "0".
+// The output then is a float tensor of shape [N, C] holding the probabilities instead of a sequence of maps,
+// and the class labels are returned once by OrtApi::SessionGetOutputZipMapLabels. This avoids building a map per row
+// for classifiers with large batches or many classes. Only applies to nodes assigned to the CPU execution provider,
+// and requires the graph optimization level to be ORT_ENABLE_EXTENDED or higher. It is ignored with a warning
+// otherwise.
+static const char* const kOrtSessionOptionsZipMapColumnarOutput = "optimization.zipmap_columnar_output";
+
 // Enable or disable Cast chain elimination in graph optimization. "0": disable; "1": enable. The default is "0".
 // CastElimination with chain elimination has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableCastChainElimination = "optimization.enable_cast_chain_elimination";
 
+// Enable or disable converting fp32 Conv and FusedConv nodes to the channels last NhwcFusedConv operator in the
+// level 3 NhwcTransformer. "0": disable; "1": enable. The default is "0".
+// The channels last kernel avoids the im2col buffer but requires transposes at the boundaries of each channels
+// last region. When enabled, the NhwcTransformer runs before the NCHWc layout transformer, so on x86-64 fp32
+// convolutions use the channels last kernel instead of the NCHWc one. Measure before enabling.
+static const char* const kOrtSessionOptionsEnableNhwcFp32Conv = "optimization.enable_nhwc_fp32_conv";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -142,6 +214,14 @@ static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimiz
 // Default value is set to "1".
 static const char* const kOrtSessionOptionsGraphOptimizationsLoopLevel = "session.graph_optimizations_loop_level";
 
+// Specifies whether the graph transformer steps after the first one only revisit the nodes that changed since each
+// transformer was last applied, and their neighbors. Transformers that declare the op types they match are skipped
+// if none of those nodes have one of these op types.
+// "0": disable. Every step applies every transformer to the whole graph.
+// "1": enable.
+// Default value is set to "1".
+static const char* const kOrtSessionOptionsGraphOptimizationsIncremental = "session.graph_optimizations_incremental";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
@@ -231,6 +311,13 @@ static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "ses
 // is used for development purpose.
 static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly = "session.allow_released_opsets_only";
 
+// "1": the independent parts of loading an ONNX model run in parallel on the intra-op thread pool of the session:
+// converting the initializer data, creating the schemas of the model local functions, checking the nodes against
+// their schema and sorting the subgraphs. The default.
+// "0": the model is loaded on the calling thread only.
+// Speeds up creating a session for models with many nodes and initializers.
+static const char* const kOrtSessionOptionsConfigParallelModelLoad = "session.parallel_model_load";
+
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
@@ -322,6 +409,28 @@ static const char* const kOrtSessionOptionsSavePrePackedConstantInitializers =
 // - "full path to file": there is not a default for this option. If the file can not be opened for writing, an error will be returned.
 static const char* const kOrtSessionOptionsCollectNodeMemoryStatsToFile = "session.collect_node_memory_stats_to_file";
 
+// Tune the number of intra-op threads of each node on the CPU EP while the session runs.
+// The first runs of a node with a given set of input shapes are timed with the full intra-op thread pool, then with
+// half of it and so on, and the node keeps the fewest threads whose median latency is within 5% of the best one.
+// Small operators then stop paying for waking up and synchronizing threads that do not speed them up.
+// "0": disable. [DEFAULT]
+// "1": enable.
+static const char* const kOrtSessionOptionsIntraOpThreadTuning = "session.intra_op_thread_tuning";
+
+// File to load the tuned intra-op thread counts from at session initialization, and to save them to after the runs
+// that finish tuning a node. The file is ignored if it was tuned for a different number of intra-op threads.
+// Only used when kOrtSessionOptionsIntraOpThreadTuning is enabled.
+// - "path to file": there is not a default for this option. The tuned thread counts are not saved if it is empty.
+static const char* const kOrtSessionOptionsIntraOpThreadTuningFile = "session.intra_op_thread_tuning_file";
+
+// Priority class of the session for the limits set with OrtApi::SetEnvResourceLimits, which all the sessions of an
+// OrtEnv share. The runs in progress share the thread budget in proportion to the weight of their priority class,
+// and the memory arenas of lower priority sessions are reclaimed first when the arenas exceed the memory cap.
+// "low": weight 1.
+// "normal": weight 2. [DEFAULT]
+// "high": weight 4.
+static const char* const kOrtSessionOptionsResourcePriority = "session.resource_priority";
+
 /// This is a composite CSV setting formatted as "memory limit in kb,file name for collected stats"
 /// "limit > 0": enables Capacity Aware Partitioning for Cuda EP. `limit` is optional and when absent
 /// the provider may attempt to figure out the memory available automatically.
@@ -369,11 +478,21 @@ static const char* const kOrtSessionOptionsEpContextModelExternalInitializersFil
     "ep.context_model_external_initializers_file_name";
 
 // Gemm fastmath mode provides fp32 gemm acceleration with bfloat16 based matmul.
+// It applies to the MatMul and Gemm CPU kernels on Linux ARM64 with bfloat16 support and on x86-64 with
+// AVX512-BF16, or AVX2 where the bfloat16 products are emulated in fp32. The key name predates the x86 support.
 // Option values:
 // - "0": Gemm FastMath mode is not enabled. [DEFAULT]
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
 
+// The MatMul and Gemm CPU kernels check their constant float weights for sparsity when they prepack them. A weight
+// that is pruned to a 2:4 pattern along K, or whose 4x16 blocks are mostly zero, is packed in a sparse format and
+// multiplied without reading its zeros. The sparse kernels accumulate in a different order than the dense SGEMM.
+// Option values:
+// - "0": Weights are always packed for the dense SGEMM.
+// - "1": Sparse weights are packed for the sparse SGEMM. [DEFAULT]
+static const char* const kOrtSessionOptionsMlasSparseGemm = "mlas.enable_sparse_gemm";
+
 // When converting DQ + MatMul -> MatMulNBits, the accuracy level of the MatMulNBits is controlled by this option.
 // Refer to MatMulNBits op schema for more details.
 // If not provided, default is 4.
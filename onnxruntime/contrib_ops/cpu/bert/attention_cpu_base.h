@@ -383,41 +383,94 @@ class AttentionCPUBase : public AttentionBase {
     unit_cost.bytes_loaded += bytes_to_copy_trans_all;
     unit_cost.bytes_stored += bytes_to_copy_trans_all;
 
-    ThreadPool::TryParallelFor(
-        tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-          for (std::ptrdiff_t i = begin; i != end; ++i) {
-            const T* v = V + kv_input_chunk_length * i;
-            if (nullptr != present) {
-              // Concatenate past_V and V: (BxNx)PxH_v, (BxNx)LxH_v -> (BxNx)TxH_v
-              v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
-            } else if (nullptr != present_value) {
-              if (past_present_share_buffer) {
-                v = present_value + cache_chunk_length * i;
-                memcpy(const_cast<T*>(v) + past_chunk_length, V + v_head_size * i, v_head_size * sizeof(T));
-              } else {
-                v = ConcatStateChunk(past_value, v, present_value, past_chunk_length, present_chunk_length, i);
-              }
+    if constexpr (std::is_same<T, float>::value) {
+      // Concatenate the past and current V of each head, then compute all heads with one grouped
+      // SGEMM. The product of each head is written straight into its strided slice of the output,
+      // so neither the temporary buffer nor the transpose copy is needed.
+      const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
+      std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_data(static_cast<size_t>(loop_len));
+
+      TensorOpCost concat_cost;
+      concat_cost.bytes_loaded = (present || present_value)
+                                     ? (past_present_share_buffer ? kv_input_chunk_length : present_chunk_length) *
+                                           static_cast<double>(sizeof(T))
+                                     : 0.0;
+      concat_cost.bytes_stored = concat_cost.bytes_loaded;
+      concat_cost.compute_cycles = 1.0;
+
+      ThreadPool::TryParallelFor(tp, loop_len, concat_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const T* v = V + kv_input_chunk_length * i;
+          if (nullptr != present) {
+            v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
+          } else if (nullptr != present_value) {
+            if (past_present_share_buffer) {
+              v = present_value + cache_chunk_length * i;
+              memcpy(const_cast<T*>(v) + past_chunk_length, V + v_head_size * i, v_head_size * sizeof(T));
+            } else {
+              v = ConcatStateChunk(past_value, v, present_value, past_chunk_length, present_chunk_length, i);
             }
+          }
+
+          const ptrdiff_t batch_index = i / num_heads_;
+          const ptrdiff_t head_index = i % num_heads_;
+
+          const ptrdiff_t probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
 
-            T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + q_input_chunk_length * i;
-            ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
-            math::MatMul<T>(sequence_length, v_head_size, total_sequence_length,
-                            attention_probs + attention_probs_offset, v, current_tmp_data, nullptr);
-
-            // Transpose: out(B, S, N, H_v) -> out_tmp(B, N, S, H_v)
-            const int batch_index = static_cast<int>(i / num_heads_);
-            const int head_index = static_cast<int>(i % num_heads_);
-            T* src = current_tmp_data;
-            ptrdiff_t dest_offset =
-                (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
-            T* dest = output + dest_offset;
-            for (int j = 0; j < sequence_length; j++) {
-              memcpy(dest, src, bytes_to_copy_trans);
-              src += v_head_size;
-              dest += v_hidden_size;
+          MLAS_SGEMM_DATA_PARAMS& data = gemm_data[i];
+          data.A = attention_probs + probs_offset;
+          data.lda = static_cast<size_t>(total_sequence_length);
+          data.B = v;
+          data.ldb = static_cast<size_t>(v_head_size);
+          data.C = output + (batch_index * sequence_length * num_heads_ + head_index) * v_head_size;
+          data.ldc = static_cast<size_t>(v_hidden_size);
+        }
+      });
+
+      MLAS_SGEMM_GROUP_PARAMS group;
+      group.M = static_cast<size_t>(sequence_length);
+      group.N = static_cast<size_t>(v_head_size);
+      group.K = static_cast<size_t>(total_sequence_length);
+      group.Data = gemm_data.data();
+      group.BatchSize = gemm_data.size();
+      MlasGemmGrouped(&group, 1, tp);
+    } else {
+      ThreadPool::TryParallelFor(
+          tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+            for (std::ptrdiff_t i = begin; i != end; ++i) {
+              const T* v = V + kv_input_chunk_length * i;
+              if (nullptr != present) {
+                // Concatenate past_V and V: (BxNx)PxH_v, (BxNx)LxH_v -> (BxNx)TxH_v
+                v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
+              } else if (nullptr != present_value) {
+                if (past_present_share_buffer) {
+                  v = present_value + cache_chunk_length * i;
+                  memcpy(const_cast<T*>(v) + past_chunk_length, V + v_head_size * i, v_head_size * sizeof(T));
+                } else {
+                  v = ConcatStateChunk(past_value, v, present_value, past_chunk_length, present_chunk_length, i);
+                }
+              }
+
+              T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + q_input_chunk_length * i;
+              ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
+              math::MatMul<T>(sequence_length, v_head_size, total_sequence_length,
+                              attention_probs + attention_probs_offset, v, current_tmp_data, nullptr);
+
+              // Transpose: out(B, S, N, H_v) -> out_tmp(B, N, S, H_v)
+              const int batch_index = static_cast<int>(i / num_heads_);
+              const int head_index = static_cast<int>(i % num_heads_);
+              T* src = current_tmp_data;
+              ptrdiff_t dest_offset =
+                  (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
+              T* dest = output + dest_offset;
+              for (int j = 0; j < sequence_length; j++) {
+                memcpy(dest, src, bytes_to_copy_trans);
+                src += v_head_size;
+                dest += v_hidden_size;
+              }
             }
-          }
-        });
+          });
+    }
   }
 
   // Used for DecoderMaskedMultiHeadAttention where sequence_length = 1
@@ -37,6 +37,11 @@ class GQAAttentionBase {
     local_window_size_ = has_local ? static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1)) : -1;
 
     qk_output_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("qk_output", static_cast<int64_t>(QKOutputType::NO_OUTPUT)));
+
+    kv_cache_bit_width_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("kv_cache_bit_width", 0));
+    ORT_ENFORCE(kv_cache_bit_width_ == 0 || kv_cache_bit_width_ == 8 || kv_cache_bit_width_ == 4,
+                "kv_cache_bit_width must be 0, 4 or 8");
+    kv_quant_group_size_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("kv_quant_group_size", 0));
   }
 
   int num_heads_;     // number of attention heads of Q
@@ -47,6 +52,8 @@ class GQAAttentionBase {
   bool rotary_interleaved_;
   int local_window_size_;
   int qk_output_;
+  int kv_cache_bit_width_;   // 0 if the kv cache is not quantized, otherwise 8 or 4
+  int kv_quant_group_size_;  // number of cached values sharing a scale, 0 for head_size
 
   bool use_smooth_softmax_;
 
@@ -134,6 +141,226 @@ class GQAAttentionBase {
     return Status::OK();
   }
 
+  // Computes the attention against a quantized key/value cache. The new keys and values are quantized into
+  // the present cache, and the Q*K' and P*V products dequantize the cache while it is read.
+  template <typename T>
+  Status ApplyAttentionQuantizedKV(const T* Q,                                 // Q data with shape BxNxSxH
+                                   const T* K,                                 // K data with shape BxN_kvxSxH
+                                   const T* V,                                 // V data with shape BxN_kvxSxH
+                                   const T* head_sink,                         // Head sink for smooth softmax
+                                   const Tensor* attention_bias,               // Attention bias to add to QxK'
+                                   const Tensor* past_key,                     // quantized past K
+                                   const Tensor* past_value,                   // quantized past V
+                                   const Tensor* past_key_scale,               // scales of past K
+                                   const Tensor* past_value_scale,             // scales of past V
+                                   Tensor* output,                             // output tensor
+                                   Tensor* present_key,                        // quantized present K
+                                   Tensor* present_value,                      // quantized present V
+                                   Tensor* present_key_scale,                  // scales of present K
+                                   Tensor* present_value_scale,                // scales of present V
+                                   const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                   GroupQueryAttentionParameters& parameters,  // attention parameters
+                                   OpKernelContext* context) const {
+    const bool is_prompt = parameters.is_first_prompt;
+    const size_t batch_size = static_cast<size_t>(parameters.batch_size);
+    const size_t sequence_length = static_cast<size_t>(parameters.sequence_length);
+    const size_t head_size = static_cast<size_t>(parameters.head_size);
+    const size_t hidden_size = static_cast<size_t>(parameters.hidden_size);
+    const size_t past_buffer_sequence_length = static_cast<size_t>(parameters.seqlen_past_kv_cache);
+    const size_t present_buffer_sequence_length = static_cast<size_t>(parameters.seqlen_present_kv_cache);
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+
+    const size_t bit_width = static_cast<size_t>(kv_cache_bit_width_);
+    const size_t group_size = kv_quant_group_size_ > 0 ? static_cast<size_t>(kv_quant_group_size_) : head_size;
+    const size_t row_bytes = bit_width == 8 ? head_size : head_size / 2;
+    const size_t scales_per_token = head_size / group_size;
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const uint8_t* past_cache[2] = {
+        past_key != nullptr ? static_cast<const uint8_t*>(past_key->DataRaw()) : nullptr,
+        past_value != nullptr ? static_cast<const uint8_t*>(past_value->DataRaw()) : nullptr};
+    const float* past_scales[2] = {
+        past_key_scale != nullptr ? past_key_scale->Data<float>() : nullptr,
+        past_value_scale != nullptr ? past_value_scale->Data<float>() : nullptr};
+    uint8_t* present_cache[2] = {static_cast<uint8_t*>(present_key->MutableDataRaw()),
+                                 static_cast<uint8_t*>(present_value->MutableDataRaw())};
+    float* present_scales[2] = {present_key_scale->MutableData<float>(), present_value_scale->MutableData<float>()};
+
+    const bool past_present_share_buffer = past_cache[0] == present_cache[0] && past_cache[1] == present_cache[1] &&
+                                           past_scales[0] == present_scales[0] && past_scales[1] == present_scales[1];
+
+    const size_t present_cache_bytes = batch_size * kv_num_heads_ * present_buffer_sequence_length * row_bytes;
+    const size_t present_scale_count = batch_size * kv_num_heads_ * present_buffer_sequence_length * scales_per_token;
+    if (!past_present_share_buffer) {
+      for (int j = 0; j < 2; j++) {
+        memset(present_cache[j], 0, present_cache_bytes);
+        memset(present_scales[j], 0, present_scale_count * sizeof(float));
+      }
+    }
+
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t chunk_length = sequence_length * head_size;  // S x H
+    const T* new_kv[2] = {packed_qkv ? Q + num_heads_ * chunk_length : K,
+                          packed_qkv ? Q + (num_heads_ + kv_num_heads_) * chunk_length : V};
+
+    // Append the new keys and values to the present cache.
+    TensorOpCost append_cost;
+    append_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(4) * chunk_length);
+    append_cost.bytes_loaded = static_cast<double>(2 * chunk_length * sizeof(T));
+    append_cost.bytes_stored = static_cast<double>(2 * sequence_length * row_bytes);
+
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, append_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      std::vector<float> input_fp32(std::is_same_v<T, float> ? 0 : chunk_length);
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t kv_head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+
+        for (int j = 0; j < 2; j++) {
+          uint8_t* cache = present_cache[j] + i * present_buffer_sequence_length * row_bytes;
+          float* scales = present_scales[j] + i * present_buffer_sequence_length * scales_per_token;
+
+          if (!past_present_share_buffer && past_seqlen > 0) {
+            memcpy(cache, past_cache[j] + i * past_buffer_sequence_length * row_bytes, past_seqlen * row_bytes);
+            memcpy(scales, past_scales[j] + i * past_buffer_sequence_length * scales_per_token,
+                   past_seqlen * scales_per_token * sizeof(float));
+          }
+
+          const T* input = packed_qkv ? new_kv[j] + packed_batch_stride * batch_index + chunk_length * kv_head_index
+                                      : new_kv[j] + chunk_length * i;
+          const float* input_float;
+          if constexpr (std::is_same_v<T, float>) {
+            input_float = input;
+          } else {
+            MlasConvertHalfToFloatBuffer(input, input_fp32.data(), chunk_length);
+            input_float = input_fp32.data();
+          }
+
+          MlasQuantizeKvCache(input_float, sequence_length, head_size, group_size, bit_width,
+                              cache + past_seqlen * row_bytes, scales + past_seqlen * scales_per_token);
+        }
+      }
+    });
+
+    const T* attention_bias_data = attention_bias != nullptr ? attention_bias->Data<T>() : nullptr;
+    auto attention_bias_shape = attention_bias != nullptr ? attention_bias->Shape().GetDims() : gsl::span<const int64_t>{};
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    T* output_data = output->MutableData<T>();
+
+    // Each unit reads the quantized cache once per query token.
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(4) * sequence_length * head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded = static_cast<double>(SafeInt<ptrdiff_t>(2) * sequence_length * present_buffer_sequence_length *
+                                                 (row_bytes + scales_per_token * sizeof(float)));
+    unit_cost.bytes_stored = static_cast<double>(chunk_length * sizeof(T));
+
+    ThreadPool::TryParallelFor(tp, batch_size * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      std::vector<float> probs(present_buffer_sequence_length);
+      std::vector<float> output_fp32(head_size);
+      std::vector<float> query_fp32(std::is_same_v<T, float> ? 0 : head_size);
+      std::vector<float> attention_bias_fp32(std::is_same_v<T, float> ? 0 : present_buffer_sequence_length);
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / num_heads_;
+        const size_t head_index = i % num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k_data[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+
+        const size_t kv_index = batch_index * kv_num_heads_ + head_index / kv_num_heads_factor;
+        const uint8_t* key_cache = present_cache[0] + kv_index * present_buffer_sequence_length * row_bytes;
+        const uint8_t* value_cache = present_cache[1] + kv_index * present_buffer_sequence_length * row_bytes;
+        const float* key_scales = present_scales[0] + kv_index * present_buffer_sequence_length * scales_per_token;
+        const float* value_scales = present_scales[1] + kv_index * present_buffer_sequence_length * scales_per_token;
+
+        const T* q = packed_qkv ? Q + packed_batch_stride * batch_index + chunk_length * head_index
+                                : Q + chunk_length * i;
+
+        // Attention bias is of shape (B or 1, H or 1, S, T) so handle broadcasting
+        const T* attention_bias_thread = nullptr;
+        ptrdiff_t attention_total_seqlen = 0;
+        if (attention_bias_data != nullptr) {
+          ptrdiff_t attention_bias_offset = 0;
+          attention_total_seqlen = static_cast<ptrdiff_t>(attention_bias_shape[3]);
+          const ptrdiff_t attention_matrix_size = sequence_length * attention_total_seqlen;
+          if (attention_bias_shape[0] != 1) {
+            attention_bias_offset += SafeInt<ptrdiff_t>(batch_index) * attention_bias_shape[1] * attention_matrix_size;
+          }
+          if (attention_bias_shape[1] != 1) {
+            attention_bias_offset += SafeInt<ptrdiff_t>(head_index) * attention_matrix_size;
+          }
+          attention_bias_thread = attention_bias_data + attention_bias_offset;
+        }
+
+        for (size_t seq = 0; seq < sequence_length; seq++) {
+          const size_t seq_causal_length = past_seqlen + seq + 1;
+
+          // local_window_size does not include the current query token, while window_size includes it.
+          const bool should_apply_local_window = local_window_size_ >= 0 &&
+                                                 seq_causal_length > static_cast<size_t>(local_window_size_) + 1;
+          const size_t start_offset = should_apply_local_window ? seq_causal_length - local_window_size_ - 1 : 0;
+          const size_t window_size = should_apply_local_window ? local_window_size_ + 1 : seq_causal_length;
+
+          const float* query_row;
+          if constexpr (std::is_same_v<T, float>) {
+            query_row = q + seq * head_size;
+          } else {
+            MlasConvertHalfToFloatBuffer(q + seq * head_size, query_fp32.data(), head_size);
+            query_row = query_fp32.data();
+          }
+
+          float* window_probs = probs.data();
+          MlasKvCacheQKDot(query_row, key_cache + start_offset * row_bytes, key_scales + start_offset * scales_per_token,
+                           window_size, head_size, group_size, bit_width, alpha, window_probs);
+
+          if (softcap_ > 0.f) {
+            ComputeAttentionSoftcapInplace(window_probs, static_cast<int>(window_size), softcap_);
+          }
+
+          if (attention_bias_thread != nullptr) {
+            const T* bias_row = attention_bias_thread + seq * attention_total_seqlen + start_offset;
+            if constexpr (std::is_same_v<T, float>) {
+              ApplyAttentionBias(window_probs, bias_row, static_cast<int>(window_size));
+            } else {
+              MlasConvertHalfToFloatBuffer(bias_row, attention_bias_fp32.data(), window_size);
+              ApplyAttentionBias(window_probs, attention_bias_fp32.data(), static_cast<int>(window_size));
+            }
+          }
+
+          if (use_smooth_softmax_ || head_sink != nullptr) {
+            float sink = (head_sink != nullptr) ? static_cast<float>(head_sink[head_index]) : 0.0f;
+            ComputeSmoothSoftmaxInplace(window_probs, static_cast<int>(window_size), sink, nullptr);
+          } else {
+            ComputeAttentionSoftmaxInplace(window_probs, 1, static_cast<int>(window_size), nullptr);
+          }
+
+          std::fill(output_fp32.begin(), output_fp32.end(), 0.0f);
+          MlasKvCachePVAccumulate(window_probs, value_cache + start_offset * row_bytes,
+                                  value_scales + start_offset * scales_per_token, window_size, head_size, group_size,
+                                  bit_width, output_fp32.data());
+
+          // The output has shape BxSxNxH.
+          T* output_row = output_data + (batch_index * sequence_length * num_heads_ + head_index) * head_size +
+                          seq * hidden_size;
+          if constexpr (std::is_same_v<T, float>) {
+            memcpy(output_row, output_fp32.data(), head_size * sizeof(float));
+          } else {
+            MlasConvertFloatToHalfBuffer(output_fp32.data(), output_row, head_size);
+          }
+        }
+      }
+    });
+
+    return Status::OK();
+  }
+
  private:
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
@@ -22,16 +22,19 @@ namespace onnxruntime {
 namespace contrib {
 
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                        \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
-      GroupQueryAttention,                                              \
-      kMSDomain,                                                        \
-      1,                                                                \
-      T,                                                                \
-      kCpuExecutionProvider,                                            \
-      KernelDefBuilder()                                                \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
-          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
+#define REGISTER_KERNEL_TYPED(T)                                                     \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                     \
+      GroupQueryAttention,                                                           \
+      kMSDomain,                                                                     \
+      1,                                                                             \
+      T,                                                                             \
+      kCpuExecutionProvider,                                                         \
+      KernelDefBuilder()                                                             \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                     \
+          .TypeConstraint("T_CACHE", {DataTypeImpl::GetTensorType<T>(),              \
+                                      DataTypeImpl::GetTensorType<int8_t>(),         \
+                                      DataTypeImpl::GetTensorType<uint8_t>()})       \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),              \
       GroupQueryAttention<T>);
 
 REGISTER_KERNEL_TYPED(float)
@@ -55,13 +58,18 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* position_ids = context->Input<Tensor>(9);
   const Tensor* attention_bias = context->Input<Tensor>(10);
   const Tensor* head_sink = context->Input<Tensor>(11);
+  const Tensor* past_key_scale = context->Input<Tensor>(12);
+  const Tensor* past_value_scale = context->Input<Tensor>(13);
+
+  // A quantized past cache is checked separately as its element type and head size differ from the query.
+  const bool quantized_kv_cache = kv_cache_bit_width_ != 0;
 
   GroupQueryAttentionParameters parameters = {};
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
                                                                 key,
                                                                 value,
-                                                                past_key,
-                                                                past_value,
+                                                                quantized_kv_cache ? nullptr : past_key,
+                                                                quantized_kv_cache ? nullptr : past_value,
                                                                 cos_cache,
                                                                 sin_cache,
                                                                 &parameters,
@@ -77,6 +85,21 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
                                                                                head_sink,
                                                                                parameters));
 
+  if (quantized_kv_cache) {
+    const int group_size = kv_quant_group_size_ > 0 ? kv_quant_group_size_ : parameters.head_size;
+    ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckQuantizedKVCache(past_key,
+                                                                            past_value,
+                                                                            past_key_scale,
+                                                                            past_value_scale,
+                                                                            kv_cache_bit_width_,
+                                                                            group_size,
+                                                                            parameters));
+    if (qk_output_ != static_cast<int>(QKOutputType::NO_OUTPUT)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "qk_output is not supported with a quantized key/value cache.");
+    }
+  }
+
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
   const int present_kv_seqlen = parameters.seqlen_present_kv_cache;
@@ -90,11 +113,26 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   output_shape[2] = static_cast<int64_t>(q_hidden_size);
   Tensor* output = context->Output(0, output_shape);
 
-  std::vector<int64_t> present_k_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
-  std::vector<int64_t> present_v_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
+  // An int4 cache packs two values per byte.
+  const int present_head_size = kv_cache_bit_width_ == 4 ? head_size / 2 : head_size;
+  std::vector<int64_t> present_k_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(present_head_size)});
+  std::vector<int64_t> present_v_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(present_head_size)});
   Tensor* present_k = context->Output(1, present_k_shape);
   Tensor* present_v = context->Output(2, present_v_shape);
 
+  Tensor* present_k_scale = nullptr;
+  Tensor* present_v_scale = nullptr;
+  if (quantized_kv_cache) {
+    const int group_size = kv_quant_group_size_ > 0 ? kv_quant_group_size_ : head_size;
+    std::vector<int64_t> present_scale_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size / group_size)});
+    present_k_scale = context->Output(4, present_scale_shape);
+    present_v_scale = context->Output(5, present_scale_shape);
+    if (present_k == nullptr || present_v == nullptr || present_k_scale == nullptr || present_v_scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "A quantized key/value cache requires the present key, value and scale outputs.");
+    }
+  }
+
   std::vector<int64_t> output_qk_shape{static_cast<int64_t>(batch_size), static_cast<int64_t>(num_heads_), static_cast<int64_t>(parameters.sequence_length), static_cast<int64_t>(parameters.total_sequence_length)};
   Tensor* output_qk = context->Output(3, output_qk_shape);
 
@@ -214,6 +252,14 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const T* head_sink_data = (head_sink != nullptr) ? head_sink->Data<T>() : nullptr;
 
   // Compute the attention score and apply the score to V
+  if (quantized_kv_cache) {
+    return ApplyAttentionQuantizedKV(q_rotary, packed_qkv ? nullptr : k_rotary,
+                                     packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(), head_sink_data,
+                                     attention_bias, past_key, past_value, past_key_scale, past_value_scale, output,
+                                     present_k, present_v, present_k_scale, present_v_scale, seqlens_k, parameters,
+                                     context);
+  }
+
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
                         head_sink_data, attention_bias, past_key, past_value, output, present_k, present_v,
                         output_qk, seqlens_k, parameters, allocator, context);
@@ -410,6 +410,68 @@ Status CheckOutputs(const T* output_qk, int qk_output) {
   return Status::OK();
 }
 
+// Checks a quantized past key/value cache and its scales, and sets the past and present cache lengths.
+// The cache has shape (B, N_k, S*, H) for int8 or (B, N_k, S*, H / 2) for int4, and the scales have
+// shape (B, N_k, S*, H / group_size).
+template <typename T = Tensor>
+Status CheckQuantizedKVCache(const T* past_key,
+                             const T* past_value,
+                             const T* past_key_scale,
+                             const T* past_value_scale,
+                             int kv_cache_bit_width,
+                             int kv_quant_group_size,
+                             GroupQueryAttentionParameters& parameters) {
+  const int head_size = parameters.head_size;
+  if (kv_cache_bit_width != 8 && kv_cache_bit_width != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "kv_cache_bit_width must be 0, 4 or 8. Got ", kv_cache_bit_width);
+  }
+  if (kv_quant_group_size <= 0 || kv_quant_group_size % 8 != 0 || head_size % kv_quant_group_size != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "kv_quant_group_size must be a multiple of 8 that divides head_size. Got ",
+                           kv_quant_group_size, " for head_size ", head_size);
+  }
+
+  int past_sequence_length = 0;
+  if (past_key != nullptr && past_value != nullptr) {
+    if (past_key_scale == nullptr || past_value_scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key_scale' and 'past_value_scale' are required for a quantized past_key "
+                             "and past_value.");
+    }
+
+    const int packed_head_size = kv_cache_bit_width == 8 ? head_size : head_size / 2;
+    ORT_RETURN_IF_ERROR(CheckPast(past_key, past_value, parameters.batch_size, parameters.kv_num_heads,
+                                  packed_head_size, past_sequence_length));
+
+    const bool is_int8 = kv_cache_bit_width == 8;
+    if ((is_int8 && !(past_key->template IsDataType<int8_t>() && past_value->template IsDataType<int8_t>())) ||
+        (!is_int8 && !(past_key->template IsDataType<uint8_t>() && past_value->template IsDataType<uint8_t>()))) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key' and 'past_value' shall be int8 when kv_cache_bit_width is 8, "
+                             "or uint8 when it is 4.");
+    }
+
+    const auto& past_key_dims = past_key->Shape().GetDims();
+    for (const T* scale : {past_key_scale, past_value_scale}) {
+      const auto& scale_dims = scale->Shape().GetDims();
+      if (scale_dims.size() != 4 || scale_dims[0] != past_key_dims[0] || scale_dims[1] != past_key_dims[1] ||
+          scale_dims[2] != past_key_dims[2] || scale_dims[3] != head_size / kv_quant_group_size) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Input 'past_key_scale' and 'past_value_scale' shall have shape (batch_size, "
+                               "kv_num_heads, past_sequence_length, head_size / kv_quant_group_size).");
+      }
+    }
+  } else if (past_key != nullptr || past_value != nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be both present or both absent.");
+  }
+
+  parameters.seqlen_past_kv_cache = past_sequence_length;
+  parameters.seqlen_present_kv_cache = std::max(parameters.total_sequence_length, past_sequence_length);
+  return Status::OK();
+}
+
 inline Status CheckNoQKOutput(int num_outputs, int qk_output) {
   if (num_outputs > 3) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
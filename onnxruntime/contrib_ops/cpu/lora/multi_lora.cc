@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/lora/multi_lora.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MultiLoRA,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("I", DataTypeImpl::GetTensorType<int32_t>()),
+    MultiLoRA<float>);
+
+template <typename T>
+Status MultiLoRA<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* lora_a = context->Input<Tensor>(1);
+  const Tensor* lora_b = context->Input<Tensor>(2);
+  const Tensor* adapter_ids = context->Input<Tensor>(3);
+  const Tensor* base = context->Input<Tensor>(4);
+
+  const auto& input_dims = input->Shape().GetDims();
+  const auto& lora_a_dims = lora_a->Shape().GetDims();
+  const auto& lora_b_dims = lora_b->Shape().GetDims();
+
+  ORT_RETURN_IF_NOT(input_dims.size() == 2 || input_dims.size() == 3,
+                    "input is expected to have 2 or 3 dimensions, got ", input_dims.size());
+  ORT_RETURN_IF_NOT(lora_a_dims.size() == 3, "lora_a is expected to have 3 dimensions, got ", lora_a_dims.size());
+  ORT_RETURN_IF_NOT(lora_b_dims.size() == 3, "lora_b is expected to have 3 dimensions, got ", lora_b_dims.size());
+
+  const int64_t batch_size = input_dims[0];
+  const int64_t hidden_size = input_dims.back();
+  const int64_t num_adapters = lora_a_dims[0];
+  const int64_t rank = lora_a_dims[2];
+  const int64_t output_size = lora_b_dims[2];
+
+  ORT_RETURN_IF_NOT(lora_a_dims[1] == hidden_size, "lora_a dimension 1 should be hidden_size ", hidden_size,
+                    ", got ", lora_a_dims[1]);
+  ORT_RETURN_IF_NOT(lora_b_dims[0] == num_adapters && lora_b_dims[1] == rank,
+                    "lora_b is expected to have shape (", num_adapters, ", ", rank, ", output_size)");
+  ORT_RETURN_IF_NOT(adapter_ids->Shape().NumDimensions() == 1 && adapter_ids->Shape()[0] == batch_size,
+                    "adapter_ids is expected to have shape (", batch_size, ")");
+
+  TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
+  output_dims.back() = output_size;
+  const TensorShape output_shape(output_dims);
+
+  Tensor* output = context->Output(0, output_shape);
+  float* output_data = output->MutableData<float>();
+
+  if (base != nullptr) {
+    ORT_RETURN_IF_NOT(base->Shape() == output_shape, "base is expected to have shape ", output_shape,
+                      ", got ", base->Shape());
+    std::copy_n(base->Data<float>(), output_shape.Size(), output_data);
+  } else {
+    std::fill_n(output_data, output_shape.Size(), 0.0f);
+  }
+
+  const size_t sequence_length = input_dims.size() == 3 ? static_cast<size_t>(input_dims[1]) : 1;
+  const size_t num_rows = SafeInt<size_t>(batch_size) * sequence_length;
+  if (num_rows == 0 || output_size == 0) {
+    return Status::OK();
+  }
+
+  // Every row of a batch entry uses the adapter of the entry.
+  const int32_t* ids = adapter_ids->Data<int32_t>();
+  std::vector<int32_t> row_adapter_ids(num_rows);
+  for (int64_t b = 0; b < batch_size; b++) {
+    ORT_RETURN_IF_NOT(ids[b] >= 0 && ids[b] < num_adapters, "adapter_ids[", b, "] = ", ids[b], " is out of range [0, ",
+                      num_adapters, ")");
+    std::fill_n(row_adapter_ids.begin() + static_cast<size_t>(b) * sequence_length, sequence_length, ids[b]);
+  }
+
+  const size_t lora_a_size = static_cast<size_t>(hidden_size * rank);
+  const size_t lora_b_size = static_cast<size_t>(rank * output_size);
+  std::vector<const float*> lora_a_data(static_cast<size_t>(num_adapters));
+  std::vector<const float*> lora_b_data(static_cast<size_t>(num_adapters));
+  for (size_t i = 0; i < lora_a_data.size(); i++) {
+    lora_a_data[i] = lora_a->Data<float>() + i * lora_a_size;
+    lora_b_data[i] = lora_b->Data<float>() + i * lora_b_size;
+  }
+
+  MlasLoraSgmv(num_rows, static_cast<size_t>(output_size), static_cast<size_t>(hidden_size),
+               static_cast<size_t>(rank), input->Data<float>(), static_cast<size_t>(hidden_size),
+               row_adapter_ids.data(), lora_a_data.data(), lora_b_data.data(), scale_, output_data,
+               static_cast<size_t>(output_size), context->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
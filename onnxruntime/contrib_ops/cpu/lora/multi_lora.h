@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LoRA update with a per batch entry adapter selection. The rows of all batch entries are computed by one
+// segmented low-rank GEMM (SGMV), so requests for different adapters share a single Run.
+template <typename T>
+class MultiLoRA final : public OpKernel {
+ public:
+  explicit MultiLoRA(const OpKernelInfo& info) : OpKernel(info) {
+    scale_ = info.GetAttrOrDefault<float>("scale", 1.0f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/framework/tensor_shape.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+enum class MoEActivationType {
+  Relu,
+  Gelu,
+  Silu,
+  SwiGLU,
+  Identity,
+};
+
+enum class MoEQuantType {
+  None = 0,
+  UINT4 = 1,
+  UINT8 = 2,
+};
+
+struct MoEParameters {
+  int64_t num_rows;
+  int64_t num_experts;
+  int64_t hidden_size;
+  int64_t inter_size;
+};
+
+// Attribute parsing and input validation shared by the CPU MoE and QMoE kernels.
+// This mirrors contrib_ops/cuda/moe/moe_base.h without the expert and tensor parallel options.
+class MoEBaseCPU {
+ public:
+  Status CheckInputs(MoEParameters& parameters, MoEQuantType quant_type, const Tensor* input,
+                     const Tensor* router_probs, const Tensor* fc1_experts_weights,
+                     const Tensor* fc1_experts_bias_optional, const Tensor* fc2_experts_weights,
+                     const Tensor* fc2_experts_bias_optional, const Tensor* fc3_experts_weights_optional,
+                     const Tensor* fc3_experts_bias_optional) const {
+    const auto& input_dims = input->Shape().GetDims();
+    const auto& router_probs_dims = router_probs->Shape().GetDims();
+    const auto& fc1_experts_weights_dims = fc1_experts_weights->Shape().GetDims();
+    const auto& fc2_experts_weights_dims = fc2_experts_weights->Shape().GetDims();
+
+    if (input_dims.size() != 2 && input_dims.size() != 3) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input must be 2D or 3D, got ", input_dims.size());
+    }
+    if (fc1_experts_weights_dims.size() != 3) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc1_experts_weights_dims must be 3D, got ",
+                             fc1_experts_weights_dims.size());
+    }
+    if (fc2_experts_weights_dims.size() != 3) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc2_experts_weights_dims must be 3D, got ",
+                             fc2_experts_weights_dims.size());
+    }
+    if (router_probs_dims.size() != 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "router_probs_dims must be 2D, got ",
+                             router_probs_dims.size());
+    }
+
+    const int64_t num_rows = input_dims.size() == 2 ? input_dims[0] : input_dims[0] * input_dims[1];
+    const int64_t hidden_size = input_dims[input_dims.size() - 1];
+    const int64_t num_experts = router_probs_dims[1];
+    const int64_t inter_size = fc2_experts_weights_dims[1];
+
+    if (fc1_experts_weights_dims[0] != num_experts || fc2_experts_weights_dims[0] != num_experts) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "Expert parallelism is not supported on CPU. The number of experts in the weights (",
+                             fc1_experts_weights_dims[0], ", ", fc2_experts_weights_dims[0],
+                             ") must be equal to the number of experts in router_probs (", num_experts, ")");
+    }
+    if (fc1_experts_weights_dims[1] != hidden_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "fc1_experts_weights_dims[1] must be equal to hidden_size, got ",
+                             fc1_experts_weights_dims[1], " and ", hidden_size);
+    }
+
+    const int64_t coe = quant_type == MoEQuantType::UINT4 ? 2 : 1;
+    const int64_t act = activation_type_ == MoEActivationType::SwiGLU ? 2 : 1;
+    if (fc1_experts_weights_dims[2] != act * inter_size / coe) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "fc1_experts_weights_dims[2] is ",
+                             fc1_experts_weights_dims[2], " expected ", act * inter_size / coe);
+    }
+    if (fc2_experts_weights_dims[2] != hidden_size / coe) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "fc2_experts_weights_dims[2] is ",
+                             fc2_experts_weights_dims[2], " expected ", hidden_size / coe);
+    }
+    if (coe == 2 && ((act * inter_size) % 2 != 0 || hidden_size % 2 != 0)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "4 bit weights require even hidden_size and inter_size, got ", hidden_size, " and ",
+                             inter_size);
+    }
+    if (router_probs_dims[0] != num_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "router_probs_dims[0] must be equal to num_rows, got ",
+                             router_probs_dims[0], " and ", num_rows);
+    }
+    if (k_ <= 0 || k_ > num_experts) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "k must be in the range [1, num_experts], got ", k_,
+                             " and num_experts ", num_experts);
+    }
+
+    ORT_RETURN_IF_ERROR(CheckBias(fc1_experts_bias_optional, "fc1_experts_bias", num_experts, act * inter_size));
+    ORT_RETURN_IF_ERROR(CheckBias(fc2_experts_bias_optional, "fc2_experts_bias", num_experts, hidden_size));
+
+    if (fc3_experts_weights_optional != nullptr) {
+      if (activation_type_ == MoEActivationType::SwiGLU) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "SwiGLU activation is not supported with fc3");
+      }
+      if (fc3_experts_weights_optional->Shape().GetDims() != fc1_experts_weights_dims) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "fc3_experts_weights_dims must be equal to fc1_experts_weights_dims, got ",
+                               fc3_experts_weights_optional->Shape(), " and ", TensorShape(fc1_experts_weights_dims));
+      }
+      ORT_RETURN_IF_ERROR(CheckBias(fc3_experts_bias_optional, "fc3_experts_bias", num_experts, inter_size));
+    } else if (fc3_experts_bias_optional != nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "fc3_experts_bias requires fc3_experts_weights");
+    }
+
+    parameters.num_rows = num_rows;
+    parameters.num_experts = num_experts;
+    parameters.hidden_size = hidden_size;
+    parameters.inter_size = inter_size;
+    return Status::OK();
+  }
+
+  Status CheckInputScales(const Tensor* fc1_experts_scales, const Tensor* fc2_experts_scales,
+                          const Tensor* fc3_experts_scales, int64_t num_experts, int64_t hidden_size,
+                          int64_t inter_size) const {
+    const int64_t act = activation_type_ == MoEActivationType::SwiGLU ? 2 : 1;
+    ORT_RETURN_IF_ERROR(CheckBias(fc1_experts_scales, "fc1_scales", num_experts, act * inter_size));
+    ORT_RETURN_IF_ERROR(CheckBias(fc2_experts_scales, "fc2_scales", num_experts, hidden_size));
+    if (fc3_experts_scales != nullptr) {
+      ORT_RETURN_IF_ERROR(CheckBias(fc3_experts_scales, "fc3_scales", num_experts, inter_size));
+    }
+    return Status::OK();
+  }
+
+ protected:
+  MoEBaseCPU(const OpKernelInfo& op_kernel_info) {
+    ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("k", &k_).IsOK());
+
+    std::string activation_type_str;
+    ORT_ENFORCE(op_kernel_info.GetAttr<std::string>("activation_type", &activation_type_str).IsOK());
+    if (activation_type_str == "relu") {
+      activation_type_ = MoEActivationType::Relu;
+    } else if (activation_type_str == "gelu") {
+      activation_type_ = MoEActivationType::Gelu;
+    } else if (activation_type_str == "silu") {
+      activation_type_ = MoEActivationType::Silu;
+    } else if (activation_type_str == "swiglu") {
+      activation_type_ = MoEActivationType::SwiGLU;
+    } else if (activation_type_str == "identity") {
+      activation_type_ = MoEActivationType::Identity;
+    } else {
+      ORT_THROW("Unsupported MoE activation type: ", activation_type_str);
+    }
+
+    normalize_routing_weights_ = op_kernel_info.GetAttrOrDefault<int64_t>("normalize_routing_weights", 0) == 1;
+
+    // The sparse mixer routing (jittered top-2) is only implemented by the CUDA kernel.
+    ORT_ENFORCE(op_kernel_info.GetAttrOrDefault<int64_t>("use_sparse_mixer", 0) == 0,
+                "use_sparse_mixer is not supported by the CPU MoE kernels");
+  }
+
+  bool normalize_routing_weights_;
+  int64_t k_;
+  MoEActivationType activation_type_;
+
+  static Status CheckBias(const Tensor* bias, const char* name, int64_t num_experts, int64_t size) {
+    if (bias == nullptr) {
+      return Status::OK();
+    }
+    const auto& dims = bias->Shape().GetDims();
+    if (dims.size() != 2 || dims[0] != num_experts || dims[1] != size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " must have shape (", num_experts, ", ", size,
+                             "), got ", bias->Shape());
+    }
+    return Status::OK();
+  }
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
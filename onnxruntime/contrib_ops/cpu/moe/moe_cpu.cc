@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/moe/moe_cpu.h"
+
+#include <vector>
+
+#include "contrib_ops/cpu/moe/moe_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MoE,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MoE<float>);
+
+template <typename T>
+MoE<T>::MoE(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info), MoEBaseCPU(op_kernel_info) {
+}
+
+template <typename T>
+Status MoE<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* router_probs = context->Input<Tensor>(1);
+  const Tensor* fc1_experts_weights = context->Input<Tensor>(2);
+  const Tensor* fc1_experts_bias_optional = context->Input<Tensor>(3);
+  const Tensor* fc2_experts_weights = context->Input<Tensor>(4);
+  const Tensor* fc2_experts_bias_optional = context->Input<Tensor>(5);
+  const Tensor* fc3_experts_weights_optional = context->Input<Tensor>(6);
+  const Tensor* fc3_experts_bias_optional = context->Input<Tensor>(7);
+
+  MoEParameters moe_params;
+  ORT_RETURN_IF_ERROR(CheckInputs(moe_params, MoEQuantType::None, input, router_probs, fc1_experts_weights,
+                                  fc1_experts_bias_optional, fc2_experts_weights, fc2_experts_bias_optional,
+                                  fc3_experts_weights_optional, fc3_experts_bias_optional));
+
+  Tensor* output = context->Output(0, input->Shape());
+  if (moe_params.num_rows == 0) {
+    return Status::OK();
+  }
+
+  MoERouting routing;
+  ComputeMoERouting(router_probs->Data<float>(), moe_params.num_rows, moe_params.num_experts, k_,
+                    normalize_routing_weights_, routing, context->GetOperatorThreadPool());
+
+  const size_t num_experts = static_cast<size_t>(moe_params.num_experts);
+  const size_t hidden_size = static_cast<size_t>(moe_params.hidden_size);
+  const size_t inter_size = static_cast<size_t>(moe_params.inter_size);
+  const size_t fc1_output_size = activation_type_ == MoEActivationType::SwiGLU ? 2 * inter_size : inter_size;
+  const bool has_fc3 = fc3_experts_weights_optional != nullptr;
+
+  std::vector<const float*> fc1_weights(num_experts);
+  std::vector<const float*> fc2_weights(num_experts);
+  std::vector<const float*> fc3_weights(has_fc3 ? num_experts : 0);
+  for (size_t e = 0; e < num_experts; e++) {
+    fc1_weights[e] = fc1_experts_weights->Data<float>() + e * hidden_size * fc1_output_size;
+    fc2_weights[e] = fc2_experts_weights->Data<float>() + e * inter_size * hidden_size;
+    if (has_fc3) {
+      fc3_weights[e] = fc3_experts_weights_optional->Data<float>() + e * hidden_size * inter_size;
+    }
+  }
+
+  return RunMoEExperts(
+      context, moe_params, activation_type_, k_, routing, input->Data<float>(),
+      fc1_weights.data(), fc1_experts_bias_optional == nullptr ? nullptr : fc1_experts_bias_optional->Data<float>(),
+      fc2_weights.data(), fc2_experts_bias_optional == nullptr ? nullptr : fc2_experts_bias_optional->Data<float>(),
+      has_fc3 ? fc3_weights.data() : nullptr,
+      fc3_experts_bias_optional == nullptr ? nullptr : fc3_experts_bias_optional->Data<float>(),
+      output->MutableData<float>());
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,311 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/moe/moe_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// One FC layer of the experts: C[rows of e] = A[rows of e] * expert_weights[e] for every expert e with routed rows.
+// A and C are indexed by permuted row.
+struct MoEExpertGemm {
+  const float* A;
+  size_t lda;
+  const float* const* expert_weights;
+  size_t K;
+  size_t N;
+  float* C;
+  size_t ldc;
+};
+
+// Runs the given FC layers for all experts with a single grouped SGEMM call, so that experts with few rows and the
+// independent layers (fc1 and fc3) share the thread pool instead of running one after another.
+void RunMoEExpertGemms(const MoEExpertGemm* gemms, size_t gemm_count, const MoERouting& routing,
+                       concurrency::ThreadPool* thread_pool) {
+  const size_t num_experts = routing.expert_offsets.size() - 1;
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data;
+  std::vector<MLAS_SGEMM_GROUP_PARAMS> groups;
+  data.reserve(gemm_count * num_experts);
+  groups.reserve(gemm_count * num_experts);
+
+  for (size_t g = 0; g < gemm_count; g++) {
+    const MoEExpertGemm& gemm = gemms[g];
+    for (size_t e = 0; e < num_experts; e++) {
+      const size_t row_start = static_cast<size_t>(routing.expert_offsets[e]);
+      const size_t row_count = static_cast<size_t>(routing.expert_offsets[e + 1]) - row_start;
+      if (row_count == 0) {
+        continue;
+      }
+
+      MLAS_SGEMM_DATA_PARAMS& params = data.emplace_back();
+      params.A = gemm.A + row_start * gemm.lda;
+      params.lda = gemm.lda;
+      params.B = gemm.expert_weights[e];
+      params.ldb = gemm.N;
+      params.C = gemm.C + row_start * gemm.ldc;
+      params.ldc = gemm.ldc;
+
+      MLAS_SGEMM_GROUP_PARAMS& group = groups.emplace_back();
+      group.M = row_count;
+      group.N = gemm.N;
+      group.K = gemm.K;
+      group.Data = &params;
+      group.BatchSize = 1;
+    }
+  }
+
+  MlasGemmGrouped(groups.data(), groups.size(), thread_pool);
+}
+
+}  // namespace
+
+void ComputeMoERouting(const float* router_logits, int64_t num_rows, int64_t num_experts, int64_t k,
+                       bool normalize_routing_weights, MoERouting& routing,
+                       concurrency::ThreadPool* thread_pool) {
+  const size_t expanded_rows = static_cast<size_t>(num_rows * k);
+  routing.expert_for_expanded_row.resize(expanded_rows);
+  routing.routing_weights.resize(expanded_rows);
+  routing.expert_offsets.assign(static_cast<size_t>(num_experts) + 1, 0);
+  routing.permuted_to_expanded_row.resize(expanded_rows);
+  routing.expanded_to_permuted_row.resize(expanded_rows);
+
+  // The softmax and the top k selection are fused: only the k selected probabilities are written out.
+  const double cost = static_cast<double>(num_experts) * (8.0 + static_cast<double>(k));
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_rows), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> probs(static_cast<size_t>(num_experts));
+        std::vector<int32_t> order(static_cast<size_t>(num_experts));
+
+        for (std::ptrdiff_t row = begin; row < end; row++) {
+          const float* logits = router_logits + row * num_experts;
+          const float max_logit = *std::max_element(logits, logits + num_experts);
+
+          float sum = 0.0f;
+          for (int64_t e = 0; e < num_experts; e++) {
+            probs[e] = std::exp(logits[e] - max_logit);
+            sum += probs[e];
+          }
+
+          // Ties select the lower expert index first.
+          std::iota(order.begin(), order.end(), 0);
+          std::partial_sort(order.begin(), order.begin() + k, order.end(), [&probs](int32_t a, int32_t b) {
+            return probs[a] > probs[b] || (probs[a] == probs[b] && a < b);
+          });
+
+          float selected_sum = 0.0f;
+          for (int64_t k_idx = 0; k_idx < k; k_idx++) {
+            selected_sum += probs[order[k_idx]];
+          }
+
+          const float scale = 1.0f / (normalize_routing_weights ? selected_sum : sum);
+          for (int64_t k_idx = 0; k_idx < k; k_idx++) {
+            const size_t expanded_row = static_cast<size_t>(row * k + k_idx);
+            routing.expert_for_expanded_row[expanded_row] = order[k_idx];
+            routing.routing_weights[expanded_row] = probs[order[k_idx]] * scale;
+          }
+        }
+      });
+
+  // Counting sort of the expanded rows by expert. The sort is stable so the rows of an expert keep the token order.
+  for (size_t i = 0; i < expanded_rows; i++) {
+    routing.expert_offsets[static_cast<size_t>(routing.expert_for_expanded_row[i]) + 1]++;
+  }
+  std::partial_sum(routing.expert_offsets.begin(), routing.expert_offsets.end(), routing.expert_offsets.begin());
+
+  std::vector<int32_t> next(routing.expert_offsets.begin(), routing.expert_offsets.end() - 1);
+  for (size_t i = 0; i < expanded_rows; i++) {
+    const int32_t permuted_row = next[static_cast<size_t>(routing.expert_for_expanded_row[i])]++;
+    routing.permuted_to_expanded_row[static_cast<size_t>(permuted_row)] = static_cast<int32_t>(i);
+    routing.expanded_to_permuted_row[i] = permuted_row;
+  }
+}
+
+void GatherMoERows(const float* input, const MoERouting& routing, int64_t k, int64_t hidden_size,
+                   float* permuted_input, concurrency::ThreadPool* thread_pool) {
+  const size_t row_bytes = static_cast<size_t>(hidden_size) * sizeof(float);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(routing.permuted_to_expanded_row.size()),
+      TensorOpCost{static_cast<double>(row_bytes), static_cast<double>(row_bytes), 0.0},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i < end; i++) {
+          const int64_t source_row = routing.permuted_to_expanded_row[static_cast<size_t>(i)] / k;
+          std::memcpy(permuted_input + i * hidden_size, input + source_row * hidden_size, row_bytes);
+        }
+      });
+}
+
+void ApplyMoEActivation(MoEActivationType activation_type, const MoERouting& routing, int64_t inter_size,
+                        float* fc1_output, const float* fc1_bias, const float* fc3_output, const float* fc3_bias,
+                        concurrency::ThreadPool* thread_pool) {
+  const bool is_swiglu = activation_type == MoEActivationType::SwiGLU;
+  const int64_t fc1_output_size = is_swiglu ? 2 * inter_size : inter_size;
+  const size_t permuted_rows = routing.permuted_to_expanded_row.size();
+
+  std::vector<int32_t> expert_for_permuted_row(permuted_rows);
+  for (size_t e = 0; e + 1 < routing.expert_offsets.size(); e++) {
+    std::fill(expert_for_permuted_row.begin() + routing.expert_offsets[e],
+              expert_for_permuted_row.begin() + routing.expert_offsets[e + 1], static_cast<int32_t>(e));
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(permuted_rows), static_cast<double>(fc1_output_size) * 8.0,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> scratch(static_cast<size_t>(inter_size));
+
+        for (std::ptrdiff_t i = begin; i < end; i++) {
+          const int64_t expert = expert_for_permuted_row[static_cast<size_t>(i)];
+          float* row = fc1_output + i * fc1_output_size;
+
+          if (fc1_bias != nullptr) {
+            const float* bias = fc1_bias + expert * fc1_output_size;
+            for (int64_t j = 0; j < fc1_output_size; j++) {
+              row[j] += bias[j];
+            }
+          }
+
+          switch (activation_type) {
+            case MoEActivationType::Relu:
+              for (int64_t j = 0; j < inter_size; j++) {
+                row[j] = std::max(row[j], 0.0f);
+              }
+              break;
+            case MoEActivationType::Gelu: {
+              // Tanh approximation, as used by the FasterTransformer MoE kernels.
+              constexpr float kAlpha = 0.7978845608028654f;  // sqrt(2/pi)
+              constexpr float kBeta = 0.044715f;
+              for (int64_t j = 0; j < inter_size; j++) {
+                scratch[j] = kAlpha * row[j] * (1.0f + kBeta * row[j] * row[j]);
+              }
+              MlasComputeTanh(scratch.data(), scratch.data(), static_cast<size_t>(inter_size));
+              for (int64_t j = 0; j < inter_size; j++) {
+                row[j] = 0.5f * row[j] * (1.0f + scratch[j]);
+              }
+              break;
+            }
+            case MoEActivationType::Silu:
+              MlasComputeLogistic(row, scratch.data(), static_cast<size_t>(inter_size));
+              for (int64_t j = 0; j < inter_size; j++) {
+                row[j] *= scratch[j];
+              }
+              break;
+            case MoEActivationType::SwiGLU: {
+              // Interleaved gate and linear values: y = g * sigmoid(alpha * g) * (l + 1).
+              constexpr float kSwiGLUAlpha = 1.702f;
+              for (int64_t j = 0; j < inter_size; j++) {
+                scratch[j] = kSwiGLUAlpha * row[2 * j];
+              }
+              MlasComputeLogistic(scratch.data(), scratch.data(), static_cast<size_t>(inter_size));
+              // Writing row[j] only overwrites values that were already consumed.
+              for (int64_t j = 0; j < inter_size; j++) {
+                row[j] = row[2 * j] * scratch[j] * (row[2 * j + 1] + 1.0f);
+              }
+              break;
+            }
+            case MoEActivationType::Identity:
+              break;
+          }
+
+          if (fc3_output != nullptr) {
+            const float* gate = fc3_output + i * inter_size;
+            const float* bias = fc3_bias != nullptr ? fc3_bias + expert * inter_size : nullptr;
+            for (int64_t j = 0; j < inter_size; j++) {
+              row[j] *= gate[j] + (bias != nullptr ? bias[j] : 0.0f);
+            }
+          }
+        }
+      });
+}
+
+void CombineMoERows(const float* fc2_output, const float* fc2_bias, const MoERouting& routing, int64_t num_rows,
+                    int64_t k, int64_t hidden_size, float* output, concurrency::ThreadPool* thread_pool) {
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_rows),
+      TensorOpCost{static_cast<double>(k * hidden_size * sizeof(float)),
+                   static_cast<double>(hidden_size * sizeof(float)), static_cast<double>(k * hidden_size * 2)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; row++) {
+          float* out = output + row * hidden_size;
+          std::fill_n(out, hidden_size, 0.0f);
+
+          for (int64_t k_idx = 0; k_idx < k; k_idx++) {
+            const size_t expanded_row = static_cast<size_t>(row * k + k_idx);
+            const float weight = routing.routing_weights[expanded_row];
+            const int64_t expert = routing.expert_for_expanded_row[expanded_row];
+            const float* expert_row = fc2_output + routing.expanded_to_permuted_row[expanded_row] * hidden_size;
+
+            if (fc2_bias != nullptr) {
+              const float* bias = fc2_bias + expert * hidden_size;
+              for (int64_t j = 0; j < hidden_size; j++) {
+                out[j] += weight * (expert_row[j] + bias[j]);
+              }
+            } else {
+              for (int64_t j = 0; j < hidden_size; j++) {
+                out[j] += weight * expert_row[j];
+              }
+            }
+          }
+        }
+      });
+}
+
+Status RunMoEExperts(OpKernelContext* context, const MoEParameters& moe_params, MoEActivationType activation_type,
+                     int64_t k, const MoERouting& routing, const float* input,
+                     const float* const* fc1_weights, const float* fc1_bias,
+                     const float* const* fc2_weights, const float* fc2_bias,
+                     const float* const* fc3_weights, const float* fc3_bias, float* output) {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const size_t hidden_size = static_cast<size_t>(moe_params.hidden_size);
+  const size_t inter_size = static_cast<size_t>(moe_params.inter_size);
+  const size_t fc1_output_size = activation_type == MoEActivationType::SwiGLU ? 2 * inter_size : inter_size;
+  const size_t expanded_rows = routing.permuted_to_expanded_row.size();
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto permuted_input = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * hidden_size);
+  auto fc1_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * fc1_output_size);
+  auto fc2_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * hidden_size);
+  IAllocatorUniquePtr<float> fc3_output;
+  if (fc3_weights != nullptr) {
+    fc3_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * inter_size);
+  }
+
+  GatherMoERows(input, routing, k, moe_params.hidden_size, permuted_input.get(), thread_pool);
+
+  // fc1 and fc3 read the same rows and are independent, so they run in one grouped call.
+  const MoEExpertGemm fc1_fc3[] = {
+      {permuted_input.get(), hidden_size, fc1_weights, hidden_size, fc1_output_size, fc1_output.get(),
+       fc1_output_size},
+      {permuted_input.get(), hidden_size, fc3_weights, hidden_size, inter_size, fc3_output.get(), inter_size},
+  };
+  RunMoEExpertGemms(fc1_fc3, fc3_weights != nullptr ? 2 : 1, routing, thread_pool);
+
+  ApplyMoEActivation(activation_type, routing, moe_params.inter_size, fc1_output.get(), fc1_bias, fc3_output.get(),
+                     fc3_bias, thread_pool);
+
+  // The activation leaves its result in the first inter_size columns of each fc1 output row.
+  const MoEExpertGemm fc2 = {fc1_output.get(), fc1_output_size, fc2_weights, inter_size, hidden_size,
+                             fc2_output.get(), hidden_size};
+  RunMoEExpertGemms(&fc2, 1, routing, thread_pool);
+
+  CombineMoERows(fc2_output.get(), fc2_bias, routing, moe_params.num_rows, k, moe_params.hidden_size, output,
+                 thread_pool);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "contrib_ops/cpu/moe/moe_base_cpu.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Token to expert assignment computed from the router logits.
+//
+// Every (row, k) pair is an "expanded row" with index row * k + k_idx. The expanded rows are sorted by the expert
+// they are routed to, so that the rows of each expert are contiguous and can be computed with a single GEMM per
+// expert. The rows of expert e occupy [expert_offsets[e], expert_offsets[e + 1]) in permuted order.
+struct MoERouting {
+  std::vector<int32_t> expert_for_expanded_row;   // num_rows * k
+  std::vector<float> routing_weights;             // num_rows * k
+  std::vector<int32_t> expert_offsets;            // num_experts + 1
+  std::vector<int32_t> permuted_to_expanded_row;  // num_rows * k
+  std::vector<int32_t> expanded_to_permuted_row;  // num_rows * k
+
+  int64_t ExpertRowCount(int64_t expert) const {
+    return expert_offsets[static_cast<size_t>(expert) + 1] - expert_offsets[static_cast<size_t>(expert)];
+  }
+};
+
+// Selects the top k experts of every row with a softmax over the router logits and sorts the expanded rows by
+// expert. The selected weights are renormalized to sum to one when normalize_routing_weights is set.
+void ComputeMoERouting(const float* router_logits, int64_t num_rows, int64_t num_experts, int64_t k,
+                       bool normalize_routing_weights, MoERouting& routing,
+                       concurrency::ThreadPool* thread_pool);
+
+// Copies the input rows into permuted order: permuted[i] = input[permuted_to_expanded_row[i] / k].
+void GatherMoERows(const float* input, const MoERouting& routing, int64_t k, int64_t hidden_size,
+                   float* permuted_input, concurrency::ThreadPool* thread_pool);
+
+// Adds the fc1 bias and applies the activation to the fc1 output of every permuted row in place. When fc3 output is
+// given, the activated value is multiplied by (fc3 + fc3 bias). For SwiGLU the fc1 output has 2 * inter_size columns
+// holding interleaved gate and linear values, and the first inter_size columns of each row receive the result.
+void ApplyMoEActivation(MoEActivationType activation_type, const MoERouting& routing, int64_t inter_size,
+                        float* fc1_output, const float* fc1_bias, const float* fc3_output, const float* fc3_bias,
+                        concurrency::ThreadPool* thread_pool);
+
+// Computes output[row] = sum over k of routing_weight * (fc2_output[permuted row] + fc2_bias[expert]).
+void CombineMoERows(const float* fc2_output, const float* fc2_bias, const MoERouting& routing, int64_t num_rows,
+                    int64_t k, int64_t hidden_size, float* output, concurrency::ThreadPool* thread_pool);
+
+// Runs the routed rows through the expert FC layers and combines the results into output. The weights of every expert
+// are row major (K, N) float matrices, one pointer per expert. Only the experts that receive rows are read, so the
+// entries of the other experts may be nullptr. fc3_weights is nullptr when there is no fc3 layer.
+Status RunMoEExperts(OpKernelContext* context, const MoEParameters& moe_params, MoEActivationType activation_type,
+                     int64_t k, const MoERouting& routing, const float* input,
+                     const float* const* fc1_weights, const float* fc1_bias,
+                     const float* const* fc2_weights, const float* fc2_bias,
+                     const float* const* fc3_weights, const float* fc3_bias, float* output);
+
+}  // namespace contrib
+}  // namespace onnxruntime
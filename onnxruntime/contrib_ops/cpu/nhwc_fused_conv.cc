@@ -0,0 +1,354 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/util/math.h"
+
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+using ConvPadVector = ConvAttributes::ConvPadVector;
+
+/**
+ * @brief Channels last convolution for fp32 tensors.
+ *
+ * Input and output are NHWC. Instead of expanding the input with im2col, every output pixel gets an
+ * indirection buffer entry of kernel_size pointers into the input image, and MLAS gathers the patches
+ * of a few output pixels at a time while computing (see MlasConvIndirect). The scratch memory is
+ * one pointer per kernel position per output pixel instead of a float per kernel element.
+ *
+ * The optional input Z is added to the output before the activation.
+ */
+class NhwcFusedConvFloat final : public OpKernel {
+ public:
+  NhwcFusedConvFloat(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+ private:
+  /**
+   * @brief Returns the size in bytes of the packed filter. Depthwise filters are reordered to
+   *        (kernel_size x channels), other filters are packed per group with MlasConvIndirectPackW.
+   */
+  size_t PackedFilterSize(const TensorShape& W_shape) const;
+
+  void PackFilter(const float* W_data, const TensorShape& W_shape, void* packed_W) const;
+
+  bool IsDepthwise(const TensorShape& W_shape) const {
+    return W_shape[1] == 1 && W_shape[0] == conv_attrs_.group;
+  }
+
+  MLAS_ACTIVATION activation_;
+  ConvAttributes conv_attrs_;
+  TensorShape W_shape_;
+  BufferUniquePtr packed_W_buffer_;
+};
+
+size_t NhwcFusedConvFloat::PackedFilterSize(const TensorShape& W_shape) const {
+  const size_t output_channels = static_cast<size_t>(W_shape[0]);
+  const size_t group_input_channels = static_cast<size_t>(W_shape[1]);
+  const size_t kernel_size = static_cast<size_t>(W_shape.SizeFromDimension(2));
+
+  if (IsDepthwise(W_shape)) {
+    return SafeInt<size_t>(sizeof(float)) * output_channels * kernel_size;
+  }
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  return SafeInt<size_t>(group_count) *
+         MlasConvIndirectPackWSize(output_channels / group_count, group_input_channels, kernel_size);
+}
+
+void NhwcFusedConvFloat::PackFilter(const float* W_data, const TensorShape& W_shape, void* packed_W) const {
+  const size_t output_channels = static_cast<size_t>(W_shape[0]);
+  const size_t group_input_channels = static_cast<size_t>(W_shape[1]);
+  const size_t kernel_size = static_cast<size_t>(W_shape.SizeFromDimension(2));
+
+  if (IsDepthwise(W_shape)) {
+    // (M x 1 x kH x kW) -> (kH x kW x M)
+    auto* reordered_W = static_cast<float*>(packed_W);
+    for (size_t k = 0; k < kernel_size; k++) {
+      for (size_t oc = 0; oc < output_channels; oc++) {
+        *reordered_W++ = W_data[oc * kernel_size + k];
+      }
+    }
+    return;
+  }
+
+  // Reorder every group from (M/group x C/group x kH x kW) to (kH x kW x C/group) x M/group before packing.
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t group_output_channels = output_channels / group_count;
+  const size_t kernel_dim = group_input_channels * kernel_size;
+  const size_t packed_W_size = MlasConvIndirectPackWSize(group_output_channels, group_input_channels, kernel_size);
+
+  std::vector<float> group_reordered_W(kernel_dim * group_output_channels);
+
+  for (size_t group_id = 0; group_id < group_count; group_id++) {
+    const float* group_W = W_data + group_id * group_output_channels * kernel_dim;
+    float* reordered = group_reordered_W.data();
+    for (size_t k = 0; k < kernel_size; k++) {
+      for (size_t ic = 0; ic < group_input_channels; ic++) {
+        for (size_t oc = 0; oc < group_output_channels; oc++) {
+          *reordered++ = group_W[(oc * group_input_channels + ic) * kernel_size + k];
+        }
+      }
+    }
+
+    MlasConvIndirectPackW(group_output_channels, group_input_channels, kernel_size, group_reordered_W.data(),
+                          group_output_channels, static_cast<uint8_t*>(packed_W) + group_id * packed_W_size);
+  }
+}
+
+Status NhwcFusedConvFloat::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+  if (input_idx != 1) {
+    // Only pack filter tensor (aka weights)
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  if (shape.NumDimensions() <= 2 || shape[0] % conv_attrs_.group != 0) {
+    // Leave invalid shapes to be reported by Compute.
+    return Status::OK();
+  }
+
+  const size_t packed_W_size = PackedFilterSize(shape);
+  auto* packed_W = alloc->Alloc(packed_W_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we do not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_W, 0, packed_W_size);
+
+  packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(alloc));
+  PackFilter(tensor.Data<float>(), shape, packed_W);
+  W_shape_ = shape;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status NhwcFusedConvFloat::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                     int input_idx,
+                                                     /*out*/ bool& used_shared_buffers) {
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  used_shared_buffers = true;
+  packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  return Status::OK();
+}
+
+Status NhwcFusedConvFloat::Compute(OpKernelContext* context) const {
+  const size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = packed_W_buffer_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : W_shape_;
+  const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
+  const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, true));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+  const size_t kernel_rank = kernel_shape.size();
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1 + kernel_rank];
+  const int64_t M = W_shape[0];
+
+  TensorShapeVector Y_dims({N});
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  float* Ydata = Y->MutableData<float>();
+
+  // Check for the optional Conv/Sum fusion.
+  float beta = 0.0f;
+  if (Sum != nullptr) {
+    ORT_RETURN_IF_NOT(Y->Shape() == Sum->Shape(), "output and sum shape must match");
+    if (Sum->Data<float>() != Ydata) {
+      memcpy(Ydata, Sum->Data<float>(), SafeInt<size_t>(sizeof(float)) * Y->Shape().Size());
+    }
+    beta = 1.0f;
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Handle the case of a dynamic weight filter.
+  const void* packed_W = packed_W_buffer_.get();
+  IAllocatorUniquePtr<void> dynamic_packed_W;
+  if (packed_W == nullptr) {
+    dynamic_packed_W = IAllocator::MakeUniquePtr<void>(alloc, PackedFilterSize(W_shape), true);
+    PackFilter(W->Data<float>(), W_shape, dynamic_packed_W.get());
+    packed_W = dynamic_packed_W.get();
+  }
+
+  const bool is_depthwise_conv = IsDepthwise(W_shape);
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = W_shape[1];
+  const int64_t group_output_channels = M / group_count;
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const size_t packed_W_size = is_depthwise_conv
+                                   ? 0
+                                   : MlasConvIndirectPackWSize(static_cast<size_t>(group_output_channels),
+                                                               static_cast<size_t>(group_input_channels),
+                                                               static_cast<size_t>(kernel_size));
+
+  // Pointwise convolutions read the input directly, all others build the indirection buffer per task.
+  const bool use_indirection_buffer = kernel_size != 1 || !conv_attrs_.HasStridesOneAndNoPadding();
+  std::vector<float> padding_data;
+  if (use_indirection_buffer) {
+    padding_data.resize(static_cast<size_t>(C), 0.0f);
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // Partition the output pixels of every image so that each task has enough work to amortize the pass
+  // over the packed filter, while producing a few tasks per thread.
+  constexpr double kMinTaskComplexity = static_cast<double>(64 * 1024);
+  const int64_t degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+  const int64_t weights_per_pixel = std::max<int64_t>(M * kernel_dim / (is_depthwise_conv ? M : 1), 1);
+  int64_t stride_m = static_cast<int64_t>(std::ceil(kMinTaskComplexity / static_cast<double>(weights_per_pixel)));
+  stride_m = std::max<int64_t>(stride_m, (N * output_image_size + degree_of_parallelism * 4 - 1) /
+                                             (degree_of_parallelism * 4));
+  stride_m = std::min<int64_t>(std::max<int64_t>(stride_m, 1), output_image_size);
+  const int64_t task_count_per_image = (output_image_size + stride_m - 1) / stride_m;
+
+  const auto* Xdata = X->Data<float>();
+  const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+
+  auto conv_worker = [&](ptrdiff_t task) {
+    const int64_t image_id = task / task_count_per_image;
+    const int64_t output_start = (task % task_count_per_image) * stride_m;
+    const int64_t output_count = std::min(stride_m, output_image_size - output_start);
+
+    const float* input_data = Xdata + image_id * input_image_size * C;
+    float* output_data = Ydata + (image_id * output_image_size + output_start) * M;
+
+    std::vector<const float*> indirection;
+    if (use_indirection_buffer) {
+      indirection.resize(static_cast<size_t>(output_count * kernel_size));
+      math::Im2col<float, StorageOrder::NHWC>()(
+          input_data,
+          C,
+          input_shape.GetDims().data(),
+          output_shape.GetDims().data(),
+          kernel_shape.data(),
+          strides.data(),
+          dilations.data(),
+          pads.data(),
+          static_cast<ptrdiff_t>(kernel_rank),
+          output_start,
+          output_count,
+          indirection.data(),
+          padding_data.data());
+    }
+
+    if (is_depthwise_conv) {
+      if (use_indirection_buffer) {
+        MlasConvDepthwise(indirection.data(), static_cast<const float*>(packed_W), Bdata, output_data,
+                          static_cast<size_t>(M), static_cast<size_t>(output_count),
+                          static_cast<size_t>(kernel_size), beta, &activation_);
+      } else {
+        // A pointwise depthwise convolution is a per channel scale.
+        std::vector<const float*> pixels(static_cast<size_t>(output_count));
+        for (int64_t i = 0; i < output_count; i++) {
+          pixels[static_cast<size_t>(i)] = input_data + (output_start + i) * C;
+        }
+        MlasConvDepthwise(pixels.data(), static_cast<const float*>(packed_W), Bdata, output_data,
+                          static_cast<size_t>(M), static_cast<size_t>(output_count), 1, beta, &activation_);
+      }
+      return;
+    }
+
+    for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+      MLAS_CONV_INDIRECT_PARAMS params = {};
+      if (use_indirection_buffer) {
+        params.InputIndirection = indirection.data();
+      } else {
+        params.InputDirect = input_data + output_start * C;
+        params.InputStride = static_cast<size_t>(C);
+      }
+      params.InputOffset = static_cast<size_t>(group_id * group_input_channels);
+      params.PackedFilter = static_cast<const uint8_t*>(packed_W) + group_id * packed_W_size;
+      params.Bias = Bdata != nullptr ? Bdata + group_id * group_output_channels : nullptr;
+      params.Output = output_data + group_id * group_output_channels;
+      params.OutputStride = static_cast<size_t>(M);
+      params.InputChannels = static_cast<size_t>(group_input_channels);
+      params.OutputChannels = static_cast<size_t>(group_output_channels);
+      params.OutputCount = static_cast<size_t>(output_count);
+      params.KernelSize = static_cast<size_t>(kernel_size);
+      params.Beta = beta;
+      params.Activation = &activation_;
+      MlasConvIndirect(params);
+    }
+  };
+
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, narrow<ptrdiff_t>(N * task_count_per_image),
+                                                conv_worker);
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    NhwcFusedConv,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcFusedConvFloat);
+
+}  // namespace contrib
+}  // namespace onnxruntime
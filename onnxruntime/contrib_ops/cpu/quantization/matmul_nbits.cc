@@ -30,7 +30,8 @@ constexpr size_t A = 0,
                  scales = 2,
                  zero_points = 3,
                  g_idx = 4,
-                 bias = 5;
+                 bias = 5,
+                 quantized_A = 6;
 };
 
 typedef enum {
@@ -112,8 +113,8 @@ class MatMulNBits final : public OpKernel {
       has_unquantized_zero_point_ = type != ONNX_NAMESPACE::TensorProto_DataType_UINT8;
     }
 
-    ORT_ENFORCE(nbits_ == 4 || nbits_ == 8,
-                "Only 4b and 8b quantization is supported for MatMulNBits op, additional bits support is planned.");
+    ORT_ENFORCE(nbits_ == 2 || nbits_ == 3 || nbits_ == 4 || nbits_ == 8,
+                "Only 2b, 3b, 4b and 8b quantization is supported for MatMulNBits op.");
     const Tensor* tensor_zero_point = nullptr;
     has_zp_input_ = info.TryGetConstantInput(InputIndex::zero_points, &tensor_zero_point);
   }
@@ -163,6 +164,7 @@ class MatMulNBits final : public OpKernel {
                         const Tensor* scales,
                         const Tensor* zero_points,
                         const Tensor* bias,
+                        const Tensor* quantized_a,
                         Tensor* y,
                         AllocatorPtr& allocator,
                         concurrency::ThreadPool* thread_pool,
@@ -306,6 +308,7 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
                                        const Tensor* scales,
                                        const Tensor* zero_points,
                                        const Tensor* bias,
+                                       const Tensor* quantized_a,
                                        Tensor* y,
                                        AllocatorPtr& allocator,
                                        concurrency::ThreadPool* thread_pool,
@@ -322,9 +325,23 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(false);
 
+  // A already quantized by the node that produced it (see the quantized_output of SkipLayerNormalization) replaces
+  // the quantization of A in the workspace. It is only used if it has the layout MLAS expects for this shape of A.
+  const void* quant_a_data = nullptr;
+  if constexpr (std::is_same_v<T1, float>) {
+    if (quantized_a != nullptr && batch_count == 1 && compute_type_ == SQNBIT_CompInt8) {
+      const size_t quant_a_size = MlasQNBitGemmQuantizedASize(M, K, nbits_, block_size_, zero_points, compute_type_);
+      if (quant_a_size > 0 && quantized_a->SizeInBytes() == quant_a_size) {
+        quant_a_data = quantized_a->DataRaw();
+      }
+    }
+  }
+
   IAllocatorUniquePtr<std::byte> workspace{};
-  const size_t workspace_size = MlasQNBitGemmBatchWorkspaceSize(
-      M, N, K, batch_count, nbits_, block_size_, zero_points, compute_type_);
+  const size_t workspace_size = quant_a_data != nullptr
+                                    ? 0
+                                    : MlasQNBitGemmBatchWorkspaceSize(M, N, K, batch_count, nbits_, block_size_,
+                                                                      zero_points, compute_type_);
   if (workspace_size > 0) {
     // Use reserve since no caching is needed
     workspace = IAllocator::MakeUniquePtr<std::byte>(allocator, workspace_size, true);
@@ -343,6 +360,7 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
     data[i].Bias = bias_data;
     data[i].C = y_data + helper.OutputOffsets()[i];
     data[i].ldc = N;
+    data[i].QuantA = quant_a_data;
   }
   MlasQNBitGemmBatch(M, N, K, batch_count, nbits_, block_size_, compute_type_, data.data(), workspace.get(),
                      thread_pool);
@@ -355,6 +373,7 @@ Status MatMulNBits<MLFloat16>::ComputeBPacked(const Tensor* a,
                                               const Tensor* scales,
                                               const Tensor* zero_points,
                                               const Tensor* bias,
+                                              const Tensor* /*quantized_a*/,
                                               Tensor* y,
                                               AllocatorPtr& allocator,
                                               concurrency::ThreadPool* thread_pool,
@@ -469,8 +488,24 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
           static_cast<int32_t>(K_),                       // number of rows in quantized input
           static_cast<int32_t>(N_),                       // number of columns in quantized input
           thread_pool);
-    } else {  // If it isn't 4bit, it has to be 8-bit quantization
-      ORT_ENFORCE(nbits_ == 8);
+    } else if (nbits_ == 2) {
+      MlasDequantizeBlockwise<float, 2>(
+          tmp_b_data_ptr.get(),                           // dequantized output
+          b_data,                                         // quantized input
+          scales_data,                                    // quantization scales
+          static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
+          static_cast<int32_t>(block_size_),              // quantization block size
+          column_wise_quant_,                             // columnwise quantization or row-wise
+          static_cast<int32_t>(K_),                       // number of rows in quantized input
+          static_cast<int32_t>(N_),                       // number of columns in quantized input
+          thread_pool);
+    } else {
+      // 3b weights have no MLAS dequantization routine and are only supported by the packed compute path.
+      if (nbits_ != 8) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                               "MatMulNBits with ", nbits_, " bits requires a constant B input, uint8 zero points "
+                               "and no g_idx.");
+      }
       MlasDequantizeBlockwise<float, 8>(
           tmp_b_data_ptr.get(),                           // dequantized output
           b_data,                                         // quantized input
@@ -606,8 +641,24 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
           static_cast<int32_t>(K_),                       // number of rows in quantized input
           static_cast<int32_t>(N_),                       // number of columns in quantized input
           thread_pool);
-    } else {  // If it isn't 4bit, it has to be 8-bit quantization
-      ORT_ENFORCE(nbits_ == 8);
+    } else if (nbits_ == 2) {
+      MlasDequantizeBlockwise<float, 2>(
+          tmp_b_data_ptr.get(),                           // dequantized output
+          b_data,                                         // quantized input
+          scales_ptr,                                     // quantization scales
+          static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
+          static_cast<int32_t>(block_size_),              // quantization block size
+          column_wise_quant_,                             // columnwise quantization or row-wise
+          static_cast<int32_t>(K_),                       // number of rows in quantized input
+          static_cast<int32_t>(N_),                       // number of columns in quantized input
+          thread_pool);
+    } else {
+      // 3b weights have no MLAS dequantization routine and are only supported by the packed compute path.
+      if (nbits_ != 8) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                               "MatMulNBits with ", nbits_, " bits requires a constant B input, uint8 zero points "
+                               "and no g_idx.");
+      }
       MlasDequantizeBlockwise<float, 8>(
           tmp_b_data_ptr.get(),                           // dequantized output
           b_data,                                         // quantized input
@@ -718,6 +769,7 @@ Status MatMulNBits<T1>::Compute(OpKernelContext* ctx) const {
   const Tensor* zero_points = ctx->Input<Tensor>(InputIndex::zero_points);
   const Tensor* reorder_idx = ctx->Input<Tensor>(InputIndex::g_idx);
   const Tensor* bias = ctx->Input<Tensor>(InputIndex::bias);
+  const Tensor* quantized_a = ctx->Input<Tensor>(InputIndex::quantized_A);
 
   ORT_RETURN_IF_ERROR(matmul_nbits_helper::CheckInputs<Tensor>(
       a, b, scales, zero_points, reorder_idx, bias, N_, K_, block_size_, nbits_));
@@ -749,7 +801,7 @@ Status MatMulNBits<T1>::Compute(OpKernelContext* ctx) const {
                     // MlasQNBitGemmPackQuantBDataSize() returns 0, we can consider calling MlasQNBitGemmBatch()
                     // with B directly too.
     if (MlasIsQNBitGemmAvailable(nbits_, block_size_, compute_type_)) {
-      return ComputeBPacked(a, scales, zero_points, bias, y, allocator, thread_pool, helper);
+      return ComputeBPacked(a, scales, zero_points, bias, quantized_a, y, allocator, thread_pool, helper);
     }
   }
 
@@ -0,0 +1,471 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/quantization/moe_quantization_cpu.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "contrib_ops/cpu/moe/moe_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// QMoE op input indices.
+// These should match the inputs names specified in the op schema.
+namespace InputIndex {
+constexpr int input = 0,
+              router_probs = 1,
+              fc1_experts_weights = 2,
+              fc1_scales = 3,
+              fc1_experts_bias = 4,
+              fc2_experts_weights = 5,
+              fc2_scales = 6,
+              fc2_experts_bias = 7,
+              fc3_experts_weights = 8,
+              fc3_scales = 9,
+              fc3_experts_bias = 10;
+};
+
+constexpr MLAS_QNBIT_GEMM_COMPUTE_TYPE kComputeType = SQNBIT_CompFp32;
+
+// The scales are per column, so any block size gives the same result. Prefer the largest block that divides K to
+// keep the repeated scales small and avoid padding.
+size_t GetPackBlockSize(size_t K) {
+  for (size_t block_size : {128, 64, 32, 16}) {
+    if (K % block_size == 0) {
+      return block_size;
+    }
+  }
+  return 32;
+}
+
+uint8_t GetQuantValue(const uint8_t* expert_weights, size_t N, size_t bits, size_t k, size_t n) {
+  if (bits == 4) {
+    const uint8_t packed = expert_weights[(k * N + n) / 2];
+    return (n & 1) ? (packed >> 4) : (packed & 0x0F);
+  }
+  return expert_weights[k * N + n];
+}
+
+}  // namespace
+
+#define REGISTER_QMoE(T)                                               \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                       \
+      QMoE,                                                            \
+      kMSDomain,                                                       \
+      1,                                                               \
+      T,                                                               \
+      kCpuExecutionProvider,                                           \
+      KernelDefBuilder()                                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())       \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>()) \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T>()),     \
+      QMoE<T>);
+
+REGISTER_QMoE(float);
+
+template <typename T>
+QMoE<T>::QMoE(const OpKernelInfo& op_kernel_info)
+    : OpKernel(op_kernel_info),
+      MoEBaseCPU(op_kernel_info),
+      expert_weight_bits_{op_kernel_info.GetAttrOrDefault<int64_t>("expert_weight_bits", 4)},
+      has_fc3_{op_kernel_info.GetInputCount() > InputIndex::fc3_experts_weights &&
+               op_kernel_info.node().InputDefs()[InputIndex::fc3_experts_weights]->Exists()} {
+  ORT_ENFORCE(expert_weight_bits_ == 4 || expert_weight_bits_ == 8,
+              "expert_weight_bits must be 4 or 8, but got ", expert_weight_bits_);
+}
+
+template <typename T>
+Status QMoE<T>::PackExperts(const Tensor& weights, const Tensor& scales, AllocatorPtr alloc,
+                            PackedExperts& packed) const {
+  const auto& dims = weights.Shape().GetDims();
+  const auto& scales_dims = scales.Shape().GetDims();
+  if (dims.size() != 3 || scales_dims.size() != 2 || scales_dims[0] != dims[0] || scales_dims[1] != dims[2] * 2) {
+    // Leave shape errors to CheckInputs() at compute time.
+    return Status::OK();
+  }
+
+  const size_t num_experts = narrow<size_t>(dims[0]);
+  const size_t K = narrow<size_t>(dims[1]);
+  const size_t N = narrow<size_t>(dims[2]) * 2;
+  const size_t block_size = GetPackBlockSize(K);
+  if (!MlasIsQNBitGemmAvailable(4, block_size, kComputeType)) {
+    return Status::OK();
+  }
+
+  const size_t packed_size = MlasQNBitGemmPackQuantBDataSize(N, K, 4, block_size, false, kComputeType);
+  if (packed_size == 0) {
+    return Status::OK();
+  }
+
+  // Convert every expert to the MatMulNBits layout: (N, block_count_k, block_size / 2) with K padded by the zero
+  // point, followed by MLAS packing.
+  const size_t block_count_k = (K + block_size - 1) / block_size;
+  const size_t column_bytes = block_count_k * block_size / 2;
+  std::vector<uint8_t> column_major(N * column_bytes);
+
+  packed.quant_b = IAllocator::MakeUniquePtr<void>(alloc, SafeInt<size_t>(num_experts) * packed_size, true);
+  packed.quant_b_stride = packed_size;
+  packed.scales = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(num_experts) * N * block_count_k, true);
+  packed.num_experts = num_experts;
+  packed.N = N;
+  packed.K = K;
+  packed.block_size = block_size;
+
+  const uint8_t* weights_data = weights.Data<uint8_t>();
+  const float* scales_data = scales.Data<float>();
+
+  for (size_t e = 0; e < num_experts; e++) {
+    const uint8_t* expert_weights = weights_data + e * K * N / 2;
+    std::fill(column_major.begin(), column_major.end(), uint8_t{0x88});
+    for (size_t k = 0; k < K; k++) {
+      for (size_t n = 0; n < N; n++) {
+        uint8_t& dst = column_major[n * column_bytes + k / 2];
+        const int shift = (k & 1) ? 4 : 0;
+        dst = static_cast<uint8_t>((dst & ~(0x0F << shift)) | (GetQuantValue(expert_weights, N, 4, k, n) << shift));
+      }
+    }
+
+    float* expert_scales = packed.scales.get() + e * N * block_count_k;
+    for (size_t n = 0; n < N; n++) {
+      std::fill_n(expert_scales + n * block_count_k, block_count_k, scales_data[e * N + n]);
+    }
+
+    MlasQNBitGemmPackQuantBData(N, K, 4, block_size, kComputeType, column_major.data(),
+                                static_cast<std::byte*>(packed.quant_b.get()) + e * packed_size, nullptr, false,
+                                nullptr, nullptr);
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status QMoE<T>::PackAllExperts(AllocatorPtr alloc) {
+  const std::pair<int, int> inputs[] = {{InputIndex::fc1_experts_weights, InputIndex::fc1_scales},
+                                        {InputIndex::fc2_experts_weights, InputIndex::fc2_scales},
+                                        {InputIndex::fc3_experts_weights, InputIndex::fc3_scales}};
+  PackedExperts* packed_experts[] = {&packed_fc1_, &packed_fc2_, &packed_fc3_};
+
+  const size_t num_layers = has_fc3_ ? 3 : 2;
+  for (size_t i = 0; i < num_layers; i++) {
+    const Tensor* weights = nullptr;
+    const Tensor* scales = nullptr;
+    bool packed = OpKernel::Info().TryGetConstantInput(inputs[i].first, &weights) && weights != nullptr &&
+                  OpKernel::Info().TryGetConstantInput(inputs[i].second, &scales) && scales != nullptr;
+    if (packed) {
+      ORT_RETURN_IF_ERROR(PackExperts(*weights, *scales, alloc, *packed_experts[i]));
+      packed = packed_experts[i]->quant_b != nullptr;
+    }
+
+    if (!packed) {
+      for (PackedExperts* packed_layer : packed_experts) {
+        *packed_layer = PackedExperts{};
+      }
+      return Status::OK();
+    }
+  }
+
+  is_prepacked_ = true;
+  return Status::OK();
+}
+
+template <typename T>
+Status QMoE<T>::PrePack(const Tensor& /*tensor*/, int input_idx, AllocatorPtr alloc,
+                        /*out*/ bool& is_packed,
+                        /*out*/ PrePackedWeights* prepacked_weights) {
+  ORT_UNUSED_PARAMETER(prepacked_weights);
+  is_packed = false;
+
+  // Only 4 bit weights have a MLAS n-bit GEMM kernel for float inputs.
+  if (expert_weight_bits_ != 4) {
+    return Status::OK();
+  }
+
+  if (input_idx != InputIndex::fc1_experts_weights && input_idx != InputIndex::fc2_experts_weights &&
+      input_idx != InputIndex::fc3_experts_weights) {
+    return Status::OK();
+  }
+
+  // A weight may only be released once all of them are packed, as Compute cannot run from a mix of packed weights
+  // and initializers.
+  if (!prepack_attempted_) {
+    prepack_attempted_ = true;
+    ORT_RETURN_IF_ERROR(PackAllExperts(alloc));
+  }
+
+  is_packed = is_prepacked_;
+  return Status::OK();
+}
+
+template <typename T>
+Status QMoE<T>::CheckPackedInputs(MoEParameters& moe_params, const Tensor* input, const Tensor* router_probs,
+                                  const Tensor* fc1_experts_bias_optional, const Tensor* fc2_experts_bias_optional,
+                                  const Tensor* fc3_experts_bias_optional) const {
+  // The prepacked weights were released, so validate against the shapes recorded while packing.
+  const auto& input_dims = input->Shape().GetDims();
+  const auto& router_probs_dims = router_probs->Shape().GetDims();
+  ORT_RETURN_IF_NOT((input_dims.size() == 2 || input_dims.size() == 3) && router_probs_dims.size() == 2,
+                    "input must be 2D or 3D and router_probs must be 2D");
+
+  const int64_t num_rows = input_dims.size() == 2 ? input_dims[0] : input_dims[0] * input_dims[1];
+  const int64_t num_experts = router_probs_dims[1];
+  const int64_t hidden_size = input_dims.back();
+  const int64_t inter_size = static_cast<int64_t>(packed_fc2_.K);
+  const int64_t act = activation_type_ == MoEActivationType::SwiGLU ? 2 : 1;
+
+  ORT_RETURN_IF_NOT(router_probs_dims[0] == num_rows, "router_probs_dims[0] must be equal to num_rows, got ",
+                    router_probs_dims[0], " and ", num_rows);
+  ORT_RETURN_IF_NOT(static_cast<int64_t>(packed_fc1_.num_experts) == num_experts &&
+                        static_cast<int64_t>(packed_fc2_.num_experts) == num_experts &&
+                        (!has_fc3_ || static_cast<int64_t>(packed_fc3_.num_experts) == num_experts),
+                    "Expert parallelism is not supported on CPU. The number of experts in the weights must be equal "
+                    "to the number of experts in router_probs (", num_experts, ")");
+  ORT_RETURN_IF_NOT(static_cast<int64_t>(packed_fc1_.K) == hidden_size &&
+                        static_cast<int64_t>(packed_fc1_.N) == act * inter_size &&
+                        static_cast<int64_t>(packed_fc2_.N) == hidden_size,
+                    "Expert weights do not match hidden_size ", hidden_size);
+  ORT_RETURN_IF_NOT(k_ > 0 && k_ <= num_experts, "k must be in the range [1, num_experts], got ", k_,
+                    " and num_experts ", num_experts);
+
+  ORT_RETURN_IF_ERROR(CheckBias(fc1_experts_bias_optional, "fc1_experts_bias", num_experts, act * inter_size));
+  ORT_RETURN_IF_ERROR(CheckBias(fc2_experts_bias_optional, "fc2_experts_bias", num_experts, hidden_size));
+  if (has_fc3_) {
+    ORT_RETURN_IF(activation_type_ == MoEActivationType::SwiGLU, "SwiGLU activation is not supported with fc3");
+    ORT_RETURN_IF_NOT(static_cast<int64_t>(packed_fc3_.K) == hidden_size &&
+                          static_cast<int64_t>(packed_fc3_.N) == inter_size,
+                      "fc3_experts_weights must match fc1_experts_weights");
+    ORT_RETURN_IF_ERROR(CheckBias(fc3_experts_bias_optional, "fc3_experts_bias", num_experts, inter_size));
+  } else {
+    ORT_RETURN_IF(fc3_experts_bias_optional != nullptr, "fc3_experts_bias requires fc3_experts_weights");
+  }
+
+  moe_params.num_rows = num_rows;
+  moe_params.num_experts = num_experts;
+  moe_params.hidden_size = hidden_size;
+  moe_params.inter_size = inter_size;
+  return Status::OK();
+}
+
+template <typename T>
+Status QMoE<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(InputIndex::input);
+  const Tensor* router_probs = context->Input<Tensor>(InputIndex::router_probs);
+  const Tensor* fc1_experts_weights = context->Input<Tensor>(InputIndex::fc1_experts_weights);
+  const Tensor* fc1_scales = context->Input<Tensor>(InputIndex::fc1_scales);
+  const Tensor* fc1_experts_bias_optional = context->Input<Tensor>(InputIndex::fc1_experts_bias);
+  const Tensor* fc2_experts_weights = context->Input<Tensor>(InputIndex::fc2_experts_weights);
+  const Tensor* fc2_scales = context->Input<Tensor>(InputIndex::fc2_scales);
+  const Tensor* fc2_experts_bias_optional = context->Input<Tensor>(InputIndex::fc2_experts_bias);
+  const Tensor* fc3_experts_weights_optional = context->Input<Tensor>(InputIndex::fc3_experts_weights);
+  const Tensor* fc3_scales_optional = context->Input<Tensor>(InputIndex::fc3_scales);
+  const Tensor* fc3_experts_bias_optional = context->Input<Tensor>(InputIndex::fc3_experts_bias);
+
+  MoEParameters moe_params;
+  const MoEQuantType quant_type = expert_weight_bits_ == 4 ? MoEQuantType::UINT4 : MoEQuantType::UINT8;
+  if (is_prepacked_) {
+    ORT_RETURN_IF_ERROR(CheckPackedInputs(moe_params, input, router_probs, fc1_experts_bias_optional,
+                                          fc2_experts_bias_optional, fc3_experts_bias_optional));
+  } else {
+    ORT_RETURN_IF_ERROR(CheckInputs(moe_params, quant_type, input, router_probs, fc1_experts_weights,
+                                    fc1_experts_bias_optional, fc2_experts_weights, fc2_experts_bias_optional,
+                                    fc3_experts_weights_optional, fc3_experts_bias_optional));
+    ORT_RETURN_IF_ERROR(CheckInputScales(fc1_scales, fc2_scales, fc3_scales_optional, moe_params.num_experts,
+                                         moe_params.hidden_size, moe_params.inter_size));
+  }
+
+  Tensor* output = context->Output(0, input->Shape());
+  if (moe_params.num_rows == 0) {
+    return Status::OK();
+  }
+
+  if (is_prepacked_) {
+    return ComputeFromPacked(context, moe_params, input, router_probs, fc1_experts_bias_optional,
+                             fc2_experts_bias_optional, fc3_experts_bias_optional, output);
+  }
+
+  return ComputeFromDequantized(context, moe_params, input, router_probs, fc1_experts_weights, fc1_scales,
+                                fc1_experts_bias_optional, fc2_experts_weights, fc2_scales, fc2_experts_bias_optional,
+                                fc3_experts_weights_optional, fc3_scales_optional, fc3_experts_bias_optional, output);
+}
+
+template <typename T>
+Status QMoE<T>::ComputeFromPacked(OpKernelContext* context, const MoEParameters& moe_params, const Tensor* input,
+                                  const Tensor* router_probs, const Tensor* fc1_experts_bias_optional,
+                                  const Tensor* fc2_experts_bias_optional, const Tensor* fc3_experts_bias_optional,
+                                  Tensor* output) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  MoERouting routing;
+  ComputeMoERouting(router_probs->Data<float>(), moe_params.num_rows, moe_params.num_experts, k_,
+                    normalize_routing_weights_, routing, thread_pool);
+
+  const size_t hidden_size = static_cast<size_t>(moe_params.hidden_size);
+  const size_t inter_size = static_cast<size_t>(moe_params.inter_size);
+  const size_t fc1_output_size = packed_fc1_.N;
+  const size_t expanded_rows = routing.permuted_to_expanded_row.size();
+
+  size_t max_expert_rows = 0;
+  for (int64_t e = 0; e < moe_params.num_experts; e++) {
+    max_expert_rows = std::max(max_expert_rows, static_cast<size_t>(routing.ExpertRowCount(e)));
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto permuted_input = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * hidden_size);
+  auto fc1_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * fc1_output_size);
+  auto fc2_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * hidden_size);
+  IAllocatorUniquePtr<float> fc3_output;
+  if (has_fc3_) {
+    fc3_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(expanded_rows) * inter_size);
+  }
+
+  size_t workspace_size = 0;
+  for (const PackedExperts* packed : {&packed_fc1_, &packed_fc2_, &packed_fc3_}) {
+    if (packed->quant_b != nullptr) {
+      workspace_size = std::max(workspace_size,
+                                MlasQNBitGemmBatchWorkspaceSize(max_expert_rows, packed->N, packed->K, 1, 4,
+                                                                packed->block_size, false, kComputeType));
+    }
+  }
+  IAllocatorUniquePtr<std::byte> workspace{};
+  if (workspace_size > 0) {
+    workspace = IAllocator::MakeUniquePtr<std::byte>(allocator, workspace_size, true);
+  }
+
+  GatherMoERows(input->Data<float>(), routing, k_, moe_params.hidden_size, permuted_input.get(), thread_pool);
+
+  // Every expert is one n-bit GEMM over its contiguous block of permuted rows.
+  auto run_experts = [&](const PackedExperts& packed, const float* a, size_t lda, float* c) {
+    const size_t block_count_k = (packed.K + packed.block_size - 1) / packed.block_size;
+    for (int64_t e = 0; e < moe_params.num_experts; e++) {
+      const size_t row_count = static_cast<size_t>(routing.ExpertRowCount(e));
+      if (row_count == 0) {
+        continue;
+      }
+      const size_t row_start = static_cast<size_t>(routing.expert_offsets[static_cast<size_t>(e)]);
+
+      MLAS_QNBIT_GEMM_DATA_PARAMS<float> params;
+      params.A = a + row_start * lda;
+      params.lda = lda;
+      params.PackedQuantBData = static_cast<const std::byte*>(packed.quant_b.get()) + e * packed.quant_b_stride;
+      params.QuantBScale = packed.scales.get() + e * packed.N * block_count_k;
+      params.C = c + row_start * packed.N;
+      params.ldc = packed.N;
+      MlasQNBitGemmBatch(row_count, packed.N, packed.K, 1, 4, packed.block_size, kComputeType, &params,
+                         workspace.get(), thread_pool);
+    }
+  };
+
+  run_experts(packed_fc1_, permuted_input.get(), hidden_size, fc1_output.get());
+  if (has_fc3_) {
+    run_experts(packed_fc3_, permuted_input.get(), hidden_size, fc3_output.get());
+  }
+
+  ApplyMoEActivation(activation_type_, routing, moe_params.inter_size, fc1_output.get(),
+                     fc1_experts_bias_optional == nullptr ? nullptr : fc1_experts_bias_optional->Data<float>(),
+                     fc3_output.get(),
+                     fc3_experts_bias_optional == nullptr ? nullptr : fc3_experts_bias_optional->Data<float>(),
+                     thread_pool);
+
+  run_experts(packed_fc2_, fc1_output.get(), fc1_output_size, fc2_output.get());
+
+  CombineMoERows(fc2_output.get(),
+                 fc2_experts_bias_optional == nullptr ? nullptr : fc2_experts_bias_optional->Data<float>(),
+                 routing, moe_params.num_rows, k_, moe_params.hidden_size, output->MutableData<float>(), thread_pool);
+
+  return Status::OK();
+}
+
+template <typename T>
+Status QMoE<T>::ComputeFromDequantized(OpKernelContext* context, const MoEParameters& moe_params,
+                                       const Tensor* input, const Tensor* router_probs,
+                                       const Tensor* fc1_experts_weights, const Tensor* fc1_scales,
+                                       const Tensor* fc1_experts_bias_optional, const Tensor* fc2_experts_weights,
+                                       const Tensor* fc2_scales, const Tensor* fc2_experts_bias_optional,
+                                       const Tensor* fc3_experts_weights_optional, const Tensor* fc3_scales_optional,
+                                       const Tensor* fc3_experts_bias_optional, Tensor* output) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  MoERouting routing;
+  ComputeMoERouting(router_probs->Data<float>(), moe_params.num_rows, moe_params.num_experts, k_,
+                    normalize_routing_weights_, routing, thread_pool);
+
+  const size_t num_experts = static_cast<size_t>(moe_params.num_experts);
+  const size_t hidden_size = static_cast<size_t>(moe_params.hidden_size);
+  const size_t inter_size = static_cast<size_t>(moe_params.inter_size);
+  const size_t fc1_output_size = activation_type_ == MoEActivationType::SwiGLU ? 2 * inter_size : inter_size;
+  const size_t bits = static_cast<size_t>(expert_weight_bits_);
+  const uint8_t zero_point = bits == 4 ? 8 : 128;
+
+  std::vector<size_t> active_experts;
+  for (size_t e = 0; e < num_experts; e++) {
+    if (routing.ExpertRowCount(static_cast<int64_t>(e)) > 0) {
+      active_experts.push_back(e);
+    }
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  // Only the experts that receive rows are dequantized.
+  auto dequantize = [&](const Tensor* weights, const Tensor* scales, size_t K, size_t N,
+                        IAllocatorUniquePtr<float>& buffer, std::vector<const float*>& expert_weights) {
+    buffer = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(active_experts.size()) * K * N);
+    expert_weights.assign(num_experts, nullptr);
+
+    const uint8_t* weights_data = weights->Data<uint8_t>();
+    const float* scales_data = scales->Data<float>();
+    float* buffer_data = buffer.get();
+    const size_t expert_bytes = K * N * bits / 8;
+
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(active_experts.size() * K),
+        TensorOpCost{static_cast<double>(N * bits / 8), static_cast<double>(N * sizeof(float)),
+                     static_cast<double>(N * 2)},
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i < end; i++) {
+            const size_t index = static_cast<size_t>(i) / K;
+            const size_t k = static_cast<size_t>(i) % K;
+            const size_t e = active_experts[index];
+            const uint8_t* expert_data = weights_data + e * expert_bytes;
+            const float* expert_scales = scales_data + e * N;
+            float* row = buffer_data + (index * K + k) * N;
+            for (size_t n = 0; n < N; n++) {
+              const int32_t q = GetQuantValue(expert_data, N, bits, k, n);
+              row[n] = static_cast<float>(q - zero_point) * expert_scales[n];
+            }
+          }
+        });
+
+    for (size_t index = 0; index < active_experts.size(); index++) {
+      expert_weights[active_experts[index]] = buffer_data + index * K * N;
+    }
+  };
+
+  IAllocatorUniquePtr<float> fc1_buffer, fc2_buffer, fc3_buffer;
+  std::vector<const float*> fc1_weights, fc2_weights, fc3_weights;
+  dequantize(fc1_experts_weights, fc1_scales, hidden_size, fc1_output_size, fc1_buffer, fc1_weights);
+  dequantize(fc2_experts_weights, fc2_scales, inter_size, hidden_size, fc2_buffer, fc2_weights);
+  if (fc3_experts_weights_optional != nullptr) {
+    ORT_RETURN_IF(fc3_scales_optional == nullptr, "fc3_scales is required when fc3_experts_weights is given");
+    dequantize(fc3_experts_weights_optional, fc3_scales_optional, hidden_size, inter_size, fc3_buffer, fc3_weights);
+  }
+
+  return RunMoEExperts(
+      context, moe_params, activation_type_, k_, routing, input->Data<float>(),
+      fc1_weights.data(), fc1_experts_bias_optional == nullptr ? nullptr : fc1_experts_bias_optional->Data<float>(),
+      fc2_weights.data(), fc2_experts_bias_optional == nullptr ? nullptr : fc2_experts_bias_optional->Data<float>(),
+      fc3_experts_weights_optional != nullptr ? fc3_weights.data() : nullptr,
+      fc3_experts_bias_optional == nullptr ? nullptr : fc3_experts_bias_optional->Data<float>(),
+      output->MutableData<float>());
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
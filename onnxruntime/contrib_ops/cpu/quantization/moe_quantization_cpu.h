@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas_qnbit.h"
+#include "contrib_ops/cpu/moe/moe_base_cpu.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Quantized mixture of experts on CPU.
+//
+// The expert weights are stored row major per expert with shape (K, N) for 8 bits or (K, N / 2) for 4 bits, where two
+// consecutive columns share a byte with the lower column in the low nibble. Values are unsigned with an implied zero
+// point of 8 (4 bits) or 128 (8 bits), and every output column has one scale.
+//
+// Constant 4 bit weights are repacked once into the MatMulNBits block layout so that each expert runs through the
+// MLAS n-bit GEMM kernels. Otherwise the weights of the experts that receive tokens are dequantized per run and the
+// float grouped GEMM path of the MoE kernel is used.
+template <typename T>
+class QMoE final : public OpKernel, public MoEBaseCPU {
+ public:
+  explicit QMoE(const OpKernelInfo& op_kernel_info);
+  Status Compute(OpKernelContext* ctx) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+ private:
+  // One FC layer of all experts in the MLAS n-bit GEMM layout.
+  struct PackedExperts {
+    IAllocatorUniquePtr<void> quant_b;  // packed data of all experts
+    size_t quant_b_stride{0};           // bytes per expert in quant_b
+    IAllocatorUniquePtr<float> scales;  // (num_experts, N, block_count_k), the column scale repeated per block
+    size_t num_experts{0};
+    size_t N{0};
+    size_t K{0};
+    size_t block_size{0};
+  };
+
+  Status PackExperts(const Tensor& weights, const Tensor& scales, AllocatorPtr alloc, PackedExperts& packed) const;
+
+  // Packs the weights of every FC layer, or none of them if any layer cannot be packed.
+  Status PackAllExperts(AllocatorPtr alloc);
+
+  Status CheckPackedInputs(MoEParameters& moe_params, const Tensor* input, const Tensor* router_probs,
+                           const Tensor* fc1_experts_bias_optional, const Tensor* fc2_experts_bias_optional,
+                           const Tensor* fc3_experts_bias_optional) const;
+
+  Status ComputeFromPacked(OpKernelContext* context, const MoEParameters& moe_params, const Tensor* input,
+                           const Tensor* router_probs, const Tensor* fc1_experts_bias_optional,
+                           const Tensor* fc2_experts_bias_optional, const Tensor* fc3_experts_bias_optional,
+                           Tensor* output) const;
+
+  Status ComputeFromDequantized(OpKernelContext* context, const MoEParameters& moe_params, const Tensor* input,
+                                const Tensor* router_probs, const Tensor* fc1_experts_weights,
+                                const Tensor* fc1_scales, const Tensor* fc1_experts_bias_optional,
+                                const Tensor* fc2_experts_weights, const Tensor* fc2_scales,
+                                const Tensor* fc2_experts_bias_optional, const Tensor* fc3_experts_weights_optional,
+                                const Tensor* fc3_scales_optional, const Tensor* fc3_experts_bias_optional,
+                                Tensor* output) const;
+
+  int64_t expert_weight_bits_;
+  bool has_fc3_;
+
+  PackedExperts packed_fc1_;
+  PackedExperts packed_fc2_;
+  PackedExperts packed_fc3_;
+  bool prepack_attempted_{false};
+  bool is_prepacked_{false};
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
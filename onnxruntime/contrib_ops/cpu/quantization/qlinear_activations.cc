@@ -4,6 +4,9 @@
 #include "qlinear_activations.h"
 #include "qlinear_lookup_table.h"
 
+#include <cmath>
+#include <string>
+
 #include "core/common/narrow.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
@@ -97,6 +100,31 @@ Status QLinearSigmoid<T>::Compute(OpKernelContext* context) const {
   });
 }
 
+template <typename T>
+float QLinearGelu<T>::Gelu(float v) {
+  constexpr float kSqrtHalf = 0.7071067811865476f;  // 1 / sqrt(2)
+  return 0.5f * v * (1.0f + std::erf(v * kSqrtHalf));
+}
+
+template <typename T>
+float QLinearGelu<T>::GeluTanh(float v) {
+  constexpr float kAlpha = 0.7978845608028654f;  // sqrt(2 / pi)
+  constexpr float kGamma = 0.044715f;
+  return 0.5f * v * (1.0f + std::tanh(kAlpha * (v + kGamma * v * v * v)));
+}
+
+template <typename T>
+QLinearGelu<T>::QLinearGelu(const OpKernelInfo& info)
+    : QLinearLookupBase<T>(info),
+      approximate_tanh_(info.GetAttrOrDefault<std::string>("approximate", "none") == "tanh") {
+  this->BuildLookupTableIfFixed(info, approximate_tanh_ ? &GeluTanh : &Gelu);
+}
+
+template <typename T>
+Status QLinearGelu<T>::Compute(OpKernelContext* context) const {
+  return this->ComputeBase(context, approximate_tanh_ ? &GeluTanh : &Gelu);
+}
+
 #define REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(op_name, version, data_type, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                                         \
       op_name, version, data_type,                                                           \
@@ -108,6 +136,8 @@ REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, int8_t, QLinearLe
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, uint8_t, QLinearLeakyRelu);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, int8_t, QLinearSigmoid);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, uint8_t, QLinearSigmoid);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearGelu, 1, int8_t, QLinearGelu);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearGelu, 1, uint8_t, QLinearGelu);
 
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "qlinear_layer_norm.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// input indices
+constexpr int kX = 0;
+constexpr int kXScale = 1;
+constexpr int kXZeroPoint = 2;
+constexpr int kScale = 3;
+constexpr int kScaleScale = 4;
+constexpr int kScaleZeroPoint = 5;
+constexpr int kYScale = 6;
+constexpr int kYZeroPoint = 7;
+constexpr int kBias = 8;
+constexpr int kBiasScale = 9;
+
+// Dequantizes a scale or bias input. Its scale and zero point are either scalars or have one value per element.
+template <typename TValue>
+Status Dequantize(const Tensor& value, const Tensor& scale, const Tensor* zero_point, std::vector<float>& output) {
+  const size_t size = narrow<size_t>(value.Shape().Size());
+  const size_t scale_size = narrow<size_t>(scale.Shape().Size());
+  const size_t zero_point_size = zero_point ? narrow<size_t>(zero_point->Shape().Size()) : 1;
+  ORT_RETURN_IF_NOT((scale_size == 1 || scale_size == size) && (zero_point_size == 1 || zero_point_size == size),
+                    "QLinearLayerNormalization: quantization parameters must be scalars or have one value per element");
+
+  const auto values = value.DataAsSpan<TValue>();
+  const auto scales = scale.DataAsSpan<float>();
+  output.resize(size);
+  for (size_t i = 0; i < size; ++i) {
+    const int32_t zp = zero_point ? static_cast<int32_t>(zero_point->Data<TValue>()[zero_point_size == 1 ? 0 : i]) : 0;
+    output[i] = static_cast<float>(static_cast<int32_t>(values[i]) - zp) * scales[scale_size == 1 ? 0 : i];
+  }
+
+  return Status::OK();
+}
+
+Status DequantizeScale(const Tensor& value, const Tensor& scale, const Tensor* zero_point, std::vector<float>& output) {
+  if (value.IsDataType<int8_t>()) {
+    return Dequantize<int8_t>(value, scale, zero_point, output);
+  }
+  ORT_RETURN_IF_NOT(value.IsDataType<uint8_t>(), "QLinearLayerNormalization: scale must be int8 or uint8");
+  return Dequantize<uint8_t>(value, scale, zero_point, output);
+}
+
+template <typename T>
+T GetZeroPoint(const Tensor* zero_point) {
+  return zero_point ? *zero_point->Data<T>() : T{0};
+}
+
+}  // namespace
+
+template <typename T>
+QLinearLayerNormalization<T>::QLinearLayerNormalization(const OpKernelInfo& info)
+    : OpKernel(info),
+      axis_(info.GetAttrOrDefault<int64_t>("axis", -1)),
+      epsilon_(info.GetAttrOrDefault<float>("epsilon", 1e-5f)) {
+  const Tensor* scale = nullptr;
+  const Tensor* scale_scale = nullptr;
+  const Tensor* scale_zero_point = nullptr;
+  if (info.TryGetConstantInput(kScale, &scale) && info.TryGetConstantInput(kScaleScale, &scale_scale) &&
+      (!info.node().InputDefs()[kScaleZeroPoint]->Exists() ||
+       info.TryGetConstantInput(kScaleZeroPoint, &scale_zero_point))) {
+    ORT_THROW_IF_ERROR(DequantizeScale(*scale, *scale_scale, scale_zero_point, fixed_scale_));
+  }
+
+  const auto& input_defs = info.node().InputDefs();
+  const Tensor* bias = nullptr;
+  const Tensor* bias_scale = nullptr;
+  if (input_defs.size() > static_cast<size_t>(kBiasScale) && input_defs[kBias]->Exists() &&
+      info.TryGetConstantInput(kBias, &bias) && info.TryGetConstantInput(kBiasScale, &bias_scale)) {
+    ORT_THROW_IF_ERROR(Dequantize<int32_t>(*bias, *bias_scale, nullptr, fixed_bias_));
+  }
+}
+
+template <typename T>
+Status QLinearLayerNormalization<T>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(kX);
+  const Tensor* x_scale = context->Input<Tensor>(kXScale);
+  const Tensor* x_zero_point = context->Input<Tensor>(kXZeroPoint);
+  const Tensor* y_scale = context->Input<Tensor>(kYScale);
+  const Tensor* y_zero_point = context->Input<Tensor>(kYZeroPoint);
+  const Tensor* bias = context->Input<Tensor>(kBias);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(x_scale) && IsScalarOr1ElementVector(y_scale) &&
+                        (!x_zero_point || IsScalarOr1ElementVector(x_zero_point)) &&
+                        (!y_zero_point || IsScalarOr1ElementVector(y_zero_point)),
+                    "QLinearLayerNormalization: input and output quantization parameters must be scalars");
+
+  const auto& x_shape = X->Shape();
+  const size_t axis = narrow<size_t>(HandleNegativeAxis(axis_, narrow<int64_t>(x_shape.NumDimensions())));
+  const int64_t num_rows = x_shape.SizeToDimension(axis);
+  const int64_t row_size = x_shape.SizeFromDimension(axis);
+
+  std::vector<float> scale_values;
+  const std::vector<float>* scale = &fixed_scale_;
+  if (fixed_scale_.empty()) {
+    ORT_RETURN_IF_ERROR(DequantizeScale(*context->Input<Tensor>(kScale), *context->Input<Tensor>(kScaleScale),
+                                        context->Input<Tensor>(kScaleZeroPoint), scale_values));
+    scale = &scale_values;
+  }
+
+  std::vector<float> bias_values;
+  const std::vector<float>* bias_ptr = nullptr;
+  if (bias) {
+    bias_ptr = &fixed_bias_;
+    if (fixed_bias_.empty()) {
+      const Tensor* bias_scale = context->Input<Tensor>(kBiasScale);
+      ORT_RETURN_IF(bias_scale == nullptr, "QLinearLayerNormalization: B_scale is required with B");
+      ORT_RETURN_IF_ERROR(Dequantize<int32_t>(*bias, *bias_scale, nullptr, bias_values));
+      bias_ptr = &bias_values;
+    }
+  }
+
+  ORT_RETURN_IF_NOT(scale->size() == static_cast<size_t>(row_size) &&
+                        (!bias_ptr || bias_ptr->size() == static_cast<size_t>(row_size)),
+                    "QLinearLayerNormalization: Scale and B must have the size of the normalized dimensions, ",
+                    row_size);
+
+  Tensor* Y = context->Output(0, x_shape);
+  if (num_rows == 0 || row_size == 0) {
+    return Status::OK();
+  }
+
+  const float x_scale_value = *x_scale->Data<float>();
+  const float y_scale_value = *y_scale->Data<float>();
+  const int32_t x_zero_point_value = GetZeroPoint<T>(x_zero_point);
+  const T y_zero_point_value = GetZeroPoint<T>(y_zero_point);
+  const T* x_data = X->Data<T>();
+  T* y_data = Y->MutableData<T>();
+  const float* scale_data = scale->data();
+  const float* bias_data = bias_ptr ? bias_ptr->data() : nullptr;
+  const size_t n = narrow<size_t>(row_size);
+  const float epsilon = epsilon_;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(num_rows),
+      TensorOpCost{static_cast<double>(n), static_cast<double>(n), 8.0 * n},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> row(n);
+        for (std::ptrdiff_t r = first; r < last; ++r) {
+          const T* x = x_data + r * n;
+
+          // the statistics of the zero point adjusted values, which are exact in integer arithmetic
+          int64_t sum = 0;
+          int64_t sum_of_squares = 0;
+          for (size_t i = 0; i < n; ++i) {
+            const int64_t v = static_cast<int64_t>(x[i]) - x_zero_point_value;
+            sum += v;
+            sum_of_squares += v * v;
+          }
+
+          const double mean = static_cast<double>(sum) / n;
+          const double variance = std::max(static_cast<double>(sum_of_squares) / n - mean * mean, 0.0) *
+                                  x_scale_value * x_scale_value;
+          const float multiplier = static_cast<float>(x_scale_value / std::sqrt(variance + epsilon));
+          const float offset = static_cast<float>(mean + x_zero_point_value);
+
+          for (size_t i = 0; i < n; ++i) {
+            row[i] = (static_cast<float>(x[i]) - offset) * multiplier * scale_data[i] +
+                     (bias_data ? bias_data[i] : 0.0f);
+          }
+
+          MlasQuantizeLinear(row.data(), y_data + r * n, n, y_scale_value, y_zero_point_value);
+        }
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(data_type)                \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                       \
+      QLinearLayerNormalization, 1, data_type,                             \
+      KernelDefBuilder()                                                   \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())   \
+          .TypeConstraint("T2", {DataTypeImpl::GetTensorType<int8_t>(),    \
+                                 DataTypeImpl::GetTensorType<uint8_t>()}), \
+      QLinearLayerNormalization<data_type>);
+
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
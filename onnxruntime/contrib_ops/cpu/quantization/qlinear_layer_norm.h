@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LayerNormalization of a quantized input to a quantized output. The statistics of each row are accumulated from the
+// quantized values, and each normalized row is quantized directly, so no float tensor is materialized.
+template <typename T>
+class QLinearLayerNormalization final : public OpKernel {
+ public:
+  QLinearLayerNormalization(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  float epsilon_;
+
+  // dequantized scale and bias, when they and their quantization parameters are constant
+  std::vector<float> fixed_scale_;
+  std::vector<float> fixed_bias_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
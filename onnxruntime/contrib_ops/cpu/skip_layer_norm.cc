@@ -1,8 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/common/narrow.h"
 #include "core/framework/tensor.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/mlas/inc/mlas_qnbit.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -120,6 +122,11 @@ SkipLayerNorm<T, simplified>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
       prepacked_bias_fp32_data_(nullptr) {
   ORT_ENFORCE(op_kernel_info.GetAttr<float>("epsilon", &epsilon_).IsOK());
   ORT_ENFORCE(epsilon_ >= 0);
+  quantized_output_bits_ = narrow<size_t>(op_kernel_info.GetAttrOrDefault<int64_t>("quantized_output_bits", 4));
+  quantized_output_block_size_ =
+      narrow<size_t>(op_kernel_info.GetAttrOrDefault<int64_t>("quantized_output_block_size", 32));
+  quantized_output_has_zero_point_ =
+      op_kernel_info.GetAttrOrDefault<int64_t>("quantized_output_has_zero_point", 0) != 0;
 }
 
 template <typename T, bool simplified>
@@ -161,6 +168,28 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
   T* skip_input_bias_add_output_data = skip_input_bias_add_output == nullptr ? nullptr : skip_input_bias_add_output->MutableData<T>();
   const int64_t skip_size = skip ? skip->Shape().Size() : prepacked_skip_fp32_size_;
 
+  // The optional output quantized to the int8 A layout of MatMulNBits is produced from each row of the output while it
+  // is still in cache, so that the MatMulNBits does not read the whole output again to quantize it. It is empty if the
+  // layout is not available, and MatMulNBits then quantizes the output itself.
+  const size_t quantized_output_size =
+      std::is_same_v<T, double> || p_ctx->OutputCount() <= 4
+          ? 0
+          : MlasQNBitGemmQuantizedASize(static_cast<size_t>(task_count), static_cast<size_t>(hidden_size),
+                                        quantized_output_bits_, quantized_output_block_size_,
+                                        quantized_output_has_zero_point_, SQNBIT_CompInt8);
+  Tensor* quantized_output = p_ctx->Output(4, {static_cast<int64_t>(quantized_output_size)});
+  void* quantized_output_data =
+      quantized_output == nullptr || quantized_output_size == 0 ? nullptr : quantized_output->MutableDataRaw();
+
+  const auto quantize_output_row = [&](const float* p_output, ptrdiff_t task_idx) {
+    if (quantized_output_data != nullptr) {
+      MlasQNBitGemmQuantizeA(static_cast<size_t>(task_count), static_cast<size_t>(hidden_size),
+                             quantized_output_bits_, quantized_output_block_size_, quantized_output_has_zero_point_,
+                             SQNBIT_CompInt8, p_output + task_idx * hidden_size, static_cast<size_t>(hidden_size),
+                             static_cast<size_t>(task_idx), 1, quantized_output_data);
+    }
+  };
+
   if constexpr (std::is_same_v<T, MLFloat16>) {
     const size_t total_data_size = static_cast<size_t>(input->Shape().Size());
 
@@ -232,6 +261,7 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
         [&](ptrdiff_t task_idx) {
           ComputeJob(input_data_f, skip_data_f, gamma_data_f, beta_data_f, bias_data_f, task_idx, hidden_size, skip_size,
                      epsilon_, simplified, output_data_f, skip_input_bias_add_output_data_f);
+          quantize_output_row(output_data_f, task_idx);
         },
         0);
     MlasConvertFloatToHalfBuffer(output_data_f, output_data, total_data_size);
@@ -243,6 +273,9 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
         [&](ptrdiff_t task_idx) {
           ComputeJob(input_data, skip_data, gamma_data, beta_data, bias_data, task_idx, hidden_size, skip_size,
                      epsilon_, simplified, output_data, skip_input_bias_add_output_data);
+          if constexpr (std::is_same_v<T, float>) {
+            quantize_output_row(output_data, task_idx);
+          }
         },
         0);
   }
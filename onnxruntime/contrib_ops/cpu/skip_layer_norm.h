@@ -21,6 +21,10 @@ class SkipLayerNorm final : public OpKernel {
 
  private:
   float epsilon_;
+  // B quantization of the MatMulNBits that consumes the optional output quantized to its int8 A layout.
+  size_t quantized_output_bits_;
+  size_t quantized_output_block_size_;
+  bool quantized_output_has_zero_point_;
   int64_t prepacked_skip_fp32_size_;
   IAllocatorUniquePtr<float> prepacked_skip_fp32_data_;
   IAllocatorUniquePtr<float> prepacked_gamma_fp32_data_;
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/zipmap_columnar.h"
+
+#include "core/providers/cpu/tensor/utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    ZipMapColumnar,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .Alias(0, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    ZipMapColumnar);
+
+ZipMapColumnar::ZipMapColumnar(const OpKernelInfo& info) : OpKernel(info) {
+  const auto classlabels_int64s = info.GetAttrsOrDefault<int64_t>("classlabels_int64s");
+  const auto classlabels_strings = info.GetAttrsOrDefault<std::string>("classlabels_strings");
+  ORT_ENFORCE(classlabels_strings.empty() ^ classlabels_int64s.empty(),
+              "Must provide classlabels_strings or classlabels_int64s but not both.");
+  num_labels_ = classlabels_strings.empty() ? classlabels_int64s.size() : classlabels_strings.size();
+}
+
+Status ZipMapColumnar::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const auto x_dims = X.Shape().GetDims();
+  ORT_RETURN_IF(x_dims.empty() || x_dims.size() > 2, "ZipMapColumnar only supports 1D or 2D input tensors");
+
+  const int64_t batch_size = x_dims.size() > 1 ? x_dims[0] : 1;
+  const int64_t num_features = x_dims.back();
+  ORT_RETURN_IF_NOT(num_features == static_cast<int64_t>(num_labels_),
+                    "Input features_per_batch[", num_features, "] != number of classlabels[", num_labels_, "]");
+
+  Tensor& Z = *context->Output(0, TensorShape({batch_size, num_features}));
+  CopyCpuTensor(&X, &Z);
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
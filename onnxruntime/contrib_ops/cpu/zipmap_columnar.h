@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Columnar form of ZipMap. The output is the [N, C] probability tensor, which aliases the input, and the labels are
+// kept in the node attributes where InferenceSession::GetZipMapColumnarLabels finds them.
+class ZipMapColumnar final : public OpKernel {
+ public:
+  explicit ZipMapColumnar(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  size_t num_labels_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -26,6 +26,7 @@ namespace cuda {
       kCudaExecutionProvider,                                            \
       (*KernelDefBuilder::Create())                                      \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())         \
+          .TypeConstraint("T_CACHE", DataTypeImpl::GetTensorType<T>())   \
           .TypeConstraint("M", {DataTypeImpl::GetTensorType<int32_t>()}) \
           .MayInplace(3, 1)                                              \
           .MayInplace(4, 2)                                              \
@@ -53,6 +54,8 @@ GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info)
   scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
   softcap_ = info.GetAttrOrDefault<float>("softcap", 0.0f);
   use_smooth_softmax_ = info.GetAttrOrDefault<int64_t>("smooth_softmax", 0) == 1;
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("kv_cache_bit_width", 0) == 0,
+              "A quantized KV cache (kv_cache_bit_width) is only supported on CPU");
 
   kernel_options_ = this->GetAttentionKernelOptions();
 
@@ -267,6 +267,10 @@ Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
     ORT_THROW("MatMulNBits does not support bias in CUDA kernel");
   }
 
+  if (nbits_ != 4 && nbits_ != 8) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MatMulNBits CUDA kernel supports 4 or 8 bits, got ", nbits_);
+  }
+
   ORT_RETURN_IF_ERROR(matmul_nbits_helper::CheckInputs<Tensor>(
       a, b, scales, zero_points, reorder_idx, bias, N_, K_, block_size_, nbits_));
 
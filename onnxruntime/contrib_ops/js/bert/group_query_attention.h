@@ -15,6 +15,7 @@ class GroupQueryAttention : public JsKernel, GQAAttentionBase {
  public:
   explicit GroupQueryAttention(const OpKernelInfo& info)
       : JsKernel(info), GQAAttentionBase(info, false) {
+    ORT_ENFORCE(kv_cache_bit_width_ == 0, "A quantized KV cache (kv_cache_bit_width) is only supported on CPU");
     JSEP_INIT_KERNEL_ATTRIBUTE(GroupQueryAttention, ({
                                  "numHeads" : $1,
                                  "kvNumHeads" : $2,
@@ -31,6 +31,7 @@ namespace rocm {
       kRocmExecutionProvider,                                          \
       (*KernelDefBuilder::Create())                                    \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())       \
+          .TypeConstraint("T_CACHE", DataTypeImpl::GetTensorType<T>()) \
           .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()) \
           .MayInplace(3, 1)                                            \
           .MayInplace(4, 2)                                            \
@@ -138,6 +139,8 @@ GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info)
   do_rotary_ = info.GetAttrOrDefault<int64_t>("do_rotary", 0) == 1;
   rotary_interleaved_ = info.GetAttrOrDefault<int64_t>("rotary_interleaved", 0) == 1;
   scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("kv_cache_bit_width", 0) == 0,
+              "A quantized KV cache (kv_cache_bit_width) is only supported on CPU");
 }
 
 template <>
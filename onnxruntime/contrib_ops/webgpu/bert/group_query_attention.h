@@ -57,6 +57,9 @@ class GroupQueryAttention final : public WebGpuKernel {
     use_smooth_softmax_ = info.GetAttrOrDefault<int64_t>("smooth_softmax", 0) == 1;
 
     local_window_size_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1));
+
+    ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("kv_cache_bit_width", 0) == 0,
+                "A quantized KV cache (kv_cache_bit_width) is only supported on CPU");
   }
 
   int num_heads_;     // number of attention heads of Q
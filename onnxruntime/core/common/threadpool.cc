@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 
@@ -421,7 +422,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     // Split the work across threads in the pool.  Each work item will run a loop claiming iterations,
     // hence we need at most one for each thread, even if the number of blocks of iterations is larger.
     auto num_blocks = total / block_size;
-    auto num_threads_inc_main = NumThreads() + 1;
+    auto num_threads_inc_main = LimitedThreadsIncludingCaller();
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
     assert(num_work_items > 0);
 
@@ -460,7 +461,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     };
     // Distribute task among all threads in the pool, reduce number of work items if
     // num_of_blocks is smaller than number of threads.
-    RunInParallel(run_work, std::min(NumThreads() + 1, num_of_blocks), base_block_size);
+    RunInParallel(run_work, std::min(LimitedThreadsIncludingCaller(), num_of_blocks), base_block_size);
   }
 }
 
@@ -496,7 +497,10 @@ std::string ThreadPool::StopProfiling() {
 
 namespace {
 thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
-}
+
+// The limit of the innermost DegreeOfParallelismLimit of the calling thread, or 0 if there is none.
+thread_local int current_degree_of_parallelism_limit = 0;
+}  // namespace
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
   ORT_ENFORCE(!current_parallel_section.has_value(), "Nested parallelism not supported");
@@ -516,6 +520,15 @@ ThreadPool::ParallelSection::~ParallelSection() {
   }
 }
 
+ThreadPool::DegreeOfParallelismLimit::DegreeOfParallelismLimit(int max_threads)
+    : previous_limit_(current_degree_of_parallelism_limit) {
+  current_degree_of_parallelism_limit = std::max(max_threads, 0);
+}
+
+ThreadPool::DegreeOfParallelismLimit::~DegreeOfParallelismLimit() {
+  current_degree_of_parallelism_limit = previous_limit_;
+}
+
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
     if (current_parallel_section.has_value()) {
@@ -547,6 +560,11 @@ bool ThreadPool::ShouldParallelizeLoop(const std::ptrdiff_t num_iterations,
     return false;
   }
 
+  // Do not parallelize loops that the caller limited to its own thread.
+  if (current_degree_of_parallelism_limit == 1) {
+    return false;
+  }
+
   return true;
 }
 
@@ -641,15 +659,19 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // tp, plus 1 for the thread entering a loop.
   if (tp) {
     if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
-      return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
+      return tp->LimitedThreadsIncludingCaller() * TaskGranularityFactor;
     } else {
-      return ((tp->NumThreads() + 1));
+      return tp->LimitedThreadsIncludingCaller();
     }
   } else {
     return 1;
   }
 }
 
+int ThreadPool::MaxThreadsIncludingCaller(const concurrency::ThreadPool* tp) {
+  return tp ? tp->NumThreads() + 1 : 1;
+}
+
 void ThreadPool::StartProfiling(concurrency::ThreadPool* tp) {
   if (tp) {
     tp->StartProfiling();
@@ -685,6 +707,14 @@ int ThreadPool::NumThreads() const {
   }
 }
 
+int ThreadPool::LimitedThreadsIncludingCaller() const {
+  const int num_threads_inc_main = NumThreads() + 1;
+  if (current_degree_of_parallelism_limit > 0) {
+    return std::min(num_threads_inc_main, current_degree_of_parallelism_limit);
+  }
+  return num_threads_inc_main;
+}
+
 // Return ID of the current thread within this pool.  Returns -1 for a thread outside the
 // current pool.
 int ThreadPool::CurrentThreadId() const {
@@ -0,0 +1,324 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/cpu_page_allocator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+#include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+#include "core/common/safeint.h"
+#include "core/framework/bfc_arena.h"
+#include "core/framework/config_options.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+
+Status CPUPageAllocatorOptions::Create(int huge_pages, int numa_node, CPUPageAllocatorOptions& out) {
+  ORT_RETURN_IF(huge_pages < static_cast<int>(HugePageMode::kNone) ||
+                    huge_pages > static_cast<int>(HugePageMode::kExplicit1GB),
+                "Invalid huge page mode ", huge_pages, ". Valid values are 0, 1, 2 and 3.");
+  ORT_RETURN_IF(numa_node < -1, "Invalid NUMA node ", numa_node, ". Use -1 to not bind the memory to a node.");
+
+  out.huge_pages = static_cast<HugePageMode>(huge_pages);
+  out.numa_node = numa_node;
+  return Status::OK();
+}
+
+Status CPUPageAllocatorOptions::FromConfigOptions(const ConfigOptions& config_options,
+                                                  CPUPageAllocatorOptions& out) {
+  int huge_pages = 0;
+  int numa_node = -1;
+
+  const auto parse = [&config_options](const char* key, int& value) -> Status {
+    if (const auto str = config_options.GetConfigEntry(key); str.has_value()) {
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(*str, value),
+                        "Failed to parse the value of session config entry ", key, ": ", *str);
+    }
+    return Status::OK();
+  };
+
+  ORT_RETURN_IF_ERROR(parse(kOrtSessionOptionsCpuAllocatorHugePages, huge_pages));
+  ORT_RETURN_IF_ERROR(parse(kOrtSessionOptionsCpuAllocatorNumaNode, numa_node));
+  return Create(huge_pages, numa_node, out);
+}
+
+namespace {
+
+#if defined(__linux__) || defined(_WIN32)
+size_t RoundUpToMultiple(size_t size, size_t alignment) {
+  return (SafeInt<size_t>(size) + alignment - 1) / alignment * alignment;
+}
+#endif
+
+#if defined(__linux__)
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+constexpr size_t k2MB = size_t{1} << 21;
+constexpr size_t k1GB = size_t{1} << 30;
+
+void* MapAnonymous(size_t size, int extra_flags) {
+  void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  return p == MAP_FAILED ? nullptr : p;
+}
+
+// mmap only guarantees the alignment of regular pages. Over-map by alignment bytes and unmap the excess on both
+// sides to get a region that huge pages can back completely.
+void* MapAligned(size_t size, size_t alignment) {
+  const size_t over_mapped_size = SafeInt<size_t>(size) + alignment;
+  void* p = MapAnonymous(over_mapped_size, 0);
+  if (p == nullptr) {
+    return nullptr;
+  }
+
+  const auto begin = reinterpret_cast<uintptr_t>(p);
+  const auto aligned = (begin + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+  if (aligned > begin) {
+    munmap(p, aligned - begin);
+  }
+
+  const size_t tail = begin + over_mapped_size - (aligned + size);
+  if (tail > 0) {
+    munmap(reinterpret_cast<void*>(aligned + size), tail);
+  }
+
+  return reinterpret_cast<void*>(aligned);
+}
+
+// Sets the NUMA policy of the range with the mbind syscall, so that there is no dependency on libnuma.
+// The range has not been touched yet, so the pages are allocated on the node when they are first written.
+bool BindToNumaNode(void* p, size_t size, int numa_node) {
+#if defined(SYS_mbind)
+  // MPOL_PREFERRED places the pages on the node and falls back to other nodes when it is out of memory, where
+  // MPOL_BIND would fail the allocation.
+  constexpr int kMpolPreferred = 1;
+  constexpr size_t kBitsPerMaskWord = sizeof(unsigned long) * 8;
+
+  std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / kBitsPerMaskWord + 1);
+  node_mask[static_cast<size_t>(numa_node) / kBitsPerMaskWord] |= 1UL << (numa_node % kBitsPerMaskWord);
+  return syscall(SYS_mbind, p, size, kMpolPreferred, node_mask.data(), node_mask.size() * kBitsPerMaskWord + 1,
+                 0) == 0;
+#else
+  ORT_UNUSED_PARAMETER(p);
+  ORT_UNUSED_PARAMETER(size);
+  ORT_UNUSED_PARAMETER(numa_node);
+  return false;
+#endif
+}
+
+#endif  // defined(__linux__)
+
+// The arena regions are sized this many bytes short of whole huge pages, so that the MLAS_SYMM_QGEMM_BUF_OVERRUN
+// bytes that MapPages adds to every region do not take another huge page. It is a multiple of the 256 byte minimum
+// allocation size of BFCArena, which the region sizes must be multiples of.
+constexpr size_t kArenaRegionSlack = 256;
+static_assert(MLAS_SYMM_QGEMM_BUF_OVERRUN <= kArenaRegionSlack);
+
+}  // namespace
+
+size_t CPUPageAllocatorOptions::HugePageSize() const {
+#if defined(__linux__)
+  switch (huge_pages) {
+    case HugePageMode::kTransparent:
+    case HugePageMode::kExplicit2MB:
+      return k2MB;
+    case HugePageMode::kExplicit1GB:
+      return k1GB;
+    default:
+      return 0;
+  }
+#elif defined(_WIN32)
+  // Windows has no transparent huge pages, and both explicit modes use large pages.
+  if (huge_pages == HugePageMode::kExplicit2MB || huge_pages == HugePageMode::kExplicit1GB) {
+    return GetLargePageMinimum();
+  }
+  return 0;
+#else
+  return 0;
+#endif
+}
+
+void CPUPageAllocatorOptions::AdjustArenaConfig(OrtArenaCfg& arena_cfg) const {
+  const size_t page_size = HugePageSize();
+  if (page_size == 0) {
+    return;
+  }
+
+  // Rounds a region size down to whole huge pages, with at least one page, less the slack. Doubling such a size, as
+  // the kNextPowerOfTwo extend strategy does, keeps it a whole number of pages.
+  const auto to_region_size = [page_size](int64_t bytes) {
+    const size_t pages = std::max<size_t>(static_cast<size_t>(bytes) / page_size, 1);
+    return static_cast<int64_t>(SafeInt<size_t>(pages) * page_size - kArenaRegionSlack);
+  };
+
+  const auto adjust = [&to_region_size](int& bytes, int default_bytes) {
+    const int64_t region_size = to_region_size(bytes == -1 ? default_bytes : bytes);
+    if (region_size <= std::numeric_limits<int>::max()) {
+      bytes = static_cast<int>(region_size);
+    }
+  };
+
+  adjust(arena_cfg.initial_chunk_size_bytes, BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES);
+  adjust(arena_cfg.initial_growth_chunk_size_bytes, BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES);
+  arena_cfg.max_power_of_two_extend_bytes = to_region_size(arena_cfg.max_power_of_two_extend_bytes == -1
+                                                               ? BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES
+                                                               : arena_cfg.max_power_of_two_extend_bytes);
+}
+
+CPUPageAllocator::CPUPageAllocator(const OrtMemoryInfo& memory_info, const CPUPageAllocatorOptions& options)
+    : IAllocator(memory_info), options_(options) {
+}
+
+CPUPageAllocator::~CPUPageAllocator() {
+  for (const auto& [p, mapped_size] : allocations_) {
+    UnmapPages(p, mapped_size);
+  }
+}
+
+void* CPUPageAllocator::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t mapped_size = 0;
+  void* p = MapPages(size, mapped_size);
+  if (p == nullptr) {
+    ORT_THROW_EX(std::bad_alloc);
+  }
+
+  allocations_.emplace(p, mapped_size);
+  return p;
+}
+
+void CPUPageAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = allocations_.find(p);
+  ORT_ENFORCE(it != allocations_.end(), "Freeing a pointer that was not allocated by this CPUPageAllocator.");
+  UnmapPages(p, it->second);
+  allocations_.erase(it);
+}
+
+#if defined(__linux__)
+
+void* CPUPageAllocator::MapPages(size_t size, size_t& mapped_size) {
+  size = SafeInt<size_t>(size) + MLAS_SYMM_QGEMM_BUF_OVERRUN;
+  void* p = nullptr;
+
+  if (options_.huge_pages == HugePageMode::kExplicit2MB || options_.huge_pages == HugePageMode::kExplicit1GB) {
+    const bool use_1gb = options_.huge_pages == HugePageMode::kExplicit1GB;
+    const int page_size_log2 = use_1gb ? 30 : 21;
+    mapped_size = RoundUpToMultiple(size, use_1gb ? k1GB : k2MB);
+    p = MapAnonymous(mapped_size, MAP_HUGETLB | (page_size_log2 << MAP_HUGE_SHIFT));
+    if (p == nullptr && !logged_fallback_) {
+      LOGS_DEFAULT(WARNING) << "Failed to map " << mapped_size << " bytes of " << (use_1gb ? "1 GB" : "2 MB")
+                            << " huge pages. Falling back to transparent huge pages. Reserve huge pages with "
+                            << "/proc/sys/vm/nr_hugepages or the hugepages kernel parameter.";
+      logged_fallback_ = true;
+    }
+  }
+
+  if (p == nullptr && options_.huge_pages != HugePageMode::kNone) {
+    mapped_size = RoundUpToMultiple(size, k2MB);
+    p = MapAligned(mapped_size, k2MB);
+    if (p != nullptr) {
+      // this is only advice, so a kernel without transparent huge page support leaves the region on regular pages
+      madvise(p, mapped_size, MADV_HUGEPAGE);
+    }
+  }
+
+  if (p == nullptr && options_.huge_pages == HugePageMode::kNone) {
+    mapped_size = RoundUpToMultiple(size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+    p = MapAnonymous(mapped_size, 0);
+  }
+
+  if (p != nullptr && options_.numa_node >= 0 && !BindToNumaNode(p, mapped_size, options_.numa_node)) {
+    LOGS_DEFAULT(WARNING) << "Failed to bind " << mapped_size << " bytes to NUMA node " << options_.numa_node
+                          << ". errno: " << errno;
+  }
+
+  return p;
+}
+
+void CPUPageAllocator::UnmapPages(void* p, size_t mapped_size) {
+  munmap(p, mapped_size);
+}
+
+#elif defined(_WIN32)
+
+void* CPUPageAllocator::MapPages(size_t size, size_t& mapped_size) {
+  size = SafeInt<size_t>(size) + MLAS_SYMM_QGEMM_BUF_OVERRUN;
+  void* p = nullptr;
+
+  const auto virtual_alloc = [this](size_t alloc_size, DWORD extra_flags) -> void* {
+    const DWORD flags = MEM_RESERVE | MEM_COMMIT | extra_flags;
+    if (options_.numa_node >= 0) {
+      return VirtualAllocExNuma(GetCurrentProcess(), nullptr, alloc_size, flags, PAGE_READWRITE,
+                                static_cast<DWORD>(options_.numa_node));
+    }
+    return VirtualAlloc(nullptr, alloc_size, flags, PAGE_READWRITE);
+  };
+
+  // Windows has no transparent huge pages, and large pages are the size that GetLargePageMinimum reports,
+  // so both explicit modes use large pages.
+  if (options_.huge_pages == HugePageMode::kExplicit2MB || options_.huge_pages == HugePageMode::kExplicit1GB) {
+    if (const size_t large_page_size = GetLargePageMinimum(); large_page_size > 0) {
+      mapped_size = RoundUpToMultiple(size, large_page_size);
+      p = virtual_alloc(mapped_size, MEM_LARGE_PAGES);
+    }
+
+    if (p == nullptr && !logged_fallback_) {
+      LOGS_DEFAULT(WARNING) << "Failed to allocate " << size << " bytes of large pages. Falling back to regular "
+                            << "pages. Large pages require the SeLockMemoryPrivilege privilege.";
+      logged_fallback_ = true;
+    }
+  }
+
+  if (p == nullptr) {
+    mapped_size = size;
+    p = virtual_alloc(mapped_size, 0);
+  }
+
+  return p;
+}
+
+void CPUPageAllocator::UnmapPages(void* p, size_t /*mapped_size*/) {
+  VirtualFree(p, 0, MEM_RELEASE);
+}
+
+#else
+
+void* CPUPageAllocator::MapPages(size_t size, size_t& mapped_size) {
+  // huge pages and NUMA placement are not supported on this platform
+  mapped_size = size;
+  return AllocatorDefaultAllocAligned(size, std::max(Info().device.GetAlignment(), MlasGetPreferredBufferAlignment()));
+}
+
+void CPUPageAllocator::UnmapPages(void* p, size_t /*mapped_size*/) {
+  AllocatorDefaultFreeAligned(p, std::max(Info().device.GetAlignment(), MlasGetPreferredBufferAlignment()));
+}
+
+#endif
+
+}  // namespace onnxruntime
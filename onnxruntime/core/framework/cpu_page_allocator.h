@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+struct ConfigOptions;
+
+// The pages that back the memory of a CPUPageAllocator.
+// The values match the "arena.huge_pages" arena config key and the kOrtSessionOptionsCpuAllocatorHugePages
+// session config entry.
+enum class HugePageMode : int {
+  kNone = 0,         // regular pages
+  kTransparent = 1,  // 2 MB aligned memory that is advised for transparent huge pages
+  kExplicit2MB = 2,  // explicitly reserved 2 MB huge pages, falling back to kTransparent if none are available
+  kExplicit1GB = 3,  // explicitly reserved 1 GB huge pages, falling back to kTransparent if none are available
+};
+
+struct CPUPageAllocatorOptions {
+  HugePageMode huge_pages{HugePageMode::kNone};
+  // The NUMA node that the memory is placed on, or -1 to leave the placement to the first touch.
+  int numa_node{-1};
+
+  // Returns true if a CPUPageAllocator should be used instead of the default CPUAllocator.
+  bool IsEnabled() const { return huge_pages != HugePageMode::kNone || numa_node >= 0; }
+
+  // Returns the size of the huge pages that back the memory, or 0 if it is backed by regular pages.
+  size_t HugePageSize() const;
+
+  // Sizes the regions of a BFCArena that maps them from a CPUPageAllocator to whole huge pages. Every mapping is
+  // rounded up to the huge page size, so the default 1 MB initial chunk and its extensions would leave most of each
+  // huge page unused. Does nothing if the memory is backed by regular pages.
+  void AdjustArenaConfig(OrtArenaCfg& arena_cfg) const;
+
+  static Status Create(int huge_pages, int numa_node, CPUPageAllocatorOptions& out);
+
+  // Reads the options from the kOrtSessionOptionsCpuAllocatorHugePages and kOrtSessionOptionsCpuAllocatorNumaNode
+  // session config entries.
+  static Status FromConfigOptions(const ConfigOptions& config_options, CPUPageAllocatorOptions& out);
+};
+
+// CPUPageAllocator maps its memory directly from the OS, so the memory can be backed by huge pages and be placed on
+// a given NUMA node. Large weights that are read on every inference suffer from TLB misses when they are spread over
+// regular 4 KB pages, and on multi-socket hosts they otherwise land on the node of the thread that touched them first.
+//
+// Every allocation is rounded up to the page size, so the allocator is meant to back the large regions of a BFCArena
+// rather than to serve many small tensors. Use CPUPageAllocatorOptions::AdjustArenaConfig to size the regions.
+// Huge pages are supported on Linux (MAP_HUGETLB and madvise) and, as large pages, on Windows. NUMA placement is
+// supported on Linux and Windows. On other platforms the options are ignored.
+class CPUPageAllocator : public IAllocator {
+ public:
+  CPUPageAllocator(const OrtMemoryInfo& memory_info, const CPUPageAllocatorOptions& options);
+  ~CPUPageAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CPUPageAllocator);
+
+  void* MapPages(size_t size, size_t& mapped_size);
+  void UnmapPages(void* p, size_t mapped_size);
+
+  const CPUPageAllocatorOptions options_;
+
+  std::mutex mutex_;
+  // mapped size of each allocation
+  InlinedHashMap<void*, size_t> allocations_;
+  bool logged_fallback_{false};
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/env_resource_manager.h"
+
+#include <algorithm>
+
+#include "core/framework/allocator_stats.h"
+#include "core/framework/bfc_arena.h"
+
+namespace onnxruntime {
+
+namespace {
+
+int64_t GetPriorityWeight(ResourcePriority priority) {
+  switch (priority) {
+    case ResourcePriority::kLow:
+      return 1;
+    case ResourcePriority::kHigh:
+      return 4;
+    default:
+      return 2;
+  }
+}
+
+AllocatorStats GetArenaStats(IAllocator& arena) {
+  AllocatorStats stats;
+  arena.GetStats(&stats);
+  return stats;
+}
+
+}  // namespace
+
+Status ParseResourcePriority(const std::string& value, ResourcePriority& priority) {
+  if (value == "low") {
+    priority = ResourcePriority::kLow;
+  } else if (value == "normal") {
+    priority = ResourcePriority::kNormal;
+  } else if (value == "high") {
+    priority = ResourcePriority::kHigh;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid resource priority '", value,
+                           "'. It must be 'low', 'normal' or 'high'.");
+  }
+
+  return Status::OK();
+}
+
+const char* ResourcePriorityToString(ResourcePriority priority) {
+  switch (priority) {
+    case ResourcePriority::kLow:
+      return "low";
+    case ResourcePriority::kHigh:
+      return "high";
+    default:
+      return "normal";
+  }
+}
+
+void EnvResourceManager::SetLimits(int thread_budget, size_t arena_memory_cap) {
+  thread_budget_.store(std::max(thread_budget, 0), std::memory_order_relaxed);
+  arena_memory_cap_.store(arena_memory_cap, std::memory_order_relaxed);
+}
+
+std::unique_ptr<EnvResourceManager::SessionResources> EnvResourceManager::RegisterSession(
+    std::string name, ResourcePriority priority, int max_threads, InlinedVector<AllocatorPtr> arenas) {
+  std::unique_ptr<SessionResources> session(
+      new SessionResources(*this, std::move(name), priority, max_threads, std::move(arenas)));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  sessions_.push_back(session.get());
+  return session;
+}
+
+void EnvResourceManager::Unregister(const SessionResources& session) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sessions_.erase(std::remove(sessions_.begin(), sessions_.end(), &session), sessions_.end());
+}
+
+void EnvResourceManager::ReclaimArenaMemory(const logging::Logger& logger) {
+  const auto cap = static_cast<int64_t>(GetArenaMemoryCap());
+  if (cap == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Sessions can share the arenas of the environment, so each arena is counted once.
+  InlinedHashSet<IAllocator*> counted_arenas;
+  int64_t bytes_reserved = 0;
+  for (const SessionResources* session : sessions_) {
+    for (const auto& arena : session->arenas_) {
+      if (counted_arenas.insert(arena.get()).second) {
+        bytes_reserved += GetArenaStats(*arena).total_allocated_bytes;
+      }
+    }
+  }
+
+  if (bytes_reserved <= cap) {
+    return;
+  }
+
+  // The arenas of idle sessions only hold what the sessions keep between runs, so they are reclaimed first.
+  InlinedVector<SessionResources*> sessions(sessions_.begin(), sessions_.end());
+  std::stable_sort(sessions.begin(), sessions.end(), [](const SessionResources* a, const SessionResources* b) {
+    const bool a_idle = a->active_runs_.load(std::memory_order_relaxed) == 0;
+    const bool b_idle = b->active_runs_.load(std::memory_order_relaxed) == 0;
+    if (a_idle != b_idle) {
+      return a_idle;
+    }
+    return a->priority_ < b->priority_;
+  });
+
+  InlinedHashSet<IAllocator*> shrunk_arenas;
+  for (SessionResources* session : sessions) {
+    for (const auto& arena : session->arenas_) {
+      if (bytes_reserved <= cap) {
+        return;
+      }
+
+      if (!shrunk_arenas.insert(arena.get()).second) {
+        continue;
+      }
+
+      const int64_t bytes_before = GetArenaStats(*arena).total_allocated_bytes;
+      auto status = static_cast<BFCArena*>(arena.get())->Shrink();
+      if (!status.IsOK()) {
+        LOGS(logger, WARNING) << "Unable to shrink arena: " << arena->Info().ToString()
+                              << " of session " << session->name_ << " error message: " << status.ErrorMessage();
+        continue;
+      }
+
+      // Runs in progress may allocate from the arena at the same time, so only count what was released.
+      const int64_t bytes_released = std::max<int64_t>(bytes_before - GetArenaStats(*arena).total_allocated_bytes, 0);
+      bytes_reserved -= bytes_released;
+      session->arena_bytes_reclaimed_.fetch_add(bytes_released, std::memory_order_relaxed);
+    }
+  }
+
+  if (bytes_reserved > cap) {
+    LOGS(logger, INFO) << "The memory arenas of the sessions reserve " << bytes_reserved
+                       << " bytes after releasing their unused regions, which is above the cap of " << cap
+                       << " bytes.";
+  }
+}
+
+EnvResourceManager::SessionResources::SessionResources(EnvResourceManager& manager, std::string name,
+                                                       ResourcePriority priority, int max_threads,
+                                                       InlinedVector<AllocatorPtr> arenas)
+    : manager_(manager),
+      name_(std::move(name)),
+      priority_(priority),
+      weight_(GetPriorityWeight(priority)),
+      max_threads_(std::max(max_threads, 1)),
+      arenas_(std::move(arenas)) {
+}
+
+EnvResourceManager::SessionResources::~SessionResources() {
+  manager_.Unregister(*this);
+}
+
+int EnvResourceManager::SessionResources::GetThreadGrant() const {
+  const int64_t thread_budget = manager_.GetThreadBudget();
+  if (thread_budget == 0) {
+    return 0;
+  }
+
+  // The run that asks is in progress, so the total weight includes its own unless the caller has no RunScope.
+  const int64_t total_weight = std::max(manager_.active_weight_.load(std::memory_order_relaxed), weight_);
+  const int64_t thread_grant = std::max<int64_t>(thread_budget * weight_ / total_weight, 1);
+  return thread_grant < max_threads_ ? static_cast<int>(thread_grant) : 0;
+}
+
+SessionResourceUsage EnvResourceManager::SessionResources::GetUsage() const {
+  SessionResourceUsage usage;
+  usage.priority = priority_;
+  usage.max_threads = max_threads_;
+  const int thread_grant = GetThreadGrant();
+  usage.thread_grant = thread_grant != 0 ? thread_grant : max_threads_;
+  usage.active_runs = active_runs_.load(std::memory_order_relaxed);
+  for (const auto& arena : arenas_) {
+    const AllocatorStats stats = GetArenaStats(*arena);
+    usage.arena_bytes_in_use += stats.bytes_in_use;
+    usage.arena_bytes_reserved += stats.total_allocated_bytes;
+  }
+  usage.arena_bytes_reclaimed = arena_bytes_reclaimed_.load(std::memory_order_relaxed);
+  return usage;
+}
+
+void EnvResourceManager::SessionResources::ReclaimArenaMemory(const logging::Logger& logger) {
+  manager_.ReclaimArenaMemory(logger);
+}
+
+EnvResourceManager::RunScope::RunScope(SessionResources& session) : session_(session) {
+  session_.active_runs_.fetch_add(1, std::memory_order_relaxed);
+  session_.manager_.active_weight_.fetch_add(session_.weight_, std::memory_order_relaxed);
+}
+
+EnvResourceManager::RunScope::~RunScope() {
+  session_.manager_.active_weight_.fetch_sub(session_.weight_, std::memory_order_relaxed);
+  session_.active_runs_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+}  // namespace onnxruntime
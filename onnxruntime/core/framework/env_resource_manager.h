@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+/// Priority class of a session for the resources that the sessions of an Environment share.
+enum class ResourcePriority {
+  kLow,
+  kNormal,
+  kHigh,
+};
+
+/// Parses the value of the "session.resource_priority" session config entry: "low", "normal" or "high".
+Status ParseResourcePriority(const std::string& value, ResourcePriority& priority);
+
+const char* ResourcePriorityToString(ResourcePriority priority);
+
+/// Resources that a session uses, as reported by EnvResourceManager.
+struct SessionResourceUsage {
+  ResourcePriority priority = ResourcePriority::kNormal;
+  int max_threads = 1;                // intra-op threads of the session, including the thread calling Run
+  int thread_grant = 1;               // threads that a run of the session may use at the moment
+  int active_runs = 0;
+  int64_t arena_bytes_in_use = 0;
+  int64_t arena_bytes_reserved = 0;
+  int64_t arena_bytes_reclaimed = 0;  // bytes released from the arenas of the session to keep within the cap
+};
+
+/**
+ * Arbitrates the intra-op threads and the arena memory between the sessions of an Environment.
+ *
+ * Thread budget: the runs in progress across all sessions share the budget in proportion to the weight of the
+ * priority class of their session, which is 1 for low, 2 for normal and 4 for high. Each node runs with a
+ * ThreadPool::DegreeOfParallelismLimit of the share of its run when the node starts, so the shares follow the runs
+ * that start and finish in other sessions. A run always keeps its calling thread.
+ *
+ * Arena memory cap: when the memory arenas of the sessions reserve more than the cap at the end of a run, the regions
+ * of the arenas that have no memory in use are released until the total is within the cap. Idle sessions are
+ * reclaimed from before busy ones, and lower priority sessions before higher priority ones. Memory in use is never
+ * released, so the cap bounds the memory that the arenas keep between runs rather than their peak.
+ *
+ * Without limits the manager only tracks the usage of the sessions.
+ */
+class EnvResourceManager {
+ public:
+  EnvResourceManager() = default;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(EnvResourceManager);
+
+  /**
+   * Sets the limits of the sessions of the environment. They apply to the nodes and runs that start afterwards.
+   * @param thread_budget Number of intra-op threads, including the threads calling Run, that the runs of all the
+   *                      sessions may use at the same time. 0 for no limit.
+   * @param arena_memory_cap Number of bytes that the memory arenas of all the sessions may keep. 0 for no limit.
+   */
+  void SetLimits(int thread_budget, size_t arena_memory_cap);
+
+  int GetThreadBudget() const { return thread_budget_.load(std::memory_order_relaxed); }
+
+  size_t GetArenaMemoryCap() const { return arena_memory_cap_.load(std::memory_order_relaxed); }
+
+  class RunScope;
+
+  /// The resources of a registered session. The session is unregistered when the object is destroyed.
+  class SessionResources {
+   public:
+    ~SessionResources();
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionResources);
+
+    /// Returns the number of threads that a node of a run of the session may use now, or 0 if it is not limited.
+    int GetThreadGrant() const;
+
+    SessionResourceUsage GetUsage() const;
+
+    /// Releases unused arena memory of the sessions if their arenas exceed the memory cap. Called after each run.
+    void ReclaimArenaMemory(const logging::Logger& logger);
+
+   private:
+    friend class EnvResourceManager;
+    friend class RunScope;
+
+    SessionResources(EnvResourceManager& manager, std::string name, ResourcePriority priority, int max_threads,
+                     InlinedVector<AllocatorPtr> arenas);
+
+    EnvResourceManager& manager_;
+    const std::string name_;
+    const ResourcePriority priority_;
+    const int64_t weight_;
+    const int max_threads_;
+    const InlinedVector<AllocatorPtr> arenas_;  // BFCArena instances
+
+    std::atomic<int> active_runs_{0};
+    std::atomic<int64_t> arena_bytes_reclaimed_{0};
+  };
+
+  /**
+   * Registers a session.
+   * @param name Name of the session in the log messages.
+   * @param priority Priority class of the session.
+   * @param max_threads Number of threads, including the calling thread, that the intra-op pool of the session can use.
+   * @param arenas The BFCArena allocators of the session. Arenas shared with other sessions are counted once.
+   */
+  std::unique_ptr<SessionResources> RegisterSession(std::string name, ResourcePriority priority, int max_threads,
+                                                    InlinedVector<AllocatorPtr> arenas);
+
+  /// Counts a run of a session as in progress for the thread budget while the object is alive.
+  class RunScope {
+   public:
+    explicit RunScope(SessionResources& session);
+    ~RunScope();
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunScope);
+
+   private:
+    SessionResources& session_;
+  };
+
+ private:
+  void Unregister(const SessionResources& session);
+
+  void ReclaimArenaMemory(const logging::Logger& logger);
+
+  std::atomic<int> thread_budget_{0};
+  std::atomic<size_t> arena_memory_cap_{0};
+
+  // Sum of the priority weights of the runs in progress.
+  std::atomic<int64_t> active_weight_{0};
+
+  std::mutex mutex_;
+  InlinedVector<SessionResources*> sessions_;
+};
+
+}  // namespace onnxruntime
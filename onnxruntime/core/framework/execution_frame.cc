@@ -330,6 +330,12 @@ Status IExecutionFrame::GetOutputs(std::vector<OrtValue>& fetches) {
   return Status::OK();
 }
 
+void IExecutionFrame::ClearValues() {
+  for (auto& value : all_values_) {
+    value = OrtValue();
+  }
+}
+
 bool IExecutionFrame::IsOutput(int ort_value_idx) const {
   return std::find(fetch_mlvalue_idxs_.begin(), fetch_mlvalue_idxs_.end(), ort_value_idx) != fetch_mlvalue_idxs_.end();
 }
@@ -347,38 +353,13 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 #endif
       session_state_(session_state),
       mem_patterns_(nullptr) {
-  Init(
-      feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
-#if !defined(DISABLE_SPARSE_TENSORS)
-      [&session_state](const std::string& name) -> bool {
-        int idx = -1;
-        if (session_state.GetOrtValueNameIdxMap().GetIdx(name, idx).IsOK()) {
-          return session_state.IsSparseInitializer(idx);
-        }
-        return false;
-      },
-#else
-      [&](const std::string& /*name*/) -> bool {
-        return false;
-      },
-#endif
-      fetches);
+  InitValues(feed_mlvalue_idxs, feeds, fetches);
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   session_state.GetMemoryProfiler()->GetMemoryInfo().IncreaseIteration();
 #endif
 
-  // map the custom allocators to ort_value_idx entries
-  if (!fetch_allocators.empty()) {
-    custom_allocators_.reserve(fetch_allocators.size());
-    const auto idx_size = fetch_mlvalue_idxs.size();
-    for (const auto& e : fetch_allocators) {
-      if (e.first < idx_size) {
-        int ort_value_idx = fetch_mlvalue_idxs[e.first];
-        custom_allocators_.insert_or_assign(ort_value_idx, e.second);
-      }
-    }
-  }
+  SetCustomAllocators(fetch_mlvalue_idxs, fetch_allocators);
 
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
@@ -395,11 +376,31 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
-      // if no existing patterns, generate one in this execution frame
-      if (!mem_patterns_) {
-        planner_.emplace(*session_state.GetExecutionPlan());
+      if (session_state.GetEnableSymbolicMemoryPattern()) {
+        // evaluate the symbolic pattern for the input shapes of this execution.
+        // if it doesn't exist yet, trace this execution to generate it.
+        const auto* symbolic_patterns = session_state.GetSymbolicMemoryPatternGroup();
+        if (!symbolic_patterns) {
+          planner_.emplace(*session_state.GetExecutionPlan());
+          symbolic_trace_.emplace();
+        } else {
+          auto status = symbolic_patterns->Evaluate(feed_mlvalue_idxs, feeds, evaluated_mem_patterns_);
+          if (status.IsOK()) {
+            mem_patterns_ = &evaluated_mem_patterns_;
+          } else {
+            LOGS(session_state_.Logger(), VERBOSE) << "Symbolic memory pattern is not used for this execution: "
+                                                   << status.ErrorMessage();
+          }
+        }
       } else {
+        mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+        // if no existing patterns, generate one in this execution frame
+        if (!mem_patterns_) {
+          planner_.emplace(*session_state.GetExecutionPlan());
+        }
+      }
+
+      if (mem_patterns_) {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         buffers_.reserve(mem_patterns_->locations.size());
@@ -493,6 +494,59 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
 ExecutionFrame::~ExecutionFrame() = default;
 
+void ExecutionFrame::InitValues(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                gsl::span<const OrtValue> fetches) {
+  Init(
+      feed_mlvalue_idxs, feeds, session_state_.GetInitializedTensors(),
+#if !defined(DISABLE_SPARSE_TENSORS)
+      [this](const std::string& name) -> bool {
+        int idx = -1;
+        if (session_state_.GetOrtValueNameIdxMap().GetIdx(name, idx).IsOK()) {
+          return session_state_.IsSparseInitializer(idx);
+        }
+        return false;
+      },
+#else
+      [&](const std::string& /*name*/) -> bool {
+        return false;
+      },
+#endif
+      fetches);
+}
+
+void ExecutionFrame::SetCustomAllocators(gsl::span<const int> fetch_mlvalue_idxs,
+                                         const std::unordered_map<size_t, IExecutor::CustomAllocator>&
+                                             fetch_allocators) {
+  custom_allocators_.clear();
+
+  // map the custom allocators to ort_value_idx entries
+  if (!fetch_allocators.empty()) {
+    custom_allocators_.reserve(fetch_allocators.size());
+    const auto idx_size = fetch_mlvalue_idxs.size();
+    for (const auto& e : fetch_allocators) {
+      if (e.first < idx_size) {
+        int ort_value_idx = fetch_mlvalue_idxs[e.first];
+        custom_allocators_.insert_or_assign(ort_value_idx, e.second);
+      }
+    }
+  }
+}
+
+void ExecutionFrame::Reset(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                           gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches,
+                           const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  ORT_ENFORCE(!planner_.has_value(), "An execution frame that traces a memory pattern can't be reset.");
+
+  ClearValues();
+  InitValues(feed_mlvalue_idxs, feeds, fetches);
+
+#if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
+  session_state_.GetMemoryProfiler()->GetMemoryInfo().IncreaseIteration();
+#endif
+
+  SetCustomAllocators(fetch_mlvalue_idxs, fetch_allocators);
+}
+
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
 }
@@ -901,6 +955,9 @@ void ExecutionFrame::TraceAllocate(int ort_value_idx, size_t size) {
       LOGS(session_state_.Logger(), WARNING) << "TraceAllocation for ort_value_idx=" << ort_value_idx
                                              << " size=" << size << " failed: " << status.ErrorMessage();
     }
+    if (symbolic_trace_.has_value()) {
+      symbolic_trace_->TraceAllocation(ort_value_idx, size);
+    }
   }
 }
 
@@ -925,6 +982,9 @@ void ExecutionFrame::TraceFree(int ort_value_idx) {
           LOGS(session_state_.Logger(), WARNING)
               << "TraceFree for ort_value_idx=" << ort_value_idx << " failed: " << status.ErrorMessage();
         }
+        if (symbolic_trace_.has_value()) {
+          symbolic_trace_->TraceFree(ort_value_idx);
+        }
       }
     }
   }
@@ -940,6 +1000,21 @@ Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup& out) {
   return planner_->GeneratePatterns(out);
 }
 
+// generate the symbolic memory pattern based on the tracing of memory allocation/free in current execution.
+// return error if the symbolic trace is not setup.
+Status ExecutionFrame::GenerateSymbolicPatterns(gsl::span<const int> feed_mlvalue_idxs,
+                                                gsl::span<const OrtValue> feeds,
+                                                std::unique_ptr<SymbolicMemoryPatternGroup>& out) {
+  if (!planner_.has_value() || !symbolic_trace_.has_value()) {
+    return Status(ONNXRUNTIME, FAIL, "Symbolic memory pattern tracing is not enabled on this execution framework.");
+  }
+
+  MemoryPatternGroup traced_patterns;
+  ORT_RETURN_IF_ERROR(planner_->GeneratePatterns(traced_patterns));
+  return SymbolicMemoryPatternGroup::Create(session_state_, feed_mlvalue_idxs, feeds, *symbolic_trace_,
+                                            traced_patterns, out);
+}
+
 bool ExecutionFrame::TryGetInferredShape(int index, TensorShape& shape) const {
   // NodeArg index to OrtValue index.
   int ort_value_idx = GetNodeIdxToMLValueIdx(index);
@@ -14,6 +14,7 @@
 #include "core/framework/node_index_info.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/sequential_execution_plan.h"
+#include "core/framework/symbolic_mem_pattern.h"
 #include "core/framework/tensor.h"
 #include "core/graph/graph_viewer.h"
 
@@ -103,6 +104,9 @@ class IExecutionFrame {
   // returns true if the ort_value_idx is an output from the graph
   bool IsOutput(int ort_value_idx) const;
 
+  // Release all the values, so that Init can be called again.
+  void ClearValues();
+
   const OrtValueNameIdxMap& GetOrtValueNameIdxMap() const noexcept { return ort_value_idx_map_; }
 
  private:
@@ -161,6 +165,14 @@ class ExecutionFrame final : public IExecutionFrame {
                                                 const OrtDevice& location, const TensorShape& shape,
                                                 bool is_strided_tensor = false);
 
+  // Rebinds the frame to the feeds and fetches of another execution of the plan, keeping the memory pattern buffers.
+  // This lets a control flow node execute its subgraph repeatedly without creating a frame each time.
+  // The feeds must have the shapes of the feeds the frame was created with, as the memory patterns and the inferred
+  // shapes depend on them, and the previous execution must have completed.
+  void Reset(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+             gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
   // thread-safe
   Status GeneratePatterns(MemoryPatternGroup& out);
 
@@ -168,6 +180,13 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_.has_value();
   }
 
+  Status GenerateSymbolicPatterns(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                  std::unique_ptr<SymbolicMemoryPatternGroup>& out);
+
+  bool HasSymbolicMemoryPatternTrace() const {
+    return symbolic_trace_.has_value();
+  }
+
 #if !defined(ORT_MINIMAL_BUILD)
   std::optional<size_t> GetOrtValueDynamicAllocation(int ort_value_index) const {
     auto it = ort_value_to_dynamic_allocations_size_.find(ort_value_index);
@@ -207,6 +226,12 @@ class ExecutionFrame final : public IExecutionFrame {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
+  void InitValues(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                  gsl::span<const OrtValue> fetches);
+
+  void SetCustomAllocators(gsl::span<const int> fetch_mlvalue_idxs,
+                           const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
   AllocatorPtr GetAllocatorImpl(const OrtDevice& info) const override;
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) override;
@@ -249,6 +274,13 @@ class ExecutionFrame final : public IExecutionFrame {
   // use this planner_ to trace the memory allocation in current executor.
   std::optional<OrtValuePatternPlanner> planner_;
 
+  // If the symbolic memory pattern is enabled but not generated yet, trace the order of the allocations
+  // in current executor in addition to planner_.
+  std::optional<SymbolicMemoryPatternTrace> symbolic_trace_;
+
+  // The symbolic memory pattern evaluated for the input shapes of current executor.
+  MemoryPatternGroup evaluated_mem_patterns_;
+
   // Big chunks on different locations that will be used by mem_pattern.
   InlinedHashMap<OrtDevice, BufferUniquePtr> buffers_;
 
@@ -0,0 +1,271 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/intra_op_thread_tuner.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "nlohmann/json.hpp"
+
+#include "core/framework/op_kernel_context.h"
+#include "core/framework/resource_accountant.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tuning_results.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph.h"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+
+namespace {
+constexpr const char* kIntraOpNumThreadsValidator = "INTRA_OP_NUM_THREADS";
+constexpr const char* kIntraOpThreadCountResults = "IntraOpThreadCount";
+
+// layout of a NodeSlot
+constexpr uint32_t kSlotBucketShift = 16;
+constexpr uint32_t kMaxSlotThreadCount = (uint32_t{1} << kSlotBucketShift) - 1;
+}  // namespace
+
+IntraOpThreadTuner::IntraOpThreadTuner(int max_threads, size_t samples_per_candidate, double tolerance,
+                                       size_t max_entries)
+    : max_threads_(std::clamp(max_threads, 1, static_cast<int>(kMaxSlotThreadCount))),
+      samples_per_candidate_(std::max<size_t>(samples_per_candidate, 1)),
+      tolerance_(tolerance),
+      max_entries_(max_entries) {
+  for (int thread_count = max_threads_;; thread_count /= 2) {
+    candidates_.push_back(thread_count);
+    if (thread_count == 1) {
+      break;
+    }
+  }
+}
+
+uint32_t IntraOpThreadTuner::GetShapeBucket(const OpKernelContext& kernel_ctx) {
+  uint64_t element_count = 0;
+  for (int i = 0, end = kernel_ctx.InputCount(); i < end; ++i) {
+    const OrtValue* input = kernel_ctx.GetInputOrtValue(i);
+    if (input != nullptr && input->IsTensor()) {
+      element_count += static_cast<uint64_t>(std::max<int64_t>(input->Get<Tensor>().Shape().Size(), 0));
+    }
+  }
+
+  uint32_t bucket = 0;
+  for (; element_count != 0; element_count >>= 1) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+std::string IntraOpThreadTuner::MakeKey(const Node& node, uint32_t shape_bucket) {
+  return MakeString(IResourceAccountant::MakeUniqueNodeName(node), "|", shape_bucket);
+}
+
+int IntraOpThreadTuner::GetThreadCount(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    if (entries_.size() >= max_entries_) {
+      return max_threads_;
+    }
+    it = entries_.emplace(key, Entry{}).first;
+  }
+
+  const Entry& entry = it->second;
+  return entry.tuned_thread_count != 0 ? entry.tuned_thread_count : candidates_[entry.candidate];
+}
+
+int IntraOpThreadTuner::ReportLatency(const std::string& key, int thread_count, std::chrono::nanoseconds latency) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    // the node is beyond max_entries_ and always runs with all threads
+    return max_threads_;
+  }
+
+  // Ignore the runs that started with an earlier candidate on another thread.
+  Entry& entry = it->second;
+  if (entry.tuned_thread_count != 0 || candidates_[entry.candidate] != thread_count) {
+    return entry.tuned_thread_count;
+  }
+
+  // The first run of each candidate warms up the caches and the threads of the pool.
+  if (entry.runs++ == 0) {
+    return 0;
+  }
+
+  entry.samples.push_back(latency.count());
+  if (entry.samples.size() == samples_per_candidate_) {
+    FinishCandidate(entry);
+  }
+  return entry.tuned_thread_count;
+}
+
+void IntraOpThreadTuner::FinishCandidate(Entry& entry) {
+  auto middle = entry.samples.begin() + entry.samples.size() / 2;
+  std::nth_element(entry.samples.begin(), middle, entry.samples.end());
+  const int64_t median = *middle;
+  entry.medians.emplace_back(candidates_[entry.candidate], median);
+  entry.samples.clear();
+  entry.runs = 0;
+
+  int64_t best_median = median;
+  for (const auto& finished : entry.medians) {
+    best_median = std::min(best_median, finished.second);
+  }
+
+  const auto within_tolerance = [&](int64_t candidate_median) {
+    return static_cast<double>(candidate_median) <= static_cast<double>(best_median) * (1.0 + tolerance_);
+  };
+
+  // Fewer threads rarely help once halving them made the node slower, so stop at the first such candidate.
+  if (entry.candidate + 1 < candidates_.size() && within_tolerance(median)) {
+    ++entry.candidate;
+    return;
+  }
+
+  // The candidates are in descending order, so the last one within the tolerance uses the fewest threads.
+  for (const auto& [thread_count, candidate_median] : entry.medians) {
+    if (within_tolerance(candidate_median)) {
+      entry.tuned_thread_count = thread_count;
+    }
+  }
+
+  entry.medians.clear();
+  entry.medians.shrink_to_fit();
+  updated_ = true;
+}
+
+int IntraOpThreadTuner::GetTunedThreadCount(const std::string& key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  return it != entries_.end() ? it->second.tuned_thread_count : 0;
+}
+
+Status IntraOpThreadTuner::Load(const std::filesystem::path& file_path, const logging::Logger& logger) {
+  std::ifstream ifs(file_path);
+  if (!ifs.is_open()) {
+    LOGS(logger, INFO) << "No intra-op thread tuning results found at " << file_path << ". The nodes will be tuned.";
+    return Status::OK();
+  }
+
+  TuningResults tuning_results;
+  Status status;
+  ORT_TRY {
+    const json parsed = json::parse(ifs);
+    tuning_results.ep = parsed.at("ep").get<std::string>();
+    tuning_results.validators = parsed.at("validators").get<std::unordered_map<std::string, std::string>>();
+    tuning_results.results = parsed.at("results").get<std::unordered_map<std::string, KernelMap>>();
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the intra-op thread tuning results in ",
+                               file_path, ": ", ex.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  const auto validator = tuning_results.validators.find(kIntraOpNumThreadsValidator);
+  if (tuning_results.ep != kCpuExecutionProvider || validator == tuning_results.validators.end() ||
+      validator->second != std::to_string(max_threads_)) {
+    LOGS(logger, WARNING) << "Ignoring the intra-op thread tuning results in " << file_path
+                          << " as they were tuned for a different number of intra-op threads.";
+    return Status::OK();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [key, thread_count] : tuning_results.results[kIntraOpThreadCountResults]) {
+    if (entries_.size() >= max_entries_) {
+      break;
+    }
+    entries_[key].tuned_thread_count = std::clamp(thread_count, 1, max_threads_);
+  }
+  updated_ = false;
+
+  return Status::OK();
+}
+
+Status IntraOpThreadTuner::SaveIfUpdated(const std::filesystem::path& file_path) {
+  // Concurrent runs save in the order that they took their snapshot of the results.
+  std::lock_guard<std::mutex> save_lock(save_mutex_);
+
+  json results = json::object();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!updated_) {
+      return Status::OK();
+    }
+
+    for (const auto& [key, entry] : entries_) {
+      if (entry.tuned_thread_count != 0) {
+        results[key] = entry.tuned_thread_count;
+      }
+    }
+    updated_ = false;
+  }
+
+  json output;
+  output["ep"] = kCpuExecutionProvider;
+  output["validators"] = {{kIntraOpNumThreadsValidator, std::to_string(max_threads_)}};
+  output["results"] = {{kIntraOpThreadCountResults, std::move(results)}};
+
+  // Write a temporary file and rename it over the results, so that other processes that load the file while it is
+  // written see either the old or the new results.
+  std::filesystem::path temp_file_path = file_path;
+  temp_file_path += ".tmp";
+  {
+    std::ofstream ofs(temp_file_path, std::ofstream::out | std::ofstream::trunc);
+    ORT_RETURN_IF_NOT(ofs.is_open(), "Failed to open file: ", temp_file_path);
+    ofs << output.dump(2);
+    ORT_RETURN_IF_NOT(ofs.flush().good(), "Failed to write file: ", temp_file_path);
+  }
+
+  std::error_code error_code;
+  std::filesystem::rename(temp_file_path, file_path, error_code);
+  ORT_RETURN_IF(error_code, "Failed to rename ", temp_file_path, " to ", file_path, ": ", error_code.message());
+  return Status::OK();
+}
+
+IntraOpThreadTuner::NodeScope::NodeScope(IntraOpThreadTuner& tuner, NodeSlot* slot, const Node& node,
+                                         const OpKernelContext& kernel_ctx)
+    : tuner_(tuner),
+      slot_(slot),
+      shape_bucket_(GetShapeBucket(kernel_ctx)),
+      thread_count_(0) {
+  if (slot_ != nullptr) {
+    const uint32_t cached = slot_->load(std::memory_order_relaxed);
+    if ((cached >> kSlotBucketShift) == shape_bucket_) {
+      thread_count_ = static_cast<int>(cached & kMaxSlotThreadCount);
+    }
+  }
+
+  if (thread_count_ == 0) {
+    key_ = MakeKey(node, shape_bucket_);
+    thread_count_ = tuner_.GetThreadCount(key_);
+  }
+
+  if (thread_count_ < tuner_.max_threads_) {
+    limit_.emplace(thread_count_);
+  }
+  start_ = std::chrono::steady_clock::now();
+}
+
+IntraOpThreadTuner::NodeScope::~NodeScope() {
+  if (key_.empty()) {
+    // the thread count came from the slot, so the node is tuned already
+    limit_.reset();
+    return;
+  }
+
+  const auto latency = std::chrono::steady_clock::now() - start_;
+  limit_.reset();
+  const int tuned_thread_count = tuner_.ReportLatency(key_, thread_count_,
+                                                      std::chrono::duration_cast<std::chrono::nanoseconds>(latency));
+  if (slot_ != nullptr && tuned_thread_count != 0) {
+    slot_->store((shape_bucket_ << kSlotBucketShift) | static_cast<uint32_t>(tuned_thread_count),
+                 std::memory_order_relaxed);
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+class Node;
+class OpKernelContext;
+
+/**
+ * Picks the number of intra-op threads for each node of a session from the latency measured while the session runs.
+ *
+ * A node is identified by its name and a shape bucket, the power of two range that the total number of elements of
+ * its inputs falls in. Dynamic shapes, such as a sequence length that grows with every decode step, are then tuned
+ * per size class rather than per shape. At most max_entries nodes and buckets are tuned, and any others run with
+ * all threads. The first runs of a node are spread over a descending list
+ * of thread counts: the size of the pool including the calling thread, then half of it, and so on down to 1.
+ * Each count is run once to warm up and then sampled a few times, and halving stops as soon as a count is slower
+ * than the best one so far by more than the tolerance. The node then keeps the smallest count whose median latency
+ * is within the tolerance of the best median, which leaves the other threads idle for small operators where the
+ * fork and join of the pool cost more than the extra threads save.
+ *
+ * The chosen counts can be saved to and loaded from a JSON file in the layout of TuningResults, so that later sessions
+ * skip the tuning. The file records the size of the intra-op pool and is ignored if it does not match.
+ */
+class IntraOpThreadTuner {
+ public:
+  static constexpr size_t kDefaultSamplesPerCandidate = 5;
+  static constexpr double kDefaultTolerance = 0.05;
+  static constexpr size_t kDefaultMaxEntries = 4096;
+
+  /**
+   * @param max_threads Number of threads, including the calling thread, that the intra-op pool can use.
+   * @param samples_per_candidate Number of timed runs of each thread count, after one warm-up run.
+   * @param tolerance Relative latency above the best one that a smaller thread count may have and still be chosen.
+   * @param max_entries Maximum number of nodes and shape buckets that are tuned.
+   */
+  explicit IntraOpThreadTuner(int max_threads,
+                              size_t samples_per_candidate = kDefaultSamplesPerCandidate,
+                              double tolerance = kDefaultTolerance,
+                              size_t max_entries = kDefaultMaxEntries);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IntraOpThreadTuner);
+
+  /// Returns the shape bucket of the inputs in the kernel context, the bit width of their total number of elements.
+  static uint32_t GetShapeBucket(const OpKernelContext& kernel_ctx);
+
+  /// Makes the key of a node from its unique name and the shape bucket of its inputs.
+  static std::string MakeKey(const Node& node, uint32_t shape_bucket);
+
+  /// Returns the number of threads to run the next run of the node with.
+  int GetThreadCount(const std::string& key);
+
+  /// Records the latency of a run of the node that used the given number of threads.
+  /// Returns the number of threads that the node keeps using, or 0 while it is being tuned.
+  int ReportLatency(const std::string& key, int thread_count, std::chrono::nanoseconds latency);
+
+  /// Returns the tuned number of threads of the node, or 0 if it is not tuned yet.
+  int GetTunedThreadCount(const std::string& key) const;
+
+  /// Loads the thread counts saved by a previous session. Mismatching files are ignored with a warning.
+  Status Load(const std::filesystem::path& file_path, const logging::Logger& logger);
+
+  /// Saves the tuned thread counts if any node finished tuning since they were last loaded or saved.
+  /// Concurrent calls are serialized, and the file is replaced by renaming a temporary file over it.
+  Status SaveIfUpdated(const std::filesystem::path& file_path);
+
+  /**
+   * Caches the tuned number of threads of a node for one shape bucket, so that the runs of a tuned node take neither
+   * the mutex of the tuner nor build its key. The bucket is in the upper 16 bits and the thread count in the lower
+   * 16 bits, and 0 means that nothing is cached. SessionState holds one slot per node.
+   */
+  using NodeSlot = std::atomic<uint32_t>;
+
+  /**
+   * Limits the degree of parallelism of the intra-op pool for one run of a node and reports the latency of the run
+   * when it goes out of scope.
+   */
+  class NodeScope {
+   public:
+    /// @param slot The cache slot of the node, or nullptr to always look the node up in the tuner.
+    NodeScope(IntraOpThreadTuner& tuner, NodeSlot* slot, const Node& node, const OpKernelContext& kernel_ctx);
+    ~NodeScope();
+
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeScope);
+
+   private:
+    IntraOpThreadTuner& tuner_;
+    NodeSlot* slot_;
+    uint32_t shape_bucket_;
+    std::string key_;  // empty if the thread count came from the slot
+    int thread_count_;
+    std::optional<concurrency::ThreadPool::DegreeOfParallelismLimit> limit_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+ private:
+  struct Entry {
+    int tuned_thread_count = 0;
+    size_t candidate = 0;
+    size_t runs = 0;
+    std::vector<int64_t> samples;
+    std::vector<std::pair<int, int64_t>> medians;  // thread count and median latency of the finished candidates
+  };
+
+  void FinishCandidate(Entry& entry);
+
+  const int max_threads_;
+  const size_t samples_per_candidate_;
+  const double tolerance_;
+  const size_t max_entries_;
+  std::vector<int> candidates_;
+
+  mutable std::mutex mutex_;
+  InlinedHashMap<std::string, Entry> entries_;
+  bool updated_ = false;
+
+  std::mutex save_mutex_;
+};
+
+}  // namespace onnxruntime
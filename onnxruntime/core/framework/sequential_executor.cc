@@ -3,6 +3,7 @@
 
 #include "core/framework/sequential_executor.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <vector>
@@ -11,11 +12,13 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/intra_op_thread_tuner.h"
 #include "core/framework/resource_accountant.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
 #include "core/framework/debug_node_inputs_outputs_utils.h"
@@ -489,7 +492,30 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
         status = kernel_ctx.SetOutputMLValue(0, cache.get()->at(cached_arg_name));
       }
 #else
-      status = p_kernel->Compute(&kernel_ctx);
+      auto* env_resources = ctx.GetSessionState().GetEnvResources();
+      const int thread_grant = env_resources != nullptr ? env_resources->GetThreadGrant() : 0;
+      if (thread_grant != 0) {
+        // The node gets the share of the thread budget of the environment that its run has while other sessions run.
+        // Its latency then depends on those sessions, so it is not tuned either.
+        concurrency::ThreadPool::DegreeOfParallelismLimit thread_budget_limit(thread_grant);
+        status = p_kernel->Compute(&kernel_ctx);
+      } else {
+#if !defined(ORT_MINIMAL_BUILD)
+        const SessionState& session_state = ctx.GetSessionState();
+        auto* intra_op_thread_tuner = session_state.GetIntraOpThreadTuner();
+        if (intra_op_thread_tuner != nullptr &&
+            p_kernel->Node().GetExecutionProviderType() == kCpuExecutionProvider) {
+          IntraOpThreadTuner::NodeScope tuner_scope(*intra_op_thread_tuner,
+                                                    session_state.GetIntraOpThreadTunerSlot(idx),
+                                                    p_kernel->Node(), kernel_ctx);
+          status = p_kernel->Compute(&kernel_ctx);
+        } else {
+          status = p_kernel->Compute(&kernel_ctx);
+        }
+#else
+        status = p_kernel->Compute(&kernel_ctx);
+#endif
+      }
 
 #if !defined(ORT_MINIMAL_BUILD)
       auto* node_stats_recorder = ctx.GetSessionState().GetNodeStatsRecorder();
@@ -578,6 +604,37 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
   return Status::OK();
 }
 
+// Get the outputs of a completed execution and cache the memory patterns it generated.
+static Status FinishExecution(const SessionState& session_state, StreamExecutionContext& ctx,
+                              gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                              std::vector<OrtValue>& fetches) {
+  ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
+  if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
+    bool all_tensors = true;
+    for (const auto& feed : feeds) {
+      if (!(feed.IsTensor())) {
+        all_tensors = false;
+        break;
+      }
+    }
+
+    if (all_tensors) {
+      if (ctx.GetExecutionFrame().HasSymbolicMemoryPatternTrace()) {
+        std::unique_ptr<SymbolicMemoryPatternGroup> mem_patterns;
+        ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GenerateSymbolicPatterns(feed_mlvalue_idxs, feeds,
+                                                                             mem_patterns));
+        session_state.SetSymbolicMemoryPatternGroup(std::move(mem_patterns));
+      } else {
+        MemoryPatternGroup mem_patterns;
+        ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
+        ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                    gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -650,24 +707,386 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
 
   ctx.WaitAll();
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
-  ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
-  if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
-    bool all_tensors = true;
+  return FinishExecution(session_state, ctx, feed_mlvalue_idxs, feeds, fetches);
+}
+
+// Returns true if the plan has a single logic stream with steps, the first one, and it is on CPU.
+static bool HasSingleCpuStream(const SessionState& session_state) {
+  const auto* execution_plan = session_state.GetExecutionPlan();
+  if (execution_plan == nullptr) {
+    return false;
+  }
+
+  size_t num_streams = 0;
+  for (const auto& stream : execution_plan->execution_plan) {
+    if (stream && !stream->steps_.empty()) {
+      if (stream->device_.Type() != OrtDevice::CPU) {
+        return false;
+      }
+      ++num_streams;
+    }
+  }
+
+  return num_streams == 1 && execution_plan->execution_plan.front() &&
+         !execution_plan->execution_plan.front()->steps_.empty();
+}
+
+bool PersistentExecutionContext::IsSupported(const SessionState& session_state) {
+  return HasSingleCpuStream(session_state);
+}
+
+PersistentExecutionContext::PersistentExecutionContext(const SessionState& session_state)
+    : session_state_(session_state) {
+}
+
+PersistentExecutionContext::~PersistentExecutionContext() = default;
+
+bool PersistentExecutionContext::MatchesFeeds(gsl::span<const OrtValue> feeds) const {
+  if (feeds.size() != feed_shapes_.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (feeds[i].IsTensor() != feed_shapes_[i].has_value() ||
+        (feeds[i].IsTensor() && feeds[i].Get<Tensor>().Shape() != *feed_shapes_[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Status PersistentExecutionContext::Execute(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                           gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                                           const std::unordered_map<size_t, IExecutor::CustomAllocator>&
+                                               fetch_allocators,
+                                           const logging::Logger& logger, const bool& terminate_flag) {
+  if (ctx_ && MatchesFeeds(feeds)) {
+    ctx_->Reset(1, feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators);
+    ctx_->SetLogger(logger);
+  } else {
+    // release the memory pattern buffers of the previous frame before the new frame allocates its own
+    ctx_.reset();
+
+#ifdef ORT_ENABLE_STREAM
+    const auto* execution_plan = session_state_.GetExecutionPlan();
+    ctx_ = std::make_unique<StreamExecutionContext>(session_state_,
+                                                    1,
+                                                    execution_plan->notification_owner_stream,
+                                                    execution_plan->num_barriers,
+                                                    nullptr,
+                                                    feed_mlvalue_idxs,
+                                                    feeds,
+                                                    fetch_mlvalue_idxs,
+                                                    fetches,
+                                                    fetch_allocators,
+                                                    logger,
+                                                    true);
+#else
+    ctx_ = std::make_unique<StreamExecutionContext>(session_state_,
+                                                    1,
+                                                    feed_mlvalue_idxs,
+                                                    feeds,
+                                                    fetch_mlvalue_idxs,
+                                                    fetches,
+                                                    fetch_allocators,
+                                                    logger,
+                                                    true);
+#endif
+
+    feed_shapes_.clear();
+    feed_shapes_.reserve(feeds.size());
     for (const auto& feed : feeds) {
-      if (!(feed.IsTensor())) {
-        all_tensors = false;
-        break;
+      feed_shapes_.push_back(feed.IsTensor() ? std::optional<TensorShape>(feed.Get<Tensor>().Shape())
+                                             : std::nullopt);
+    }
+  }
+
+  Status status;
+  {
+    SessionScope session_scope(session_state_, ctx_->GetExecutionFrame());
+    RunSince(0, *ctx_, session_scope, terminate_flag, 0);
+    status = ctx_->TaskStatus();
+  }
+
+  if (status.IsOK()) {
+    status = FinishExecution(session_state_, *ctx_, feed_mlvalue_idxs, feeds, fetches);
+  }
+
+  // A frame that traced a memory pattern allocated everything on demand. Recreate it so that the following
+  // executions use the pattern. A failed execution may have left values behind.
+  if (!status.IsOK() || ctx_->GetExecutionFrame().HasMemoryPatternPlanner()) {
+    ctx_.reset();
+  }
+
+  return status;
+}
+
+struct PipelineExecutor::Request {
+  InlinedVector<int> feed_mlvalue_idxs;
+  std::vector<OrtValue> feeds;
+  InlinedVector<int> fetch_mlvalue_idxs;
+  std::vector<OrtValue> fetches;
+  const logging::Logger* logger;
+  const bool* terminate_flag;
+  CompletionFn done;
+
+  std::unique_ptr<StreamExecutionContext> ctx;
+  std::unique_ptr<SessionScope> session_scope;
+  size_t next_step{0};
+
+  // durations of the steps in seconds, if the request is used to rebalance the stages
+  std::vector<double> step_durations;
+};
+
+bool PipelineExecutor::IsSupported(const SessionState& session_state) {
+  return HasSingleCpuStream(session_state);
+}
+
+PipelineExecutor::PipelineExecutor(const SessionState& session_state, concurrency::ThreadPool* thread_pool,
+                                   size_t num_stages, size_t max_in_flight)
+    : session_state_(session_state),
+      thread_pool_(thread_pool),
+      num_steps_(session_state.GetExecutionPlan()->execution_plan.front()->steps_.size()),
+      num_stages_(std::max<size_t>(1, std::min(num_stages, num_steps_))),
+      max_in_flight_(std::max<size_t>(1, max_in_flight)),
+      stages_(num_stages_) {
+  stage_begins_.resize(num_stages_);
+  for (size_t stage = 0; stage < num_stages_; ++stage) {
+    stage_begins_[stage] = stage * num_steps_ / num_stages_;
+  }
+}
+
+PipelineExecutor::~PipelineExecutor() {
+  std::unique_lock<std::mutex> lock(lock_);
+  idle_.wait(lock, [this]() { return IsIdle(); });
+}
+
+bool PipelineExecutor::IsIdle() const {
+  return in_flight_ == 0 &&
+         std::none_of(stages_.begin(), stages_.end(), [](const Stage& stage) { return stage.running; });
+}
+
+void PipelineExecutor::Submit(gsl::span<const int> feed_mlvalue_idxs, std::vector<OrtValue> feeds,
+                              gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue> fetches,
+                              const logging::Logger& logger, const bool& terminate_flag, CompletionFn done) {
+  auto request = std::make_unique<Request>();
+  request->feed_mlvalue_idxs.assign(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end());
+  request->feeds = std::move(feeds);
+  request->fetch_mlvalue_idxs.assign(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
+  request->fetches = std::move(fetches);
+  request->logger = &logger;
+  request->terminate_flag = &terminate_flag;
+  request->done = std::move(done);
+
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (in_flight_ == max_in_flight_) {
+      pending_.push_back(std::move(request));
+      return;
+    }
+
+    ++in_flight_;
+    if (!calibrated_) {
+      calibrated_ = true;
+      request->step_durations.resize(num_steps_);
+    }
+  }
+
+  Start(std::move(request));
+}
+
+void PipelineExecutor::Start(std::unique_ptr<Request> request) {
+  const auto* execution_plan = session_state_.GetExecutionPlan();
+  const std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+
+  // the execution context creates the execution frame of the request
+#ifdef ORT_ENABLE_STREAM
+  request->ctx = std::make_unique<StreamExecutionContext>(session_state_,
+                                                          1,
+                                                          execution_plan->notification_owner_stream,
+                                                          execution_plan->num_barriers,
+                                                          nullptr,
+                                                          request->feed_mlvalue_idxs,
+                                                          request->feeds,
+                                                          request->fetch_mlvalue_idxs,
+                                                          request->fetches,
+                                                          fetch_allocators,
+                                                          *request->logger,
+                                                          true);
+#else
+  ORT_UNUSED_PARAMETER(execution_plan);
+  request->ctx = std::make_unique<StreamExecutionContext>(session_state_,
+                                                          1,
+                                                          request->feed_mlvalue_idxs,
+                                                          request->feeds,
+                                                          request->fetch_mlvalue_idxs,
+                                                          request->fetches,
+                                                          fetch_allocators,
+                                                          *request->logger,
+                                                          true);
+#endif
+  request->session_scope = std::make_unique<SessionScope>(session_state_, request->ctx->GetExecutionFrame());
+
+  Enqueue(0, request.release());
+}
+
+void PipelineExecutor::Enqueue(size_t stage, Request* request) {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    stages_[stage].queue.push_back(request);
+    if (stages_[stage].running) {
+      return;
+    }
+    stages_[stage].running = true;
+  }
+
+  concurrency::ThreadPool::Schedule(thread_pool_, [this, stage]() { RunStage(stage); });
+}
+
+void PipelineExecutor::RunStage(size_t stage) {
+  for (;;) {
+    Request* request = nullptr;
+    size_t end = num_steps_;
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      auto& queue = stages_[stage].queue;
+      if (queue.empty()) {
+        // this is the last access to the executor from this stage, which the destructor waits for
+        stages_[stage].running = false;
+        if (IsIdle()) {
+          idle_.notify_all();
+        }
+        return;
+      }
+
+      request = queue.front();
+      queue.pop_front();
+      if (stage + 1 < num_stages_) {
+        end = stage_begins_[stage + 1];
       }
     }
 
-    if (all_tensors) {
-      MemoryPatternGroup mem_patterns;
-      ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+    // A request runs the steps from where the previous stage stopped, so each step runs exactly once when the stages
+    // are rebalanced while it is in flight.
+    RunSteps(*request, end);
+
+    if (stage + 1 < num_stages_ && request->ctx->TaskStatus().IsOK()) {
+      Enqueue(stage + 1, request);
+    } else {
+      Complete(request);
     }
   }
+}
 
-  return Status::OK();
+void PipelineExecutor::RunSteps(Request& request, size_t end) {
+  StreamExecutionContext& ctx = *request.ctx;
+  const auto& steps = session_state_.GetExecutionPlan()->execution_plan.front()->steps_;
+  const bool& terminate_flag = *request.terminate_flag;
+
+  for (; request.next_step < end; ++request.next_step) {
+    if (terminate_flag) {
+      Status status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      ctx.SetStatus(status);
+      return;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    bool continue_flag = true;
+    Status status;
+    ORT_TRY {
+      status = steps[request.next_step]->Execute(ctx, 0, *request.session_scope, terminate_flag, continue_flag);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    // with a single logic stream there is no step to wait for, so a step never breaks the execution
+    if (status.IsOK() && !continue_flag) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Step ", request.next_step, " can't be pipelined");
+    }
+
+    if (!status.IsOK()) {
+      ctx.SetStatus(status);
+      return;
+    }
+
+    if (!request.step_durations.empty()) {
+      request.step_durations[request.next_step] =
+          std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+  }
+}
+
+void PipelineExecutor::Complete(Request* completed) {
+  std::unique_ptr<Request> request(completed);
+  Status status = request->ctx->TaskStatus();
+  if (status.IsOK()) {
+    ORT_TRY {
+      status = FinishExecution(session_state_, *request->ctx, request->feed_mlvalue_idxs, request->feeds,
+                               request->fetches);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (status.IsOK() && !request->step_durations.empty()) {
+      Rebalance(request->step_durations);
+    }
+  }
+
+  // release the execution frame before the next request starts
+  request->session_scope.reset();
+  request->ctx.reset();
+
+  std::unique_ptr<Request> next;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (!pending_.empty()) {
+      next = std::move(pending_.front());
+      pending_.pop_front();
+    }
+  }
+
+  if (next) {
+    Start(std::move(next));
+  }
+
+  request->done(status, request->fetches);
+
+  if (!next) {
+    std::lock_guard<std::mutex> lock(lock_);
+    --in_flight_;
+  }
+}
+
+void PipelineExecutor::Rebalance(gsl::span<const double> step_durations) {
+  double total = 0;
+  for (double duration : step_durations) {
+    total += duration;
+  }
+
+  // each stage ends at the step where the running total crosses its share of the total duration
+  std::vector<size_t> stage_begins(num_stages_, 0);
+  double elapsed = 0;
+  size_t step = 0;
+  for (size_t stage = 1; stage < num_stages_; ++stage) {
+    const double target = total * static_cast<double>(stage) / static_cast<double>(num_stages_);
+    // leave at least one step for each of the remaining stages
+    const size_t max_begin = num_steps_ - (num_stages_ - stage);
+    while (step < max_begin && (step < stage || elapsed + step_durations[step] / 2 < target)) {
+      elapsed += step_durations[step];
+      ++step;
+    }
+    stage_begins[stage] = step;
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  stage_begins_ = std::move(stage_begins);
 }
 
 #ifdef ENABLE_TRAINING
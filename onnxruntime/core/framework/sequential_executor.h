@@ -3,6 +3,12 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -20,6 +26,9 @@
 #endif
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 
 class StreamExecutionContext;
 class DeviceStreamCollection;
@@ -48,6 +57,106 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                                    const bool only_execute_path_to_fetches,
                                    bool single_thread_mode);
 
+// PersistentExecutionContext keeps the execution context of a plan, and with it the execution frame and its memory
+// pattern buffers, alive across repeated executions such as the iterations of a Loop or Scan subgraph. An execution
+// then only rebinds the feeds and fetches instead of creating a frame, looking up the memory pattern and allocating
+// its buffers.
+//
+// The context is recreated when the shapes of the feeds change, and after an execution that traced a new memory
+// pattern so that the following executions use the pattern.
+class PersistentExecutionContext {
+ public:
+  // Returns true if the plan has a single logic stream on CPU, so that a completed execution leaves no notification
+  // or barrier behind that would need to be reset.
+  static bool IsSupported(const SessionState& session_state);
+
+  explicit PersistentExecutionContext(const SessionState& session_state);
+  ~PersistentExecutionContext();
+
+  // Executes the plan in the calling thread. The feeds and fetches must be on CPU. IsSupported must be true.
+  Status Execute(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                 gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                 const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                 const logging::Logger& logger, const bool& terminate_flag);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PersistentExecutionContext);
+
+ private:
+  // Returns true if the feeds have the types and shapes of the feeds the current context was created with.
+  bool MatchesFeeds(gsl::span<const OrtValue> feeds) const;
+
+  const SessionState& session_state_;
+  std::unique_ptr<StreamExecutionContext> ctx_;
+  // shapes of the feeds the context was created with. nullopt for a feed that is not a tensor.
+  InlinedVector<std::optional<TensorShape>> feed_shapes_;
+};
+
+// PipelineExecutor executes the plan of a session as a pipeline of stages, each of which is a range of consecutive
+// steps of the single logic stream of the plan. A stage runs one request at a time in submission order and then hands
+// it to the next stage, so that consecutive requests, each with its own execution context, are in flight on
+// different stages at the same time. The throughput is then limited by the slowest stage instead of the whole plan.
+//
+// The stages initially split the steps evenly, and are rebalanced with the durations of the steps in the first
+// request. At most max_in_flight requests are executed at a time; requests submitted beyond that wait for one to
+// complete. The stages run on the given thread pool.
+class PipelineExecutor {
+ public:
+  // Called with the status and the fetches of a request once it completed.
+  using CompletionFn = std::function<void(const Status& status, std::vector<OrtValue>& fetches)>;
+
+  // Returns true if the plan has a single logic stream on CPU, which is the case for a sequential execution plan of
+  // CPU execution providers.
+  static bool IsSupported(const SessionState& session_state);
+
+  PipelineExecutor(const SessionState& session_state, concurrency::ThreadPool* thread_pool,
+                   size_t num_stages, size_t max_in_flight);
+
+  // Waits for the submitted requests to complete.
+  ~PipelineExecutor();
+
+  size_t NumStages() const { return num_stages_; }
+
+  // Submits a request. Does not block. The feeds and fetches must be on CPU, and the logger and terminate flag must
+  // stay valid until `done` was called.
+  void Submit(gsl::span<const int> feed_mlvalue_idxs, std::vector<OrtValue> feeds,
+              gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue> fetches,
+              const logging::Logger& logger, const bool& terminate_flag, CompletionFn done);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PipelineExecutor);
+
+ private:
+  struct Request;
+
+  struct Stage {
+    std::deque<Request*> queue;
+    bool running{false};
+  };
+
+  void Start(std::unique_ptr<Request> request);
+  void Enqueue(size_t stage, Request* request);
+  void RunStage(size_t stage);
+  void RunSteps(Request& request, size_t end);
+  void Complete(Request* request);
+  void Rebalance(gsl::span<const double> step_durations);
+  // Returns true if no request is in flight and no stage is running. Requires lock_.
+  bool IsIdle() const;
+
+  const SessionState& session_state_;
+  concurrency::ThreadPool* const thread_pool_;
+  const size_t num_steps_;
+  const size_t num_stages_;
+  const size_t max_in_flight_;
+
+  std::mutex lock_;
+  std::condition_variable idle_;
+  // The first step of each stage.
+  std::vector<size_t> stage_begins_;
+  std::vector<Stage> stages_;
+  std::deque<std::unique_ptr<Request>> pending_;
+  size_t in_flight_{0};
+  bool calibrated_{false};
+};
+
 #ifdef ENABLE_TRAINING
 onnxruntime::Status PartialExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                           std::vector<OrtValue>& feeds, gsl::span<const int> fetch_mlvalue_idxs,
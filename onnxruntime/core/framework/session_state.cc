@@ -108,6 +108,8 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  enable_symbolic_mem_pattern_ =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableSymbolicMemoryPattern, "0") == "1";
   if (parent_allocators) {
     allocators_ = parent_allocators;
     initializer_allocators_ = parent_initializer_allocators;
@@ -993,6 +995,19 @@ Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> ten
   return Status::OK();
 }
 
+const SymbolicMemoryPatternGroup* SessionState::GetSymbolicMemoryPatternGroup() const {
+  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+  return symbolic_mem_patterns_.get();
+}
+
+void SessionState::SetSymbolicMemoryPatternGroup(std::unique_ptr<SymbolicMemoryPatternGroup> mem_patterns) const {
+  std::lock_guard<std::mutex> lock(mem_patterns_lock_);
+  // Do not update if present, as the pointer to the existing one is cached
+  if (!symbolic_mem_patterns_) {
+    symbolic_mem_patterns_ = std::move(mem_patterns);
+  }
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -1672,6 +1687,12 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
+#if !defined(ORT_MINIMAL_BUILD)
+  if (GetIntraOpThreadTuner() != nullptr) {
+    intra_op_thread_tuner_slots_ = std::make_unique<std::atomic<uint32_t>[]>(session_kernels_.size());
+  }
+#endif
+
   if (!disable_prepacking) {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
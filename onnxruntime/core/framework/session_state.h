@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -19,6 +20,7 @@
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/data_transfer_manager.h"
+#include "core/framework/env_resource_manager.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/stream_execution_context.h"
@@ -28,6 +30,7 @@
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/symbolic_mem_pattern.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
@@ -59,6 +62,7 @@ class NodeIndexInfo;
 struct SequentialExecutionPlan;
 struct MemoryPatternGroup;
 class DeviceStreamCollection;
+class IntraOpThreadTuner;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
@@ -240,6 +244,17 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Get the symbolic memory pattern, or nullptr if it has not been generated yet.
+  */
+  const SymbolicMemoryPatternGroup* GetSymbolicMemoryPatternGroup() const;
+
+  /**
+  Set the symbolic memory pattern generated by the first execution.
+  Const as it's an internal cache update only. The pattern is not replaced once set, as the pointer is cached.
+  */
+  void SetSymbolicMemoryPatternGroup(std::unique_ptr<SymbolicMemoryPatternGroup> mem_patterns) const;
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -247,6 +262,12 @@ class SessionState {
   */
   bool GetEnableMemoryPattern() const;
 
+  /**
+  Get whether the memory pattern is planned symbolically instead of per input shape.
+  Only meaningful if the memory pattern is enabled.
+  */
+  bool GetEnableSymbolicMemoryPattern() const { return enable_symbolic_mem_pattern_; }
+
   /**
   Get enable memory re-use flag.
   */
@@ -389,8 +410,48 @@ class SessionState {
     }
     return node_stats_recorder_;
   }
+
+  void SetIntraOpThreadTuner(IntraOpThreadTuner* intra_op_thread_tuner) {
+    intra_op_thread_tuner_ = intra_op_thread_tuner;
+  }
+
+  /**
+   * Returns a pointer to the IntraOpThreadTuner object if intra-op thread tuning was enabled for the session.
+   * The object pointer is only present at the root SessionState object
+   */
+  IntraOpThreadTuner* GetIntraOpThreadTuner() const {
+    if (parent_ != nullptr) {
+      return parent_->GetIntraOpThreadTuner();
+    }
+    return intra_op_thread_tuner_;
+  }
+
+  /**
+   * Returns the IntraOpThreadTuner::NodeSlot that caches the tuned thread count of a node of this graph,
+   * or nullptr if intra-op thread tuning is not enabled for the session.
+   */
+  std::atomic<uint32_t>* GetIntraOpThreadTunerSlot(NodeIndex node_index) const {
+    return intra_op_thread_tuner_slots_ != nullptr && node_index < session_kernels_.size()
+               ? &intra_op_thread_tuner_slots_[node_index]
+               : nullptr;
+  }
 #endif
 
+  void SetEnvResources(EnvResourceManager::SessionResources* env_resources) {
+    env_resources_ = env_resources;
+  }
+
+  /**
+   * Returns a pointer to the resources of the session in the resource manager of the environment, if the session
+   * is registered with it. The object pointer is only present at the root SessionState object
+   */
+  EnvResourceManager::SessionResources* GetEnvResources() const {
+    if (parent_ != nullptr) {
+      return parent_->GetEnvResources();
+    }
+    return env_resources_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
@@ -513,16 +574,26 @@ class SessionState {
 
 #if !defined(ORT_MINIMAL_BUILD)
   NodeStatsRecorder* node_stats_recorder_ = nullptr;
+  IntraOpThreadTuner* intra_op_thread_tuner_ = nullptr;
+  // IntraOpThreadTuner::NodeSlot of each node, indexed by the node index
+  std::unique_ptr<std::atomic<uint32_t>[]> intra_op_thread_tuner_slots_;
 #endif
 
+  EnvResourceManager::SessionResources* env_resources_ = nullptr;
+
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // plan the memory pattern once in terms of the symbolic input dimensions instead of per input shape.
+  bool enable_symbolic_mem_pattern_{false};
+
   // lock for the mem_patterns_
   mutable std::mutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
   // must be a node based container as a pointer is cached.
   mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
+  // the symbolic memory pattern used for all input shapes if enable_symbolic_mem_pattern_ is set.
+  mutable std::unique_ptr<SymbolicMemoryPatternGroup> symbolic_mem_patterns_;
   // This is mutable under mutex in training scenarios so execution frame would make a copy
   // of the value when created.
 #ifdef ENABLE_TRAINING
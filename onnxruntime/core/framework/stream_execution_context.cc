@@ -59,11 +59,7 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
   }
   // init remain task to number of streams
   remain_tasks_.Set(num_streams);
-  // generate release plan (the ref counts)
-  auto& release_actions = sess_state.GetExecutionPlan()->release_actions;
-  for (size_t i = 0; i < release_actions.size(); ++i) {
-    release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
-  }
+  InitReleasePlan();
 }
 
 synchronize::Notification* StreamExecutionContext::GetNotification(size_t idx) {
@@ -113,11 +109,7 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
 #endif
   // init remain task to number of streams
   remain_tasks_.Set(num_streams);
-  // generate release plan (the ref counts)
-  auto& release_actions = sess_state.GetExecutionPlan()->release_actions;
-  for (size_t i = 0; i < release_actions.size(); ++i) {
-    release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
-  }
+  InitReleasePlan();
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t /*idx*/) {
@@ -133,6 +125,32 @@ Stream* StreamExecutionContext ::GetDeviceStream(size_t /*idx*/) {
 }
 #endif
 
+void StreamExecutionContext::InitReleasePlan() {
+  // generate release plan (the ref counts)
+  auto& release_actions = session_state_->GetExecutionPlan()->release_actions;
+  for (size_t i = 0; i < release_actions.size(); ++i) {
+    release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
+  }
+}
+
+void StreamExecutionContext::Reset(int32_t num_streams,
+                                   gsl::span<const int> feed_mlvalue_idxs,
+                                   gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
+                                   std::vector<OrtValue>& fetches,
+                                   const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  ORT_ENFORCE(remain_tasks_.Get() == 0, "The previous execution has not completed.");
+
+  frame_.Reset(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators);
+  task_status_ = Status::OK();
+#ifdef ORT_ENABLE_STREAM
+  for (auto& barrier : count_down_barriers_) {
+    barrier.Set(2);
+  }
+#endif
+  remain_tasks_.Set(num_streams);
+  InitReleasePlan();
+}
+
 const SessionState& StreamExecutionContext ::GetSessionState() const { return *session_state_; }
 
 const logging::Logger& StreamExecutionContext ::GetLogger() const { return *logger_; }
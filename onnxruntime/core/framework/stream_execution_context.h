@@ -116,6 +116,14 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // Prepare the context for another execution of the plan with new feeds and fetches, reusing the execution frame.
+  // The previous execution must have completed. See ExecutionFrame::Reset.
+  void Reset(int32_t num_streams,
+             gsl::span<const int> feed_mlvalue_idxs,
+             gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
+             std::vector<OrtValue>& fetches,
+             const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -160,6 +168,8 @@ class StreamExecutionContext {
 
   Status task_status_{Status::OK()};
 
+  void InitReleasePlan();
+
 #ifdef ENABLE_TRAINING
   const ProgramRegion* program_range_{nullptr};
 
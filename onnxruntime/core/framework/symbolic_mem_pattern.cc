@@ -0,0 +1,249 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/symbolic_mem_pattern.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "core/common/safeint.h"
+#include "core/framework/allocator.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+
+namespace onnxruntime {
+
+void SymbolicMemoryPatternTrace::TraceAllocation(int ort_value_idx, size_t size) {
+  std::lock_guard<std::mutex> lock(lock_);
+  alloc_index_[ort_value_idx] = allocs_.size();
+  allocs_.push_back({ort_value_idx, size, step_++, std::numeric_limits<size_t>::max()});
+}
+
+void SymbolicMemoryPatternTrace::TraceFree(int ort_value_idx) {
+  std::lock_guard<std::mutex> lock(lock_);
+  auto it = alloc_index_.find(ort_value_idx);
+  if (it != alloc_index_.end()) {
+    allocs_[it->second].free_step = step_++;
+    alloc_index_.erase(it);
+  }
+}
+
+bool SymbolicMemoryPatternGroup::TryGetBlockSize(const Block& block, gsl::span<const int64_t> dim_values,
+                                                 size_t& size) {
+  SafeInt<int64_t> elems = block.constant_elems;
+  for (size_t dim : block.dims) {
+    if (dim_values[dim] < 0) {
+      return false;
+    }
+    elems *= dim_values[dim];
+  }
+
+  return Tensor::CalculateTensorStorageSize(block.element_type, TensorShape({static_cast<int64_t>(elems)}),
+                                            block.alignment, size)
+      .IsOK();
+}
+
+Status SymbolicMemoryPatternGroup::BindDims(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                            InlinedVector<int64_t>& dim_values) const {
+  ORT_RETURN_IF_NOT(feed_mlvalue_idxs.size() == feeds.size(), "Number of feed indices and feeds mismatch");
+
+  dim_values.assign(dim_names_.size(), -1);
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!feeds[i].IsTensor()) {
+      continue;
+    }
+
+    const auto& shape = feeds[i].Get<Tensor>().Shape();
+    for (const auto& source : dim_sources_) {
+      if (source.ort_value_idx != feed_mlvalue_idxs[i]) {
+        continue;
+      }
+
+      ORT_RETURN_IF_NOT(source.axis < shape.NumDimensions(), "Feed with ort_value_idx=", source.ort_value_idx,
+                        " has rank ", shape.NumDimensions(), " but symbolic dimension '",
+                        dim_names_[source.dim], "' is bound to axis ", source.axis);
+
+      int64_t& value = dim_values[source.dim];
+      ORT_RETURN_IF(value >= 0 && value != shape[source.axis], "Symbolic dimension '", dim_names_[source.dim],
+                    "' is bound to both ", value, " and ", shape[source.axis]);
+      value = shape[source.axis];
+    }
+  }
+
+  return Status::OK();
+}
+
+Status SymbolicMemoryPatternGroup::Create(const SessionState& session_state,
+                                          gsl::span<const int> feed_mlvalue_idxs,
+                                          gsl::span<const OrtValue> feeds,
+                                          const SymbolicMemoryPatternTrace& trace,
+                                          const MemoryPatternGroup& traced_patterns,
+                                          std::unique_ptr<SymbolicMemoryPatternGroup>& out) {
+  const SequentialExecutionPlan* exec_plan = session_state.GetExecutionPlan();
+  ORT_RETURN_IF(exec_plan == nullptr, "Execution plan is not available");
+
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& graph_viewer = session_state.GetGraphViewer();
+
+  auto get_shape = [&](int ort_value_idx) -> const ONNX_NAMESPACE::TensorShapeProto* {
+    std::string name;
+    if (!name_idx_map.GetName(ort_value_idx, name).IsOK()) {
+      return nullptr;
+    }
+    const NodeArg* node_arg = graph_viewer.GetNodeArg(name);
+    return node_arg != nullptr ? node_arg->Shape() : nullptr;
+  };
+
+  auto group = std::make_unique<SymbolicMemoryPatternGroup>();
+
+  // the symbolic dimensions of the graph inputs are the variables of the pattern
+  InlinedHashMap<std::string, size_t> dim_index;
+  for (int ort_value_idx : feed_mlvalue_idxs) {
+    const auto* shape = get_shape(ort_value_idx);
+    if (shape == nullptr) {
+      continue;
+    }
+
+    for (int axis = 0; axis < shape->dim_size(); ++axis) {
+      const auto& dim = shape->dim(axis);
+      if (!utils::HasDimParam(dim)) {
+        continue;
+      }
+
+      auto insert = dim_index.emplace(dim.dim_param(), group->dim_names_.size());
+      if (insert.second) {
+        group->dim_names_.push_back(dim.dim_param());
+      }
+      group->dim_sources_.push_back({ort_value_idx, static_cast<size_t>(axis), insert.first->second});
+    }
+  }
+
+  InlinedVector<int64_t> dim_values;
+  ORT_RETURN_IF_ERROR(group->BindDims(feed_mlvalue_idxs, feeds, dim_values));
+
+  struct TracedBlock {
+    const SymbolicMemoryPatternTrace::Allocation* alloc;
+    size_t offset;
+    Block block;
+  };
+
+  const auto& allocs = trace.Allocations();
+  for (size_t l = 0; l < traced_patterns.locations.size(); ++l) {
+    const OrtDevice& location = traced_patterns.locations[l];
+    const MemoryPattern& pattern = traced_patterns.patterns[l];
+    const size_t alignment = std::max(location.GetAlignment(), kAllocAlignment);
+
+    std::vector<TracedBlock> traced_blocks;
+    for (const auto& alloc : allocs) {
+      if (alloc.size == 0 || !(exec_plan->GetLocation(alloc.ort_value_idx) == location)) {
+        continue;
+      }
+
+      const MemoryBlock* traced = pattern.GetBlock(alloc.ort_value_idx);
+      const auto* shape = get_shape(alloc.ort_value_idx);
+      const auto* value_type = exec_plan->allocation_plan[alloc.ort_value_idx].value_type;
+      if (traced == nullptr || traced->size_ != alloc.size || shape == nullptr || value_type == nullptr ||
+          !value_type->IsTensorType()) {
+        continue;
+      }
+
+      Block block{alloc.ort_value_idx, 1, {},
+                  static_cast<const TensorTypeBase*>(value_type)->GetElementType(), alignment, {}};
+
+      bool symbolic = true;
+      for (const auto& dim : shape->dim()) {
+        if (utils::HasDimValue(dim)) {
+          block.constant_elems = SafeInt<int64_t>(block.constant_elems) * dim.dim_value();
+          continue;
+        }
+
+        auto it = utils::HasDimParam(dim) ? dim_index.find(dim.dim_param()) : dim_index.end();
+        if (it == dim_index.end()) {
+          symbolic = false;
+          break;
+        }
+        block.dims.push_back(it->second);
+      }
+
+      // the size must also agree with the traced execution, which verifies the inferred shape
+      size_t size = 0;
+      if (!symbolic || !TryGetBlockSize(block, dim_values, size) || size != alloc.size) {
+        continue;
+      }
+
+      traced_blocks.push_back({&alloc, traced->offset_, std::move(block)});
+    }
+
+    if (traced_blocks.empty()) {
+      continue;
+    }
+
+    // In the traced pattern, blocks with intersecting lifetimes do not overlap, so ordering by offset puts every
+    // such pair in the order that keeps them apart.
+    std::stable_sort(traced_blocks.begin(), traced_blocks.end(),
+                     [](const TracedBlock& a, const TracedBlock& b) { return a.offset < b.offset; });
+
+    std::vector<Block> blocks;
+    blocks.reserve(traced_blocks.size());
+    for (size_t j = 0; j < traced_blocks.size(); ++j) {
+      for (size_t i = 0; i < j; ++i) {
+        if (SymbolicMemoryPatternTrace::Overlap(*traced_blocks[i].alloc, *traced_blocks[j].alloc)) {
+          traced_blocks[j].block.predecessors.push_back(i);
+        }
+      }
+      blocks.push_back(std::move(traced_blocks[j].block));
+    }
+
+    group->locations_.push_back(location);
+    group->blocks_.push_back(std::move(blocks));
+  }
+
+  out = std::move(group);
+  return Status::OK();
+}
+
+Status SymbolicMemoryPatternGroup::Evaluate(gsl::span<const int> feed_mlvalue_idxs,
+                                            gsl::span<const OrtValue> feeds,
+                                            MemoryPatternGroup& out) const {
+  InlinedVector<int64_t> dim_values;
+  ORT_RETURN_IF_ERROR(BindDims(feed_mlvalue_idxs, feeds, dim_values));
+
+  out.locations.clear();
+  out.patterns.clear();
+  out.locations.reserve(locations_.size());
+  out.patterns.reserve(locations_.size());
+
+  std::vector<size_t> ends;
+  for (size_t l = 0; l < locations_.size(); ++l) {
+    const auto& blocks = blocks_[l];
+    MemoryPattern pattern;
+    pattern.patterns_.reserve(blocks.size());
+
+    // a block that is not evaluated ends at 0 so it doesn't push its successors
+    ends.assign(blocks.size(), 0);
+    for (size_t j = 0; j < blocks.size(); ++j) {
+      size_t size = 0;
+      if (!TryGetBlockSize(blocks[j], dim_values, size)) {
+        continue;
+      }
+
+      size_t offset = 0;
+      for (size_t i : blocks[j].predecessors) {
+        offset = std::max(offset, ends[i]);
+      }
+
+      ends[j] = SafeInt<size_t>(offset) + size;
+      pattern.patterns_.emplace(blocks[j].ort_value_idx, MemoryBlock(offset, size));
+      pattern.peak_size_ = std::max(pattern.peak_size_, ends[j]);
+    }
+
+    out.locations.push_back(locations_[l]);
+    out.patterns.push_back(std::move(pattern));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/data_types.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+class SessionState;
+
+// SymbolicMemoryPatternTrace records the order of the allocations and frees of one execution.
+// Together with the memory pattern generated by OrtValuePatternPlanner for the same execution it is
+// used to create a SymbolicMemoryPatternGroup.
+// Thread-safe.
+class SymbolicMemoryPatternTrace {
+ public:
+  struct Allocation {
+    int ort_value_idx;
+    size_t size;
+    size_t alloc_step;
+    size_t free_step;
+  };
+
+  SymbolicMemoryPatternTrace() = default;
+
+  void TraceAllocation(int ort_value_idx, size_t size);
+  void TraceFree(int ort_value_idx);
+
+  // Returns true if the lifetimes of the two allocations intersect.
+  static bool Overlap(const Allocation& a, const Allocation& b) {
+    return a.alloc_step < b.free_step && b.alloc_step < a.free_step;
+  }
+
+  const std::vector<Allocation>& Allocations() const { return allocs_; }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SymbolicMemoryPatternTrace);
+
+ private:
+  std::mutex lock_;
+  std::vector<Allocation> allocs_;
+  InlinedHashMap<int, size_t> alloc_index_;
+  size_t step_{0};
+};
+
+// SymbolicMemoryPatternGroup is a memory pattern whose block sizes and offsets are functions of the
+// symbolic dimensions of the graph inputs.
+//
+// The size of a block is its element count, a constant times a product of symbolic dimensions, converted to
+// aligned bytes. The blocks of a location are ordered by their offset in the traced execution, and the offset of
+// a block is the end of the furthest block before it whose lifetime intersects its own. Blocks with intersecting
+// lifetimes therefore never overlap for any binding of the dimensions, and a single buffer of the evaluated peak
+// size holds all the blocks of the location.
+class SymbolicMemoryPatternGroup {
+ public:
+  SymbolicMemoryPatternGroup() = default;
+
+  // Create the group from the allocations of one execution with the given feeds.
+  // Tensors whose shape is not known in terms of the symbolic dimensions of the graph inputs, or whose symbolic size
+  // does not match the traced size, are left out and allocated per execution.
+  static Status Create(const SessionState& session_state,
+                       gsl::span<const int> feed_mlvalue_idxs,
+                       gsl::span<const OrtValue> feeds,
+                       const SymbolicMemoryPatternTrace& trace,
+                       const MemoryPatternGroup& traced_patterns,
+                       std::unique_ptr<SymbolicMemoryPatternGroup>& out);
+
+  // Evaluate the group for the shapes of the given feeds.
+  // Blocks that use a dimension that is not bound by the feeds are left out.
+  Status Evaluate(gsl::span<const int> feed_mlvalue_idxs,
+                  gsl::span<const OrtValue> feeds,
+                  MemoryPatternGroup& out) const;
+
+  size_t NumDims() const { return dim_names_.size(); }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SymbolicMemoryPatternGroup);
+
+ private:
+  // A graph input axis that binds a symbolic dimension.
+  struct DimSource {
+    int ort_value_idx;
+    size_t axis;
+    size_t dim;
+  };
+
+  struct Block {
+    int ort_value_idx;
+    int64_t constant_elems;
+    InlinedVector<size_t> dims;
+    MLDataType element_type;
+    size_t alignment;
+    // Indices of the earlier blocks of the location whose lifetime intersects this block.
+    std::vector<size_t> predecessors;
+  };
+
+  // Returns false if the block uses a dimension that is not bound.
+  static bool TryGetBlockSize(const Block& block, gsl::span<const int64_t> dim_values, size_t& size);
+
+  Status BindDims(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                  InlinedVector<int64_t>& dim_values) const;
+
+  std::vector<std::string> dim_names_;
+  std::vector<DimSource> dim_sources_;
+  std::vector<OrtDevice> locations_;
+  std::vector<std::vector<Block>> blocks_;
+};
+}  // namespace onnxruntime
@@ -726,21 +726,22 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             bool only_execute_path_to_fetches,
-                            Stream* parent_stream) {
+                            Stream* parent_stream,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
-  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                                  execution_mode, terminate_flag, logger,
                                  device_stream_collection,
                                  only_execute_path_to_fetches,
                                  parent_stream);
   return retval;
 #else
-  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                           execution_mode, terminate_flag, logger,
                           only_execute_path_to_fetches,
                           parent_stream);
@@ -754,7 +755,8 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #ifdef ORT_ENABLE_STREAM
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
-                            const logging::Logger& logger) {
+                            const logging::Logger& logger,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
   return ExecuteGraph(session_state,
                       feeds_fetches_manager,
                       feeds, fetches,
@@ -764,7 +766,9 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #ifdef ORT_ENABLE_STREAM
                       device_stream_collection_holder,
 #endif
-                      run_options.only_execute_path_to_fetches);
+                      run_options.only_execute_path_to_fetches,
+                      nullptr,
+                      fetch_allocators);
 }
 
 #ifdef ENABLE_TRAINING
@@ -887,7 +891,17 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
                                Stream* parent_stream,
-                               bool sync_subgraph_fetches) {
+                               bool sync_subgraph_fetches,
+                               PersistentExecutionContext* persistent_context) {
+  if (persistent_context != nullptr && parent_stream == nullptr &&
+      feeds_fetches_manager.GetDeviceCopyChecks().status == DeviceCopyCheck::NoCopy &&
+      PersistentExecutionContext::IsSupported(session_state)) {
+    const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
+    return persistent_context->Execute(feeds_fetches_info.feeds_mlvalue_idxs, feeds,
+                                       feeds_fetches_info.fetches_mlvalue_idxs, fetches, fetch_allocators,
+                                       logger, terminate_flag);
+  }
+
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollectionHolder device_stream_collection_holder(&session_state);
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
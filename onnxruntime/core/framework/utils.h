@@ -21,6 +21,7 @@ class KernelDef;
 class KernelRegistryManager;
 class IExecutionProvider;
 class Node;
+class PersistentExecutionContext;
 class Tensor;
 struct KernelCreateInfo;
 #ifdef ENABLE_TRAINING
@@ -85,7 +86,8 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             bool only_execute_path_to_fetches = false,
-                            Stream* parent_stream = nullptr);
+                            Stream* parent_stream = nullptr,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators = {});
 
 common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                             gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
@@ -93,7 +95,8 @@ common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManag
 #ifdef ORT_ENABLE_STREAM
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
-                            const logging::Logger& logger);
+                            const logging::Logger& logger,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators = {});
 
 #ifdef ENABLE_TRAINING
 common::Status ExecutePartialGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
@@ -115,7 +118,10 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                /*when this is enabled, we will sync the parent stream to make sure the subgraph fetches
                                is complete. this is mainly used when the parent kernel depends on the CPU value of the
                                subgraph fetches, i.e. the loop condition*/
-                               bool sync_subgraph_fetches = false);
+                               bool sync_subgraph_fetches = false,
+                               // optional context that is kept alive across the executions of the subgraph.
+                               // used when the subgraph runs on CPU without device copies, otherwise ignored.
+                               PersistentExecutionContext* persistent_context = nullptr);
 
 bool IsInputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
 bool IsOutputOnCpu(const Node& node, const KernelCreateInfo* p_kci, size_t index);
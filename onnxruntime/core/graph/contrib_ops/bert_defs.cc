@@ -378,6 +378,30 @@ void GroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext&
   // TODO(aciddelgado): propagate output shapes depending if kv-share buffer is on or not
   constexpr int use_max_past_present_buffer = -1;
   BaseGroupQueryAttentionTypeAndShapeInference(ctx, past_key_index, use_max_past_present_buffer, qk_output_index);
+
+  // A quantized key/value cache is int8, or uint8 holding two int4 values, with float scales. Otherwise the cache
+  // has the type of query, which binds T_CACHE to T for the kernels that only support an unquantized cache.
+  const int64_t kv_cache_bit_width = getAttribute(ctx, "kv_cache_bit_width", 0);
+  const int32_t cache_type = kv_cache_bit_width == 0   ? ctx.getInputType(0)->tensor_type().elem_type()
+                             : kv_cache_bit_width == 8 ? ONNX_NAMESPACE::TensorProto::INT8
+                                                       : ONNX_NAMESPACE::TensorProto::UINT8;
+  for (int i = past_key_index; i <= past_key_index + 1 && i < static_cast<int>(ctx.getNumInputs()); ++i) {
+    const auto* past_type = ctx.getInputType(i);
+    if (past_type != nullptr && cache_type != ONNX_NAMESPACE::TensorProto::UNDEFINED &&
+        past_type->tensor_type().elem_type() != cache_type) {
+      fail_type_inference("past_key and past_value must have the type of query when kv_cache_bit_width is 0, or ",
+                          "int8/uint8 when it is 8/4");
+    }
+  }
+
+  if (kv_cache_bit_width != 0 && ctx.getNumOutputs() >= 3) {
+    updateOutputElemType(ctx, 1, cache_type);
+    updateOutputElemType(ctx, 2, cache_type);
+    if (ctx.getNumOutputs() >= 6) {
+      updateOutputElemType(ctx, 4, ONNX_NAMESPACE::TensorProto::FLOAT);
+      updateOutputElemType(ctx, 5, ONNX_NAMESPACE::TensorProto::FLOAT);
+    }
+  }
 }
 
 void SparseAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int past_key_index) {
@@ -1129,6 +1153,9 @@ Only supports causal and local attention.
 Supports rotary position embedding for CPU and CUDA.
 Supports packed input for CPU and CUDA.
 Supports continuous decoding for batch_size == 1 for CPU and CUDA.
+Supports an int8 or int4 quantized past/present key and value cache for CPU through the kv_cache_bit_width
+attribute. Each cached token is quantized symmetrically in groups of kv_quant_group_size values of a head, and
+the float scales are carried in past_key_scale/past_value_scale and present_key_scale/present_value_scale.
 
 )DOC";
 
@@ -1166,6 +1193,17 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "Output values of QK matrix multiplication before (1) or after (2) softmax normalization. Default value is 0 (don't output).",
               AttributeProto::INT,
               static_cast<int64_t>(QKOutputType::NO_OUTPUT))
+        .Attr("kv_cache_bit_width",
+              "Number of bits of the quantized past/present key and value cache: 0 (not quantized, same type as "
+              "query), 8 (int8) or 4 (two int4 values per uint8, so the last dimension is head_size / 2). "
+              "Default value is 0.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
+        .Attr("kv_quant_group_size",
+              "Number of values of a cached key or value head that share a quantization scale. It must divide "
+              "head_size and be a multiple of 8. Default value is 0, meaning head_size (one scale per token and head).",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
         .Input(0,
                "query",
                "Query with shape (batch_size, sequence_length, hidden_size), or packed QKV with shape"
@@ -1185,13 +1223,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1228,6 +1266,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "1D tensor with shape (num_heads). Each head has a smooth factor adding to the denominator of softmax.",
                "T",
                OpSchema::Optional)
+        .Input(12,
+               "past_key_scale",
+               "Scales of the quantized past key with shape (batch_size, kv_num_heads, past_sequence_length, "
+               "head_size / kv_quant_group_size). Required when kv_cache_bit_width is not 0 and past_key is given.",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(13,
+               "past_value_scale",
+               "Scales of the quantized past value with shape (batch_size, kv_num_heads, past_sequence_length, "
+               "head_size / kv_quant_group_size). Required when kv_cache_bit_width is not 0 and past_value is given.",
+               "tensor(float)",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1237,19 +1287,33 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(3,
                 "output_qk",
                 "Values of QK matrix multiplication, either before or after softmax normalization",
                 "T",
                 OpSchema::Optional)
+        .Output(4,
+                "present_key_scale",
+                "Scales of the quantized present key with shape (batch_size, kv_num_heads, present_sequence_length, "
+                "head_size / kv_quant_group_size). Required when kv_cache_bit_width is not 0.",
+                "tensor(float)",
+                OpSchema::Optional)
+        .Output(5,
+                "present_value_scale",
+                "Scales of the quantized present value with shape (batch_size, kv_num_heads, present_sequence_length, "
+                "head_size / kv_quant_group_size). Required when kv_cache_bit_width is not 0.",
+                "tensor(float)",
+                OpSchema::Optional)
         .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)", "tensor(uint8)"},
+                        "Constrain the key/value cache to the type of query, or to int8/uint8 when quantized.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3, 3);
@@ -1851,6 +1915,17 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           updateOutputShape(ctx, 0, output_shape);
         }));
 
+constexpr const char* kSkipLayerNormQuantizedOutputDoc =
+    "Output quantized to int8 blocks in the platform specific layout of the quantized_A input of MatMulNBits "
+    "with accuracy_level 4, for a MatMulNBits with the B quantization given by the quantized_output_* attributes. "
+    "Only produced by graph optimization for the CPU execution provider. It is empty if the layout is not available.";
+constexpr const char* kSkipLayerNormQuantizedOutputBitsDoc =
+    "Number of bits of the quantized B of the MatMulNBits that consumes quantized_output.";
+constexpr const char* kSkipLayerNormQuantizedOutputBlockSizeDoc =
+    "Block size of the quantized B of the MatMulNBits that consumes quantized_output.";
+constexpr const char* kSkipLayerNormQuantizedOutputHasZeroPointDoc =
+    "Whether the MatMulNBits that consumes quantized_output has zero points.";
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     SkipLayerNormalization, 1,
     OpSchema()
@@ -1865,8 +1940,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .Output(1, "mean", "Saved mean used during training to speed up gradient computation", "U", OpSchema::Optional)
         .Output(2, "inv_std_var", "Saved inverse standard variance used during training to speed up gradient computation.", "U", OpSchema::Optional)
         .Output(3, "input_skip_bias_sum", "Sum of the input and skip inputs (and bias if it exists) with shape (batch_size, sequence_length, hidden_size).", "T", OpSchema::Optional)
+        .Output(4, "quantized_output", kSkipLayerNormQuantizedOutputDoc, "Q", OpSchema::Optional)
+        .Attr("quantized_output_bits", kSkipLayerNormQuantizedOutputBitsDoc, AttributeProto::INT, static_cast<int64_t>(4))
+        .Attr("quantized_output_block_size", kSkipLayerNormQuantizedOutputBlockSizeDoc, AttributeProto::INT, static_cast<int64_t>(32))
+        .Attr("quantized_output_has_zero_point", kSkipLayerNormQuantizedOutputHasZeroPointDoc, AttributeProto::INT, static_cast<int64_t>(0))
         .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float or half tensors.")
         .TypeConstraint("U", {"tensor(float)"}, "Constrain mean and inv_std_var to float tensors.")
+        .TypeConstraint("Q", {"tensor(uint8)"}, "Constrain quantized_output to uint8 tensors.")
         .TypeAndShapeInferenceFunction(SkipLayerNormalizationShapeInference));
 
 ONNX_MS_OPERATOR_SET_SCHEMA(
@@ -1914,8 +1994,17 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "with shape (batch_size, sequence_length, hidden_size) or (token_count, hidden_size).",
                 "T",
                 OpSchema::Optional)
+        .Output(4,
+                "quantized_output",
+                kSkipLayerNormQuantizedOutputDoc,
+                "Q",
+                OpSchema::Optional)
+        .Attr("quantized_output_bits", kSkipLayerNormQuantizedOutputBitsDoc, AttributeProto::INT, static_cast<int64_t>(4))
+        .Attr("quantized_output_block_size", kSkipLayerNormQuantizedOutputBlockSizeDoc, AttributeProto::INT, static_cast<int64_t>(32))
+        .Attr("quantized_output_has_zero_point", kSkipLayerNormQuantizedOutputHasZeroPointDoc, AttributeProto::INT, static_cast<int64_t>(0))
         .TypeConstraint("T", {"tensor(float)", "tensor(float16)", "tensor(bfloat16)"}, "Constrain input and output to float tensors.")
         .TypeConstraint("U", {"tensor(float)"}, "Constrain mean and inv_std_var to float tensors.")
+        .TypeConstraint("Q", {"tensor(uint8)"}, "Constrain quantized_output to uint8 tensors.")
         .TypeAndShapeInferenceFunction(SkipLayerNormalizationShapeInference));
 
 constexpr const char* NGramRepeatBlock_ver1_doc = R"DOC(
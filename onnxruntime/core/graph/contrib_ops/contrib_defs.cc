@@ -1476,11 +1476,62 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "2D input tensor with shape (num_rows, hidden_size) or 3D input tensor with shape "
                 "(batch_size, sequence_length, hidden_size)",
                 "T")
-        .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)"}, "Constrain input and output types to float tensors.")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)", "tensor(bfloat16)"}, "Constrain input and output types to float tensors.")
         .TypeConstraint("T1", {"tensor(uint8)"}, "Constrain weights type to uint8 tensors.")
         .TypeConstraint("T2", {"tensor(float)", "tensor(float16)"}, "Constrain scales type to float tensors.")
         .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+constexpr const char* MultiLoRA_ver1_doc = R"DOC(
+      Low-rank adapter (LoRA) update where each batch entry selects its own adapter, so requests for
+      different fine-tunes of one base model can share a batch (SGMV, https://arxiv.org/abs/2310.18547).
+      For every batch entry b with adapter_ids[b] = i, output = base + scale * input * lora_a[i] * lora_b[i].
+      Batch entries with a negative adapter id get no update. The stacked adapter weights are usually bound
+      from several resident LoRA adapters at run time.
+      )DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MultiLoRA, 1,
+    OpSchema()
+        .SetDoc(MultiLoRA_ver1_doc)
+        .Attr("scale", "Scaling factor of the low-rank update", AttributeProto::FLOAT, 1.0f)
+        .Input(0,
+               "input",
+               "2D input tensor with shape (batch_size, hidden_size) or 3D input tensor with shape "
+               "(batch_size, sequence_length, hidden_size)",
+               "T")
+        .Input(1, "lora_a", "3D input tensor with shape (num_adapters, hidden_size, rank)", "T")
+        .Input(2, "lora_b", "3D input tensor with shape (num_adapters, rank, output_size)", "T")
+        .Input(3, "adapter_ids", "1D input tensor with shape (batch_size). A negative id selects no adapter.", "I")
+        .Input(4,
+               "base",
+               "Optional output of the base projection with the same shape as the output",
+               "T",
+               OpSchema::Optional)
+        .Output(0,
+                "output",
+                "2D output tensor with shape (batch_size, output_size) or 3D output tensor with shape "
+                "(batch_size, sequence_length, output_size)",
+                "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeConstraint("I", {"tensor(int32)"}, "Constrain adapter ids to int32 tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 2)) {
+            return;
+          }
+          const auto& input_shape = getInputShape(ctx, 0);
+          const auto& lora_b_shape = getInputShape(ctx, 2);
+          if (lora_b_shape.dim_size() != 3) {
+            fail_shape_inference("lora_b shall be 3 dimensions");
+          }
+          ONNX_NAMESPACE::TensorShapeProto output_shape;
+          for (int i = 0; i < input_shape.dim_size() - 1; ++i) {
+            *output_shape.add_dim() = input_shape.dim(i);
+          }
+          *output_shape.add_dim() = lora_b_shape.dim(2);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(SampleOp, 1,
                             OpSchema()
                                 .Input(0, "X", "input", "T")
@@ -1949,6 +2000,46 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Tokenizer, 1,
                                   updateOutputShape(ctx, 0, output_shape);
                                 }));
 
+constexpr const char* ZipMapColumnar_ver1_doc = R"DOC(
+Columnar form of ai.onnx.ml.ZipMap. ZipMap creates a map from label to probability for every row of the input,
+which is expensive for large batches or many classes. ZipMapColumnar returns the probabilities as a dense
+tensor of shape [N, C] instead, and the labels are only stored once in the classlabels_strings or classlabels_int64s
+attribute. A 1-D input of shape [C] produces an output of shape [1, C].
+Column j of the output holds the probabilities of label j, so row i is equivalent to the i-th map of ZipMap.
+The output shares the buffer of the input when possible.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(ZipMapColumnar, 1,
+                            OpSchema()
+                                .SetDoc(ZipMapColumnar_ver1_doc)
+                                .Input(0, "X", "The input values. Shape is [N, C] or [C].", "T")
+                                .Output(0, "Z", "The input values as a 2-D tensor of shape [N, C].", "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output to float tensors.")
+                                .Attr("classlabels_strings", "The keys when using string keys.",
+                                      AttributeProto::STRINGS, OPTIONAL_VALUE)
+                                .Attr("classlabels_int64s", "The keys when using int keys.",
+                                      AttributeProto::INTS, OPTIONAL_VALUE)
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  if (!hasInputShape(ctx, 0))
+                                    return;
+
+                                  auto& input_shape = getInputShape(ctx, 0);
+                                  const int rank = input_shape.dim_size();
+                                  if (rank < 1 || rank > 2) {
+                                    fail_shape_inference("Input dimensions are either [C] or [N][C] allowed");
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  if (rank == 1) {
+                                    output_shape.add_dim()->set_dim_value(1);
+                                  } else {
+                                    *output_shape.add_dim() = input_shape.dim(0);
+                                  }
+                                  *output_shape.add_dim() = input_shape.dim(rank - 1);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(MatMulInteger16, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(
@@ -3478,6 +3569,12 @@ For example, for 4 bits, the first 4 bits are stored in the lower 4 bits of a by
              "T3", OpSchema::Optional)
       .Input(4, "g_idx", "group_idx. This input is deprecated", "T4", OpSchema::Optional)
       .Input(5, "bias", "Bias to add to result. It should have shape [N].", "T1", OpSchema::Optional)
+      .Input(6, "quantized_A",
+             "Input A already quantized to int8 blocks, in the platform specific layout of the quantized_output of "
+             "SkipLayerNormalization. Only added by graph optimization for the CPU execution provider. "
+             "It is used instead of quantizing A when accuracy_level is 4 and it matches the shape of A, "
+             "otherwise it is ignored.",
+             "T2", OpSchema::Optional)
       .Output(0, "Y", "tensor. The output tensor has the same rank as the input. ", "T1")
       .TypeConstraint("T1", {"tensor(float)", "tensor(float16)", "tensor(bfloat16)"},
                       "Constrain input and output types to float tensors.")
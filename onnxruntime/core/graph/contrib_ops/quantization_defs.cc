@@ -600,6 +600,81 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
         .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+const char* QLinearGeluDoc_ver1 = R"DOC(
+QLinearGelu takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
+(Tensor<T>) where the function `f(x) = quantize(Gelu(dequantize(x)))`, is applied to the data tensor elementwise.
+Where the function `Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))`, or
+`Gelu(x) = 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))` when `approximate` is 'tanh'.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearGelu, 1,
+    OpSchema()
+        .SetDoc(QLinearGeluDoc_ver1)
+        .Attr("approximate", "Gelu approximation algorithm: 'none' or 'tanh'.", AttributeProto::STRING,
+              std::string("none"))
+        .Input(0, "X", "Input tensor", "T")
+        .Input(1, "X_scale", "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(2, "X_zero_point",
+               "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(3, "Y_scale", "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(4, "Y_zero_point",
+               "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Output(0, "Y", "Output tensor", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+const char* QLinearLayerNormalizationDoc_ver1 = R"DOC(
+QLinearLayerNormalization is the quantized version of LayerNormalization. It normalizes the quantized input over the
+dimensions from `axis` on, applies the quantized `Scale` and the optional int32 bias `B`, and quantizes the result
+with the output quantization parameters:
+`Y = quantize((dequantize(X) - Mean) / sqrt(Var + epsilon) * dequantize(Scale) + dequantize(B))`.
+The zero point of `B` is 0, as for the bias of QLinearConv.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearLayerNormalization, 1,
+    OpSchema()
+        .SetDoc(QLinearLayerNormalizationDoc_ver1)
+        .Attr("axis", "The first normalization dimension. Negative value means counting dimensions from the back.",
+              AttributeProto::INT, static_cast<int64_t>(-1))
+        .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+        .Attr("stash_type", "Kept for compatibility with LayerNormalization. The statistics are always computed in "
+              "at least float precision.", AttributeProto::INT, static_cast<int64_t>(1))
+        .Input(0, "X", "Input tensor", "T")
+        .Input(1, "X_scale", "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(2, "X_zero_point",
+               "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(3, "Scale", "Quantized scale, with the shape of the normalized dimensions.", "T2")
+        .Input(4, "Scale_scale", "Scale of the quantized Scale. A scalar, or one value per element of Scale.",
+               "tensor(float)")
+        .Input(5, "Scale_zero_point",
+               "Zero point of the quantized Scale. Default value is 0 if it's not specified. A scalar, or one value "
+               "per element of Scale.",
+               "T2", OpSchema::Optional)
+        .Input(6, "Y_scale", "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(7, "Y_zero_point",
+               "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(8, "B", "Optional quantized bias, with the shape of the normalized dimensions.", "tensor(int32)",
+               OpSchema::Optional)
+        .Input(9, "B_scale", "Scale of the quantized B. A scalar, or one value per element of B. Required with B.",
+               "tensor(float)", OpSchema::Optional)
+        .Output(0, "Y", "Output tensor", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
+        .TypeConstraint("T2", {"tensor(uint8)", "tensor(int8)"}, "Constrain scale types to 8 bit tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     QLinearSoftmax, 1,
     OpSchema()
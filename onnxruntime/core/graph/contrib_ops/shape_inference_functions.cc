@@ -129,6 +129,10 @@ void SkipLayerNormalizationShapeInference(::ONNX_NAMESPACE::InferenceContext& ct
   if (ctx.getNumOutputs() > 3) {
     propagateElemTypeFromInputToOutput(ctx, 0, 3);
   }
+  if (ctx.getNumOutputs() > 4) {
+    auto output_type = ctx.getOutputType(4);
+    output_type->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_UINT8);
+  }
   if (!hasNInputShapes(ctx, 1)) {
     return;
   }
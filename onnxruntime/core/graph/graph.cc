@@ -41,6 +41,7 @@
 #include "core/graph/function.h"
 #include "core/graph/function_impl.h"
 #include "core/graph/schema_registry.h"
+#include "core/platform/threadpool.h"
 #include "onnx/checker.h"
 #include "onnx/defs/parser.h"
 using namespace ONNX_NAMESPACE::checker;
@@ -1198,15 +1199,17 @@ Graph::Graph(const Model& owning_model,
              Version ir_version,
              IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
              const logging::Logger& logger,
-             bool strict_shape_type_inference)
+             bool strict_shape_type_inference,
+             concurrency::ThreadPool* thread_pool)
     : Graph(owning_model, graph_proto, domain_to_version, ir_version,
-            schema_registry, nullptr, nullptr, logger, strict_shape_type_inference) {}
+            schema_registry, nullptr, nullptr, logger, strict_shape_type_inference, thread_pool) {}
 
 Graph::Graph(const Model& owning_model,
              GraphProto* graph_proto, const std::unordered_map<std::string, int>& domain_to_version, Version ir_version,
              IOnnxRuntimeOpSchemaCollectionPtr schema_registry, Graph* parent_graph, const Node* parent_node,
              const logging::Logger& logger,
-             bool strict_shape_type_inference)
+             bool strict_shape_type_inference,
+             concurrency::ThreadPool* thread_pool)
     : owning_model_(owning_model),
       graph_proto_(graph_proto),
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -1226,23 +1229,33 @@ Graph::Graph(const Model& owning_model,
   ArgNameToTypeMap name_to_type_map;
   const auto& model_path = ModelPath();
 
+  // Move the data of the tensor proto into an OrtValue and replace the tensor proto with one that has an
+  // external data reference pointing to the OrtValue. Only accesses the given tensor proto, so it is safe to call
+  // for different tensor protos concurrently.
+  auto move_data_to_ort_value = [&model_path](ONNX_NAMESPACE::TensorProto& tensor_proto, OrtValue& ort_value) {
+    ORT_RETURN_IF_ERROR(utils::TensorProtoToOrtValue(Env::Default(), model_path, tensor_proto,
+                                                     CPUAllocator::DefaultInstance(), ort_value));
+    constexpr const bool use_tensor_buffer_true = true;
+    tensor_proto = utils::TensorToTensorProto(ort_value.Get<Tensor>(), tensor_proto.name(), use_tensor_buffer_true);
+    return Status::OK();
+  };
+
+  auto add_ort_value_initializer = [this](const std::string& name, OrtValue&& ort_value) {
+    assert(ort_value.IsAllocated());
+    auto ins_result = ortvalue_initializers_.insert_or_assign(name, std::move(ort_value));
+    ORT_ENFORCE(ins_result.second, "Unexpected duplicate insert or assign OrtValue for tensor: ", name,
+                " in the initializer list.");
+  };
+
   // If the tensor proto data is large enough, externalize it and replace with a tensor_proto
   // with external data reference pointing to an OrtValue, otherwise do nothing.
-  auto put_data_maybe_in_memory = [this, &model_path](ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  auto put_data_maybe_in_memory = [&](ONNX_NAMESPACE::TensorProto& tensor_proto) {
     size_t size_in_bytes = 0;
     ORT_THROW_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &size_in_bytes));
     if (size_in_bytes > utils::kSmallTensorExternalDataThreshold) {
       OrtValue ort_value;
-      ORT_THROW_IF_ERROR(utils::TensorProtoToOrtValue(Env::Default(), model_path, tensor_proto,
-                                                      CPUAllocator::DefaultInstance(), ort_value));
-      constexpr const bool use_tensor_buffer_true = true;
-      auto tensor_proto_to_add = utils::TensorToTensorProto(ort_value.Get<Tensor>(), tensor_proto.name(),
-                                                            use_tensor_buffer_true);
-      assert(ort_value.IsAllocated());
-      auto ins_result = ortvalue_initializers_.insert_or_assign(tensor_proto_to_add.name(), std::move(ort_value));
-      ORT_ENFORCE(ins_result.second, "Unexpected duplicate insert or assign OrtValue for tensor: ", tensor_proto_to_add.name(),
-                  " in the initializer list.");
-      tensor_proto = std::move(tensor_proto_to_add);
+      ORT_THROW_IF_ERROR(move_data_to_ort_value(tensor_proto, ort_value));
+      add_ort_value_initializer(tensor_proto.name(), std::move(ort_value));
     }
   };
 
@@ -1342,6 +1355,52 @@ Graph::Graph(const Model& owning_model,
     }
   }
 
+  // Unpacking the data of the large initializers dominates the load time of models with many weights and is
+  // independent per initializer, so do it up front for all of them, in parallel if there is a thread pool.
+  // The loop below skips these initializers as they now have in-memory external data.
+  {
+    InlinedVector<int> large_initializers;
+    size_t large_initializers_size_in_bytes = 0;
+    for (int i = 0, lim = graph_proto_->initializer_size(); i < lim; ++i) {
+      const auto& tensor = graph_proto_->initializer(i);
+      size_t size_in_bytes = 0;
+      if (!utils::HasExternalData(tensor) &&
+          utils::GetSizeInBytesFromTensorProto<0>(tensor, &size_in_bytes).IsOK() &&
+          size_in_bytes > utils::kSmallTensorExternalDataThreshold) {
+        large_initializers.push_back(i);
+        large_initializers_size_in_bytes += size_in_bytes;
+      }
+    }
+
+    if (!large_initializers.empty()) {
+      const auto num_large_initializers = static_cast<std::ptrdiff_t>(large_initializers.size());
+      std::vector<OrtValue> ort_values(large_initializers.size());
+      std::vector<Status> statuses(large_initializers.size());
+      concurrency::ThreadPool::TryParallelFor(
+          thread_pool, num_large_initializers,
+          static_cast<double>(large_initializers_size_in_bytes) / static_cast<double>(num_large_initializers),
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t j = first; j < last; ++j) {
+              auto& tensor = *graph_proto_->mutable_initializer(large_initializers[j]);
+              ORT_TRY {
+                statuses[j] = move_data_to_ort_value(tensor, ort_values[j]);
+              }
+              ORT_CATCH(const std::exception& ex) {
+                ORT_HANDLE_EXCEPTION([&]() {
+                  statuses[j] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to load initializer ", tensor.name(),
+                                                ": ", ex.what());
+                });
+              }
+            }
+          });
+
+      for (size_t j = 0; j < large_initializers.size(); ++j) {
+        ORT_THROW_IF_ERROR(statuses[j]);
+        add_ort_value_initializer(graph_proto_->initializer(large_initializers[j]).name(), std::move(ort_values[j]));
+      }
+    }
+  }
+
   // Copy initial tensors to a map.
   for (int i = 0, lim = graph_proto_->initializer_size(); i < lim; ++i) {
     auto& tensor = *graph_proto_->mutable_initializer(i);
@@ -1423,6 +1482,16 @@ Graph::Graph(const Model& owning_model,
     }
   }
 
+  // Size the NodeArg and Node containers up front so adding the nodes of a large graph does not rehash and
+  // reallocate repeatedly. Each node output defines a NodeArg; node inputs refer to these or to the NodeArgs
+  // created above.
+  size_t num_node_outputs = 0;
+  for (const auto& node_proto : graph_proto_->node()) {
+    num_node_outputs += static_cast<size_t>(node_proto.output_size());
+  }
+  node_args_.reserve(node_args_.size() + num_node_outputs);
+  nodes_.reserve(static_cast<size_t>(graph_proto_->node_size()));
+
   for (const auto& node_proto : graph_proto_->node()) {
     AddNode(node_proto, name_to_type_map);
   }
@@ -3180,14 +3249,60 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
-  for (auto node_index : nodes_in_topological_order_) {
+  // Running the ONNX checker on a node only reads the node, so for a large graph check the nodes that still have
+  // their original NodeProto in parallel up front. The nodes are checked against a lexical scope that contains the
+  // outputs of all the nodes. That matches checking them in topological order, as a subgraph can only refer to
+  // outer scope values of the nodes that the node containing it depends on.
+  // Entry i is the result for nodes_in_topological_order_[i] if the node was checked up front.
+  std::vector<std::optional<Status>> checked_node_status;
+  if (concurrency::ThreadPool::DegreeOfParallelism(options.thread_pool) > 1) {
+    LexicalScopeContext graph_lsc{lsc};
+    for (auto node_index : nodes_in_topological_order_) {
+      for (const auto* output : GetNode(node_index)->OutputDefs()) {
+        graph_lsc.output_names.insert(output->Name());
+      }
+    }
+
+    // rough cost of checking a node in cycles, so small graphs are checked inline
+    constexpr double kCheckNodeCost = 10000.0;
+    checked_node_status.resize(nodes_in_topological_order_.size());
+    concurrency::ThreadPool::TryParallelFor(
+        options.thread_pool, static_cast<std::ptrdiff_t>(nodes_in_topological_order_.size()), kCheckNodeCost,
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const Node& node = *GetNode(nodes_in_topological_order_[i]);
+            const NodeProto* orig_node_proto = node.GetOriginalNodeProto();
+            if (node.Op() || !orig_node_proto) {
+              continue;
+            }
+
+            auto status = Status::OK();
+            ORT_TRY {
+              checker::check_node(*orig_node_proto, ctx, graph_lsc);
+            }
+            ORT_CATCH(const std::exception& ex) {
+              ORT_HANDLE_EXCEPTION([&]() {
+                status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_GRAPH,
+                                         "This is an invalid model. In Node, ", node, ", Error ", ex.what());
+              });
+            }
+            checked_node_status[i] = std::move(status);
+          }
+        });
+  }
+
+  for (size_t i = 0; i < nodes_in_topological_order_.size(); ++i) {
     // Node verification.
-    auto& node = *GetNode(node_index);
+    auto& node = *GetNode(nodes_in_topological_order_[i]);
 
     const auto& node_name = node.Name();
 
     if (!node.Op()) {
-      {
+      if (i < checked_node_status.size() && checked_node_status[i].has_value()) {
+        ORT_RETURN_IF_ERROR(*checked_node_status[i]);
+        // clear original as we don't know if the node will be modified once the Graph::Resolve completes.
+        node.SetOriginalNodeProto(nullptr);
+      } else {
         auto status = Status::OK();
         ORT_TRY {
           // if this is first Graph::Resolve call, we may have a NodeProto that was set on the Node so we can skip
@@ -3377,9 +3492,9 @@ Status Graph::Resolve(const ResolveOptions& options) {
     return Status::OK();
   }
 
-  // init all graph/subgraphs. non-recursive so call via ForThisAndAllSubgraphs.
+  // init all graph/subgraphs. non-recursive and independent per graph so can run in parallel.
   auto init_func = [](Graph& graph) { return graph.InitInputsInitializersOutputs(); };
-  ORT_RETURN_IF_ERROR(ForThisAndAllSubgraphs(all_subgraphs, init_func));
+  ORT_RETURN_IF_ERROR(ForThisAndAllSubgraphsInParallel(all_subgraphs, options.thread_pool, init_func));
 
   std::unordered_set<std::string> outer_scope_node_args_consumed;
 
@@ -3388,9 +3503,9 @@ Status Graph::Resolve(const ResolveOptions& options) {
   ORT_ENFORCE(outer_scope_node_args_consumed.empty(),
               "Shouldn't be possible to have NodeArgs that haven't been handled already.");
 
-  // topological sort of this and any subgraphs is non-recursive
+  // topological sort of this and any subgraphs is non-recursive and independent per graph
   auto topo_sort_func = [](Graph& graph) { return graph.PerformTopologicalSortAndCheckIsAcyclic(); };
-  ORT_RETURN_IF_ERROR(ForThisAndAllSubgraphs(all_subgraphs, topo_sort_func));
+  ORT_RETURN_IF_ERROR(ForThisAndAllSubgraphsInParallel(all_subgraphs, options.thread_pool, topo_sort_func));
 
   // type/shape validation and inferencing on this and any subgraphs
   // recurses into subgraphs via the ONNX checker, which descends into the GraphProto in node attributes
@@ -3541,6 +3656,36 @@ Status Graph::ForThisAndAllSubgraphs(const std::vector<Graph*>& subgraphs, std::
   return status;
 }
 
+Status Graph::ForThisAndAllSubgraphsInParallel(const std::vector<Graph*>& subgraphs,
+                                               concurrency::ThreadPool* thread_pool,
+                                               const std::function<Status(Graph&)>& func) {
+  if (subgraphs.empty() || concurrency::ThreadPool::DegreeOfParallelism(thread_pool) <= 1) {
+    return ForThisAndAllSubgraphs(subgraphs, func);
+  }
+
+  // index 0 is this graph. report the error of the first graph that failed in the same order as the sequential
+  // iteration.
+  std::vector<Status> statuses(subgraphs.size() + 1);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(statuses.size()), [&](std::ptrdiff_t i) {
+        Graph& graph = i == 0 ? *this : *subgraphs[static_cast<size_t>(i) - 1];
+        ORT_TRY {
+          statuses[i] = func(graph);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
 Status Graph::RemovedUnusedInitializersOrtFormat() {
   std::vector<Graph*> all_subgraphs;
   FindAllSubgraphs(all_subgraphs);
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <exception>
 #include <memory>
 #include "core/common/logging/logging.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
@@ -24,6 +25,7 @@
 #include <gsl/gsl>
 
 #include "core/platform/env.h"
+#include "core/platform/threadpool.h"
 
 #if !defined(ORT_MINIMAL_BUILD)
 #include "core/graph/schema_registry.h"
@@ -129,27 +131,13 @@ Model::Model(const std::string& graph_name,
                                             func_ptr);
   }
 
-  model_local_function_templates_maps_.reserve(model_proto_.functions().size());
-  for (auto& func : model_proto_.functions()) {
-    auto func_schema_ptr = function_utils::CreateSchema(func.domain(),
-                                                        func.name(),
-                                                        model_local_functions_,
-                                                        *p_domain_to_version,
-                                                        *schema_registry,
-                                                        logger,
-                                                        allow_released_opsets_only_final);
-    auto func_template_ptr = std::make_unique<FunctionTemplate>();
-    func_template_ptr->op_schema_ = std::move(func_schema_ptr);
-    func_template_ptr->onnx_func_proto_ = &func;
-    model_local_function_templates_maps_.insert_or_assign(function_utils::GetFunctionIdentifier(func.domain(),
-                                                                                                func.name()),
-                                                          std::move(func_template_ptr));
-  }
+  CreateModelLocalFunctionTemplates(*p_domain_to_version, *schema_registry, logger,
+                                    allow_released_opsets_only_final, options.thread_pool);
 
   // need to call private ctor so can't use make_shared
   GSL_SUPPRESS(r .11)
   graph_.reset(new Graph(*this, model_proto_.mutable_graph(), *p_domain_to_version, IrVersion(), schema_registry,
-                         logger, options.strict_shape_type_inference));
+                         logger, options.strict_shape_type_inference, options.thread_pool));
 }
 
 Model::Model(const ModelProto& model_proto, const PathString& model_path,
@@ -259,27 +247,55 @@ Model::Model(ModelProto&& model_proto, const PathString& model_path,
     model_local_functions_.insert_or_assign(function_utils::GetFunctionIdentifier(func.domain(), func.name()), &func);
   }
 
-  model_local_function_templates_maps_.reserve(model_proto_.functions().size());
-  for (auto& func : model_proto_.functions()) {
-    auto func_schema_ptr = function_utils::CreateSchema(func.domain(),
-                                                        func.name(),
-                                                        model_local_functions_,
-                                                        domain_to_version,
-                                                        *schema_registry,
-                                                        logger,
-                                                        allow_official_onnx_release_only_final);
+  CreateModelLocalFunctionTemplates(domain_to_version, *schema_registry, logger,
+                                    allow_official_onnx_release_only_final, options.thread_pool);
+
+  // create instance. need to call private ctor so can't use make_unique
+  GSL_SUPPRESS(r .11)
+  graph_.reset(new Graph(*this, model_proto_.mutable_graph(), domain_to_version, IrVersion(), schema_registry,
+                         logger, options.strict_shape_type_inference, options.thread_pool));
+}
+
+void Model::CreateModelLocalFunctionTemplates(const std::unordered_map<std::string, int>& domain_to_version,
+                                              const SchemaRegistryManager& schema_registry,
+                                              const logging::Logger& logger,
+                                              bool allow_released_opsets_only,
+                                              concurrency::ThreadPool* thread_pool) {
+  const auto& functions = model_proto_.functions();
+
+  // The schema of a function only depends on the function protos and the schema registry, which are read only here,
+  // so the schemas are created in parallel.
+  std::vector<std::unique_ptr<ONNX_NAMESPACE::OpSchema>> schemas(functions.size());
+  std::vector<std::exception_ptr> errors(functions.size());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(functions.size()), [&](std::ptrdiff_t i) {
+        const auto& func = functions[static_cast<int>(i)];
+        ORT_TRY {
+          schemas[i] = function_utils::CreateSchema(func.domain(), func.name(), model_local_functions_,
+                                                    domain_to_version, schema_registry, logger,
+                                                    allow_released_opsets_only);
+        }
+        ORT_CATCH(...) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            errors[i] = std::current_exception();
+          });
+        }
+      });
+
+  model_local_function_templates_maps_.reserve(functions.size());
+  for (int i = 0; i < functions.size(); ++i) {
+    if (errors[i]) {
+      std::rethrow_exception(errors[i]);
+    }
+
+    const auto& func = functions[i];
     auto func_template_ptr = std::make_unique<FunctionTemplate>();
-    func_template_ptr->op_schema_ = std::move(func_schema_ptr);
+    func_template_ptr->op_schema_ = std::move(schemas[i]);
     func_template_ptr->onnx_func_proto_ = &func;
     model_local_function_templates_maps_.insert_or_assign(function_utils::GetFunctionIdentifier(func.domain(),
                                                                                                 func.name()),
                                                           std::move(func_template_ptr));
   }
-
-  // create instance. need to call private ctor so can't use make_unique
-  GSL_SUPPRESS(r .11)
-  graph_.reset(new Graph(*this, model_proto_.mutable_graph(), domain_to_version, IrVersion(), schema_registry,
-                         logger, options.strict_shape_type_inference));
 }
 
 const NodeHashMap<std::string, std::unique_ptr<FunctionTemplate>>& Model::GetModelLocalFunctionTemplates() const {
@@ -382,6 +398,12 @@ ModelProto Model::ToProto() const {
   return result;
 }
 
+ModelProto Model::ToProtoWithInMemoryReferences() {
+  // The graph proto is owned by model_proto_, so it is copied with it once it is in sync with the graph.
+  graph_->ToGraphProto();
+  return model_proto_;
+}
+
 ModelProto Model::ToGraphProtoWithExternalInitializers(const std::filesystem::path& external_file_name,
                                                        const std::filesystem::path& file_path,
                                                        const ModelSavingOptions& model_saving_options) const {
@@ -449,6 +471,7 @@ Status Model::Load(const ModelProto& model_proto,
 
   Graph::ResolveOptions resolve_options;
   resolve_options.no_proto_sync_required = true;
+  resolve_options.thread_pool = options.thread_pool;
   ORT_RETURN_IF_ERROR(model->MainGraph().Resolve(resolve_options));
 
   return status;
@@ -493,6 +516,7 @@ Status Model::Load(ModelProto&& model_proto,
 
   Graph::ResolveOptions resolve_options;
   resolve_options.no_proto_sync_required = true;
+  resolve_options.thread_pool = options.thread_pool;
   ORT_RETURN_IF_ERROR(model->MainGraph().Resolve(resolve_options));
 
   return status;
@@ -690,6 +714,7 @@ Status Model::LoadFromBytes(int count, void* p_bytes, const PathString& model_pa
 
   Graph::ResolveOptions resolve_options;
   resolve_options.no_proto_sync_required = true;
+  resolve_options.thread_pool = options.thread_pool;
   ORT_RETURN_IF_ERROR(p_model->MainGraph().Resolve(resolve_options));
 
   return Status::OK();
@@ -749,6 +774,7 @@ Status Model::Load(int fd, const PathString& model_path, std::shared_ptr<Model>&
 
   Graph::ResolveOptions resolve_options;
   resolve_options.no_proto_sync_required = true;
+  resolve_options.thread_pool = options.thread_pool;
   ORT_RETURN_IF_ERROR(p_model->MainGraph().Resolve(resolve_options));
 
   return Status::OK();
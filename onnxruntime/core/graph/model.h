@@ -22,6 +22,7 @@
 namespace onnxruntime {
 
 class PrepackedShareableWeightsContainer;
+class SchemaRegistryManager;
 
 namespace fbs {
 struct Model;
@@ -41,6 +42,11 @@ struct ModelOptions {
 
   CheckLoadCancellationFn check_load_cancellation_fn;
 
+  // Thread pool to parallelize the independent parts of loading and resolving the model: converting the
+  // initializer data, creating the schemas of the model local functions and checking the nodes. Optional.
+  // Only used while loading, so it only needs to outlive the Model::Load call.
+  concurrency::ThreadPool* thread_pool = nullptr;
+
   ModelOptions(bool allow_released_opsets_only, bool strict_shape_type_inference,
                CheckLoadCancellationFn check_load_cancellation_fn)
       : allow_released_opsets_only(allow_released_opsets_only),
@@ -200,6 +206,11 @@ class Model {
   // Get model's serialization proto data.
   ONNX_NAMESPACE::ModelProto ToProto() const;
 
+  // Get model's serialization proto data without inlining the data of initializers that is in memory. The proto
+  // references that memory, so it can only be loaded into another model while those initializers are alive, and it
+  // cannot be saved.
+  ONNX_NAMESPACE::ModelProto ToProtoWithInMemoryReferences();
+
   // Get model's serialization proto data.
   // Save initializer larger than the given threshold (in bytes) into an external binary file
   // with the given name. This function is useful to avoid hitting the size limit of protobuf files.
@@ -323,6 +334,15 @@ class Model {
   Model();
 
  private:
+#if !defined(ORT_MINIMAL_BUILD)
+  // Create the templates of the functions in model_proto_, creating their schemas in parallel on thread_pool.
+  void CreateModelLocalFunctionTemplates(const std::unordered_map<std::string, int>& domain_to_version,
+                                         const SchemaRegistryManager& schema_registry,
+                                         const logging::Logger& logger,
+                                         bool allow_released_opsets_only,
+                                         concurrency::ThreadPool* thread_pool);
+#endif
+
   // Model data.
 #if !defined(ORT_MINIMAL_BUILD)
   ONNX_NAMESPACE::ModelProto model_proto_;
@@ -84,6 +84,10 @@ Abstract:
 #define MLAS_SUPPORTS_GEMM_DOUBLE
 #endif
 
+#if (defined(__aarch64__) && defined(__linux__)) || defined(MLAS_TARGET_AMD64)
+#define MLAS_SUPPORTS_SBGEMM
+#endif
+
 #if (!defined(_MSC_VER)) || (_MSC_VER >= 1930)
 #if defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_ARM64EC)
 #if !defined(__APPLE__)
@@ -245,6 +249,214 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Supply one group of same-shaped problems to the grouped SGEMM
+ */
+struct MLAS_SGEMM_GROUP_PARAMS {
+    CBLAS_TRANSPOSE TransA = CblasNoTrans;        /**< Supplies the transpose operation for matrix A. */
+    CBLAS_TRANSPOSE TransB = CblasNoTrans;        /**< Supplies the transpose operation for matrix B. */
+    size_t M = 0;                                 /**< Supplies the number of rows of matrix A and matrix C. */
+    size_t N = 0;                                 /**< Supplies the number of columns of matrix B and matrix C. */
+    size_t K = 0;                                 /**< Supplies the shared dimension of matrix A and matrix B. */
+    const MLAS_SGEMM_DATA_PARAMS* Data = nullptr; /**< Supplies an array of BatchSize matrices data parameters. */
+    size_t BatchSize = 0;                         /**< Supplies the number of multiplications in this group. */
+};
+
+/**
+ * @brief  Grouped single precision matrix/matrix multiply operation (SGEMM)
+ *
+ *         Each group holds a batch of problems with the same shape, while the
+ *         shapes of different groups may differ. All problems of all groups are
+ *         split into tiles that are scheduled together over the thread pool, so
+ *         many small multiplications keep every thread busy instead of each one
+ *         sizing its own partition. When all problems of a group reference the
+ *         same unpacked matrix B, B is packed once and shared by the group.
+ *
+ * @param Groups     Supplies an array of group parameters.
+ * @param GroupCount Supplies the number of groups.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUP_PARAMS* Groups,
+    size_t GroupCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Segmented low-rank (LoRA) update with per-row adapter selection
+ *
+ *         Computes Y[m] += Scale * X[m] * LoraA[i] * LoraB[i] with i equal to
+ *         AdapterIndex[m], so the rows of one batch may use different adapters.
+ *         Consecutive rows with the same adapter form a segment, and segments
+ *         of the same adapter and row count share one packed copy of its
+ *         matrices. Rows with a negative adapter index are left unchanged.
+ *
+ * @param M            Supplies the number of rows of matrix X and matrix Y.
+ * @param N            Supplies the number of columns of matrix Y.
+ * @param K            Supplies the number of columns of matrix X.
+ * @param Rank         Supplies the rank of the adapters.
+ * @param X            Supplies the address of matrix X.
+ * @param ldx          Supplies the first dimension of matrix X.
+ * @param AdapterIndex Supplies the adapter index of each row.
+ * @param LoraA        Supplies the address of the K x Rank matrix of each adapter.
+ * @param LoraB        Supplies the address of the Rank x N matrix of each adapter.
+ * @param Scale        Supplies the scaling factor of the update.
+ * @param Y            Supplies the address of matrix Y.
+ * @param ldy          Supplies the first dimension of matrix Y.
+ * @param ThreadPool   Supplies the thread pool object to use, else nullptr if the
+                       base library threading support should be used.
+ */
+void
+MLASCALL
+MlasLoraSgmv(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t Rank,
+    const float* X,
+    size_t ldx,
+    const int32_t* AdapterIndex,
+    const float* const* LoraA,
+    const float* const* LoraB,
+    float Scale,
+    float* Y,
+    size_t ldy,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Define the formats of a sparse matrix B packed for the sparse SGEMM.
+ *
+ *        The packed columns of B are split into panels of 16 columns. The
+ *        block format stores only the 4 x 16 (K x N) blocks of a panel that
+ *        have a nonzero value. The 2:4 format stores, for each group of 4
+ *        consecutive rows of a column, the 2 values that may be nonzero and
+ *        their index within the group.
+ */
+enum MLAS_SPARSE_SGEMM_FORMAT {
+    MlasSparseSgemmFormatNone = 0,  /**< B is not sparse enough to benefit from the sparse SGEMM. */
+    MlasSparseSgemmFormatBlock = 1, /**< Block-sparse with 4 x 16 blocks. */
+    MlasSparseSgemmFormat2To4 = 2,  /**< 2:4 structured sparse along K. */
+};
+
+/**
+ * @brief  Select the sparse format to pack matrix B with
+ *
+ *         Returns MlasSparseSgemmFormatBlock if at most half of the 4 x 16
+ *         blocks of B have a nonzero value, else MlasSparseSgemmFormat2To4 if
+ *         every group of 4 rows of every column has at most 2 nonzero values,
+ *         else MlasSparseSgemmFormatNone.
+ *
+ * @param TransB  Supplies the transpose operation for matrix B.
+ * @param N       Supplies the number of columns of matrix B.
+ * @param K       Supplies the number of rows of matrix B.
+ * @param B       Supplies the address of matrix B.
+ * @param ldb     Supplies the first dimension of matrix B.
+ */
+MLAS_SPARSE_SGEMM_FORMAT
+MLASCALL
+MlasSparseSgemmSelectFormat(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+/**
+ * @brief  Return the size in bytes of matrix B packed in a sparse format
+ *
+ * @param Format  Supplies the sparse format, as returned by
+ *                MlasSparseSgemmSelectFormat.
+ * @param TransB  Supplies the transpose operation for matrix B.
+ * @param N       Supplies the number of columns of matrix B.
+ * @param K       Supplies the number of rows of matrix B.
+ * @param B       Supplies the address of matrix B.
+ * @param ldb     Supplies the first dimension of matrix B.
+ * @return        The size of the packed buffer, or 0 if B can not be packed in
+ *                the format.
+ */
+size_t
+MLASCALL
+MlasSparseSgemmPackBSize(
+    MLAS_SPARSE_SGEMM_FORMAT Format,
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+/**
+ * @brief  Pack matrix B in a sparse format
+ *
+ * @param Format   Supplies the sparse format.
+ * @param TransB   Supplies the transpose operation for matrix B.
+ * @param N        Supplies the number of columns of matrix B.
+ * @param K        Supplies the number of rows of matrix B.
+ * @param B        Supplies the address of matrix B.
+ * @param ldb      Supplies the first dimension of matrix B.
+ * @param PackedB  Supplies the address of the packed buffer, of the size
+ *                 returned by MlasSparseSgemmPackBSize.
+ */
+void
+MLASCALL
+MlasSparseSgemmPackB(
+    MLAS_SPARSE_SGEMM_FORMAT Format,
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Data parameters for the sparse SGEMM. Matrix B is shared by all the
+ *        problems of a batch.
+ */
+struct MLAS_SPARSE_SGEMM_DATA_PARAMS {
+    const float* A = nullptr; /**< Supplies the address of matrix A */
+    size_t lda = 0;           /**< Supplies the first dimension of matrix A. */
+    float* C = nullptr;       /**< Supplies the address of matrix C */
+    size_t ldc = 0;           /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
+    float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
+};
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply with a sparse matrix B
+ *
+ *         Computes C = alpha * A * B + beta * C for each problem of the batch,
+ *         where B was packed by MlasSparseSgemmPackB. Only the packed values of
+ *         B are read, so the work and the memory traffic of B shrink with its
+ *         sparsity.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+ *                   of rows of matrix B.
+ * @param PackedB    Supplies the address of the packed matrix B.
+ * @param Data       Supplies an array of matrices data parameters.
+ * @param BatchSize  Supplies the number of multiplications in this batch.
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSparseSgemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const void* PackedB,
+    const MLAS_SPARSE_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 /**
  * @brief  Single precision matrix/matrix multiply operation (SGEMM)
  *
@@ -892,6 +1104,75 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd convolution routines for 3x3 filters with unit stride and
+// dilation, computing F(2x2,3x3) or F(4x4,3x3) output tiles.
+//
+
+struct MLAS_CONV_WINOGRAD_PARAMETERS {
+    size_t TileSize;                    // 2 or 4, see MlasConvWinogradSelectTileSize
+    size_t BatchCount;
+    size_t GroupCount;
+    size_t InputChannels;               // per group
+    size_t FilterCount;                 // per group
+    size_t InputHeight;
+    size_t InputWidth;
+    size_t OutputHeight;
+    size_t OutputWidth;
+    size_t PaddingTop;
+    size_t PaddingLeft;
+    float Beta;
+    const MLAS_ACTIVATION* Activation;
+};
+
+size_t
+MLASCALL
+MlasConvWinogradSelectTileSize(
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t OutputHeight,
+    size_t OutputWidth
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    void* PackedFilter
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradGetWorkingBufferSize(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasConvWinograd(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1013,6 +1294,71 @@ MlasConvSymDepthwise(
     const MLAS_CONV_SYM_PARAMS& Params
     );
 
+//
+// Single precision NHWC convolution using an indirection buffer.
+//
+// Every output pixel has KernelSize pointers to the channels-last input pixels
+// that are sampled by the kernel, with padding pointing at a zero vector. The
+// patches are gathered through the pointers into a small per-call panel, so no
+// im2col buffer proportional to the output size is required.
+//
+
+struct MLAS_CONV_INDIRECT_PARAMS {
+    const float* InputDirect;           // pointwise: OutputCount rows of InputStride elements
+    const float* const* InputIndirection; // OutputCount x KernelSize pointers
+    size_t InputOffset;                 // channel offset of the group in every input pixel
+    size_t InputStride;                 // elements between rows of InputDirect
+    const void* PackedFilter;           // from MlasConvIndirectPackW, aligned as MlasGemmPackB
+    const float* Bias;                  // optional, OutputChannels values
+    float* Output;
+    size_t OutputStride;                // elements between output pixels
+    size_t InputChannels;               // channels per group
+    size_t OutputChannels;              // filters per group
+    size_t OutputCount;
+    size_t KernelSize;
+    float Beta;                         // scales the existing output before accumulation
+    const MLAS_ACTIVATION* Activation;
+};
+
+size_t
+MLASCALL
+MlasConvIndirectPackWSize(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize
+    );
+
+void
+MLASCALL
+MlasConvIndirectPackW(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize,
+    const float* Filter,
+    size_t ldf,
+    void* PackedFilter
+    );
+
+void
+MLASCALL
+MlasConvIndirect(
+    const MLAS_CONV_INDIRECT_PARAMS& Params
+    );
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    float Beta,
+    const MLAS_ACTIVATION* Activation
+    );
+
 //
 // Pooling routines.
 //
@@ -1865,9 +2211,11 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
+ *        On x86 this is true for AVX512-BF16 and also for AVX2, where
+ *        the bf16 dot products are emulated by widening to fp32.
  */
 bool MLASCALL
 MlasBf16AccelerationSupported();
@@ -2094,6 +2442,90 @@ MlasFlashAttention(
     MLAS_THREADPOOL* ThreadPool
 );
 
+//
+// Quantized key/value cache routines for attention.
+//
+// Each cached token stores HeadSize values quantized symmetrically in groups
+// of GroupSize values, with one float scale per group. A token row is
+// HeadSize bytes for 8-bit values (int8) or HeadSize / 2 bytes for 4-bit
+// values (two values per byte biased by 8, the even element in the low nibble).
+// GroupSize must be a multiple of 8 that divides HeadSize.
+//
+
+/**
+ * @brief Quantize rows of keys or values into the quantized cache format.
+ * @param Input        TokenCount x HeadSize values
+ * @param TokenCount   number of rows
+ * @param HeadSize     number of values per row
+ * @param GroupSize    number of values sharing a scale
+ * @param BitWidth     8 or 4
+ * @param Output       TokenCount quantized rows
+ * @param Scales       TokenCount x (HeadSize / GroupSize) scales
+*/
+void
+MLASCALL
+MlasQuantizeKvCache(
+    const float* Input,
+    size_t TokenCount,
+    size_t HeadSize,
+    size_t GroupSize,
+    size_t BitWidth,
+    void* Output,
+    float* Scales
+    );
+
+/**
+ * @brief Compute Scores[t] = Alpha * dot(Query, Key[t]) over a quantized key
+ *        cache, dequantizing the keys as they are read.
+ * @param Query        HeadSize values
+ * @param KeyCache     TokenCount quantized rows
+ * @param KeyScales    TokenCount x (HeadSize / GroupSize) scales
+ * @param TokenCount   number of cached tokens to score
+ * @param HeadSize     number of values per row
+ * @param GroupSize    number of values sharing a scale
+ * @param BitWidth     8 or 4
+ * @param Alpha        scale applied to each score
+ * @param Scores       TokenCount scores
+*/
+void
+MLASCALL
+MlasKvCacheQKDot(
+    const float* Query,
+    const void* KeyCache,
+    const float* KeyScales,
+    size_t TokenCount,
+    size_t HeadSize,
+    size_t GroupSize,
+    size_t BitWidth,
+    float Alpha,
+    float* Scores
+    );
+
+/**
+ * @brief Compute Output += sum(Probs[t] * Value[t]) over a quantized value
+ *        cache, dequantizing the values as they are read.
+ * @param Probs        TokenCount attention probabilities
+ * @param ValueCache   TokenCount quantized rows
+ * @param ValueScales  TokenCount x (HeadSize / GroupSize) scales
+ * @param TokenCount   number of cached tokens to accumulate
+ * @param HeadSize     number of values per row
+ * @param GroupSize    number of values sharing a scale
+ * @param BitWidth     8 or 4
+ * @param Output       HeadSize accumulators
+*/
+void
+MLASCALL
+MlasKvCachePVAccumulate(
+    const float* Probs,
+    const void* ValueCache,
+    const float* ValueScales,
+    size_t TokenCount,
+    size_t HeadSize,
+    size_t GroupSize,
+    size_t BitWidth,
+    float* Output
+    );
+
 #if defined(USE_KLEIDIAI) && !defined(_MSC_VER)
 /**
  * @brief Function to override the packing mechanism decision if kleidi ai is included
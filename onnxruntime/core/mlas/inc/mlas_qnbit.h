@@ -54,6 +54,9 @@ struct MLAS_QNBIT_GEMM_DATA_PARAMS {
 
     ///< optional post processing to apply to result matrix
     MLAS_GEMM_POSTPROCESSOR<T>* PostProcessor = nullptr;
+
+    ///< optional address of A already quantized by MlasQNBitGemmQuantizeA(), used instead of A
+    const void* QuantA = nullptr;
 };
 
 /**
@@ -82,6 +85,8 @@ struct MLAS_QNBIT_GEMM_DATA_PARAMS {
  * @param[in]       Workspace       Address of intermediate workspace buffer.
                                     If MlasQNBitGemmBatchWorkspaceSize() returns a non-zero value, this must be a
                                     buffer with at least that many bytes. Otherwise, it may be nullptr.
+                                    If MLAS_QNBIT_GEMM_DATA_PARAMS::QuantA is set for every batch, the workspace is
+                                    not used and may be nullptr.
  * @param[in]       ThreadPool      optional thread pool to use
  */
 template <typename T>
@@ -138,6 +143,61 @@ MlasQNBitGemmBatchWorkspaceSize(
     MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
 );
 
+/**
+ * @brief Gets the size in bytes of a buffer for matrix A quantized by MlasQNBitGemmQuantizeA(). This is the int8
+ * block quantized layout that MlasQNBitGemmBatch() would otherwise produce in its workspace, so that a producer of A
+ * (e.g., a normalization) can quantize each row while it is still in cache and skip the separate pass over A.
+ * If zero, the layout is not available for these parameters on the current platform and A must be passed as float.
+ *
+ * @param[in]   M               row size of matrix A
+ * @param[in]   K               column size of matrix A
+ * @param[in]   BlkBitWidth     quantized value bit width of B (e.g., 4 means 4 bit ints)
+ * @param[in]   BlkLen          number of quantized values per block
+ * @param[in]   HasZeroPoint    whether zero points of B are provided
+ * @param[in]   ComputeType     GEMM compute type, only SQNBIT_CompInt8 is supported
+ */
+size_t MLASCALL
+MlasQNBitGemmQuantizedASize(
+    size_t M,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    bool HasZeroPoint,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
+);
+
+/**
+ * @brief Quantizes a range of rows of float32 matrix A to the layout of MlasQNBitGemmQuantizedASize(). The result
+ * may be passed to MlasQNBitGemmBatch() with MLAS_QNBIT_GEMM_DATA_PARAMS::QuantA. The ranges of rows may be
+ * quantized in any order and concurrently.
+ *
+ * @param[in]   M               row size of matrix A
+ * @param[in]   K               column size of matrix A
+ * @param[in]   BlkBitWidth     quantized value bit width of B (e.g., 4 means 4 bit ints)
+ * @param[in]   BlkLen          number of quantized values per block
+ * @param[in]   HasZeroPoint    whether zero points of B are provided
+ * @param[in]   ComputeType     GEMM compute type, only SQNBIT_CompInt8 is supported
+ * @param[in]   A               address of the first row of the range of matrix A
+ * @param[in]   lda             leading dimension of A
+ * @param[in]   RangeStartM     index of the first row of the range
+ * @param[in]   RangeCountM     number of rows of the range
+ * @param[out]  QuantA          buffer of at least MlasQNBitGemmQuantizedASize() bytes for the whole of matrix A
+ */
+void MLASCALL
+MlasQNBitGemmQuantizeA(
+    size_t M,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    bool HasZeroPoint,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType,
+    const float* A,
+    size_t lda,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    void* QuantA
+);
+
 /**
  * @brief Gets the size in bytes of the packed quantized B data.
  * If non-zero, the quantized B data must first be packed by calling MlasQNBitGemmPackQuantBData() with a buffer of
@@ -0,0 +1,331 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    kv_cache_quant.cpp
+
+Abstract:
+
+    This module implements the routines for an attention key/value cache
+    stored as symmetrically quantized 8-bit or 4-bit values.
+
+    The cache is dequantized on the fly: each group of GroupSize values is
+    expanded to single precision in registers, multiplied against the query
+    or accumulated into the output, and scaled once per group. A decode step
+    then reads one byte (8-bit) or half a byte (4-bit) per cached value
+    instead of two (float16) or four (float).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of values expanded from the cache at a time. Group sizes
+// are required to be a multiple of this count.
+//
+
+#define MLAS_KV_CACHE_UNPACK_COUNT              8
+
+MLAS_FORCEINLINE
+void
+MlasKvCacheUnpack(
+    const uint8_t* Row,
+    size_t Index,
+    size_t BitWidth,
+    float* Values
+    )
+/*++
+
+Routine Description:
+
+    This routine expands MLAS_KV_CACHE_UNPACK_COUNT quantized values of a
+    cache row to single precision, without applying the group scale.
+
+Arguments:
+
+    Row - Supplies the quantized cache row.
+
+    Index - Supplies the index of the first value to expand.
+
+    BitWidth - Supplies the number of bits per quantized value.
+
+    Values - Receives the expanded values.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BitWidth == 8) {
+
+        const int8_t* Input = reinterpret_cast<const int8_t*>(Row) + Index;
+
+        for (size_t i = 0; i < MLAS_KV_CACHE_UNPACK_COUNT; i++) {
+            Values[i] = float(Input[i]);
+        }
+
+    } else {
+
+        const uint8_t* Input = Row + Index / 2;
+
+        for (size_t i = 0; i < MLAS_KV_CACHE_UNPACK_COUNT / 2; i++) {
+            Values[i * 2 + 0] = float(int32_t(Input[i] & 0x0F) - 8);
+            Values[i * 2 + 1] = float(int32_t(Input[i] >> 4) - 8);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQuantizeKvCache(
+    const float* Input,
+    size_t TokenCount,
+    size_t HeadSize,
+    size_t GroupSize,
+    size_t BitWidth,
+    void* Output,
+    float* Scales
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes rows of keys or values to the quantized cache
+    format. Each group of GroupSize values is scaled so that its maximum
+    absolute value maps to the largest quantized magnitude.
+
+Arguments:
+
+    Input - Supplies the TokenCount x HeadSize values to quantize.
+
+    TokenCount - Supplies the number of rows.
+
+    HeadSize - Supplies the number of values per row.
+
+    GroupSize - Supplies the number of values sharing a scale.
+
+    BitWidth - Supplies the number of bits per quantized value (8 or 4).
+
+    Output - Receives the quantized rows.
+
+    Scales - Receives the TokenCount x (HeadSize / GroupSize) scales.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowBytes = (BitWidth == 8) ? HeadSize : HeadSize / 2;
+    const float MaximumValue = (BitWidth == 8) ? 127.0f : 7.0f;
+
+    uint8_t* OutputRow = static_cast<uint8_t*>(Output);
+
+    for (size_t t = 0; t < TokenCount; t++) {
+
+        for (size_t g = 0; g < HeadSize; g += GroupSize) {
+
+            const float* Group = Input + g;
+
+            float MaximumAbsolute = 0.0f;
+
+            for (size_t i = 0; i < GroupSize; i++) {
+                MaximumAbsolute = std::max(MaximumAbsolute, std::fabs(Group[i]));
+            }
+
+            const float Scale = MaximumAbsolute / MaximumValue;
+            const float InverseScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+
+            *Scales++ = Scale;
+
+            if (BitWidth == 8) {
+
+                int8_t* Quantized = reinterpret_cast<int8_t*>(OutputRow) + g;
+
+                for (size_t i = 0; i < GroupSize; i++) {
+                    float Value = std::nearbyintf(Group[i] * InverseScale);
+                    Value = std::min(std::max(Value, -MaximumValue), MaximumValue);
+                    Quantized[i] = int8_t(Value);
+                }
+
+            } else {
+
+                uint8_t* Quantized = OutputRow + g / 2;
+
+                for (size_t i = 0; i < GroupSize; i += 2) {
+                    float Value0 = std::nearbyintf(Group[i + 0] * InverseScale);
+                    float Value1 = std::nearbyintf(Group[i + 1] * InverseScale);
+                    Value0 = std::min(std::max(Value0, -MaximumValue), MaximumValue);
+                    Value1 = std::min(std::max(Value1, -MaximumValue), MaximumValue);
+                    Quantized[i / 2] = uint8_t((int32_t(Value0) + 8) | ((int32_t(Value1) + 8) << 4));
+                }
+            }
+        }
+
+        Input += HeadSize;
+        OutputRow += RowBytes;
+    }
+}
+
+void
+MLASCALL
+MlasKvCacheQKDot(
+    const float* Query,
+    const void* KeyCache,
+    const float* KeyScales,
+    size_t TokenCount,
+    size_t HeadSize,
+    size_t GroupSize,
+    size_t BitWidth,
+    float Alpha,
+    float* Scores
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the scaled dot products of a query row against the
+    rows of a quantized key cache.
+
+Arguments:
+
+    Query - Supplies the HeadSize query values.
+
+    KeyCache - Supplies the quantized key rows.
+
+    KeyScales - Supplies the TokenCount x (HeadSize / GroupSize) key scales.
+
+    TokenCount - Supplies the number of key rows.
+
+    HeadSize - Supplies the number of values per row.
+
+    GroupSize - Supplies the number of values sharing a scale.
+
+    BitWidth - Supplies the number of bits per quantized value (8 or 4).
+
+    Alpha - Supplies the scale applied to each dot product.
+
+    Scores - Receives the TokenCount scores.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowBytes = (BitWidth == 8) ? HeadSize : HeadSize / 2;
+    const uint8_t* KeyRow = static_cast<const uint8_t*>(KeyCache);
+
+    MLAS_DECLSPEC_ALIGN(float Values[MLAS_KV_CACHE_UNPACK_COUNT], 16);
+
+    for (size_t t = 0; t < TokenCount; t++) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+        for (size_t g = 0; g < HeadSize; g += GroupSize) {
+
+            MLAS_FLOAT32X4 GroupAccumulator = MlasZeroFloat32x4();
+
+            for (size_t i = g; i < g + GroupSize; i += MLAS_KV_CACHE_UNPACK_COUNT) {
+
+                MlasKvCacheUnpack(KeyRow, i, BitWidth, Values);
+
+                GroupAccumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Query + i),
+                    MlasLoadFloat32x4(Values), GroupAccumulator);
+                GroupAccumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Query + i + 4),
+                    MlasLoadFloat32x4(Values + 4), GroupAccumulator);
+            }
+
+            Accumulator = MlasMultiplyAddFloat32x4(GroupAccumulator, *KeyScales++, Accumulator);
+        }
+
+        Scores[t] = Alpha * MlasReduceAddFloat32x4(Accumulator);
+
+        KeyRow += RowBytes;
+    }
+}
+
+void
+MLASCALL
+MlasKvCachePVAccumulate(
+    const float* Probs,
+    const void* ValueCache,
+    const float* ValueScales,
+    size_t TokenCount,
+    size_t HeadSize,
+    size_t GroupSize,
+    size_t BitWidth,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the rows of a quantized value cache weighted by
+    the attention probabilities.
+
+Arguments:
+
+    Probs - Supplies the TokenCount attention probabilities.
+
+    ValueCache - Supplies the quantized value rows.
+
+    ValueScales - Supplies the TokenCount x (HeadSize / GroupSize) value
+        scales.
+
+    TokenCount - Supplies the number of value rows.
+
+    HeadSize - Supplies the number of values per row.
+
+    GroupSize - Supplies the number of values sharing a scale.
+
+    BitWidth - Supplies the number of bits per quantized value (8 or 4).
+
+    Output - Supplies the HeadSize accumulators, updated with the weighted
+        sum of the value rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowBytes = (BitWidth == 8) ? HeadSize : HeadSize / 2;
+    const size_t GroupCount = HeadSize / GroupSize;
+    const uint8_t* ValueRow = static_cast<const uint8_t*>(ValueCache);
+
+    MLAS_DECLSPEC_ALIGN(float Values[MLAS_KV_CACHE_UNPACK_COUNT], 16);
+
+    for (size_t t = 0; t < TokenCount; t++) {
+
+        //
+        // Skip the tokens that are masked out by a causal or local window.
+        //
+
+        if (Probs[t] != 0.0f) {
+
+            for (size_t g = 0; g < GroupCount; g++) {
+
+                const MLAS_FLOAT32X4 Factor = MlasBroadcastFloat32x4(Probs[t] * ValueScales[g]);
+
+                for (size_t i = g * GroupSize; i < (g + 1) * GroupSize; i += MLAS_KV_CACHE_UNPACK_COUNT) {
+
+                    MlasKvCacheUnpack(ValueRow, i, BitWidth, Values);
+
+                    MlasStoreFloat32x4(Output + i, MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Values),
+                        Factor, MlasLoadFloat32x4(Output + i)));
+                    MlasStoreFloat32x4(Output + i + 4, MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Values + 4),
+                        Factor, MlasLoadFloat32x4(Output + i + 4)));
+                }
+            }
+        }
+
+        ValueScales += GroupCount;
+        ValueRow += RowBytes;
+    }
+}
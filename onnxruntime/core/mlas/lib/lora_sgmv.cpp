@@ -0,0 +1,198 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    lora_sgmv.cpp
+
+Abstract:
+
+    This module implements the segmented low-rank (LoRA) update used to serve
+    several adapters from one batch.
+
+    The rows of the batch are split into segments of consecutive rows that use
+    the same adapter. Each segment is projected to the adapter rank by its
+    LoraA matrix (shrink) and back to the output width by its LoraB matrix
+    (expand). The segments of both steps are computed by the grouped SGEMM, so
+    a batch with many small segments runs as two parallel sections, and the
+    segments of one adapter with the same row count share one packed copy of
+    the adapter matrices.
+
+--*/
+
+#include "mlasi.h"
+
+#include <algorithm>
+#include <vector>
+
+//
+// Define a segment of consecutive rows that use the same adapter.
+//
+
+struct MLAS_LORA_SGMV_SEGMENT {
+    size_t StartM;
+    size_t CountM;
+    size_t Adapter;
+};
+
+void
+MLASCALL
+MlasLoraSgmv(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t Rank,
+    const float* X,
+    size_t ldx,
+    const int32_t* AdapterIndex,
+    const float* const* LoraA,
+    const float* const* LoraB,
+    float Scale,
+    float* Y,
+    size_t ldy,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine adds Scale * X[m] * LoraA[i] * LoraB[i] to each row m of Y,
+    where i is the adapter index of the row.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix X and matrix Y.
+
+    N - Supplies the number of columns of matrix Y.
+
+    K - Supplies the number of columns of matrix X.
+
+    Rank - Supplies the rank of the adapters.
+
+    X - Supplies the address of matrix X.
+
+    ldx - Supplies the first dimension of matrix X.
+
+    AdapterIndex - Supplies the adapter index of each row. Rows with a
+        negative index are not updated.
+
+    LoraA - Supplies the address of the K x Rank matrix of each adapter.
+
+    LoraB - Supplies the address of the Rank x N matrix of each adapter.
+
+    Scale - Supplies the scaling factor of the update.
+
+    Y - Supplies the address of matrix Y.
+
+    ldy - Supplies the first dimension of matrix Y.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || K == 0 || Rank == 0) {
+        return;
+    }
+
+    //
+    // Split the rows into segments of consecutive rows with the same adapter.
+    //
+
+    std::vector<MLAS_LORA_SGMV_SEGMENT> Segments;
+
+    for (size_t m = 0; m < M;) {
+
+        const int32_t Adapter = AdapterIndex[m];
+        size_t CountM = 1;
+
+        while (m + CountM < M && AdapterIndex[m + CountM] == Adapter) {
+            CountM++;
+        }
+
+        if (Adapter >= 0) {
+            Segments.push_back({m, CountM, size_t(Adapter)});
+        }
+
+        m += CountM;
+    }
+
+    if (Segments.empty()) {
+        return;
+    }
+
+    //
+    // Order the segments so that segments of the same adapter and row count
+    // are adjacent and can be computed as one group.
+    //
+
+    std::stable_sort(Segments.begin(), Segments.end(),
+        [](const MLAS_LORA_SGMV_SEGMENT& a, const MLAS_LORA_SGMV_SEGMENT& b) {
+            return (a.Adapter != b.Adapter) ? (a.Adapter < b.Adapter) : (a.CountM < b.CountM);
+        });
+
+    //
+    // The low rank intermediate of each row is stored at the row's offset.
+    //
+
+    std::vector<float> Intermediate(M * Rank);
+
+    std::vector<MLAS_SGEMM_DATA_PARAMS> ShrinkData(Segments.size());
+    std::vector<MLAS_SGEMM_DATA_PARAMS> ExpandData(Segments.size());
+    std::vector<MLAS_SGEMM_GROUP_PARAMS> ShrinkGroups;
+    std::vector<MLAS_SGEMM_GROUP_PARAMS> ExpandGroups;
+
+    for (size_t s = 0; s < Segments.size(); s++) {
+
+        const MLAS_LORA_SGMV_SEGMENT& Segment = Segments[s];
+        float* T = Intermediate.data() + Segment.StartM * Rank;
+
+        ShrinkData[s].A = X + Segment.StartM * ldx;
+        ShrinkData[s].lda = ldx;
+        ShrinkData[s].B = LoraA[Segment.Adapter];
+        ShrinkData[s].ldb = Rank;
+        ShrinkData[s].C = T;
+        ShrinkData[s].ldc = Rank;
+
+        ExpandData[s].A = T;
+        ExpandData[s].lda = Rank;
+        ExpandData[s].B = LoraB[Segment.Adapter];
+        ExpandData[s].ldb = N;
+        ExpandData[s].C = Y + Segment.StartM * ldy;
+        ExpandData[s].ldc = ldy;
+        ExpandData[s].alpha = Scale;
+        ExpandData[s].beta = 1.0f;
+
+        if (s > 0 && Segments[s - 1].Adapter == Segment.Adapter && Segments[s - 1].CountM == Segment.CountM) {
+            ShrinkGroups.back().BatchSize++;
+            ExpandGroups.back().BatchSize++;
+            continue;
+        }
+
+        MLAS_SGEMM_GROUP_PARAMS Shrink;
+        Shrink.M = Segment.CountM;
+        Shrink.N = Rank;
+        Shrink.K = K;
+        Shrink.Data = &ShrinkData[s];
+        Shrink.BatchSize = 1;
+        ShrinkGroups.push_back(Shrink);
+
+        MLAS_SGEMM_GROUP_PARAMS Expand;
+        Expand.M = Segment.CountM;
+        Expand.N = N;
+        Expand.K = Rank;
+        Expand.Data = &ExpandData[s];
+        Expand.BatchSize = 1;
+        ExpandGroups.push_back(Expand);
+    }
+
+    MlasGemmGrouped(ShrinkGroups.data(), ShrinkGroups.size(), ThreadPool);
+    MlasGemmGrouped(ExpandGroups.data(), ExpandGroups.size(), ThreadPool);
+}
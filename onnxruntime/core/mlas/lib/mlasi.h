@@ -378,6 +378,30 @@ size_t
     bool ZeroMode
     );
 
+#if defined(MLAS_TARGET_AMD64)
+//
+// x86 has no native bfloat16 type, so bfloat16 values are handled as their
+// raw 16-bit encoding.
+//
+
+typedef uint16_t bfloat16_t;
+
+typedef
+size_t
+(MLASCALL MLAS_SBGEMM_FLOAT_KERNEL)(
+    const float* A,
+    const bfloat16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+    );
+#endif
+
 #ifdef FORCE_GENERIC_ALGORITHMS
 typedef
 size_t
@@ -911,6 +935,8 @@ extern "C" {
     MLAS_GEMM_DOUBLE_KERNEL MlasGemmDoubleKernelAvx;
     MLAS_GEMM_DOUBLE_KERNEL MlasGemmDoubleKernelFma3;
     MLAS_GEMM_DOUBLE_KERNEL MlasGemmDoubleKernelAvx512F;
+    MLAS_SBGEMM_FLOAT_KERNEL MlasSbgemmKernelAvx2;
+    MLAS_SBGEMM_FLOAT_KERNEL MlasSbgemmKernelAvx512Bf16;
 #endif
 #elif defined(MLAS_TARGET_POWER)
     MLAS_GEMM_FLOAT_KERNEL MlasSgemmKernel;
@@ -1099,7 +1125,7 @@ extern "C" {
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 #define MLAS_HGEMM_THREAD_COMPLEXITY                65536
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
 #define MLAS_SBGEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
 #endif
 
@@ -1124,6 +1150,32 @@ MlasSgemmOperation(
     size_t ldc
     );
 
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
+void
+MlasSgemmCopyPackB(
+    float* D,
+    const float* B,
+    size_t ldb,
+    size_t CountX,
+    size_t CountY
+    );
+
 //
 // Quantized integer matrix/matrix dispatch structure.
 //
@@ -1224,6 +1276,22 @@ extern const MLAS_ROPE_DISPATCH MlasRopeDispatchAvx2;
 struct MLAS_HGEMM_DISPATCH;
 extern const MLAS_HGEMM_DISPATCH MlasHGemmDispatchNeon;
 
+//
+// bfloat16 gemm dispatch structure
+//
+struct MLAS_SBGEMM_DISPATCH;
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx2;
+#if defined(MLAS_AVX512BF16_SUPPORTED)
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+#endif
+
+//
+// sparse sgemm dispatch structure
+//
+struct MLAS_SPARSE_SGEMM_DISPATCH;
+extern const MLAS_SPARSE_SGEMM_DISPATCH MlasSparseSgemmDispatchAvx2;
+extern const MLAS_SPARSE_SGEMM_DISPATCH MlasSparseSgemmDispatchAvx512;
+
 // softmax dispatch structure
 struct MLAS_SOFTMAX_DISPATCH;
 extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchNeon;
@@ -1406,6 +1474,10 @@ struct MLAS_PLATFORM {
 
     const MLAS_ROPE_DISPATCH* RopeDispatch{nullptr};
     const MLAS_HGEMM_DISPATCH* HGemmDispatch{nullptr};
+#if defined(MLAS_TARGET_AMD64)
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{nullptr};
+#endif
+    const MLAS_SPARSE_SGEMM_DISPATCH* SparseSgemmDispatch{nullptr};
     const MLAS_SOFTMAX_DISPATCH* SoftmaxDispatch{nullptr};
     const MLAS_ELTWISE_DISPATCH* EltwiseDispatch{nullptr};
 };
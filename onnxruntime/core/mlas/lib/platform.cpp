@@ -410,6 +410,8 @@ Return Value:
                 this->CastF16ToF32Kernel = &MlasCastF16ToF32KernelAvx2;
                 this->CastF32ToF16Kernel = &MlasCastF32ToF16KernelAvx2;
                 this->RopeDispatch = &MlasRopeDispatchAvx2;
+                this->SBGemmDispatch = &MlasSBGemmDispatchAvx2;
+                this->SparseSgemmDispatch = &MlasSparseSgemmDispatchAvx2;
 
 
                 //
@@ -481,6 +483,7 @@ Return Value:
                         this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Core;
                         this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchAvx512;
                         this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512;
+                        this->SparseSgemmDispatch = &MlasSparseSgemmDispatchAvx512;
 
                         //
                         // Check if the processor supports AVX512VNNI.
@@ -495,6 +498,17 @@ Return Value:
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                             this->QNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
                         }
+
+#if defined(MLAS_AVX512BF16_SUPPORTED)
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
+#endif  // defined(MLAS_AVX512BF16_SUPPORTED)
                     }
                 }
 
@@ -33,6 +33,10 @@ enum QNBitGemmVariant {
     HQ4BitGemmVariant_CompFp16,
     HQ4BitGemmVariant_CompInt8,
     SQ8BitGemmVariant_CompInt8,
+    SQ2BitGemmVariant_CompFp32,
+    SQ2BitGemmVariant_CompInt8,
+    SQ3BitGemmVariant_CompFp32,
+    SQ3BitGemmVariant_CompInt8,
 
     // End of valid variants
 
@@ -63,12 +67,35 @@ GetQNBitGemmVariant(
             if (ComputeType == SQNBIT_CompInt8) {
                 return SQ8BitGemmVariant_CompInt8;
             }
+        } else if (BlkBitWidth == 2) {
+            if (ComputeType == SQNBIT_CompFp32) {
+                return SQ2BitGemmVariant_CompFp32;
+            } else if (ComputeType == SQNBIT_CompInt8) {
+                return SQ2BitGemmVariant_CompInt8;
+            }
+        } else if (BlkBitWidth == 3) {
+            if (ComputeType == SQNBIT_CompFp32) {
+                return SQ3BitGemmVariant_CompFp32;
+            } else if (ComputeType == SQNBIT_CompInt8) {
+                return SQ3BitGemmVariant_CompInt8;
+            }
         }
     }
 
     return SQNBitGemmVariantInvalid;
 }
 
+//
+// The 2-bit and 3-bit variants are implemented with the portable MLAS vector
+// types and do not depend on the platform QNBitGemmDispatch.
+//
+bool
+IsQLowBitGemmVariant(QNBitGemmVariant Variant)
+{
+    return Variant == SQ2BitGemmVariant_CompFp32 || Variant == SQ2BitGemmVariant_CompInt8 ||
+           Variant == SQ3BitGemmVariant_CompFp32 || Variant == SQ3BitGemmVariant_CompInt8;
+}
+
 }  // namespace
 
 bool MLASCALL
@@ -78,13 +105,17 @@ MlasIsQNBitGemmAvailable(
     MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
 )
 {
+    const auto Variant = GetQNBitGemmVariant(BlkBitWidth, BlkLen, ComputeType);
+
+    if (IsQLowBitGemmVariant(Variant)) {
+        return true;
+    }
+
     const auto* Dispatch = GetMlasPlatform().QNBitGemmDispatch;
     if (Dispatch == nullptr) {
         return false;
     }
 
-    const auto Variant = GetQNBitGemmVariant(BlkBitWidth, BlkLen, ComputeType);
-
     switch (Variant) {
         case SQ4BitGemmVariant_CompFp32: {
             return Dispatch->SQ4BitGemmM1Kernel_CompFp32 != nullptr &&
@@ -126,6 +157,10 @@ QNBitGemmPerGemmWorkspaceSize(
     MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
 )
 {
+    if (IsQLowBitGemmVariant(GetQNBitGemmVariant(BlkBitWidth, BlkLen, ComputeType))) {
+        return SQLowBitGemmPerGemmWorkspaceSize(M, K, BlkLen, ComputeType);
+    }
+
     const auto* Dispatch = GetMlasPlatform().QNBitGemmDispatch;
     if (Dispatch == nullptr || Dispatch->QNBitGemmPerGemmWorkspaceSize == nullptr) {
         return 0;
@@ -145,6 +180,10 @@ QNBitGemmPerGemmWorkspaceAlignment(
     MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
 )
 {
+    if (IsQLowBitGemmVariant(GetQNBitGemmVariant(BlkBitWidth, BlkLen, ComputeType))) {
+        return sizeof(float);
+    }
+
     const auto* Dispatch = GetMlasPlatform().QNBitGemmDispatch;
     if (Dispatch == nullptr || Dispatch->QNBitGemmPerGemmWorkspaceAlignment == nullptr) {
         return 1;
@@ -173,6 +212,21 @@ QNBitGemmPerGemmWorkspaceStride(
     return MlasDivRoundup(Size, Alignment) * Alignment;
 }
 
+void*
+AlignQNBitGemmWorkspace(
+    void* Workspace,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
+)
+{
+    const size_t Alignment = QNBitGemmPerGemmWorkspaceAlignment(BlkBitWidth, BlkLen, ComputeType);
+    const uintptr_t WorkspaceAddress = reinterpret_cast<uintptr_t>(Workspace);
+    return reinterpret_cast<void*>(
+        (WorkspaceAddress + Alignment - 1) & (~(Alignment - 1))
+    );
+}
+
 }  // namespace
 
 size_t MLASCALL
@@ -210,6 +264,10 @@ MlasQNBitGemmPackQuantBDataSize(
     MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
 )
 {
+    if (IsQLowBitGemmVariant(GetQNBitGemmVariant(BlkBitWidth, BlkLen, ComputeType))) {
+        return SQLowBitGemmPackQuantBDataSize(N, K, BlkBitWidth, BlkLen);
+    }
+
     const auto* Dispatch = GetMlasPlatform().QNBitGemmDispatch;
     if (Dispatch == nullptr) {
         return 0;
@@ -258,6 +316,25 @@ MlasQNBitGemmPackQuantBData(
     MLAS_THREADPOOL* ThreadPool
 )
 {
+    if (IsQLowBitGemmVariant(GetQNBitGemmVariant(BlkBitWidth, BlkLen, ComputeType))) {
+        //
+        // Scales and zero points are read unpacked at compute time, so only
+        // the call that supplies the quantized data packs anything.
+        //
+        if (QuantBData != nullptr) {
+            SQLowBitGemmPackQuantBData(
+                N,
+                K,
+                BlkBitWidth,
+                BlkLen,
+                static_cast<const std::byte*>(QuantBData),
+                static_cast<std::byte*>(PackedQuantBDataAndOrBlkSumWorkspace),
+                ThreadPool
+            );
+        }
+        return;
+    }
+
     const auto* Dispatch = GetMlasPlatform().QNBitGemmDispatch;
     if (Dispatch == nullptr) {
         return;
@@ -787,6 +864,52 @@ SQ8BitGemm_CompInt8(
     }
 }
 
+//
+// Quantizes the rows [RangeStartM, RangeStartM + RangeCountM) of A to the int8 blocks that the CompInt8 kernels read
+// when A is not packed as a whole. A points to the first row of the range.
+//
+void
+QuantizeARows_CompInt8(
+    size_t BlkLen,
+    size_t M,
+    size_t K,
+    const float* A,
+    size_t lda,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    void* PerGemmWorkspace
+)
+{
+    const auto QuantizeARow = GetMlasPlatform().QNBitGemmDispatch->QuantizeARow_CompInt8;
+    const auto QuantizeARow2 = GetMlasPlatform().QNBitGemmDispatch->QuantizeARowComputeBlkSum_CompInt8;
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const float* ARowPtr = A;
+
+    if (QuantizeARow) {
+        const size_t QuantAStride = BlockCountK * Q8BlkSize(BlkLen);
+        std::byte* QuantARowPtr = static_cast<std::byte*>(PerGemmWorkspace) + RangeStartM * QuantAStride;
+        for (size_t m = 0; m < RangeCountM; ++m) {
+            QuantizeARow(BlkLen, ARowPtr, K, QuantARowPtr);
+
+            ARowPtr += lda;
+            QuantARowPtr += QuantAStride;
+        }
+    } else {
+        PerGemmQuantAWorkspace quant_a_data(PerGemmWorkspace, M, BlockCountK, BlkLen);
+        std::byte* QuantARowPtr = quant_a_data.QuantData + RangeStartM * BlockCountK * BlkLen;
+        float* QuantARowScalePtr = quant_a_data.QuantScale + RangeStartM * BlockCountK;
+        float* QuantARowBlkSum = quant_a_data.BlockSum + RangeStartM * BlockCountK;
+        for (size_t m = 0; m < RangeCountM; ++m) {
+            QuantizeARow2(BlkLen, ARowPtr, K, QuantARowPtr, QuantARowScalePtr, QuantARowBlkSum);
+            ARowPtr += lda;
+            QuantARowPtr += BlockCountK * BlkLen;
+            QuantARowScalePtr += BlockCountK;
+            QuantARowBlkSum += BlockCountK;
+        }
+    }
+}
+
 template <typename T>
 void
 InitializeWorkspace_CompInt8(
@@ -819,11 +942,6 @@ InitializeWorkspace_CompInt8<float>(
 
     const auto UsePacked = GetMlasPlatform().QNBitGemmDispatch->UsePacked_CompInt8;
     const auto QuantizeA_Packed = GetMlasPlatform().QNBitGemmDispatch->QuantizeA_Packed_CompInt8;
-    const auto QuantizeARow = GetMlasPlatform().QNBitGemmDispatch->QuantizeARow_CompInt8;
-    const auto QuantizeARow2 = GetMlasPlatform().QNBitGemmDispatch->QuantizeARowComputeBlkSum_CompInt8;
-
-    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
-    const size_t QuantAStride = BlockCountK * Q8BlkSize(BlkLen);
 
     // TODO: try parallel on BatchN * M threads because BatchN is usually 1.
     if (UsePacked && QuantizeA_Packed && UsePacked(K, BlkLen, DataParams->QuantBZeroPoint)) {
@@ -834,36 +952,12 @@ InitializeWorkspace_CompInt8<float>(
             std::byte* QuantARowPtr = static_cast<std::byte*>(Workspace) + gemm_idx * PerGemmWorkspaceStride;
             QuantizeA_Packed(BlkLen, ARowPtr, M, K, QuantARowPtr);
         });
-    } else if (QuantizeARow) {
-        MlasTrySimpleParallel(ThreadPool, BatchN, [&](ptrdiff_t gemm_idx) {
-            const auto& data = DataParams[gemm_idx];
-
-            const float* ARowPtr = data.A;
-            std::byte* QuantARowPtr = static_cast<std::byte*>(Workspace) + gemm_idx * PerGemmWorkspaceStride;
-            for (size_t m = 0; m < M; ++m) {
-                QuantizeARow(BlkLen, ARowPtr, K, QuantARowPtr);
-
-                ARowPtr += data.lda;
-                QuantARowPtr += QuantAStride;
-            }
-        });
     } else {
         MlasTrySimpleParallel(ThreadPool, BatchN, [&](ptrdiff_t gemm_idx) {
             const auto& data = DataParams[gemm_idx];
-            const float* ARowPtr = data.A;
 
             void* PerGemmWorkspace = static_cast<std::byte*>(Workspace) + gemm_idx * PerGemmWorkspaceStride;
-            PerGemmQuantAWorkspace quant_a_data(PerGemmWorkspace, M, BlockCountK, BlkLen);
-            std::byte* QuantARowPtr = quant_a_data.QuantData;
-            float* QuantARowScalePtr = quant_a_data.QuantScale;
-            float* QuantARowBlkSum = quant_a_data.BlockSum;
-            for (size_t m = 0; m < M; ++m) {
-                QuantizeARow2(BlkLen, ARowPtr, K, QuantARowPtr, QuantARowScalePtr, QuantARowBlkSum);
-                ARowPtr += data.lda;
-                QuantARowPtr += BlockCountK * BlkLen;
-                QuantARowScalePtr += BlockCountK;
-                QuantARowBlkSum += BlockCountK;
-            }
+            QuantizeARows_CompInt8(BlkLen, M, K, data.A, data.lda, 0, M, PerGemmWorkspace);
         });
     }
 }
@@ -917,6 +1011,9 @@ GetInitializeWorkspace(QNBitGemmVariant variant)
         case SQ4BitGemmVariant_CompInt8:
         case SQ8BitGemmVariant_CompInt8:
             return InitializeWorkspace_CompInt8<float>;
+        case SQ2BitGemmVariant_CompInt8:
+        case SQ3BitGemmVariant_CompInt8:
+            return SQLowBitGemmInitializeWorkspace_CompInt8;
         default:
             return nullptr;
     }
@@ -961,6 +1058,14 @@ GetQNBitGemm(QNBitGemmVariant variant)
             return SQ4BitGemm_CompInt8;
         case SQ8BitGemmVariant_CompInt8:
             return SQ8BitGemm_CompInt8;
+        case SQ2BitGemmVariant_CompFp32:
+            return SQLowBitGemm_CompFp32<2>;
+        case SQ2BitGemmVariant_CompInt8:
+            return SQLowBitGemm_CompInt8<2>;
+        case SQ3BitGemmVariant_CompFp32:
+            return SQLowBitGemm_CompFp32<3>;
+        case SQ3BitGemmVariant_CompInt8:
+            return SQLowBitGemm_CompInt8<3>;
         default:
             return nullptr;
     }
@@ -979,6 +1084,68 @@ GetQNBitGemm(QNBitGemmVariant variant)
 }
 }  // namespace
 
+size_t MLASCALL
+MlasQNBitGemmQuantizedASize(
+    size_t M,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    bool HasZeroPoint,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
+)
+{
+    const auto Variant = GetQNBitGemmVariant(BlkBitWidth, BlkLen, ComputeType);
+    if (Variant != SQ4BitGemmVariant_CompInt8 && Variant != SQ8BitGemmVariant_CompInt8) {
+        return 0;
+    }
+
+    if (!MlasIsQNBitGemmAvailable(BlkBitWidth, BlkLen, ComputeType)) {
+        return 0;
+    }
+
+    //
+    // A packed as a whole matrix cannot be quantized a range of rows at a time.
+    //
+    const auto* Dispatch = GetMlasPlatform().QNBitGemmDispatch;
+    if (Dispatch->UsePacked_CompInt8 != nullptr && Dispatch->QuantizeA_Packed_CompInt8 != nullptr &&
+        Dispatch->UsePacked_CompInt8(K, BlkLen, HasZeroPoint)) {
+        return 0;
+    }
+
+    if (Dispatch->QuantizeARow_CompInt8 == nullptr && Dispatch->QuantizeARowComputeBlkSum_CompInt8 == nullptr) {
+        return 0;
+    }
+
+    //
+    // The layout is the per GEMM workspace of MlasQNBitGemmBatch(), which does not depend on N.
+    //
+    return MlasQNBitGemmBatchWorkspaceSize(M, 1, K, 1, BlkBitWidth, BlkLen, HasZeroPoint, ComputeType);
+}
+
+void MLASCALL
+MlasQNBitGemmQuantizeA(
+    size_t M,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    bool HasZeroPoint,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType,
+    const float* A,
+    size_t lda,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    void* QuantA
+)
+{
+    assert(MlasQNBitGemmQuantizedASize(M, K, BlkBitWidth, BlkLen, HasZeroPoint, ComputeType) != 0);
+    MLAS_UNREFERENCED_PARAMETER(HasZeroPoint);
+
+    QuantizeARows_CompInt8(
+        BlkLen, M, K, A, lda, RangeStartM, RangeCountM,
+        AlignQNBitGemmWorkspace(QuantA, BlkBitWidth, BlkLen, ComputeType)
+    );
+}
+
 template <typename T>
 void MLASCALL
 MlasQNBitGemmBatch(
@@ -1001,24 +1168,34 @@ MlasQNBitGemmBatch(
     // Ensure `Workspace` has correct alignment.
     //
     if (Workspace != nullptr) {
-        const size_t Alignment = QNBitGemmPerGemmWorkspaceAlignment(BlkBitWidth, BlkLen, ComputeType);
-        const uintptr_t WorkspaceAddress = reinterpret_cast<uintptr_t>(Workspace);
-        Workspace = reinterpret_cast<void*>(
-            (WorkspaceAddress + Alignment - 1) & (~(Alignment - 1))
-        );
+        Workspace = AlignQNBitGemmWorkspace(Workspace, BlkBitWidth, BlkLen, ComputeType);
     }
 
     const bool has_zp_input = DataParams->QuantBZeroPoint;
     const size_t PerGemmWorkspaceStride =
         QNBitGemmPerGemmWorkspaceStride(M, N, K, BlkBitWidth, BlkLen, has_zp_input, ComputeType);
 
+    //
+    // A quantized by the caller takes the place of the workspace that A would be quantized to.
+    //
+    const bool HasQuantA = DataParams->QuantA != nullptr;
+
     if (const auto InitializeWorkspaceOperation = GetInitializeWorkspace<T>(Variant);
-        InitializeWorkspaceOperation != nullptr) {
+        InitializeWorkspaceOperation != nullptr && !HasQuantA) {
         InitializeWorkspaceOperation(
             M, N, K, BatchN, BlkLen, DataParams, Workspace, PerGemmWorkspaceStride, ThreadPool
         );
     }
 
+    const auto GetPerGemmWorkspace = [&](size_t gemm_i) -> void* {
+        if (HasQuantA) {
+            return AlignQNBitGemmWorkspace(
+                const_cast<void*>(DataParams[gemm_i].QuantA), BlkBitWidth, BlkLen, ComputeType
+            );
+        }
+        return reinterpret_cast<std::byte*>(Workspace) + gemm_i * PerGemmWorkspaceStride;
+    };
+
     const auto ComputeOperation = GetQNBitGemm<T>(Variant);
 
     const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
@@ -1026,8 +1203,7 @@ MlasQNBitGemmBatch(
     if (ThreadPool == nullptr) {
         for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
             const auto* Data = &DataParams[gemm_i];
-            void* PerGemmWorkspace =
-                reinterpret_cast<std::byte*>(Workspace) + gemm_i * PerGemmWorkspaceStride;
+            void* PerGemmWorkspace = GetPerGemmWorkspace(gemm_i);
             if (Variant == SQ4BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmKernel_BlkSum_CompInt8 != nullptr) {
                 PackedQuantBDataStruct<T, 4> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
                 const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
@@ -1104,8 +1280,7 @@ MlasQNBitGemmBatch(
         const size_t RangeStartN = ThreadIdN * StrideN;
         const size_t RangeCountN = std::min(N - RangeStartN, (size_t)StrideN);
 
-        void* PerGemmWorkspace =
-            reinterpret_cast<std::byte*>(Workspace) + gemm_i * PerGemmWorkspaceStride;
+        void* PerGemmWorkspace = GetPerGemmWorkspace(gemm_i);
         if (Variant == SQ4BitGemmVariant_CompInt8 && GetMlasPlatform().QNBitGemmDispatch->SQ4BitGemmKernel_BlkSum_CompInt8 != nullptr) {
             PackedQuantBDataStruct<T, 4> packed_quant_b(const_cast<void*>(Data->QuantBDataWorkspace), N, BlockCountK, BlkLen);
             const_cast<MLAS_QNBIT_GEMM_DATA_PARAMS<T>*>(Data)->PackedQuantBData = packed_quant_b.PackedQuantBData;
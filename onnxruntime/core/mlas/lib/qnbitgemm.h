@@ -536,3 +536,77 @@ struct MLAS_QNBIT_GEMM_DISPATCH {
 
     HQ4BitGemmKernel_CompFp16_Fn* HQ4BitGemmKernel_CompFp16 = nullptr;
 };
+
+//
+// 2-bit and 3-bit quantized B routines.
+//
+// These widths have no per-platform kernels in the dispatch structure above.
+// They are implemented once in qnbitgemm_lowbit.cpp with the portable MLAS
+// vector types and are available on every platform.
+//
+
+size_t
+SQLowBitGemmPackQuantBDataSize(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen
+);
+
+void
+SQLowBitGemmPackQuantBData(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const std::byte* QuantBData,
+    std::byte* PackedQuantBData,
+    MLAS_THREADPOOL* ThreadPool
+);
+
+size_t
+SQLowBitGemmPerGemmWorkspaceSize(
+    size_t M,
+    size_t K,
+    size_t BlkLen,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
+);
+
+void
+SQLowBitGemmInitializeWorkspace_CompInt8(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    size_t BlkLen,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* DataParams,
+    void* Workspace,
+    size_t PerGemmWorkspaceStride,
+    MLAS_THREADPOOL* ThreadPool
+);
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemm_CompFp32(
+    size_t BlkLen,
+    size_t K,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* DataParams,
+    void* PerGemmWorkspace,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+);
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemm_CompInt8(
+    size_t BlkLen,
+    size_t K,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* DataParams,
+    void* PerGemmWorkspace,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+);
@@ -0,0 +1,769 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qnbitgemm_lowbit.cpp
+
+Abstract:
+
+    This module implements the float/quantized n-bit integer matrix
+    multiplication for 2-bit and 3-bit quantized B.
+
+    The quantized B data is repacked into bit planes. Each block of BlkLen
+    values stores the low two bits of every value as a 2-bit stream, four
+    values per byte, followed for 3-bit data by the third bit of every value
+    as a 1-bit stream, eight values per byte. A byte of the low plane and a
+    nibble of the high plane then each expand to four consecutive values
+    through a small lookup table, which keeps the inner loops free of
+    variable shifts and lets them run on the portable MLAS vector types.
+
+    For 2-bit data the packed layout is identical to the MatMulNBits layout.
+
+--*/
+
+#include "qnbitgemm.h"
+
+#include <cassert>
+
+namespace
+{
+
+//
+// Lookup tables that expand a byte of the low plane or a nibble of the high
+// plane to four consecutive quantized values.
+//
+
+struct MLAS_QLOWBIT_UNPACK_TABLE {
+    float Low[256][4];
+    float High[16][4];
+    uint8_t LowBytes[256][4];
+    uint8_t HighBytes[16][4];
+
+    constexpr MLAS_QLOWBIT_UNPACK_TABLE() : Low(), High(), LowBytes(), HighBytes()
+    {
+        for (size_t b = 0; b < 256; b++) {
+            for (size_t i = 0; i < 4; i++) {
+                LowBytes[b][i] = uint8_t((b >> (2 * i)) & 3);
+                Low[b][i] = float(LowBytes[b][i]);
+            }
+        }
+        for (size_t b = 0; b < 16; b++) {
+            for (size_t i = 0; i < 4; i++) {
+                HighBytes[b][i] = uint8_t(((b >> i) & 1) << 2);
+                High[b][i] = float(HighBytes[b][i]);
+            }
+        }
+    }
+};
+
+constexpr MLAS_QLOWBIT_UNPACK_TABLE MlasQLowBitUnpackTable;
+
+//
+// Number of M rows processed per pass of the int8 kernel.
+//
+
+constexpr size_t MLAS_QLOWBIT_STRIDE_M = 128;
+
+MLAS_FORCEINLINE
+size_t
+QLowBitZeroPointStride(
+    size_t BlkBitWidth,
+    size_t BlockCountK
+    )
+{
+    return MlasDivRoundup(BlockCountK * BlkBitWidth, 8);
+}
+
+MLAS_FORCEINLINE
+float
+QLowBitZeroPoint(
+    const std::byte* QuantBZeroPoint,
+    size_t BlkBitWidth,
+    size_t BlockIndex
+    )
+/*++
+
+Routine Description:
+
+    This routine extracts the zero point of a block from a column of packed
+    zero points. Zero points are stored as a bit stream of BlkBitWidth bits
+    per block, least significant bits first, and may straddle a byte.
+
+    When no zero points are supplied, the midpoint of the quantized range is
+    returned.
+
+--*/
+{
+    if (QuantBZeroPoint == nullptr) {
+        return float(1u << (BlkBitWidth - 1));
+    }
+
+    const size_t BitOffset = BlockIndex * BlkBitWidth;
+    const size_t ByteIndex = BitOffset / 8;
+    const size_t Shift = BitOffset % 8;
+
+    uint32_t Value = std::to_integer<uint32_t>(QuantBZeroPoint[ByteIndex]) >> Shift;
+    if (Shift + BlkBitWidth > 8) {
+        Value |= std::to_integer<uint32_t>(QuantBZeroPoint[ByteIndex + 1]) << (8 - Shift);
+    }
+
+    return float(Value & ((1u << BlkBitWidth) - 1));
+}
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE
+void
+QLowBitUnpackFloat8(
+    const uint8_t* LowPlane,
+    const uint8_t* HighPlane,
+    size_t Index,
+    MLAS_FLOAT32X4& Values0,
+    MLAS_FLOAT32X4& Values1
+    )
+/*++
+
+Routine Description:
+
+    This routine expands eight consecutive quantized values of a packed
+    block, starting at an index that is a multiple of eight.
+
+--*/
+{
+    Values0 = MlasLoadFloat32x4(MlasQLowBitUnpackTable.Low[LowPlane[Index / 4]]);
+    Values1 = MlasLoadFloat32x4(MlasQLowBitUnpackTable.Low[LowPlane[Index / 4 + 1]]);
+
+    if constexpr (BlkBitWidth == 3) {
+        const uint8_t High = HighPlane[Index / 8];
+        Values0 = MlasAddFloat32x4(Values0, MlasLoadFloat32x4(MlasQLowBitUnpackTable.High[High & 0x0F]));
+        Values1 = MlasAddFloat32x4(Values1, MlasLoadFloat32x4(MlasQLowBitUnpackTable.High[High >> 4]));
+    }
+}
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE
+void
+QLowBitUnpackBytes(
+    const uint8_t* LowPlane,
+    const uint8_t* HighPlane,
+    size_t BlkLen,
+    uint8_t* Values
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a packed block to one unsigned byte per quantized
+    value.
+
+--*/
+{
+    for (size_t i = 0; i < BlkLen; i += 8) {
+
+        uint8_t Bytes[8];
+        std::memcpy(Bytes, MlasQLowBitUnpackTable.LowBytes[LowPlane[i / 4]], 4);
+        std::memcpy(Bytes + 4, MlasQLowBitUnpackTable.LowBytes[LowPlane[i / 4 + 1]], 4);
+
+        if constexpr (BlkBitWidth == 3) {
+            const uint8_t High = HighPlane[i / 8];
+            for (size_t j = 0; j < 4; j++) {
+                Bytes[j] |= MlasQLowBitUnpackTable.HighBytes[High & 0x0F][j];
+                Bytes[j + 4] |= MlasQLowBitUnpackTable.HighBytes[High >> 4][j];
+            }
+        }
+
+        std::memcpy(Values + i, Bytes, 8);
+    }
+}
+
+template <size_t BlkBitWidth>
+void
+QLowBitGemvFloat(
+    size_t BlkLen,
+    const float* PaddedA,
+    const float* BlockSumA,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t BlockCountK,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a single row of C against CountN columns of packed
+    B, dequantizing B on the fly.
+
+    Each block contributes Scale * (dot(A, B) - ZeroPoint * sum(A)), so the
+    inner loop only multiplies A against the unsigned quantized values.
+
+Arguments:
+
+    BlkLen - Supplies the number of quantized values per block.
+
+    PaddedA - Supplies the row of A, zero padded to BlockCountK * BlkLen.
+
+    BlockSumA - Supplies the sum of each block of the row of A.
+
+    QuantBData - Supplies the first packed column of B.
+
+    QuantBScale - Supplies the block scales of the first column of B.
+
+    QuantBZeroPoint - Optionally supplies the packed zero points of the first
+        column of B.
+
+    C - Supplies the first output element.
+
+    CountN - Supplies the number of columns of B.
+
+    BlockCountK - Supplies the number of blocks along K.
+
+    Bias - Optionally supplies the bias of the first column.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ZeroPointStride = QLowBitZeroPointStride(BlkBitWidth, BlockCountK);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const uint8_t* b = reinterpret_cast<const uint8_t*>(QuantBData) + n * BlockCountK * BlkDataSize;
+        const float* scale = QuantBScale + n * BlockCountK;
+        const std::byte* zp = (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * ZeroPointStride;
+
+        MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+        float Offset = 0.0f;
+
+        for (size_t blk = 0; blk < BlockCountK; blk++) {
+
+            const uint8_t* LowPlane = b + blk * BlkDataSize;
+            const uint8_t* HighPlane = LowPlane + BlkLen / 4;
+            const float* a = PaddedA + blk * BlkLen;
+
+            MLAS_FLOAT32X4 BlockAccumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 BlockAccumulator1 = MlasZeroFloat32x4();
+
+            for (size_t i = 0; i < BlkLen; i += 8) {
+
+                MLAS_FLOAT32X4 Values0;
+                MLAS_FLOAT32X4 Values1;
+                QLowBitUnpackFloat8<BlkBitWidth>(LowPlane, HighPlane, i, Values0, Values1);
+
+                BlockAccumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a + i), Values0, BlockAccumulator0);
+                BlockAccumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(a + i + 4), Values1, BlockAccumulator1);
+            }
+
+            const float Scale = scale[blk];
+
+            Accumulator = MlasMultiplyAddFloat32x4(MlasAddFloat32x4(BlockAccumulator0, BlockAccumulator1),
+                Scale, Accumulator);
+            Offset += Scale * QLowBitZeroPoint(zp, BlkBitWidth, blk) * BlockSumA[blk];
+        }
+
+        C[n] = MlasReduceAddFloat32x4(Accumulator) - Offset + ((Bias == nullptr) ? 0.0f : Bias[n]);
+    }
+}
+
+template <size_t BlkBitWidth>
+void
+QLowBitDequantBForSgemm(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes CountN columns of packed B to the layout
+    expected by the SGEMM kernels: panels of 16 columns, each stored as
+    CountK rows of 16 values, with the columns past CountN zero filled.
+
+--*/
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ZeroPointStride = QLowBitZeroPointStride(BlkBitWidth, BlockCountK);
+
+    MLAS_DECLSPEC_ALIGN(float Values[8], 16);
+
+    for (size_t n = 0; n < CountN; n += 16) {
+
+        const size_t CountPanelN = std::min(CountN - n, size_t{16});
+        float* Panel = FpData + n * CountK;
+
+        if (CountPanelN < 16) {
+            std::fill_n(Panel, CountK * 16, 0.0f);
+        }
+
+        for (size_t nn = 0; nn < CountPanelN; nn++) {
+
+            const uint8_t* b = reinterpret_cast<const uint8_t*>(QuantBData) + (n + nn) * BlockCountK * BlkDataSize;
+            const float* scale = QuantBScale + (n + nn) * BlockCountK;
+            const std::byte* zp =
+                (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + (n + nn) * ZeroPointStride;
+
+            for (size_t blk = 0; blk < BlockCountK; blk++) {
+
+                const uint8_t* LowPlane = b + blk * BlkDataSize;
+                const uint8_t* HighPlane = LowPlane + BlkLen / 4;
+
+                const MLAS_FLOAT32X4 Scale = MlasBroadcastFloat32x4(scale[blk]);
+                const MLAS_FLOAT32X4 ZeroPoint = MlasBroadcastFloat32x4(QLowBitZeroPoint(zp, BlkBitWidth, blk));
+
+                const size_t k = blk * BlkLen;
+                const size_t CountBlockK = std::min(CountK - k, BlkLen);
+
+                for (size_t i = 0; i < CountBlockK; i += 8) {
+
+                    MLAS_FLOAT32X4 Values0;
+                    MLAS_FLOAT32X4 Values1;
+                    QLowBitUnpackFloat8<BlkBitWidth>(LowPlane, HighPlane, i, Values0, Values1);
+
+                    MlasStoreFloat32x4(Values, MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Values0, ZeroPoint), Scale));
+                    MlasStoreFloat32x4(Values + 4, MlasMultiplyFloat32x4(MlasSubtractFloat32x4(Values1, ZeroPoint), Scale));
+
+                    const size_t CountValues = std::min(CountBlockK - i, size_t{8});
+
+                    for (size_t j = 0; j < CountValues; j++) {
+                        Panel[(k + i + j) * 16 + nn] = Values[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+QLowBitAddBias(
+    const float* Bias,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+{
+    for (size_t m = 0; m < CountM; m++) {
+        for (size_t n = 0; n < CountN; n++) {
+            C[m * ldc + n] += Bias[n];
+        }
+    }
+}
+
+//
+// Per-GEMM workspace of the int8 compute type. Every row of A is stored as its
+// blockwise quantized values, zero padded to BlockCountK * BlkLen, followed by
+// the scale and the sum of the quantized values of every block.
+//
+
+struct QLowBitQuantARow {
+    QLowBitQuantARow(const void* PerGemmWorkspace, size_t Row, size_t BlockCountK, size_t BlkLen)
+    {
+        QuantData = static_cast<int8_t*>(const_cast<void*>(PerGemmWorkspace)) + Row * Stride(BlockCountK, BlkLen);
+        QuantScale = reinterpret_cast<float*>(QuantData + BlockCountK * BlkLen);
+        BlockSum = reinterpret_cast<int32_t*>(QuantScale + BlockCountK);
+    }
+
+    static size_t Stride(size_t BlockCountK, size_t BlkLen)
+    {
+        return BlockCountK * (BlkLen + sizeof(float) + sizeof(int32_t));
+    }
+
+    int8_t* QuantData;      // BlockCountK x BlkLen
+    float* QuantScale;      // BlockCountK
+    int32_t* BlockSum;      // BlockCountK
+};
+
+void
+QLowBitQuantizeARow(
+    size_t BlkLen,
+    const float* A,
+    size_t K,
+    int8_t* QuantA,
+    float* QuantAScale,
+    int32_t* QuantABlockSum
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes a row of A to symmetric int8 blocks of BlkLen
+    values and records the scale and the sum of the quantized values of every
+    block.
+
+--*/
+{
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+
+    for (size_t blk = 0; blk < BlockCountK; blk++) {
+
+        const size_t k = blk * BlkLen;
+        const size_t CountBlockK = std::min(K - k, BlkLen);
+
+        float MaximumAbsolute = 0.0f;
+        for (size_t i = 0; i < CountBlockK; i++) {
+            MaximumAbsolute = std::max(MaximumAbsolute, std::fabs(A[k + i]));
+        }
+
+        const float Scale = MaximumAbsolute / 127.0f;
+        const float InverseScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+
+        int8_t* q = QuantA + k;
+        int32_t Sum = 0;
+
+        for (size_t i = 0; i < CountBlockK; i++) {
+            const float Value = std::min(std::max(std::roundf(A[k + i] * InverseScale), -127.0f), 127.0f);
+            q[i] = int8_t(Value);
+            Sum += q[i];
+        }
+        std::fill_n(q + CountBlockK, BlkLen - CountBlockK, int8_t{0});
+
+        QuantAScale[blk] = Scale;
+        QuantABlockSum[blk] = Sum;
+    }
+}
+
+}  // namespace
+
+size_t
+SQLowBitGemmPackQuantBDataSize(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen
+)
+{
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    return N * BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+}
+
+void
+SQLowBitGemmPackQuantBData(
+    size_t N,
+    size_t K,
+    size_t BlkBitWidth,
+    size_t BlkLen,
+    const std::byte* QuantBData,
+    std::byte* PackedQuantBData,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    assert(BlkBitWidth == 2 || BlkBitWidth == 3);
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+
+    if (BlkBitWidth == 2) {
+        std::memcpy(PackedQuantBData, QuantBData, N * BlockCountK * BlkDataSize);
+        return;
+    }
+
+    //
+    // Split each block of the 3-bit stream into the 2-bit low plane and the
+    // 1-bit high plane.
+    //
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(N * BlockCountK), [&](ptrdiff_t tid) {
+        const uint8_t* Input = reinterpret_cast<const uint8_t*>(QuantBData) + tid * BlkDataSize;
+        uint8_t* LowPlane = reinterpret_cast<uint8_t*>(PackedQuantBData) + tid * BlkDataSize;
+        uint8_t* HighPlane = LowPlane + BlkLen / 4;
+
+        std::fill_n(LowPlane, BlkDataSize, uint8_t{0});
+
+        for (size_t i = 0; i < BlkLen; i++) {
+            const size_t BitOffset = i * 3;
+            const size_t ByteIndex = BitOffset / 8;
+            const size_t Shift = BitOffset % 8;
+
+            uint32_t Value = uint32_t(Input[ByteIndex]) >> Shift;
+            if (Shift > 5) {
+                Value |= uint32_t(Input[ByteIndex + 1]) << (8 - Shift);
+            }
+
+            LowPlane[i / 4] |= uint8_t((Value & 3) << (2 * (i % 4)));
+            HighPlane[i / 8] |= uint8_t(((Value >> 2) & 1) << (i % 8));
+        }
+    });
+}
+
+size_t
+SQLowBitGemmPerGemmWorkspaceSize(
+    size_t M,
+    size_t K,
+    size_t BlkLen,
+    MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType
+)
+{
+    if (ComputeType == SQNBIT_CompInt8) {
+        return M * QLowBitQuantARow::Stride(MlasDivRoundup(K, BlkLen), BlkLen);
+    }
+
+    return 0;
+}
+
+void
+SQLowBitGemmInitializeWorkspace_CompInt8(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    size_t BlkLen,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* DataParams,
+    void* Workspace,
+    size_t PerGemmWorkspaceStride,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    MLAS_UNREFERENCED_PARAMETER(N);
+
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(BatchN * M), [&](ptrdiff_t tid) {
+        const size_t gemm_idx = size_t(tid) / M;
+        const size_t m = size_t(tid) % M;
+        const auto& data = DataParams[gemm_idx];
+
+        QLowBitQuantARow QuantA(
+            static_cast<std::byte*>(Workspace) + gemm_idx * PerGemmWorkspaceStride, m, BlockCountK, BlkLen
+        );
+
+        QLowBitQuantizeARow(BlkLen, data.A + m * data.lda, K, QuantA.QuantData, QuantA.QuantScale, QuantA.BlockSum);
+    });
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemm_CompFp32(
+    size_t BlkLen,
+    size_t K,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* DataParams,
+    void* PerGemmWorkspace,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+)
+{
+    MLAS_UNREFERENCED_PARAMETER(PerGemmWorkspace);
+
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const size_t k_blks = MlasDivRoundup(K, BlkLen);
+    const size_t ldb = k_blks * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t k_blks_zp_bytes = QLowBitZeroPointStride(BlkBitWidth, k_blks);
+
+    const float* A = DataParams->A + RangeStartM * lda;
+
+    const std::byte* QuantBData = DataParams->PackedQuantBData + RangeStartN * ldb;
+    const float* QuantBScale = DataParams->QuantBScale + RangeStartN * k_blks;
+    const std::byte* QuantBZeroPoint =
+        (DataParams->QuantBZeroPoint == nullptr)
+            ? nullptr
+            : static_cast<const std::byte*>(DataParams->QuantBZeroPoint) + RangeStartN * k_blks_zp_bytes;
+
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    const float* Bias = (DataParams->Bias == nullptr) ? nullptr : DataParams->Bias + RangeStartN;
+
+    if (RangeCountM == 1) {
+
+        //
+        // Zero pad the row of A to whole blocks and compute the block sums
+        // used to apply the zero points once per block.
+        //
+
+        MlasThreadedBufAlloc((k_blks * BlkLen + k_blks) * sizeof(float));
+        float* PaddedA = reinterpret_cast<float*>(ThreadedBufHolder.get());
+        float* BlockSumA = PaddedA + k_blks * BlkLen;
+
+        std::copy_n(A, K, PaddedA);
+        std::fill_n(PaddedA + K, k_blks * BlkLen - K, 0.0f);
+
+        for (size_t blk = 0; blk < k_blks; blk++) {
+            float Sum = 0.0f;
+            for (size_t i = 0; i < BlkLen; i++) {
+                Sum += PaddedA[blk * BlkLen + i];
+            }
+            BlockSumA[blk] = Sum;
+        }
+
+        size_t CountN;
+        for (size_t n = 0; n < RangeCountN; n += CountN) {
+            CountN = std::min(RangeCountN - n, size_t{128});
+
+            QLowBitGemvFloat<BlkBitWidth>(
+                BlkLen,
+                PaddedA,
+                BlockSumA,
+                QuantBData + n * ldb,
+                QuantBScale + n * k_blks,
+                (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes,
+                C + n,
+                CountN,
+                k_blks,
+                (Bias == nullptr) ? nullptr : Bias + n
+            );
+
+            if (DataParams->PostProcessor != nullptr) {
+                DataParams->PostProcessor->Process(
+                    DataParams->C, RangeStartM, RangeStartN + n,
+                    RangeCountM, CountN, ldc
+                );
+            }
+        }
+        return;
+    }
+
+    constexpr size_t StrideN = 32;
+    MlasThreadedBufAlloc(k_blks * BlkLen * StrideN * sizeof(float));
+    float* dequant_b = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, StrideN);
+
+        const float* a_row = A;
+        float* c_blk = C + n;
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+        QLowBitDequantBForSgemm<BlkBitWidth>(
+            BlkLen,
+            dequant_b,
+            QuantBData + n * ldb,
+            QuantBScale + n * k_blks,
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes,
+            CountN,
+            K,
+            k_blks
+        );
+
+        size_t RowsRemaining = RangeCountM;
+        while (RowsRemaining > 0) {
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER) || defined(MLAS_TARGET_LARCH64)
+            auto RowsHandled = GetMlasPlatform().GemmFloatKernel(
+                a_row, dequant_b, c_blk, K, RowsRemaining, CountN, lda, ldc, 1.f, true
+            );
+#else
+            auto RowsHandled = MlasSgemmKernelZero(a_row, dequant_b, c_blk, K, RowsRemaining, CountN, lda, ldc, 1.f);
+#endif
+
+            if (bias) {
+                QLowBitAddBias(bias, c_blk, RowsHandled, CountN, ldc);
+            }
+            if (DataParams->PostProcessor != nullptr) {
+                DataParams->PostProcessor->Process(
+                    DataParams->C, RangeStartM + RangeCountM - RowsRemaining, RangeStartN + n,
+                    RowsHandled, CountN, ldc
+                );
+            }
+
+            c_blk += ldc * RowsHandled;
+            a_row += lda * RowsHandled;
+            RowsRemaining -= RowsHandled;
+        }
+    }
+}
+
+template <size_t BlkBitWidth>
+void
+SQLowBitGemm_CompInt8(
+    size_t BlkLen,
+    size_t K,
+    const MLAS_QNBIT_GEMM_DATA_PARAMS<float>* DataParams,
+    void* PerGemmWorkspace,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+)
+{
+    const size_t ldc = DataParams->ldc;
+
+    const size_t k_blks = MlasDivRoundup(K, BlkLen);
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ldb = k_blks * BlkDataSize;
+    const size_t k_blks_zp_bytes = QLowBitZeroPointStride(BlkBitWidth, k_blks);
+
+    const std::byte* QuantBZeroPointBase = static_cast<const std::byte*>(DataParams->QuantBZeroPoint);
+
+    MlasThreadedBufAlloc(BlkLen + MLAS_QLOWBIT_STRIDE_M * sizeof(float));
+    float* Accumulators = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    uint8_t* UnpackedB = reinterpret_cast<uint8_t*>(Accumulators + MLAS_QLOWBIT_STRIDE_M);
+
+    for (size_t m0 = 0; m0 < RangeCountM; m0 += MLAS_QLOWBIT_STRIDE_M) {
+
+        const size_t CountM = std::min(RangeCountM - m0, MLAS_QLOWBIT_STRIDE_M);
+        const size_t RowStart = RangeStartM + m0;
+
+        for (size_t n = RangeStartN; n < RangeStartN + RangeCountN; n++) {
+
+            const uint8_t* b = reinterpret_cast<const uint8_t*>(DataParams->PackedQuantBData) + n * ldb;
+            const float* scale = DataParams->QuantBScale + n * k_blks;
+            const std::byte* zp = (QuantBZeroPointBase == nullptr) ? nullptr : QuantBZeroPointBase + n * k_blks_zp_bytes;
+
+            std::fill_n(Accumulators, CountM, 0.0f);
+
+            for (size_t blk = 0; blk < k_blks; blk++) {
+
+                const uint8_t* LowPlane = b + blk * BlkDataSize;
+                QLowBitUnpackBytes<BlkBitWidth>(LowPlane, LowPlane + BlkLen / 4, BlkLen, UnpackedB);
+
+                const float ScaleB = scale[blk];
+                const int32_t ZeroPoint = int32_t(QLowBitZeroPoint(zp, BlkBitWidth, blk));
+
+                for (size_t m = 0; m < CountM; m++) {
+
+                    const QLowBitQuantARow QuantA(PerGemmWorkspace, RowStart + m, k_blks, BlkLen);
+                    const int8_t* a = QuantA.QuantData + blk * BlkLen;
+
+                    int32_t Dot = 0;
+                    for (size_t i = 0; i < BlkLen; i++) {
+                        Dot += int32_t(a[i]) * int32_t(UnpackedB[i]);
+                    }
+
+                    Dot -= ZeroPoint * QuantA.BlockSum[blk];
+
+                    Accumulators[m] += float(Dot) * QuantA.QuantScale[blk] * ScaleB;
+                }
+            }
+
+            const float BiasValue = (DataParams->Bias == nullptr) ? 0.0f : DataParams->Bias[n];
+
+            for (size_t m = 0; m < CountM; m++) {
+                DataParams->C[(RowStart + m) * ldc + n] = Accumulators[m] + BiasValue;
+            }
+        }
+
+        if (DataParams->PostProcessor != nullptr) {
+            DataParams->PostProcessor->Process(
+                DataParams->C, RowStart, RangeStartN,
+                CountM, RangeCountN, ldc
+            );
+        }
+    }
+}
+
+template void SQLowBitGemm_CompFp32<2>(size_t, size_t, const MLAS_QNBIT_GEMM_DATA_PARAMS<float>*, void*, size_t, size_t, size_t, size_t);
+template void SQLowBitGemm_CompFp32<3>(size_t, size_t, const MLAS_QNBIT_GEMM_DATA_PARAMS<float>*, void*, size_t, size_t, size_t, size_t);
+template void SQLowBitGemm_CompInt8<2>(size_t, size_t, const MLAS_QNBIT_GEMM_DATA_PARAMS<float>*, void*, size_t, size_t, size_t, size_t);
+template void SQLowBitGemm_CompInt8<3>(size_t, size_t, const MLAS_QNBIT_GEMM_DATA_PARAMS<float>*, void*, size_t, size_t, size_t, size_t);
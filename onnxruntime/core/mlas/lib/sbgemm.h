@@ -30,8 +30,6 @@ Abstract:
         MLAS_SBGEMM_STRIDES Strides{128, 128, 256};
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
-
 #pragma once
 
 #include <cassert>
@@ -39,6 +37,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(MLAS_SUPPORTS_SBGEMM)
+
 /**
  * @brief Define the default striding parameters for
  *        the bfloat16 precision gemm operation
@@ -134,7 +134,8 @@ MlasSBGemmPackedOperation(size_t M, size_t RangeStartN, size_t RangeCountN, size
             bool ZeroMode = (k == 0);
             CountK = std::min(K - k, PackedStrideK);
 
-            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + CountK * SliceStartN;
+            const size_t AlignedK = (CountK + KernelType::PackedK - 1) & ~(KernelType::PackedK - 1);
+            const bfloat16_t* pb = (const bfloat16_t*)PackedB + AlignedN * k + AlignedK * SliceStartN;
             float* c = C + n;
             const float* pbias = ((nullptr == Bias) ? nullptr : Bias + RangeStartN + n);
             MlasSBGemmKernel<KernelType>(M, CountN, CountK, A + k, lda, pb, c, ldc, ZeroMode ? pbias : nullptr, ZeroMode);
@@ -153,24 +154,18 @@ MlasSBGemmNonPackedOperation(size_t M, size_t N, size_t K, const float* A, size_
     //
     // Compute the strides to step through slices of the input matrices.
     //
-    // Expand the N stride if K is small or expand the K stride if N is small
-    // for better utilization of the B panel. Avoid changing the K stride if
-    // the A panel needs to be used for transposing.
+    // Expand the N stride if K is small for better utilization of the B
+    // panel. The K stride is never expanded: the packing routine splits B
+    // into row blocks of KernelType::Strides.K, and the kernel expects a
+    // single block.
     //
     constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
     size_t StrideN = Strides.N;
     size_t StrideK = Strides.K;
 
-    if (N >= K) {
-        while (StrideK / 2 >= K) {
-            StrideN *= 2;
-            StrideK /= 2;
-        }
-    } else {
-        while (StrideN > 16 && StrideN / 2 >= N) {
-            StrideK *= 2;
-            StrideN /= 2;
-        }
+    while (StrideK / 2 >= K && StrideK / 2 >= KernelType::PackedK) {
+        StrideN *= 2;
+        StrideK /= 2;
     }
 
     constexpr size_t packBSize = UpAlignSize(Strides.N * Strides.K * sizeof(bfloat16_t));
@@ -283,7 +278,9 @@ struct MLAS_SBGEMM_DISPATCH {
     size_t BufOverRead;
 };
 
+#if defined(MLAS_TARGET_ARM64)
 extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchNeon;
+#endif
 
 MLAS_FORCEINLINE
 const MLAS_SBGEMM_DISPATCH*
@@ -291,6 +288,8 @@ MlasSBGemmGetDispatch()
 {
 #if defined(MLAS_TARGET_ARM64)
     return &MlasSBGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().SBGemmDispatch;
 #else
     std::cerr << "SBGemm Kernel is supported only on ARM64 platform.";
     exit(1);
@@ -396,4 +395,4 @@ MlasSBGemmBatch(const size_t M, const size_t N, const size_t K, const size_t Bat
         }
     );
 }
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SUPPORTS_SBGEMM)
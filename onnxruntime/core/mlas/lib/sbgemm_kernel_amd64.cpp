@@ -0,0 +1,240 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_amd64.cpp
+
+Abstract:
+
+    This module implements the bfloat16 precision GEMM (SBGEMM) dispatch for
+    x86, shared by the AVX512-BF16 kernel and the AVX2 kernel that emulates
+    the bfloat16 dot products by widening to single precision.
+
+    Matrix B is packed in panels of 16 columns. Within a panel, each pair of
+    rows is interleaved so that the two values of a column are adjacent, the
+    layout consumed by vdpbf16ps:
+
+        B[k][n], B[k+1][n], B[k][n+1], B[k+1][n+1], ...
+
+    Odd row counts and partial panels are padded with zeros.
+
+--*/
+
+#include "mlasi.h"
+#include "sbgemm.h"
+
+struct MLAS_SBGEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 2;
+    static constexpr size_t PackedN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+bool MLASCALL
+MlasBf16AccelerationSupported()
+{
+    return GetMlasPlatform().SBGemmDispatch != nullptr;
+}
+
+MLAS_FORCEINLINE
+bfloat16_t
+MlasSBGemmFloatToBfloat16(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a single precision value to bfloat16 with round to
+    nearest even, matching the conversion done by the kernels.
+
+Arguments:
+
+    Value - Supplies the value to convert.
+
+Return Value:
+
+    Returns the bfloat16 encoding of the value.
+
+--*/
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return bfloat16_t((Bits >> 16) | 0x0040);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+
+    return bfloat16_t(Bits >> 16);
+}
+
+void
+MlasSBGemmConvertCopyPackB(
+    bfloat16_t* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of matrix B to bfloat16 and copies it to
+    the packed buffer in 16 column panels of interleaved row pairs.
+
+Arguments:
+
+    D - Supplies the address of the packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the first dimension of the source matrix.
+
+    CountN - Supplies the number of columns to pack.
+
+    CountK - Supplies the number of rows to pack.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t PanelN = MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    for (size_t n = 0; n < CountN; n += PanelN) {
+
+        const size_t CountPanelN = std::min(CountN - n, PanelN);
+
+        for (size_t k = 0; k < CountK; k += 2) {
+
+            const float* b0 = B + k * ldb + n;
+            const float* b1 = (k + 1 < CountK) ? b0 + ldb : nullptr;
+
+            for (size_t i = 0; i < PanelN; i++) {
+
+                if (i < CountPanelN) {
+                    D[0] = MlasSBGemmFloatToBfloat16(b0[i]);
+                    D[1] = (b1 != nullptr) ? MlasSBGemmFloatToBfloat16(b1[i]) : bfloat16_t(0);
+                } else {
+                    D[0] = 0;
+                    D[1] = 0;
+                }
+
+                D += 2;
+            }
+        }
+    }
+}
+
+template <typename KernelType>
+void
+MlasSBGemmConvertPackBAmd64(
+    bfloat16_t* PackedB,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+    )
+{
+    const size_t AlignedN = (CountN + KernelType::PackedN - 1) & ~(KernelType::PackedN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension. Every block
+    // but the last has Strides.K rows, which is a multiple of PackedK.
+    //
+
+    size_t K_block_size;
+    constexpr MLAS_SBGEMM_STRIDES Strides = KernelType::Strides;
+
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+
+        MlasSBGemmConvertCopyPackB(PackedB, B + k * ldb, ldb, CountN, K_block_size);
+        PackedB += AlignedN * K_block_size;
+    }
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX2>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    MlasSBGemmConvertPackBAmd64<MLAS_SBGEMM_KERNEL_AVX2>(PackedB, B, ldb, CountN, CountK);
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    MlasSBGemmConvertPackBAmd64<MLAS_SBGEMM_KERNEL_AVX512BF16>(PackedB, B, ldb, CountN, CountK);
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX2>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    while (CountM > 0) {
+        size_t RowsHandled = MlasSbgemmKernelAvx2(A, B, C, CountK, CountM, CountN, lda, ldc, Bias, ZeroMode);
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+    }
+}
+
+#if defined(MLAS_AVX512BF16_SUPPORTED)
+
+template <>
+MLAS_FORCEINLINE void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode)
+{
+    while (CountM > 0) {
+        size_t RowsHandled = MlasSbgemmKernelAvx512Bf16(A, B, C, CountK, CountM, CountN, lda, ldc, Bias, ZeroMode);
+        C += ldc * RowsHandled;
+        A += lda * RowsHandled;
+        CountM -= RowsHandled;
+    }
+}
+
+#endif  // defined(MLAS_AVX512BF16_SUPPORTED)
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx2 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX2>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX2>,
+    MLAS_SBGEMM_KERNEL_AVX2::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX2::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
+
+#if defined(MLAS_AVX512BF16_SUPPORTED)
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0
+};
+
+#endif  // defined(MLAS_AVX512BF16_SUPPORTED)
@@ -0,0 +1,283 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the bfloat16 precision GEMM kernel for AVX2.
+
+    AVX2 has no bfloat16 arithmetic, so the kernel emulates vdpbf16ps: the
+    interleaved row pairs of packed B are widened to single precision by
+    shifting each bfloat16 into the upper half of a 32-bit lane, and A is
+    rounded to bfloat16 before the multiply. This produces the same products
+    as the AVX512-BF16 kernel on any AVX2 capable processor.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of columns in a packed panel of B and the number of rows
+// of A converted to bfloat16 at a time.
+//
+
+#define MLAS_SBGEMM_AVX2_PANEL_N                16
+#define MLAS_SBGEMM_AVX2_STRIDE_K               256
+
+MLAS_FORCEINLINE
+__m256
+MlasSBGemmRoundToBfloat16Avx2(
+    __m256 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine rounds single precision values to bfloat16 precision with
+    round to nearest even, keeping the results in single precision format.
+
+Arguments:
+
+    Value - Supplies the values to round.
+
+Return Value:
+
+    Returns the rounded values.
+
+--*/
+{
+    __m256i Bits = _mm256_castps_si256(Value);
+    __m256i Lsb = _mm256_and_si256(_mm256_srli_epi32(Bits, 16), _mm256_set1_epi32(1));
+    Bits = _mm256_add_epi32(Bits, _mm256_add_epi32(Lsb, _mm256_set1_epi32(0x7FFF)));
+    return _mm256_castsi256_ps(_mm256_and_si256(Bits, _mm256_set1_epi32(int32_t(0xFFFF0000))));
+}
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeBlockAvx2(
+    const float* ABuffer,
+    size_t PairCount,
+    const bfloat16_t* B,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of RowCount rows by one packed panel of
+    matrix C.
+
+Arguments:
+
+    ABuffer - Supplies the rows of A rounded to bfloat16 precision, with a
+        row stride of MLAS_SBGEMM_AVX2_STRIDE_K.
+
+    PairCount - Supplies the number of row pairs of the packed panel.
+
+    B - Supplies the packed panel of B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the panel to store.
+
+    Bias - Optionally supplies the bias added in ZeroMode.
+
+    ZeroMode - Supplies true if the output overwrites C, else the output is
+        accumulated into C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    static const int32_t MaskTable[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    const __m256i OddMask = _mm256_set1_epi32(int32_t(0xFFFF0000));
+
+    __m256 Accumulators[RowCount][2];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = _mm256_setzero_ps();
+        Accumulators[r][1] = _mm256_setzero_ps();
+    }
+
+    for (size_t p = 0; p < PairCount; p++) {
+
+        const __m256i Packed0 = _mm256_loadu_si256((const __m256i*)(B + p * 32));
+        const __m256i Packed1 = _mm256_loadu_si256((const __m256i*)(B + p * 32 + 16));
+
+        const __m256 BEven0 = _mm256_castsi256_ps(_mm256_slli_epi32(Packed0, 16));
+        const __m256 BOdd0 = _mm256_castsi256_ps(_mm256_and_si256(Packed0, OddMask));
+        const __m256 BEven1 = _mm256_castsi256_ps(_mm256_slli_epi32(Packed1, 16));
+        const __m256 BOdd1 = _mm256_castsi256_ps(_mm256_and_si256(Packed1, OddMask));
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const __m256 AEven = _mm256_broadcast_ss(ABuffer + r * MLAS_SBGEMM_AVX2_STRIDE_K + p * 2);
+            const __m256 AOdd = _mm256_broadcast_ss(ABuffer + r * MLAS_SBGEMM_AVX2_STRIDE_K + p * 2 + 1);
+
+            Accumulators[r][0] = _mm256_fmadd_ps(AEven, BEven0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(AEven, BEven1, Accumulators[r][1]);
+            Accumulators[r][0] = _mm256_fmadd_ps(AOdd, BOdd0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(AOdd, BOdd1, Accumulators[r][1]);
+        }
+    }
+
+    const size_t CountN0 = std::min(CountN, size_t(8));
+    const size_t CountN1 = CountN - CountN0;
+    const __m256i Mask0 = _mm256_loadu_si256((const __m256i*)(MaskTable + 8 - CountN0));
+    const __m256i Mask1 = _mm256_loadu_si256((const __m256i*)(MaskTable + 8 - CountN1));
+
+    __m256 Addend0 = _mm256_setzero_ps();
+    __m256 Addend1 = _mm256_setzero_ps();
+
+    if (ZeroMode && Bias != nullptr) {
+        Addend0 = _mm256_maskload_ps(Bias, Mask0);
+        Addend1 = _mm256_maskload_ps(Bias + 8, Mask1);
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* c = C + r * ldc;
+
+        if (!ZeroMode) {
+            Addend0 = _mm256_maskload_ps(c, Mask0);
+            Addend1 = _mm256_maskload_ps(c + 8, Mask1);
+        }
+
+        _mm256_maskstore_ps(c, Mask0, _mm256_add_ps(Accumulators[r][0], Addend0));
+        _mm256_maskstore_ps(c + 8, Mask1, _mm256_add_ps(Accumulators[r][1], Addend1));
+    }
+}
+
+size_t
+MLASCALL
+MlasSbgemmKernelAvx2(
+    const float* A,
+    const bfloat16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to four rows of the matrix product of A and the
+    packed bfloat16 matrix B.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of
+        rows of matrix B.
+
+    CountM - Supplies the maximum number of rows that can be processed.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Optionally supplies the bias vector added in ZeroMode.
+
+    ZeroMode - Supplies true if the output overwrites C, else the output is
+        accumulated into C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float ABuffer[4 * MLAS_SBGEMM_AVX2_STRIDE_K], 32);
+
+    const size_t RowCount = std::min(CountM, size_t(4));
+    const size_t AlignedK = (CountK + 1) & ~size_t(1);
+
+    for (size_t k = 0; k < CountK; k += MLAS_SBGEMM_AVX2_STRIDE_K) {
+
+        const size_t CountChunkK = std::min(CountK - k, size_t(MLAS_SBGEMM_AVX2_STRIDE_K));
+        const size_t PairCount = (CountChunkK + 1) / 2;
+        const bool ChunkZeroMode = ZeroMode && (k == 0);
+
+        //
+        // Round this chunk of the rows of A to bfloat16 precision, padding an
+        // odd row count with a zero.
+        //
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const float* a = A + r * lda + k;
+            float* buffer = ABuffer + r * MLAS_SBGEMM_AVX2_STRIDE_K;
+
+            size_t i = 0;
+
+            for (; i + 8 <= CountChunkK; i += 8) {
+                _mm256_store_ps(buffer + i, MlasSBGemmRoundToBfloat16Avx2(_mm256_loadu_ps(a + i)));
+            }
+
+            for (; i < CountChunkK; i++) {
+                buffer[i] = _mm256_cvtss_f32(MlasSBGemmRoundToBfloat16Avx2(_mm256_set1_ps(a[i])));
+            }
+
+            if ((CountChunkK & 1) != 0) {
+                buffer[CountChunkK] = 0.0f;
+            }
+        }
+
+        //
+        // Step through each packed panel of B. A panel holds AlignedK rows,
+        // and this chunk starts at row pair k / 2 of the panel.
+        //
+
+        for (size_t n = 0; n < CountN; n += MLAS_SBGEMM_AVX2_PANEL_N) {
+
+            const bfloat16_t* b = B + n * AlignedK + k * MLAS_SBGEMM_AVX2_PANEL_N;
+            const size_t CountPanelN = std::min(CountN - n, size_t(MLAS_SBGEMM_AVX2_PANEL_N));
+            const float* bias = (Bias != nullptr) ? Bias + n : nullptr;
+
+            switch (RowCount) {
+                case 4:
+                    MlasSBGemmComputeBlockAvx2<4>(ABuffer, PairCount, b, C + n, ldc, CountPanelN, bias, ChunkZeroMode);
+                    break;
+                case 3:
+                    MlasSBGemmComputeBlockAvx2<3>(ABuffer, PairCount, b, C + n, ldc, CountPanelN, bias, ChunkZeroMode);
+                    break;
+                case 2:
+                    MlasSBGemmComputeBlockAvx2<2>(ABuffer, PairCount, b, C + n, ldc, CountPanelN, bias, ChunkZeroMode);
+                    break;
+                default:
+                    MlasSBGemmComputeBlockAvx2<1>(ABuffer, PairCount, b, C + n, ldc, CountPanelN, bias, ChunkZeroMode);
+                    break;
+            }
+        }
+    }
+
+    return RowCount;
+}
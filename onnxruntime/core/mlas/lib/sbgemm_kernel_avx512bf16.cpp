@@ -0,0 +1,273 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 precision GEMM kernel for
+    AVX512-BF16.
+
+    Each vdpbf16ps multiplies a pair of rows of a packed panel of B by a
+    broadcast pair of elements of A and accumulates both products into the
+    16 single precision columns of the panel.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of columns in a packed panel of B and the number of rows
+// of A converted to bfloat16 at a time.
+//
+
+#define MLAS_SBGEMM_AVX512BF16_PANEL_N          16
+#define MLAS_SBGEMM_AVX512BF16_STRIDE_K         256
+
+template <size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeBlockAvx512Bf16(
+    const uint32_t* ABuffer,
+    size_t PairCount,
+    const bfloat16_t* B,
+    size_t PanelStride,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of RowCount rows by PanelCount packed panels
+    of matrix C.
+
+Arguments:
+
+    ABuffer - Supplies the rows of A converted to pairs of bfloat16 values,
+        with a row stride of MLAS_SBGEMM_AVX512BF16_STRIDE_K / 2 pairs.
+
+    PairCount - Supplies the number of row pairs of the packed panels.
+
+    B - Supplies the first packed panel of B.
+
+    PanelStride - Supplies the number of elements between packed panels.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the panels to store.
+
+    Bias - Optionally supplies the bias added in ZeroMode.
+
+    ZeroMode - Supplies true if the output overwrites C, else the output is
+        accumulated into C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t j = 0; j < PanelCount; j++) {
+            Accumulators[r][j] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t p = 0; p < PairCount; p++) {
+
+        __m512bh Packed[PanelCount];
+
+        for (size_t j = 0; j < PanelCount; j++) {
+            Packed[j] = (__m512bh)_mm512_loadu_si512(B + j * PanelStride + p * 32);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const __m512bh APair = (__m512bh)_mm512_set1_epi32(
+                int32_t(ABuffer[r * (MLAS_SBGEMM_AVX512BF16_STRIDE_K / 2) + p]));
+
+            for (size_t j = 0; j < PanelCount; j++) {
+                Accumulators[r][j] = _mm512_dpbf16_ps(Accumulators[r][j], APair, Packed[j]);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < PanelCount; j++) {
+
+        const size_t CountPanelN = std::min(CountN - j * MLAS_SBGEMM_AVX512BF16_PANEL_N,
+                                            size_t(MLAS_SBGEMM_AVX512BF16_PANEL_N));
+        const __mmask16 Mask = __mmask16((uint32_t(1) << CountPanelN) - 1);
+
+        __m512 Addend = _mm512_setzero_ps();
+
+        if (ZeroMode && Bias != nullptr) {
+            Addend = _mm512_maskz_loadu_ps(Mask, Bias + j * MLAS_SBGEMM_AVX512BF16_PANEL_N);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            float* c = C + r * ldc + j * MLAS_SBGEMM_AVX512BF16_PANEL_N;
+
+            if (!ZeroMode) {
+                Addend = _mm512_maskz_loadu_ps(Mask, c);
+            }
+
+            _mm512_mask_storeu_ps(c, Mask, _mm512_add_ps(Accumulators[r][j], Addend));
+        }
+    }
+}
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSBGemmComputeRowsAvx512Bf16(
+    const uint32_t* ABuffer,
+    size_t PairCount,
+    const bfloat16_t* B,
+    size_t AlignedK,
+    size_t StartK,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    const float* Bias,
+    bool ZeroMode
+    )
+{
+    const size_t PanelStride = AlignedK * MLAS_SBGEMM_AVX512BF16_PANEL_N;
+
+    //
+    // Step through the packed panels of B two at a time. A panel holds
+    // AlignedK rows, and this chunk starts at row pair StartK / 2 of the panel.
+    //
+
+    for (size_t n = 0; n < CountN; n += 2 * MLAS_SBGEMM_AVX512BF16_PANEL_N) {
+
+        const bfloat16_t* b = B + n * AlignedK + StartK * MLAS_SBGEMM_AVX512BF16_PANEL_N;
+        const size_t CountBlockN = std::min(CountN - n, size_t(2 * MLAS_SBGEMM_AVX512BF16_PANEL_N));
+        const float* bias = (Bias != nullptr) ? Bias + n : nullptr;
+
+        if (CountBlockN > MLAS_SBGEMM_AVX512BF16_PANEL_N) {
+            MlasSBGemmComputeBlockAvx512Bf16<RowCount, 2>(ABuffer, PairCount, b, PanelStride, C + n, ldc,
+                                                          CountBlockN, bias, ZeroMode);
+        } else {
+            MlasSBGemmComputeBlockAvx512Bf16<RowCount, 1>(ABuffer, PairCount, b, PanelStride, C + n, ldc,
+                                                          CountBlockN, bias, ZeroMode);
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasSbgemmKernelAvx512Bf16(
+    const float* A,
+    const bfloat16_t* B,
+    float* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    const float* Bias,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to four rows of the matrix product of A and the
+    packed bfloat16 matrix B.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of
+        rows of matrix B.
+
+    CountM - Supplies the maximum number of rows that can be processed.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Bias - Optionally supplies the bias vector added in ZeroMode.
+
+    ZeroMode - Supplies true if the output overwrites C, else the output is
+        accumulated into C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(uint32_t ABuffer[4 * MLAS_SBGEMM_AVX512BF16_STRIDE_K / 2], 64);
+
+    const size_t RowCount = std::min(CountM, size_t(4));
+    const size_t AlignedK = (CountK + 1) & ~size_t(1);
+
+    for (size_t k = 0; k < CountK; k += MLAS_SBGEMM_AVX512BF16_STRIDE_K) {
+
+        const size_t CountChunkK = std::min(CountK - k, size_t(MLAS_SBGEMM_AVX512BF16_STRIDE_K));
+        const size_t PairCount = (CountChunkK + 1) / 2;
+        const bool ChunkZeroMode = ZeroMode && (k == 0);
+
+        //
+        // Convert this chunk of the rows of A to pairs of bfloat16 values,
+        // padding an odd row count with a zero.
+        //
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const float* a = A + r * lda + k;
+            uint32_t* buffer = ABuffer + r * (MLAS_SBGEMM_AVX512BF16_STRIDE_K / 2);
+
+            for (size_t i = 0; i < CountChunkK; i += 32) {
+
+                const size_t CountLow = std::min(CountChunkK - i, size_t(16));
+                const size_t CountHigh = std::min(CountChunkK - i - CountLow, size_t(16));
+
+                const __m512 Low = _mm512_maskz_loadu_ps(__mmask16((uint32_t(1) << CountLow) - 1), a + i);
+                const __m512 High = _mm512_maskz_loadu_ps(__mmask16((uint32_t(1) << CountHigh) - 1), a + i + 16);
+
+                _mm512_store_si512(buffer + i / 2, (__m512i)_mm512_cvtne2ps_pbh(High, Low));
+            }
+        }
+
+        switch (RowCount) {
+            case 4:
+                MlasSBGemmComputeRowsAvx512Bf16<4>(ABuffer, PairCount, B, AlignedK, k, C, ldc, CountN, Bias, ChunkZeroMode);
+                break;
+            case 3:
+                MlasSBGemmComputeRowsAvx512Bf16<3>(ABuffer, PairCount, B, AlignedK, k, C, ldc, CountN, Bias, ChunkZeroMode);
+                break;
+            case 2:
+                MlasSBGemmComputeRowsAvx512Bf16<2>(ABuffer, PairCount, B, AlignedK, k, C, ldc, CountN, Bias, ChunkZeroMode);
+                break;
+            default:
+                MlasSBGemmComputeRowsAvx512Bf16<1>(ABuffer, PairCount, B, AlignedK, k, C, ldc, CountN, Bias, ChunkZeroMode);
+                break;
+        }
+    }
+
+    return RowCount;
+}
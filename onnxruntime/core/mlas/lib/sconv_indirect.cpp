@@ -0,0 +1,426 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sconv_indirect.cpp
+
+Abstract:
+
+    This module implements the single precision channels last convolution
+    operation using an indirection buffer.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of output pixels gathered into the local panel per pass
+// over the packed filter.
+//
+
+#define MLAS_CONV_INDIRECT_ROWS             32
+
+size_t
+MLASCALL
+MlasConvIndirectPackWSize(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed filter buffer.
+
+Arguments:
+
+    OutputChannels - Supplies the number of filters.
+
+    InputChannels - Supplies the number of input channels per filter.
+
+    KernelSize - Supplies the number of kernel positions.
+
+Return Value:
+
+    Returns the size in bytes for the packed filter buffer.
+
+--*/
+{
+    const size_t AlignedN = (OutputChannels + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const size_t BytesRequired = AlignedN * InputChannels * KernelSize * sizeof(float);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+void
+MLASCALL
+MlasConvIndirectPackW(
+    size_t OutputChannels,
+    size_t InputChannels,
+    size_t KernelSize,
+    const float* Filter,
+    size_t ldf,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the filter for use by MlasConvIndirect.
+
+    The packed format is private to the indirect convolution and is not
+    affected by platform overrides of MlasGemmPackB.
+
+Arguments:
+
+    OutputChannels - Supplies the number of filters.
+
+    InputChannels - Supplies the number of input channels per filter.
+
+    KernelSize - Supplies the number of kernel positions.
+
+    Filter - Supplies the filter as a (KernelSize * InputChannels) x
+        OutputChannels row major matrix, where the rows are ordered by kernel
+        position and then input channel.
+
+    ldf - Supplies the number of elements per row of the filter.
+
+    PackedFilter - Supplies the address of the packed filter buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t K = InputChannels * KernelSize;
+    const size_t AlignedN = (OutputChannels + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    float* D = reinterpret_cast<float*>(PackedFilter);
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+
+        MlasSgemmCopyPackB(D, Filter + k * ldf, ldf, OutputChannels, CountK);
+
+        D += AlignedN * CountK;
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvIndirectGather(
+    float* Panel,
+    const float* const* Input,
+    size_t InputOffset,
+    size_t InputChannels,
+    size_t KernelSize,
+    size_t CountM,
+    size_t k,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a slice of the convolution patches for a set of output
+    pixels from the indirection buffer into a local panel.
+
+Arguments:
+
+    Panel - Supplies the panel receiving CountM rows of CountK elements.
+
+    Input - Supplies the indirection buffer for the first output pixel.
+
+    InputOffset - Supplies the channel offset added to every input pointer.
+
+    InputChannels - Supplies the number of input channels per kernel position.
+
+    KernelSize - Supplies the number of kernel positions.
+
+    CountM - Supplies the number of output pixels.
+
+    k - Supplies the first patch element to copy.
+
+    CountK - Supplies the number of patch elements to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t StartPosition = k / InputChannels;
+    const size_t StartChannel = k % InputChannels;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        const float* const* PixelInput = Input + m * KernelSize;
+        size_t Position = StartPosition;
+        size_t Channel = StartChannel;
+        size_t Remaining = CountK;
+
+        while (Remaining > 0) {
+
+            const size_t CopyCount = std::min(InputChannels - Channel, Remaining);
+
+            std::copy_n(PixelInput[Position] + InputOffset + Channel, CopyCount, Panel);
+
+            Panel += CopyCount;
+            Remaining -= CopyCount;
+            Position++;
+            Channel = 0;
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvIndirectPostProcess(
+    const MLAS_CONV_INDIRECT_PARAMS& Params,
+    float* Output,
+    size_t CountM
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the bias and applies the activation to a set of output
+    pixels.
+
+Arguments:
+
+    Params - Supplies the convolution parameters.
+
+    Output - Supplies the first output pixel.
+
+    CountM - Supplies the number of output pixels.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t N = Params.OutputChannels;
+
+    if (Params.Bias != nullptr) {
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            float* c = Output + m * Params.OutputStride;
+            size_t n = 0;
+
+            for (; n + 4 <= N; n += 4) {
+                MlasStoreFloat32x4(c + n, MlasAddFloat32x4(MlasLoadFloat32x4(c + n),
+                    MlasLoadFloat32x4(Params.Bias + n)));
+            }
+
+            for (; n < N; n++) {
+                c[n] += Params.Bias[n];
+            }
+        }
+    }
+
+    if (Params.Activation != nullptr &&
+        Params.Activation->ActivationKind != MlasIdentityActivation) {
+        MlasActivation(Params.Activation, Output, nullptr, CountM, N, Params.OutputStride);
+    }
+}
+
+void
+MLASCALL
+MlasConvIndirect(
+    const MLAS_CONV_INDIRECT_PARAMS& Params
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision channels last convolution
+    for a range of output pixels of one group.
+
+    Output = Activation(Patches * Filter + Bias + Beta * Output)
+
+    With an indirection buffer, the patches of up to MLAS_CONV_INDIRECT_ROWS
+    output pixels are gathered one packed K slice at a time into a local panel
+    that stays in the L1 cache, and are multiplied with the packed filter
+    before the next slice is gathered. Pointwise convolutions read the input
+    directly.
+
+Arguments:
+
+    Params - Supplies the convolution parameters.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t N = Params.OutputChannels;
+    const size_t K = Params.InputChannels * Params.KernelSize;
+    const size_t AlignedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    if (Params.InputIndirection == nullptr) {
+
+        MlasSgemmPackedOperation(CblasNoTrans, Params.OutputCount, 0, N, K, 1.0f,
+            Params.InputDirect + Params.InputOffset, Params.InputStride,
+            Params.PackedFilter, AlignedN, Params.Beta, Params.Output,
+            Params.OutputStride);
+
+        MlasConvIndirectPostProcess(Params, Params.Output, Params.OutputCount);
+        return;
+    }
+
+    MLAS_DECLSPEC_ALIGN(float Panel[MLAS_CONV_INDIRECT_ROWS * MLAS_SGEMM_PACKED_STRIDEK], 64);
+
+    const float* const* Input = Params.InputIndirection;
+    float* Output = Params.Output;
+
+    size_t CountM;
+
+    for (size_t m = 0; m < Params.OutputCount; m += CountM) {
+
+        CountM = std::min(Params.OutputCount - m, size_t(MLAS_CONV_INDIRECT_ROWS));
+
+        //
+        // Step through the packed filter one K slice at a time, so that the
+        // packed layout matches a GEMM with K no larger than the slice.
+        //
+
+        const float* PackedFilter = reinterpret_cast<const float*>(Params.PackedFilter);
+        float beta = Params.Beta;
+        size_t CountK;
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+
+            MlasConvIndirectGather(Panel, Input, Params.InputOffset, Params.InputChannels,
+                Params.KernelSize, CountM, k, CountK);
+
+            MlasSgemmPackedOperation(CblasNoTrans, CountM, 0, N, CountK, 1.0f, Panel,
+                CountK, PackedFilter, AlignedN, beta, Output, Params.OutputStride);
+
+            PackedFilter += AlignedN * CountK;
+            beta = 1.0f;
+        }
+
+        MlasConvIndirectPostProcess(Params, Output, CountM);
+
+        Input += CountM * Params.KernelSize;
+        Output += CountM * Params.OutputStride;
+    }
+}
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    float Beta,
+    const MLAS_ACTIVATION* Activation
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision channels last depthwise
+    convolution for a range of output pixels using an indirection buffer.
+
+Arguments:
+
+    Input - Supplies the indirection buffer with KernelSize pointers per
+        output pixel.
+
+    Filter - Supplies the filter as a KernelSize x Channels matrix.
+
+    Bias - Optionally supplies the bias vector.
+
+    Output - Supplies the output buffer with Channels elements per pixel.
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of kernel positions.
+
+    Beta - Supplies the scale applied to the existing output before
+        accumulation, typically 0 or 1.
+
+    Activation - Optionally supplies the activation to apply.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 BetaVector = MlasBroadcastFloat32x4(Beta);
+    float* OutputRow = Output;
+
+    for (size_t i = 0; i < OutputCount; i++) {
+
+        size_t c = 0;
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = (Bias == nullptr) ? MlasZeroFloat32x4() : MlasLoadFloat32x4(Bias + c);
+
+            if (Beta != 0.0f) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(OutputRow + c), BetaVector, Accumulator);
+            }
+
+            const float* f = Filter + c;
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Input[k] + c),
+                    MlasLoadFloat32x4(f), Accumulator);
+                f += Channels;
+            }
+
+            MlasStoreFloat32x4(OutputRow + c, Accumulator);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = (Bias == nullptr) ? 0.0f : Bias[c];
+
+            if (Beta != 0.0f) {
+                Accumulator += OutputRow[c] * Beta;
+            }
+
+            for (size_t k = 0; k < KernelSize; k++) {
+                Accumulator += Input[k][c] * Filter[k * Channels + c];
+            }
+
+            OutputRow[c] = Accumulator;
+        }
+
+        Input += KernelSize;
+        OutputRow += Channels;
+    }
+
+    if (Activation != nullptr && Activation->ActivationKind != MlasIdentityActivation) {
+        MlasActivation(Activation, Output, nullptr, OutputCount, Channels, Channels);
+    }
+}
@@ -0,0 +1,898 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sconv_winograd.cpp
+
+Abstract:
+
+    This module implements the single precision Winograd convolution for 3x3
+    filters with unit stride and dilation.
+
+    The output image is split into TileSize x TileSize tiles. Each tile of
+    (TileSize + 2) x (TileSize + 2) input elements is transformed into the
+    Winograd domain, the element wise products over the input channels are
+    computed as one SGEMM per transformed element against the pretransformed
+    filter, and the results are transformed back to the output tile.
+
+    F(2x2,3x3) needs 16 multiplies per output tile instead of 36 and
+    F(4x4,3x3) needs 36 instead of 144.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the maximum number of tiles processed per block and the target size
+// in elements of the per thread working buffer.
+//
+
+#define MLAS_WINOGRAD_MAXIMUM_TILE_BLOCK        32
+#define MLAS_WINOGRAD_TARGET_BLOCK_ELEMENTS     (256 * 1024)
+
+//
+// Define the minimum channel counts for which the transforms are amortized
+// by the element wise products.
+//
+
+#define MLAS_WINOGRAD_MINIMUM_CHANNELS          8
+
+template<size_t TileSize>
+struct MLAS_WINOGRAD_TRANSFORM;
+
+//
+// F(2x2,3x3) transforms.
+//
+//  B^T = | 1  0 -1  0 |    G = | 1    0    0   |    A^T = | 1  1  1  0 |
+//        | 0  1  1  0 |        | 1/2  1/2  1/2 |          | 0  1 -1 -1 |
+//        | 0 -1  1  0 |        | 1/2 -1/2  1/2 |
+//        | 0  1  0 -1 |        | 0    0    1   |
+//
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<2>
+{
+    static constexpr size_t Alpha = 4;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Input(
+        const float* d,
+        size_t ds,
+        float* v,
+        size_t vs
+        )
+    {
+        v[0 * vs] = d[0 * ds] - d[2 * ds];
+        v[1 * vs] = d[1 * ds] + d[2 * ds];
+        v[2 * vs] = d[2 * ds] - d[1 * ds];
+        v[3 * vs] = d[1 * ds] - d[3 * ds];
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Filter(
+        const float* g,
+        size_t gs,
+        float* u,
+        size_t us
+        )
+    {
+        u[0 * us] = g[0];
+        u[1 * us] = 0.5f * (g[0] + g[gs] + g[2 * gs]);
+        u[2 * us] = 0.5f * (g[0] - g[gs] + g[2 * gs]);
+        u[3 * us] = g[2 * gs];
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Output(
+        const float* m,
+        size_t ms,
+        float* o,
+        size_t os
+        )
+    {
+        o[0 * os] = m[0 * ms] + m[1 * ms] + m[2 * ms];
+        o[1 * os] = m[1 * ms] - m[2 * ms] - m[3 * ms];
+    }
+};
+
+//
+// F(4x4,3x3) transforms.
+//
+//  B^T = | 4  0 -5  0  1  0 |    G = |  1/4    0     0   |
+//        | 0 -4 -4  1  1  0 |        | -1/6  -1/6  -1/6  |
+//        | 0  4 -4 -1  1  0 |        | -1/6   1/6  -1/6  |
+//        | 0 -2 -1  2  1  0 |        |  1/24  1/12  1/6  |
+//        | 0  2 -1 -2  1  0 |        |  1/24 -1/12  1/6  |
+//        | 0  4  0 -5  0  1 |        |  0     0     1    |
+//
+//  A^T = | 1  1  1  1  1  0 |
+//        | 0  1 -1  2 -2  0 |
+//        | 0  1  1  4  4  0 |
+//        | 0  1 -1  8 -8  1 |
+//
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<4>
+{
+    static constexpr size_t Alpha = 6;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Input(
+        const float* d,
+        size_t ds,
+        float* v,
+        size_t vs
+        )
+    {
+        const float d0 = d[0 * ds];
+        const float d1 = d[1 * ds];
+        const float d2 = d[2 * ds];
+        const float d3 = d[3 * ds];
+        const float d4 = d[4 * ds];
+        const float d5 = d[5 * ds];
+
+        const float t0 = d4 - 4.0f * d2;
+        const float t1 = d3 - 4.0f * d1;
+        const float t2 = d4 - d2;
+        const float t3 = 2.0f * (d3 - d1);
+
+        v[0 * vs] = 4.0f * d0 - 5.0f * d2 + d4;
+        v[1 * vs] = t0 + t1;
+        v[2 * vs] = t0 - t1;
+        v[3 * vs] = t2 + t3;
+        v[4 * vs] = t2 - t3;
+        v[5 * vs] = 4.0f * d1 - 5.0f * d3 + d5;
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Filter(
+        const float* g,
+        size_t gs,
+        float* u,
+        size_t us
+        )
+    {
+        const float g0 = g[0];
+        const float g1 = g[gs];
+        const float g2 = g[2 * gs];
+
+        u[0 * us] = g0 / 4.0f;
+        u[1 * us] = -(g0 + g1 + g2) / 6.0f;
+        u[2 * us] = -(g0 - g1 + g2) / 6.0f;
+        u[3 * us] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+        u[4 * us] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+        u[5 * us] = g2;
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Output(
+        const float* m,
+        size_t ms,
+        float* o,
+        size_t os
+        )
+    {
+        const float t0 = m[1 * ms] + m[2 * ms];
+        const float t1 = m[1 * ms] - m[2 * ms];
+        const float t2 = m[3 * ms] + m[4 * ms];
+        const float t3 = m[3 * ms] - m[4 * ms];
+
+        o[0 * os] = m[0 * ms] + t0 + t2;
+        o[1 * os] = t1 + 2.0f * t3;
+        o[2 * os] = t0 + 4.0f * t2;
+        o[3 * os] = t1 + 8.0f * t3 + m[5 * ms];
+    }
+};
+
+size_t
+MLASCALL
+MlasConvWinogradSelectTileSize(
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t OutputHeight,
+    size_t OutputWidth
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the Winograd output tile size for a 3x3 convolution
+    with unit stride and dilation.
+
+Arguments:
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    OutputHeight - Supplies the output height, or zero if not known.
+
+    OutputWidth - Supplies the output width, or zero if not known.
+
+Return Value:
+
+    Returns 4 for F(4x4,3x3), 2 for F(2x2,3x3), else 0 if the direct
+    convolution is expected to be faster.
+
+--*/
+{
+    //
+    // The input and output transforms are linear in the channel counts while
+    // the element wise products are quadratic, so small channel counts do
+    // not benefit.
+    //
+
+    if (InputChannels < MLAS_WINOGRAD_MINIMUM_CHANNELS ||
+        FilterCount < MLAS_WINOGRAD_MINIMUM_CHANNELS) {
+        return 0;
+    }
+
+    if (OutputHeight == 0 || OutputWidth == 0) {
+        return 4;
+    }
+
+    //
+    // Larger tiles waste more of the computation on the partial tiles at the
+    // right and bottom edges of small images.
+    //
+
+    if (OutputHeight >= 8 && OutputWidth >= 8) {
+        return 4;
+    }
+
+    if (OutputHeight >= 2 && OutputWidth >= 2) {
+        return 2;
+    }
+
+    return 0;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the pretransformed filter
+    buffer.
+
+Arguments:
+
+    TileSize - Supplies the output tile size (2 or 4).
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+Return Value:
+
+    Returns the size in bytes for the pretransformed filter buffer.
+
+--*/
+{
+    const size_t Alpha = TileSize + 2;
+    const size_t AlignedN = (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const size_t BytesRequired = GroupCount * Alpha * Alpha * AlignedN * InputChannels * sizeof(float);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradPackFilterImpl(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    )
+{
+    using Transform = MLAS_WINOGRAD_TRANSFORM<TileSize>;
+    constexpr size_t Alpha = Transform::Alpha;
+
+    const size_t AlignedN = (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // Transform every filter to a InputChannels x FilterCount matrix per
+    // Winograd element, then pack each matrix as the B operand of an SGEMM.
+    //
+
+    std::unique_ptr<float[]> Transformed(new float[Alpha * Alpha * InputChannels * FilterCount]);
+    const size_t TransformedStride = InputChannels * FilterCount;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g3x3 = Filter + (f * InputChannels + c) * 9;
+                float Temp[Alpha * 3];
+                float* u = Transformed.get() + c * FilterCount + f;
+
+                //
+                // Temp = G * g, then U = Temp * G^T.
+                //
+
+                for (size_t j = 0; j < 3; j++) {
+                    Transform::Filter(g3x3 + j, 3, Temp + j, 3);
+                }
+
+                for (size_t i = 0; i < Alpha; i++) {
+                    Transform::Filter(Temp + i * 3, 1, u + i * Alpha * TransformedStride,
+                        TransformedStride);
+                }
+            }
+        }
+
+        for (size_t e = 0; e < Alpha * Alpha; e++) {
+
+            const float* B = Transformed.get() + e * TransformedStride;
+            size_t CountK;
+
+            for (size_t k = 0; k < InputChannels; k += CountK) {
+
+                CountK = std::min(InputChannels - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+
+                MlasSgemmCopyPackB(PackedFilter, B + k * FilterCount, FilterCount,
+                    FilterCount, CountK);
+
+                PackedFilter += AlignedN * CountK;
+            }
+        }
+
+        Filter += FilterCount * InputChannels * 9;
+    }
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter to the Winograd domain and packs it for
+    use by MlasConvWinograd.
+
+Arguments:
+
+    TileSize - Supplies the output tile size (2 or 4).
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    Filter - Supplies the filter tensor in the layout of the Conv operator,
+        GroupCount * FilterCount x InputChannels x 3 x 3.
+
+    PackedFilter - Supplies the address of the packed filter buffer, which
+        must be aligned as for MlasGemmPackB.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (TileSize == 4) {
+        MlasConvWinogradPackFilterImpl<4>(GroupCount, InputChannels, FilterCount, Filter,
+            reinterpret_cast<float*>(PackedFilter));
+    } else {
+        MlasConvWinogradPackFilterImpl<2>(GroupCount, InputChannels, FilterCount, Filter,
+            reinterpret_cast<float*>(PackedFilter));
+    }
+}
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters;
+    const float* Input;
+    const void* PackedFilter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    size_t TileBlock;
+    size_t BlocksPerImage;
+    size_t WorkingBufferSizePerThread;
+    ptrdiff_t ThreadCount;
+};
+
+static
+size_t
+MlasConvWinogradTileBlock(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of tiles processed per block so that the
+    transformed tiles of a block stay close to the target working set.
+
+--*/
+{
+    const size_t Alpha = Parameters->TileSize + 2;
+    const size_t ElementsPerTile =
+        Alpha * Alpha * (Parameters->InputChannels + Parameters->FilterCount);
+
+    size_t TileBlock = MLAS_WINOGRAD_TARGET_BLOCK_ELEMENTS / ElementsPerTile;
+
+    return std::min(std::max(TileBlock, size_t(4)), size_t(MLAS_WINOGRAD_MAXIMUM_TILE_BLOCK));
+}
+
+static
+size_t
+MlasConvWinogradWorkingBufferSizePerThread(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters,
+    size_t TileBlock
+    )
+{
+    const size_t TileSize = Parameters->TileSize;
+    const size_t Alpha = TileSize + 2;
+
+    return Alpha * Alpha * TileBlock * (Parameters->InputChannels + Parameters->FilterCount) +
+        TileSize * TileSize * TileBlock * Parameters->FilterCount;
+}
+
+static
+ptrdiff_t
+MlasConvWinogradThreadCount(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters,
+    size_t TileBlock,
+    MLAS_THREADPOOL* ThreadPool,
+    size_t* BlocksPerImage
+    )
+{
+    const size_t TileSize = Parameters->TileSize;
+    const size_t TileCount = ((Parameters->OutputHeight + TileSize - 1) / TileSize) *
+        ((Parameters->OutputWidth + TileSize - 1) / TileSize);
+
+    *BlocksPerImage = (TileCount + TileBlock - 1) / TileBlock;
+
+    const size_t BlockCount = Parameters->BatchCount * Parameters->GroupCount * (*BlocksPerImage);
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    return std::max(ThreadCount, ptrdiff_t(1));
+}
+
+size_t
+MLASCALL
+MlasConvWinogradGetWorkingBufferSize(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements to allocate for the working
+    buffer of MlasConvWinograd.
+
+Arguments:
+
+    Parameters - Supplies the convolution parameters.
+
+    ThreadPool - Supplies the thread pool object that will be passed to
+        MlasConvWinograd.
+
+Return Value:
+
+    Returns the number of float elements for the working buffer.
+
+--*/
+{
+    const size_t TileBlock = MlasConvWinogradTileBlock(Parameters);
+
+    size_t BlocksPerImage;
+    const ptrdiff_t ThreadCount =
+        MlasConvWinogradThreadCount(Parameters, TileBlock, ThreadPool, &BlocksPerImage);
+
+    return size_t(ThreadCount) * MlasConvWinogradWorkingBufferSizePerThread(Parameters, TileBlock);
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradBlock(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* Output,
+    size_t TileStart,
+    size_t TileCount,
+    float* WorkingBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output tiles for all filters of one
+    image and group.
+
+Arguments:
+
+    Parameters - Supplies the convolution parameters.
+
+    Input - Supplies the input channels of the image and group.
+
+    PackedFilter - Supplies the pretransformed filter of the group.
+
+    Bias - Optionally supplies the bias of the group.
+
+    Output - Supplies the output channels of the image and group.
+
+    TileStart - Supplies the index of the first tile in row major order.
+
+    TileCount - Supplies the number of tiles.
+
+    WorkingBuffer - Supplies the working buffer of the thread.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using Transform = MLAS_WINOGRAD_TRANSFORM<TileSize>;
+    constexpr size_t Alpha = Transform::Alpha;
+    constexpr size_t TileElements = TileSize * TileSize;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputHeight;
+    const size_t InputWidth = Parameters->InputWidth;
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputHeight = Parameters->OutputHeight;
+    const size_t OutputWidth = Parameters->OutputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+    const size_t TilesW = (OutputWidth + TileSize - 1) / TileSize;
+    const size_t AlignedN = (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+    const float Beta = Parameters->Beta;
+
+    //
+    // The working buffer holds the transformed input as one TileCount x
+    // InputChannels matrix per Winograd element, the element wise products as
+    // one TileCount x FilterCount matrix per Winograd element, and the output
+    // tiles as a FilterCount x (TileCount * TileElements) matrix.
+    //
+
+    const size_t VStride = TileCount * InputChannels;
+    const size_t MStride = TileCount * FilterCount;
+    const size_t OStride = TileCount * TileElements;
+
+    float* V = WorkingBuffer;
+    float* M = V + Alpha * Alpha * VStride;
+    float* O = M + Alpha * Alpha * MStride;
+
+    //
+    // Transform the input tiles.
+    //
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t ty = (TileStart + t) / TilesW;
+        const size_t tx = (TileStart + t) % TilesW;
+        const ptrdiff_t iy0 = ptrdiff_t(ty * TileSize) - ptrdiff_t(Parameters->PaddingTop);
+        const ptrdiff_t ix0 = ptrdiff_t(tx * TileSize) - ptrdiff_t(Parameters->PaddingLeft);
+
+        const bool Interior = iy0 >= 0 && ix0 >= 0 &&
+            size_t(iy0) + Alpha <= InputHeight && size_t(ix0) + Alpha <= InputWidth;
+
+        const float* input = Input;
+        float* v = V + t * InputChannels;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            float d[Alpha * Alpha];
+
+            if (Interior) {
+
+                const float* row = input + size_t(iy0) * InputWidth + size_t(ix0);
+
+                for (size_t i = 0; i < Alpha; i++) {
+                    for (size_t j = 0; j < Alpha; j++) {
+                        d[i * Alpha + j] = row[j];
+                    }
+                    row += InputWidth;
+                }
+
+            } else {
+
+                for (size_t i = 0; i < Alpha; i++) {
+
+                    const ptrdiff_t iy = iy0 + ptrdiff_t(i);
+
+                    for (size_t j = 0; j < Alpha; j++) {
+
+                        const ptrdiff_t ix = ix0 + ptrdiff_t(j);
+
+                        if (iy >= 0 && ix >= 0 && size_t(iy) < InputHeight && size_t(ix) < InputWidth) {
+                            d[i * Alpha + j] = input[size_t(iy) * InputWidth + size_t(ix)];
+                        } else {
+                            d[i * Alpha + j] = 0.0f;
+                        }
+                    }
+                }
+            }
+
+            //
+            // Temp = B^T * d, then V = Temp * B.
+            //
+
+            float Temp[Alpha * Alpha];
+
+            for (size_t j = 0; j < Alpha; j++) {
+                Transform::Input(d + j, Alpha, Temp + j, Alpha);
+            }
+
+            for (size_t i = 0; i < Alpha; i++) {
+                Transform::Input(Temp + i * Alpha, 1, v + i * Alpha * VStride, VStride);
+            }
+
+            input += InputSize;
+            v++;
+        }
+    }
+
+    //
+    // Compute the element wise products as one SGEMM per Winograd element.
+    //
+
+    const size_t PackedStride = AlignedN * InputChannels;
+
+    for (size_t e = 0; e < Alpha * Alpha; e++) {
+        MlasSgemmPackedOperation(CblasNoTrans, TileCount, 0, FilterCount, InputChannels, 1.0f,
+            V + e * VStride, InputChannels, PackedFilter + e * PackedStride, AlignedN, 0.0f,
+            M + e * MStride, FilterCount);
+    }
+
+    //
+    // Transform the output tiles and accumulate the existing output.
+    //
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t ty = (TileStart + t) / TilesW;
+        const size_t tx = (TileStart + t) % TilesW;
+        const size_t oy0 = ty * TileSize;
+        const size_t ox0 = tx * TileSize;
+        const size_t CountY = std::min(TileSize, OutputHeight - oy0);
+        const size_t CountX = std::min(TileSize, OutputWidth - ox0);
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            const float* m = M + t * FilterCount + f;
+            float* o = O + f * OStride + t * TileElements;
+
+            //
+            // Temp = A^T * m, then o = Temp * A.
+            //
+
+            float Temp[TileSize * Alpha];
+
+            for (size_t j = 0; j < Alpha; j++) {
+                Transform::Output(m + j * MStride, Alpha * MStride, Temp + j, Alpha);
+            }
+
+            for (size_t i = 0; i < TileSize; i++) {
+                Transform::Output(Temp + i * Alpha, 1, o + i * TileSize, 1);
+            }
+
+            if (Beta != 0.0f) {
+
+                const float* output = Output + f * OutputSize + oy0 * OutputWidth + ox0;
+
+                for (size_t i = 0; i < CountY; i++) {
+                    for (size_t j = 0; j < CountX; j++) {
+                        o[i * TileSize + j] += Beta * output[i * OutputWidth + j];
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // Apply the activation with optional bias and store the valid part of the
+    // output tiles.
+    //
+
+    MlasActivation(Parameters->Activation, O, Bias, FilterCount, OStride, OStride);
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t ty = (TileStart + t) / TilesW;
+        const size_t tx = (TileStart + t) % TilesW;
+        const size_t oy0 = ty * TileSize;
+        const size_t ox0 = tx * TileSize;
+        const size_t CountY = std::min(TileSize, OutputHeight - oy0);
+        const size_t CountX = std::min(TileSize, OutputWidth - ox0);
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            const float* o = O + f * OStride + t * TileElements;
+            float* output = Output + f * OutputSize + oy0 * OutputWidth + ox0;
+
+            for (size_t i = 0; i < CountY; i++) {
+                std::copy_n(o + i * TileSize, CountX, output + i * OutputWidth);
+            }
+        }
+    }
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a range of tile
+    blocks of a Winograd convolution.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = reinterpret_cast<const MLAS_CONV_WINOGRAD_WORK_BLOCK*>(Context);
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputGroupSize = InputChannels * Parameters->InputHeight * Parameters->InputWidth;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputHeight * Parameters->OutputWidth;
+    const size_t AlignedN = (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+        ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+    const size_t PackedGroupSize = (TileSize + 2) * (TileSize + 2) * AlignedN * InputChannels;
+    const size_t TileCount = ((Parameters->OutputHeight + TileSize - 1) / TileSize) *
+        ((Parameters->OutputWidth + TileSize - 1) / TileSize);
+
+    const size_t TileBlock = WorkBlock->TileBlock;
+    const size_t BlocksPerImage = WorkBlock->BlocksPerImage;
+    const size_t BlockCount = Parameters->BatchCount * GroupCount * BlocksPerImage;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer + Index * WorkBlock->WorkingBufferSizePerThread;
+
+    size_t BlockStart;
+    size_t BlockRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, BlockCount, &BlockStart, &BlockRemaining);
+
+    for (size_t block = BlockStart; block < BlockStart + BlockRemaining; block++) {
+
+        const size_t bg = block / BlocksPerImage;
+        const size_t group = bg % GroupCount;
+        const size_t TileStart = (block % BlocksPerImage) * TileBlock;
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount;
+        }
+
+        MlasConvWinogradBlock<TileSize>(Parameters, WorkBlock->Input + bg * InputGroupSize,
+            reinterpret_cast<const float*>(WorkBlock->PackedFilter) + group * PackedGroupSize,
+            bias, WorkBlock->Output + bg * OutputGroupSize, TileStart,
+            std::min(TileBlock, TileCount - TileStart), WorkingBuffer);
+    }
+}
+
+void
+MLASCALL
+MlasConvWinograd(
+    const MLAS_CONV_WINOGRAD_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution for a 3x3 filter with
+    unit stride and dilation on NCHW tensors.
+
+    Output = Activation(Conv(Input, Filter) + Bias + Beta * Output)
+
+Arguments:
+
+    Parameters - Supplies the convolution parameters.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter from MlasConvWinogradPackFilter with
+        the same tile size.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvWinogradGetWorkingBufferSize.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.PackedFilter = PackedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TileBlock = MlasConvWinogradTileBlock(Parameters);
+    WorkBlock.WorkingBufferSizePerThread =
+        MlasConvWinogradWorkingBufferSizePerThread(Parameters, WorkBlock.TileBlock);
+    WorkBlock.ThreadCount = MlasConvWinogradThreadCount(Parameters, WorkBlock.TileBlock,
+        ThreadPool, &WorkBlock.BlocksPerImage);
+
+    if (Parameters->TileSize == 4) {
+        MlasExecuteThreaded(MlasConvWinogradThreaded<4>, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+    } else {
+        MlasExecuteThreaded(MlasConvWinogradThreaded<2>, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+    }
+}
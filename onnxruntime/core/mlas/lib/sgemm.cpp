@@ -1640,6 +1640,317 @@ MlasGemmBatch(
 #pragma warning(pop)
 #endif
 
+//
+// Define the target number of tiles per thread for the grouped SGEMM
+// scheduler. Splitting the work finer than the thread count allows the cost
+// balancing to even out problems of different shapes.
+//
+
+#define MLAS_SGEMM_GROUPED_TILES_PER_THREAD 4
+
+static
+bool
+MlasSgemmGroupSharesB(
+    const MLAS_SGEMM_GROUP_PARAMS* Group
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether all problems of a group reference the same
+    unpacked matrix B and would benefit from packing it once for the group.
+
+Arguments:
+
+    Group - Supplies the group parameters.
+
+Return Value:
+
+    Returns true if matrix B should be packed once and shared by the group.
+
+--*/
+{
+    //
+    // A single row of matrix A uses the small-M path that reads matrix B in
+    // place, so there is nothing to share.
+    //
+
+    if (Group->BatchSize < 2 || Group->M <= 1 || Group->N == 0 || Group->K == 0) {
+        return false;
+    }
+
+    const MLAS_SGEMM_DATA_PARAMS* Data = Group->Data;
+
+    for (size_t i = 0; i < Group->BatchSize; i++) {
+        if (Data[i].BIsPacked || Data[i].B != Data[0].B || Data[i].ldb != Data[0].ldb) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+MLASCALL
+MlasGemmGrouped(
+    const MLAS_SGEMM_GROUP_PARAMS* Groups,
+    size_t GroupCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a grouped single precision matrix/matrix multiply
+    operation (SGEMM). The problems of all groups are split into tiles and the
+    tiles are distributed over the worker threads by their cost, so a batch of
+    small multiplications with different shapes is computed by one parallel
+    section.
+
+Arguments:
+
+    Groups - Supplies an array of group parameters.
+
+    GroupCount - Supplies the number of groups.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Preserve the behavior of the platform override by dispatching each
+    // group through the batched entry point.
+    //
+
+    if (GetMlasPlatform().MlasGemmBatchOverride != nullptr) {
+        for (size_t g = 0; g < GroupCount; g++) {
+            const MLAS_SGEMM_GROUP_PARAMS& Group = Groups[g];
+            if (Group.BatchSize > 0) {
+                MlasGemmBatch(Group.TransA, Group.TransB, Group.M, Group.N, Group.K,
+                    Group.Data, Group.BatchSize, ThreadPool);
+            }
+        }
+        return;
+    }
+
+    //
+    // Pack matrix B once for each group that shares it across its problems.
+    // The packing is done in slices along the K dimension so that the slices
+    // of all groups can be packed in parallel.
+    //
+
+    struct MLAS_SGEMM_GROUP_PACKED_B {
+        size_t Offset;
+        size_t AlignedN;
+        size_t SliceStart;
+    };
+
+    std::vector<MLAS_SGEMM_GROUP_PACKED_B> PackedGroups(GroupCount);
+    std::vector<size_t> PackedGroupIndex;
+    size_t PackedFloats = 0;
+    size_t PackSliceCount = 0;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+
+        PackedGroups[g].Offset = SIZE_MAX;
+
+        if (MlasSgemmGroupSharesB(&Groups[g])) {
+
+            const size_t AlignedN = (Groups[g].N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+                ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+            PackedGroups[g].Offset = PackedFloats;
+            PackedGroups[g].AlignedN = AlignedN;
+            PackedGroups[g].SliceStart = PackSliceCount;
+
+            PackedFloats += AlignedN * Groups[g].K;
+            PackSliceCount += MlasDivRoundup(Groups[g].K, MLAS_SGEMM_PACKED_STRIDEK);
+            PackedGroupIndex.push_back(g);
+        }
+    }
+
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    std::vector<float> PackedBuffer;
+    float* PackedB = nullptr;
+
+    if (PackedFloats > 0) {
+
+        PackedBuffer.resize(PackedFloats + BufferAlignment / sizeof(float));
+        PackedB = reinterpret_cast<float*>(
+            (reinterpret_cast<uintptr_t>(PackedBuffer.data()) + BufferAlignment - 1) & ~(BufferAlignment - 1));
+
+        MlasTrySimpleParallel(ThreadPool, ptrdiff_t(PackSliceCount), [&](ptrdiff_t tid) {
+
+            auto it = std::upper_bound(PackedGroupIndex.begin(), PackedGroupIndex.end(), size_t(tid),
+                [&](size_t slice, size_t g) { return slice < PackedGroups[g].SliceStart; });
+            const size_t g = *(it - 1);
+
+            const MLAS_SGEMM_GROUP_PARAMS& Group = Groups[g];
+            const size_t AlignedN = PackedGroups[g].AlignedN;
+            const size_t k = (size_t(tid) - PackedGroups[g].SliceStart) * MLAS_SGEMM_PACKED_STRIDEK;
+            const size_t CountK = std::min(Group.K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+            const float* B = Group.Data[0].B;
+            const size_t ldb = Group.Data[0].ldb;
+            float* D = PackedB + PackedGroups[g].Offset + AlignedN * k;
+
+            if (Group.TransB == CblasNoTrans) {
+                MlasSgemmCopyPackB(D, B + k * ldb, ldb, Group.N, CountK);
+            } else {
+                MlasSgemmTransposePackB(D, B + k, ldb, Group.N, CountK);
+            }
+        });
+    }
+
+    //
+    // Compute the total complexity of all problems and the number of target
+    // threads. Problems with K equal to zero still need to apply the beta
+    // multiplier, so count them as a single pass over the output.
+    //
+
+    double TotalComplexity = 0.0;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+        const MLAS_SGEMM_GROUP_PARAMS& Group = Groups[g];
+        TotalComplexity += double(Group.M) * double(Group.N) * double(std::max(Group.K, size_t(1))) *
+            double(Group.BatchSize);
+    }
+
+    if (TotalComplexity == 0.0) {
+        return;
+    }
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(TotalComplexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Split each problem of a group into tiles of roughly equal cost. As with
+    // the batched SGEMM, a problem is partitioned along N when N is larger
+    // than M and along M otherwise.
+    //
+
+    struct MLAS_SGEMM_GROUP_TILING {
+        double ProblemCost;
+        double TileCost;
+        ptrdiff_t ThreadCountM;
+        ptrdiff_t ThreadCountN;
+        size_t TileStart;
+        size_t TileCount;
+        double CostStart;
+    };
+
+    const double TargetTileCost = TotalComplexity /
+        double(TargetThreadCount * MLAS_SGEMM_GROUPED_TILES_PER_THREAD);
+
+    std::vector<MLAS_SGEMM_GROUP_TILING> Tilings(GroupCount);
+    size_t TotalTiles = 0;
+    double CostStart = 0.0;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+
+        const MLAS_SGEMM_GROUP_PARAMS& Group = Groups[g];
+        MLAS_SGEMM_GROUP_TILING& Tiling = Tilings[g];
+
+        Tiling.ProblemCost = double(Group.M) * double(Group.N) * double(std::max(Group.K, size_t(1)));
+        Tiling.TileStart = TotalTiles;
+        Tiling.TileCount = 0;
+        Tiling.CostStart = CostStart;
+        Tiling.ThreadCountM = 1;
+        Tiling.ThreadCountN = 1;
+        Tiling.TileCost = Tiling.ProblemCost;
+
+        if (Tiling.ProblemCost == 0.0 || Group.BatchSize == 0) {
+            Tiling.TileCost = 0.0;
+            continue;
+        }
+
+        size_t TilesPerProblem = size_t(std::ceil(Tiling.ProblemCost / TargetTileCost));
+
+        if (Group.N > Group.M) {
+            const size_t BlockedN = MlasDivRoundup(Group.N, MLAS_SGEMM_STRIDEN_THREAD_ALIGN);
+            TilesPerProblem = std::max(std::min(TilesPerProblem, BlockedN), size_t(1));
+            Tiling.ThreadCountN = ptrdiff_t(TilesPerProblem);
+        } else {
+            TilesPerProblem = std::max(std::min(TilesPerProblem, Group.M), size_t(1));
+            Tiling.ThreadCountM = ptrdiff_t(TilesPerProblem);
+        }
+
+        Tiling.TileCost = Tiling.ProblemCost / double(TilesPerProblem);
+        Tiling.TileCount = TilesPerProblem * Group.BatchSize;
+
+        TotalTiles += Tiling.TileCount;
+        CostStart += Tiling.ProblemCost * double(Group.BatchSize);
+    }
+
+    //
+    // Returns the index of the first tile whose cost midpoint is at or beyond
+    // the supplied cost. Each worker thread executes the tiles between the
+    // boundaries of its share of the total cost.
+    //
+
+    auto FirstTileAtCost = [&](double Cost) -> size_t {
+
+        auto it = std::upper_bound(Tilings.begin(), Tilings.end(), Cost,
+            [](double c, const MLAS_SGEMM_GROUP_TILING& t) { return c < t.CostStart; });
+
+        while (it != Tilings.begin() && (it - 1)->TileCount == 0) {
+            --it;
+        }
+
+        if (it == Tilings.begin()) {
+            return 0;
+        }
+
+        const MLAS_SGEMM_GROUP_TILING& Tiling = *(it - 1);
+        const double Position = (Cost - Tiling.CostStart) / Tiling.TileCost - 0.5;
+        const size_t LocalTile = (Position <= 0.0) ? 0 : std::min(size_t(std::ceil(Position)), Tiling.TileCount);
+
+        return Tiling.TileStart + LocalTile;
+    };
+
+    const ptrdiff_t WorkerCount = std::min(TargetThreadCount, ptrdiff_t(TotalTiles));
+
+    MlasTrySimpleParallel(ThreadPool, WorkerCount, [&](ptrdiff_t tid) {
+
+        const size_t TileBegin = (tid == 0) ? 0 :
+            FirstTileAtCost(TotalComplexity * double(tid) / double(WorkerCount));
+        const size_t TileEnd = (tid == WorkerCount - 1) ? TotalTiles :
+            FirstTileAtCost(TotalComplexity * double(tid + 1) / double(WorkerCount));
+
+        size_t g = 0;
+
+        for (size_t Tile = TileBegin; Tile < TileEnd; Tile++) {
+
+            while (Tile >= Tilings[g].TileStart + Tilings[g].TileCount) {
+                g++;
+            }
+
+            const MLAS_SGEMM_GROUP_PARAMS& Group = Groups[g];
+            const MLAS_SGEMM_GROUP_TILING& Tiling = Tilings[g];
+            const size_t TilesPerProblem = size_t(Tiling.ThreadCountM * Tiling.ThreadCountN);
+            const size_t LocalTile = Tile - Tiling.TileStart;
+
+            MLAS_SGEMM_DATA_PARAMS DataParams = Group.Data[LocalTile / TilesPerProblem];
+
+            if (PackedGroups[g].Offset != SIZE_MAX) {
+                DataParams.B = PackedB + PackedGroups[g].Offset;
+                DataParams.BIsPacked = true;
+            }
+
+            MlasSgemmThreaded(Tiling.ThreadCountM, Tiling.ThreadCountN, Group.TransA, Group.TransB,
+                Group.M, Group.N, Group.K, &DataParams, ptrdiff_t(LocalTile % TilesPerProblem));
+        }
+    });
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -0,0 +1,653 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse_sgemm.cpp
+
+Abstract:
+
+    This module implements the packing of a sparse matrix B and the driver of
+    the sparse single precision matrix/matrix multiply operation (sparse
+    SGEMM).
+
+    Weights that were pruned to a 2:4 pattern or to zero blocks are multiplied
+    without reading their zeros: the block format skips the zero 4 x 16 blocks
+    of B entirely, and the 2:4 format stores half of the values of B plus a
+    byte index per value, so the weights that are streamed from memory shrink
+    by 37.5%. The kernels are selected from the platform dispatch, with the
+    portable kernels below as the fallback.
+
+--*/
+
+#include "sparse_sgemm.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+//
+// Define the maximum fraction of nonzero 4 x 16 blocks for the block format to
+// be selected. The block kernels do the same work per block as the dense
+// SGEMM, so the zero blocks must cover enough of B to make up for the less
+// regular access pattern.
+//
+
+constexpr double MLAS_SPARSE_SGEMM_BLOCK_DENSITY_THRESHOLD = 0.5;
+
+//
+// Define the number of rows of matrix A and matrix C that a thread computes
+// for each panel of matrix B before moving on to the next panel.
+//
+
+constexpr size_t MLAS_SPARSE_SGEMM_STRIDE_M = 64;
+
+namespace
+{
+
+struct MLAS_SPARSE_SGEMM_MATRIX {
+    CBLAS_TRANSPOSE TransB;
+    size_t N;
+    size_t K;
+    const float* B;
+    size_t ldb;
+
+    float operator()(size_t k, size_t n) const
+    {
+        return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+    }
+
+    //
+    // Returns true if the 4 x 16 block of the panel at column n that starts at
+    // row k has a nonzero value.
+    //
+
+    bool BlockIsNonzero(size_t k, size_t n) const
+    {
+        const size_t CountK = std::min(K - k, MLAS_SPARSE_SGEMM_BLOCK_K);
+        const size_t CountN = std::min(N - n, MLAS_SPARSE_SGEMM_PANEL_N);
+
+        for (size_t kk = 0; kk < CountK; kk++) {
+            for (size_t nn = 0; nn < CountN; nn++) {
+                if ((*this)(k + kk, n + nn) != 0.0f) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    size_t BlockCount(size_t n) const
+    {
+        size_t Count = 0;
+
+        for (size_t k = 0; k < K; k += MLAS_SPARSE_SGEMM_BLOCK_K) {
+            Count += BlockIsNonzero(k, n) ? 1 : 0;
+        }
+
+        return Count;
+    }
+
+    bool Is2To4() const
+    {
+        for (size_t k = 0; k < K; k += MLAS_SPARSE_SGEMM_BLOCK_K) {
+            const size_t CountK = std::min(K - k, MLAS_SPARSE_SGEMM_BLOCK_K);
+            for (size_t n = 0; n < N; n++) {
+                size_t NonzeroCount = 0;
+                for (size_t kk = 0; kk < CountK; kk++) {
+                    NonzeroCount += ((*this)(k + kk, n) != 0.0f) ? 1 : 0;
+                }
+                if (NonzeroCount > 2) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+};
+
+size_t
+MlasSparseSgemmPanelCount(
+    size_t N
+    )
+{
+    return (N + MLAS_SPARSE_SGEMM_PANEL_N - 1) / MLAS_SPARSE_SGEMM_PANEL_N;
+}
+
+size_t
+MlasSparseSgemmGroupCount(
+    size_t K
+    )
+{
+    return (K + MLAS_SPARSE_SGEMM_BLOCK_K - 1) / MLAS_SPARSE_SGEMM_BLOCK_K;
+}
+
+size_t
+MlasSparseSgemmAlignPanel(
+    size_t Size
+    )
+{
+    return (Size + MLAS_SPARSE_SGEMM_PANEL_ALIGNMENT - 1) & ~(MLAS_SPARSE_SGEMM_PANEL_ALIGNMENT - 1);
+}
+
+size_t
+MlasSparseSgemmPanelSize(
+    MLAS_SPARSE_SGEMM_FORMAT Format,
+    const MLAS_SPARSE_SGEMM_MATRIX& Matrix,
+    size_t n
+    )
+{
+    if (Format == MlasSparseSgemmFormatBlock) {
+        const size_t BlockCount = Matrix.BlockCount(n);
+        return MlasSparseSgemmBlockValuesOffset(BlockCount) +
+               BlockCount * MLAS_SPARSE_SGEMM_BLOCK_K * MLAS_SPARSE_SGEMM_PANEL_N * sizeof(float);
+    }
+
+    return MlasSparseSgemmGroupCount(Matrix.K) * MLAS_SPARSE_SGEMM_2TO4_GROUP_SIZE;
+}
+
+size_t
+MlasSparseSgemmPanelsOffset(
+    size_t PanelCount
+    )
+{
+    return MlasSparseSgemmAlignPanel(sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER) + PanelCount * sizeof(uint64_t));
+}
+
+size_t
+MLASCALL
+MlasSparseSgemmBlockKernelPortable(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t BlockCount = *reinterpret_cast<const uint32_t*>(Panel);
+    const uint32_t* BlockK = reinterpret_cast<const uint32_t*>(Panel) + 1;
+    const float* Values = reinterpret_cast<const float*>(Panel + MlasSparseSgemmBlockValuesOffset(BlockCount));
+
+    float Accumulators[MLAS_SPARSE_SGEMM_PANEL_N];
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        std::fill_n(Accumulators, MLAS_SPARSE_SGEMM_PANEL_N, 0.0f);
+
+        const float* a = A + m * lda;
+
+        for (size_t b = 0; b < BlockCount; b++) {
+            const size_t k = BlockK[b];
+            const size_t BlockCountK = std::min(CountK - k, MLAS_SPARSE_SGEMM_BLOCK_K);
+            const float* v = Values + b * MLAS_SPARSE_SGEMM_BLOCK_K * MLAS_SPARSE_SGEMM_PANEL_N;
+
+            for (size_t kk = 0; kk < BlockCountK; kk++) {
+                const float AElement = a[k + kk];
+                for (size_t n = 0; n < MLAS_SPARSE_SGEMM_PANEL_N; n++) {
+                    Accumulators[n] += AElement * v[kk * MLAS_SPARSE_SGEMM_PANEL_N + n];
+                }
+            }
+        }
+
+        float* c = C + m * ldc;
+
+        for (size_t n = 0; n < CountN; n++) {
+            c[n] = ZeroMode ? alpha * Accumulators[n] : c[n] + alpha * Accumulators[n];
+        }
+    }
+
+    return CountM;
+}
+
+size_t
+MLASCALL
+MlasSparseSgemm2To4KernelPortable(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t GroupCount = MlasSparseSgemmGroupCount(CountK);
+
+    float Accumulators[MLAS_SPARSE_SGEMM_PANEL_N];
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        std::fill_n(Accumulators, MLAS_SPARSE_SGEMM_PANEL_N, 0.0f);
+
+        const float* a = A + m * lda;
+        const uint8_t* Group = Panel;
+
+        for (size_t g = 0; g < GroupCount; g++) {
+            const float* v = reinterpret_cast<const float*>(Group);
+            const uint8_t* Index = Group + 2 * MLAS_SPARSE_SGEMM_PANEL_N * sizeof(float);
+
+            for (size_t i = 0; i < 2 * MLAS_SPARSE_SGEMM_PANEL_N; i++) {
+                Accumulators[i % MLAS_SPARSE_SGEMM_PANEL_N] += a[g * MLAS_SPARSE_SGEMM_BLOCK_K + Index[i]] * v[i];
+            }
+
+            Group += MLAS_SPARSE_SGEMM_2TO4_GROUP_SIZE;
+        }
+
+        float* c = C + m * ldc;
+
+        for (size_t n = 0; n < CountN; n++) {
+            c[n] = ZeroMode ? alpha * Accumulators[n] : c[n] + alpha * Accumulators[n];
+        }
+    }
+
+    return CountM;
+}
+
+const MLAS_SPARSE_SGEMM_DISPATCH MlasSparseSgemmDispatchPortable = {
+    MlasSparseSgemmBlockKernelPortable,
+    MlasSparseSgemm2To4KernelPortable,
+};
+
+}  // namespace
+
+MLAS_SPARSE_SGEMM_FORMAT
+MLASCALL
+MlasSparseSgemmSelectFormat(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the sparse format to pack matrix B with.
+
+    The block format is preferred when at most half of the blocks of B have a
+    nonzero value, because it skips the work of the zero blocks and streams
+    less of B than the 2:4 format does. Otherwise the 2:4 format is selected
+    if B follows the 2:4 pattern.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    The sparse format, or MlasSparseSgemmFormatNone if B should be multiplied
+    by the dense SGEMM.
+
+--*/
+{
+    if (N == 0 || K == 0) {
+        return MlasSparseSgemmFormatNone;
+    }
+
+    const MLAS_SPARSE_SGEMM_MATRIX Matrix{TransB, N, K, B, ldb};
+
+    size_t BlockCount = 0;
+
+    for (size_t n = 0; n < N; n += MLAS_SPARSE_SGEMM_PANEL_N) {
+        BlockCount += Matrix.BlockCount(n);
+    }
+
+    const size_t TotalBlockCount = MlasSparseSgemmPanelCount(N) * MlasSparseSgemmGroupCount(K);
+
+    if (double(BlockCount) <= MLAS_SPARSE_SGEMM_BLOCK_DENSITY_THRESHOLD * double(TotalBlockCount)) {
+        return MlasSparseSgemmFormatBlock;
+    }
+
+    if (Matrix.Is2To4()) {
+        return MlasSparseSgemmFormat2To4;
+    }
+
+    return MlasSparseSgemmFormatNone;
+}
+
+size_t
+MLASCALL
+MlasSparseSgemmPackBSize(
+    MLAS_SPARSE_SGEMM_FORMAT Format,
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the size of the buffer that matrix B is packed to in
+    the given sparse format.
+
+Arguments:
+
+    Format - Supplies the sparse format.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    The size of the packed buffer in bytes, or zero if matrix B can not be
+    packed in the format.
+
+--*/
+{
+    if (N == 0 || K == 0 || Format == MlasSparseSgemmFormatNone) {
+        return 0;
+    }
+
+    const MLAS_SPARSE_SGEMM_MATRIX Matrix{TransB, N, K, B, ldb};
+
+    if (Format == MlasSparseSgemmFormat2To4 && !Matrix.Is2To4()) {
+        return 0;
+    }
+
+    const size_t PanelCount = MlasSparseSgemmPanelCount(N);
+
+    size_t BufferSize = MlasSparseSgemmPanelsOffset(PanelCount);
+
+    for (size_t n = 0; n < N; n += MLAS_SPARSE_SGEMM_PANEL_N) {
+        BufferSize += MlasSparseSgemmAlignPanel(MlasSparseSgemmPanelSize(Format, Matrix, n));
+    }
+
+    return BufferSize;
+}
+
+void
+MLASCALL
+MlasSparseSgemmPackB(
+    MLAS_SPARSE_SGEMM_FORMAT Format,
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs matrix B in the given sparse format.
+
+Arguments:
+
+    Format - Supplies the sparse format.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of the packed buffer, of the size returned
+        by MlasSparseSgemmPackBSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_SPARSE_SGEMM_MATRIX Matrix{TransB, N, K, B, ldb};
+    const size_t PanelCount = MlasSparseSgemmPanelCount(N);
+    const size_t GroupCount = MlasSparseSgemmGroupCount(K);
+
+    uint8_t* Buffer = static_cast<uint8_t*>(PackedB);
+    uint64_t* PanelOffsets = reinterpret_cast<uint64_t*>(Buffer + sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER));
+
+    size_t Offset = MlasSparseSgemmPanelsOffset(PanelCount);
+    size_t ValueCount = 0;
+
+    std::memset(Buffer, 0, Offset);
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        const size_t n = p * MLAS_SPARSE_SGEMM_PANEL_N;
+        const size_t CountN = std::min(N - n, MLAS_SPARSE_SGEMM_PANEL_N);
+        const size_t PanelSize = MlasSparseSgemmAlignPanel(MlasSparseSgemmPanelSize(Format, Matrix, n));
+        uint8_t* Panel = Buffer + Offset;
+
+        std::memset(Panel, 0, PanelSize);
+        PanelOffsets[p] = Offset;
+
+        if (Format == MlasSparseSgemmFormatBlock) {
+
+            const size_t BlockCount = Matrix.BlockCount(n);
+            uint32_t* BlockK = reinterpret_cast<uint32_t*>(Panel);
+            float* Values = reinterpret_cast<float*>(Panel + MlasSparseSgemmBlockValuesOffset(BlockCount));
+
+            *BlockK++ = static_cast<uint32_t>(BlockCount);
+
+            for (size_t k = 0; k < K; k += MLAS_SPARSE_SGEMM_BLOCK_K) {
+
+                if (!Matrix.BlockIsNonzero(k, n)) {
+                    continue;
+                }
+
+                *BlockK++ = static_cast<uint32_t>(k);
+
+                const size_t CountK = std::min(K - k, MLAS_SPARSE_SGEMM_BLOCK_K);
+
+                for (size_t kk = 0; kk < CountK; kk++) {
+                    for (size_t nn = 0; nn < CountN; nn++) {
+                        Values[kk * MLAS_SPARSE_SGEMM_PANEL_N + nn] = Matrix(k + kk, n + nn);
+                    }
+                }
+
+                Values += MLAS_SPARSE_SGEMM_BLOCK_K * MLAS_SPARSE_SGEMM_PANEL_N;
+            }
+
+            ValueCount += BlockCount * MLAS_SPARSE_SGEMM_BLOCK_K * MLAS_SPARSE_SGEMM_PANEL_N;
+
+        } else {
+
+            uint8_t* Group = Panel;
+
+            for (size_t g = 0; g < GroupCount; g++) {
+
+                const size_t k = g * MLAS_SPARSE_SGEMM_BLOCK_K;
+                const size_t CountK = std::min(K - k, MLAS_SPARSE_SGEMM_BLOCK_K);
+                float* Values = reinterpret_cast<float*>(Group);
+                uint8_t* Index = Group + 2 * MLAS_SPARSE_SGEMM_PANEL_N * sizeof(float);
+
+                //
+                // Keep the nonzero values of each column in the order of their
+                // rows. Columns with fewer than 2 nonzero values are padded
+                // with zeros at row 0 of the group.
+                //
+
+                for (size_t nn = 0; nn < CountN; nn++) {
+                    size_t Slot = 0;
+                    for (size_t kk = 0; kk < CountK && Slot < 2; kk++) {
+                        const float Value = Matrix(k + kk, n + nn);
+                        if (Value != 0.0f) {
+                            Values[Slot * MLAS_SPARSE_SGEMM_PANEL_N + nn] = Value;
+                            Index[Slot * MLAS_SPARSE_SGEMM_PANEL_N + nn] = static_cast<uint8_t>(kk);
+                            Slot++;
+                        }
+                    }
+                }
+
+                Group += MLAS_SPARSE_SGEMM_2TO4_GROUP_SIZE;
+            }
+
+            ValueCount += GroupCount * 2 * MLAS_SPARSE_SGEMM_PANEL_N;
+        }
+
+        Offset += PanelSize;
+    }
+
+    auto* Header = reinterpret_cast<MLAS_SPARSE_SGEMM_PACKED_HEADER*>(Buffer);
+    Header->Format = static_cast<uint32_t>(Format);
+    Header->PanelCount = static_cast<uint32_t>(PanelCount);
+    Header->N = N;
+    Header->K = K;
+    Header->ValueCount = ValueCount;
+}
+
+void
+MLASCALL
+MlasSparseSgemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const void* PackedB,
+    const MLAS_SPARSE_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes C = alpha * A * B + beta * C for each problem of the
+    batch, with matrix B packed by MlasSparseSgemmPackB.
+
+    The work is split into tiles of one panel of B by up to
+    MLAS_SPARSE_SGEMM_STRIDE_M rows of A. The tiles of a panel are consecutive
+    so each thread keeps the panel it works on in its cache.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    Data - Supplies an array of matrices data parameters.
+
+    BatchSize - Supplies the number of multiplications in this batch.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    const auto* Header = static_cast<const MLAS_SPARSE_SGEMM_PACKED_HEADER*>(PackedB);
+
+    assert(Header->N == N && Header->K == K);
+
+    const MLAS_SPARSE_SGEMM_DISPATCH* Dispatch = GetMlasPlatform().SparseSgemmDispatch;
+
+    if (Dispatch == nullptr) {
+        Dispatch = &MlasSparseSgemmDispatchPortable;
+    }
+
+    MLAS_SPARSE_SGEMM_KERNEL* Kernel = (Header->Format == MlasSparseSgemmFormatBlock) ?
+        Dispatch->BlockKernel : Dispatch->TwoToFourKernel;
+
+    const size_t PanelCount = Header->PanelCount;
+    const size_t BlockCountM = (M + MLAS_SPARSE_SGEMM_STRIDE_M - 1) / MLAS_SPARSE_SGEMM_STRIDE_M;
+    const size_t WorkCount = BatchSize * PanelCount * BlockCountM;
+
+    //
+    // Compute the number of target threads from the multiply-adds of the
+    // stored values only.
+    //
+
+    const double Complexity = double(M) * double(Header->ValueCount) * double(BatchSize);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+
+    TargetThreadCount = std::min(TargetThreadCount, MlasGetMaximumThreadCount(ThreadPool));
+    TargetThreadCount = std::min(TargetThreadCount, ptrdiff_t(WorkCount));
+
+    const uint64_t* PanelOffsets = MlasSparseSgemmPanelOffsets(PackedB);
+
+    MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, TargetThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+        for (; WorkRemaining > 0; WorkIndex++, WorkRemaining--) {
+
+            const size_t BlockM = WorkIndex % BlockCountM;
+            const size_t Panel = (WorkIndex / BlockCountM) % PanelCount;
+            const size_t Batch = WorkIndex / (BlockCountM * PanelCount);
+
+            const MLAS_SPARSE_SGEMM_DATA_PARAMS& Params = Data[Batch];
+
+            const size_t m = BlockM * MLAS_SPARSE_SGEMM_STRIDE_M;
+            const size_t n = Panel * MLAS_SPARSE_SGEMM_PANEL_N;
+            const size_t CountN = std::min(N - n, MLAS_SPARSE_SGEMM_PANEL_N);
+            size_t CountM = std::min(M - m, MLAS_SPARSE_SGEMM_STRIDE_M);
+
+            const float* A = Params.A + m * Params.lda;
+            float* C = Params.C + m * Params.ldc + n;
+
+            const bool ZeroMode = (Params.beta == 0.0f);
+
+            if (!ZeroMode && Params.beta != 1.0f) {
+                for (size_t mm = 0; mm < CountM; mm++) {
+                    for (size_t nn = 0; nn < CountN; nn++) {
+                        C[mm * Params.ldc + nn] *= Params.beta;
+                    }
+                }
+            }
+
+            const uint8_t* PackedPanel = static_cast<const uint8_t*>(PackedB) + PanelOffsets[Panel];
+
+            while (CountM > 0) {
+
+                const size_t RowsHandled = Kernel(A, Params.lda, PackedPanel, C, Params.ldc, CountM, CountN, K,
+                                                  Params.alpha, ZeroMode);
+
+                A += RowsHandled * Params.lda;
+                C += RowsHandled * Params.ldc;
+                CountM -= RowsHandled;
+            }
+        }
+    });
+}
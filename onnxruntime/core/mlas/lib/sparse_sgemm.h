@@ -0,0 +1,112 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse_sgemm.h
+
+Abstract:
+
+    This module defines the packed layout of a sparse matrix B and the kernel
+    dispatch structure of the sparse single precision matrix/matrix multiply
+    operation (sparse SGEMM).
+
+    The packed buffer starts with a MLAS_SPARSE_SGEMM_PACKED_HEADER and the
+    byte offset of each panel of 16 columns. A panel starts on a 64 byte
+    boundary and is laid out as follows:
+
+    Block format:
+        uint32_t BlockCount;
+        uint32_t BlockK[BlockCount];            first row of each block
+        (padding to a 64 byte boundary)
+        float Values[BlockCount][4][16];        rows of each block
+
+    2:4 format, for each group of 4 rows of the panel:
+        float Values[2][16];                    the 2 kept values of each column
+        uint8_t Index[2][16];                   their row within the group
+
+    The rows of the last block or group that are past K are zero, as are the
+    columns of the last panel that are past N.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+constexpr size_t MLAS_SPARSE_SGEMM_PANEL_N = 16;
+constexpr size_t MLAS_SPARSE_SGEMM_BLOCK_K = 4;
+constexpr size_t MLAS_SPARSE_SGEMM_PANEL_ALIGNMENT = 64;
+
+constexpr size_t MLAS_SPARSE_SGEMM_2TO4_GROUP_SIZE =
+    2 * MLAS_SPARSE_SGEMM_PANEL_N * sizeof(float) + 2 * MLAS_SPARSE_SGEMM_PANEL_N * sizeof(uint8_t);
+
+struct MLAS_SPARSE_SGEMM_PACKED_HEADER {
+    uint32_t Format;
+    uint32_t PanelCount;
+    uint64_t N;
+    uint64_t K;
+    uint64_t ValueCount;                        // number of values stored over all panels
+};
+
+MLAS_FORCEINLINE
+const uint64_t*
+MlasSparseSgemmPanelOffsets(
+    const void* PackedB
+    )
+{
+    return reinterpret_cast<const uint64_t*>(
+        static_cast<const uint8_t*>(PackedB) + sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER));
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasSparseSgemmBlockValuesOffset(
+    size_t BlockCount
+    )
+{
+    const size_t IndexSize = sizeof(uint32_t) * (1 + BlockCount);
+    return (IndexSize + MLAS_SPARSE_SGEMM_PANEL_ALIGNMENT - 1) & ~(MLAS_SPARSE_SGEMM_PANEL_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Compute C (+)= alpha * A * B for the rows of A starting at A and one
+ *        packed panel of B.
+ *
+ * @param A         Supplies the address of the first row of matrix A.
+ * @param lda       Supplies the first dimension of matrix A.
+ * @param Panel     Supplies the address of the packed panel of matrix B.
+ * @param C         Supplies the address of the first row and the first
+ *                  column of the panel in matrix C.
+ * @param ldc       Supplies the first dimension of matrix C.
+ * @param CountM    Supplies the number of rows of A and C left to compute.
+ * @param CountN    Supplies the number of columns of the panel to store,
+ *                  at most MLAS_SPARSE_SGEMM_PANEL_N.
+ * @param CountK    Supplies the number of columns of matrix A.
+ * @param alpha     Supplies the scalar multiplier.
+ * @param ZeroMode  Supplies true if C is overwritten, else the result is
+ *                  added to C.
+ * @return          The number of rows that were computed.
+ */
+typedef
+size_t
+(MLASCALL MLAS_SPARSE_SGEMM_KERNEL)(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    );
+
+struct MLAS_SPARSE_SGEMM_DISPATCH {
+    MLAS_SPARSE_SGEMM_KERNEL* BlockKernel;      /**< kernel for the block format */
+    MLAS_SPARSE_SGEMM_KERNEL* TwoToFourKernel;  /**< kernel for the 2:4 format */
+};
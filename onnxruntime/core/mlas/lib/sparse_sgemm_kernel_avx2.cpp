@@ -0,0 +1,263 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse_sgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the sparse single precision matrix/matrix multiply
+    kernels for AVX2 and FMA3.
+
+    A panel of 16 columns is held in two vectors of 8 columns for each of up
+    to 4 rows of matrix A. The block kernel broadcasts the elements of A for
+    each row of a nonzero block. The 2:4 kernel broadcasts the 4 elements of A
+    of a group to both 128-bit lanes and selects the element of each column by
+    its packed index with VPERMILPS.
+
+--*/
+
+#include "sparse_sgemm.h"
+
+#include <algorithm>
+
+constexpr size_t MLAS_SPARSE_SGEMM_AVX2_MAX_M = 4;
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSparseSgemmStoreAvx2(
+    __m256 Accumulators[RowCount][2],
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const __m256 Alpha = _mm256_set1_ps(alpha);
+
+    for (size_t m = 0; m < RowCount; m++) {
+
+        __m256 c0 = _mm256_mul_ps(Accumulators[m][0], Alpha);
+        __m256 c1 = _mm256_mul_ps(Accumulators[m][1], Alpha);
+        float* c = C + m * ldc;
+
+        if (CountN == MLAS_SPARSE_SGEMM_PANEL_N) {
+            if (!ZeroMode) {
+                c0 = _mm256_add_ps(c0, _mm256_loadu_ps(c));
+                c1 = _mm256_add_ps(c1, _mm256_loadu_ps(c + 8));
+            }
+            _mm256_storeu_ps(c, c0);
+            _mm256_storeu_ps(c + 8, c1);
+        } else {
+            MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_SPARSE_SGEMM_PANEL_N], 32);
+            _mm256_store_ps(Buffer, c0);
+            _mm256_store_ps(Buffer + 8, c1);
+            for (size_t n = 0; n < CountN; n++) {
+                c[n] = ZeroMode ? Buffer[n] : c[n] + Buffer[n];
+            }
+        }
+    }
+}
+
+template <size_t RowCount>
+void
+MlasSparseSgemmBlockAvx2(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t BlockCount = *reinterpret_cast<const uint32_t*>(Panel);
+    const uint32_t* BlockK = reinterpret_cast<const uint32_t*>(Panel) + 1;
+    const float* Values = reinterpret_cast<const float*>(Panel + MlasSparseSgemmBlockValuesOffset(BlockCount));
+
+    __m256 Accumulators[RowCount][2];
+
+    for (size_t m = 0; m < RowCount; m++) {
+        Accumulators[m][0] = _mm256_setzero_ps();
+        Accumulators[m][1] = _mm256_setzero_ps();
+    }
+
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const size_t k = BlockK[b];
+        const size_t BlockCountK = std::min(CountK - k, MLAS_SPARSE_SGEMM_BLOCK_K);
+
+        for (size_t kk = 0; kk < BlockCountK; kk++) {
+
+            const __m256 b0 = _mm256_loadu_ps(Values + kk * MLAS_SPARSE_SGEMM_PANEL_N);
+            const __m256 b1 = _mm256_loadu_ps(Values + kk * MLAS_SPARSE_SGEMM_PANEL_N + 8);
+
+            for (size_t m = 0; m < RowCount; m++) {
+                const __m256 a = _mm256_broadcast_ss(A + m * lda + k + kk);
+                Accumulators[m][0] = _mm256_fmadd_ps(a, b0, Accumulators[m][0]);
+                Accumulators[m][1] = _mm256_fmadd_ps(a, b1, Accumulators[m][1]);
+            }
+        }
+
+        Values += MLAS_SPARSE_SGEMM_BLOCK_K * MLAS_SPARSE_SGEMM_PANEL_N;
+    }
+
+    MlasSparseSgemmStoreAvx2<RowCount>(Accumulators, C, ldc, CountN, alpha, ZeroMode);
+}
+
+template <size_t RowCount>
+void
+MlasSparseSgemm2To4Avx2(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t GroupCount = CountK / MLAS_SPARSE_SGEMM_BLOCK_K;
+    const size_t RemainderK = CountK % MLAS_SPARSE_SGEMM_BLOCK_K;
+
+    __m256 Accumulators[RowCount][2];
+
+    for (size_t m = 0; m < RowCount; m++) {
+        Accumulators[m][0] = _mm256_setzero_ps();
+        Accumulators[m][1] = _mm256_setzero_ps();
+    }
+
+    const auto ComputeGroup = [&](const uint8_t* Group, const float* const* RowA) {
+
+        const float* Values = reinterpret_cast<const float*>(Group);
+        const uint8_t* Index = Group + 2 * MLAS_SPARSE_SGEMM_PANEL_N * sizeof(float);
+
+        for (size_t s = 0; s < 2; s++) {
+
+            const __m256 b0 = _mm256_loadu_ps(Values + s * MLAS_SPARSE_SGEMM_PANEL_N);
+            const __m256 b1 = _mm256_loadu_ps(Values + s * MLAS_SPARSE_SGEMM_PANEL_N + 8);
+            const __m256i i0 = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Index + s * MLAS_SPARSE_SGEMM_PANEL_N)));
+            const __m256i i1 = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Index + s * MLAS_SPARSE_SGEMM_PANEL_N + 8)));
+
+            for (size_t m = 0; m < RowCount; m++) {
+                const __m256 a = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(RowA[m]));
+                Accumulators[m][0] = _mm256_fmadd_ps(_mm256_permutevar_ps(a, i0), b0, Accumulators[m][0]);
+                Accumulators[m][1] = _mm256_fmadd_ps(_mm256_permutevar_ps(a, i1), b1, Accumulators[m][1]);
+            }
+        }
+    };
+
+    const float* RowA[RowCount];
+    const uint8_t* Group = Panel;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+        for (size_t m = 0; m < RowCount; m++) {
+            RowA[m] = A + m * lda + g * MLAS_SPARSE_SGEMM_BLOCK_K;
+        }
+        ComputeGroup(Group, RowA);
+        Group += MLAS_SPARSE_SGEMM_2TO4_GROUP_SIZE;
+    }
+
+    //
+    // Copy the last columns of A to a zero padded buffer so the partial group
+    // does not read past the rows of A.
+    //
+
+    if (RemainderK > 0) {
+        float Buffer[RowCount][MLAS_SPARSE_SGEMM_BLOCK_K] = {};
+        for (size_t m = 0; m < RowCount; m++) {
+            std::copy_n(A + m * lda + GroupCount * MLAS_SPARSE_SGEMM_BLOCK_K, RemainderK, Buffer[m]);
+            RowA[m] = Buffer[m];
+        }
+        ComputeGroup(Group, RowA);
+    }
+
+    MlasSparseSgemmStoreAvx2<RowCount>(Accumulators, C, ldc, CountN, alpha, ZeroMode);
+}
+
+size_t
+MLASCALL
+MlasSparseSgemmBlockKernelAvx2(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t RowCount = std::min(CountM, MLAS_SPARSE_SGEMM_AVX2_MAX_M);
+
+    switch (RowCount) {
+        case 4:
+            MlasSparseSgemmBlockAvx2<4>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+        case 3:
+            MlasSparseSgemmBlockAvx2<3>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+        case 2:
+            MlasSparseSgemmBlockAvx2<2>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+        default:
+            MlasSparseSgemmBlockAvx2<1>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+    }
+
+    return RowCount;
+}
+
+size_t
+MLASCALL
+MlasSparseSgemm2To4KernelAvx2(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t RowCount = std::min(CountM, MLAS_SPARSE_SGEMM_AVX2_MAX_M);
+
+    switch (RowCount) {
+        case 4:
+            MlasSparseSgemm2To4Avx2<4>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+        case 3:
+            MlasSparseSgemm2To4Avx2<3>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+        case 2:
+            MlasSparseSgemm2To4Avx2<2>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+        default:
+            MlasSparseSgemm2To4Avx2<1>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+            break;
+    }
+
+    return RowCount;
+}
+
+const MLAS_SPARSE_SGEMM_DISPATCH MlasSparseSgemmDispatchAvx2 = {
+    MlasSparseSgemmBlockKernelAvx2,
+    MlasSparseSgemm2To4KernelAvx2,
+};
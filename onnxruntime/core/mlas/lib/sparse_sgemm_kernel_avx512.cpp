@@ -0,0 +1,235 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse_sgemm_kernel_avx512.cpp
+
+Abstract:
+
+    This module implements the sparse single precision matrix/matrix multiply
+    kernels for AVX512F.
+
+    A panel of 16 columns is held in one vector for each of up to 8 rows of
+    matrix A, and the columns of a partial panel are stored with a mask. The
+    2:4 kernel broadcasts the 4 elements of A of a group to the four 128-bit
+    lanes and selects the element of each column by its packed index with
+    VPERMILPS.
+
+--*/
+
+#include "sparse_sgemm.h"
+
+#include <algorithm>
+
+constexpr size_t MLAS_SPARSE_SGEMM_AVX512_MAX_M = 8;
+
+template <size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSparseSgemmStoreAvx512(
+    __m512 Accumulators[RowCount],
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const __m512 Alpha = _mm512_set1_ps(alpha);
+    const __mmask16 Mask = __mmask16((uint32_t(1) << CountN) - 1);
+
+    for (size_t m = 0; m < RowCount; m++) {
+
+        float* c = C + m * ldc;
+        __m512 Result = _mm512_mul_ps(Accumulators[m], Alpha);
+
+        if (!ZeroMode) {
+            Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, c));
+        }
+
+        _mm512_mask_storeu_ps(c, Mask, Result);
+    }
+}
+
+template <size_t RowCount>
+void
+MlasSparseSgemmBlockAvx512(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t BlockCount = *reinterpret_cast<const uint32_t*>(Panel);
+    const uint32_t* BlockK = reinterpret_cast<const uint32_t*>(Panel) + 1;
+    const float* Values = reinterpret_cast<const float*>(Panel + MlasSparseSgemmBlockValuesOffset(BlockCount));
+
+    __m512 Accumulators[RowCount];
+
+    for (size_t m = 0; m < RowCount; m++) {
+        Accumulators[m] = _mm512_setzero_ps();
+    }
+
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const size_t k = BlockK[b];
+        const size_t BlockCountK = std::min(CountK - k, MLAS_SPARSE_SGEMM_BLOCK_K);
+
+        for (size_t kk = 0; kk < BlockCountK; kk++) {
+
+            const __m512 BElements = _mm512_loadu_ps(Values + kk * MLAS_SPARSE_SGEMM_PANEL_N);
+
+            for (size_t m = 0; m < RowCount; m++) {
+                const __m512 a = _mm512_set1_ps(A[m * lda + k + kk]);
+                Accumulators[m] = _mm512_fmadd_ps(a, BElements, Accumulators[m]);
+            }
+        }
+
+        Values += MLAS_SPARSE_SGEMM_BLOCK_K * MLAS_SPARSE_SGEMM_PANEL_N;
+    }
+
+    MlasSparseSgemmStoreAvx512<RowCount>(Accumulators, C, ldc, CountN, alpha, ZeroMode);
+}
+
+template <size_t RowCount>
+void
+MlasSparseSgemm2To4Avx512(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const size_t GroupCount = CountK / MLAS_SPARSE_SGEMM_BLOCK_K;
+    const size_t RemainderK = CountK % MLAS_SPARSE_SGEMM_BLOCK_K;
+
+    __m512 Accumulators[RowCount];
+
+    for (size_t m = 0; m < RowCount; m++) {
+        Accumulators[m] = _mm512_setzero_ps();
+    }
+
+    const auto ComputeGroup = [&](const uint8_t* Group, const float* const* RowA) {
+
+        const float* Values = reinterpret_cast<const float*>(Group);
+        const uint8_t* Index = Group + 2 * MLAS_SPARSE_SGEMM_PANEL_N * sizeof(float);
+
+        const __m512 b0 = _mm512_loadu_ps(Values);
+        const __m512 b1 = _mm512_loadu_ps(Values + MLAS_SPARSE_SGEMM_PANEL_N);
+        const __m512i i0 = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Index)));
+        const __m512i i1 = _mm512_cvtepu8_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(Index + MLAS_SPARSE_SGEMM_PANEL_N)));
+
+        for (size_t m = 0; m < RowCount; m++) {
+            const __m512 a = _mm512_broadcast_f32x4(_mm_loadu_ps(RowA[m]));
+            Accumulators[m] = _mm512_fmadd_ps(_mm512_permutevar_ps(a, i0), b0, Accumulators[m]);
+            Accumulators[m] = _mm512_fmadd_ps(_mm512_permutevar_ps(a, i1), b1, Accumulators[m]);
+        }
+    };
+
+    const float* RowA[RowCount];
+    const uint8_t* Group = Panel;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+        for (size_t m = 0; m < RowCount; m++) {
+            RowA[m] = A + m * lda + g * MLAS_SPARSE_SGEMM_BLOCK_K;
+        }
+        ComputeGroup(Group, RowA);
+        Group += MLAS_SPARSE_SGEMM_2TO4_GROUP_SIZE;
+    }
+
+    //
+    // Copy the last columns of A to a zero padded buffer so the partial group
+    // does not read past the rows of A.
+    //
+
+    if (RemainderK > 0) {
+        float Buffer[RowCount][MLAS_SPARSE_SGEMM_BLOCK_K] = {};
+        for (size_t m = 0; m < RowCount; m++) {
+            std::copy_n(A + m * lda + GroupCount * MLAS_SPARSE_SGEMM_BLOCK_K, RemainderK, Buffer[m]);
+            RowA[m] = Buffer[m];
+        }
+        ComputeGroup(Group, RowA);
+    }
+
+    MlasSparseSgemmStoreAvx512<RowCount>(Accumulators, C, ldc, CountN, alpha, ZeroMode);
+}
+
+size_t
+MLASCALL
+MlasSparseSgemmBlockKernelAvx512(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    if (CountM >= MLAS_SPARSE_SGEMM_AVX512_MAX_M) {
+        MlasSparseSgemmBlockAvx512<8>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+        return 8;
+    } else if (CountM >= 4) {
+        MlasSparseSgemmBlockAvx512<4>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+        return 4;
+    } else if (CountM >= 2) {
+        MlasSparseSgemmBlockAvx512<2>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+        return 2;
+    }
+
+    MlasSparseSgemmBlockAvx512<1>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+    return 1;
+}
+
+size_t
+MLASCALL
+MlasSparseSgemm2To4KernelAvx512(
+    const float* A,
+    size_t lda,
+    const uint8_t* Panel,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    if (CountM >= MLAS_SPARSE_SGEMM_AVX512_MAX_M) {
+        MlasSparseSgemm2To4Avx512<8>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+        return 8;
+    } else if (CountM >= 4) {
+        MlasSparseSgemm2To4Avx512<4>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+        return 4;
+    } else if (CountM >= 2) {
+        MlasSparseSgemm2To4Avx512<2>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+        return 2;
+    }
+
+    MlasSparseSgemm2To4Avx512<1>(A, lda, Panel, C, ldc, CountN, CountK, alpha, ZeroMode);
+    return 1;
+}
+
+const MLAS_SPARSE_SGEMM_DISPATCH MlasSparseSgemmDispatchAvx512 = {
+    MlasSparseSgemmBlockKernelAvx512,
+    MlasSparseSgemm2To4KernelAvx512,
+};
@@ -12,6 +12,9 @@ class GemmActivationFusion : public GraphTransformer {
   GemmActivationFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("GemmActivationFusion", compatible_execution_providers) {}
 
+  // fuses a Gemm node with the activation node that consumes its output
+  InlinedVector<std::string> TargetOpTypes() const override { return {"Gemm"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -12,6 +12,17 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   // ORT_RETURN_IF_ERROR(graph.Resolve());
 
   auto status = ApplyImpl(graph, modified, 0, logger);
+  return FinalizeApply(graph, modified, std::move(status), logger);
+}
+
+Status GraphTransformer::ApplyIncremental(Graph& graph, const InlinedHashSet<NodeIndex>& nodes, bool& modified,
+                                          const logging::Logger& logger) const {
+  auto status = ApplyIncrementalImpl(graph, nodes, modified, logger);
+  return FinalizeApply(graph, modified, std::move(status), logger);
+}
+
+Status GraphTransformer::FinalizeApply(Graph& graph, bool modified, Status status,
+                                       const logging::Logger& logger) const {
   LOGS(logger, INFO) << "GraphTransformer " << Name() << " modified: " << modified << " with status: " << status;
   ORT_RETURN_IF_ERROR(status);
 
@@ -21,6 +32,8 @@ Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logg
   if (modified) {
     status = graph.Resolve();
   }
+#else
+  ORT_UNUSED_PARAMETER(graph);
 #endif
 
   return status;
@@ -4,14 +4,164 @@
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <utility>
 
+#include "core/common/hash_combine.h"
+
 using namespace onnxruntime;
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
+namespace {
+
+size_t AttributeSignature(const ONNX_NAMESPACE::AttributeProto& attr) {
+  size_t signature = 0;
+  HashCombine(attr.name(), signature);
+  HashCombine(static_cast<int>(attr.type()), signature);
+  HashCombine(attr.i(), signature);
+  HashCombine(attr.f(), signature);
+  HashCombine(attr.s(), signature);
+  for (auto value : attr.ints()) {
+    HashCombine(value, signature);
+  }
+  for (auto value : attr.floats()) {
+    HashCombine(value, signature);
+  }
+  for (const auto& value : attr.strings()) {
+    HashCombine(value, signature);
+  }
+  // the data of a tensor attribute is not hashed as it can be large. a transformer that changes a tensor attribute
+  // in place is expected to also change its name or type.
+  if (attr.has_t()) {
+    HashCombine(attr.t().name(), signature);
+    HashCombine(attr.t().data_type(), signature);
+    HashCombine(attr.t().raw_data().size(), signature);
+  }
+  return signature;
+}
+
+// Combines a NodeArg with its type and shape. Resolving the graph after a transformer changed it can refine the types
+// and shapes of NodeArgs far from the change, which rules that check shapes can match on.
+void CombineNodeArgSignature(const NodeArg* def, size_t& signature) {
+  HashCombine(def, signature);
+  if (def == nullptr) {
+    return;
+  }
+
+  HashCombine(def->Type(), signature);
+  const auto* shape = def->Shape();
+  if (shape == nullptr) {
+    return;
+  }
+
+  HashCombine(shape->dim_size(), signature);
+  for (const auto& dim : shape->dim()) {
+    if (dim.has_dim_value()) {
+      HashCombine(dim.dim_value(), signature);
+    } else {
+      HashCombine(dim.dim_param(), signature);
+    }
+  }
+}
+
+size_t GraphSignature(const Graph& graph);
+
+// Hash of the parts of a node that transformers match patterns on: its op, attributes, inputs and outputs with their
+// types and shapes, the number of its producers and consumers, and the nodes of its subgraphs.
+size_t NodeSignature(const Node& node) {
+  size_t signature = 0;
+  HashCombine(node.OpType(), signature);
+  HashCombine(node.Domain(), signature);
+  HashCombine(node.GetExecutionProviderType(), signature);
+  for (const auto* def : node.InputDefs()) {
+    CombineNodeArgSignature(def, signature);
+  }
+  for (const auto* def : node.ImplicitInputDefs()) {
+    CombineNodeArgSignature(def, signature);
+  }
+  for (const auto* def : node.OutputDefs()) {
+    CombineNodeArgSignature(def, signature);
+  }
+  HashCombine(node.GetInputEdgesCount(), signature);
+  HashCombine(node.GetOutputEdgesCount(), signature);
+
+  // the order of the attributes in the map is arbitrary, so combine them independent of it
+  size_t attributes_signature = 0;
+  for (const auto& attr : node.GetAttributes()) {
+    attributes_signature += AttributeSignature(attr.second);
+  }
+  HashCombine(attributes_signature, signature);
+
+  for (const auto& subgraph : node.GetSubgraphs()) {
+    HashCombine(GraphSignature(*subgraph), signature);
+  }
+
+  return signature;
+}
+
+size_t GraphSignature(const Graph& graph) {
+  size_t signature = 0;
+  for (const auto& node : graph.Nodes()) {
+    size_t node_signature = node.Index();
+    HashCombineWithHashValue(NodeSignature(node), node_signature);
+    signature += node_signature;
+  }
+  return signature;
+}
+
+// Finds the nodes of a graph that changed between calls to Update by comparing a signature of each node.
+// Computing the signatures is linear in the size of the graph, but much cheaper than applying a transformer, which
+// matches patterns at every node and resolves the graph.
+class GraphChangeTracker {
+ public:
+  explicit GraphChangeTracker(const Graph& graph) {
+    ORT_IGNORE_RETURN_VALUE(Update(graph, nullptr));
+  }
+
+  // Records the current state of the graph. Adds the nodes that were added or changed since the last call, and their
+  // producers and consumers, to changed_nodes if given.
+  // Returns false if the change could not be attributed to nodes of the main graph, i.e. the change was in a subgraph
+  // or did not change any node.
+  bool Update(const Graph& graph, InlinedHashSet<NodeIndex>* changed_nodes) {
+    InlinedHashMap<NodeIndex, size_t> signatures;
+    signatures.reserve(static_cast<size_t>(graph.NumberOfNodes()));
+    bool attributable = true;
+    bool any_changed = signatures_.size() != static_cast<size_t>(graph.NumberOfNodes());
+
+    for (const auto& node : graph.Nodes()) {
+      const size_t signature = NodeSignature(node);
+      signatures.emplace(node.Index(), signature);
+
+      auto previous = signatures_.find(node.Index());
+      if (changed_nodes == nullptr || (previous != signatures_.end() && previous->second == signature)) {
+        continue;
+      }
+
+      any_changed = true;
+      attributable = attributable && !node.ContainsSubgraph();
+      changed_nodes->insert(node.Index());
+      for (auto it = node.InputNodesBegin(), end = node.InputNodesEnd(); it != end; ++it) {
+        changed_nodes->insert(it->Index());
+      }
+      for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+        changed_nodes->insert(it->Index());
+      }
+    }
+
+    signatures_ = std::move(signatures);
+    return attributable && any_changed;
+  }
+
+ private:
+  InlinedHashMap<NodeIndex, size_t> signatures_;
+};
+
+}  // namespace
+
 common::Status GraphTransformerManager::SetSteps(unsigned steps) {
   steps_ = steps;
   return Status::OK();
@@ -30,17 +180,90 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  // The nodes that changed since a transformer was last applied.
+  struct Worklist {
+    InlinedVector<std::string> target_op_types;
+    InlinedHashSet<NodeIndex> changed_nodes;
+    // set if a change could not be attributed to nodes of the main graph
+    bool all_changed = false;
+  };
+
+  const bool incremental = incremental_ && steps_ > 1;
+  std::optional<GraphChangeTracker> tracker;
+  InlinedVector<Worklist> worklists(transformers->second.size());
+  if (incremental) {
+    tracker.emplace(graph);
+    for (size_t i = 0; i < worklists.size(); ++i) {
+      worklists[i].target_op_types = transformers->second[i]->TargetOpTypes();
+    }
+  }
+
   for (unsigned step = 0; step < steps_; ++step) {
     if (IsLoadCancellationFlagSet()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, MODEL_LOAD_CANCELED, "Graph transformation canceled due to user request.");
     }
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < transformers->second.size(); ++i) {
+      const auto& transformer = transformers->second[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      auto& stats = transformer_stats_[transformer->Name()];
+
+      // After the first step, a transformer can only match again where the graph changed since it was applied.
+      bool apply_to_graph = true;
+      InlinedHashSet<NodeIndex> nodes_to_visit;
+      if (incremental) {
+        auto& worklist = worklists[i];
+        if (step > 0 && !worklist.all_changed) {
+          if (!worklist.target_op_types.empty()) {
+            apply_to_graph = false;
+            for (auto node_index : worklist.changed_nodes) {
+              const auto* node = graph.GetNode(node_index);
+              if (node != nullptr && std::find(worklist.target_op_types.begin(), worklist.target_op_types.end(),
+                                               node->OpType()) != worklist.target_op_types.end()) {
+                nodes_to_visit.insert(node_index);
+              }
+            }
+          }
+
+          if (worklist.changed_nodes.empty() || (!apply_to_graph && nodes_to_visit.empty())) {
+            ++stats.num_skipped;
+            continue;
+          }
+        }
+
+        worklist.changed_nodes.clear();
+        worklist.all_changed = false;
+      }
+
+      const TimePoint start_time = std::chrono::high_resolution_clock::now();
       bool modified = false;
-      ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+      ORT_RETURN_IF_ERROR(apply_to_graph ? transformer->Apply(graph, modified, logger)
+                                         : transformer->ApplyIncremental(graph, nodes_to_visit, modified, logger));
+
+      stats.duration += std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::high_resolution_clock::now() - start_time);
+      ++stats.num_runs;
+      if (profiler_ != nullptr && profiler_->IsEnabled()) {
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, transformer->Name() + "_apply", start_time,
+                                         {{"step", std::to_string(step)},
+                                          {"nodes", apply_to_graph ? "all" : std::to_string(nodes_to_visit.size())},
+                                          {"modified", modified ? "1" : "0"}});
+      }
+
+      if (modified) {
+        ++stats.num_modified;
+        if (incremental) {
+          InlinedHashSet<NodeIndex> changed_nodes;
+          const bool attributable = tracker->Update(graph, &changed_nodes);
+          for (auto& worklist : worklists) {
+            worklist.changed_nodes.insert(changed_nodes.begin(), changed_nodes.end());
+            worklist.all_changed = worklist.all_changed || !attributable;
+          }
+        }
+      }
+
       graph_changed = graph_changed || modified;
       _is_graph_modified = _is_graph_modified || modified;
     }
@@ -49,6 +272,14 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     }
   }
 
+  for (const auto& transformer : transformers->second) {
+    const auto& stats = transformer_stats_[transformer->Name()];
+    LOGS(logger, VERBOSE) << "GraphTransformer " << transformer->Name() << " runs: " << stats.num_runs
+                          << " skipped: " << stats.num_skipped << " modified: " << stats.num_modified
+                          << " time: " << std::chrono::duration_cast<std::chrono::microseconds>(stats.duration).count()
+                          << "us";
+  }
+
   return Status::OK();
 }
 
@@ -3,16 +3,35 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/rewrite_rule.h"
 
 namespace onnxruntime {
 
+// Time spent in and effect of a graph transformer, accumulated over all ApplyTransformers calls.
+struct GraphTransformerStats {
+  std::chrono::nanoseconds duration{0};
+  // number of times the transformer was applied
+  size_t num_runs = 0;
+  // number of times the transformer was skipped as none of its target nodes changed since it was last applied
+  size_t num_skipped = 0;
+  // number of times applying the transformer modified the graph
+  size_t num_modified = 0;
+};
+
 // Manages a list of graph transformers. It is initialized with a list of graph
 // transformers. Each inference session can further register additional ones.
+//
+// In the first step all the transformers of a level are applied to the whole graph. In the following steps each
+// transformer only revisits the nodes that changed since it was last applied, and their neighbors.
+// A transformer that declares its target op types is skipped if none of those nodes have one of them.
+// A transformer that does not declare them is applied to the whole graph again if anything changed.
 class GraphTransformerManager {
  public:
   explicit GraphTransformerManager(unsigned steps) : steps_(steps) {
@@ -34,6 +53,16 @@ class GraphTransformerManager {
     return check_load_cancellation_fn_ && check_load_cancellation_fn_();
   }
 
+  // Enable or disable revisiting only the changed nodes in the steps after the first one. Enabled by default.
+  void SetIncremental(bool incremental) noexcept {
+    incremental_ = incremental;
+  }
+
+  // Set the profiler to record the application of each transformer with, if profiling is enabled.
+  void SetProfiler(profiling::Profiler* profiler) noexcept {
+    profiler_ = profiler;
+  }
+
   // Register a transformer with a level.
   common::Status Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level);
 
@@ -45,6 +74,11 @@ class GraphTransformerManager {
   // Set/Re-Set graph modified to "false" (generally) to remove any trace of previous application
   void ClearGraphModified(void);
 
+  // Get the time spent in and effect of each transformer that was applied, by transformer name.
+  const InlinedHashMap<std::string, GraphTransformerStats>& GetTransformerStats() const noexcept {
+    return transformer_stats_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
@@ -54,6 +88,9 @@ class GraphTransformerManager {
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
   CheckLoadCancellationFn check_load_cancellation_fn_;
+  bool incremental_ = true;
+  profiling::Profiler* profiler_ = nullptr;
   mutable bool _is_graph_modified = false;
+  mutable InlinedHashMap<std::string, GraphTransformerStats> transformer_stats_;
 };
 }  // namespace onnxruntime
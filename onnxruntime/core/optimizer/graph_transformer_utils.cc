@@ -79,9 +79,11 @@
 #include "core/optimizer/rocm_blas_alt_impl.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
+#include "core/optimizer/skip_layer_norm_quantize_fusion.h"
 #include "core/optimizer/slice_elimination.h"
 #include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
+#include "core/optimizer/zipmap_columnar_transformer.h"
 #ifdef ENABLE_TRAINING
 #include "orttraining/core/optimizer/bias_softmax_dropout_fusion.h"
 #include "orttraining/core/optimizer/bitmask_dropout_replacement.h"
@@ -302,6 +304,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                             QDQIsInt8Allowed() ? "1" : "0") == "1";
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
+      const bool enable_zipmap_columnar_output =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsZipMapColumnarOutput, "0") == "1";
 
       const InlinedHashSet<std::string_view> cuda_eps = {onnxruntime::kCudaExecutionProvider};
 
@@ -414,6 +418,12 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #endif
 
       transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_ep));
+      transformers.emplace_back(std::make_unique<SkipLayerNormQuantizeFusion>(cpu_ep));
+
+      // ZipMapColumnarTransformer changes the type of model outputs, so it needs to be explicitly enabled.
+      if (enable_zipmap_columnar_output) {
+        transformers.emplace_back(std::make_unique<ZipMapColumnarTransformer>(cpu_ep));
+      }
 
 #endif  // !defined(DISABLE_CONTRIB_OPS)
       // The QDQFinalCleanupTransformer must run AFTER other transformers that fuse Q/DQ nodes. Otherwise, their
@@ -424,15 +434,25 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
     case TransformerLevel::Level3: {
 #ifndef DISABLE_CONTRIB_OPS
+      auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
+      const bool enable_nhwc_fp32_conv =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32Conv, "0") == "1";
+      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                logger, enable_nhwc_fp32_conv);
+      const bool nhwc_transformer_active = nhwc_transformer->IsActive();
+
+      // The NchwcTransformer converts every fp32 Conv it supports, so when fp32 NHWC convolutions are requested the
+      // NhwcTransformer must run first for those nodes to reach it.
+      if (nhwc_transformer_active && enable_nhwc_fp32_conv) {
+        transformers.emplace_back(std::move(nhwc_transformer));
+      }
+
       // Register the NCHWc layout transformer if supported by the platform.
       if (MlasNchwcGetBlockSize() > 1) {
         transformers.emplace_back(std::make_unique<NchwcTransformer>());
       }
 
-      auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
-                                                                logger);
-      if (nhwc_transformer->IsActive()) {
+      if (nhwc_transformer_active && !enable_nhwc_fp32_conv) {
         transformers.emplace_back(std::move(nhwc_transformer));
       }
 
@@ -526,8 +546,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformersForMinimalB
 #ifndef DISABLE_CONTRIB_OPS
         AllocatorPtr cpu_allocator = CPUAllocator::DefaultInstance();
         auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
+        const bool enable_nhwc_fp32_conv =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32Conv, "0") == "1";
         auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
-                                                                  logger);
+                                                                  logger, enable_nhwc_fp32_conv);
         if (nhwc_transformer->IsActive()) {
           transformers.emplace_back(std::move(nhwc_transformer));
         }
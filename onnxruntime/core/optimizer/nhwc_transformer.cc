@@ -46,7 +46,8 @@ NhwcConvLookup(
 
 NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator,
                                  std::shared_ptr<KernelRegistry> cpu_kernel_registry,
-                                 const logging::Logger& logger) noexcept
+                                 const logging::Logger& logger,
+                                 bool enable_fp32_conv) noexcept
     : GraphTransformer("NhwcTransformer"), cpu_allocator_(std::move(cpu_allocator)) {
   if (!cpu_kernel_registry) {
     // This is a CPU op nodes optimizer, not useful if cpu EP is not available.
@@ -117,6 +118,26 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator,
     }
   }
 
+  if (enable_fp32_conv) {
+    // fp32 conv -> fp32 nhwc conv
+    OpKernelRegistryId nhwc_conv_fp32{
+        "NhwcFusedConv", kMSDomain, 1, {{"T", {DataTypeImpl::GetTensorType<float>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_,
+        nhwc_conv_fp32.version_, nhwc_conv_fp32.type_constraints_, logger, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("Conv", kOnnxDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+      conv_table_.emplace(
+          OpIdInfo("FusedConv", kMSDomain, api::DataType::FLOAT),
+          OpTransformInfo{nhwc_conv_fp32.op_type_, nhwc_conv_fp32.domain_, nhwc_conv_fp32.version_, false});
+    }
+  }
+
   {
     // fp16 MaxPool -> fp16 nhwc MaxPool
     OpKernelRegistryId nhwc_maxpool_fp16{
@@ -217,7 +238,13 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     size_t rank = shape->dim_size();
     std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
     std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
-    WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+    // The optional Sum input of FusedConv has the layout of the output.
+    const auto inputs = node->Inputs();
+    if (node->OpType() == "FusedConv" && inputs.size() > 3 && !inputs[3].empty()) {
+      WrapTransposesAroundNode(*api_graph, *node, {&input_perm, nullptr, nullptr, &input_perm}, {&output_perm});
+    } else {
+      WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+    }
 
     // Replace the operator if needed
     if (node->Domain() != transform->domain_ ||
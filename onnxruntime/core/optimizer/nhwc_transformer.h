@@ -75,8 +75,11 @@ and inserts nodes to transpose tensors as needed.
 class NhwcTransformer : public GraphTransformer {
  private:
  public:
+  /**
+   * @param enable_fp32_conv whether fp32 Conv and FusedConv nodes are converted to NhwcFusedConv.
+   */
   explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
-                           const logging::Logger& logger) noexcept;
+                           const logging::Logger& logger, bool enable_fp32_conv = false) noexcept;
 
   /**
    * @brief Usually called right after constructor, it shows whether
@@ -93,6 +93,25 @@ std::vector<NodeAndMoveInfo> WhereMoves() {
       MoveAll(q, ArgType::kOutput)};
   return moves;
 }
+// moves for replacing a LayerNormalization node with DQ inputs with the qlinear version
+std::vector<NodeAndMoveInfo> LayerNormalizationMoves() {
+  NTO::NodeLocation dq_x{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation dq_scale{NTO::NodeType::kInput, 1};
+  NTO::NodeLocation dq_bias{NTO::NodeType::kInput, 2};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAll(dq_x, ArgType::kInput),                                     // append all inputs from x
+      MoveAll(dq_scale, ArgType::kInput),                                 // append all inputs from scale
+      MoveAndAppend(q, ArgType::kInput, 1, ArgType::kInput),              // append scale (input 1) from q
+      MoveAndAppend(q, ArgType::kInput, 2, ArgType::kInput),              // append zp (input 2) from q
+      MoveAndAppend(dq_bias, ArgType::kInput, 0, ArgType::kInput, true),  // (optional) append bias
+      MoveAndAppend(dq_bias, ArgType::kInput, 1, ArgType::kInput, true),  // (optional) append bias scale
+      MoveAll(q, ArgType::kOutput)};                                      // and use the outputs from q
+
+  return moves;
+}
+
 QDQReplaceWithNew SplitReplacer(bool has_split_as_input) {
   NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
   NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
@@ -254,6 +273,9 @@ ConvReplaceWithQLinear::ConvReplaceWithQLinear()
 WhereReplaceWithQLinear::WhereReplaceWithQLinear()
     : ReplaceWithQLinear(kMSDomain, WhereMoves()) {
 }
+LayerNormalizationReplaceWithQLinear::LayerNormalizationReplaceWithQLinear()
+    : ReplaceWithQLinear(kMSDomain, LayerNormalizationMoves()) {
+}
 MatMulReplaceWithQLinear::MatMulReplaceWithQLinear()
     : matmul_int_to_float_replacer_{MatMulIntToFloatReplacer()},
       qlinear_matmul_replacer_{kOnnxDomain} {
@@ -69,6 +69,9 @@ struct ConvReplaceWithQLinear : ReplaceWithQLinear {
 struct WhereReplaceWithQLinear : ReplaceWithQLinear {
   WhereReplaceWithQLinear();
 };
+struct LayerNormalizationReplaceWithQLinear : ReplaceWithQLinear {
+  LayerNormalizationReplaceWithQLinear();
+};
 struct SplitReplaceWithQuant : public Action {
   Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
 };
@@ -5,6 +5,8 @@
 
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 
+#include <algorithm>
+
 #include "core/graph/graph.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/qdq_transformer/qdq_util.h"
@@ -402,6 +404,10 @@ void ConvSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
   builder.input_nodes.resize(3, NodesToOptimizeIndices::kEmptyNodeIndex);
 }
 
+void LayerNormalizationSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  builder.input_nodes.resize(3, NodesToOptimizeIndices::kEmptyNodeIndex);
+}
+
 bool EinsumNodeGroupSelector::Check(const GraphViewer& graph_viewer,
                                     const Node& node, const Node* redundant_clip_node,
                                     const std::vector<const Node*>& dq_nodes,
@@ -704,6 +710,11 @@ bool InstanceAndLayerNormalizationNodeGroupSelector::Check(const GraphViewer& gr
   }
 
   int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_scale = dq_nodes[1]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (!allow_16bit_ && (Is16BitIntType(dt_input) || Is16BitIntType(dt_scale))) {
+    return false;
+  }
+
   int32_t dt_bias = 0;
   bool has_bias = false;
   // bias is optional for LayerNorm
@@ -719,6 +730,44 @@ bool InstanceAndLayerNormalizationNodeGroupSelector::Check(const GraphViewer& gr
          (has_bias ? dt_bias == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT32 : true);
 }
 
+bool LayerNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                                const Node* redundant_clip_node,
+                                                const std::vector<const Node*>& dq_nodes,
+                                                const std::vector<const Node*>& q_nodes) const {
+  if (!InstanceAndLayerNormalizationNodeGroupSelector::Check(graph_viewer, node, redundant_clip_node, dq_nodes,
+                                                             q_nodes)) {
+    return false;
+  }
+
+  auto get_const_initializer = [&graph_viewer](const std::string& initializer_name) {
+    return graph_viewer.GetConstantInitializer(initializer_name, true);
+  };
+
+  // per-axis and blockwise quantization have non-scalar scales
+  bool zero_point_exists = false;
+  if (!QOrDQNodeHasConstantScalarScaleAndZeroPoint(*q_nodes[0], get_const_initializer, zero_point_exists)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < dq_nodes.size(); ++i) {
+    if (!QOrDQNodeHasConstantScalarScaleAndZeroPoint(*dq_nodes[i], get_const_initializer, zero_point_exists)) {
+      return false;
+    }
+
+    // the fused node has no B zero point input, so it must be absent or 0
+    if (i == 2 && zero_point_exists) {
+      const auto* zp_tensor_proto = get_const_initializer(dq_nodes[i]->InputDefs()[InputIndex::ZERO_POINT_ID]->Name());
+      Initializer zero_point(graph_viewer.GetGraph(), *zp_tensor_proto, graph_viewer.ModelPath());
+      const auto zero_point_bytes = zero_point.DataAsByteSpan();
+      if (std::any_of(zero_point_bytes.begin(), zero_point_bytes.end(), [](uint8_t b) { return b != 0; })) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 bool BatchNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
                                                 const Node* redundant_clip_node,
                                                 const std::vector<const Node*>& dq_nodes,
@@ -264,6 +264,27 @@ class GemmNodeGroupSelector : public NodeGroupSelector {
 // Input: DQ nodes for input, scale, and B
 // Output: Q node for output
 class InstanceAndLayerNormalizationNodeGroupSelector : public NodeGroupSelector {
+ public:
+  explicit InstanceAndLayerNormalizationNodeGroupSelector(bool allow_16bit = true) : allow_16bit_(allow_16bit) {}
+
+ protected:
+  bool Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+
+ private:
+  bool allow_16bit_;
+};
+
+// Input: DQ nodes for input, scale, and B
+// Output: Q node for output
+// Additionally requires per-tensor quantization and a zero B zero point, as QLinearLayerNormalization has no
+// B zero point input and dequantizes Scale and B element-wise.
+class LayerNormalizationNodeGroupSelector : public InstanceAndLayerNormalizationNodeGroupSelector {
+ public:
+  explicit LayerNormalizationNodeGroupSelector(bool allow_16bit = false)
+      : InstanceAndLayerNormalizationNodeGroupSelector(allow_16bit) {}
+
  private:
   bool Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
              const std::vector<const Node*>& dq_nodes,
@@ -405,6 +426,15 @@ class ConvSelector : public BaseSelector {
   void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
 };
 
+// DQ nodes for X, Scale and optionally B -> LayerNormalization -> Q
+class LayerNormalizationSelector : public BaseSelector {
+ public:
+  explicit LayerNormalizationSelector(gsl::span<const char*> compatible_providers = {}, bool allow_16bit = false)
+      : BaseSelector(std::make_unique<LayerNormalizationNodeGroupSelector>(allow_16bit), compatible_providers) {}
+
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 class WhereSelector : public BaseSelector {
  public:
   explicit WhereSelector(gsl::span<const char*> compatible_providers = {}, bool allow_16bit = false,
@@ -39,6 +39,45 @@ Status RuleBasedGraphTransformer::ApplyRulesOnNode(Graph& graph, Node& node,
   return Status::OK();
 }
 
+Status RuleBasedGraphTransformer::ApplyRulesAndRecurse(Graph& graph, Node& node, bool& modified, int graph_level,
+                                                       const logging::Logger& logger) const {
+  // Initialize the effect of rules on this node to denote that the graph has not yet been modified
+  // by the rule application on the current node.
+  auto rule_effect = RuleEffect::kNone;
+
+  if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+    return Status::OK();
+  }
+
+  // First apply rewrite rules that are registered for the op type of the current node; then apply rules that are
+  // registered to be applied regardless of the op type; then recursively apply rules to subgraphs (if any).
+  // Stop further rule application for the current node, if the node gets removed by a rule.
+  const InlinedVector<std::reference_wrapper<const RewriteRule>>* rules = nullptr;
+
+  rules = GetRewriteRulesForOpType(node.OpType());
+  if (rules) {
+    ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, node, *rules, rule_effect, logger));
+  }
+
+  if (rule_effect != RuleEffect::kRemovedCurrentNode) {
+    rules = GetAnyOpRewriteRules();
+    if (rules) {
+      ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, node, *rules, rule_effect, logger));
+    }
+  }
+
+  // Update the modified field of the rule-based transformer.
+  if (rule_effect != RuleEffect::kNone) {
+    modified = true;
+  }
+
+  if (rule_effect != RuleEffect::kRemovedCurrentNode) {
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+  }
+
+  return Status::OK();
+}
+
 Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
@@ -50,44 +89,47 @@ Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int gr
       continue;
     }
 
-    // Initialize the effect of rules on this node to denote that the graph has not yet been modified
-    // by the rule application on the current node.
-    auto rule_effect = RuleEffect::kNone;
-
-    if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
-      continue;
-    }
+    ORT_RETURN_IF_ERROR(ApplyRulesAndRecurse(graph, *node, modified, graph_level, logger));
+  }
 
-    // First apply rewrite rules that are registered for the op type of the current node; then apply rules that are
-    // registered to be applied regardless of the op type; then recursively apply rules to subgraphs (if any).
-    // Stop further rule application for the current node, if the node gets removed by a rule.
-    const InlinedVector<std::reference_wrapper<const RewriteRule>>* rules = nullptr;
+  return Status::OK();
+}
 
-    rules = GetRewriteRulesForOpType(node->OpType());
-    if (rules) {
-      ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, *node, *rules, rule_effect, logger));
-    }
+Status RuleBasedGraphTransformer::ApplyIncrementalImpl(Graph& graph, const InlinedHashSet<NodeIndex>& nodes,
+                                                       bool& modified, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  auto& order = graph_viewer.GetNodesInTopologicalOrder();
 
-    if (rule_effect != RuleEffect::kRemovedCurrentNode) {
-      rules = GetAnyOpRewriteRules();
-      if (rules) {
-        ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, *node, *rules, rule_effect, logger));
-      }
+  for (NodeIndex i : order) {
+    if (nodes.count(i) == 0) {
+      continue;
     }
 
-    // Update the modified field of the rule-based transformer.
-    if (rule_effect != RuleEffect::kNone) {
-      modified = true;
+    auto* node = graph.GetNode(i);
+    if (!node) {
+      continue;
     }
 
-    if (rule_effect != RuleEffect::kRemovedCurrentNode) {
-      ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
-    }
+    ORT_RETURN_IF_ERROR(ApplyRulesAndRecurse(graph, *node, modified, 0, logger));
   }
 
   return Status::OK();
 }
 
+InlinedVector<std::string> RuleBasedGraphTransformer::TargetOpTypes() const {
+  if (!any_op_type_rules_.empty()) {
+    return {};
+  }
+
+  InlinedVector<std::string> op_types;
+  op_types.reserve(op_type_to_rules_.size());
+  for (const auto& entry : op_type_to_rules_) {
+    op_types.push_back(entry.first);
+  }
+
+  return op_types;
+}
+
 size_t RuleBasedGraphTransformer::RulesCount() const {
   return rules_.size();
 }
@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/skip_layer_norm_quantize_fusion.h"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <tuple>
+
+#include "core/graph/graph_utils.h"
+#include "core/mlas/inc/mlas_qnbit.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+constexpr int kQuantizedOutputIndex = 4;
+constexpr int kQuantizedAInputIndex = 6;
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr != nullptr ? attr->i() : default_value;
+}
+
+bool HasInput(const Node& node, size_t index) {
+  return node.InputDefs().size() > index && node.InputDefs()[index]->Exists();
+}
+
+// Bits, block size and whether there are zero points, which together with K determine the layout of quantized A.
+using BQuantization = std::tuple<int64_t, int64_t, bool>;
+
+// Gets the B quantization of a MatMulNBits that consumes the output of the norm node as A and may use it quantized.
+std::optional<BQuantization> GetFusableBQuantization(const Node& norm, const Node& matmul, int64_t hidden_size) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul, "MatMulNBits", {1}, kMSDomain) ||
+      matmul.GetExecutionProviderType() != norm.GetExecutionProviderType() ||
+      GetIntAttribute(matmul, "accuracy_level", 0) != 4 ||
+      GetIntAttribute(matmul, "K", -1) != hidden_size ||
+      HasInput(matmul, 4) ||  // g_idx
+      HasInput(matmul, kQuantizedAInputIndex) ||
+      matmul.InputArgCount().size() <= static_cast<size_t>(kQuantizedAInputIndex)) {
+    return std::nullopt;
+  }
+
+  // Zero points of the type of A are not prepacked, and MatMulNBits does not use the quantized A kernels then.
+  const bool has_zero_points = HasInput(matmul, 3);
+  if (has_zero_points && *matmul.InputDefs()[3]->Type() != "tensor(uint8)") {
+    return std::nullopt;
+  }
+
+  const int64_t bits = GetIntAttribute(matmul, "bits", 4);
+  const int64_t block_size = GetIntAttribute(matmul, "block_size", 0);
+  if (bits <= 0 || block_size <= 0 ||
+      MlasQNBitGemmQuantizedASize(1, static_cast<size_t>(hidden_size), static_cast<size_t>(bits),
+                                  static_cast<size_t>(block_size), has_zero_points, SQNBIT_CompInt8) == 0) {
+    return std::nullopt;
+  }
+
+  return BQuantization{bits, block_size, has_zero_points};
+}
+
+}  // namespace
+
+Status SkipLayerNormQuantizeFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                              const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    Node* p_norm = graph.GetNode(node_index);
+    if (p_norm == nullptr)
+      continue;  // node was removed.
+
+    Node& norm = *p_norm;
+    ORT_RETURN_IF_ERROR(Recurse(norm, modified, graph_level, logger));
+
+    if ((!graph_utils::IsSupportedOptypeVersionAndDomain(norm, "SkipLayerNormalization", {1}, kMSDomain) &&
+         !graph_utils::IsSupportedOptypeVersionAndDomain(norm, "SkipSimplifiedLayerNormalization", {1}, kMSDomain)) ||
+        !graph_utils::IsSupportedProvider(norm, GetCompatibleExecutionProviders()) ||
+        *norm.InputDefs()[0]->Type() != "tensor(float)" ||
+        (norm.OutputDefs().size() > kQuantizedOutputIndex && norm.OutputDefs()[kQuantizedOutputIndex]->Exists())) {
+      continue;
+    }
+
+    const auto* gamma_shape = norm.InputDefs()[2]->Shape();
+    if (gamma_shape == nullptr || gamma_shape->dim_size() != 1 || !utils::HasDimValue(gamma_shape->dim(0))) {
+      continue;
+    }
+    const int64_t hidden_size = gamma_shape->dim(0).dim_value();
+
+    // Group the consumers by their B quantization, which determines the layout they read quantized A in.
+    std::map<BQuantization, InlinedVector<NodeIndex>> consumers;
+    for (auto it = norm.OutputEdgesBegin(), end = norm.OutputEdgesEnd(); it != end; ++it) {
+      if (it->GetSrcArgIndex() != 0 || it->GetDstArgIndex() != 0) {
+        continue;
+      }
+
+      if (auto b_quantization = GetFusableBQuantization(norm, it->GetNode(), hidden_size)) {
+        consumers[*b_quantization].push_back(it->GetNode().Index());
+      }
+    }
+
+    if (consumers.empty()) {
+      continue;
+    }
+
+    const auto fused = std::max_element(consumers.begin(), consumers.end(), [](const auto& a, const auto& b) {
+      return a.second.size() < b.second.size();
+    });
+    const auto& [bits, block_size, has_zero_points] = fused->first;
+
+    TypeProto quantized_output_type;
+    quantized_output_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+    NodeArg& quantized_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(norm.Name() + "_quantized"),
+                                                         &quantized_output_type);
+    NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+
+    auto& output_defs = norm.MutableOutputDefs();
+    output_defs.resize(kQuantizedOutputIndex + 1, &empty_arg);
+    output_defs[kQuantizedOutputIndex] = &quantized_output;
+    norm.AddAttribute("quantized_output_bits", bits);
+    norm.AddAttribute("quantized_output_block_size", block_size);
+    norm.AddAttribute("quantized_output_has_zero_point", static_cast<int64_t>(has_zero_points ? 1 : 0));
+
+    for (NodeIndex matmul_index : fused->second) {
+      Node& matmul = *graph.GetNode(matmul_index);
+
+      // Resolve() gave the missing optional inputs a count of zero, and they are present as empty inputs now.
+      auto& input_defs = matmul.MutableInputDefs();
+      auto& input_args_count = matmul.MutableInputArgsCount();
+      for (size_t i = input_defs.size(); i <= static_cast<size_t>(kQuantizedAInputIndex); ++i) {
+        input_args_count[i] = 1;
+      }
+      input_defs.resize(kQuantizedAInputIndex + 1, &empty_arg);
+      input_defs[kQuantizedAInputIndex] = &quantized_output;
+
+      graph.AddEdge(norm.Index(), matmul_index, kQuantizedOutputIndex, kQuantizedAInputIndex);
+    }
+
+    LOGS(logger, VERBOSE) << "Fused the int8 quantization of the input of " << fused->second.size()
+                          << " MatMulNBits node(s) into " << norm.OpType() << " node " << norm.Name();
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class SkipLayerNormQuantizeFusion
+
+Makes a float SkipLayerNormalization or SkipSimplifiedLayerNormalization quantize its output to the int8 A layout of
+the MatMulNBits nodes with accuracy_level 4 that consume it, through the optional quantized_output of the norm and the
+optional quantized_A input of the MatMulNBits. The norm quantizes each row while it is still in cache, which saves the
+MatMulNBits nodes a pass over the whole activation each.
+
+The consumers with the same B quantization share the quantized output. If the consumers differ, the largest group of
+them is fused. The layout is platform specific, so this only applies to nodes assigned to the CPU execution provider.
+
+*/
+class SkipLayerNormQuantizeFusion : public GraphTransformer {
+ public:
+  explicit SkipLayerNormQuantizeFusion(
+      const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("SkipLayerNormQuantizeFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/zipmap_columnar_transformer.h"
+
+#include "core/graph/graph_utils.h"
+
+namespace onnxruntime {
+
+static bool IsCandidateNode(const Graph& graph, const Node& node,
+                            const InlinedHashSet<std::string_view>& compatible_providers) {
+  // The output must not be consumed by any node, including nodes in subgraphs, as they expect the map type.
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "ZipMap", {1}, kMLDomain) &&
+         graph_utils::IsSupportedProvider(node, compatible_providers) &&
+         node.GetOutputEdgesCount() == 0 &&
+         graph.IsOutput(node.OutputDefs()[0]);
+}
+
+Status ZipMapColumnarTransformer::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                            const logging::Logger& logger) const {
+  // The outputs of a subgraph are consumed by the node that contains it, so only the main graph is rewritten.
+  if (graph.ParentGraph() != nullptr) {
+    return Status::OK();
+  }
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  int count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr || !IsCandidateNode(graph, *p_node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    Node& node = *p_node;
+
+    // The graph output keeps its NodeArg, so its type is replaced. The shape is inferred when the graph is resolved.
+    ONNX_NAMESPACE::TypeProto output_type;
+    output_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    graph.SetNodeArgType(*node.MutableOutputDefs()[0], output_type);
+
+    Node& zipmap_columnar = graph.AddNode(graph.GenerateNodeName(node.Name() + "_columnar"), "ZipMapColumnar",
+                                          "Columnar ZipMap", node.MutableInputDefs(), node.MutableOutputDefs(),
+                                          &node.GetAttributes(), kMSDomain);
+    zipmap_columnar.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.Index());
+    count++;
+  }
+
+  if (count > 0) {
+    modified = true;
+    LOGS(logger, INFO) << "Total ZipMap nodes rewritten to ZipMapColumnar: " << count;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ZipMapColumnarTransformer
+
+Rewrite ai.onnx.ml ZipMap nodes whose output is a graph output of the main graph into com.microsoft.ZipMapColumnar
+nodes. The graph output keeps its name but changes from a sequence of maps to a float tensor of shape [N, C].
+Only enabled by the kOrtSessionOptionsZipMapColumnarOutput session config entry, as it changes the output type.
+*/
+class ZipMapColumnarTransformer : public GraphTransformer {
+ public:
+  ZipMapColumnarTransformer(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ZipMapColumnarTransformer", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -15,6 +15,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/sequential_executor.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
@@ -205,6 +206,15 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
     auto& output = subgraph_outputs[i];
     subgraph_output_names.push_back(output->Name());
   }
+
+  // the 'cond' output is either the 'cond' input or an Identity of it
+  const auto& condition_input_name = subgraph_input_names[1];
+  condition_is_loop_invariant = subgraph_output_names[0] == condition_input_name;
+  if (!condition_is_loop_invariant) {
+    const auto* producer = subgraph.GetProducerNode(subgraph_output_names[0]);
+    condition_is_loop_invariant = producer != nullptr && producer->OpType() == "Identity" &&
+                                  producer->InputDefs()[0]->Name() == condition_input_name;
+  }
 }
 
 class LoopImpl {
@@ -228,6 +238,21 @@ class LoopImpl {
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
+  // Setup the allocators that let the subgraph write the loop carried variables to the buffers of a previous
+  // iteration, and the scan outputs to slices of the Loop outputs.
+  void CreateFetchAllocators(std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // Returns true if the value of a loop carried variable that is replaced by the next iteration can be overwritten
+  // by a later iteration.
+  bool IsReusableLoopCarriedVar(const OrtValue& value, const std::vector<OrtValue>& last_outputs,
+                                int loop_carried_var_index) const;
+
+  // Get the slice of the Loop output for the current iteration of a scan output, allocating the Loop output if needed.
+  Status GetScanOutputSlice(int scan_output_index, const TensorShape& per_iteration_shape, OrtValue& slice);
+
+  // Copy the scan outputs of the last iteration into the Loop outputs if they were not written there directly.
+  Status WriteScanOutputs(const std::vector<OrtValue>& last_outputs);
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const Loop::Info& info_;
@@ -245,6 +270,21 @@ class LoopImpl {
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
   const Loop::ConcatOutput& concat_output_func_;
+
+  // Iterations on CPU keep the execution frame of the subgraph alive, alternate the loop carried variables between
+  // two buffers, and write the scan outputs directly into the Loop outputs if the number of iterations is known.
+  bool fast_iterations_;
+  bool write_scan_outputs_in_place_{false};
+  PersistentExecutionContext persistent_context_;
+
+  // per loop carried variable, the value of a previous iteration that the subgraph can overwrite
+  std::vector<OrtValue> spare_loop_carried_vars_;
+
+  // data of the Loop inputs and of the saved scan outputs, which must not be overwritten
+  InlinedHashSet<const void*> read_only_buffers_;
+
+  // the Loop outputs for the scan outputs if they are written in place
+  std::vector<Tensor*> scan_outputs_;
 };
 
 static Status ConcatenateCpuOutput(void* /*stream*/,
@@ -400,7 +440,9 @@ LoopImpl::LoopImpl(OpKernelContextInternal& context,
       session_state_(session_state),
       info_(subgraph_info),
       implicit_inputs_(context_.GetImplicitInputs()),
-      concat_output_func_(concat_output_func) {
+      concat_output_func_(concat_output_func),
+      fast_iterations_(context.GetComputeStream() == nullptr),
+      persistent_context_(session_state) {
   auto* max_trip_count_tensor = context.Input<Tensor>(0);
   max_trip_count_ = max_trip_count_tensor ? *max_trip_count_tensor->Data<int64_t>() : INT64_MAX;
 
@@ -446,6 +488,40 @@ Status LoopImpl::Initialize() {
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
 
+  if (fast_iterations_) {
+    spare_loop_carried_vars_.resize(info_.num_loop_carried_vars);
+
+    const auto add_read_only_buffer = [this](const OrtValue* value) {
+      if (value != nullptr && value->IsTensor() && value->Get<Tensor>().SizeInBytes() > 0) {
+        read_only_buffers_.insert(value->Get<Tensor>().DataRaw());
+      }
+    };
+
+    for (int i = 2; i < info_.num_subgraph_inputs; ++i) {
+      add_read_only_buffer(context_.GetInputMLValue(i));
+    }
+
+    for (const auto* entry : implicit_inputs_) {
+      add_read_only_buffer(entry);
+    }
+
+    // The trip count is known if the condition can't change. Packed sub-byte types can't be sliced per iteration.
+    write_scan_outputs_in_place_ = info_.condition_is_loop_invariant && max_trip_count_tensor != nullptr &&
+                                   condition_ && max_trip_count_ > 0 && info_.num_outputs > info_.num_loop_carried_vars;
+
+    auto& subgraph_outputs = info_.subgraph.GetOutputs();
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs && write_scan_outputs_in_place_; ++i) {
+      const auto* type = subgraph_outputs[static_cast<size_t>(i) + 1]->TypeAsProto();  // skip 'cond'
+      write_scan_outputs_in_place_ = type != nullptr && type->has_tensor_type() &&
+                                     type->tensor_type().elem_type() != TensorProto_DataType_INT4 &&
+                                     type->tensor_type().elem_type() != TensorProto_DataType_UINT4;
+    }
+
+    if (write_scan_outputs_in_place_) {
+      scan_outputs_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars, nullptr);
+    }
+  }
+
   return status;
 }
 
@@ -472,16 +548,72 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
+  // save loop outputs as we have to concatenate at the end
+  if (!write_scan_outputs_in_place_) {
+    for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
+      ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
+      loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+
+      if (fast_iterations_ && last_outputs[j + 1].Get<Tensor>().SizeInBytes() > 0) {
+        read_only_buffers_.insert(last_outputs[j + 1].Get<Tensor>().DataRaw());
+      }
+    }
+  }
+
+  // the previous values of the loop carried vars can be overwritten by the next iteration once they are replaced,
+  // unless they are still referenced elsewhere
+  if (fast_iterations_) {
+    for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+      auto& spare = spare_loop_carried_vars_[i];
+      spare = OrtValue();
+
+      const OrtValue& previous = next_inputs[static_cast<ptrdiff_t>(i) + 2];
+      if (IsReusableLoopCarriedVar(previous, last_outputs, i)) {
+        spare = previous;
+      }
+    }
+  }
+
   // simple copy for cond and loop carried vars. start at 1 to skip iter_num in input
   for (ptrdiff_t i = 1; i < info_.num_subgraph_inputs; ++i) {
     next_inputs[i] = last_outputs[i - 1];
   }
+}
 
-  // save loop outputs as we have to concatenate at the end
-  for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
-    ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
-    loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+bool LoopImpl::IsReusableLoopCarriedVar(const OrtValue& value, const std::vector<OrtValue>& last_outputs,
+                                        int loop_carried_var_index) const {
+  if (!value.IsTensor() || value.Get<Tensor>().SizeInBytes() == 0 ||
+      value.Get<Tensor>().Location().device.Type() != OrtDevice::CPU) {
+    return false;
+  }
+
+  const void* data = value.Get<Tensor>().DataRaw();
+  if (read_only_buffers_.count(data) != 0) {
+    return false;
   }
+
+  // a loop carried var that is also a scan output may be a slice of the Loop output
+  for (const auto* scan_output : scan_outputs_) {
+    if (scan_output != nullptr) {
+      const auto* begin = static_cast<const std::byte*>(scan_output->DataRaw());
+      const auto* p = static_cast<const std::byte*>(data);
+      if (p >= begin && p < begin + scan_output->SizeInBytes()) {
+        return false;
+      }
+    }
+  }
+
+  const auto references_data = [data](const OrtValue& other) {
+    return other.IsTensor() && other.Get<Tensor>().DataRaw() == data;
+  };
+
+  // a subgraph output can pass a previous value through, and the spares must be distinct
+  if (std::any_of(last_outputs.begin(), last_outputs.end(), references_data)) {
+    return false;
+  }
+
+  return std::none_of(spare_loop_carried_vars_.begin(), spare_loop_carried_vars_.begin() + loop_carried_var_index,
+                      references_data);
 }
 
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
@@ -504,13 +636,100 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_outp
   return Status::OK();
 }
 
+void LoopImpl::CreateFetchAllocators(std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    // + 1 to skip 'cond' in the fetches
+    fetch_allocators[static_cast<size_t>(i) + 1] = [this, i](const TensorShape& shape, const OrtDevice& location,
+                                                             OrtValue& ort_value, bool& allocated) {
+      auto& spare = spare_loop_carried_vars_[i];
+      if (spare.IsTensor() && spare.Get<Tensor>().Shape() == shape &&
+          spare.Get<Tensor>().Location().device == location) {
+        ort_value = std::move(spare);
+        spare = OrtValue();
+        allocated = true;
+      }
+
+      return Status::OK();
+    };
+  }
+
+  if (write_scan_outputs_in_place_) {
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+      const int scan_output_index = i - info_.num_loop_carried_vars;
+      fetch_allocators[static_cast<size_t>(i) + 1] = [this, scan_output_index](const TensorShape& shape,
+                                                                               const OrtDevice& location,
+                                                                               OrtValue& ort_value, bool& allocated) {
+        OrtValue slice;
+        ORT_RETURN_IF_ERROR(GetScanOutputSlice(scan_output_index, shape, slice));
+
+        // if the subgraph produces the value on another device it is copied into the slice by WriteScanOutputs
+        if (slice.Get<Tensor>().Location().device == location) {
+          ort_value = std::move(slice);
+          allocated = true;
+        }
+
+        return Status::OK();
+      };
+    }
+  }
+}
+
+Status LoopImpl::GetScanOutputSlice(int scan_output_index, const TensorShape& per_iteration_shape, OrtValue& slice) {
+  Tensor*& output = scan_outputs_[scan_output_index];
+  if (output == nullptr) {
+    // first dimension is number of iterations
+    TensorShapeVector dims;
+    dims.reserve(per_iteration_shape.NumDimensions() + 1);
+    dims.push_back(max_trip_count_);
+    const auto per_iteration_dims = per_iteration_shape.GetDims();
+    dims.insert(dims.end(), per_iteration_dims.begin(), per_iteration_dims.end());
+
+    const int output_index = info_.num_loop_carried_vars + scan_output_index;
+    output = context_.Output(output_index, TensorShape(dims));
+    ORT_RETURN_IF(output == nullptr, "Failed to allocate Loop output ", output_index);
+  } else if (output->Shape().Slice(1) != per_iteration_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Inconsistent shape in loop output for output. ",
+                           " Expected:", output->Shape().Slice(1), " Got:", per_iteration_shape);
+  }
+
+  const auto iteration = *iter_num_mlvalue_.Get<Tensor>().Data<int64_t>();
+  const size_t bytes_per_iteration = output->SizeInBytes() / static_cast<size_t>(max_trip_count_);
+  auto* data = static_cast<std::byte*>(output->MutableDataRaw()) + static_cast<size_t>(iteration) * bytes_per_iteration;
+  Tensor::InitOrtValue(output->DataType(), per_iteration_shape, data, output->Location(), slice);
+
+  return Status::OK();
+}
+
+Status LoopImpl::WriteScanOutputs(const std::vector<OrtValue>& last_outputs) {
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    const auto& value = last_outputs[static_cast<size_t>(i) + 1];  // skip 'cond'
+    ORT_RETURN_IF_NOT(value.IsTensor(), "All scan outputs MUST be tensors");
+
+    const auto& tensor = value.Get<Tensor>();
+    OrtValue slice;
+    ORT_RETURN_IF_ERROR(GetScanOutputSlice(i - info_.num_loop_carried_vars, tensor.Shape(), slice));
+
+    // the allocator is not used if the value is a subgraph input or initializer, if it is also a loop carried var,
+    // or if it was produced on another device
+    if (slice.Get<Tensor>().DataRaw() != tensor.DataRaw()) {
+      ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(tensor, *slice.GetMutable<Tensor>()));
+    }
+  }
+
+  return Status::OK();
+}
+
 Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto status = Status::OK();
 
   std::vector<OrtValue> feeds;
   std::vector<OrtValue> fetches;
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
   CreateInitialFeeds(feeds);
+  if (fast_iterations_) {
+    CreateFetchAllocators(fetch_allocators);
+  }
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
@@ -520,19 +739,28 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
                                     // have to perofrm a stream sync to make sure the data arrived.
-                                    true);
+                                    true,
+                                    fast_iterations_ ? &persistent_context_ : nullptr);
     ORT_RETURN_IF_ERROR(status);
 
+    if (write_scan_outputs_in_place_) {
+      ORT_RETURN_IF_ERROR(WriteScanOutputs(fetches));
+    }
+
     condition_mlvalue_ = fetches[0];
 
     ++iter_num_value;
   }
 
+  ORT_RETURN_IF(write_scan_outputs_in_place_ && iter_num_value != max_trip_count_,
+                "Loop with a loop invariant condition stopped after ", iter_num_value, " of ", max_trip_count_,
+                " iterations");
+
   // As the loop carried variables may change shape across iterations there's no way to avoid a copy
   // as we need the final shape.
   auto copy_mlvalue_to_output = [this](OrtValue& input, int output_idx,
@@ -605,7 +833,8 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
       ORT_RETURN_IF_ERROR(copy_mlvalue_to_output(fetches[static_cast<ptrdiff_t>(i) + 1], i, iter_num_value, *info_.loop_carried_vars_types[static_cast<ptrdiff_t>(i)]));  // skip cond
     }
 
-    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    // scan outputs written in place are complete
+    for (int i = info_.num_loop_carried_vars; i < info_.num_outputs && !write_scan_outputs_in_place_; ++i) {
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
       per_iteration_outputs.push_back(fetches[static_cast<ptrdiff_t>(i) + 1]);  // skip cond
@@ -38,6 +38,10 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // true if the subgraph passes its 'cond' input through to its 'cond' output, so the Loop runs for the full
+    // trip count once it starts.
+    bool condition_is_loop_invariant;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
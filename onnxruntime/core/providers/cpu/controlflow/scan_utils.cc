@@ -199,6 +199,9 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
   std::vector<OrtValue> fetches;
   std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
+  // keep the execution frame of the subgraph alive across the iterations
+  PersistentExecutionContext persistent_context(session_state);
+
   feeds.resize(num_inputs);
   fetches.resize(num_variadic_outputs);
 
@@ -272,7 +275,7 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
     // Create Executor and run graph.
     status = utils::ExecuteSubgraph(session_state, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(), context.Logger(),
-                                    context.GetComputeStream());
+                                    context.GetComputeStream(), false, &persistent_context);
 
     ORT_RETURN_IF_ERROR(status);
 
@@ -32,8 +32,23 @@ CPUExecutionProvider::CPUExecutionProvider(const CPUExecutionProviderInfo& info)
 
 std::vector<AllocatorPtr> CPUExecutionProvider::CreatePreferredAllocators() {
   const bool create_arena = DoesCpuAllocatorSupportArenaUsage() ? info_.create_arena : false;
-  AllocatorCreationInfo device_info_cpu{[](int) { return std::make_unique<CPUAllocator>(); },
-                                        DEFAULT_CPU_ALLOCATOR_DEVICE_ID, create_arena};
+  AllocatorFactory device_alloc_factory = [](int) { return std::make_unique<CPUAllocator>(); };
+  OrtArenaCfg arena_cfg{0, -1, -1, -1, -1, -1L};
+  if (info_.page_allocator_options.IsEnabled()) {
+    // the page allocator maps every allocation from the OS, so it only backs the regions of an arena
+    if (create_arena) {
+      device_alloc_factory = [options = info_.page_allocator_options](int) {
+        return std::make_unique<CPUPageAllocator>(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator), options);
+      };
+      info_.page_allocator_options.AdjustArenaConfig(arena_cfg);
+    } else {
+      LOGS_DEFAULT(WARNING) << "The CPU allocator huge page and NUMA node options are ignored as the CPU memory arena "
+                            << "is disabled.";
+    }
+  }
+
+  AllocatorCreationInfo device_info_cpu{device_alloc_factory, DEFAULT_CPU_ALLOCATOR_DEVICE_ID, create_arena,
+                                        arena_cfg};
 
   return std::vector<AllocatorPtr>{CreateAllocator(device_info_cpu)};
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "core/framework/cpu_page_allocator.h"
 #include "core/framework/execution_provider.h"
 #include "core/graph/constants.h"
 
@@ -11,6 +12,8 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // Huge page and NUMA options for the memory that backs the allocator.
+  CPUPageAllocatorOptions page_allocator_options{};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -33,6 +33,8 @@ std::unique_ptr<IExecutionProvider> CpuProviderFactory::CreateProvider(const Ort
                                                                        const OrtLogger& session_logger) {
   CPUExecutionProviderInfo info;
   info.create_arena = session_options.value.enable_cpu_mem_arena;
+  ORT_THROW_IF_ERROR(CPUPageAllocatorOptions::FromConfigOptions(session_options.value.config_options,
+                                                                info.page_allocator_options));
 
   auto cpu_ep = std::make_unique<CPUExecutionProvider>(info);
   cpu_ep->SetLogger(reinterpret_cast<const logging::Logger*>(&session_logger));
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace onnxruntime::common;
 
@@ -34,14 +35,36 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
               size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
               void* /*einsum_cuda_assets*/) {
-  for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp);
+  if constexpr (std::is_same<T, float>::value) {
+    // Schedule all batches of the float MatMul together instead of running one threaded GEMM
+    // after another, which leaves most threads idle when the individual matrices are small.
+    std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
+    for (size_t i = 0; i < num_batches; ++i) {
+      data[i].A = input_1_data + i * left_stride;
+      data[i].lda = K;
+      data[i].B = input_2_data + i * right_stride;
+      data[i].ldb = N;
+      data[i].C = output_data + i * output_stride;
+      data[i].ldc = N;
+    }
+
+    MLAS_SGEMM_GROUP_PARAMS group;
+    group.M = M;
+    group.N = N;
+    group.K = K;
+    group.Data = data.data();
+    group.BatchSize = num_batches;
+    MlasGemmGrouped(&group, 1, tp);
+  } else {
+    for (size_t i = 0; i < num_batches; ++i) {
+      math::MatMul<T>(
+          static_cast<int>(M),
+          static_cast<int>(N),
+          static_cast<int>(K),
+          input_1_data + i * left_stride,
+          input_2_data + i * right_stride,
+          output_data + i * output_stride, tp);
+    }
   }
 
   return Status::OK();
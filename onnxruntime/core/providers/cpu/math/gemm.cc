@@ -140,6 +140,41 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_a,
+                         bool trans_b,
+                         IAllocatorUniquePtr<void>& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape) {
+  // The sparse SGEMM reads the rows of A in place.
+  if (trans_a || tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const auto& shape = tensor_b.Shape();
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  const float* b_data = tensor_b.Data<float>();
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasTrans : CblasNoTrans;
+  const size_t ldb = trans_b ? K : N;
+
+  const MLAS_SPARSE_SGEMM_FORMAT format = MlasSparseSgemmSelectFormat(trans, N, K, b_data, ldb);
+  if (format == MlasSparseSgemmFormatNone) {
+    return false;
+  }
+
+  packed_b_size = MlasSparseSgemmPackBSize(format, trans, N, K, b_data, ldb);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  b_shape = shape;
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  MlasSparseSgemmPackB(format, trans, N, K, b_data, ldb, packed_b.get());
+  return true;
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -276,7 +311,24 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_A_ != CblasNoTrans, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+#if defined(MLAS_SUPPORTS_SBGEMM)
+    const auto& b_shape = tensor.Shape();
+    if (b_shape.NumDimensions() == 2 && UseFastMathMode(b_shape[1], b_shape[0])) {
+      is_packed = GemmPackBBfloat16(alloc, tensor, false, packed_b_, packed_b_size, b_shape_);
+      packed_b_is_bfloat16_ = is_packed;
+    } else
+#endif
+    {
+      if (use_sparse_gemm_) {
+        is_packed = GemmPackBSparseFp32(alloc, tensor, trans_A_ != CblasNoTrans, trans_B_ != CblasNoTrans, packed_b_,
+                                        packed_b_size, b_shape_);
+        packed_b_is_sparse_ = is_packed;
+      }
+      if (!is_packed) {
+        is_packed = GemmPackBFp32(alloc, tensor, trans_A_ != CblasNoTrans, trans_B_ != CblasNoTrans, packed_b_,
+                                  packed_b_size, b_shape_);
+      }
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -401,6 +453,33 @@ Status Gemm<MLFloat16>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+#if defined(MLAS_SUPPORTS_SBGEMM)
+namespace {
+
+// The bfloat16 GEMM overwrites the output, so beta * C is added to its result
+// with the broadcasting of GemmBroadcastBias.
+void GemmAddBroadcastBias(ptrdiff_t M, ptrdiff_t N, float beta,
+                          const float* c_data, const TensorShape* c_shape,
+                          float* y_data) {
+  if (beta == 0 || c_data == nullptr) {
+    return;
+  }
+
+  auto output_mat = EigenMatrixMapRowMajor<float>(y_data, M, N);
+  if (c_shape->Size() == 1) {
+    output_mat.array() += beta * *c_data;
+  } else if (c_shape->NumDimensions() == 1 || (*c_shape)[0] == 1) {
+    output_mat.rowwise() += beta * ConstEigenVectorMap<float>(c_data, N).transpose();
+  } else if ((*c_shape)[1] == 1) {
+    output_mat.colwise() += beta * ConstEigenVectorMap<float>(c_data, M);
+  } else {
+    output_mat += beta * ConstEigenMatrixMapRowMajor<float>(c_data, M, N);
+  }
+}
+
+}  // namespace
+#endif
+
 template <>
 Status Gemm<float>::Compute(OpKernelContext* context) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
@@ -431,12 +510,41 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
+#if defined(MLAS_SUPPORTS_SBGEMM)
+  if (K > 0 && (packed_b_is_bfloat16_ || (B && UseFastMathMode(N, K)))) {
+    MLAS_SBGEMM_DATA_PARAMS data;
+    data.AIsfp32 = true;
+    data.BIsfp32 = !packed_b_is_bfloat16_;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(K);
+    data.B = data.BIsfp32 ? static_cast<const void*>(B->Data<float>()) : packed_b_.get();
+    data.ldb = static_cast<size_t>(N);
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    MlasSBGemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), 1, &data, thread_pool);
+
+    GemmAddBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+    return Status::OK();
+  }
+#endif
+
   if (B) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    if (K > 0) {
+    if (K > 0 && packed_b_is_sparse_) {
+      MLAS_SPARSE_SGEMM_DATA_PARAMS data;
+      data.A = A->Data<float>();
+      data.lda = static_cast<size_t>(K);
+      data.C = y_data;
+      data.ldc = static_cast<size_t>(N);
+      data.alpha = alpha_;
+      data.beta = c_data != nullptr ? beta_ : 0.0f;
+      MlasSparseSgemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), packed_b_.get(),
+                           &data, 1, thread_pool);
+    } else if (K > 0) {
       MlasGemm(
           trans_A_,
           static_cast<size_t>(M),
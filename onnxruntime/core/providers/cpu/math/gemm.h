@@ -7,6 +7,8 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
 
@@ -25,6 +27,11 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+#if defined(MLAS_SUPPORTS_SBGEMM)
+    auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
+    use_fastmath_mode_ = std::is_same<T, float>::value && (config_ops == "1") && MlasBf16AccelerationSupported();
+#endif
+    use_sparse_gemm_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasSparseGemm, "1") == "1";
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -50,10 +57,29 @@ class Gemm : protected GemmBase, public OpKernel {
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
 
+  // Pack sparse weights for MlasSparseSgemmBatch, see MatMul<float>.
+  bool use_sparse_gemm_{true};
+  bool packed_b_is_sparse_{false};
+
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
+
+#if defined(MLAS_SUPPORTS_SBGEMM)
+  // fastmath mode state, see MatMul<float>
+  bool use_fastmath_mode_{false};
+  const size_t kFastMathModeKernelsizeThreshold = 32;
+
+  // The bfloat16 GEMM has no alpha and no transposes, so only the plain product is accelerated.
+  bool UseFastMathMode(ptrdiff_t N, ptrdiff_t K) const {
+    return use_fastmath_mode_ && trans_A_ == CblasNoTrans && trans_B_ == CblasNoTrans && alpha_ == 1.0f &&
+           static_cast<size_t>(N) * static_cast<size_t>(K) >= kFastMathModeKernelsizeThreshold;
+  }
+
+  // packed_b_ holds bfloat16 data from MlasSBGemmConvertPackB rather than MlasGemmPackB.
+  bool packed_b_is_bfloat16_{false};
+#endif
 };
 
 }  // namespace onnxruntime
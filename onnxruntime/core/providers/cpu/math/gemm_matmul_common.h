@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -14,4 +15,23 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    IAllocatorUniquePtr<void>& packed_b,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
+
+// Packs a 2D weight matrix for MlasSparseSgemmBatch if it is sparse enough for the sparse SGEMM to be faster than the
+// dense one. Returns false if it is not, in which case the caller packs it with GemmPackBFp32.
+bool GemmPackBSparseFp32(AllocatorPtr& alloc,
+                         const Tensor& tensor_b,
+                         bool trans_a,
+                         bool trans_b,
+                         IAllocatorUniquePtr<void>& packed_b,
+                         size_t& packed_b_size,
+                         TensorShape& b_shape);
+
+#if defined(MLAS_SUPPORTS_SBGEMM)
+bool GemmPackBBfloat16(AllocatorPtr& alloc,
+                       const Tensor& tensor_b,
+                       bool trans_b,
+                       IAllocatorUniquePtr<void>& packed_b,
+                       size_t& packed_b_size,
+                       TensorShape& b_shape);
+#endif
 };  // namespace onnxruntime
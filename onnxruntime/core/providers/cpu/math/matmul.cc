@@ -7,6 +7,9 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -133,7 +136,7 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   return Status::OK();
 }
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
 bool GemmPackBBfloat16(AllocatorPtr& alloc,
                        const Tensor& tensor_b,
                        bool trans_b,
@@ -180,7 +183,7 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
     size_t dim1 = 0;
     size_t dim2 = 0;
     TensorShape b_shape = tensor.Shape();
@@ -195,7 +198,15 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
     } else
 #endif
     {
-      is_packed = GemmPackBFp32(alloc, tensor, trans_a_attr_, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      if (use_sparse_gemm_) {
+        is_packed = GemmPackBSparseFp32(alloc, tensor, trans_a_attr_ != 0, trans_b_attr_ != 0, packed_b_,
+                                        packed_b_size, b_shape_);
+        packed_b_is_sparse_ = is_packed;
+      }
+      if (!is_packed) {
+        is_packed = GemmPackBFp32(alloc, tensor, trans_a_attr_, trans_b_attr_ != 0, packed_b_, packed_b_size,
+                                  b_shape_);
+      }
     }
 
     bool share_prepacked_weights = (prepacked_weights != nullptr);
@@ -258,7 +269,23 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
-#if defined(__aarch64__) && defined(__linux__)
+
+  if (packed_b_is_sparse_) {
+    // B is a single 2D matrix, so every multiplication of the batch shares the packed B.
+    std::vector<MLAS_SPARSE_SGEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+      data[i].alpha = alpha_attr_;
+      data[i].beta = 0.0f;
+    }
+    MlasSparseSgemmBatch(M, N, K, packed_b_.get(), data.data(), max_len, thread_pool);
+    return Status::OK();
+  }
+
+#if defined(MLAS_SUPPORTS_SBGEMM)
   if (use_fastmath_mode_ && !trans_b && ((N * K) >= kFastMathModeKernelsizeThreshold)) {
     std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
@@ -277,20 +304,48 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   } else
 #endif
   {
+    // Order the batch by the offset into B so that the multiplications of a broadcast B form one
+    // group. The grouped SGEMM packs a shared B once per group and schedules the tiles of all
+    // multiplications together, which keeps the threads busy for many small matrices.
+    const auto& right_offsets = helper.RightOffsets();
+    std::vector<size_t> order(max_len);
+    std::iota(order.begin(), order.end(), size_t{0});
+    if (!packed_b_) {
+      std::stable_sort(order.begin(), order.end(),
+                       [&right_offsets](size_t l, size_t r) { return right_offsets[l] < right_offsets[r]; });
+    }
+
     std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
-    for (size_t i = 0; i < max_len; i++) {
-      data[i].BIsPacked = bool(packed_b_);
-      data[i].A = a_data + helper.LeftOffsets()[i];
-      data[i].lda = lda;
-      data[i].B = data[i].BIsPacked ? (float*)packed_b_.get() : b_data + helper.RightOffsets()[i];
-      data[i].ldb = ldb;
-      data[i].C = y_data + helper.OutputOffsets()[i];
-      data[i].ldc = N;
-      data[i].alpha = alpha_attr_;
-      data[i].beta = 0.0f;
+    std::vector<MLAS_SGEMM_GROUP_PARAMS> groups;
+    for (size_t j = 0; j < max_len; j++) {
+      const size_t i = order[j];
+      data[j].BIsPacked = bool(packed_b_);
+      data[j].A = a_data + helper.LeftOffsets()[i];
+      data[j].lda = lda;
+      data[j].B = data[j].BIsPacked ? (float*)packed_b_.get() : b_data + right_offsets[i];
+      data[j].ldb = ldb;
+      data[j].C = y_data + helper.OutputOffsets()[i];
+      data[j].ldc = N;
+      data[j].alpha = alpha_attr_;
+      data[j].beta = 0.0f;
+
+      if (groups.empty() || data[j].B != data[j - 1].B) {
+        MLAS_SGEMM_GROUP_PARAMS& group = groups.emplace_back();
+        group.TransA = trans_a ? CblasTrans : CblasNoTrans;
+        group.TransB = trans_b ? CblasTrans : CblasNoTrans;
+        group.M = M;
+        group.N = N;
+        group.K = K;
+        group.Data = &data[j];
+      }
+      groups.back().BatchSize++;
+    }
+    if (groups.size() == max_len && max_len > 1) {
+      // No B is shared, so keep the whole batch in a single group.
+      groups.resize(1);
+      groups[0].BatchSize = max_len;
     }
-    MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
-                  M, N, K, data.data(), max_len, thread_pool);
+    MlasGemmGrouped(groups.data(), groups.size(), thread_pool);
   }
   return Status::OK();
 }
@@ -30,10 +30,11 @@ class MatMul<float> final : public OpKernel {
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
     auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
     use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
 #endif
+    use_sparse_gemm_ = info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasSparseGemm, "1") == "1";
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -49,6 +50,10 @@ class MatMul<float> final : public OpKernel {
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
 
+  // Pack sparse weights for MlasSparseSgemmBatch. packed_b_ then holds the sparse packing.
+  bool use_sparse_gemm_;
+  bool packed_b_is_sparse_{false};
+
   // For FusedMatMul contrib ops
   float alpha_attr_;
   int64_t trans_a_attr_;
@@ -56,7 +61,7 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_a_;
   bool trans_batch_b_;
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
   // fastmath mode state
   bool use_fastmath_mode_;
   // sbgemm kernel is implemented as 8x8 blocks with weights pre-packed to 4 blocks of 4x2
@@ -153,20 +153,125 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  const auto& W_shape = tensor.Shape();
+  const int64_t group = conv_attrs_.group;
+  if (W_shape.NumDimensions() != 4 || group <= 0 || W_shape[0] % group != 0) {
+    return Status::OK();
+  }
+
+  TensorShapeVector kernel_shape;
+  if (!conv_attrs_.ComputeKernelShape(W_shape, kernel_shape).IsOK() ||
+      kernel_shape.size() != 2 || kernel_shape[0] != 3 || kernel_shape[1] != 3) {
+    return Status::OK();
+  }
+
+  auto is_one = [](int64_t v) { return v == 1; };
+  if (!std::all_of(conv_attrs_.strides.begin(), conv_attrs_.strides.end(), is_one) ||
+      !std::all_of(conv_attrs_.dilations.begin(), conv_attrs_.dilations.end(), is_one)) {
+    return Status::OK();
+  }
+
+  // Select the tile size from the output shape when the spatial shape of the input is static.
+  size_t output_height = 0;
+  size_t output_width = 0;
+  const auto* X_shape = Node().InputDefs()[0]->Shape();
+  const bool static_input_shape = X_shape != nullptr && X_shape->dim_size() == 4 &&
+                                  X_shape->dim(2).has_dim_value() && X_shape->dim(3).has_dim_value();
+  if (static_input_shape) {
+    const TensorShape input_shape({X_shape->dim(2).dim_value(), X_shape->dim(3).dim_value()});
+    const TensorShapeVector unit_strides(2, 1);
+    ConvPadVector pads(conv_attrs_.pads);
+    if (pads.empty()) {
+      pads.resize(4, 0);
+    }
+    TensorShapeVector output_dims;
+    const Status status = conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, unit_strides, unit_strides,
+                                                              pads, output_dims);
+    if (!status.IsOK()) {
+      return Status::OK();
+    }
+    output_height = narrow<size_t>(output_dims[0]);
+    output_width = narrow<size_t>(output_dims[1]);
+  }
+
+  const size_t group_count = narrow<size_t>(group);
+  const size_t input_channels = narrow<size_t>(W_shape[1]);
+  const size_t filter_count = narrow<size_t>(W_shape[0] / group);
+
+  const size_t tile_size = MlasConvWinogradSelectTileSize(input_channels, filter_count, output_height, output_width);
+  if (tile_size == 0) {
+    return Status::OK();
+  }
+
+  const size_t packed_W_size = MlasConvWinogradPackFilterSize(tile_size, group_count, input_channels, filter_count);
+  auto* packed_W_data = alloc->Alloc(packed_W_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we do not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_W_data, 0, packed_W_size);
+
+  winograd_packed_W_ = BufferUniquePtr(packed_W_data, BufferDeleter(std::move(alloc)));
+  MlasConvWinogradPackFilter(tile_size, group_count, input_channels, filter_count, tensor.Data<float>(),
+                             winograd_packed_W_.get());
+  winograd_tile_size_ = tile_size;
+
+  // With a static input shape Compute always takes the Winograd path, so the
+  // original filter is released. Otherwise it stays available to Compute for
+  // the input shapes that are not worth computing with the Winograd convolution.
+  if (!static_input_shape) {
+    return Status::OK();
+  }
+
+  W_shape_ = W_shape;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(winograd_packed_W_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    winograd_packed_W_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
+  // W is nullptr when only the Winograd filter was kept by PrePack.
   const Tensor* W = context->Input<Tensor>(1);
+  const TensorShape& W_shape = W != nullptr ? W->Shape() : W_shape_;
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -213,7 +318,36 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const size_t kernel_rank = kernel_shape.size();
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
-  if (kernel_rank >= 1 && kernel_rank <= 3) {
+  if (winograd_packed_W_ != nullptr && kernel_rank == 2 &&
+      (W == nullptr ||
+       MlasConvWinogradSelectTileSize(narrow<size_t>(C / conv_attrs_.group), narrow<size_t>(M / conv_attrs_.group),
+                                      narrow<size_t>(output_shape[0]), narrow<size_t>(output_shape[1])) != 0)) {
+    MLAS_CONV_WINOGRAD_PARAMETERS Parameters;
+    Parameters.TileSize = winograd_tile_size_;
+    Parameters.BatchCount = narrow<size_t>(N);
+    Parameters.GroupCount = narrow<size_t>(conv_attrs_.group);
+    Parameters.InputChannels = narrow<size_t>(C / conv_attrs_.group);
+    Parameters.FilterCount = narrow<size_t>(M / conv_attrs_.group);
+    Parameters.InputHeight = narrow<size_t>(input_shape[0]);
+    Parameters.InputWidth = narrow<size_t>(input_shape[1]);
+    Parameters.OutputHeight = narrow<size_t>(output_shape[0]);
+    Parameters.OutputWidth = narrow<size_t>(output_shape[1]);
+    Parameters.PaddingTop = narrow<size_t>(pads[0]);
+    Parameters.PaddingLeft = narrow<size_t>(pads[1]);
+    Parameters.Beta = Beta;
+    Parameters.Activation = &activation_;
+
+    const size_t WorkingBufferSize = MlasConvWinogradGetWorkingBufferSize(&Parameters, thread_pool);
+    auto working_buffer = IAllocator::MakeUniquePtr<float>(alloc, WorkingBufferSize);
+
+    MlasConvWinograd(&Parameters,
+                     Xdata.data(),
+                     winograd_packed_W_.get(),
+                     Bdata,
+                     working_buffer.get(),
+                     Ydata.data(),
+                     thread_pool);
+  } else if (kernel_rank >= 1 && kernel_rank <= 3) {
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
     MlasConvPrepare(&Parameters,
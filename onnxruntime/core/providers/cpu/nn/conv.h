@@ -30,10 +30,26 @@ class Conv<float> : public OpKernel {
 
   Status Compute(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // 3x3 filter transformed for the Winograd convolution, or nullptr if the
+  // convolution is computed by MlasConv.
+  BufferUniquePtr winograd_packed_W_;
+  size_t winograd_tile_size_{0};
+  // Shape of the filter when only the Winograd filter is kept.
+  TensorShape W_shape_;
 };
 
 }  // namespace onnxruntime
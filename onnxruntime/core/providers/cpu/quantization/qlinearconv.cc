@@ -642,6 +642,7 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     transpose_output_buffer = BufferUniquePtr(transpose_output, BufferDeleter(alloc));
   }
 
+  bool use_col_buffer = false;
   BufferUniquePtr col_buffer;
   BufferUniquePtr indirection_buffer;
   size_t ind_buf_length = 0;
@@ -656,11 +657,15 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     } else {
       // Pointwise convolutions can use the original input tensor in place,
       // otherwise a temporary buffer is required for the im2col transform.
-      int64_t group_col_buffer_size = (kernel_rank > 2) ? group_count * col_buffer_size : col_buffer_size;
-      group_col_buffer_size += MLAS_SYMM_QGEMM_BUF_OVERRUN;
-      auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(ActType)) * group_col_buffer_size);
-      col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
-      memset(col_data, 0, SafeInt<size_t>(sizeof(ActType)) * group_col_buffer_size);
+      // 1D and 2D convolutions only expand the output rows of each task, so
+      // their buffer is allocated per task in conv_worker.
+      use_col_buffer = true;
+      if (kernel_rank > 2) {
+        const int64_t group_col_buffer_size = group_count * col_buffer_size + MLAS_SYMM_QGEMM_BUF_OVERRUN;
+        auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(ActType)) * group_col_buffer_size);
+        col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+        memset(col_data, 0, SafeInt<size_t>(sizeof(ActType)) * group_col_buffer_size);
+      }
     }
   }
 
@@ -867,6 +872,14 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
 
       auto* worker_gemm_output = static_cast<int32_t*>(gemm_output_buffer.get()) + output_start * M;
 
+      IAllocatorUniquePtr<ActType> task_col_buffer;
+      if (use_col_buffer && kernel_rank <= 2) {
+        const size_t task_col_buffer_size = SafeInt<size_t>(output_count) * kernel_dim;
+        task_col_buffer = IAllocator::MakeUniquePtr<ActType>(alloc, task_col_buffer_size + MLAS_SYMM_QGEMM_BUF_OVERRUN,
+                                                             true);
+        memset(task_col_buffer.get() + task_col_buffer_size, 0, sizeof(ActType) * MLAS_SYMM_QGEMM_BUF_OVERRUN);
+      }
+
       if (is_depthwise_conv) {
         MlasConvDepthwise(
             reinterpret_cast<const void* const*>(worker_indirection_buffer),
@@ -886,8 +899,8 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
           const auto* group_input_data = input_data + group_id * group_input_channels;
           const uint8_t* AData;
           size_t lda;
-          if (col_buffer) {
-            auto* worker_col_buffer = static_cast<ActType*>(col_buffer.get()) + output_start * kernel_dim;
+          if (use_col_buffer) {
+            auto* worker_col_buffer = task_col_buffer.get();
             if (kernel_rank == 2) {
               math::Im2col<ActType, StorageOrder::NHWC>()(
                   group_input_data,
@@ -930,7 +943,8 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
                   X_zero_point_value);
             } else {
               // Use the im2col buffer prepared outside the thread, indexed by group.
-              worker_col_buffer += group_id * col_buffer_size;
+              worker_col_buffer = static_cast<ActType*>(col_buffer.get()) + group_id * col_buffer_size +
+                                  output_start * kernel_dim;
             }
             AData = reinterpret_cast<const uint8_t*>(worker_col_buffer);
             lda = static_cast<size_t>(kernel_dim);
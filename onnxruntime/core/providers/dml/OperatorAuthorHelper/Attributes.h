@@ -109,6 +109,7 @@ namespace AttrName
     static constexpr const char* Unidirectional = "unidirectional";
     static constexpr const char* NumHeads = "num_heads";
     static constexpr const char* KvNumHeads = "kv_num_heads";
+    static constexpr const char* KvCacheBitWidth = "kv_cache_bit_width";
     static constexpr const char* PastPresentShareBuffer = "past_present_share_buffer";
 
     static constexpr const char* FusedActivation = "fused_activation";
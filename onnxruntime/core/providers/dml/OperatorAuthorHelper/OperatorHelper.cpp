@@ -2806,6 +2806,8 @@ namespace OperatorHelper
     void GroupQueryAttentionHelper::Initialize(const IKernelInformationAdapter& kernelInformation)
     {
         m_kvNumHeads = gsl::narrow_cast<uint32_t>(kernelInformation.GetAttributes().GetAttribute<int64_t>(AttrName::KvNumHeads));
+        ML_CHECK_VALID_ARGUMENT(kernelInformation.GetAttributes().GetOptionalAttribute<int64_t>(AttrName::KvCacheBitWidth, 0) == 0,
+                                "A quantized KV cache (kv_cache_bit_width != 0) is not supported.");
 
         std::vector<int32_t> totalSequenceLength;
         ReadCpuLocalTensorIntoInt32(kernelInformation.GetConstantInputTensor(6), /*out*/ totalSequenceLength);
@@ -87,16 +87,25 @@ common::Status IOBinding::BindOutput(const std::string& name, OrtDevice device)
   return BindOutputImpl(name, {}, device);
 }
 
-common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device) {
+common::Status IOBinding::BindOutput(const std::string& name, AllocatorPtr allocator) {
+  ORT_RETURN_IF(allocator == nullptr, "Allocator for output '", name, "' is null");
+  const OrtDevice device = allocator->Info().device;
+  return BindOutputImpl(name, {}, device, std::move(allocator));
+}
+
+common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device,
+                                         AllocatorPtr allocator) {
   auto it = mapped_output_names_.emplace(name, output_names_.size());
   size_t index = it.first->second;
   if (it.second) {
     output_names_.push_back(name);
     outputs_.push_back(ml_value);
     outputs_device_info_.push_back(device);
+    outputs_allocators_.push_back(std::move(allocator));
   } else {
     outputs_[index] = ml_value;
     outputs_device_info_[index] = device;
+    outputs_allocators_[index] = std::move(allocator);
   }
   ORT_ENFORCE(mapped_output_names_.size() == output_names_.size(), "Size mismatch", mapped_output_names_.size(), "!=", output_names_.size());
 
@@ -108,6 +117,7 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  outputs_allocators_.clear();
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
@@ -120,6 +130,10 @@ const std::vector<OrtDevice>& IOBinding::GetOutputsDeviceInfo() const {
   return outputs_device_info_;
 }
 
+const std::vector<AllocatorPtr>& IOBinding::GetOutputsAllocators() const {
+  return outputs_allocators_;
+}
+
 const std::vector<std::string>& IOBinding::GetInputNames() const { return feed_names_; }
 
 const std::vector<OrtValue>& IOBinding::GetInputs() const { return feeds_; }
@@ -71,6 +71,19 @@ class IOBinding {
    */
   common::Status BindOutput(const std::string& name, OrtDevice device = {});
 
+  /**
+   * Bind an output name to an allocator, typically a caller owned pool of output buffers.
+   * The output is allocated from the allocator on its device while the model runs, so the producing kernel writes it
+   * in place when it runs on that device. Otherwise the output is copied into a buffer from the allocator.
+   * The buffer is freed with the allocator once the output OrtValue is released, which returns it to the pool.
+   * Outputs that are not newly allocated tensors, e.g. a model input or initializer that is also a model output,
+   * are returned as if bound with BindOutput(name, device).
+   *
+   * @param allocator Allocator to allocate the output with. It must stay valid while the output is alive, and must
+   *                  be thread safe if runs are concurrent.
+   */
+  common::Status BindOutput(const std::string& name, AllocatorPtr allocator);
+
   /**
    * This simply collects the outputs obtained after calling Run() inside the @param outputs.
    */
@@ -106,13 +119,18 @@ class IOBinding {
   std::unordered_map<std::string, size_t> mapped_output_names_;
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
+  std::vector<AllocatorPtr> outputs_allocators_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
   const std::vector<OrtDevice>& GetOutputsDeviceInfo() const;
 
+  // allocator for all outputs. null for an output that is not bound to an allocator.
+  const std::vector<AllocatorPtr>& GetOutputsAllocators() const;
+
   // The implementation for the BindOutput() overloads
-  common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
+  common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device,
+                                AllocatorPtr allocator = nullptr);
 };
 }  // namespace onnxruntime
@@ -3,11 +3,13 @@
 
 #include "core/session/environment.h"
 
+#include <algorithm>
 #include <array>
 
 #include "core/common/basic_types.h"
 #include "core/framework/allocator.h"
 #include "core/framework/allocator_utils.h"
+#include "core/framework/cpu_page_allocator.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/plugin_data_transfer.h"
 #include "core/graph/constants.h"
@@ -224,15 +226,35 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
       max_power_of_two_extend_bytes = arena_cfg->max_power_of_two_extend_bytes;
     }
 
+    // the arena regions can be backed by huge pages and placed on a NUMA node
+    CPUPageAllocatorOptions page_allocator_options;
+    if (arena_cfg) {
+      ORT_RETURN_IF_ERROR(CPUPageAllocatorOptions::Create(std::max(arena_cfg->huge_pages, 0), arena_cfg->numa_node,
+                                                          page_allocator_options));
+    }
+
     OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
                             initial_growth_chunk_size_bytes, max_power_of_two_extend_bytes};
+
+    AllocatorFactory device_alloc_factory = [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); };
+    if (page_allocator_options.IsEnabled()) {
+      device_alloc_factory = [mem_info, page_allocator_options](int) {
+        return std::make_unique<CPUPageAllocator>(mem_info, page_allocator_options);
+      };
+      page_allocator_options.AdjustArenaConfig(l_arena_cfg);
+    }
+
     AllocatorCreationInfo alloc_creation_info{
-        [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
+        device_alloc_factory,
         0,
         create_arena,
         l_arena_cfg};
     allocator_ptr = CreateAllocator(alloc_creation_info);
   } else {
+    if (arena_cfg && (arena_cfg->huge_pages > 0 || arena_cfg->numa_node >= 0)) {
+      LOGS_DEFAULT(WARNING) << "The huge page and NUMA node arena options are ignored as no arena is created.";
+    }
+
     AllocatorCreationInfo alloc_creation_info{[mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
                                               0, create_arena};
     allocator_ptr = CreateAllocator(alloc_creation_info);
@@ -34,6 +34,7 @@
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/sequential_executor.h"
 #include "core/framework/transform_layout_functions.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
@@ -385,6 +386,9 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   ORT_THROW_IF_ERROR(graph_transformer_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps));
   graph_transformer_mgr_.SetLoadCancellationFn(this->check_load_cancellation_fn_);
+  graph_transformer_mgr_.SetIncremental(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsGraphOptimizationsIncremental, "1") == "1");
+  graph_transformer_mgr_.SetProfiler(&session_profiler_);
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -452,6 +456,16 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         if (session_options_.config_options.TryGetConfigEntry(kOrtSessionOptionsConfigIntraOpThreadAffinities, to.affinity_str)) {
           ORT_ENFORCE(!to.affinity_str.empty(), "Affinity string must not be empty");
         }
+
+        // A session can't use more threads than the thread budget of the environment, so the default sized pool does
+        // not create more. Its threads are not pinned either as other sessions share the same cores.
+        const int env_thread_budget = session_env.GetResourceManager().GetThreadBudget();
+        if (to.thread_pool_size == 0 && env_thread_budget > 0) {
+          to.thread_pool_size = std::min(env_thread_budget, Env::Default().GetNumPhysicalCpuCores());
+          LOGS(*session_logger_, INFO) << "Intra-op thread pool size limited to " << to.thread_pool_size
+                                       << " by the thread budget of the environment.";
+        }
+
         to.auto_set_affinity = to.thread_pool_size == 0 &&
                                session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                                to.affinity_str.empty();
@@ -730,6 +744,10 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // Wait for the pipelined RunAsync requests in flight. Their completion uses the members declared after the
+  // pipeline executor, e.g. env_resources_.
+  pipeline_executor_.reset();
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -1008,6 +1026,14 @@ common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std
   return status;
 }
 
+onnxruntime::concurrency::ThreadPool* InferenceSession::GetModelLoadThreadPool() const {
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelModelLoad, "1") != "1") {
+    return nullptr;
+  }
+
+  return GetIntraOpThreadPoolToUse();
+}
+
 common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
   model_location_ = model_uri;
   auto loader = [this](std::shared_ptr<onnxruntime::Model>& model) {
@@ -1021,10 +1047,10 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
 
     const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
                                                  kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+    ModelOptions model_opts(true, strict_shape_type_inference, check_load_cancellation_fn_);
+    model_opts.thread_pool = GetModelLoadThreadPool();
     return onnxruntime::Model::Load(model_location_, model, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
-                                    *session_logger_,
-                                    ModelOptions(true, strict_shape_type_inference,
-                                                 check_load_cancellation_fn_));
+                                    *session_logger_, model_opts);
   };
 
   common::Status st = LoadWithLoader(loader, "model_loading_uri");
@@ -1115,10 +1141,11 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
       model_location_ = ToPathString(external_data_folder_path + "/virtual_model.onnx");
     }
 
+    ModelOptions model_opts(true, strict_shape_type_inference, check_load_cancellation_fn_);
+    model_opts.thread_pool = GetModelLoadThreadPool();
     return onnxruntime::Model::Load(std::move(model_proto), model_location_, model,
                                     HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
-                                    ModelOptions(true, strict_shape_type_inference,
-                                                 check_load_cancellation_fn_));
+                                    model_opts);
   };
 
   return LoadWithLoader(loader, "model_loading_array");
@@ -1154,10 +1181,11 @@ common::Status InferenceSession::LoadOnnxModel(ModelProto model_proto) {
     }
 
     // This call will move model_proto to the constructed model instance
+    ModelOptions model_opts(true, strict_shape_type_inference, check_load_cancellation_fn_);
+    model_opts.thread_pool = GetModelLoadThreadPool();
     return onnxruntime::Model::Load(std::move(model_proto), model_location_, model,
                                     HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
-                                    ModelOptions(true, strict_shape_type_inference,
-                                                 check_load_cancellation_fn_));
+                                    model_opts);
   };
 
   return LoadWithLoader(loader, "model_loading_proto");
@@ -1192,6 +1220,7 @@ common::Status InferenceSession::Load(std::istream& model_istream, bool allow_re
     ModelOptions model_opts(allow_released_opsets_only,
                             strict_shape_type_inference,
                             check_load_cancellation_fn_);
+    model_opts.thread_pool = GetModelLoadThreadPool();
 
     std::string external_data_folder_path = session_options_.config_options.GetConfigOrDefault(
         kOrtSessionOptionsModelExternalInitializersFileFolderPath, "");
@@ -1228,10 +1257,10 @@ common::Status InferenceSession::Load() {
                                                 kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly, "1") == "1";
 
     // Pass on ownership of the parsed ModelProto to the Model instance (its job here is done by this stage)
+    ModelOptions model_opts(allow_released_opsets_only, strict_shape_type_inference, check_load_cancellation_fn_);
+    model_opts.thread_pool = GetModelLoadThreadPool();
     return Model::Load(std::move(this->model_proto_), model_location_, model,
-                       HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
-                       ModelOptions(allow_released_opsets_only, strict_shape_type_inference,
-                                    check_load_cancellation_fn_));
+                       HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_, model_opts);
   };
 
   return LoadWithLoader(loader, "model_loading_from_saved_proto");
@@ -1996,6 +2025,251 @@ common::Status InferenceSession::HasInvalidCombinationOfExecutionProviders() con
   return Status::OK();
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+common::Status InferenceSession::CreateShapeBucketSessions() {
+  const std::string config =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShapeBuckets, "");
+  if (config.empty()) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(ShapeBuckets::Parse(config, shape_buckets_));
+  if (shape_buckets_.Empty()) {
+    return Status::OK();
+  }
+
+  // The specialized sessions create their own CPU execution provider. Other execution providers can't be shared
+  // between sessions, as compiling providers keep the state of the compiled partitions in the provider instance.
+  for (const auto& ep : execution_providers_) {
+    if (ep->Type() != kCpuExecutionProvider) {
+      LOGS(*session_logger_, WARNING) << kOrtSessionOptionsShapeBuckets << " is only supported with the CPU "
+                                      << "execution provider, but " << ep->Type()
+                                      << " is registered. Shape buckets are ignored.";
+      shape_buckets_ = ShapeBuckets{};
+      return Status::OK();
+    }
+  }
+
+  const Graph& graph = model_->MainGraph();
+
+  auto get_bucketed_axes = [this](const NodeArg& node_arg, InlinedVector<int>& axes) {
+    const auto* shape = node_arg.Shape();
+    if (shape == nullptr) {
+      return false;
+    }
+
+    bool bucketed = false;
+    axes.clear();
+    for (const auto& dim : shape->dim()) {
+      const int bucket_dim = utils::HasDimParam(dim) ? shape_buckets_.DimIndex(dim.dim_param()) : -1;
+      bucketed = bucketed || bucket_dim >= 0;
+      axes.push_back(bucket_dim);
+    }
+    return bucketed;
+  };
+
+  InlinedVector<int> axes;
+  for (const NodeArg* input : graph.GetInputs()) {
+    if (get_bucketed_axes(*input, axes)) {
+      shape_bucket_input_axes_.emplace(input->Name(), axes);
+    }
+  }
+
+  if (shape_bucket_input_axes_.empty()) {
+    LOGS(*session_logger_, WARNING) << "None of the graph inputs has a dimension declared in "
+                                    << kOrtSessionOptionsShapeBuckets << ". Shape buckets are ignored.";
+    shape_buckets_ = ShapeBuckets{};
+    return Status::OK();
+  }
+
+  for (const NodeArg* output : graph.GetOutputs()) {
+    if (get_bucketed_axes(*output, axes)) {
+      shape_bucket_output_axes_.emplace(output->Name(), axes);
+    }
+  }
+
+  // Share the initializers between this session and the specialized sessions.
+  const auto& initializers = graph.GetAllInitializedTensors();
+  shape_bucket_initializers_.reserve(initializers.size());
+  for (const auto& [name, tensor_proto] : initializers) {
+    if (session_options_.initializers_to_share_map.count(name) != 0) {
+      continue;
+    }
+
+    OrtValue value;
+    if (!graph.GetOrtValueInitializer(name, value)) {
+      ORT_RETURN_IF_ERROR(utils::TensorProtoToOrtValue(Env::Default(), graph.ModelPath(), *tensor_proto,
+                                                       CPUAllocator::DefaultInstance(), value));
+    }
+
+    shape_bucket_initializers_.push_back(std::move(value));
+    session_options_.initializers_to_share_map.emplace(name, &shape_bucket_initializers_.back());
+  }
+
+  if (prepacked_weights_container_ == nullptr) {
+    shape_bucket_prepacked_weights_container_ = std::make_unique<PrepackedWeightsContainer>();
+    prepacked_weights_container_ = shape_bucket_prepacked_weights_container_.get();
+  }
+
+  // The large initializers of the loaded model are referenced rather than copied into the model of each specialized
+  // session. shape_bucket_initializers_ keeps their data alive after this session's graph is transformed.
+  const ONNX_NAMESPACE::ModelProto model_proto = model_->ToProtoWithInMemoryReferences();
+  const size_t num_buckets = shape_buckets_.NumBuckets();
+  shape_bucket_sessions_.reserve(num_buckets);
+
+  for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+    const auto sizes = shape_buckets_.BucketSizes(bucket);
+
+    SessionOptions bucket_options = session_options_;
+    bucket_options.config_options.configurations.erase(kOrtSessionOptionsShapeBuckets);
+    bucket_options.optimized_model_filepath.clear();
+    bucket_options.enable_profiling = false;
+    bucket_options.session_logid = session_options_.session_logid + "_bucket" + std::to_string(bucket);
+    for (size_t dim = 0; dim < sizes.size(); ++dim) {
+      bucket_options.free_dimension_overrides.push_back(
+          {shape_buckets_.DimName(dim), FreeDimensionOverrideType::Name, sizes[dim]});
+    }
+
+    auto session = std::make_unique<InferenceSession>(bucket_options, environment_, GetIntraOpThreadPoolToUse(),
+                                                      GetInterOpThreadPoolToUse());
+    session->model_location_ = model_location_;
+    ORT_RETURN_IF_ERROR(session->AddPrePackedWeightsContainer(prepacked_weights_container_));
+    for (const auto& custom_registry : custom_registries_) {
+      ORT_RETURN_IF_ERROR(session->RegisterCustomRegistry(custom_registry));
+    }
+
+    ORT_RETURN_IF_ERROR(session->LoadOnnxModel(model_proto));
+    ORT_RETURN_IF_ERROR(session->Initialize());
+    shape_bucket_sessions_.push_back(std::move(session));
+  }
+
+  LOGS(*session_logger_, INFO) << "Created " << num_buckets << " sessions for the shape buckets " << config;
+  return Status::OK();
+}
+
+common::Status InferenceSession::RunWithShapeBucket(const RunOptions& run_options,
+                                                    gsl::span<const std::string> feed_names,
+                                                    gsl::span<const OrtValue> feeds,
+                                                    gsl::span<const std::string> output_names,
+                                                    std::vector<OrtValue>* p_fetches,
+                                                    const std::vector<OrtDevice>* p_fetches_device_info,
+                                                    bool& dispatched) {
+  dispatched = false;
+
+  // pre-allocated outputs and outputs on other devices can't be cropped
+  if (p_fetches == nullptr || p_fetches_device_info != nullptr ||
+      std::any_of(p_fetches->begin(), p_fetches->end(), [](const OrtValue& fetch) { return fetch.IsAllocated(); })) {
+    return Status::OK();
+  }
+
+  auto is_cpu_tensor = [](const OrtValue& value) {
+    return value.IsTensor() && value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU &&
+           !value.Get<Tensor>().IsDataTypeString();
+  };
+
+  // bind the bucketed dimensions to the sizes of the feeds
+  InlinedVector<int64_t> dim_values(shape_buckets_.NumDims(), -1);
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    auto it = shape_bucket_input_axes_.find(feed_names[i]);
+    if (it == shape_bucket_input_axes_.end()) {
+      continue;
+    }
+
+    const auto& axes = it->second;
+    if (!is_cpu_tensor(feeds[i]) || feeds[i].Get<Tensor>().Shape().NumDimensions() != axes.size()) {
+      return Status::OK();
+    }
+
+    const auto& shape = feeds[i].Get<Tensor>().Shape();
+    for (size_t axis = 0; axis < axes.size(); ++axis) {
+      if (axes[axis] < 0) {
+        continue;
+      }
+
+      int64_t& value = dim_values[axes[axis]];
+      if (value >= 0 && value != shape[axis]) {
+        return Status::OK();
+      }
+      value = shape[axis];
+    }
+  }
+
+  size_t bucket = 0;
+  if (!shape_buckets_.FindBucket(dim_values, bucket)) {
+    return Status::OK();
+  }
+
+  const auto sizes = shape_buckets_.BucketSizes(bucket);
+  AllocatorPtr allocator = CPUAllocator::DefaultInstance();
+
+  // zero pad the feeds to the sizes of the bucket
+  std::vector<OrtValue> bucket_feeds(feeds.begin(), feeds.end());
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    auto it = shape_bucket_input_axes_.find(feed_names[i]);
+    if (it == shape_bucket_input_axes_.end()) {
+      continue;
+    }
+
+    const auto& axes = it->second;
+    const Tensor& feed = feeds[i].Get<Tensor>();
+    TensorShapeVector padded_dims = feed.Shape().AsShapeVector();
+    for (size_t axis = 0; axis < axes.size(); ++axis) {
+      if (axes[axis] >= 0) {
+        padded_dims[axis] = sizes[axes[axis]];
+      }
+    }
+
+    if (TensorShape(padded_dims) == feed.Shape()) {
+      continue;
+    }
+
+    OrtValue padded;
+    Tensor::InitOrtValue(feed.DataType(), TensorShape(padded_dims), allocator, padded);
+    Tensor& padded_tensor = *padded.GetMutable<Tensor>();
+    memset(padded_tensor.MutableDataRaw(), 0, padded_tensor.SizeInBytes());
+    ORT_RETURN_IF_ERROR(CopyTensorRegion(feed, padded_tensor));
+    bucket_feeds[i] = std::move(padded);
+  }
+
+  ORT_RETURN_IF_ERROR(shape_bucket_sessions_[bucket]->Run(run_options, feed_names, bucket_feeds, output_names,
+                                                          p_fetches, nullptr));
+  dispatched = true;
+
+  // crop the outputs to the sizes of the feeds
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    auto it = shape_bucket_output_axes_.find(output_names[i]);
+    OrtValue& fetch = (*p_fetches)[i];
+    if (it == shape_bucket_output_axes_.end() || !is_cpu_tensor(fetch)) {
+      continue;
+    }
+
+    const auto& axes = it->second;
+    const Tensor& output = fetch.Get<Tensor>();
+    if (output.Shape().NumDimensions() != axes.size()) {
+      continue;
+    }
+
+    TensorShapeVector cropped_dims = output.Shape().AsShapeVector();
+    for (size_t axis = 0; axis < axes.size(); ++axis) {
+      if (axes[axis] >= 0 && dim_values[axes[axis]] >= 0) {
+        cropped_dims[axis] = std::min(cropped_dims[axis], dim_values[axes[axis]]);
+      }
+    }
+
+    if (TensorShape(cropped_dims) == output.Shape()) {
+      continue;
+    }
+
+    OrtValue cropped;
+    Tensor::InitOrtValue(output.DataType(), TensorShape(cropped_dims), allocator, cropped);
+    ORT_RETURN_IF_ERROR(CopyTensorRegion(output, *cropped.GetMutable<Tensor>()));
+    fetch = std::move(cropped);
+  }
+
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // VC++ reports: "Releasing unheld lock 'l' in function 'onnxruntime::InferenceSession::Initialize'". But I don't see anything wrong.
@@ -2054,6 +2328,8 @@ common::Status InferenceSession::Initialize() {
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      ORT_RETURN_IF_ERROR_SESSIONID_(CPUPageAllocatorOptions::FromConfigOptions(session_options_.config_options,
+                                                                                epi.page_allocator_options));
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
       execution_providers_.SetCpuProviderWasImplicitlyAdded(true);
@@ -2081,6 +2357,11 @@ common::Status InferenceSession::Initialize() {
     }
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // create the sessions for the shape buckets from the graph before it is transformed for this session
+    ORT_RETURN_IF_ERROR_SESSIONID_(CreateShapeBucketSessions());
+#endif
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     TraceLoggingWriteStart(session_activity, "OrtInferenceSessionActivity");
     session_activity_started_ = true;
@@ -2151,8 +2432,45 @@ common::Status InferenceSession::Initialize() {
     }
 
     session_state_->SetNodeStatsRecorder(GetNodeStatsRecorder());
+
+    // Sessions that use the global thread pools share them with other sessions, so their measurements would depend
+    // on what those sessions run and they are not tuned.
+    const int intra_op_max_threads = concurrency::ThreadPool::MaxThreadsIncludingCaller(
+        use_per_session_threads_ ? GetIntraOpThreadPoolToUse() : nullptr);
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsIntraOpThreadTuning, "0") == "1" &&
+        intra_op_max_threads > 1) {
+      auto& tuner = intra_op_thread_tuner_.emplace(intra_op_max_threads);
+      intra_op_thread_tuning_file_ = session_options_.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsIntraOpThreadTuningFile, "");
+      if (!intra_op_thread_tuning_file_.empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(tuner.Load(intra_op_thread_tuning_file_, *session_logger_));
+      }
+    }
+
+    session_state_->SetIntraOpThreadTuner(GetIntraOpThreadTuner());
 #endif
 
+    // Register with the resource manager of the environment, which shares its thread budget and arena memory cap
+    // between the sessions and reports the usage of each session.
+    ResourcePriority resource_priority = ResourcePriority::kNormal;
+    ORT_RETURN_IF_ERROR_SESSIONID_(ParseResourcePriority(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsResourcePriority, "normal"),
+        resource_priority));
+
+    InlinedVector<AllocatorPtr> arenas;
+    for (const auto& [device, allocator] : session_state_->GetAllocators()) {
+      if (allocator->Info().alloc_type == OrtAllocatorType::OrtArenaAllocator &&
+          std::find(arenas.begin(), arenas.end(), allocator) == arenas.end()) {
+        arenas.push_back(allocator);
+      }
+    }
+
+    env_resources_ = environment_.GetResourceManager().RegisterSession(
+        session_options_.session_logid.empty() ? std::to_string(session_id_) : session_options_.session_logid,
+        resource_priority, concurrency::ThreadPool::MaxThreadsIncludingCaller(GetIntraOpThreadPoolToUse()),
+        std::move(arenas));
+    session_state_->SetEnvResources(env_resources_.get());
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
@@ -2195,6 +2513,14 @@ common::Status InferenceSession::Initialize() {
         return Status::OK();
       };
 
+      // the ZipMapColumnarTransformer is a Level2 transformer, so the output stays a sequence of maps below that
+      if (session_options_.graph_optimization_level < TransformerLevel::Level2 &&
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsZipMapColumnarOutput, "0") == "1") {
+        LOGS(*session_logger_, WARNING)
+            << kOrtSessionOptionsZipMapColumnarOutput << " is ignored as it requires the graph optimization level to "
+            << "be ORT_ENABLE_EXTENDED or higher. The ZipMap outputs remain sequences of maps.";
+      }
+
       // add predefined transformers
       ORT_RETURN_IF_ERROR_SESSIONID_(AddPredefinedTransformers(graph_transformer_mgr_,
                                                                session_options_.graph_optimization_level,
@@ -2485,6 +2811,50 @@ common::Status InferenceSession::Initialize() {
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    const std::string pipeline_stages_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsRunAsyncPipelineStages, "0");
+    size_t pipeline_stages = 0;
+    if (!TryParseStringWithClassicLocale(pipeline_stages_str, pipeline_stages)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                             kOrtSessionOptionsRunAsyncPipelineStages, ": ", pipeline_stages_str);
+    }
+
+#if !defined(ORT_MINIMAL_BUILD)
+    // Shape-bucket dispatch happens in Run(), which the pipeline bypasses.
+    if (pipeline_stages > 1 && !shape_bucket_sessions_.empty()) {
+      LOGS(*session_logger_, WARNING) << "RunAsync can't execute the model as a pipeline as "
+                                      << kOrtSessionOptionsShapeBuckets << " is set.";
+      pipeline_stages = 0;
+    }
+#endif
+
+    // The pipeline doesn't record the runs and the nodes of the requests in the session profile.
+    if (pipeline_stages > 1 && session_options_.enable_profiling) {
+      LOGS(*session_logger_, WARNING) << "RunAsync can't execute the model as a pipeline as profiling is enabled.";
+      pipeline_stages = 0;
+    }
+
+    if (pipeline_stages > 1) {
+      const std::string max_in_flight_str = session_options_.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsRunAsyncMaxInFlight, std::to_string(2 * pipeline_stages));
+      size_t max_in_flight = 0;
+      if (!TryParseStringWithClassicLocale(max_in_flight_str, max_in_flight) || max_in_flight == 0) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                               kOrtSessionOptionsRunAsyncMaxInFlight, ": ", max_in_flight_str);
+      }
+
+      if (PipelineExecutor::IsSupported(*session_state_)) {
+        pipeline_executor_ = std::make_unique<PipelineExecutor>(*session_state_, GetIntraOpThreadPoolToUse(),
+                                                                pipeline_stages, max_in_flight);
+        LOGS(*session_logger_, INFO) << "RunAsync executes the model as a pipeline of "
+                                     << pipeline_executor_->NumStages() << " stages with up to " << max_in_flight
+                                     << " requests in flight.";
+      } else {
+        LOGS(*session_logger_, WARNING) << "RunAsync can't execute the model as a pipeline as its execution plan "
+                                        << "is not a single sequence of nodes on CPU.";
+      }
+    }
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
@@ -2879,6 +3249,49 @@ struct ThreadPoolSpinningSwitch {
     }
   }
 };
+
+// Create the fetch allocators for the outputs that are bound to an allocator, so the execution frame allocates those
+// output tensors from it rather than from the session allocators.
+Status CreateFetchAllocators(const SessionState& session_state, gsl::span<const std::string> output_names,
+                             const std::vector<AllocatorPtr>& allocators, std::vector<OrtValue>& fetches,
+                             std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& alloc_plan = session_state.GetPerValueAllocPlan();
+
+  for (size_t i = 0, end = std::min(output_names.size(), allocators.size()); i < end; ++i) {
+    if (!allocators[i] || (i < fetches.size() && fetches[i].IsAllocated())) {
+      continue;
+    }
+
+    int ort_value_idx = -1;
+    ORT_RETURN_IF_ERROR(name_idx_map.GetIdx(output_names[i], ort_value_idx));
+    const auto* type = alloc_plan[ort_value_idx].value_type;
+    if (type == nullptr || !type->IsTensorType()) {
+      continue;
+    }
+
+    const auto* element_type = static_cast<const TensorTypeBase*>(type)->GetElementType();
+    fetch_allocators[i] = [i, element_type, allocator = allocators[i], &fetches](
+                              const TensorShape& shape, const OrtDevice& location,
+                              OrtValue& ort_value, bool& allocated) {
+      OrtValue value;
+      Tensor::InitOrtValue(element_type, shape, allocator, value);
+
+      if (allocator->Info().device == location) {
+        ort_value = std::move(value);
+        allocated = true;
+      } else {
+        // the output is produced on another device. put the value in fetches so that the copy logic in
+        // utils::ExecuteGraphImpl copies the output into it.
+        fetches[i] = std::move(value);
+      }
+
+      return Status::OK();
+    };
+  }
+
+  return Status::OK();
+}
 }  // namespace
 
 Status InferenceSession::SetEpDynamicOptions(gsl::span<const char* const> keys,
@@ -2902,7 +3315,19 @@ Status InferenceSession::SetEpDynamicOptions(gsl::span<const char* const> keys,
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
-                             const std::vector<OrtDevice>* p_fetches_device_info) {
+                             const std::vector<OrtDevice>* p_fetches_device_info,
+                             const std::vector<AllocatorPtr>* p_fetches_allocators) {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (!shape_bucket_sessions_.empty()) {
+    bool dispatched = false;
+    ORT_RETURN_IF_ERROR(RunWithShapeBucket(run_options, feed_names, feeds, output_names, p_fetches,
+                                           p_fetches_device_info, dispatched));
+    if (dispatched) {
+      return Status::OK();
+    }
+  }
+#endif
+
   TimePoint tp = std::chrono::high_resolution_clock::now();
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2948,6 +3373,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
     InlinedVector<AllocatorPtr> arenas_to_shrink;
 
+    // count the run for the share of the thread budget of the environment that the nodes of each run get
+    std::optional<EnvResourceManager::RunScope> env_resources_run_scope;
+    if (env_resources_ != nullptr) {
+      env_resources_run_scope.emplace(*env_resources_);
+    }
+
     ORT_TRY {
       if (!is_inited_) {
         LOGS(*session_logger_, ERROR) << "Session was not initialized";
@@ -2981,6 +3412,14 @@ Status InferenceSession::Run(const RunOptions& run_options,
         }
       }
 
+      std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+      if (p_fetches_allocators) {
+        // resize now so the fetch allocators can place values in fetches during execution
+        p_fetches->resize(output_names.size());
+        ORT_RETURN_IF_ERROR_SESSIONID_(CreateFetchAllocators(*session_state_, output_names, *p_fetches_allocators,
+                                                             *p_fetches, fetch_allocators));
+      }
+
       if (!run_options.run_tag.empty()) {
         LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
       }
@@ -3035,7 +3474,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef ORT_ENABLE_STREAM
                                      device_stream_collection_holder,
 #endif
-                                     run_logger);
+                                     run_logger,
+                                     fetch_allocators);
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -3068,6 +3508,12 @@ Status InferenceSession::Run(const RunOptions& run_options,
     if (!arenas_to_shrink.empty()) {
       ShrinkMemoryArenas(arenas_to_shrink);
     }
+
+    // release unused arena memory across the sessions of the environment if they exceed its memory cap
+    if (env_resources_run_scope.has_value()) {
+      env_resources_run_scope.reset();
+      env_resources_->ReclaimArenaMemory(*session_logger_);
+    }
   }
 
   // keep track of telemetry
@@ -3124,6 +3570,14 @@ Status InferenceSession::Run(const RunOptions& run_options,
     node_stats_recorder_->DumpStats(session_state_->GetGraphViewer().ModelPath());
     node_stats_recorder_->ResetPerRunNameDeduper();
   }
+
+  if (intra_op_thread_tuner_.has_value() && !intra_op_thread_tuning_file_.empty() && retval.IsOK()) {
+    auto save_status = intra_op_thread_tuner_->SaveIfUpdated(intra_op_thread_tuning_file_);
+    if (!save_status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save the intra-op thread tuning results: "
+                                      << save_status.ErrorMessage();
+    }
+  }
 #endif
 
   reset_saturation_count();
@@ -3138,7 +3592,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
       cached_execution_provider_for_graph_replay_.AllowGraphCaptureOnRun(graph_annotation_id) &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                            p_fetches_allocators));
   }
 
   // Log runtime error telemetry if the return value is not OK
@@ -3217,6 +3672,115 @@ Status InferenceSession::Run(const RunOptions& run_options,
   return Status::OK();
 }
 
+common::Status InferenceSession::RunAsyncPipelined(const RunOptions* run_options,
+                                                   gsl::span<const char* const> feed_names,
+                                                   gsl::span<const OrtValue* const> feeds,
+                                                   gsl::span<const char* const> fetch_names,
+                                                   gsl::span<OrtValue*> fetches,
+                                                   RunAsyncCallbackFn callback,
+                                                   void* user_data,
+                                                   bool& submitted) {
+  submitted = false;
+
+  // profiling may have been started after the session was initialized
+  if (session_profiler_.IsEnabled()) {
+    LOGS(*session_logger_, VERBOSE) << "RunAsync request is not pipelined as profiling is enabled.";
+    return Status::OK();
+  }
+
+  InlinedVector<std::string> feed_name_vec;
+  std::vector<OrtValue> feed_vec;
+  feed_name_vec.reserve(feed_names.size());
+  feed_vec.reserve(feed_names.size());
+  for (size_t i = 0; i != feed_names.size(); ++i) {
+    if (feed_names[i] == nullptr || feed_names[i][0] == '\0') {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    if (!feeds[i]) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "OrtValue with name: ", feed_names[i], " is not allocated");
+    }
+    feed_name_vec.emplace_back(feed_names[i]);
+    feed_vec.push_back(*feeds[i]);
+  }
+
+  InlinedVector<std::string> fetch_name_vec;
+  std::vector<OrtValue> fetch_vec;
+  fetch_name_vec.reserve(fetch_names.size());
+  fetch_vec.reserve(fetch_names.size());
+  for (size_t i = 0; i != fetch_names.size(); ++i) {
+    if (fetch_names[i] == nullptr || fetch_names[i][0] == '\0') {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    fetch_name_vec.emplace_back(fetch_names[i]);
+    fetch_vec.push_back(fetches[i] != nullptr ? *fetches[i] : OrtValue());
+  }
+
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_name_vec, feed_vec));
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(fetch_name_vec, &fetch_vec));
+
+  FeedsFetchesInfo info(feed_name_vec, fetch_name_vec, session_state_->GetOrtValueNameIdxMap());
+  FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+  ORT_RETURN_IF_ERROR_SESSIONID_(utils::InitializeFeedFetchCopyInfo(*session_state_, feeds_fetches_manager));
+
+  // the pipeline doesn't copy the feeds and fetches between devices
+  if (feeds_fetches_manager.GetDeviceCopyChecks().status != DeviceCopyCheck::NoCopy) {
+    return Status::OK();
+  }
+
+  static const bool no_terminate = false;
+  const bool& terminate_flag = run_options != nullptr ? run_options->terminate : no_terminate;
+  const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
+
+  // count the request as a run, like Run() does, until it completes
+  current_num_runs_.fetch_add(1, std::memory_order_relaxed);
+  std::shared_ptr<EnvResourceManager::RunScope> env_resources_run_scope;
+  if (env_resources_ != nullptr) {
+    env_resources_run_scope = std::make_shared<EnvResourceManager::RunScope>(*env_resources_);
+  }
+
+  pipeline_executor_->Submit(
+      feeds_fetches_info.feeds_mlvalue_idxs, std::move(feed_vec),
+      feeds_fetches_info.fetches_mlvalue_idxs, std::move(fetch_vec),
+      *session_logger_, terminate_flag,
+      [this, env_resources_run_scope, fetches, callback, user_data](const Status& status,
+                                                                   std::vector<OrtValue>& results) mutable {
+        if (env_resources_run_scope != nullptr) {
+          env_resources_run_scope.reset();
+          env_resources_->ReclaimArenaMemory(*session_logger_);
+        }
+        current_num_runs_.fetch_sub(1, std::memory_order_acq_rel);
+
+        Status result_status = status;
+        if (result_status.IsOK()) {
+          ORT_TRY {
+            // We do it in two loops to make sure copy __ctors does not throw
+            InlinedVector<std::unique_ptr<OrtValue>> fetch_unique_ptrs(fetches.size());
+            for (size_t i = 0; i != fetches.size(); ++i) {
+              if (fetches[i] == nullptr) {
+                fetch_unique_ptrs[i] = std::make_unique<OrtValue>(results[i]);
+              }
+            }
+
+            for (size_t i = 0; i != fetches.size(); ++i) {
+              if (fetches[i] == nullptr) {
+                fetches[i] = fetch_unique_ptrs[i].release();
+              }
+            }
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              result_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+            });
+          }
+        }
+
+        callback(user_data, fetches.data(), result_status.IsOK() ? fetches.size() : 0, ToOrtStatus(result_status));
+      });
+
+  submitted = true;
+  return Status::OK();
+}
+
 common::Status InferenceSession::RunAsync(const RunOptions* run_options,
                                           gsl::span<const char* const> feed_names,
                                           gsl::span<const OrtValue* const> feeds,
@@ -3229,6 +3793,16 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
   if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "intra op thread pool must have at least one thread for RunAsync");
   }
+
+  if (pipeline_executor_) {
+    bool submitted = false;
+    ORT_RETURN_IF_ERROR(RunAsyncPipelined(run_options, feed_names, feeds, fetch_names, fetches,
+                                          callback, user_data, submitted));
+    if (submitted) {
+      return Status::OK();
+    }
+  }
+
   std::function<void()> run_fn = [run_options, feed_names, feeds, fetch_names, fetches, num_fetches,
                                   callback, user_data, this]() {
     Status status = Status::OK();
@@ -3326,6 +3900,43 @@ std::pair<common::Status, const OutputDefList*> InferenceSession::GetModelOutput
   return std::make_pair(common::Status::OK(), &model_->MainGraph().GetOutputs());
 }
 
+common::Status InferenceSession::GetZipMapColumnarLabels(size_t output_index,
+                                                         const ONNX_NAMESPACE::AttributeProto*& labels) const {
+  labels = nullptr;
+
+  auto [status, outputs] = GetModelOutputs();
+  ORT_RETURN_IF_ERROR(status);
+  ORT_RETURN_IF_NOT(output_index < outputs->size(), "Output index ", output_index, " is out of range. The model has ",
+                    outputs->size(), " outputs.");
+
+  const NodeArg* output = (*outputs)[output_index];
+  for (const auto& node : model_->MainGraph().Nodes()) {
+    if (node.OpType() != "ZipMapColumnar" || node.Domain() != kMSDomain || node.OutputDefs()[0] != output) {
+      continue;
+    }
+
+    const auto& attributes = node.GetAttributes();
+    for (const char* name : {"classlabels_strings", "classlabels_int64s"}) {
+      if (auto it = attributes.find(name); it != attributes.end()) {
+        labels = &it->second;
+        break;
+      }
+    }
+    break;
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetResourceUsage(SessionResourceUsage& usage) const {
+  if (!is_inited_ || env_resources_ == nullptr) {
+    return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Session has not been initialized.");
+  }
+
+  usage = env_resources_->GetUsage();
+  return Status::OK();
+}
+
 common::Status InferenceSession::GetInputOutputMemoryInfo(SessionInputOutputType type,
                                                           InlinedVector<const OrtMemoryInfo*>& memory_info) const {
   memory_info.clear();
@@ -3429,7 +4040,7 @@ common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& i
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
   return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(), &io_binding.GetOutputsAllocators());
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -17,7 +17,9 @@
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/env_resource_manager.h"
 #include "core/framework/iexecutor.h"
+#include "core/framework/intra_op_thread_tuner.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/prepacked_weights_container.h"
@@ -30,6 +32,7 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/session/shape_buckets.h"
 #include <mutex>
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
@@ -56,6 +59,7 @@ class Environment;
 class GraphTransformer;
 class IExecutionProvider;
 class IOBinding;
+class PipelineExecutor;
 struct Notification;
 
 void reset_saturation_count();
@@ -364,7 +368,8 @@ class InferenceSession {
   [[nodiscard]] common::Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
                                    gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches,
-                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr);
+                                   const std::vector<OrtDevice>* p_fetches_device_info = nullptr,
+                                   const std::vector<AllocatorPtr>* p_fetches_allocators = nullptr);
 
   [[nodiscard]] common::Status Run(const RunOptions& run_options,
                                    gsl::span<const char* const> feed_names,
@@ -465,6 +470,23 @@ class InferenceSession {
    */
   std::pair<common::Status, const OutputDefList*> GetModelOutputs() const;
 
+  /**
+   * Get the class labels of a model output that the ZipMapColumnarTransformer rewrote into a probability tensor.
+   * @param output_index Index of the model output.
+   * @param labels Set to the classlabels_strings or classlabels_int64s attribute of the ZipMapColumnar node that
+   *               produces the output, or to nullptr if the output is not produced by a ZipMapColumnar node.
+   * @note lifetime of the returned pointer is valid as long as the Session object is live.
+   */
+  common::Status GetZipMapColumnarLabels(size_t output_index, const ONNX_NAMESPACE::AttributeProto*& labels) const;
+
+  /**
+   * Get the threads and the arena memory that the session uses, as tracked by the resource manager of the
+   * environment.
+   * @param usage Set to the current usage of the session.
+   * @return Status::OK() if the session is initialized, otherwise an error.
+   */
+  common::Status GetResourceUsage(SessionResourceUsage& usage) const;
+
   enum class SessionInputOutputType : uint8_t {
     kInput = 0,
     kOutput = 1,
@@ -620,6 +642,13 @@ class InferenceSession {
     return node_stats_recorder_.has_value() ? &*node_stats_recorder_ : nullptr;
   }
 
+  /**
+   * IntraOpThreadTuner pointer if intra-op thread tuning is enabled for the session, else nullptr
+   */
+  IntraOpThreadTuner* GetIntraOpThreadTuner() noexcept {
+    return intra_op_thread_tuner_.has_value() ? &*intra_op_thread_tuner_ : nullptr;
+  }
+
 #endif
 
   const Model& GetModel() const;
@@ -706,6 +735,12 @@ class InferenceSession {
     }
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // The thread pool that the independent parts of loading and resolving a model run on, or nullptr if the model is
+  // loaded on the calling thread. See kOrtSessionOptionsConfigParallelModelLoad.
+  onnxruntime::concurrency::ThreadPool* GetModelLoadThreadPool() const;
+#endif
+
   /// convenience pointer to logger. should always be the same as session_state_.Logger();
   const logging::Logger* session_logger_;
 
@@ -753,6 +788,20 @@ class InferenceSession {
     return !custom_schema_registries_.empty();
   }
 
+  // Creates the sessions specialized for the buckets declared with the "session.shape_buckets" config entry.
+  // Must be called before the session state is created, as the initializers to share are added to the session options.
+  [[nodiscard]] common::Status CreateShapeBucketSessions();
+
+  // Runs with the session of the smallest bucket that holds the inputs if there is one, in which case
+  // `dispatched` is set to true.
+  [[nodiscard]] common::Status RunWithShapeBucket(const RunOptions& run_options,
+                                                  gsl::span<const std::string> feed_names,
+                                                  gsl::span<const OrtValue> feeds,
+                                                  gsl::span<const std::string> output_names,
+                                                  std::vector<OrtValue>* p_fetches,
+                                                  const std::vector<OrtDevice>* p_fetches_device_info,
+                                                  bool& dispatched);
+
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
 #endif
 
@@ -790,6 +839,16 @@ class InferenceSession {
   [[nodiscard]] common::Status CheckShapes(const std::string& input_name, const TensorShape& input_shape,
                                            const TensorShape& expected_shape, const char* input_output_moniker) const;
 
+  // Submits a RunAsync request to the pipeline executor. `submitted` is false if the request can't be pipelined.
+  [[nodiscard]] common::Status RunAsyncPipelined(const RunOptions* run_options,
+                                                 gsl::span<const char* const> feed_names,
+                                                 gsl::span<const OrtValue* const> feeds,
+                                                 gsl::span<const char* const> fetch_names,
+                                                 gsl::span<OrtValue*> fetches,
+                                                 RunAsyncCallbackFn callback,
+                                                 void* user_data,
+                                                 bool& submitted);
+
   [[nodiscard]] common::Status ValidateInputs(gsl::span<const std::string> feed_names,
                                               gsl::span<const OrtValue> feeds) const;
 
@@ -868,6 +927,13 @@ class InferenceSession {
   MemoryProfiler memory_profiler_;
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Initializers and pre-packed weights shared with the sessions specialized for the shape buckets.
+  // The container is only created if the user did not add one.
+  std::vector<OrtValue> shape_bucket_initializers_;
+  std::unique_ptr<PrepackedWeightsContainer> shape_bucket_prepacked_weights_container_;
+#endif
+
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
   std::unique_ptr<SessionState> session_state_;
@@ -998,6 +1064,20 @@ class InferenceSession {
   // the cache is valid until any session reliant on it is still in scope.
   PrepackedWeightsContainer* prepacked_weights_container_ = nullptr;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // The buckets declared with the "session.shape_buckets" config entry and a session specialized for each bucket.
+  ShapeBuckets shape_buckets_;
+  std::vector<std::unique_ptr<InferenceSession>> shape_bucket_sessions_;
+
+  // For each graph input and output with a bucketed dimension, the bucketed dimension of each axis or -1.
+  InlinedHashMap<std::string, InlinedVector<int>> shape_bucket_input_axes_;
+  InlinedHashMap<std::string, InlinedVector<int>> shape_bucket_output_axes_;
+#endif
+
+  // Executes RunAsync requests as a pipeline if "session.run_async_pipeline_stages" is set.
+  // Declared after the session state and the thread pools as it waits for the requests in flight when destroyed.
+  std::unique_ptr<PipelineExecutor> pipeline_executor_;
+
   // Cache the EP instance if the user has configured the EP to capture a graph
   // for the model and all the necessary criteria for graph capture has been met.
   // At Run() time, if this member is not nullptr and the captured graph is ready
@@ -1041,9 +1121,16 @@ class InferenceSession {
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
 
+  // The registration of the session with the resource manager of the environment
+  std::unique_ptr<EnvResourceManager::SessionResources> env_resources_;
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Enable nodestats collection
   std::optional<NodeStatsRecorder> node_stats_recorder_;
+
+  // Tunes the number of intra-op threads of each node, and the file the results are loaded from and saved to
+  std::optional<IntraOpThreadTuner> intra_op_thread_tuner_;
+  std::filesystem::path intra_op_thread_tuning_file_;
 #endif
 };
 
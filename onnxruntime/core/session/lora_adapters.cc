@@ -4,7 +4,10 @@
 #include "core/session/lora_adapters.h"
 #include "lora/adapter_format_utils.h"
 
+#include <cstring>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "core/framework/data_transfer.h"
 #include "core/framework/error_code_helper.h"
@@ -38,7 +41,7 @@ void LoraAdapter::Load(const std::filesystem::path& file_path) {
 
 void LoraAdapter::Load(std::vector<uint8_t> buffer) {
   adapter_ = adapters::utils::ValidateAndGetAdapterFromBytes(buffer);
-  buffer_.emplace<BufferHolder>(std::move(buffer));
+  buffer_ = std::make_shared<const Buffer>(std::in_place_type<BufferHolder>, std::move(buffer));
   InitializeParamsValues();
 }
 
@@ -46,7 +49,7 @@ void LoraAdapter::MemoryMap(const std::filesystem::path& file_path) {
   auto [mapped_memory, file_size] = adapters::utils::MemoryMapAdapterFile(file_path);
   auto u8_span = ReinterpretAsSpan<const uint8_t>(gsl::make_span(mapped_memory.get(), file_size));
   adapter_ = adapters::utils::ValidateAndGetAdapterFromBytes(u8_span);
-  buffer_.emplace<MemMapHolder>(std::move(mapped_memory), file_size);
+  buffer_ = std::make_shared<const Buffer>(std::in_place_type<MemMapHolder>, std::move(mapped_memory), file_size);
   InitializeParamsValues();
 }
 
@@ -82,18 +85,23 @@ static Status CreateOrtValueOnDevice(const OrtValue& ort_value_mapped,
   return Status::OK();
 }
 
-void LoraAdapter::InitializeParamsValues() {
-  if (adapter_ == nullptr) {
-    ORT_THROW("Adapter is not loaded yet.");
-  }
-
+static std::unique_ptr<IDataTransfer> GetDeviceDataTransfer(const AllocatorPtr& device_allocator) {
   std::unique_ptr<IDataTransfer> data_transfer;
-  if (device_allocator_) {
-    data_transfer = GetDataTransfer(device_allocator_->Info());
+  if (device_allocator) {
+    data_transfer = GetDataTransfer(device_allocator->Info());
     if (data_transfer == nullptr) {
       ORT_THROW("Data transfer is not available for the specified device allocator, it also must not be a CPU allocator");
     }
   }
+  return data_transfer;
+}
+
+void LoraAdapter::InitializeParamsValues() {
+  if (adapter_ == nullptr) {
+    ORT_THROW("Adapter is not loaded yet.");
+  }
+
+  std::unique_ptr<IDataTransfer> data_transfer = GetDeviceDataTransfer(device_allocator_);
 
   const auto* params = adapter_->parameters();
   ORT_ENFORCE(params != nullptr, "Params absent");
@@ -120,6 +128,95 @@ void LoraAdapter::InitializeParamsValues() {
   params_values_.swap(params_values);
 }
 
+void LoraAdapter::Stack(gsl::span<const LoraAdapter* const> sources) {
+  ORT_ENFORCE(!sources.empty(), "At least one adapter is required to stack");
+
+  const LoraAdapter& first = *sources[0];
+  for (const LoraAdapter* adapter : sources) {
+    ORT_ENFORCE(adapter->GetParamNum() == first.GetParamNum(),
+                "Stacked adapters must have the same parameters");
+    ORT_ENFORCE(adapter->ModelVersion() == first.ModelVersion(),
+                "Stacked adapters must be created for the same model version");
+  }
+
+  std::unique_ptr<IDataTransfer> data_transfer = GetDeviceDataTransfer(device_allocator_);
+
+  // The flatbuffer of a stacked adapter only holds its versions, the parameters are created from the sources.
+  adapters::utils::AdapterFormatBuilder adapter_builder;
+  auto metadata = adapter_builder.Finish(first.AdapterVersion(), first.ModelVersion());
+  const auto* adapter = adapters::utils::ValidateAndGetAdapterFromBytes(metadata);
+  auto buffer = std::make_shared<const Buffer>(std::in_place_type<BufferHolder>, std::move(metadata));
+
+  std::unordered_map<std::string, Param> params_values;
+  params_values.reserve(first.params_values_.size());
+  for (const auto& [name, param] : first.params_values_) {
+    const auto& first_tensor = param.GetMapped().Get<Tensor>();
+    ORT_ENFORCE(!first_tensor.IsDataTypeString(), "Parameter: ", name, " of string type can not be stacked");
+    const size_t slice_bytes = first_tensor.SizeInBytes();
+    const auto* first_data = static_cast<const uint8_t*>(first_tensor.DataRaw());
+
+    InlinedVector<int64_t> stacked_shape;
+    stacked_shape.reserve(first_tensor.Shape().NumDimensions() + 1);
+    stacked_shape.push_back(static_cast<int64_t>(sources.size()));
+    const auto dims = first_tensor.Shape().GetDims();
+    stacked_shape.insert(stacked_shape.end(), dims.begin(), dims.end());
+
+    InlinedVector<const OrtValue*> slices;
+    slices.reserve(sources.size());
+    bool contiguous = true;
+    for (const LoraAdapter* source : sources) {
+      auto hit = source->params_values_.find(name);
+      ORT_ENFORCE(hit != source->params_values_.end(), "Parameter: ", name, " is missing from a stacked adapter");
+      const auto& tensor = hit->second.GetMapped().Get<Tensor>();
+      ORT_ENFORCE(tensor.GetElementType() == first_tensor.GetElementType() && tensor.Shape() == first_tensor.Shape(),
+                  "Parameter: ", name, " must have the same data type and shape in all stacked adapters");
+      contiguous = contiguous && tensor.DataRaw() == first_data + slices.size() * slice_bytes;
+      slices.push_back(&hit->second.GetMapped());
+    }
+
+    OrtValue stacked_value;
+    if (contiguous) {
+      // The stacked parameter is a view of the memory of the sources, which it keeps alive.
+      std::vector<OrtValue> source_values;
+      std::vector<std::shared_ptr<const Buffer>> source_buffers;
+      for (size_t i = 0; i < sources.size(); ++i) {
+        source_values.push_back(*slices[i]);
+        source_buffers.push_back(sources[i]->buffer_);
+      }
+
+      auto view = std::make_unique<Tensor>(first_tensor.DataType(), TensorShape(stacked_shape),
+                                           const_cast<uint8_t*>(first_data), first_tensor.Location());
+      stacked_value.Init(view.release(), DataTypeImpl::GetType<Tensor>(),
+                         [source_values = std::move(source_values),
+                          source_buffers = std::move(source_buffers)](void* p) {
+                           ORT_UNUSED_PARAMETER(source_values);
+                           ORT_UNUSED_PARAMETER(source_buffers);
+                           delete static_cast<Tensor*>(p);
+                         });
+    } else {
+      Tensor stacked(first_tensor.DataType(), TensorShape(stacked_shape), CPUAllocator::DefaultInstance());
+      auto* stacked_data = static_cast<uint8_t*>(stacked.MutableDataRaw());
+      for (size_t i = 0; i < slices.size(); ++i) {
+        memcpy(stacked_data + i * slice_bytes, slices[i]->Get<Tensor>().DataRaw(), slice_bytes);
+      }
+      Tensor::InitOrtValue(std::move(stacked), stacked_value);
+    }
+
+    if (data_transfer) {
+      OrtValue stacked_value_on_device;
+      ORT_THROW_IF_ERROR(CreateOrtValueOnDevice(stacked_value, device_allocator_, *data_transfer,
+                                                stacked_value_on_device));
+      params_values.emplace(name, Param(std::move(stacked_value), std::move(stacked_value_on_device)));
+    } else {
+      params_values.emplace(name, Param(std::move(stacked_value)));
+    }
+  }
+
+  adapter_ = adapter;
+  buffer_ = std::move(buffer);
+  params_values_.swap(params_values);
+}
+
 }  // namespace lora
 }  // namespace onnxruntime
 
@@ -161,6 +258,31 @@ ORT_API_STATUS_IMPL(OrtApis::CreateLoraAdapterFromArray, _In_ const void* bytes,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateStackedLoraAdapter,
+                    _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters, _In_ size_t num_adapters,
+                    _In_opt_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** adapter) {
+  API_IMPL_BEGIN
+
+  if (adapters == nullptr || num_adapters == 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "At least one adapter is required to stack");
+  }
+
+  std::unique_ptr<onnxruntime::lora::LoraAdapter> lora_adapter;
+  if (allocator != nullptr) {
+    auto alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>(std::move(alloc_ptr));
+  } else {
+    lora_adapter = std::make_unique<onnxruntime::lora::LoraAdapter>();
+  }
+
+  auto sources = gsl::make_span(reinterpret_cast<const onnxruntime::lora::LoraAdapter* const*>(adapters),
+                                num_adapters);
+  lora_adapter->Stack(sources);
+  *adapter = reinterpret_cast<OrtLoraAdapter*>(lora_adapter.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API(void, OrtApis::ReleaseLoraAdapter, _Frees_ptr_opt_ OrtLoraAdapter* adapter) {
   delete reinterpret_cast<onnxruntime::lora::LoraAdapter*>(adapter);
 }
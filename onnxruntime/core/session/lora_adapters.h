@@ -12,6 +12,7 @@
 #include "lora/adapter_format_utils.h"
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <variant>
 #include <vector>
@@ -98,6 +99,19 @@ class LoraAdapter {
   /// <param name="file_name"></param>
   void MemoryMap(const std::filesystem::path& file_path);
 
+  /// <summary>
+  /// Stacks the parameters of several resident adapters along a new leading
+  /// dimension so that a single Run() can serve requests for all of them,
+  /// with a per request adapter index selecting the slice (see com.microsoft.MultiLoRA).
+  /// All adapters must have the same parameter names, data types and shapes.
+  /// A parameter whose slices are already laid out contiguously, as they are when a single
+  /// adapter is stacked, references the memory of the sources (including memory mapped files)
+  /// and keeps it alive. Other parameters are copied once into the stacked tensor.
+  /// Versions are taken from the first adapter.
+  /// </summary>
+  /// <param name="sources">adapters to stack, the position is the adapter index</param>
+  void Stack(gsl::span<const LoraAdapter* const> sources);
+
   /// <summary>
   /// Returns number of parameters in the adapter.
   /// The number is expected to be even as lora params come in pairs.
@@ -165,7 +179,9 @@ class LoraAdapter {
     size_t file_size_;
   };
 
-  std::variant<std::monostate, MemMapHolder, BufferHolder> buffer_;
+  using Buffer = std::variant<std::monostate, MemMapHolder, BufferHolder>;
+  // shared with the parameters of stacked adapters that reference it
+  std::shared_ptr<const Buffer> buffer_;
 
   AllocatorPtr device_allocator_;
   const adapters::Adapter* adapter_{nullptr};
@@ -262,6 +262,18 @@ ORT_API_STATUS_IMPL(OrtApis::UpdateEnvWithCustomLogLevel, _In_ OrtEnv* ort_env,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SetEnvResourceLimits, _Inout_ OrtEnv* ort_env, int thread_budget,
+                    size_t arena_memory_cap) {
+  API_IMPL_BEGIN
+  if (thread_budget < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "thread_budget must not be negative.");
+  }
+
+  ort_env->GetEnvironment().GetResourceManager().SetLimits(thread_budget, arena_memory_cap);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::CreateTensorWithDataAsOrtValue, _In_ const OrtMemoryInfo* info,
                     _Inout_ void* p_data, size_t p_data_len, _In_ const int64_t* shape, size_t shape_len,
                     ONNXTensorElementDataType type, _Outptr_ OrtValue** out) {
@@ -947,6 +959,22 @@ ORT_API_STATUS_IMPL(OrtApis::BindOutputToDevice, _Inout_ OrtIoBinding* binding_p
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::BindOutputToAllocator, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                    _In_ OrtAllocator* allocator) {
+  API_IMPL_BEGIN
+  if (allocator == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "allocator must not be null");
+  }
+
+  auto alloc_ptr = std::make_shared<onnxruntime::IAllocatorImplWrappingOrtAllocator>(allocator);
+  auto st = binding_ptr->binding_->BindOutput(name, std::move(alloc_ptr));
+  if (!st.IsOK()) {
+    return ToOrtStatus(st);
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::GetBoundOutputNames, _In_ const OrtIoBinding* binding_ptr, _In_ OrtAllocator* allocator,
                     _Out_ char** buffer, _Outptr_result_maybenull_ size_t** lengths, _Out_ size_t* count) {
   API_IMPL_BEGIN
@@ -1378,6 +1406,55 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetOverridableInitializerTypeInfo, _In_ cons
   return GetNodeDefTypeInfoHelper(sess, get_overridable_initializers_fn, index, out);
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetOutputZipMapLabels, _In_ const OrtSession* sess, size_t index,
+                    _Inout_ OrtAllocator* allocator, _Outptr_result_maybenull_ OrtValue** out) {
+  API_IMPL_BEGIN
+  *out = nullptr;
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  const ONNX_NAMESPACE::AttributeProto* labels = nullptr;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetZipMapColumnarLabels(index, labels));
+  if (labels == nullptr) {
+    return nullptr;
+  }
+
+  const bool using_strings = labels->type() == ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS;
+  const int64_t num_labels = using_strings ? labels->strings_size() : labels->ints_size();
+  auto value = std::make_unique<OrtValue>();
+  ORT_API_RETURN_IF_ERROR(CreateTensorImpl(using_strings ? DataTypeImpl::GetType<std::string>()
+                                                         : DataTypeImpl::GetType<int64_t>(),
+                                           &num_labels, 1, allocator, *value));
+  auto* tensor = value->GetMutable<Tensor>();
+  if (using_strings) {
+    std::copy(labels->strings().begin(), labels->strings().end(), tensor->MutableData<std::string>());
+  } else {
+    std::copy(labels->ints().begin(), labels->ints().end(), tensor->MutableData<int64_t>());
+  }
+
+  *out = value.release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetResourceUsage, _In_ const OrtSession* sess,
+                    _Outptr_ OrtKeyValuePairs** usage) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  SessionResourceUsage session_usage;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetResourceUsage(session_usage));
+
+  auto kvps = std::make_unique<OrtKeyValuePairs>();
+  kvps->Add("priority", ResourcePriorityToString(session_usage.priority));
+  kvps->Add("max_threads", std::to_string(session_usage.max_threads));
+  kvps->Add("thread_grant", std::to_string(session_usage.thread_grant));
+  kvps->Add("active_runs", std::to_string(session_usage.active_runs));
+  kvps->Add("arena_bytes_in_use", std::to_string(session_usage.arena_bytes_in_use));
+  kvps->Add("arena_bytes_reserved", std::to_string(session_usage.arena_bytes_reserved));
+  kvps->Add("arena_bytes_reclaimed", std::to_string(session_usage.arena_bytes_reclaimed));
+  *usage = kvps.release();
+  return nullptr;
+  API_IMPL_END
+}
+
 char* onnxruntime::StrDup(const std::string& str, OrtAllocator* allocator) {
   char* output_string = reinterpret_cast<char*>(allocator->Alloc(allocator, str.size() + 1));
   memcpy(output_string, str.c_str(), str.size());
@@ -2286,6 +2363,10 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "huge_pages") == 0) {
+      cfg->huge_pages = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "numa_node") == 0) {
+      cfg->numa_node = static_cast<int>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -4088,6 +4169,11 @@ static constexpr OrtApi ort_api_1_to_23 = {
     &OrtApis::ReleaseSyncStream,
 
     &OrtApis::CopyTensors,
+    &OrtApis::CreateStackedLoraAdapter,
+    &OrtApis::BindOutputToAllocator,
+    &OrtApis::SessionGetOutputZipMapLabels,
+    &OrtApis::SetEnvResourceLimits,
+    &OrtApis::SessionGetResourceUsage,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
@@ -740,4 +740,17 @@ ORT_API_STATUS_IMPL(CopyTensors, _In_ const OrtEnv* env,
                     _In_reads_(num_tensors) OrtValue* const* dst_tensors,
                     _In_opt_ OrtSyncStream* stream,
                     _In_ size_t num_tensors);
+
+ORT_API_STATUS_IMPL(CreateStackedLoraAdapter, _In_reads_(num_adapters) const OrtLoraAdapter* const* adapters,
+                    _In_ size_t num_adapters, _In_opt_ OrtAllocator* allocator, _Outptr_ OrtLoraAdapter** out);
+
+ORT_API_STATUS_IMPL(BindOutputToAllocator, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                    _In_ OrtAllocator* allocator);
+
+ORT_API_STATUS_IMPL(SessionGetOutputZipMapLabels, _In_ const OrtSession* session, size_t index,
+                    _Inout_ OrtAllocator* allocator, _Outptr_result_maybenull_ OrtValue** out);
+
+ORT_API_STATUS_IMPL(SetEnvResourceLimits, _Inout_ OrtEnv* env, int thread_budget, size_t arena_memory_cap);
+
+ORT_API_STATUS_IMPL(SessionGetResourceUsage, _In_ const OrtSession* session, _Outptr_ OrtKeyValuePairs** usage);
 }  // namespace OrtApis
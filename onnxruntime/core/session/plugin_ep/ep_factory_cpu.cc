@@ -48,6 +48,8 @@ OrtStatus* CpuEpFactory::CreateIExecutionProvider(const OrtHardwareDevice* const
   }
 
   CPUExecutionProviderInfo epi{session_options->value.enable_cpu_mem_arena};
+  ORT_API_RETURN_IF_STATUS_NOT_OK(CPUPageAllocatorOptions::FromConfigOptions(session_options->value.config_options,
+                                                                             epi.page_allocator_options));
   *ep = std::make_unique<CPUExecutionProvider>(epi);
   (*ep)->SetLogger(session_logger->ToInternal());
 
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/shape_buckets.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/parse_string.h"
+#include "core/common/safeint.h"
+#include "core/common/string_utils.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+Status ShapeBuckets::Parse(const std::string& config, ShapeBuckets& out) {
+  out.dims_.clear();
+
+  for (const auto& dim_config : utils::SplitString(config, ";")) {
+    const auto separator = dim_config.find(':');
+    ORT_RETURN_IF(separator == std::string_view::npos || separator == 0,
+                  "Shape bucket entry '", dim_config, "' is not in the format <dim_param>:<size>[,<size>...]");
+
+    Dim dim;
+    dim.name = utils::TrimString(std::string{dim_config.substr(0, separator)});
+    ORT_RETURN_IF(out.DimIndex(dim.name) >= 0, "Shape buckets are declared twice for dimension '", dim.name, "'");
+
+    for (const auto& size_str : utils::SplitString(dim_config.substr(separator + 1), ",")) {
+      int64_t size = 0;
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(utils::TrimString(std::string{size_str}), size) && size > 0,
+                        "Invalid shape bucket size '", size_str, "' for dimension '", dim.name, "'");
+      dim.sizes.push_back(size);
+    }
+
+    ORT_RETURN_IF(dim.sizes.empty(), "No shape bucket sizes for dimension '", dim.name, "'");
+    std::sort(dim.sizes.begin(), dim.sizes.end());
+    dim.sizes.erase(std::unique(dim.sizes.begin(), dim.sizes.end()), dim.sizes.end());
+    out.dims_.push_back(std::move(dim));
+  }
+
+  return Status::OK();
+}
+
+int ShapeBuckets::DimIndex(const std::string& name) const {
+  for (size_t i = 0; i < dims_.size(); ++i) {
+    if (dims_[i].name == name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+size_t ShapeBuckets::NumBuckets() const {
+  if (dims_.empty()) {
+    return 0;
+  }
+
+  SafeInt<size_t> num_buckets = 1;
+  for (const auto& dim : dims_) {
+    num_buckets *= dim.sizes.size();
+  }
+  return num_buckets;
+}
+
+InlinedVector<int64_t> ShapeBuckets::BucketSizes(size_t bucket) const {
+  InlinedVector<int64_t> sizes(dims_.size());
+  for (size_t i = dims_.size(); i-- > 0;) {
+    const auto& dim_sizes = dims_[i].sizes;
+    sizes[i] = dim_sizes[bucket % dim_sizes.size()];
+    bucket /= dim_sizes.size();
+  }
+  return sizes;
+}
+
+bool ShapeBuckets::FindBucket(gsl::span<const int64_t> dim_values, size_t& bucket) const {
+  if (dim_values.size() != dims_.size()) {
+    return false;
+  }
+
+  bucket = 0;
+  for (size_t i = 0; i < dims_.size(); ++i) {
+    const auto& dim_sizes = dims_[i].sizes;
+    const auto it = std::lower_bound(dim_sizes.begin(), dim_sizes.end(), dim_values[i]);
+    if (it == dim_sizes.end()) {
+      return false;
+    }
+    bucket = bucket * dim_sizes.size() + static_cast<size_t>(it - dim_sizes.begin());
+  }
+
+  return true;
+}
+
+namespace {
+
+void CopyRegion(const uint8_t* src, gsl::span<const int64_t> src_dims,
+                uint8_t* dst, gsl::span<const int64_t> dst_dims,
+                size_t axis, size_t element_size) {
+  const size_t extent = static_cast<size_t>(std::min(src_dims[axis], dst_dims[axis]));
+  if (axis + 1 == src_dims.size()) {
+    memcpy(dst, src, extent * element_size);
+    return;
+  }
+
+  const size_t src_stride = SafeInt<size_t>(TensorShape(src_dims.subspan(axis + 1)).Size()) * element_size;
+  const size_t dst_stride = SafeInt<size_t>(TensorShape(dst_dims.subspan(axis + 1)).Size()) * element_size;
+  for (size_t i = 0; i < extent; ++i) {
+    CopyRegion(src + i * src_stride, src_dims, dst + i * dst_stride, dst_dims, axis + 1, element_size);
+  }
+}
+
+}  // namespace
+
+Status CopyTensorRegion(const Tensor& src, Tensor& dst) {
+  ORT_RETURN_IF_NOT(src.DataType() == dst.DataType() && !src.IsDataTypeString() &&
+                        src.NumStorageElements() == src.Shape().Size(),
+                    "Tensor region copy does not support mismatched, string or packed sub-byte element types");
+  ORT_RETURN_IF_NOT(src.Location().device.Type() == OrtDevice::CPU && dst.Location().device.Type() == OrtDevice::CPU,
+                    "Tensor region copy requires CPU tensors");
+
+  const auto src_dims = src.Shape().GetDims();
+  const auto dst_dims = dst.Shape().GetDims();
+  ORT_RETURN_IF_NOT(src_dims.size() == dst_dims.size(), "Tensor region copy requires tensors of the same rank");
+
+  if (src.Shape().Size() == 0 || dst.Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  if (src_dims.empty()) {
+    memcpy(dst.MutableDataRaw(), src.DataRaw(), src.SizeInBytes());
+    return Status::OK();
+  }
+
+  CopyRegion(static_cast<const uint8_t*>(src.DataRaw()), src_dims,
+             static_cast<uint8_t*>(dst.MutableDataRaw()), dst_dims, 0, src.DataType()->Size());
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
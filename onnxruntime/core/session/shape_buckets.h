@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+class Tensor;
+
+// ShapeBuckets holds the buckets of the symbolic dimensions declared with the
+// kOrtSessionOptionsShapeBuckets session config entry, e.g. "seq:128,256,512;batch:1,8".
+// A bucket is one combination of sizes, one size per dimension. The buckets are numbered in row-major order of
+// the dimensions as declared, i.e. the sizes of the last dimension vary fastest.
+class ShapeBuckets {
+ public:
+  ShapeBuckets() = default;
+
+  static Status Parse(const std::string& config, ShapeBuckets& out);
+
+  bool Empty() const { return dims_.empty(); }
+  size_t NumDims() const { return dims_.size(); }
+  const std::string& DimName(size_t dim) const { return dims_[dim].name; }
+
+  // Returns the index of the dimension with the given name, or -1 if there is none.
+  int DimIndex(const std::string& name) const;
+
+  size_t NumBuckets() const;
+
+  // Returns the size of each dimension in the given bucket.
+  InlinedVector<int64_t> BucketSizes(size_t bucket) const;
+
+  // Finds the smallest bucket that holds the given dimension values, one per dimension.
+  // A negative value means the dimension is not bound and matches its smallest size.
+  // Returns false if a value is larger than the largest size of its dimension.
+  bool FindBucket(gsl::span<const int64_t> dim_values, size_t& bucket) const;
+
+ private:
+  struct Dim {
+    std::string name;
+    // ascending and unique
+    std::vector<int64_t> sizes;
+  };
+
+  std::vector<Dim> dims_;
+};
+
+// Copies the region that src and dst have in common, i.e. the leading min(src, dst) elements of each axis,
+// from src to dst. Both must be CPU tensors of the same rank and element type, which may not be string or a packed
+// sub-byte type.
+// This pads src into a larger zero-initialized dst, or crops it into a smaller one.
+Status CopyTensorRegion(const Tensor& src, Tensor& dst);
+
+}  // namespace onnxruntime
@@ -766,6 +766,7 @@ void Im2col<T, StorageOrder::NHWC>::operator()(
   }
 }
 
+template struct Im2col<float, StorageOrder::NHWC>;
 template struct Im2col<int8_t, StorageOrder::NHWC>;
 template struct Im2col<uint8_t, StorageOrder::NHWC>;
 template struct Im2col<MLFloat16, StorageOrder::NHWC>;
@@ -205,6 +205,40 @@ class Session:
         "Return registered execution providers' configurations."
         return self._provider_options
 
+    def get_zipmap_labels(self, output_name: str) -> list[str] | list[int] | None:
+        """
+        Return the class labels of an output that a ZipMap node produces in columnar form, or None if the output
+        is not one. ZipMap nodes that produce a model output are rewritten into the columnar form when the session
+        config entry ``optimization.zipmap_columnar_output`` is ``"1"``.
+
+        :param output_name: name of the output
+        """
+        output_names = [output.name for output in self._outputs_meta]
+        if output_name not in output_names:
+            raise ValueError(f"{output_name} is not an output of the model. Outputs are {output_names}.")
+        return self._sess.get_zipmap_labels(output_names.index(output_name))
+
+    def zipmap_view(self, output_name: str, probabilities: np.ndarray) -> ZipMapView:
+        """
+        Return a :class:`onnxruntime.ZipMapView` that presents a columnar ZipMap output as the list of
+        dictionaries the ZipMap operator would have returned, without copying the probabilities.
+
+        ::
+
+            so.add_session_config_entry("optimization.zipmap_columnar_output", "1")
+            sess = onnxruntime.InferenceSession(model, so)
+            label, probabilities = sess.run(None, {input_name: x})
+            rows = sess.zipmap_view("output_probability", probabilities)
+            rows[0]["class_a"]
+
+        :param output_name: name of the columnar ZipMap output
+        :param probabilities: the value of the output returned by run
+        """
+        labels = self.get_zipmap_labels(output_name)
+        if labels is None:
+            raise ValueError(f"{output_name} is not produced by a columnar ZipMap node.")
+        return ZipMapView(labels, probabilities)
+
     def set_providers(self, providers=None, provider_options=None) -> None:
         """
         Register the input list of execution providers. The underlying session is re-created.
@@ -403,6 +437,60 @@ class Session:
         self._sess.run_with_ortvaluevector(run_options, feed_names, feeds, fetch_names, fetches, fetch_devices)
 
 
+class ZipMapView(collections.abc.Sequence):
+    """
+    Read-only view of a columnar ZipMap output. Row ``i`` is a mapping from class label to the probability in
+    ``probabilities[i]``, like the i-th dictionary returned by the ZipMap operator. The labels are shared by all
+    rows and the probabilities are read from the array on access, so creating the view does not copy any data.
+    Use :meth:`onnxruntime.InferenceSession.zipmap_view` to create one.
+    """
+
+    def __init__(self, labels: Sequence[str] | Sequence[int], probabilities: np.ndarray):
+        if probabilities.ndim != 2 or probabilities.shape[1] != len(labels):
+            raise ValueError(
+                f"Expected probabilities of shape [N, {len(labels)}] but got shape {list(probabilities.shape)}."
+            )
+        self._labels = labels
+        self._label_to_column = {label: column for column, label in enumerate(labels)}
+        self._probabilities = probabilities
+
+    @property
+    def labels(self) -> Sequence[str] | Sequence[int]:
+        "Return the class labels, in the order of the columns of the probabilities."
+        return self._labels
+
+    @property
+    def probabilities(self) -> np.ndarray:
+        "Return the probabilities as an array of shape [N, C]."
+        return self._probabilities
+
+    def __len__(self) -> int:
+        return self._probabilities.shape[0]
+
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return [self[i] for i in range(*index.indices(len(self)))]
+        return _ZipMapRow(self._label_to_column, self._probabilities[index])
+
+
+class _ZipMapRow(collections.abc.Mapping):
+    def __init__(self, label_to_column, row):
+        self._label_to_column = label_to_column
+        self._row = row
+
+    def __getitem__(self, label):
+        return float(self._row[self._label_to_column[label]])
+
+    def __iter__(self):
+        return iter(self._label_to_column)
+
+    def __len__(self) -> int:
+        return len(self._label_to_column)
+
+    def __repr__(self) -> str:
+        return repr(dict(self))
+
+
 class InferenceSession(Session):
     """
     This is the main class used to run a model.
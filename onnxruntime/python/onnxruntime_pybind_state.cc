@@ -2731,6 +2731,16 @@ including arg name, arg type (contains both type and shape).)pbdoc")
             auto res = sess->GetSessionHandle()->GetModelMetadata();
             OrtPybindThrowIfError(res.first);
             return *(res.second); }, py::return_value_policy::reference_internal)
+      .def("get_zipmap_labels", [](const PyInferenceSession* sess, size_t output_index) -> py::object {
+            const ONNX_NAMESPACE::AttributeProto* labels = nullptr;
+            OrtPybindThrowIfError(sess->GetSessionHandle()->GetZipMapColumnarLabels(output_index, labels));
+            if (labels == nullptr) {
+              return py::none();
+            }
+            if (labels->type() == ONNX_NAMESPACE::AttributeProto_AttributeType_STRINGS) {
+              return py::cast(std::vector<std::string>(labels->strings().begin(), labels->strings().end()));
+            }
+            return py::cast(std::vector<int64_t>(labels->ints().begin(), labels->ints().end())); })
       .def("run_with_iobinding", [](PyInferenceSession* sess, SessionIOBinding& io_binding, RunOptions* run_options = nullptr) -> void {
 
         Status status;
@@ -243,6 +243,95 @@ TEST(FusedConvTest, Cpu_Conv2D_Bias_Z_Relu) {
   RunConvOp(attrs, {X, W, B, Z}, {X_shape, W_shape, B_shape, Z_shape}, expected_vals, Y_shape, false, true, true, true);
 }
 
+TEST(FusedConvTest, Cpu_NhwcFusedConv2D_Bias_Z_Relu) {
+  OpTester test("NhwcFusedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("group", int64_t{1});
+  test.AddAttribute("kernel_shape", vector<int64_t>{2, 2});
+  test.AddAttribute("pads", vector<int64_t>{0, 0, 0, 0});
+  test.AddAttribute("activation", std::string("Relu"));
+
+  test.AddInput<float>("X", {1, 3, 3, 1}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f});
+  test.AddInput<float>("W", {2, 1, 2, 2}, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f}, true);
+  test.AddInput<float>("B", {2}, {1.0f, -1.0f});
+  test.AddInput<float>("Z", {1, 2, 2, 2}, {-1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
+  test.AddOutput<float>("Y", {1, 2, 2, 2}, {12.0f, 11.0f, 17.0f, 15.0f, 25.0f, 23.0f, 29.0f, 28.0f});
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+// Compares the channels last kernel against a direct computation for padded, strided, dilated,
+// grouped and depthwise 2D convolutions.
+static void RunNhwcFusedConvFloatTest(int64_t N, int64_t H, int64_t W, int64_t C, int64_t M,
+                                      int64_t group, int64_t kernel, int64_t pad, int64_t stride,
+                                      int64_t dilation, bool weight_is_initializer) {
+  const int64_t group_input_channels = C / group;
+  const int64_t group_output_channels = M / group;
+  const int64_t OH = (H + 2 * pad - dilation * (kernel - 1) - 1) / stride + 1;
+  const int64_t OW = (W + 2 * pad - dilation * (kernel - 1) - 1) / stride + 1;
+
+  RandomValueGenerator random{1234};
+  const vector<int64_t> X_shape{N, H, W, C};
+  const vector<int64_t> W_shape{M, group_input_channels, kernel, kernel};
+  const vector<int64_t> Y_shape{N, OH, OW, M};
+  const vector<float> X_data = random.Uniform<float>(X_shape, -1.0f, 1.0f);
+  const vector<float> W_data = random.Uniform<float>(W_shape, -1.0f, 1.0f);
+  const vector<int64_t> B_shape{M};
+  const vector<float> B_data = random.Uniform<float>(B_shape, -1.0f, 1.0f);
+
+  vector<float> Y_data(static_cast<size_t>(N * OH * OW * M));
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t oh = 0; oh < OH; oh++) {
+      for (int64_t ow = 0; ow < OW; ow++) {
+        for (int64_t m = 0; m < M; m++) {
+          const int64_t g = m / group_output_channels;
+          double sum = B_data[static_cast<size_t>(m)];
+          for (int64_t c = 0; c < group_input_channels; c++) {
+            for (int64_t kh = 0; kh < kernel; kh++) {
+              for (int64_t kw = 0; kw < kernel; kw++) {
+                const int64_t ih = oh * stride + kh * dilation - pad;
+                const int64_t iw = ow * stride + kw * dilation - pad;
+                if (ih < 0 || ih >= H || iw < 0 || iw >= W) {
+                  continue;
+                }
+                sum += X_data[static_cast<size_t>(((n * H + ih) * W + iw) * C + g * group_input_channels + c)] *
+                       W_data[static_cast<size_t>(((m * group_input_channels + c) * kernel + kh) * kernel + kw)];
+              }
+            }
+          }
+          Y_data[static_cast<size_t>(((n * OH + oh) * OW + ow) * M + m)] = std::max(static_cast<float>(sum), 0.0f);
+        }
+      }
+    }
+  }
+
+  OpTester test("NhwcFusedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("group", group);
+  test.AddAttribute("kernel_shape", vector<int64_t>{kernel, kernel});
+  test.AddAttribute("pads", vector<int64_t>{pad, pad, pad, pad});
+  test.AddAttribute("strides", vector<int64_t>{stride, stride});
+  test.AddAttribute("dilations", vector<int64_t>{dilation, dilation});
+  test.AddAttribute("activation", std::string("Relu"));
+  test.AddInput<float>("X", X_shape, X_data);
+  test.AddInput<float>("W", W_shape, W_data, weight_is_initializer);
+  test.AddInput<float>("B", B_shape, B_data);
+  test.AddOutput<float>("Y", Y_shape, Y_data, false, 1e-4f, 1e-4f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(FusedConvTest, Cpu_NhwcFusedConv2D_Float) {
+  RunNhwcFusedConvFloatTest(2, 9, 11, 24, 40, 1, 3, 1, 1, 1, true);
+  RunNhwcFusedConvFloatTest(1, 12, 12, 300, 20, 1, 3, 0, 2, 1, false);
+  RunNhwcFusedConvFloatTest(1, 10, 10, 16, 24, 4, 3, 2, 1, 2, true);
+  RunNhwcFusedConvFloatTest(2, 8, 7, 32, 48, 1, 1, 0, 1, 1, true);
+  RunNhwcFusedConvFloatTest(1, 8, 8, 32, 32, 32, 3, 1, 1, 1, true);
+  RunNhwcFusedConvFloatTest(1, 15, 13, 19, 19, 19, 5, 2, 2, 1, false);
+}
+
 #endif
 
 }  // namespace test
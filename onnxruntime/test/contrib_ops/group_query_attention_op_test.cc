@@ -0,0 +1,349 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+
+#include "core/framework/kernel_registry.h"
+#include "core/framework/kernel_type_str_resolver.h"
+#include "core/graph/model.h"
+#include "core/mlas/inc/mlas.h"
+#include "test/common/random_generator.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Builds a model with a GroupQueryAttention node on float16 inputs with a past key/value cache of the given type.
+static std::unique_ptr<Model> BuildGroupQueryAttentionModel(int32_t cache_type, int64_t kv_cache_bit_width) {
+  auto model = std::make_unique<Model>("gqa", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                                       std::unordered_map<std::string, int>{{kOnnxDomain, 17}, {kMSDomain, 1}},
+                                       std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                       DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model->MainGraph();
+
+  auto make_type = [](int32_t elem_type, std::initializer_list<int64_t> dims) {
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(elem_type);
+    for (int64_t dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+
+  // num_heads = 4, kv_num_heads = 2, head_size = 16
+  const int32_t float16 = ONNX_NAMESPACE::TensorProto_DataType_FLOAT16;
+  const int32_t int32 = ONNX_NAMESPACE::TensorProto_DataType_INT32;
+  const auto query_type = make_type(float16, {1, 1, 64});
+  const auto kv_type = make_type(float16, {1, 1, 32});
+  const auto past_type = make_type(cache_type, {1, 2, 4, 16});
+  const auto seqlens_type = make_type(int32, {1});
+  const auto total_length_type = make_type(int32, {1});
+
+  std::vector<NodeArg*> inputs = {
+      &graph.GetOrCreateNodeArg("query", &query_type),
+      &graph.GetOrCreateNodeArg("key", &kv_type),
+      &graph.GetOrCreateNodeArg("value", &kv_type),
+      &graph.GetOrCreateNodeArg("past_key", &past_type),
+      &graph.GetOrCreateNodeArg("past_value", &past_type),
+      &graph.GetOrCreateNodeArg("seqlens_k", &seqlens_type),
+      &graph.GetOrCreateNodeArg("total_sequence_length", &total_length_type),
+  };
+  std::vector<NodeArg*> outputs = {
+      &graph.GetOrCreateNodeArg("output", nullptr),
+      &graph.GetOrCreateNodeArg("present_key", nullptr),
+      &graph.GetOrCreateNodeArg("present_value", nullptr),
+  };
+
+  Node& node = graph.AddNode("gqa", "GroupQueryAttention", "", inputs, outputs, nullptr, kMSDomain);
+  node.AddAttribute("num_heads", int64_t{4});
+  node.AddAttribute("kv_num_heads", int64_t{2});
+  node.AddAttribute("kv_cache_bit_width", kv_cache_bit_width);
+  return model;
+}
+
+static bool HasGroupQueryAttentionKernel(IExecutionProvider& execution_provider, const Graph& graph) {
+  const OpSchemaKernelTypeStrResolver kernel_type_str_resolver{};
+  const Node& node = *graph.Nodes().begin();
+  return KernelRegistry::HasImplementationOf(*execution_provider.GetKernelRegistry(), node, execution_provider.Type(),
+                                             kernel_type_str_resolver, DefaultLoggingManager().DefaultLogger());
+}
+
+TEST(GroupQueryAttentionTest, KernelMatchingWithQuantizedCache) {
+  auto float_cache_model = BuildGroupQueryAttentionModel(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16, 0);
+  ASSERT_STATUS_OK(float_cache_model->MainGraph().Resolve());
+  auto int8_cache_model = BuildGroupQueryAttentionModel(ONNX_NAMESPACE::TensorProto_DataType_INT8, 8);
+  ASSERT_STATUS_OK(int8_cache_model->MainGraph().Resolve());
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  execution_providers.push_back(DefaultWebGpuExecutionProvider());
+  execution_providers.push_back(DefaultDmlExecutionProvider());
+
+  // Only the CPU kernel supports a quantized cache. The other kernels must not be assigned such a node.
+  for (auto& execution_provider : execution_providers) {
+    if (execution_provider == nullptr) {
+      continue;
+    }
+
+    SCOPED_TRACE(execution_provider->Type());
+    EXPECT_TRUE(HasGroupQueryAttentionKernel(*execution_provider, float_cache_model->MainGraph()));
+    EXPECT_EQ(HasGroupQueryAttentionKernel(*execution_provider, int8_cache_model->MainGraph()),
+              execution_provider->Type() == kCpuExecutionProvider);
+  }
+}
+
+TEST(GroupQueryAttentionTest, CacheTypeMustMatchQuery) {
+  // The cache of a float16 query may not be float when it is not quantized, or float16 when it is.
+  auto float_cache_model = BuildGroupQueryAttentionModel(ONNX_NAMESPACE::TensorProto_DataType_FLOAT, 0);
+  EXPECT_FALSE(float_cache_model->MainGraph().Resolve().IsOK());
+  auto float16_cache_model = BuildGroupQueryAttentionModel(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16, 8);
+  EXPECT_FALSE(float16_cache_model->MainGraph().Resolve().IsOK());
+}
+
+struct GroupQueryAttentionConfig {
+  int64_t batch_size;
+  int64_t sequence_length;
+  int64_t past_sequence_length;
+  int64_t num_heads;
+  int64_t kv_num_heads;
+  int64_t head_size;
+  bool packed_qkv = false;
+  int64_t local_window_size = -1;
+  int64_t kv_quant_group_size = 0;  // 0 for head_size
+};
+
+struct GroupQueryAttentionData {
+  std::vector<float> query;       // (B, S, N * H)
+  std::vector<float> key;         // (B, S, N_kv * H)
+  std::vector<float> value;       // (B, S, N_kv * H)
+  std::vector<float> past_key;    // (B, N_kv, P, H)
+  std::vector<float> past_value;  // (B, N_kv, P, H)
+};
+
+// Quantizes a (B, N_kv, P, H) cache to the format the CPU kernel stores it in.
+template <typename TCache>
+static std::vector<TCache> QuantizeCache(const std::vector<float>& cache, int64_t head_size, int64_t bit_width,
+                                         int64_t group_size, std::vector<float>& scales) {
+  const size_t token_count = cache.size() / static_cast<size_t>(head_size);
+  std::vector<TCache> quantized(token_count * static_cast<size_t>(bit_width == 8 ? head_size : head_size / 2));
+  scales.resize(token_count * static_cast<size_t>(head_size / group_size));
+  MlasQuantizeKvCache(cache.data(), token_count, static_cast<size_t>(head_size), static_cast<size_t>(group_size),
+                      static_cast<size_t>(bit_width), quantized.data(), scales.data());
+  return quantized;
+}
+
+template <typename TCache>
+static void AddPresentOutputs(OpTester& tester, const std::vector<int64_t>& dims) {
+  const size_t size = static_cast<size_t>(TensorShape(dims).Size());
+  tester.AddOutput<TCache>("present_key", dims, std::vector<TCache>(size));
+  tester.AddOutput<TCache>("present_value", dims, std::vector<TCache>(size));
+}
+
+// Runs GroupQueryAttention on CPU with a float cache when kv_cache_bit_width is 0 or a quantized one otherwise, and
+// returns the attention output.
+template <typename T>
+static std::vector<float> RunGroupQueryAttention(const GroupQueryAttentionConfig& config,
+                                                 const GroupQueryAttentionData& data,
+                                                 int64_t kv_cache_bit_width) {
+  const int64_t batch_size = config.batch_size;
+  const int64_t sequence_length = config.sequence_length;
+  const int64_t past_sequence_length = config.past_sequence_length;
+  const int64_t total_sequence_length = past_sequence_length + sequence_length;
+  const int64_t q_hidden_size = config.num_heads * config.head_size;
+  const int64_t kv_hidden_size = config.kv_num_heads * config.head_size;
+  const int64_t group_size = config.kv_quant_group_size > 0 ? config.kv_quant_group_size : config.head_size;
+  const int64_t cache_head_size = kv_cache_bit_width == 4 ? config.head_size / 2 : config.head_size;
+
+  OpTester tester("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", config.num_heads);
+  tester.AddAttribute<int64_t>("kv_num_heads", config.kv_num_heads);
+  tester.AddAttribute<int64_t>("local_window_size", config.local_window_size);
+  if (kv_cache_bit_width != 0) {
+    tester.AddAttribute<int64_t>("kv_cache_bit_width", kv_cache_bit_width);
+    tester.AddAttribute<int64_t>("kv_quant_group_size", group_size);
+  }
+
+  if (config.packed_qkv) {
+    // Each token holds its query, key and value heads back to back.
+    std::vector<float> packed_qkv;
+    packed_qkv.reserve(data.query.size() + data.key.size() + data.value.size());
+    for (int64_t token = 0; token < batch_size * sequence_length; token++) {
+      auto append = [&](const std::vector<float>& values, int64_t hidden_size) {
+        packed_qkv.insert(packed_qkv.end(), values.begin() + token * hidden_size,
+                          values.begin() + (token + 1) * hidden_size);
+      };
+      append(data.query, q_hidden_size);
+      append(data.key, kv_hidden_size);
+      append(data.value, kv_hidden_size);
+    }
+    tester.AddInput<T>("query", {batch_size, sequence_length, q_hidden_size + 2 * kv_hidden_size},
+                       GetTypedArray<T>(packed_qkv));
+    tester.AddOptionalInputEdge<T>();
+    tester.AddOptionalInputEdge<T>();
+  } else {
+    tester.AddInput<T>("query", {batch_size, sequence_length, q_hidden_size}, GetTypedArray<T>(data.query));
+    tester.AddInput<T>("key", {batch_size, sequence_length, kv_hidden_size}, GetTypedArray<T>(data.key));
+    tester.AddInput<T>("value", {batch_size, sequence_length, kv_hidden_size}, GetTypedArray<T>(data.value));
+  }
+
+  const std::vector<int64_t> past_dims = {batch_size, config.kv_num_heads, past_sequence_length, cache_head_size};
+  std::vector<float> past_key_scale;
+  std::vector<float> past_value_scale;
+  if (past_sequence_length == 0) {
+    tester.AddOptionalInputEdge<T>();
+    tester.AddOptionalInputEdge<T>();
+  } else if (kv_cache_bit_width == 0) {
+    tester.AddInput<T>("past_key", past_dims, GetTypedArray<T>(data.past_key));
+    tester.AddInput<T>("past_value", past_dims, GetTypedArray<T>(data.past_value));
+  } else if (kv_cache_bit_width == 8) {
+    tester.AddInput<int8_t>("past_key", past_dims,
+                            QuantizeCache<int8_t>(data.past_key, config.head_size, 8, group_size, past_key_scale));
+    tester.AddInput<int8_t>("past_value", past_dims,
+                            QuantizeCache<int8_t>(data.past_value, config.head_size, 8, group_size, past_value_scale));
+  } else {
+    tester.AddInput<uint8_t>("past_key", past_dims,
+                             QuantizeCache<uint8_t>(data.past_key, config.head_size, 4, group_size, past_key_scale));
+    tester.AddInput<uint8_t>("past_value", past_dims,
+                             QuantizeCache<uint8_t>(data.past_value, config.head_size, 4, group_size,
+                                                    past_value_scale));
+  }
+
+  tester.AddInput<int32_t>("seqlens_k", {batch_size},
+                           std::vector<int32_t>(static_cast<size_t>(batch_size),
+                                                static_cast<int32_t>(total_sequence_length - 1)));
+  tester.AddInput<int32_t>("total_sequence_length", {1}, {static_cast<int32_t>(total_sequence_length)});
+
+  if (kv_cache_bit_width != 0) {
+    // cos_cache, sin_cache, position_ids, attention_bias and head_sink come before the past scales.
+    tester.AddOptionalInputEdge<T>();
+    tester.AddOptionalInputEdge<T>();
+    tester.AddOptionalInputEdge<int64_t>();
+    tester.AddOptionalInputEdge<T>();
+    tester.AddOptionalInputEdge<T>();
+    if (past_sequence_length == 0) {
+      tester.AddOptionalInputEdge<float>();
+      tester.AddOptionalInputEdge<float>();
+    } else {
+      const std::vector<int64_t> scale_dims = {batch_size, config.kv_num_heads, past_sequence_length,
+                                               config.head_size / group_size};
+      tester.AddInput<float>("past_key_scale", scale_dims, past_key_scale);
+      tester.AddInput<float>("past_value_scale", scale_dims, past_value_scale);
+    }
+  }
+
+  const size_t output_size = static_cast<size_t>(batch_size * sequence_length * q_hidden_size);
+  tester.AddOutput<T>("output", {batch_size, sequence_length, q_hidden_size}, std::vector<T>(output_size));
+  const std::vector<int64_t> present_dims = {batch_size, config.kv_num_heads, total_sequence_length, cache_head_size};
+  if (kv_cache_bit_width == 0) {
+    AddPresentOutputs<T>(tester, present_dims);
+  } else {
+    if (kv_cache_bit_width == 8) {
+      AddPresentOutputs<int8_t>(tester, present_dims);
+    } else {
+      AddPresentOutputs<uint8_t>(tester, present_dims);
+    }
+    const std::vector<int64_t> scale_dims = {batch_size, config.kv_num_heads, total_sequence_length,
+                                             config.head_size / group_size};
+    const size_t scale_size = static_cast<size_t>(TensorShape(scale_dims).Size());
+    tester.AddOptionalOutputEdge<T>();
+    tester.AddOutput<float>("present_key_scale", scale_dims, std::vector<float>(scale_size));
+    tester.AddOutput<float>("present_value_scale", scale_dims, std::vector<float>(scale_size));
+  }
+
+  std::vector<float> output;
+  tester.SetCustomOutputVerifier([&output](const std::vector<OrtValue>& fetches, const std::string& /*provider*/) {
+    const Tensor& tensor = fetches[0].Get<Tensor>();
+    const T* data = tensor.Data<T>();
+    output.resize(static_cast<size_t>(tensor.Shape().Size()));
+    for (size_t i = 0; i < output.size(); i++) {
+      if constexpr (std::is_same_v<T, MLFloat16>) {
+        output[i] = data[i].ToFloat();
+      } else {
+        output[i] = data[i];
+      }
+    }
+  });
+  tester.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+  return output;
+}
+
+// Compares the output of an int8 and an int4 quantized cache against the output of a float cache.
+template <typename T>
+static void RunQuantizedCacheTest(const GroupQueryAttentionConfig& config) {
+  const int64_t batch_size = config.batch_size;
+  const int64_t sequence_length = config.sequence_length;
+  const int64_t kv_hidden_size = config.kv_num_heads * config.head_size;
+
+  RandomValueGenerator random{};
+  GroupQueryAttentionData data;
+  data.query = random.Uniform<float>(std::vector<int64_t>{batch_size, sequence_length,
+                                                          config.num_heads * config.head_size},
+                                     -1.0f, 1.0f);
+  data.key = random.Uniform<float>(std::vector<int64_t>{batch_size, sequence_length, kv_hidden_size}, -1.0f, 1.0f);
+  data.value = random.Uniform<float>(std::vector<int64_t>{batch_size, sequence_length, kv_hidden_size}, -1.0f, 1.0f);
+  const std::vector<int64_t> past_dims = {batch_size, config.kv_num_heads, config.past_sequence_length,
+                                          config.head_size};
+  data.past_key = random.Uniform<float>(past_dims, -1.0f, 1.0f);
+  data.past_value = random.Uniform<float>(past_dims, -1.0f, 1.0f);
+
+  if constexpr (std::is_same_v<T, MLFloat16>) {
+    // Round the inputs to float16 so that the quantized cache is computed from the values the float cache holds.
+    for (auto* values : {&data.query, &data.key, &data.value, &data.past_key, &data.past_value}) {
+      for (float& value : *values) {
+        value = MLFloat16(value).ToFloat();
+      }
+    }
+  }
+
+  const std::vector<float> expected = RunGroupQueryAttention<T>(config, data, 0);
+  for (int64_t kv_cache_bit_width : {8, 4}) {
+    SCOPED_TRACE("kv_cache_bit_width " + std::to_string(kv_cache_bit_width));
+    const std::vector<float> actual = RunGroupQueryAttention<T>(config, data, kv_cache_bit_width);
+    ASSERT_EQ(actual.size(), expected.size());
+
+    // The error of a symmetric quantization is at most half a step of the group maximum, 1/254 for int8 and 1/14
+    // for int4 of the [-1, 1) inputs, and the softmax averages it over the attended tokens.
+    const float tolerance = kv_cache_bit_width == 8 ? 0.02f : 0.15f;
+    for (size_t i = 0; i < expected.size(); i++) {
+      EXPECT_NEAR(actual[i], expected[i], tolerance) << "index " << i;
+    }
+  }
+}
+
+TEST(GroupQueryAttentionTest, QuantizedCachePrompt) {
+  RunQuantizedCacheTest<float>({2, 4, 0, 4, 2, 32});
+}
+
+TEST(GroupQueryAttentionTest, QuantizedCacheAppendToPast) {
+  RunQuantizedCacheTest<float>({2, 1, 6, 4, 2, 32});
+
+  // A subsequent prompt appends several tokens to the past.
+  RunQuantizedCacheTest<float>({1, 3, 6, 4, 2, 32});
+}
+
+TEST(GroupQueryAttentionTest, QuantizedCachePackedQKV) {
+  RunQuantizedCacheTest<float>({2, 4, 0, 4, 2, 32, true});
+  RunQuantizedCacheTest<float>({2, 1, 6, 4, 2, 32, true});
+}
+
+TEST(GroupQueryAttentionTest, QuantizedCacheLocalWindow) {
+  RunQuantizedCacheTest<float>({1, 8, 0, 4, 2, 32, false, 3});
+  RunQuantizedCacheTest<float>({2, 1, 9, 4, 2, 32, false, 4});
+}
+
+TEST(GroupQueryAttentionTest, QuantizedCacheGroupSize) {
+  RunQuantizedCacheTest<float>({2, 1, 6, 4, 2, 32, false, -1, 16});
+}
+
+TEST(GroupQueryAttentionTest, QuantizedCacheFloat16) {
+  RunQuantizedCacheTest<MLFloat16>({2, 4, 0, 4, 2, 32});
+  RunQuantizedCacheTest<MLFloat16>({2, 1, 6, 4, 2, 32, true, 4});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifndef ORT_MINIMAL_BUILD
+#include <optional>
+
+#include "gtest/gtest.h"
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct TestOptionsLowBits {
+  int64_t bits{2};
+  int64_t M{1};
+  int64_t N{1};
+  int64_t K{1};
+  int64_t block_size{32};
+  int64_t accuracy_level{0};
+
+  bool has_zero_point{false};
+  bool has_bias{false};
+  bool b_is_initializer{true};
+};
+
+[[maybe_unused]] std::ostream& operator<<(std::ostream& os, const TestOptionsLowBits& opts) {
+  return os << "bits:" << opts.bits << ", M:" << opts.M << ", N:" << opts.N << ", K:" << opts.K
+            << ", block_size:" << opts.block_size
+            << ", accuracy_level:" << opts.accuracy_level
+            << ", has_zero_point:" << opts.has_zero_point
+            << ", has_bias:" << opts.has_bias
+            << ", b_is_initializer:" << opts.b_is_initializer;
+}
+
+void SetBits(std::vector<uint8_t>& stream, int64_t bit_offset, int64_t bits, uint32_t value) {
+  for (int64_t i = 0; i < bits; i++) {
+    if ((value >> i) & 1) {
+      stream[(bit_offset + i) / 8] |= static_cast<uint8_t>(1u << ((bit_offset + i) % 8));
+    }
+  }
+}
+
+// MlasQuantizeBlockwise has no 3-bit support, so B is quantized here into the MatMulNBits layout:
+// each block of block_size values is a least significant bits first stream of `bits` bit values,
+// and the zero points of a column are packed the same way.
+void RunTestLowBits(const TestOptionsLowBits& opts) {
+  SCOPED_TRACE(opts);
+
+  const int64_t M = opts.M, N = opts.N, K = opts.K, bits = opts.bits;
+  const int64_t k_blocks = (K + opts.block_size - 1) / opts.block_size;
+  const int64_t blob_size = opts.block_size * bits / 8;
+  const int64_t zero_point_blob_size = (k_blocks * bits + 7) / 8;
+  const uint32_t max_value = (1u << bits) - 1;
+
+  RandomValueGenerator random{1234};
+  std::vector<float> a_vals(random.Gaussian<float>(AsSpan({M, K}), 0.0f, 0.25f));
+  std::vector<float> b_vals(random.Gaussian<float>(AsSpan({N, K}), 0.0f, 0.25f));
+
+  std::vector<uint8_t> b_quant(N * k_blocks * blob_size);
+  std::vector<float> scales(N * k_blocks);
+  std::vector<uint8_t> zero_points(N * zero_point_blob_size);
+  std::vector<float> b_dequant(N * K);
+
+  for (int64_t n = 0; n < N; n++) {
+    std::vector<uint8_t> column(k_blocks * blob_size);
+    std::vector<uint8_t> column_zp(zero_point_blob_size);
+    for (int64_t blk = 0; blk < k_blocks; blk++) {
+      const int64_t k0 = blk * opts.block_size;
+      const int64_t k1 = std::min(K, k0 + opts.block_size);
+      float min_val = 0.0f, max_val = 0.0f;
+      for (int64_t k = k0; k < k1; k++) {
+        min_val = std::min(min_val, b_vals[n * K + k]);
+        max_val = std::max(max_val, b_vals[n * K + k]);
+      }
+      uint32_t zp = 1u << (bits - 1);
+      float scale;
+      if (opts.has_zero_point) {
+        scale = (max_val - min_val) / static_cast<float>(max_value);
+        zp = static_cast<uint32_t>(std::clamp(std::roundf(-min_val / scale), 0.0f, static_cast<float>(max_value)));
+        SetBits(column_zp, blk * bits, bits, zp);
+      } else {
+        scale = std::max(std::fabs(min_val), std::fabs(max_val)) / static_cast<float>(zp);
+      }
+      scales[n * k_blocks + blk] = scale;
+      for (int64_t k = k0; k < k0 + opts.block_size; k++) {
+        uint32_t q = zp;
+        if (k < k1) {
+          q = static_cast<uint32_t>(std::clamp(std::roundf(b_vals[n * K + k] / scale) + static_cast<float>(zp),
+                                               0.0f, static_cast<float>(max_value)));
+          b_dequant[n * K + k] = (static_cast<float>(q) - static_cast<float>(zp)) * scale;
+        }
+        SetBits(column, k * bits, bits, q);
+      }
+    }
+    std::copy(column.begin(), column.end(), b_quant.begin() + n * k_blocks * blob_size);
+    std::copy(column_zp.begin(), column_zp.end(), zero_points.begin() + n * zero_point_blob_size);
+  }
+
+  const std::vector<int64_t> bias_shape = {N};
+  const auto bias = [&]() -> std::optional<std::vector<float>> {
+    if (opts.has_bias) {
+      return random.Uniform(bias_shape, 1.0f, 5.0f);
+    }
+    return std::nullopt;
+  }();
+
+  std::vector<float> expected_vals(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_vals[m * K + k] * b_dequant[n * K + k];
+      }
+      expected_vals[m * N + n] = sum + (bias.has_value() ? (*bias)[n] : 0.0f);
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", opts.block_size);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("accuracy_level", opts.accuracy_level);
+
+  test.AddInput<float>("A", {M, K}, a_vals, false);
+  test.AddInput<uint8_t>("B", {N, k_blocks, blob_size}, b_quant, opts.b_is_initializer);
+  test.AddInput<float>("scales", {N, k_blocks}, scales, true);
+  if (opts.has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N, zero_point_blob_size}, zero_points, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+  test.AddOptionalInputEdge<int32_t>();
+  if (bias.has_value()) {
+    test.AddInput<float>("bias", bias_shape, *bias, true);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+
+  test.AddOutput<float>("Y", {M, N}, expected_vals);
+
+  // The int8 compute type also quantizes A.
+  test.SetOutputAbsErr("Y", opts.accuracy_level == 4 ? 0.1f : 0.001f);
+  test.SetOutputRelErr("Y", opts.accuracy_level == 4 ? 0.02f : 0.001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers));
+  test.RunWithConfig();
+}
+
+void TestMatMulLowBits(int64_t bits, int64_t M, int64_t N, int64_t K, int64_t block_size, int64_t accuracy_level) {
+  for (bool has_zero_point : {false, true}) {
+    for (bool has_bias : {false, true}) {
+      TestOptionsLowBits opts{};
+      opts.bits = bits;
+      opts.M = M, opts.N = N, opts.K = K;
+      opts.block_size = block_size;
+      opts.accuracy_level = accuracy_level;
+      opts.has_zero_point = has_zero_point;
+      opts.has_bias = has_bias;
+      RunTestLowBits(opts);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(MatMulNBits, Float32_2b_3b_AccuracyLevel0) {
+  for (int64_t bits : {2, 3}) {
+    TestMatMulLowBits(bits, 1, 1, 16, 16, 0);
+    TestMatMulLowBits(bits, 1, 288, 1024, 128, 0);
+    TestMatMulLowBits(bits, 1, 40, 576, 32, 0);
+    TestMatMulLowBits(bits, 2, 40, 576, 32, 0);
+    TestMatMulLowBits(bits, 100, 288, 93, 32, 0);
+    TestMatMulLowBits(bits, 32, 64, 260, 64, 0);
+  }
+}
+
+TEST(MatMulNBits, Float32_2b_3b_AccuracyLevel4) {
+  for (int64_t bits : {2, 3}) {
+    TestMatMulLowBits(bits, 1, 1, 16, 16, 4);
+    TestMatMulLowBits(bits, 1, 288, 1024, 128, 4);
+    TestMatMulLowBits(bits, 2, 40, 576, 32, 4);
+    TestMatMulLowBits(bits, 100, 288, 93, 32, 4);
+    TestMatMulLowBits(bits, 32, 64, 260, 64, 4);
+  }
+}
+
+// A non-constant 2-bit B is dequantized to fp32 by the unpacked compute path.
+TEST(MatMulNBits, Float32_2b_NonConstantB) {
+  TestOptionsLowBits opts{};
+  opts.bits = 2;
+  opts.M = 3, opts.N = 40, opts.K = 96;
+  opts.block_size = 32;
+  opts.has_zero_point = true;
+  opts.b_is_initializer = false;
+  RunTestLowBits(opts);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // ORT_MINIMAL_BUILD
@@ -1,6 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -20,7 +25,8 @@ static void RunMoETest(const std::vector<float>& input, const std::vector<float>
   constexpr int max_cuda_arch = 900;
 
   bool enable_cuda = HasCudaEnvironment(min_cuda_arch) && !NeedSkipIfCudaArchGreaterEqualThan(max_cuda_arch);
-  if (enable_cuda) {
+  bool enable_cpu = !use_float16;
+  if (enable_cuda || enable_cpu) {
     OpTester tester("MoE", 1, onnxruntime::kMSDomain);
     tester.AddAttribute<int64_t>("k", static_cast<int64_t>(top_k));
     tester.AddAttribute<std::string>("activation_type", activation_type);
@@ -78,7 +84,12 @@ static void RunMoETest(const std::vector<float>& input, const std::vector<float>
     }
 
     std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
-    execution_providers.push_back(DefaultCudaExecutionProvider());
+    if (enable_cuda) {
+      execution_providers.push_back(DefaultCudaExecutionProvider());
+    }
+    if (enable_cpu) {
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+    }
     tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
 }
@@ -1270,6 +1281,288 @@ TEST(MoETest, QMoETest_Mixtral_Int4) {
               1, /*normalize_routing_weights*/
               2 /*top_k*/);
 }
+
+// Reference MoE on float weights. The weights of each expert are row major (K, N) matrices.
+static std::vector<float> ReferenceMoE(const std::vector<float>& input, const std::vector<float>& router_probs,
+                                       const std::vector<float>& fc1_weights, const std::vector<float>& fc1_bias,
+                                       const std::vector<float>& fc2_weights, const std::vector<float>& fc2_bias,
+                                       const std::vector<float>& fc3_weights, int num_rows, int num_experts,
+                                       int hidden_size, int inter_size, const std::string& activation_type,
+                                       bool normalize_routing_weights, int top_k) {
+  const bool is_swiglu = activation_type == "swiglu";
+  const int fc1_size = is_swiglu ? 2 * inter_size : inter_size;
+  std::vector<float> output(static_cast<size_t>(num_rows) * hidden_size, 0.0f);
+
+  for (int row = 0; row < num_rows; row++) {
+    const float* logits = router_probs.data() + row * num_experts;
+    const float max_logit = *std::max_element(logits, logits + num_experts);
+    std::vector<double> probs(num_experts);
+    double sum = 0.0;
+    for (int e = 0; e < num_experts; e++) {
+      probs[e] = std::exp(static_cast<double>(logits[e] - max_logit));
+      sum += probs[e];
+    }
+
+    std::vector<int> experts(num_experts);
+    std::iota(experts.begin(), experts.end(), 0);
+    std::stable_sort(experts.begin(), experts.end(), [&probs](int a, int b) { return probs[a] > probs[b]; });
+
+    double selected_sum = 0.0;
+    for (int k_idx = 0; k_idx < top_k; k_idx++) {
+      selected_sum += probs[experts[k_idx]];
+    }
+
+    for (int k_idx = 0; k_idx < top_k; k_idx++) {
+      const int e = experts[k_idx];
+      const double weight = probs[e] / (normalize_routing_weights ? selected_sum : sum);
+
+      std::vector<double> fc1(fc1_size);
+      for (int n = 0; n < fc1_size; n++) {
+        double value = fc1_bias.empty() ? 0.0 : fc1_bias[e * fc1_size + n];
+        for (int k = 0; k < hidden_size; k++) {
+          value += static_cast<double>(input[row * hidden_size + k]) *
+                   fc1_weights[(static_cast<size_t>(e) * hidden_size + k) * fc1_size + n];
+        }
+        fc1[n] = value;
+      }
+
+      std::vector<double> act(inter_size);
+      for (int n = 0; n < inter_size; n++) {
+        if (activation_type == "relu") {
+          act[n] = std::max(fc1[n], 0.0);
+        } else if (activation_type == "silu") {
+          act[n] = fc1[n] / (1.0 + std::exp(-fc1[n]));
+        } else if (activation_type == "swiglu") {
+          const double gate = fc1[2 * n];
+          act[n] = gate / (1.0 + std::exp(-1.702 * gate)) * (fc1[2 * n + 1] + 1.0);
+        } else {
+          act[n] = fc1[n];
+        }
+
+        if (!fc3_weights.empty()) {
+          double gate = 0.0;
+          for (int k = 0; k < hidden_size; k++) {
+            gate += static_cast<double>(input[row * hidden_size + k]) *
+                    fc3_weights[(static_cast<size_t>(e) * hidden_size + k) * inter_size + n];
+          }
+          act[n] *= gate;
+        }
+      }
+
+      for (int h = 0; h < hidden_size; h++) {
+        double value = fc2_bias.empty() ? 0.0 : fc2_bias[e * hidden_size + h];
+        for (int n = 0; n < inter_size; n++) {
+          value += act[n] * fc2_weights[(static_cast<size_t>(e) * inter_size + n) * hidden_size + h];
+        }
+        output[row * hidden_size + h] += static_cast<float>(weight * value);
+      }
+    }
+  }
+
+  return output;
+}
+
+static std::vector<float> RandomFloats(std::mt19937& generator, size_t count, float low, float high) {
+  std::uniform_real_distribution<float> distribution(low, high);
+  std::vector<float> values(count);
+  for (auto& v : values) {
+    v = distribution(generator);
+  }
+  return values;
+}
+
+static void RunMoECpuTest(int num_rows, int num_experts, int hidden_size, int inter_size,
+                          const std::string& activation_type, int top_k, int normalize_routing_weights,
+                          bool use_bias, bool use_fc3) {
+  std::mt19937 generator(static_cast<unsigned>(num_rows * 131 + num_experts * 17 + hidden_size));
+  const int fc1_size = activation_type == "swiglu" ? 2 * inter_size : inter_size;
+
+  const auto input = RandomFloats(generator, static_cast<size_t>(num_rows) * hidden_size, -1.0f, 1.0f);
+  const auto router_probs = RandomFloats(generator, static_cast<size_t>(num_rows) * num_experts, -2.0f, 2.0f);
+  const auto fc1_weights = RandomFloats(generator, static_cast<size_t>(num_experts) * hidden_size * fc1_size,
+                                        -0.2f, 0.2f);
+  const auto fc2_weights = RandomFloats(generator, static_cast<size_t>(num_experts) * inter_size * hidden_size,
+                                        -0.2f, 0.2f);
+  const auto fc3_weights = use_fc3 ? RandomFloats(generator, static_cast<size_t>(num_experts) * hidden_size *
+                                                                 inter_size,
+                                                  -0.2f, 0.2f)
+                                   : std::vector<float>{};
+  const auto fc1_bias = use_bias ? RandomFloats(generator, static_cast<size_t>(num_experts) * fc1_size, -0.1f, 0.1f)
+                                 : std::vector<float>{};
+  const auto fc2_bias = use_bias ? RandomFloats(generator, static_cast<size_t>(num_experts) * hidden_size,
+                                                -0.1f, 0.1f)
+                                 : std::vector<float>{};
+
+  const auto output = ReferenceMoE(input, router_probs, fc1_weights, fc1_bias, fc2_weights, fc2_bias, fc3_weights,
+                                   num_rows, num_experts, hidden_size, inter_size, activation_type,
+                                   normalize_routing_weights != 0, top_k);
+
+  OpTester tester("MoE", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("k", static_cast<int64_t>(top_k));
+  tester.AddAttribute<std::string>("activation_type", activation_type);
+  tester.AddAttribute<int64_t>("normalize_routing_weights", static_cast<int64_t>(normalize_routing_weights));
+
+  tester.AddInput<float>("input", {num_rows, hidden_size}, input);
+  tester.AddInput<float>("router_probs", {num_rows, num_experts}, router_probs);
+  tester.AddInput<float>("fc1_experts_weights", {num_experts, hidden_size, fc1_size}, fc1_weights);
+  if (use_bias) {
+    tester.AddInput<float>("fc1_experts_bias", {num_experts, fc1_size}, fc1_bias);
+  } else {
+    tester.AddOptionalInputEdge<float>();
+  }
+  tester.AddInput<float>("fc2_experts_weights", {num_experts, inter_size, hidden_size}, fc2_weights);
+  if (use_bias) {
+    tester.AddInput<float>("fc2_experts_bias", {num_experts, hidden_size}, fc2_bias);
+  } else {
+    tester.AddOptionalInputEdge<float>();
+  }
+  if (use_fc3) {
+    tester.AddInput<float>("fc3_experts_weights", {num_experts, hidden_size, inter_size}, fc3_weights);
+  }
+  tester.AddOutput<float>("output", {num_rows, hidden_size}, output);
+  tester.SetOutputTolerance(0.0005f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+// QMoE with the CPU weight layout: (K, N) unsigned values per expert with an implied zero point of 8 or 128 and one
+// scale per output column. Two 4 bit columns share a byte with the lower column in the low nibble.
+static void RunQMoECpuTest(int num_rows, int num_experts, int hidden_size, int inter_size,
+                           const std::string& activation_type, int top_k, int normalize_routing_weights,
+                           int expert_weight_bits, bool use_fc3, bool constant_weights,
+                           bool constant_fc2_weights = true) {
+  std::mt19937 generator(static_cast<unsigned>(num_rows * 131 + num_experts * 17 + hidden_size + expert_weight_bits));
+  const int fc1_size = activation_type == "swiglu" ? 2 * inter_size : inter_size;
+  const int pack = expert_weight_bits == 4 ? 2 : 1;
+  const int zero_point = expert_weight_bits == 4 ? 8 : 128;
+
+  // Returns the quantized weights and fills the dequantized values.
+  auto quantize = [&](int K, int N, const std::vector<float>& scales, std::vector<float>& dequantized) {
+    std::uniform_int_distribution<int> distribution(0, (1 << expert_weight_bits) - 1);
+    std::vector<uint8_t> quantized(static_cast<size_t>(num_experts) * K * N / pack, 0);
+    dequantized.resize(static_cast<size_t>(num_experts) * K * N);
+    for (int e = 0; e < num_experts; e++) {
+      for (int k = 0; k < K; k++) {
+        for (int n = 0; n < N; n++) {
+          const int q = distribution(generator);
+          const size_t index = (static_cast<size_t>(e) * K + k) * N + n;
+          if (expert_weight_bits == 4) {
+            quantized[index / 2] |= static_cast<uint8_t>(q << ((n & 1) * 4));
+          } else {
+            quantized[index] = static_cast<uint8_t>(q);
+          }
+          dequantized[index] = static_cast<float>(q - zero_point) * scales[e * N + n];
+        }
+      }
+    }
+    return quantized;
+  };
+
+  const float scale_max = expert_weight_bits == 4 ? 0.03f : 0.002f;
+  const auto input = RandomFloats(generator, static_cast<size_t>(num_rows) * hidden_size, -1.0f, 1.0f);
+  const auto router_probs = RandomFloats(generator, static_cast<size_t>(num_rows) * num_experts, -2.0f, 2.0f);
+  const auto fc1_scales = RandomFloats(generator, static_cast<size_t>(num_experts) * fc1_size, 0.01f, scale_max);
+  const auto fc2_scales = RandomFloats(generator, static_cast<size_t>(num_experts) * hidden_size, 0.01f, scale_max);
+  const auto fc3_scales = RandomFloats(generator, static_cast<size_t>(num_experts) * inter_size, 0.01f, scale_max);
+
+  std::vector<float> fc1_dequantized, fc2_dequantized, fc3_dequantized;
+  const auto fc1_weights = quantize(hidden_size, fc1_size, fc1_scales, fc1_dequantized);
+  const auto fc2_weights = quantize(inter_size, hidden_size, fc2_scales, fc2_dequantized);
+  const auto fc3_weights = quantize(hidden_size, inter_size, fc3_scales, fc3_dequantized);
+
+  const auto output = ReferenceMoE(input, router_probs, fc1_dequantized, {}, fc2_dequantized, {},
+                                   use_fc3 ? fc3_dequantized : std::vector<float>{}, num_rows, num_experts,
+                                   hidden_size, inter_size, activation_type, normalize_routing_weights != 0, top_k);
+
+  OpTester tester("QMoE", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("k", static_cast<int64_t>(top_k));
+  tester.AddAttribute<std::string>("activation_type", activation_type);
+  tester.AddAttribute<int64_t>("normalize_routing_weights", static_cast<int64_t>(normalize_routing_weights));
+  tester.AddAttribute<int64_t>("expert_weight_bits", static_cast<int64_t>(expert_weight_bits));
+
+  tester.AddInput<float>("input", {num_rows, hidden_size}, input);
+  tester.AddInput<float>("router_probs", {num_rows, num_experts}, router_probs);
+  tester.AddInput<uint8_t>("fc1_experts_weights", {num_experts, hidden_size, fc1_size / pack}, fc1_weights,
+                           constant_weights);
+  tester.AddInput<float>("fc1_scales", {num_experts, fc1_size}, fc1_scales, constant_weights);
+  tester.AddOptionalInputEdge<float>();  // fc1_experts_bias
+  tester.AddInput<uint8_t>("fc2_experts_weights", {num_experts, inter_size, hidden_size / pack}, fc2_weights,
+                           constant_weights && constant_fc2_weights);
+  tester.AddInput<float>("fc2_scales", {num_experts, hidden_size}, fc2_scales, constant_weights);
+  tester.AddOptionalInputEdge<float>();  // fc2_experts_bias
+  if (use_fc3) {
+    tester.AddInput<uint8_t>("fc3_experts_weights", {num_experts, hidden_size, inter_size / pack}, fc3_weights,
+                             constant_weights);
+    tester.AddInput<float>("fc3_scales", {num_experts, inter_size}, fc3_scales, constant_weights);
+  }
+  tester.AddOutput<float>("output", {num_rows, hidden_size}, output);
+  tester.SetOutputTolerance(0.001f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MoETest, MoETest_Cpu_SwiGLU_Bias) {
+  RunMoECpuTest(7, 4, 16, 24, "swiglu", 2, 1, /*use_bias*/ true, /*use_fc3*/ false);
+}
+
+TEST(MoETest, MoETest_Cpu_Relu_TopK) {
+  RunMoECpuTest(33, 8, 32, 48, "relu", 3, 0, /*use_bias*/ true, /*use_fc3*/ false);
+}
+
+TEST(MoETest, MoETest_Cpu_Silu_Fc3) {
+  RunMoECpuTest(1, 8, 64, 40, "silu", 2, 1, /*use_bias*/ false, /*use_fc3*/ true);
+}
+
+TEST(MoETest, QMoETest_Cpu_Int4) {
+  for (bool constant_weights : {true, false}) {
+    RunQMoECpuTest(9, 4, 64, 128, "silu", 2, 1, 4, /*use_fc3*/ true, constant_weights);
+    RunQMoECpuTest(1, 8, 96, 48, "swiglu", 2, 0, 4, /*use_fc3*/ false, constant_weights);
+    RunQMoECpuTest(17, 6, 40, 24, "relu", 1, 0, 4, /*use_fc3*/ false, constant_weights);
+  }
+}
+
+TEST(MoETest, QMoETest_Cpu_Int4_PartiallyConstant) {
+  // The constant weights are not packed when others are not constant, so that they are still available to Compute.
+  RunQMoECpuTest(9, 4, 64, 128, "silu", 2, 1, 4, /*use_fc3*/ true, /*constant_weights*/ true,
+                 /*constant_fc2_weights*/ false);
+}
+
+TEST(MoETest, QMoETest_Cpu_Int4_ExpertCountMismatch) {
+  // The packed weights have 4 experts, but router_probs has 2.
+  const int num_rows = 2, num_experts = 4, hidden_size = 32, inter_size = 32;
+  OpTester tester("QMoE", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("k", 1);
+  tester.AddAttribute<std::string>("activation_type", "relu");
+  tester.AddAttribute<int64_t>("expert_weight_bits", 4);
+
+  tester.AddInput<float>("input", {num_rows, hidden_size}, std::vector<float>(num_rows * hidden_size, 0.5f));
+  tester.AddInput<float>("router_probs", {num_rows, 2}, std::vector<float>(num_rows * 2, 1.0f));
+  tester.AddInput<uint8_t>("fc1_experts_weights", {num_experts, hidden_size, inter_size / 2},
+                           std::vector<uint8_t>(num_experts * hidden_size * inter_size / 2, 0x88), true);
+  tester.AddInput<float>("fc1_scales", {num_experts, inter_size}, std::vector<float>(num_experts * inter_size, 0.1f),
+                         true);
+  tester.AddOptionalInputEdge<float>();  // fc1_experts_bias
+  tester.AddInput<uint8_t>("fc2_experts_weights", {num_experts, inter_size, hidden_size / 2},
+                           std::vector<uint8_t>(num_experts * inter_size * hidden_size / 2, 0x88), true);
+  tester.AddInput<float>("fc2_scales", {num_experts, hidden_size}, std::vector<float>(num_experts * hidden_size, 0.1f),
+                         true);
+  tester.AddOutput<float>("output", {num_rows, hidden_size}, std::vector<float>(num_rows * hidden_size, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectFailure, "Expert parallelism is not supported on CPU", {}, nullptr,
+             &execution_providers);
+}
+
+TEST(MoETest, QMoETest_Cpu_Int8) {
+  for (bool constant_weights : {true, false}) {
+    RunQMoECpuTest(9, 4, 32, 64, "silu", 2, 1, 8, /*use_fc3*/ true, constant_weights);
+  }
+}
 #endif
 
 }  // namespace test
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <optional>
+
+#include "gtest/gtest.h"
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+void RunMultiLoRATest(int64_t batch_size, int64_t sequence_length, int64_t hidden_size, int64_t rank,
+                      int64_t output_size, int64_t num_adapters, const std::vector<int32_t>& adapter_ids,
+                      float scale, bool has_base, bool weights_are_initializers) {
+  RandomValueGenerator random{1234};
+  const bool is_3d = sequence_length > 0;
+  const int64_t num_rows = batch_size * (is_3d ? sequence_length : 1);
+
+  std::vector<int64_t> input_dims = {batch_size};
+  std::vector<int64_t> output_dims = {batch_size};
+  if (is_3d) {
+    input_dims.push_back(sequence_length);
+    output_dims.push_back(sequence_length);
+  }
+  input_dims.push_back(hidden_size);
+  output_dims.push_back(output_size);
+
+  std::vector<float> input(random.Gaussian<float>(AsSpan({num_rows, hidden_size}), 0.0f, 0.5f));
+  std::vector<float> lora_a(random.Gaussian<float>(AsSpan({num_adapters, hidden_size, rank}), 0.0f, 0.5f));
+  std::vector<float> lora_b(random.Gaussian<float>(AsSpan({num_adapters, rank, output_size}), 0.0f, 0.5f));
+  std::optional<std::vector<float>> base;
+  if (has_base) {
+    base = random.Uniform<float>(AsSpan({num_rows, output_size}), -1.0f, 1.0f);
+  }
+
+  std::vector<float> expected(num_rows * output_size, 0.0f);
+  for (int64_t row = 0; row < num_rows; row++) {
+    const int32_t id = adapter_ids[row / (num_rows / batch_size)];
+    for (int64_t n = 0; n < output_size; n++) {
+      float sum = 0.0f;
+      if (id >= 0) {
+        for (int64_t r = 0; r < rank; r++) {
+          float t = 0.0f;
+          for (int64_t k = 0; k < hidden_size; k++) {
+            t += input[row * hidden_size + k] * lora_a[(id * hidden_size + k) * rank + r];
+          }
+          sum += t * lora_b[(id * rank + r) * output_size + n];
+        }
+      }
+      expected[row * output_size + n] = scale * sum + (has_base ? (*base)[row * output_size + n] : 0.0f);
+    }
+  }
+
+  OpTester test("MultiLoRA", 1, kMSDomain);
+  test.AddAttribute<float>("scale", scale);
+  test.AddInput<float>("input", input_dims, input);
+  test.AddInput<float>("lora_a", {num_adapters, hidden_size, rank}, lora_a, weights_are_initializers);
+  test.AddInput<float>("lora_b", {num_adapters, rank, output_size}, lora_b, weights_are_initializers);
+  test.AddInput<int32_t>("adapter_ids", {batch_size}, adapter_ids);
+  if (has_base) {
+    test.AddInput<float>("base", output_dims, *base);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+  test.AddOutput<float>("output", output_dims, expected);
+  test.SetOutputAbsErr("output", 1e-4f);
+  test.SetOutputRelErr("output", 1e-4f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers));
+  test.RunWithConfig();
+}
+
+}  // namespace
+
+TEST(MultiLoRATest, PerRequestAdapters_2D) {
+  RunMultiLoRATest(6, 0, 32, 8, 48, 4, {3, 0, 1, 1, 2, 0}, 1.0f, true, true);
+  RunMultiLoRATest(5, 0, 20, 4, 7, 3, {-1, 2, 2, -1, 0}, 0.5f, false, false);
+}
+
+TEST(MultiLoRATest, PerRequestAdapters_3D) {
+  RunMultiLoRATest(4, 5, 64, 16, 40, 3, {2, 2, 0, 1}, 2.0f, true, true);
+  RunMultiLoRATest(3, 7, 17, 2, 33, 2, {1, -1, 0}, 1.0f, false, true);
+}
+
+TEST(MultiLoRATest, NoActiveAdapter) {
+  RunMultiLoRATest(2, 3, 16, 4, 16, 1, {-1, -1}, 1.0f, true, true);
+}
+
+TEST(MultiLoRATest, AdapterIdOutOfRange) {
+  OpTester test("MultiLoRA", 1, kMSDomain);
+  test.AddInput<float>("input", {1, 2}, {1.0f, 2.0f});
+  test.AddInput<float>("lora_a", {1, 2, 1}, {1.0f, 1.0f});
+  test.AddInput<float>("lora_b", {1, 1, 2}, {1.0f, 1.0f});
+  test.AddInput<int32_t>("adapter_ids", {1}, {1});
+  test.AddOptionalInputEdge<float>();
+  test.AddOutput<float>("output", {1, 2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is out of range", {kCudaExecutionProvider, kDmlExecutionProvider});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
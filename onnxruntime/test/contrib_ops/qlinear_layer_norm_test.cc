@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(QLinearLayerNormalizationTest, Int8WithBias) {
+  auto run_test = [](bool scale_and_bias_are_initializers) {
+    OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+    test.AddAttribute<int64_t>("axis", -1);
+    test.AddAttribute<float>("epsilon", 1e-5f);
+
+    std::vector<int64_t> dims = {2, 4};
+    test.AddInput<int8_t>("X", dims, {-20, 10, 35, -5, 100, 90, -60, 7});
+    test.AddInput<float>("X_scale", {}, {0.1f});
+    test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+    test.AddInput<uint8_t>("Scale", {4}, {30, 60, 90, 120}, scale_and_bias_are_initializers);
+    test.AddInput<float>("Scale_scale", {}, {0.02f}, scale_and_bias_are_initializers);
+    test.AddInput<uint8_t>("Scale_zero_point", {}, {50}, scale_and_bias_are_initializers);
+    test.AddInput<float>("Y_scale", {}, {0.02f});
+    test.AddInput<int8_t>("Y_zero_point", {}, {10});
+    test.AddInput<int32_t>("B", {4}, {100, -200, 0, 300}, scale_and_bias_are_initializers);
+    test.AddInput<float>("B_scale", {}, {0.001f}, scale_and_bias_are_initializers);
+    test.AddOutput<int8_t>("Y", dims, {40, 2, 69, -9, -5, 9, -48, -4});
+    test.Run();
+  };
+
+  run_test(false);
+  run_test(true);
+}
+
+TEST(QLinearLayerNormalizationTest, UInt8NoBias) {
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+
+  std::vector<int64_t> dims = {1, 2, 3};
+  test.AddInput<uint8_t>("X", dims, {128, 138, 148, 100, 200, 150});
+  test.AddInput<float>("X_scale", {}, {0.05f});
+  test.AddInput<uint8_t>("X_zero_point", {}, {128});
+  test.AddInput<int8_t>("Scale", {3}, {100, 100, 100}, true);
+  test.AddInput<float>("Scale_scale", {}, {0.01f}, true);
+  test.AddOptionalInputEdge<int8_t>();  // optional "Scale_zero_point" using default value here
+  test.AddInput<float>("Y_scale", {}, {0.01f});
+  test.AddInput<uint8_t>("Y_zero_point", {}, {128});
+  test.AddOutput<uint8_t>("Y", dims, {6, 128, 250, 6, 250, 128});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -95,6 +95,48 @@ TEST(QLinearLookupTableBasedOperatorTests, QLinearSigmoid_UInt8) {
   std::fesetround(origin_round_mode);
 }
 
+TEST(QLinearLookupTableBasedOperatorTests, QLinearGelu_Int8) {
+  OpTester test("QLinearGelu", 1, onnxruntime::kMSDomain);
+  float X_scale = 0.04f;
+  // int8_t X_zero_point = 0;
+  float Y_scale = 0.025f;
+  int8_t Y_zero_point = -100;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<int8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, -128, -110, -108, -100, -16, -17, -18, -1});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<int8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<int8_t>("Y", dims,
+                         {-100, -81, -80, -78, -76, 44, 46, 103, -100, -100, -100, -100, -107, -107, -107, -101});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
+TEST(QLinearLookupTableBasedOperatorTests, QLinearGelu_UInt8_Tanh) {
+  OpTester test("QLinearGelu", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("approximate", "tanh");
+  float X_scale = 0.04f;
+  uint8_t X_zero_point = 128;
+  float Y_scale = 0.03f;
+  uint8_t Y_zero_point = 20;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<uint8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, 128, 136, 137, 138, 216, 217, 218, 255});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddInput<uint8_t>("X_zero_point", {}, {X_zero_point});
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<uint8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<uint8_t>("Y", dims, {20, 20, 20, 20, 20, 17, 17, 19, 20, 27, 28, 29, 137, 139, 140, 189});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
 // NNAPI can only take 0 as Y_zero_point
 TEST(QLinearLookupTableBasedOperatorTests, QLinearSigmoid_UInt8_0_Y_ZP) {
   auto run_test = [](bool scales_and_zp_are_initializers) {
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ContribOpTest, ZipMapColumnar_StringLabels) {
+  OpTester test("ZipMapColumnar", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("classlabels_strings", {"class1", "class2", "class3"});
+  test.AddInput<float>("X", {2, 3}, {1.f, 0.f, 3.f, 44.f, 23.f, 11.f});
+  test.AddOutput<float>("Z", {2, 3}, {1.f, 0.f, 3.f, 44.f, 23.f, 11.f});
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
+TEST(ContribOpTest, ZipMapColumnar_Int64Labels1D) {
+  OpTester test("ZipMapColumnar", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<int64_t>>("classlabels_int64s", {10, 20, 30});
+  test.AddInput<float>("X", {3}, {1.f, 0.f, 3.f});
+  test.AddOutput<float>("Z", {1, 3}, {1.f, 0.f, 3.f});
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
+TEST(ContribOpTest, ZipMapColumnar_LabelCountMismatch) {
+  OpTester test("ZipMapColumnar", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<int64_t>>("classlabels_int64s", {10, 20});
+  test.AddInput<float>("X", {1, 3}, {1.f, 0.f, 3.f});
+  test.AddOutput<float>("Z", {1, 3}, {1.f, 0.f, 3.f});
+  test.ConfigEp(DefaultCpuExecutionProvider())
+      .Config(OpTester::ExpectResult::kExpectFailure, "number of classlabels")
+      .RunWithConfig();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
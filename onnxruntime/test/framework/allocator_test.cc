@@ -4,7 +4,13 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/allocator_utils.h"
+#include "core/framework/config_options.h"
+#include "core/framework/cpu_page_allocator.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
+#include "asserts.h"
 #include "test_utils.h"
 #include "gtest/gtest.h"
 
@@ -31,6 +37,91 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   cpu_arena->Free(bytes);
   // todo: test the used / max api.
 }
+
+TEST(AllocatorTest, CPUPageAllocatorTest) {
+  // explicit huge pages are usually not reserved on test machines, so those allocations test the fallback
+  for (auto huge_pages : {HugePageMode::kNone, HugePageMode::kTransparent, HugePageMode::kExplicit2MB}) {
+    CPUPageAllocatorOptions options;
+    options.huge_pages = huge_pages;
+    options.numa_node = 0;
+    CPUPageAllocator allocator(OrtMemoryInfo(CPU, OrtDeviceAllocator), options);
+
+    EXPECT_EQ(allocator.Alloc(0), nullptr);
+
+    for (size_t size : {size_t{100}, size_t{3} << 20}) {
+      auto* bytes = static_cast<uint8_t*>(allocator.Alloc(size));
+      ASSERT_NE(bytes, nullptr);
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(bytes) % MlasGetPreferredBufferAlignment(), 0u);
+      memset(bytes, 1, size);
+      EXPECT_EQ(bytes[size - 1], 1);
+      allocator.Free(bytes);
+    }
+
+    // the allocator unmaps what has not been freed when it is destroyed
+    ASSERT_NE(allocator.Alloc(4096), nullptr);
+  }
+}
+
+TEST(AllocatorTest, CPUPageAllocatorOptionsTest) {
+  CPUPageAllocatorOptions options;
+  ConfigOptions config_options;
+  ASSERT_STATUS_OK(CPUPageAllocatorOptions::FromConfigOptions(config_options, options));
+  EXPECT_FALSE(options.IsEnabled());
+
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsCpuAllocatorHugePages, "1"));
+  ASSERT_STATUS_OK(CPUPageAllocatorOptions::FromConfigOptions(config_options, options));
+  EXPECT_EQ(options.huge_pages, HugePageMode::kTransparent);
+  EXPECT_EQ(options.numa_node, -1);
+  EXPECT_TRUE(options.IsEnabled());
+
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsCpuAllocatorHugePages, "4"));
+  EXPECT_FALSE(CPUPageAllocatorOptions::FromConfigOptions(config_options, options).IsOK());
+
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsCpuAllocatorHugePages, "0"));
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsCpuAllocatorNumaNode, "abc"));
+  EXPECT_FALSE(CPUPageAllocatorOptions::FromConfigOptions(config_options, options).IsOK());
+
+  // the arena regions of the CPU execution provider are mapped by a CPUPageAllocator
+  CPUExecutionProviderInfo info;
+  info.page_allocator_options.huge_pages = HugePageMode::kTransparent;
+  auto cpu_allocator = CPUExecutionProvider(info).CreatePreferredAllocators()[0];
+  EXPECT_EQ(cpu_allocator->Info().alloc_type, OrtArenaAllocator);
+  auto* bytes = cpu_allocator->Alloc(1024);
+  ASSERT_NE(bytes, nullptr);
+  memset(bytes, -1, 1024);
+  cpu_allocator->Free(bytes);
+
+  // without an arena the options are ignored rather than mapping every tensor from the OS
+  info.create_arena = false;
+  cpu_allocator = CPUExecutionProvider(info).CreatePreferredAllocators()[0];
+  EXPECT_NE(dynamic_cast<CPUAllocator*>(cpu_allocator.get()), nullptr);
+}
+
+TEST(AllocatorTest, CPUPageAllocatorArenaConfigTest) {
+  CPUPageAllocatorOptions options;
+  OrtArenaCfg arena_cfg;
+  options.AdjustArenaConfig(arena_cfg);
+  EXPECT_EQ(arena_cfg.initial_chunk_size_bytes, -1);
+
+  options.huge_pages = HugePageMode::kExplicit1GB;
+  const size_t page_size = options.HugePageSize();
+  if (page_size == 0) {
+    GTEST_SKIP() << "Huge pages are not supported on this platform.";
+  }
+
+  // the regions fill whole huge pages, leaving room for the bytes that MapPages adds to every region
+  arena_cfg.initial_growth_chunk_size_bytes = static_cast<int>(3 * page_size / 2);
+  options.AdjustArenaConfig(arena_cfg);
+  EXPECT_LT(static_cast<size_t>(arena_cfg.initial_growth_chunk_size_bytes), page_size);
+  for (int64_t region_size : {int64_t{arena_cfg.initial_chunk_size_bytes},
+                              int64_t{arena_cfg.initial_growth_chunk_size_bytes},
+                              arena_cfg.max_power_of_two_extend_bytes,
+                              2 * int64_t{arena_cfg.initial_chunk_size_bytes}}) {
+    const size_t pages = (static_cast<size_t>(region_size) + MLAS_SYMM_QGEMM_BUF_OVERRUN + page_size - 1) / page_size;
+    EXPECT_LT(pages * page_size - static_cast<size_t>(region_size), size_t{1024});
+  }
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26400)
 #endif
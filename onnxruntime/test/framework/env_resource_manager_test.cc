@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "core/framework/allocator.h"
+#include "core/framework/bfc_arena.h"
+#include "core/framework/env_resource_manager.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/test_environment.h"
+
+namespace onnxruntime {
+namespace test {
+namespace {
+
+std::shared_ptr<BFCArena> CreateArena() {
+  return std::make_shared<BFCArena>(std::make_unique<CPUAllocator>(), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+}
+
+// Adds a region of the given size to the arena that has no memory in use.
+void GrowArena(BFCArena& arena, size_t bytes) {
+  arena.Free(arena.Alloc(bytes));
+}
+
+}  // namespace
+
+TEST(EnvResourceManagerTest, ParseResourcePriority) {
+  ResourcePriority priority = ResourcePriority::kNormal;
+  ASSERT_STATUS_OK(ParseResourcePriority("high", priority));
+  EXPECT_EQ(priority, ResourcePriority::kHigh);
+  ASSERT_STATUS_OK(ParseResourcePriority("low", priority));
+  EXPECT_EQ(priority, ResourcePriority::kLow);
+  EXPECT_STREQ(ResourcePriorityToString(priority), "low");
+  ASSERT_STATUS_NOT_OK(ParseResourcePriority("urgent", priority));
+}
+
+TEST(EnvResourceManagerTest, SharesThreadBudgetByPriority) {
+  EnvResourceManager manager;
+  auto high = manager.RegisterSession("high", ResourcePriority::kHigh, 8, {});
+  auto normal = manager.RegisterSession("normal", ResourcePriority::kNormal, 2, {});
+  auto low = manager.RegisterSession("low", ResourcePriority::kLow, 8, {});
+
+  {
+    // Without a budget the runs use their whole intra-op thread pool.
+    EnvResourceManager::RunScope high_run(*high);
+    EnvResourceManager::RunScope low_run(*low);
+    EXPECT_EQ(high->GetThreadGrant(), 0);
+    EXPECT_EQ(low->GetUsage().thread_grant, 8);
+  }
+
+  manager.SetLimits(8, 0);
+  {
+    // A run alone gets the whole budget.
+    EnvResourceManager::RunScope high_run(*high);
+    EXPECT_EQ(high->GetThreadGrant(), 0);
+
+    // The runs share the budget by the weights of their priority classes, 4 for high and 1 for low.
+    EnvResourceManager::RunScope low_run(*low);
+    EXPECT_EQ(high->GetThreadGrant(), 6);
+    EXPECT_EQ(low->GetThreadGrant(), 1);
+
+    // A share that is larger than the pool of the session does not limit it.
+    EnvResourceManager::RunScope normal_run(*normal);
+    EXPECT_EQ(high->GetThreadGrant(), 4);
+    EXPECT_EQ(normal->GetThreadGrant(), 0);
+    EXPECT_EQ(normal->GetUsage().thread_grant, 2);
+
+    // Each concurrent run of a session gets its own share, and a run always keeps its calling thread.
+    EnvResourceManager::RunScope second_high_run(*high);
+    EXPECT_EQ(high->GetThreadGrant(), 2);
+    EXPECT_EQ(high->GetUsage().active_runs, 2);
+    EXPECT_EQ(low->GetThreadGrant(), 1);
+  }
+
+  EnvResourceManager::RunScope low_run(*low);
+  EXPECT_EQ(low->GetThreadGrant(), 0);
+  EXPECT_EQ(high->GetUsage().active_runs, 0);
+}
+
+TEST(EnvResourceManagerTest, ReclaimsArenaMemoryAboveCap) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  constexpr int64_t kRegionBytes = 1 << 20;
+
+  auto low_arena = CreateArena();
+  auto high_arena = CreateArena();
+  auto shared_arena = CreateArena();
+
+  EnvResourceManager manager;
+  auto low = manager.RegisterSession("low", ResourcePriority::kLow, 1, {low_arena, shared_arena});
+  auto high = manager.RegisterSession("high", ResourcePriority::kHigh, 1, {high_arena, shared_arena});
+
+  void* in_use = high_arena->Alloc(kRegionBytes);
+  GrowArena(*low_arena, kRegionBytes);
+  GrowArena(*shared_arena, kRegionBytes);
+
+  // Without a cap the arenas keep their memory.
+  high->ReclaimArenaMemory(logger);
+  EXPECT_EQ(low->GetUsage().arena_bytes_reserved, 2 * kRegionBytes);
+  EXPECT_EQ(high->GetUsage().arena_bytes_in_use, kRegionBytes);
+
+  // The arenas reserve 3 regions as the shared one is counted once. The idle low priority session is reclaimed
+  // from first, and releasing one of its regions is enough.
+  manager.SetLimits(0, 2 * kRegionBytes);
+  {
+    EnvResourceManager::RunScope high_run(*high);
+    high->ReclaimArenaMemory(logger);
+  }
+
+  SessionResourceUsage low_usage = low->GetUsage();
+  EXPECT_EQ(low_usage.arena_bytes_reserved, kRegionBytes);
+  EXPECT_EQ(low_usage.arena_bytes_reclaimed, kRegionBytes);
+  EXPECT_EQ(high->GetUsage().arena_bytes_reserved, 2 * kRegionBytes);
+
+  // Memory in use is never released, so the arenas end up at the memory in use when the cap is below it.
+  manager.SetLimits(0, 1);
+  high->ReclaimArenaMemory(logger);
+
+  low_usage = low->GetUsage();
+  EXPECT_EQ(low_usage.arena_bytes_reserved, 0);
+  EXPECT_EQ(low_usage.arena_bytes_reclaimed, 2 * kRegionBytes);
+
+  const SessionResourceUsage high_usage = high->GetUsage();
+  EXPECT_EQ(high_usage.arena_bytes_reserved, kRegionBytes);
+  EXPECT_EQ(high_usage.arena_bytes_in_use, kRegionBytes);
+  EXPECT_EQ(high_usage.arena_bytes_reclaimed, 0);
+
+  high_arena->Free(in_use);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
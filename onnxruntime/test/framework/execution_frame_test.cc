@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -509,6 +510,109 @@ TEST(ExecutionFrameTestWithoutSessionState, BadModelInvalidDimParamUsage) {
   EXPECT_THAT(st.ErrorMessage(), testing::HasSubstr("Shape mismatch attempting to re-use buffer."));
 }
 
+// Test that the symbolic memory pattern generated by the first run is evaluated for other batch sizes.
+TEST(ExecutionFrameTestWithoutSessionState, SymbolicMemPatternTest) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 13;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto input_float;
+  input_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  input_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& input_def = graph.GetOrCreateNodeArg("X", &input_float);
+  auto& add_out_def = graph.GetOrCreateNodeArg("T1", &tensor_float);
+  auto& mul_out_def = graph.GetOrCreateNodeArg("T2", &tensor_float);
+  auto& output_def = graph.GetOrCreateNodeArg("Y", &tensor_float);
+
+  graph.AddNode("node1", "Add", "add", ArgMap{&input_def, &input_def}, ArgMap{&add_out_def});
+  graph.AddNode("node2", "Mul", "mul", ArgMap{&add_out_def, &add_out_def}, ArgMap{&mul_out_def});
+  graph.AddNode("node3", "Sub", "sub", ArgMap{&mul_out_def, &input_def}, ArgMap{&output_def});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized_model;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized_model));
+
+  SessionOptions so;
+  so.session_logid = "SymbolicMemPatternTest";
+  // keep T1 and T2 in separate blocks
+  so.enable_mem_reuse = false;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableSymbolicMemoryPattern, "1"));
+
+  InferenceSessionWrapper session(so, GetEnvironment());
+  ASSERT_STATUS_OK(session.Load(serialized_model.data(), static_cast<int>(serialized_model.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  const SessionState& state = session.GetSessionState();
+  ASSERT_TRUE(state.GetEnableMemoryPattern());
+  ASSERT_TRUE(state.GetEnableSymbolicMemoryPattern());
+  ASSERT_EQ(state.GetSymbolicMemoryPatternGroup(), nullptr);
+
+  auto create_input = [](int64_t batch, OrtValue& value) {
+    std::vector<float> values(static_cast<size_t>(batch * 4));
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i) * 0.5f;
+    }
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {batch, 4}, values, &value);
+  };
+
+  auto run = [&](int64_t batch) {
+    OrtValue x;
+    create_input(batch, x);
+    std::vector<OrtValue> fetches;
+    RunOptions run_options;
+    ASSERT_STATUS_OK(session.Run(run_options, AsSpan({std::string("X")}), AsSpan({x}),
+                                 AsSpan({std::string("Y")}), &fetches, nullptr));
+    ASSERT_EQ(fetches.size(), 1u);
+    auto x_values = x.Get<Tensor>().DataAsSpan<float>();
+    auto y_values = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y_values.size(), x_values.size());
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      EXPECT_FLOAT_EQ(y_values[i], 4.0f * x_values[i] * x_values[i] - x_values[i]);
+    }
+  };
+
+  run(2);
+
+  const SymbolicMemoryPatternGroup* group = state.GetSymbolicMemoryPatternGroup();
+  ASSERT_NE(group, nullptr);
+  ASSERT_EQ(group->NumDims(), 1u);
+
+  const OrtValueNameIdxMap& name_idx_map = state.GetOrtValueNameIdxMap();
+  int x_idx = -1, t1_idx = -1, t2_idx = -1;
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("X", x_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("T1", t1_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("T2", t2_idx));
+
+  for (int64_t batch : {1, 5, 100}) {
+    OrtValue x;
+    create_input(batch, x);
+    MemoryPatternGroup patterns;
+    ASSERT_STATUS_OK(group->Evaluate(AsSpan({x_idx}), AsSpan({x}), patterns));
+    ASSERT_EQ(patterns.patterns.size(), 1u);
+
+    // T1 and T2 are alive at the same time so they must not overlap
+    const size_t size = (static_cast<size_t>(batch * 4 * sizeof(float)) + kAllocAlignment - 1) /
+                        kAllocAlignment * kAllocAlignment;
+    const MemoryBlock* t1_block = patterns.patterns[0].GetBlock(t1_idx);
+    const MemoryBlock* t2_block = patterns.patterns[0].GetBlock(t2_idx);
+    ASSERT_NE(t1_block, nullptr);
+    ASSERT_NE(t2_block, nullptr);
+    EXPECT_EQ(t1_block->size_, size);
+    EXPECT_EQ(t2_block->size_, size);
+    EXPECT_TRUE(t1_block->offset_ >= t2_block->offset_ + size || t2_block->offset_ >= t1_block->offset_ + size);
+    EXPECT_EQ(patterns.patterns[0].PeakSize(), 2 * size);
+
+    run(batch);
+  }
+
+  // the group is generated once and used for all the batch sizes
+  EXPECT_EQ(state.GetSymbolicMemoryPatternGroup(), group);
+}
+
 // Test that when an initializer is a graph output it is handled correctly
 TEST(ExecutionFrameTestInit, InitializerAsOutput) {
   const std::vector<float> expected{
@@ -50,6 +50,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/shape_buckets.h"
 #include "dummy_provider.h"
 #include "test_utils.h"
 #include "test/capturing_sink.h"
@@ -1955,6 +1956,95 @@ TEST(InferenceSessionTests, Test2LayerNestedSubgraph) {
   VerifyOutputs(fetches, expected_dims, expected_values);
 }
 
+TEST(InferenceSessionTests, ShapeBuckets) {
+  onnxruntime::Model model("shape_buckets", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("seq");
+
+  ONNX_NAMESPACE::TensorProto scale;
+  scale.set_name("scale");
+  scale.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  scale.add_dims(1);
+  scale.add_float_data(2.0f);
+  graph.AddInitializedTensor(scale);
+
+  auto& input = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& scale_arg = graph.GetOrCreateNodeArg("scale", nullptr);
+  auto& output = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  std::vector<onnxruntime::NodeArg*> inputs = {&input, &scale_arg};
+  std::vector<onnxruntime::NodeArg*> outputs = {&output};
+  graph.AddNode("mul", "Mul", "scale the input", inputs, outputs);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  PathString model_file_name = ORT_TSTR("shape_buckets_test.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ShapeBuckets";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShapeBuckets, "seq:4,8"));
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = so.session_logid;
+  std::vector<std::string> output_names = {"Y"};
+
+  // 3 is padded to the bucket of 4, 8 is the bucket of 8, and 10 doesn't fit into a bucket
+  for (int64_t seq : {int64_t{3}, int64_t{8}, int64_t{10}}) {
+    std::vector<int64_t> dims = {2, seq};
+    std::vector<float> values(static_cast<size_t>(2 * seq));
+    std::vector<float> expected_values(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = static_cast<float>(i + 1);
+      expected_values[i] = 2.0f * values[i];
+    }
+
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &ml_value);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value));
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, expected_values);
+  }
+
+  // Shape buckets are ignored when an execution provider other than the CPU one is registered.
+  {
+    InferenceSession session_with_other_ep{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_with_other_ep.RegisterExecutionProvider(std::make_unique<DummyExecutionProvider>()));
+    ASSERT_STATUS_OK(session_with_other_ep.Load(model_file_name));
+    ASSERT_STATUS_OK(session_with_other_ep.Initialize());
+
+    std::vector<int64_t> dims = {1, 3};
+    std::vector<float> values = {1.0f, 2.0f, 3.0f};
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, values, &ml_value);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value));
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_with_other_ep.Run(run_options, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, {2.0f, 4.0f, 6.0f});
+  }
+
+  ShapeBuckets buckets;
+  ASSERT_STATUS_OK(ShapeBuckets::Parse("seq:8,4;batch:1", buckets));
+  ASSERT_EQ(buckets.NumBuckets(), 2u);
+  size_t bucket = 0;
+  ASSERT_TRUE(buckets.FindBucket(std::vector<int64_t>{5, 1}, bucket));
+  EXPECT_EQ(bucket, 1u);
+  EXPECT_EQ(buckets.BucketSizes(bucket)[0], 8);
+  EXPECT_FALSE(buckets.FindBucket(std::vector<int64_t>{9, 1}, bucket));
+  EXPECT_FALSE(ShapeBuckets::Parse("seq:0", buckets).IsOK());
+}
+
 TEST(InferenceSessionTests, TestTruncatedSequence) {
   // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
   // Manually updated to have IR version of 4.
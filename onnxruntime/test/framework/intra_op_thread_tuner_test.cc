@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#include "core/framework/intra_op_thread_tuner.h"
+#include "test/util/include/test_environment.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/temp_dir.h"
+
+using namespace std::chrono_literals;
+
+namespace onnxruntime {
+namespace test {
+namespace {
+
+// Runs a node until it is tuned, with the latency of each thread count taken from the given map.
+int Tune(IntraOpThreadTuner& tuner, const std::string& key, const std::map<int, std::chrono::nanoseconds>& latencies,
+         int max_runs = 100) {
+  for (int run = 0; run < max_runs && tuner.GetTunedThreadCount(key) == 0; ++run) {
+    const int thread_count = tuner.GetThreadCount(key);
+    tuner.ReportLatency(key, thread_count, latencies.at(thread_count));
+  }
+  return tuner.GetTunedThreadCount(key);
+}
+
+}  // namespace
+
+TEST(IntraOpThreadTunerTest, KeepsAllThreadsForScalingNodes) {
+  IntraOpThreadTuner tuner(8, 3);
+  EXPECT_EQ(tuner.GetThreadCount("node"), 8);
+  EXPECT_EQ(Tune(tuner, "node", {{8, 100us}, {4, 190us}, {2, 380us}, {1, 750us}}), 8);
+}
+
+TEST(IntraOpThreadTunerTest, PicksFewestThreadsWithinTolerance) {
+  IntraOpThreadTuner tuner(8, 3, 0.05);
+  EXPECT_EQ(Tune(tuner, "small", {{8, 50us}, {4, 30us}, {2, 20us}, {1, 10us}}), 1);
+  EXPECT_EQ(Tune(tuner, "medium", {{8, 100us}, {4, 103us}, {2, 160us}, {1, 300us}}), 4);
+
+  // Nodes are tuned independently of each other.
+  EXPECT_EQ(tuner.GetTunedThreadCount("small"), 1);
+  EXPECT_EQ(tuner.GetTunedThreadCount("unknown"), 0);
+}
+
+TEST(IntraOpThreadTunerTest, IgnoresWarmupAndStaleRuns) {
+  IntraOpThreadTuner tuner(2, 1);
+  ASSERT_EQ(tuner.GetThreadCount("node"), 2);
+
+  // The warm-up run of the first candidate is not a sample, however slow it is.
+  tuner.ReportLatency("node", 2, 10ms);
+  tuner.ReportLatency("node", 2, 10us);
+  ASSERT_EQ(tuner.GetThreadCount("node"), 1);
+
+  // A run that started with the previous candidate does not count for the current one.
+  tuner.ReportLatency("node", 2, 1us);
+  tuner.ReportLatency("node", 1, 5us);
+  tuner.ReportLatency("node", 1, 20us);
+  EXPECT_EQ(tuner.GetTunedThreadCount("node"), 2);
+}
+
+TEST(IntraOpThreadTunerTest, BoundsTheNumberOfEntries) {
+  IntraOpThreadTuner tuner(4, 1, 0.05, 2);
+  ASSERT_EQ(Tune(tuner, "node|10", {{4, 30us}, {2, 10us}, {1, 20us}}), 2);
+  ASSERT_EQ(tuner.GetThreadCount("node|11"), 4);
+
+  // Nodes and shape buckets beyond the maximum are not tuned and keep all threads.
+  EXPECT_EQ(tuner.GetThreadCount("node|12"), 4);
+  EXPECT_EQ(tuner.ReportLatency("node|12", 4, 10us), 4);
+  EXPECT_EQ(tuner.GetTunedThreadCount("node|12"), 0);
+
+  // The entries that are tracked still finish tuning.
+  EXPECT_EQ(tuner.ReportLatency("node|11", 4, 10us), 0);
+  EXPECT_EQ(Tune(tuner, "node|11", {{4, 10us}, {2, 30us}}), 4);
+}
+
+TEST(IntraOpThreadTunerTest, SaveAndLoad) {
+  TemporaryDirectory tmp_dir(ORT_TSTR("intra_op_thread_tuner_test_dir"));
+  const std::filesystem::path file_path = std::filesystem::path(tmp_dir.Path()) / "tuning.json";
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+
+  {
+    IntraOpThreadTuner tuner(4, 1);
+    ASSERT_STATUS_OK(tuner.SaveIfUpdated(file_path));
+    ASSERT_FALSE(std::filesystem::exists(file_path));
+
+    ASSERT_EQ(Tune(tuner, "node", {{4, 30us}, {2, 10us}, {1, 20us}}), 2);
+    ASSERT_STATUS_OK(tuner.SaveIfUpdated(file_path));
+    ASSERT_TRUE(std::filesystem::exists(file_path));
+
+    // The results are written to a temporary file that is renamed over the results file.
+    std::filesystem::path temp_file_path = file_path;
+    temp_file_path += ".tmp";
+    ASSERT_FALSE(std::filesystem::exists(temp_file_path));
+  }
+
+  {
+    IntraOpThreadTuner tuner(4);
+    ASSERT_STATUS_OK(tuner.Load(file_path, logger));
+    EXPECT_EQ(tuner.GetTunedThreadCount("node"), 2);
+    EXPECT_EQ(tuner.GetThreadCount("node"), 2);
+  }
+
+  {
+    // Results tuned for another pool size are ignored.
+    IntraOpThreadTuner tuner(8);
+    ASSERT_STATUS_OK(tuner.Load(file_path, logger));
+    EXPECT_EQ(tuner.GetTunedThreadCount("node"), 0);
+  }
+
+  {
+    // A missing file means the nodes are tuned from scratch, while a malformed one is an error.
+    IntraOpThreadTuner tuner(4);
+    ASSERT_STATUS_OK(tuner.Load(std::filesystem::path(tmp_dir.Path()) / "missing.json", logger));
+
+    std::ofstream(file_path) << "{\"ep\": ";
+    ASSERT_STATUS_NOT_OK(tuner.Load(file_path, logger));
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
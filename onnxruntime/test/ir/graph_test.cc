@@ -8,6 +8,9 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/graph/op.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -499,6 +502,34 @@ TEST_F(GraphTest, FunctionOpsetImportTest) {
   }
 }
 
+// Tests that loading a model with a thread pool, which constructs the function schemas, checks the nodes and resolves
+// the subgraphs in parallel, gives the same graph as loading it on the calling thread.
+TEST_F(GraphTest, LoadWithThreadPool) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 4;
+  auto tp = concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+
+  for (const auto* model_path : {ORT_TSTR("testdata/function_opset_test.onnx"),
+                                 ORT_TSTR("testdata/three_layer_nested_subgraph.onnx")}) {
+    std::shared_ptr<Model> sequential_model;
+    ASSERT_STATUS_OK(Model::Load(model_path, sequential_model, nullptr, *logger_));
+
+    ModelOptions options;
+    options.thread_pool = tp.get();
+    std::shared_ptr<Model> parallel_model;
+    ASSERT_STATUS_OK(Model::Load(model_path, parallel_model, nullptr, *logger_, options));
+
+    GraphViewer sequential_viewer(sequential_model->MainGraph());
+    GraphViewer parallel_viewer(parallel_model->MainGraph());
+    ASSERT_EQ(sequential_viewer.GetNodesInTopologicalOrder(), parallel_viewer.GetNodesInTopologicalOrder());
+    ASSERT_EQ(sequential_model->GetModelLocalFunctionTemplates().size(),
+              parallel_model->GetModelLocalFunctionTemplates().size());
+    for (const auto& node : parallel_model->MainGraph().Nodes()) {
+      ASSERT_EQ(node.GetSubgraphs().size(), sequential_model->MainGraph().GetNode(node.Index())->GetSubgraphs().size());
+    }
+  }
+}
+
 TEST_F(GraphTest, LocalCustomRegistryWrongOpsetImportVersion) {
   std::shared_ptr<onnxruntime::OnnxRuntimeOpSchemaRegistry> registry = std::make_shared<OnnxRuntimeOpSchemaRegistry>();
   std::vector<ONNX_NAMESPACE::OpSchema> schema = {
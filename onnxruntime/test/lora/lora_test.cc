@@ -12,7 +12,10 @@
 #include "lora/adapter_format_utils.h"
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <unordered_map>
 
 #include "test/util/include/asserts.h"
 
@@ -199,6 +202,89 @@ TEST(LoraAdapterTest, Load) {
   }
 }
 
+TEST(LoraAdapterTest, Stack) {
+  constexpr size_t num_adapters = 3;
+  std::vector<lora::LoraAdapter> sources(num_adapters);
+  InlinedVector<const lora::LoraAdapter*> source_ptrs;
+  for (auto& source : sources) {
+    source.Load(GenerateTestParameters<float>()());
+    source_ptrs.push_back(&source);
+  }
+
+  lora::LoraAdapter stacked;
+  stacked.Stack(source_ptrs);
+  ASSERT_EQ(kAdapterVersion, stacked.AdapterVersion());
+  ASSERT_EQ(kModelVersion, stacked.ModelVersion());
+  ASSERT_EQ(sources[0].GetParamNum(), stacked.GetParamNum());
+
+  auto [begin, end] = stacked.GetParamIterators();
+  for (; begin != end; ++begin) {
+    const auto& tensor = begin->second.GetMapped().Get<Tensor>();
+    const auto shape = tensor.Shape().GetDims();
+    ASSERT_EQ(3U, shape.size());
+    ASSERT_EQ(static_cast<int64_t>(num_adapters), shape[0]);
+    ASSERT_EQ(param_shape[0], shape[1]);
+    ASSERT_EQ(param_shape[1], shape[2]);
+
+    // Every slice holds the parameter of the source adapter at that index.
+    const auto data = tensor.DataAsSpan<float>();
+    const size_t slice_size = static_cast<size_t>(param_shape[0] * param_shape[1]);
+    for (size_t i = 0; i < num_adapters; ++i) {
+      auto [src_begin, src_end] = sources[i].GetParamIterators();
+      auto hit = std::find_if(src_begin, src_end, [&](const auto& p) { return p.first == begin->first; });
+      ASSERT_NE(hit, src_end);
+      const auto expected = hit->second.GetMapped().Get<Tensor>().DataAsSpan<float>();
+      ASSERT_TRUE(std::equal(expected.begin(), expected.end(), data.begin() + i * slice_size));
+    }
+  }
+}
+
+TEST(LoraAdapterTest, StackSingleAdapterReferencesIt) {
+  auto source = std::make_unique<lora::LoraAdapter>();
+  source->Load(GenerateTestParameters<float>()());
+  InlinedVector<const lora::LoraAdapter*> source_ptrs = {source.get()};
+
+  lora::LoraAdapter stacked;
+  stacked.Stack(source_ptrs);
+  ASSERT_EQ(source->GetParamNum(), stacked.GetParamNum());
+
+  std::unordered_map<std::string, std::vector<float>> expected_values;
+  auto [src_begin, src_end] = source->GetParamIterators();
+  for (; src_begin != src_end; ++src_begin) {
+    const auto& tensor = src_begin->second.GetMapped().Get<Tensor>();
+    const auto data = tensor.DataAsSpan<float>();
+    expected_values.emplace(src_begin->first, std::vector<float>(data.begin(), data.end()));
+
+    // The stacked parameter is a view of the parameter of the source rather than a copy.
+    auto [begin, end] = stacked.GetParamIterators();
+    auto hit = std::find_if(begin, end, [&](const auto& p) { return p.first == src_begin->first; });
+    ASSERT_NE(hit, end);
+    const auto& stacked_tensor = hit->second.GetMapped().Get<Tensor>();
+    ASSERT_EQ(tensor.DataRaw(), stacked_tensor.DataRaw());
+    ASSERT_EQ(1, stacked_tensor.Shape()[0]);
+  }
+
+  // The stacked adapter keeps the memory of the source alive.
+  source.reset();
+  auto [begin, end] = stacked.GetParamIterators();
+  for (; begin != end; ++begin) {
+    const auto data = begin->second.GetMapped().Get<Tensor>().DataAsSpan<float>();
+    const auto& expected = expected_values.at(begin->first);
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), data.begin(), data.end()));
+  }
+}
+
+TEST(LoraAdapterTest, StackMismatchedParameters) {
+  lora::LoraAdapter float_adapter;
+  float_adapter.Load(GenerateTestParameters<float>()());
+  lora::LoraAdapter int_adapter;
+  int_adapter.Load(GenerateTestParameters<int32_t>()());
+
+  InlinedVector<const lora::LoraAdapter*> source_ptrs = {&float_adapter, &int_adapter};
+  lora::LoraAdapter stacked;
+  ASSERT_THROW(stacked.Stack(source_ptrs), OnnxRuntimeException);
+}
+
 #ifdef USE_CUDA
 TEST(LoraAdapterTest, VerifyDeviceCopy) {
   auto cpu_ep = DefaultCpuExecutionProvider();
@@ -31,10 +31,18 @@ void RunQNBitGemmBenchmark(size_t BlkLen,
   }
 
   size_t QuantBDataSizeInBytes, QuantBScaleSize, QuantBZeroPointSizeInBytes;
-  MlasBlockwiseQuantizedBufferSizes<BlkBitWidth>(
-      static_cast<int>(BlkLen), /* columnwise */ true,
-      static_cast<int>(K), static_cast<int>(N),
-      QuantBDataSizeInBytes, QuantBScaleSize, &QuantBZeroPointSizeInBytes);
+  if constexpr (BlkBitWidth == 3) {
+    // MlasQuantizeBlockwise has no 3-bit support, so the 3-bit benchmark runs on random quantized data.
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    QuantBDataSizeInBytes = N * BlockCountK * BlkLen * BlkBitWidth / 8;
+    QuantBScaleSize = N * BlockCountK;
+    QuantBZeroPointSizeInBytes = N * ((BlockCountK * BlkBitWidth + 7) / 8);
+  } else {
+    MlasBlockwiseQuantizedBufferSizes<BlkBitWidth>(
+        static_cast<int>(BlkLen), /* columnwise */ true,
+        static_cast<int>(K), static_cast<int>(N),
+        QuantBDataSizeInBytes, QuantBScaleSize, &QuantBZeroPointSizeInBytes);
+  }
 
   OrtThreadPoolParams tpo;
   tpo.thread_pool_size = static_cast<int>(Threads);
@@ -56,11 +64,19 @@ void RunQNBitGemmBenchmark(size_t BlkLen,
   std::vector<uint8_t> QuantBZeroPoint(Symmetric ? 0 : QuantBZeroPointSizeInBytes);
   bool has_zp_input = !Symmetric;
 
-  MlasQuantizeBlockwise<AType, BlkBitWidth>(QuantBData.data(), QuantBScale.data(),
-                                            Symmetric ? nullptr : QuantBZeroPoint.data(),
-                                            B.data(), static_cast<int>(BlkLen), /* columnwise */ true,
-                                            static_cast<int>(K), static_cast<int>(N), static_cast<int>(N),
-                                            tp.get());
+  if constexpr (BlkBitWidth == 3) {
+    QuantBData = RandomVectorUniform(QuantBDataSizeInBytes, uint8_t{0}, uint8_t{255});
+    if (!Symmetric) {
+      QuantBZeroPoint = RandomVectorUniform(QuantBZeroPointSizeInBytes, uint8_t{0}, uint8_t{255});
+    }
+    QuantBScale = RandomVectorUniform(QuantBScaleSize, AType(0.01f), AType(0.1f));
+  } else {
+    MlasQuantizeBlockwise<AType, BlkBitWidth>(QuantBData.data(), QuantBScale.data(),
+                                              Symmetric ? nullptr : QuantBZeroPoint.data(),
+                                              B.data(), static_cast<int>(BlkLen), /* columnwise */ true,
+                                              static_cast<int>(K), static_cast<int>(N), static_cast<int>(N),
+                                              tp.get());
+  }
 
   std::unique_ptr<std::byte[]> Workspace;
   if (const auto WorkspaceSize = MlasQNBitGemmBatchWorkspaceSize(M, N, K, 1, BlkBitWidth, BlkLen, !Symmetric, ComputeType);
@@ -136,6 +152,8 @@ static void QNBitGemmArgs(benchmark::internal::Benchmark* b) {
 
 BENCHMARK(QNBITGEMM<float, 4>)->Apply(QNBitGemmArgs<float>)->UseRealTime();
 BENCHMARK(QNBITGEMM<float, 8>)->Apply(QNBitGemmArgs<float>)->UseRealTime();
+BENCHMARK(QNBITGEMM<float, 2>)->Apply(QNBitGemmArgs<float>)->UseRealTime();
+BENCHMARK(QNBITGEMM<float, 3>)->Apply(QNBitGemmArgs<float>)->UseRealTime();
 BENCHMARK(QNBITGEMM<MLAS_FP16, 4>)->Apply(QNBitGemmArgs<MLAS_FP16>)->UseRealTime();
 
 // This test gets benchmark arguments from environment variables.
@@ -135,3 +135,79 @@ static void GemmLLMSizeProducts(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SGEMM, LLM, false, false, true)->Apply(GemmLLMSizeProducts)->UseRealTime();
+
+static const std::vector<std::string> sgemm_grouped_bench_arg_names = {"Batch", "M", "N", "K", "Grouped", "SharedB"};
+
+//
+// A batch of small multiplications, either computed by one grouped SGEMM or by
+// one threaded SGEMM after another. Every other problem of the batch has half
+// the rows to exercise the cross-problem scheduling of different shapes.
+//
+void SGEMM_GROUPED(benchmark::State& state) {
+  const size_t batch = static_cast<size_t>(state.range(0));
+  const size_t M = static_cast<size_t>(state.range(1));
+  const size_t N = static_cast<size_t>(state.range(2));
+  const size_t K = static_cast<size_t>(state.range(3));
+  const bool grouped = state.range(4) != 0;
+  const bool shared_b = state.range(5) != 0;
+  if (batch == 0 || M < 2 || N == 0 || K == 0) throw std::invalid_argument("Invalid grouped SGEMM arguments!");
+
+  auto A = RandomVectorUniform(M * K * batch, -1.0f, 1.0f);
+  auto B = RandomVectorUniform(N * K * (shared_b ? 1 : batch), -1.0f, 1.0f);
+  std::vector<float> C(M * N * batch);
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 8;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  // Split the batch into a group of full height problems and one of half height problems.
+  const size_t full_count = (batch + 1) / 2;
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(batch);
+  for (size_t i = 0; i < batch; i++) {
+    const size_t problem = (i < full_count) ? i * 2 : (i - full_count) * 2 + 1;
+    data[i].A = A.data() + M * K * problem;
+    data[i].lda = K;
+    data[i].B = B.data() + (shared_b ? 0 : N * K * problem);
+    data[i].ldb = N;
+    data[i].C = C.data() + M * N * problem;
+    data[i].ldc = N;
+  }
+
+  MLAS_SGEMM_GROUP_PARAMS groups[2];
+  groups[0].M = M;
+  groups[0].N = N;
+  groups[0].K = K;
+  groups[0].Data = data.data();
+  groups[0].BatchSize = full_count;
+  groups[1] = groups[0];
+  groups[1].M = M / 2;
+  groups[1].Data = data.data() + full_count;
+  groups[1].BatchSize = batch - full_count;
+
+  auto run = [&]() {
+    if (grouped) {
+      MlasGemmGrouped(groups, 2, tp.get());
+    } else {
+      for (const auto& group : groups) {
+        for (size_t i = 0; i < group.BatchSize; i++) {
+          MlasGemm(CblasNoTrans, CblasNoTrans, group.M, N, K, group.Data[i], tp.get());
+        }
+      }
+    }
+  };
+
+  run();
+  for (auto _ : state) {
+    run();
+  }
+}
+
+static void GemmGroupedSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sgemm_grouped_bench_arg_names);
+  b->ArgsProduct({{16, 64, 256}, {16, 64}, {16, 64}, {64, 256}, {0, 1}, {0, 1}});
+}
+
+BENCHMARK(SGEMM_GROUPED)->Apply(GemmGroupedSizes)->UseRealTime();
@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasKvCacheQuantTest : public MlasTestBase {
+ private:
+  static size_t RowBytes(size_t HeadSize, size_t BitWidth) {
+    return BitWidth == 8 ? HeadSize : HeadSize / 2;
+  }
+
+  static float Dequantize(const std::vector<uint8_t>& Cache, const std::vector<float>& Scales, size_t t, size_t i,
+                          size_t HeadSize, size_t GroupSize, size_t BitWidth) {
+    const uint8_t* row = Cache.data() + t * RowBytes(HeadSize, BitWidth);
+    int32_t q;
+    if (BitWidth == 8) {
+      q = static_cast<int8_t>(row[i]);
+    } else {
+      q = int32_t((i % 2 == 0) ? (row[i / 2] & 0x0F) : (row[i / 2] >> 4)) - 8;
+    }
+    return float(q) * Scales[t * (HeadSize / GroupSize) + i / GroupSize];
+  }
+
+  // Runs one decode step of attention over TokenCount cached tokens against a quantized
+  // cache and checks the kernels against the dequantized cache exactly, and against the
+  // unquantized cache within the error expected for the bit width.
+  void Test(size_t TokenCount, size_t HeadSize, size_t GroupSize, size_t BitWidth) {
+    std::default_random_engine generator(static_cast<unsigned>(TokenCount * 131 + HeadSize * 7 + GroupSize + BitWidth));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> Query(HeadSize);
+    std::vector<float> Key(TokenCount * HeadSize);
+    std::vector<float> Value(TokenCount * HeadSize);
+    for (auto& v : Query) v = distribution(generator);
+    for (auto& v : Key) v = distribution(generator);
+    for (auto& v : Value) v = distribution(generator);
+
+    const size_t ScaleCount = TokenCount * (HeadSize / GroupSize);
+    std::vector<uint8_t> KeyCache(TokenCount * RowBytes(HeadSize, BitWidth));
+    std::vector<uint8_t> ValueCache(TokenCount * RowBytes(HeadSize, BitWidth));
+    std::vector<float> KeyScales(ScaleCount);
+    std::vector<float> ValueScales(ScaleCount);
+
+    MlasQuantizeKvCache(Key.data(), TokenCount, HeadSize, GroupSize, BitWidth, KeyCache.data(), KeyScales.data());
+    MlasQuantizeKvCache(Value.data(), TokenCount, HeadSize, GroupSize, BitWidth, ValueCache.data(),
+                        ValueScales.data());
+
+    // The round trip error is bounded by half a quantization step.
+    for (size_t t = 0; t < TokenCount; t++) {
+      for (size_t i = 0; i < HeadSize; i++) {
+        const float step = KeyScales[t * (HeadSize / GroupSize) + i / GroupSize];
+        const float dequantized = Dequantize(KeyCache, KeyScales, t, i, HeadSize, GroupSize, BitWidth);
+        ASSERT_LE(std::fabs(dequantized - Key[t * HeadSize + i]), step * 0.5f + 1e-6f)
+            << "Quantize bits=" << BitWidth << " G=" << GroupSize << " @" << t << "," << i;
+      }
+    }
+
+    const float Alpha = 1.0f / std::sqrt(float(HeadSize));
+
+    std::vector<float> Scores(TokenCount);
+    MlasKvCacheQKDot(Query.data(), KeyCache.data(), KeyScales.data(), TokenCount, HeadSize, GroupSize, BitWidth,
+                     Alpha, Scores.data());
+
+    std::vector<double> ScoresExact(TokenCount);
+    std::vector<double> ScoresFloat(TokenCount);
+    for (size_t t = 0; t < TokenCount; t++) {
+      double exact = 0.0;
+      double reference = 0.0;
+      for (size_t i = 0; i < HeadSize; i++) {
+        exact += double(Query[i]) * Dequantize(KeyCache, KeyScales, t, i, HeadSize, GroupSize, BitWidth);
+        reference += double(Query[i]) * Key[t * HeadSize + i];
+      }
+      ScoresExact[t] = exact * Alpha;
+      ScoresFloat[t] = reference * Alpha;
+      ASSERT_TRUE(CloseEnough(Scores[t], float(ScoresExact[t])) || std::fabs(Scores[t] - ScoresExact[t]) < 1e-5)
+          << "QK bits=" << BitWidth << " G=" << GroupSize << " @" << t << ": " << Scores[t] << " vs "
+          << ScoresExact[t];
+    }
+
+    // Softmax of the quantized scores, with every third token masked out.
+    std::vector<float> Probs(TokenCount);
+    std::vector<double> ProbsFloat(TokenCount);
+    double sum = 0.0;
+    double sum_float = 0.0;
+    for (size_t t = 0; t < TokenCount; t++) {
+      if (t % 3 == 2) {
+        continue;
+      }
+      Probs[t] = std::exp(Scores[t]);
+      ProbsFloat[t] = std::exp(ScoresFloat[t]);
+      sum += Probs[t];
+      sum_float += ProbsFloat[t];
+    }
+    for (size_t t = 0; t < TokenCount; t++) {
+      Probs[t] = float(Probs[t] / sum);
+      ProbsFloat[t] /= sum_float;
+    }
+
+    std::vector<float> Output(HeadSize, 0.0f);
+    MlasKvCachePVAccumulate(Probs.data(), ValueCache.data(), ValueScales.data(), TokenCount, HeadSize, GroupSize,
+                            BitWidth, Output.data());
+
+    // The attention output stays within a few quantization steps of the unquantized result.
+    const double Tolerance = BitWidth == 8 ? 0.02 : 0.2;
+
+    for (size_t i = 0; i < HeadSize; i++) {
+      double exact = 0.0;
+      double reference = 0.0;
+      for (size_t t = 0; t < TokenCount; t++) {
+        exact += double(Probs[t]) * Dequantize(ValueCache, ValueScales, t, i, HeadSize, GroupSize, BitWidth);
+        reference += ProbsFloat[t] * Value[t * HeadSize + i];
+      }
+      ASSERT_TRUE(CloseEnough(Output[i], float(exact)) || std::fabs(Output[i] - exact) < 1e-5)
+          << "PV bits=" << BitWidth << " G=" << GroupSize << " @" << i << ": " << Output[i] << " vs " << exact;
+      ASSERT_LE(std::fabs(Output[i] - reference), Tolerance)
+          << "Accuracy bits=" << BitWidth << " G=" << GroupSize << " @" << i << ": " << Output[i] << " vs "
+          << reference;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("KvCacheQuant");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t BitWidth : {size_t(8), size_t(4)}) {
+      Test(1, 64, 64, BitWidth);
+      Test(37, 64, 32, BitWidth);
+      Test(100, 128, 128, BitWidth);
+      Test(257, 96, 32, BitWidth);
+      Test(19, 80, 16, BitWidth);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasKvCacheQuantTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasLoraSgmvTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t N, size_t K, size_t Rank, size_t AdapterCount, const std::vector<int32_t>& AdapterIndex,
+            float Scale) {
+    const size_t M = AdapterIndex.size();
+    const size_t ldx = K + 3;
+    const size_t ldy = N + 5;
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 31 + N * 7 + K + Rank));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> X(M * ldx);
+    std::vector<float> Y(M * ldy);
+    std::vector<std::vector<float>> BufferA(AdapterCount);
+    std::vector<std::vector<float>> BufferB(AdapterCount);
+    std::vector<const float*> LoraA(AdapterCount);
+    std::vector<const float*> LoraB(AdapterCount);
+
+    for (auto& v : X) v = distribution(generator);
+    for (auto& v : Y) v = distribution(generator);
+    for (size_t i = 0; i < AdapterCount; i++) {
+      BufferA[i].resize(K * Rank);
+      BufferB[i].resize(Rank * N);
+      for (auto& v : BufferA[i]) v = distribution(generator);
+      for (auto& v : BufferB[i]) v = distribution(generator);
+      LoraA[i] = BufferA[i].data();
+      LoraB[i] = BufferB[i].data();
+    }
+
+    std::vector<float> YReference(Y);
+    for (size_t m = 0; m < M; m++) {
+      if (AdapterIndex[m] < 0) {
+        continue;
+      }
+      const float* A = LoraA[AdapterIndex[m]];
+      const float* B = LoraB[AdapterIndex[m]];
+      std::vector<double> T(Rank, 0.0);
+      for (size_t r = 0; r < Rank; r++) {
+        for (size_t k = 0; k < K; k++) {
+          T[r] += double(X[m * ldx + k]) * A[k * Rank + r];
+        }
+      }
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (size_t r = 0; r < Rank; r++) {
+          sum += T[r] * B[r * N + n];
+        }
+        YReference[m * ldy + n] += float(Scale * sum);
+      }
+    }
+
+    MlasLoraSgmv(M, N, K, Rank, X.data(), ldx, AdapterIndex.data(), LoraA.data(), LoraB.data(), Scale,
+                 Y.data(), ldy, threadpool_);
+
+    for (size_t i = 0; i < Y.size(); i++) {
+      const float diff = std::fabs(Y[i] - YReference[i]);
+      ASSERT_TRUE(diff <= 1e-4f || CloseEnough(Y[i], YReference[i]))
+          << "M=" << M << " N=" << N << " K=" << K << " Rank=" << Rank << " @" << i << ": " << Y[i]
+          << " vs " << YReference[i];
+    }
+  }
+
+ public:
+  MlasLoraSgmvTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("LoraSgmv") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // One row per request, as in decoding, with a different adapter per row.
+    Test(64, 32, 8, 4, {0, 1, 2, 3, 2, 1}, 1.0f);
+    Test(4096, 4096, 16, 3, {2, -1, 0, 1, 0, 0, 2, 1}, 0.5f);
+
+    // Segments of several rows, including segments of one adapter with the same row count.
+    Test(96, 80, 4, 3, {0, 0, 0, 1, 1, 1, 0, 0, 0, 2, 2, 2, 1, 1, 1}, 2.0f);
+    Test(33, 130, 16, 2, std::vector<int32_t>(40, 1), 1.0f);
+    Test(17, 9, 3, 2, {1, 1, -1, -1, 0, 0, 0, 1, 1}, 0.25f);
+
+    // Rows without an adapter are left unchanged.
+    Test(16, 16, 4, 1, {-1, -1, -1}, 1.0f);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLoraSgmvTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLoraSgmvTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
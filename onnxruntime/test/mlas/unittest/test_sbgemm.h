@@ -15,12 +15,12 @@ Abstract:
 
 --*/
 
-#if defined(__aarch64__) && defined(__linux__)
-
 #pragma once
 
 #include "test_util.h"
 
+#if defined(MLAS_SUPPORTS_SBGEMM)
+
 template <typename T>
 void SmallFloatFill(T* start, size_t size) {
   constexpr float MinimumFillValue = -11.0f;
@@ -278,4 +278,4 @@ class MlasSBGemmTest : public MlasTestBase {
   }
 };
 
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SUPPORTS_SBGEMM)
@@ -0,0 +1,230 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasConvIndirectTest : public MlasTestBase {
+ private:
+  struct ConvShape {
+    size_t GroupCount;
+    size_t InputChannels;   // per group
+    size_t OutputChannels;  // per group
+    size_t InputHeight;
+    size_t InputWidth;
+    size_t KernelHeight;
+    size_t KernelWidth;
+    size_t Padding;
+    size_t Stride;
+    size_t Dilation;
+  };
+
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+
+  // Builds the indirection buffer for a 2D NHWC image, with padding pointing at ZeroVector.
+  static std::vector<const float*> BuildIndirection(const ConvShape& Shape, const float* Input, const float* ZeroVector,
+                                                    size_t OutputHeight, size_t OutputWidth) {
+    const size_t C = Shape.GroupCount * Shape.InputChannels;
+    std::vector<const float*> Indirection;
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+      for (size_t ow = 0; ow < OutputWidth; ow++) {
+        for (size_t kh = 0; kh < Shape.KernelHeight; kh++) {
+          for (size_t kw = 0; kw < Shape.KernelWidth; kw++) {
+            const ptrdiff_t ih = ptrdiff_t(oh * Shape.Stride + kh * Shape.Dilation) - ptrdiff_t(Shape.Padding);
+            const ptrdiff_t iw = ptrdiff_t(ow * Shape.Stride + kw * Shape.Dilation) - ptrdiff_t(Shape.Padding);
+            if (ih < 0 || iw < 0 || ih >= ptrdiff_t(Shape.InputHeight) || iw >= ptrdiff_t(Shape.InputWidth)) {
+              Indirection.push_back(ZeroVector);
+            } else {
+              Indirection.push_back(Input + (size_t(ih) * Shape.InputWidth + size_t(iw)) * C);
+            }
+          }
+        }
+      }
+    }
+    return Indirection;
+  }
+
+  void Test(const ConvShape& Shape, bool WithBias, float Beta, MLAS_ACTIVATION_KIND ActivationKind) {
+    const size_t OutputHeight =
+        (Shape.InputHeight + 2 * Shape.Padding - Shape.Dilation * (Shape.KernelHeight - 1) - 1) / Shape.Stride + 1;
+    const size_t OutputWidth =
+        (Shape.InputWidth + 2 * Shape.Padding - Shape.Dilation * (Shape.KernelWidth - 1) - 1) / Shape.Stride + 1;
+    const size_t OutputCount = OutputHeight * OutputWidth;
+    const size_t KernelSize = Shape.KernelHeight * Shape.KernelWidth;
+    const size_t C = Shape.GroupCount * Shape.InputChannels;
+    const size_t M = Shape.GroupCount * Shape.OutputChannels;
+    const size_t K = KernelSize * Shape.InputChannels;
+
+    std::default_random_engine generator(static_cast<unsigned>(C * 131 + M * 7 + KernelSize));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> Input(Shape.InputHeight * Shape.InputWidth * C);
+    std::vector<float> Filter(Shape.GroupCount * K * Shape.OutputChannels);  // per group: K x OutputChannels
+    std::vector<float> Bias(M);
+    std::vector<float> Output(OutputCount * M);
+    for (auto& v : Input) v = distribution(generator);
+    for (auto& v : Filter) v = distribution(generator);
+    for (auto& v : Bias) v = distribution(generator);
+    for (auto& v : Output) v = distribution(generator);
+    std::vector<float> OutputReference(Output);
+    std::vector<float> ZeroVector(C, 0.0f);
+
+    const auto Indirection = BuildIndirection(Shape, Input.data(), ZeroVector.data(), OutputHeight, OutputWidth);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.Clip.minimum = -0.5f;
+    Activation.Parameters.Clip.maximum = 0.5f;
+
+    // Reference result.
+    for (size_t o = 0; o < OutputCount; o++) {
+      for (size_t g = 0; g < Shape.GroupCount; g++) {
+        for (size_t n = 0; n < Shape.OutputChannels; n++) {
+          double sum = WithBias ? Bias[g * Shape.OutputChannels + n] : 0.0;
+          for (size_t kpos = 0; kpos < KernelSize; kpos++) {
+            const float* pixel = Indirection[o * KernelSize + kpos] + g * Shape.InputChannels;
+            for (size_t c = 0; c < Shape.InputChannels; c++) {
+              sum += double(pixel[c]) *
+                     Filter[(g * K + kpos * Shape.InputChannels + c) * Shape.OutputChannels + n];
+            }
+          }
+          float& out = OutputReference[o * M + g * Shape.OutputChannels + n];
+          float value = float(sum + (Beta == 0.0f ? 0.0 : double(Beta) * out));
+          if (ActivationKind == MlasReluActivation) {
+            value = std::max(value, 0.0f);
+          } else if (ActivationKind == MlasClipActivation) {
+            value = std::min(std::max(value, -0.5f), 0.5f);
+          }
+          out = value;
+        }
+      }
+    }
+
+    const size_t PackedSize = MlasConvIndirectPackWSize(Shape.OutputChannels, Shape.InputChannels, KernelSize);
+    uint8_t* PackedFilter = BufferPackedFilter.GetBuffer(PackedSize * Shape.GroupCount, true);
+    for (size_t g = 0; g < Shape.GroupCount; g++) {
+      MlasConvIndirectPackW(Shape.OutputChannels, Shape.InputChannels, KernelSize,
+                            Filter.data() + g * K * Shape.OutputChannels, Shape.OutputChannels,
+                            PackedFilter + g * PackedSize);
+    }
+
+    const bool Pointwise = KernelSize == 1 && Shape.Padding == 0 && Shape.Stride == 1;
+
+    // Split the output pixels into uneven ranges as the operator does across threads.
+    for (size_t start = 0; start < OutputCount;) {
+      const size_t count = std::min(OutputCount - start, size_t(37));
+      for (size_t g = 0; g < Shape.GroupCount; g++) {
+        MLAS_CONV_INDIRECT_PARAMS Params = {};
+        if (Pointwise) {
+          Params.InputDirect = Input.data() + start * C;
+          Params.InputStride = C;
+        } else {
+          Params.InputIndirection = Indirection.data() + start * KernelSize;
+        }
+        Params.InputOffset = g * Shape.InputChannels;
+        Params.PackedFilter = PackedFilter + g * PackedSize;
+        Params.Bias = WithBias ? Bias.data() + g * Shape.OutputChannels : nullptr;
+        Params.Output = Output.data() + start * M + g * Shape.OutputChannels;
+        Params.OutputStride = M;
+        Params.InputChannels = Shape.InputChannels;
+        Params.OutputChannels = Shape.OutputChannels;
+        Params.OutputCount = count;
+        Params.KernelSize = KernelSize;
+        Params.Beta = Beta;
+        Params.Activation = &Activation;
+        MlasConvIndirect(Params);
+      }
+      start += count;
+    }
+
+    for (size_t i = 0; i < Output.size(); i++) {
+      ASSERT_TRUE(std::fabs(Output[i] - OutputReference[i]) <= 1e-4f || CloseEnough(Output[i], OutputReference[i]))
+          << "G=" << Shape.GroupCount << " C=" << Shape.InputChannels << " M=" << Shape.OutputChannels
+          << " K=" << Shape.KernelHeight << "x" << Shape.KernelWidth << " @" << i << ": " << Output[i]
+          << " vs " << OutputReference[i];
+    }
+  }
+
+  void TestDepthwise(size_t Channels, size_t Height, size_t Width, size_t KernelHeight, size_t KernelWidth,
+                     size_t Padding, size_t Stride, float Beta) {
+    const ConvShape Shape{Channels, 1, 1, Height, Width, KernelHeight, KernelWidth, Padding, Stride, 1};
+    const size_t OutputHeight = (Height + 2 * Padding - KernelHeight) / Stride + 1;
+    const size_t OutputWidth = (Width + 2 * Padding - KernelWidth) / Stride + 1;
+    const size_t OutputCount = OutputHeight * OutputWidth;
+    const size_t KernelSize = KernelHeight * KernelWidth;
+
+    std::default_random_engine generator(static_cast<unsigned>(Channels * 17 + KernelSize));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> Input(Height * Width * Channels);
+    std::vector<float> Filter(KernelSize * Channels);
+    std::vector<float> Bias(Channels);
+    std::vector<float> Output(OutputCount * Channels);
+    for (auto& v : Input) v = distribution(generator);
+    for (auto& v : Filter) v = distribution(generator);
+    for (auto& v : Bias) v = distribution(generator);
+    for (auto& v : Output) v = distribution(generator);
+    std::vector<float> OutputReference(Output);
+    std::vector<float> ZeroVector(Channels, 0.0f);
+
+    const auto Indirection = BuildIndirection(Shape, Input.data(), ZeroVector.data(), OutputHeight, OutputWidth);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      for (size_t c = 0; c < Channels; c++) {
+        double sum = Bias[c];
+        for (size_t k = 0; k < KernelSize; k++) {
+          sum += double(Indirection[o * KernelSize + k][c]) * Filter[k * Channels + c];
+        }
+        float& out = OutputReference[o * Channels + c];
+        out = std::max(float(sum + (Beta == 0.0f ? 0.0 : double(Beta) * out)), 0.0f);
+      }
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasReluActivation;
+
+    MlasConvDepthwise(Indirection.data(), Filter.data(), Bias.data(), Output.data(), Channels, OutputCount,
+                      KernelSize, Beta, &Activation);
+
+    for (size_t i = 0; i < Output.size(); i++) {
+      ASSERT_TRUE(std::fabs(Output[i] - OutputReference[i]) <= 1e-5f || CloseEnough(Output[i], OutputReference[i]))
+          << "Depthwise C=" << Channels << " @" << i << ": " << Output[i] << " vs " << OutputReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("ConvIndirect");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // 3x3 with padding, stride and dilation, including K slices that split a kernel position.
+    Test({1, 3, 16, 15, 17, 3, 3, 1, 1, 1}, true, 0.0f, MlasReluActivation);
+    Test({1, 64, 48, 9, 11, 3, 3, 1, 2, 1}, false, 0.0f, MlasIdentityActivation);
+    Test({1, 100, 33, 8, 8, 3, 3, 2, 1, 2}, true, 1.0f, MlasClipActivation);
+    Test({1, 300, 20, 5, 6, 2, 2, 0, 1, 1}, true, 0.5f, MlasIdentityActivation);
+
+    // Grouped convolutions.
+    Test({4, 8, 12, 10, 10, 3, 3, 1, 1, 1}, true, 0.0f, MlasReluActivation);
+    Test({2, 37, 5, 7, 9, 1, 5, 0, 1, 1}, false, 1.0f, MlasIdentityActivation);
+
+    // Pointwise convolutions use the input directly.
+    Test({1, 40, 72, 13, 7, 1, 1, 0, 1, 1}, true, 0.0f, MlasReluActivation);
+    Test({3, 16, 8, 6, 6, 1, 1, 0, 1, 1}, true, 1.0f, MlasIdentityActivation);
+
+    // Strided pointwise convolutions go through the indirection buffer.
+    Test({1, 24, 17, 9, 9, 1, 1, 0, 2, 1}, false, 0.0f, MlasIdentityActivation);
+
+    TestDepthwise(32, 14, 14, 3, 3, 1, 1, 0.0f);
+    TestDepthwise(19, 9, 11, 5, 5, 2, 2, 1.0f);
+    TestDepthwise(3, 7, 7, 3, 3, 0, 1, 0.0f);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConvIndirectTest>::RegisterShortExecute();
+  }
+  return count;
+});
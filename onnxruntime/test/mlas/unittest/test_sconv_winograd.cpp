@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasConvWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferWorking;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t TileSize, size_t BatchCount, size_t GroupCount, size_t InputChannels, size_t FilterCount,
+            size_t InputHeight, size_t InputWidth, size_t Padding, float Beta, MLAS_ACTIVATION_KIND ActivationKind) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+    const size_t C = GroupCount * InputChannels;
+    const size_t M = GroupCount * FilterCount;
+
+    std::default_random_engine generator(static_cast<unsigned>(C * 31 + M * 7 + InputSize));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> Input(BatchCount * C * InputSize);
+    std::vector<float> Filter(M * InputChannels * 9);
+    std::vector<float> Bias(M);
+    std::vector<float> Output(BatchCount * M * OutputSize);
+    for (auto& v : Input) v = distribution(generator);
+    for (auto& v : Filter) v = distribution(generator);
+    for (auto& v : Bias) v = distribution(generator);
+    for (auto& v : Output) v = distribution(generator);
+    std::vector<float> OutputReference(Output);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.Clip.minimum = -2.0f;
+    Activation.Parameters.Clip.maximum = 2.0f;
+
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t m = 0; m < M; m++) {
+        const size_t g = m / FilterCount;
+        for (size_t oh = 0; oh < OutputHeight; oh++) {
+          for (size_t ow = 0; ow < OutputWidth; ow++) {
+            double sum = Bias[m];
+            for (size_t c = 0; c < InputChannels; c++) {
+              const float* input = Input.data() + (b * C + g * InputChannels + c) * InputSize;
+              const float* filter = Filter.data() + (m * InputChannels + c) * 9;
+              for (size_t kh = 0; kh < 3; kh++) {
+                for (size_t kw = 0; kw < 3; kw++) {
+                  const ptrdiff_t ih = ptrdiff_t(oh + kh) - ptrdiff_t(Padding);
+                  const ptrdiff_t iw = ptrdiff_t(ow + kw) - ptrdiff_t(Padding);
+                  if (ih >= 0 && iw >= 0 && ih < ptrdiff_t(InputHeight) && iw < ptrdiff_t(InputWidth)) {
+                    sum += double(input[size_t(ih) * InputWidth + size_t(iw)]) * filter[kh * 3 + kw];
+                  }
+                }
+              }
+            }
+            float& out = OutputReference[(b * M + m) * OutputSize + oh * OutputWidth + ow];
+            float value = float(sum + (Beta == 0.0f ? 0.0 : double(Beta) * out));
+            if (ActivationKind == MlasReluActivation) {
+              value = std::max(value, 0.0f);
+            } else if (ActivationKind == MlasClipActivation) {
+              value = std::min(std::max(value, -2.0f), 2.0f);
+            }
+            out = value;
+          }
+        }
+      }
+    }
+
+    const size_t PackedSize = MlasConvWinogradPackFilterSize(TileSize, GroupCount, InputChannels, FilterCount);
+    uint8_t* PackedFilter = BufferPackedFilter.GetBuffer(PackedSize, true);
+    MlasConvWinogradPackFilter(TileSize, GroupCount, InputChannels, FilterCount, Filter.data(), PackedFilter);
+
+    MLAS_CONV_WINOGRAD_PARAMETERS Parameters;
+    Parameters.TileSize = TileSize;
+    Parameters.BatchCount = BatchCount;
+    Parameters.GroupCount = GroupCount;
+    Parameters.InputChannels = InputChannels;
+    Parameters.FilterCount = FilterCount;
+    Parameters.InputHeight = InputHeight;
+    Parameters.InputWidth = InputWidth;
+    Parameters.OutputHeight = OutputHeight;
+    Parameters.OutputWidth = OutputWidth;
+    Parameters.PaddingTop = Padding;
+    Parameters.PaddingLeft = Padding;
+    Parameters.Beta = Beta;
+    Parameters.Activation = &Activation;
+
+    float* WorkingBuffer =
+        BufferWorking.GetBuffer(MlasConvWinogradGetWorkingBufferSize(&Parameters, threadpool_), true);
+
+    MlasConvWinograd(&Parameters, Input.data(), PackedFilter, Bias.data(), WorkingBuffer, Output.data(),
+                     threadpool_);
+
+    // F(4x4,3x3) amplifies rounding errors more than the direct convolution.
+    const float Tolerance = TileSize == 4 ? 1e-3f : 1e-4f;
+
+    for (size_t i = 0; i < Output.size(); i++) {
+      ASSERT_TRUE(std::fabs(Output[i] - OutputReference[i]) <= Tolerance * (1.0f + std::fabs(OutputReference[i])))
+          << "F(" << TileSize << "x" << TileSize << ",3x3) N=" << BatchCount << " G=" << GroupCount
+          << " C=" << InputChannels << " M=" << FilterCount << " H=" << InputHeight << " W=" << InputWidth
+          << " @" << i << ": " << Output[i] << " vs " << OutputReference[i];
+    }
+  }
+
+ public:
+  MlasConvWinogradTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "ConvWinograd_Threaded" : "ConvWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t TileSize : {size_t(2), size_t(4)}) {
+      // Same padding with partial tiles at the right and bottom edges.
+      Test(TileSize, 1, 1, 16, 24, 14, 14, 1, 0.0f, MlasReluActivation);
+      Test(TileSize, 2, 1, 9, 17, 11, 13, 1, 0.0f, MlasIdentityActivation);
+      // Valid padding, more channels than a packed K slice.
+      Test(TileSize, 1, 1, 300, 33, 9, 10, 0, 1.0f, MlasIdentityActivation);
+      // Grouped convolution with the Conv/Sum fusion.
+      Test(TileSize, 2, 3, 8, 16, 8, 8, 1, 1.0f, MlasClipActivation);
+      // Output smaller than a tile.
+      Test(TileSize, 1, 1, 12, 12, 3, 4, 0, 0.5f, MlasReluActivation);
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConvWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConvWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
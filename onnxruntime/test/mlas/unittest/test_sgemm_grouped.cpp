@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSgemmGroupedTest : public MlasTestBase {
+ private:
+  struct GroupShape {
+    bool TransA;
+    bool TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t BatchSize;
+    bool SharedB;
+    float alpha;
+    float beta;
+  };
+
+  MLAS_THREADPOOL* threadpool_;
+
+  static void ReferenceGemm(const GroupShape& Shape, const float* A, size_t lda, const float* B, size_t ldb, float* C, size_t ldc) {
+    for (size_t m = 0; m < Shape.M; m++) {
+      for (size_t n = 0; n < Shape.N; n++) {
+        double sum = 0.0;
+        for (size_t k = 0; k < Shape.K; k++) {
+          const float a = Shape.TransA ? A[k * lda + m] : A[m * lda + k];
+          const float b = Shape.TransB ? B[n * ldb + k] : B[k * ldb + n];
+          sum += double(a) * double(b);
+        }
+        float& c = C[m * ldc + n];
+        c = float(Shape.alpha * sum + ((Shape.beta == 0.0f) ? 0.0 : double(Shape.beta) * c));
+      }
+    }
+  }
+
+  void Test(const std::vector<GroupShape>& Shapes) {
+    std::default_random_engine generator(static_cast<unsigned>(Shapes.size()));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<std::vector<float>> BufferA(Shapes.size());
+    std::vector<std::vector<float>> BufferB(Shapes.size());
+    std::vector<std::vector<float>> BufferC(Shapes.size());
+    std::vector<std::vector<float>> BufferCReference(Shapes.size());
+    std::vector<std::vector<MLAS_SGEMM_DATA_PARAMS>> Data(Shapes.size());
+    std::vector<MLAS_SGEMM_GROUP_PARAMS> Groups(Shapes.size());
+
+    for (size_t g = 0; g < Shapes.size(); g++) {
+      const GroupShape& Shape = Shapes[g];
+      const size_t SizeA = Shape.M * Shape.K;
+      const size_t SizeB = Shape.K * Shape.N;
+      const size_t SizeC = Shape.M * Shape.N;
+
+      BufferA[g].resize(SizeA * Shape.BatchSize);
+      BufferB[g].resize(SizeB * (Shape.SharedB ? 1 : Shape.BatchSize));
+      BufferC[g].resize(SizeC * Shape.BatchSize);
+
+      for (auto& v : BufferA[g]) v = distribution(generator);
+      for (auto& v : BufferB[g]) v = distribution(generator);
+      for (auto& v : BufferC[g]) v = distribution(generator);
+      BufferCReference[g] = BufferC[g];
+
+      Data[g].resize(Shape.BatchSize);
+      for (size_t i = 0; i < Shape.BatchSize; i++) {
+        Data[g][i].A = BufferA[g].data() + SizeA * i;
+        Data[g][i].lda = Shape.TransA ? Shape.M : Shape.K;
+        Data[g][i].B = BufferB[g].data() + (Shape.SharedB ? 0 : SizeB * i);
+        Data[g][i].ldb = Shape.TransB ? Shape.K : Shape.N;
+        Data[g][i].C = BufferC[g].data() + SizeC * i;
+        Data[g][i].ldc = Shape.N;
+        Data[g][i].alpha = Shape.alpha;
+        Data[g][i].beta = Shape.beta;
+
+        ReferenceGemm(Shape, Data[g][i].A, Data[g][i].lda, Data[g][i].B, Data[g][i].ldb,
+                      BufferCReference[g].data() + SizeC * i, Shape.N);
+      }
+
+      Groups[g].TransA = Shape.TransA ? CblasTrans : CblasNoTrans;
+      Groups[g].TransB = Shape.TransB ? CblasTrans : CblasNoTrans;
+      Groups[g].M = Shape.M;
+      Groups[g].N = Shape.N;
+      Groups[g].K = Shape.K;
+      Groups[g].Data = Data[g].data();
+      Groups[g].BatchSize = Shape.BatchSize;
+    }
+
+    MlasGemmGrouped(Groups.data(), Groups.size(), threadpool_);
+
+    for (size_t g = 0; g < Shapes.size(); g++) {
+      for (size_t i = 0; i < BufferC[g].size(); i++) {
+        const float diff = std::fabs(BufferC[g][i] - BufferCReference[g][i]);
+        ASSERT_TRUE(diff <= 1e-4f || CloseEnough(BufferC[g][i], BufferCReference[g][i]))
+            << "Group " << g << " M=" << Shapes[g].M << " N=" << Shapes[g].N << " K=" << Shapes[g].K
+            << " Batch=" << Shapes[g].BatchSize << " @" << i << ": " << BufferC[g][i]
+            << " vs " << BufferCReference[g][i];
+      }
+    }
+  }
+
+ public:
+  MlasSgemmGroupedTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SGemmGrouped") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (bool trans_a : {false, true}) {
+      for (bool trans_b : {false, true}) {
+        // Mixed shapes across groups, including tiny problems.
+        Test({{trans_a, trans_b, 1, 16, 8, 5, false, 1.0f, 0.0f},
+              {trans_a, trans_b, 7, 3, 11, 9, false, 1.0f, 0.0f},
+              {trans_a, trans_b, 64, 96, 48, 2, false, 0.5f, 1.0f},
+              {trans_a, trans_b, 33, 130, 300, 3, false, 1.0f, 0.25f}});
+
+        // Groups that share matrix B are packed once for the group.
+        Test({{trans_a, trans_b, 17, 40, 19, 6, true, 1.0f, 0.0f},
+              {trans_a, trans_b, 128, 64, 520, 4, true, 2.0f, 0.5f},
+              {trans_a, trans_b, 1, 20, 8, 3, true, 1.0f, 0.0f}});
+
+        // Empty groups and problems with K equal to zero.
+        Test({{trans_a, trans_b, 0, 8, 8, 4, false, 1.0f, 0.0f},
+              {trans_a, trans_b, 5, 6, 0, 3, false, 1.0f, 0.5f},
+              {trans_a, trans_b, 9, 9, 9, 0, false, 1.0f, 0.0f},
+              {trans_a, trans_b, 300, 2, 64, 1, false, 1.0f, 0.0f}});
+      }
+    }
+
+    // Many small problems of the same shape, as produced by a broadcast batch.
+    Test({{false, false, 4, 4, 4, 256, false, 1.0f, 0.0f}});
+    Test({{false, true, 12, 32, 64, 64, true, 1.0f, 0.0f}});
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasSparseSgemmTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+
+  // Pattern 0 prunes B to 2:4 along K, pattern 1 keeps one in three 4 x 16 blocks, pattern 2 keeps B dense.
+  void Test(size_t M, size_t N, size_t K, size_t BatchSize, bool TransB, int Pattern, float alpha, float beta) {
+    const size_t ldb = TransB ? K + 1 : N + 2;
+    const size_t lda = K + 3;
+    const size_t ldc = N + 5;
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 31 + N * 7 + K + Pattern));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> B((TransB ? N : K) * ldb);
+    for (auto& v : B) v = distribution(generator);
+
+    const auto BElement = [&](size_t k, size_t n) -> float& { return TransB ? B[n * ldb + k] : B[k * ldb + n]; };
+
+    for (size_t k = 0; k < K; k++) {
+      for (size_t n = 0; n < N; n++) {
+        const bool Keep = (Pattern == 0)   ? (k % 4 == n % 4 || k % 4 == (n + 1 + k / 4) % 4)
+                          : (Pattern == 1) ? ((k / 4 + n / 16) % 3 == 0)
+                                           : true;
+        if (!Keep) {
+          BElement(k, n) = 0.0f;
+        }
+      }
+    }
+
+    const CBLAS_TRANSPOSE Trans = TransB ? CblasTrans : CblasNoTrans;
+    const MLAS_SPARSE_SGEMM_FORMAT Format = MlasSparseSgemmSelectFormat(Trans, N, K, B.data(), ldb);
+
+    if (Pattern == 2) {
+      ASSERT_EQ(Format, MlasSparseSgemmFormatNone) << "M=" << M << " N=" << N << " K=" << K;
+      return;
+    }
+    ASSERT_NE(Format, MlasSparseSgemmFormatNone) << "M=" << M << " N=" << N << " K=" << K;
+
+    const size_t PackedBSize = MlasSparseSgemmPackBSize(Format, Trans, N, K, B.data(), ldb);
+    ASSERT_GT(PackedBSize, size_t(0));
+    std::vector<uint8_t> PackedB(PackedBSize);
+    MlasSparseSgemmPackB(Format, Trans, N, K, B.data(), ldb, PackedB.data());
+
+    std::vector<float> A(BatchSize * M * lda);
+    std::vector<float> C(BatchSize * M * ldc);
+    for (auto& v : A) v = distribution(generator);
+    for (auto& v : C) v = distribution(generator);
+
+    std::vector<float> CReference(C);
+    for (size_t b = 0; b < BatchSize; b++) {
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          double sum = 0.0;
+          for (size_t k = 0; k < K; k++) {
+            sum += double(A[(b * M + m) * lda + k]) * BElement(k, n);
+          }
+          float& c = CReference[(b * M + m) * ldc + n];
+          c = float(alpha * sum + (beta == 0.0f ? 0.0 : double(beta) * c));
+        }
+      }
+    }
+
+    std::vector<MLAS_SPARSE_SGEMM_DATA_PARAMS> Data(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      Data[b].A = A.data() + b * M * lda;
+      Data[b].lda = lda;
+      Data[b].C = C.data() + b * M * ldc;
+      Data[b].ldc = ldc;
+      Data[b].alpha = alpha;
+      Data[b].beta = beta;
+    }
+
+    MlasSparseSgemmBatch(M, N, K, PackedB.data(), Data.data(), BatchSize, threadpool_);
+
+    for (size_t i = 0; i < C.size(); i++) {
+      const float diff = std::fabs(C[i] - CReference[i]);
+      ASSERT_TRUE(diff <= 1e-4f || CloseEnough(C[i], CReference[i]))
+          << "Format=" << Format << " M=" << M << " N=" << N << " K=" << K << " TransB=" << TransB << " @" << i
+          << ": " << C[i] << " vs " << CReference[i];
+    }
+  }
+
+ public:
+  MlasSparseSgemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SparseSgemm") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (int Pattern = 0; Pattern < 3; Pattern++) {
+      for (bool TransB : {false, true}) {
+        // One row, as in decoding, and row counts around the kernel heights.
+        Test(1, 64, 64, 1, TransB, Pattern, 1.0f, 0.0f);
+        Test(3, 33, 67, 1, TransB, Pattern, 0.5f, 1.0f);
+        Test(9, 16, 7, 2, TransB, Pattern, 1.0f, 0.5f);
+        Test(70, 130, 129, 1, TransB, Pattern, 2.0f, 0.0f);
+        Test(17, 1, 40, 3, TransB, Pattern, 1.0f, 1.0f);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseSgemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparseSgemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
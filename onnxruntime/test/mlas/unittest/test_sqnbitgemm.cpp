@@ -47,6 +47,7 @@ class MlasSQNBitGemmTest : public MlasTestBase {
   MatrixGuardBuffer<float> BufferDequantizedB;
   MatrixGuardBuffer<float> BufferBias;
   MatrixGuardBuffer<std::byte> BufferWorkspace;
+  MatrixGuardBuffer<std::byte> BufferQuantA;
   MatrixGuardBuffer<float> BufferC;
   MatrixGuardBuffer<float> BufferCReference;
 
@@ -64,7 +65,8 @@ class MlasSQNBitGemmTest : public MlasTestBase {
                 size_t ldc,
                 void* Workspace,
                 MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType,
-                MLAS_THREADPOOL* Threadpool) {
+                MLAS_THREADPOOL* Threadpool,
+                const void* QuantA = nullptr) {
     MLAS_QNBIT_GEMM_DATA_PARAMS<float> params;
     params.A = A;
     params.lda = lda;
@@ -80,6 +82,7 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     params.QuantBScale = QuantBScale;
     params.QuantBZeroPoint = QuantBZeroPoint;
     params.PostProcessor = nullptr;
+    params.QuantA = QuantA;
 
     MlasQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType, &params, Workspace, Threadpool);
   }
@@ -306,6 +309,34 @@ class MlasSQNBitGemmTest : public MlasTestBase {
             << "M=" << M << ", N=" << N << ", K=" << K;
       }
     }
+
+    // A quantized ahead of the GEMM, one range of rows at a time, replaces the quantization of A in the workspace.
+    if (const auto QuantASize = MlasQNBitGemmQuantizedASize(M, K, BlkBitWidth, BlkLen, !Symmetric, ComputeType);
+        QuantASize > 0) {
+      std::byte* QuantA = BufferQuantA.GetBuffer(QuantASize);
+      const size_t SplitM = M / 2;
+      MlasQNBitGemmQuantizeA(M, K, BlkBitWidth, BlkLen, !Symmetric, ComputeType,
+                             A + SplitM * K, /* lda */ K, SplitM, M - SplitM, QuantA);
+      MlasQNBitGemmQuantizeA(M, K, BlkBitWidth, BlkLen, !Symmetric, ComputeType,
+                             A, /* lda */ K, 0, SplitM, QuantA);
+
+      C = BufferC.GetBuffer(N * M, true);
+      CallGemm(M, N, K,
+               A, /* lda */ K,
+               QuantBData, PackedQuantBDataWorkspace, QuantBScale, QuantBZeroPoint,
+               Bias,
+               C, /* ldc */ N,
+               /* Workspace */ nullptr,
+               ComputeType,
+               Threadpool,
+               QuantA);
+
+      for (size_t i = 0; i < M * N; i++) {
+        ASSERT_TRUE(CloseEnough(C[i], CReference[i]))
+            << "Expected: " << CReference[i] << " Actual: " << C[i] << " with quantized A @" << i << ", "
+            << "M=" << M << ", N=" << N << ", K=" << K;
+      }
+    }
   }
 
  public:
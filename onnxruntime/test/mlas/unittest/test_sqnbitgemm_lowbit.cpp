@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "mlas_qnbit.h"
+
+//
+// Tests MlasQNBitGemmBatch with 2-bit and 3-bit quantized B. MlasQuantizeBlockwise does not produce 3-bit data,
+// so B is quantized here directly into the MatMulNBits layout: per column, blocks of BlkLen values packed as a
+// least significant bits first bit stream, with zero points packed the same way per column.
+//
+template <bool Threaded>
+class MlasSQLowBitGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<std::byte> BufferPackedQuantBData;
+  MatrixGuardBuffer<std::byte> BufferWorkspace;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void SetBits(std::vector<uint8_t>& Stream, size_t BitOffset, size_t BitWidth, uint32_t Value) {
+    for (size_t i = 0; i < BitWidth; i++) {
+      if ((Value >> i) & 1) {
+        Stream[(BitOffset + i) / 8] |= uint8_t(1u << ((BitOffset + i) % 8));
+      }
+    }
+  }
+
+  static float QuantizeA(float Value, float InverseScale) {
+    return std::min(std::max(std::roundf(Value * InverseScale), -127.0f), 127.0f);
+  }
+
+  void Test(size_t M, size_t N, size_t K, size_t BlkBitWidth, size_t BlkLen, MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType,
+            bool Symmetric, bool WithBias) {
+    ASSERT_TRUE(MlasIsQNBitGemmAvailable(BlkBitWidth, BlkLen, ComputeType));
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 131 + N * 17 + K + BlkBitWidth * 7 + BlkLen));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t BlkDataSize = BlkLen * BlkBitWidth / 8;
+    const size_t ZeroPointStride = (BlockCountK * BlkBitWidth + 7) / 8;
+    const uint32_t MaximumValue = (1u << BlkBitWidth) - 1;
+
+    std::vector<float> A(M * K);
+    std::vector<float> B(N * K);
+    std::vector<float> Bias(N);
+    for (auto& v : A) v = distribution(generator);
+    for (auto& v : B) v = distribution(generator);
+    for (auto& v : Bias) v = distribution(generator);
+
+    std::vector<uint8_t> QuantBData(N * BlockCountK * BlkDataSize);
+    std::vector<float> QuantBScale(N * BlockCountK);
+    std::vector<uint8_t> QuantBZeroPoint(N * ZeroPointStride);
+    std::vector<float> DequantizedB(N * BlockCountK * BlkLen, 0.0f);
+
+    for (size_t n = 0; n < N; n++) {
+      std::vector<uint8_t> Column(BlockCountK * BlkDataSize);
+      std::vector<uint8_t> ZeroPoints(ZeroPointStride);
+      for (size_t blk = 0; blk < BlockCountK; blk++) {
+        const size_t k = blk * BlkLen;
+        const size_t CountBlockK = std::min(K - k, BlkLen);
+        float Minimum = 0.0f;
+        float Maximum = 0.0f;
+        for (size_t i = 0; i < CountBlockK; i++) {
+          Minimum = std::min(Minimum, B[n * K + k + i]);
+          Maximum = std::max(Maximum, B[n * K + k + i]);
+        }
+        uint32_t ZeroPoint = 1u << (BlkBitWidth - 1);
+        float Scale;
+        if (Symmetric) {
+          Scale = std::max(std::fabs(Minimum), std::fabs(Maximum)) / float(ZeroPoint);
+        } else {
+          Scale = (Maximum - Minimum) / float(MaximumValue);
+          ZeroPoint = uint32_t(std::min(std::max(std::roundf(-Minimum / Scale), 0.0f), float(MaximumValue)));
+          SetBits(ZeroPoints, blk * BlkBitWidth, BlkBitWidth, ZeroPoint);
+        }
+        QuantBScale[n * BlockCountK + blk] = Scale;
+        for (size_t i = 0; i < BlkLen; i++) {
+          uint32_t q = ZeroPoint;
+          if (i < CountBlockK) {
+            q = uint32_t(std::min(std::max(std::roundf(B[n * K + k + i] / Scale) + float(ZeroPoint), 0.0f),
+                                  float(MaximumValue)));
+          }
+          SetBits(Column, (k + i) * BlkBitWidth, BlkBitWidth, q);
+          DequantizedB[n * BlockCountK * BlkLen + k + i] = (float(q) - float(ZeroPoint)) * Scale;
+        }
+      }
+      std::copy(Column.begin(), Column.end(), QuantBData.begin() + n * BlockCountK * BlkDataSize);
+      std::copy(ZeroPoints.begin(), ZeroPoints.end(), QuantBZeroPoint.begin() + n * ZeroPointStride);
+    }
+
+    // Reference result. The int8 compute type quantizes each block of A to int8 first.
+    std::vector<float> CReference(M * N);
+    for (size_t m = 0; m < M; m++) {
+      std::vector<float> RowA(BlockCountK * BlkLen, 0.0f);
+      std::copy_n(A.data() + m * K, K, RowA.data());
+      if (ComputeType == SQNBIT_CompInt8) {
+        for (size_t blk = 0; blk < BlockCountK; blk++) {
+          float MaximumAbsolute = 0.0f;
+          for (size_t i = 0; i < BlkLen; i++) {
+            MaximumAbsolute = std::max(MaximumAbsolute, std::fabs(RowA[blk * BlkLen + i]));
+          }
+          const float Scale = MaximumAbsolute / 127.0f;
+          const float InverseScale = Scale != 0.0f ? 1.0f / Scale : 0.0f;
+          for (size_t i = 0; i < BlkLen; i++) {
+            RowA[blk * BlkLen + i] = QuantizeA(RowA[blk * BlkLen + i], InverseScale) * Scale;
+          }
+        }
+      }
+      for (size_t n = 0; n < N; n++) {
+        double sum = WithBias ? Bias[n] : 0.0;
+        for (size_t k = 0; k < K; k++) {
+          sum += double(RowA[k]) * DequantizedB[n * BlockCountK * BlkLen + k];
+        }
+        CReference[m * N + n] = float(sum);
+      }
+    }
+
+    const size_t PackedSize = MlasQNBitGemmPackQuantBDataSize(N, K, BlkBitWidth, BlkLen, !Symmetric, ComputeType);
+    ASSERT_GT(PackedSize, size_t{0});
+    std::byte* PackedQuantBData = BufferPackedQuantBData.GetBuffer(PackedSize, true);
+    MlasQNBitGemmPackQuantBData(N, K, BlkBitWidth, BlkLen, ComputeType, QuantBData.data(), PackedQuantBData,
+                                QuantBScale.data(), !Symmetric, nullptr, threadpool_);
+
+    void* Workspace = nullptr;
+    if (const size_t WorkspaceSize =
+            MlasQNBitGemmBatchWorkspaceSize(M, N, K, 1, BlkBitWidth, BlkLen, !Symmetric, ComputeType);
+        WorkspaceSize > 0) {
+      Workspace = BufferWorkspace.GetBuffer(WorkspaceSize, true);
+    }
+
+    std::vector<float> C(M * N);
+
+    MLAS_QNBIT_GEMM_DATA_PARAMS<float> params;
+    params.A = A.data();
+    params.lda = K;
+    params.QuantBDataWorkspace = PackedQuantBData;
+    params.PackedQuantBData = PackedQuantBData;
+    params.QuantBScale = QuantBScale.data();
+    params.QuantBZeroPoint = Symmetric ? nullptr : QuantBZeroPoint.data();
+    params.Bias = WithBias ? Bias.data() : nullptr;
+    params.C = C.data();
+    params.ldc = N;
+
+    MlasQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType, &params, Workspace, threadpool_);
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_TRUE(CloseEnough(C[i], CReference[i]) || std::fabs(C[i] - CReference[i]) < 1e-4f)
+          << "bits=" << BlkBitWidth << " BlkLen=" << BlkLen << " ComputeType=" << ComputeType << " M=" << M
+          << " N=" << N << " K=" << K << " Symmetric=" << Symmetric << " @" << i << ": " << C[i] << " vs "
+          << CReference[i];
+    }
+  }
+
+ public:
+  MlasSQLowBitGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "SQLowBitGemm_Threaded" : "SQLowBitGemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t BlkBitWidth : {size_t(2), size_t(3)}) {
+      for (MLAS_QNBIT_GEMM_COMPUTE_TYPE ComputeType : {SQNBIT_CompFp32, SQNBIT_CompInt8}) {
+        for (bool Symmetric : {true, false}) {
+          Test(1, 1, 16, BlkBitWidth, 16, ComputeType, Symmetric, false);
+          Test(1, 67, 300, BlkBitWidth, 32, ComputeType, Symmetric, true);
+          Test(1, 160, 1024, BlkBitWidth, 128, ComputeType, Symmetric, false);
+          Test(5, 33, 100, BlkBitWidth, 64, ComputeType, Symmetric, true);
+          Test(43, 500, 401, BlkBitWidth, 32, ComputeType, Symmetric, true);
+          Test(17, 19, 513, BlkBitWidth, 256, ComputeType, Symmetric, false);
+        }
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSQLowBitGemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSQLowBitGemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
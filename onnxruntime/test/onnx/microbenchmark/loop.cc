@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+namespace {
+
+// A negative dimension is symbolic.
+void AddValueInfo(ONNX_NAMESPACE::ValueInfoProto& value_info, const std::string& name, int32_t elem_type,
+                  const std::vector<int64_t>& dims) {
+  value_info.set_name(name);
+  auto* tensor_type = value_info.mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(elem_type);
+  auto* shape = tensor_type->mutable_shape();
+  for (auto dim : dims) {
+    if (dim < 0) {
+      shape->add_dim()->set_dim_param("dim_" + std::to_string(shape->dim_size()));
+    } else {
+      shape->add_dim()->set_dim_value(dim);
+    }
+  }
+}
+
+void AddNode(ONNX_NAMESPACE::GraphProto& graph, const std::string& op_type, const std::vector<std::string>& inputs,
+             const std::vector<std::string>& outputs) {
+  auto* node = graph.add_node();
+  node->set_op_type(op_type);
+  node->set_name(outputs.front());
+  for (const auto& input : inputs) {
+    node->add_input(input);
+  }
+  for (const auto& output : outputs) {
+    node->add_output(output);
+  }
+}
+
+// A Loop whose body does almost no work, so that the time is dominated by the per-iteration overhead of the Loop:
+// executing the subgraph, passing the loop carried variable to the next iteration and collecting the scan output.
+//
+//   x_out = Neg(x_in), scan_out = Abs(x_in), cond_out = Identity(cond_in)
+std::string CreateLoopModel(int64_t size) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(8);
+  auto* opset = model.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(13);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name("loop");
+  AddValueInfo(*graph->add_input(), "M", ONNX_NAMESPACE::TensorProto_DataType_INT64, {});
+  AddValueInfo(*graph->add_input(), "cond", ONNX_NAMESPACE::TensorProto_DataType_BOOL, {});
+  AddValueInfo(*graph->add_input(), "x", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {size});
+  AddValueInfo(*graph->add_output(), "x_final", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {size});
+  AddValueInfo(*graph->add_output(), "x_scan", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {-1, size});
+
+  AddNode(*graph, "Loop", {"M", "cond", "x"}, {"x_final", "x_scan"});
+  auto* body_attribute = graph->mutable_node(0)->add_attribute();
+  body_attribute->set_name("body");
+  body_attribute->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_GRAPH);
+
+  auto* body = body_attribute->mutable_g();
+  body->set_name("body");
+  AddValueInfo(*body->add_input(), "iter_num", ONNX_NAMESPACE::TensorProto_DataType_INT64, {});
+  AddValueInfo(*body->add_input(), "cond_in", ONNX_NAMESPACE::TensorProto_DataType_BOOL, {});
+  AddValueInfo(*body->add_input(), "x_in", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {size});
+  AddValueInfo(*body->add_output(), "cond_out", ONNX_NAMESPACE::TensorProto_DataType_BOOL, {});
+  AddValueInfo(*body->add_output(), "x_out", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {size});
+  AddValueInfo(*body->add_output(), "scan_out", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {size});
+  AddNode(*body, "Identity", {"cond_in"}, {"cond_out"});
+  AddNode(*body, "Neg", {"x_in"}, {"x_out"});
+  AddNode(*body, "Abs", {"x_in"}, {"scan_out"});
+
+  return model.SerializeAsString();
+}
+
+}  // namespace
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// Reports the time per Loop iteration in the "IterationTime" counter.
+static void BM_LoopIterationOverhead(benchmark::State& state) {
+  const int64_t trip_count = state.range(0);
+  const int64_t size = state.range(1);
+  const std::string model = CreateLoopModel(size);
+
+  OrtSessionOptions* session_options = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, 1));
+  OrtSession* session = nullptr;
+  OrtStatus* status = g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session);
+  g_ort->ReleaseSessionOptions(session_options);
+  ORT_BREAK_ON_ERROR(status);
+
+  OrtMemoryInfo* memory_info = nullptr;
+  ORT_BREAK_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+
+  int64_t m = trip_count;
+  bool cond = true;
+  std::vector<float> x(static_cast<size_t>(size), 1.f);
+  const int64_t x_dims[] = {size};
+
+  OrtValue* inputs[3] = {};
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &m, sizeof(m), nullptr, 0,
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &inputs[0]));
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, &cond, sizeof(cond), nullptr, 0,
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL, &inputs[1]));
+  ORT_BREAK_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, x.data(), x.size() * sizeof(float), x_dims, 1,
+                                                           ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &inputs[2]));
+  g_ort->ReleaseMemoryInfo(memory_info);
+
+  const char* input_names[] = {"M", "cond", "x"};
+  const char* output_names[] = {"x_final", "x_scan"};
+
+  for (auto _ : state) {
+    OrtValue* outputs[2] = {};
+    ORT_BREAK_ON_ERROR(g_ort->Run(session, nullptr, input_names, inputs, 3, output_names, 2, outputs));
+    g_ort->ReleaseValue(outputs[0]);
+    g_ort->ReleaseValue(outputs[1]);
+  }
+
+  state.counters["IterationTime"] = benchmark::Counter(static_cast<double>(trip_count),
+                                                       benchmark::Counter::kIsIterationInvariantRate |
+                                                           benchmark::Counter::kInvert);
+
+  for (auto* input : inputs) {
+    g_ort->ReleaseValue(input);
+  }
+  g_ort->ReleaseSession(session);
+}
+
+BENCHMARK(BM_LoopIterationOverhead)
+    ->ArgNames({"TripCount", "Size"})
+    ->ArgsProduct({{16, 1024}, {1, 4096}})
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
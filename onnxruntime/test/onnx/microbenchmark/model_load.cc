@@ -0,0 +1,246 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/logging.h"
+#include "core/graph/model.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_c_api.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "core/session/ort_env.h"
+#include "core/util/thread_utils.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace onnxruntime;
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+namespace {
+
+// The phases of loading a model. Each benchmark run times one of them.
+enum class LoadPhase : int64_t {
+  kParse = 0,      // ModelProto::ParseFromString
+  kConstruct = 1,  // Model construction: initializer unpacking, function schemas, creating the nodes and subgraphs
+  kResolve = 2,    // Graph::Resolve: checking the nodes, topological sort, type and shape inference
+  kSession = 3,    // the whole of creating an InferenceSession from the serialized model
+};
+
+void AddValueInfo(ONNX_NAMESPACE::ValueInfoProto& value_info, const std::string& name, int64_t size) {
+  value_info.set_name(name);
+  auto* tensor_type = value_info.mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  tensor_type->mutable_shape()->add_dim()->set_dim_value(1);
+  tensor_type->mutable_shape()->add_dim()->set_dim_value(size);
+}
+
+ONNX_NAMESPACE::NodeProto& AddNode(google::protobuf::RepeatedPtrField<ONNX_NAMESPACE::NodeProto>& nodes,
+                                   const std::string& op_type, const std::vector<std::string>& inputs,
+                                   const std::string& output, const std::string& domain = "") {
+  auto* node = nodes.Add();
+  node->set_op_type(op_type);
+  node->set_domain(domain);
+  node->set_name(output);
+  for (const auto& input : inputs) {
+    node->add_input(input);
+  }
+  node->add_output(output);
+  return *node;
+}
+
+void AddInitializer(ONNX_NAMESPACE::GraphProto& graph, const std::string& name, const std::vector<int64_t>& dims) {
+  auto* tensor = graph.add_initializer();
+  tensor->set_name(name);
+  tensor->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  int64_t num_elements = 1;
+  for (auto dim : dims) {
+    tensor->add_dims(dim);
+    num_elements *= dim;
+  }
+  std::vector<float> data(static_cast<size_t>(num_elements), 0.01f);
+  tensor->set_raw_data(data.data(), data.size() * sizeof(float));
+}
+
+ONNX_NAMESPACE::GraphProto& AddBranch(ONNX_NAMESPACE::NodeProto& if_node, const std::string& name,
+                                      const std::string& op_type, const std::string& input, int64_t size) {
+  auto* attribute = if_node.add_attribute();
+  attribute->set_name(name);
+  attribute->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_GRAPH);
+  auto& branch = *attribute->mutable_g();
+  branch.set_name(if_node.name() + "_" + name);
+  const std::string output = branch.name() + "_out";
+  AddValueInfo(*branch.add_output(), output, size);
+  AddNode(*branch.mutable_node(), op_type, {input}, output);
+  return branch;
+}
+
+// A stack of layers that each have their own weights and their own model local function, and an If node every
+// few layers, to exercise all the phases of loading a large model:
+//
+//   h = Block_i(MatMul(h, W_i) + B_i), h = If(cond, Relu(h), Neg(h))
+std::string CreateLargeModel(int64_t num_layers, int64_t if_interval, int64_t size) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(8);
+  auto* opset = model.add_opset_import();
+  opset->set_domain("");
+  opset->set_version(17);
+  opset = model.add_opset_import();
+  opset->set_domain("local");
+  opset->set_version(1);
+
+  auto& graph = *model.mutable_graph();
+  graph.set_name("large_model");
+  AddValueInfo(*graph.add_input(), "X", size);
+
+  auto* cond = graph.add_initializer();
+  cond->set_name("cond");
+  cond->set_data_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  cond->add_int32_data(1);
+
+  std::string h = "X";
+  for (int64_t i = 0; i < num_layers; ++i) {
+    const std::string layer = std::to_string(i);
+
+    auto& function = *model.add_functions();
+    function.set_name("Block_" + layer);
+    function.set_domain("local");
+    function.add_input("x");
+    function.add_output("y");
+    auto* function_opset = function.add_opset_import();
+    function_opset->set_domain("");
+    function_opset->set_version(17);
+    AddNode(*function.mutable_node(), "Sigmoid", {"x"}, "s");
+    AddNode(*function.mutable_node(), "Mul", {"x", "s"}, "y");
+
+    AddInitializer(graph, "W_" + layer, {size, size});
+    AddInitializer(graph, "B_" + layer, {size});
+    AddNode(*graph.mutable_node(), "MatMul", {h, "W_" + layer}, "matmul_" + layer);
+    AddNode(*graph.mutable_node(), "Add", {"matmul_" + layer, "B_" + layer}, "add_" + layer);
+    AddNode(*graph.mutable_node(), "Block_" + layer, {"add_" + layer}, "block_" + layer, "local");
+    h = "block_" + layer;
+
+    if (if_interval > 0 && (i + 1) % if_interval == 0) {
+      auto& if_node = AddNode(*graph.mutable_node(), "If", {"cond"}, "if_" + layer);
+      AddBranch(if_node, "then_branch", "Relu", h, size);
+      AddBranch(if_node, "else_branch", "Neg", h, size);
+      h = "if_" + layer;
+    }
+  }
+
+  AddValueInfo(*graph.add_output(), h, size);
+
+  return model.SerializeAsString();
+}
+
+}  // namespace
+
+#define ORT_BREAK_ON_ERROR(expr)                                \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+// Times one phase of loading a large model. Threads is the size of the intra-op thread pool that the model is loaded
+// with, 1 loads it on the calling thread. Compare the phases to see where the startup time of a model goes, and the
+// thread counts to see how much of it the thread pool saves.
+static void BM_ModelLoad(benchmark::State& state) {
+  const auto phase = static_cast<LoadPhase>(state.range(0));
+  const int threads = static_cast<int>(state.range(1));
+  const int64_t num_layers = state.range(2);
+  const int64_t if_interval = state.range(3);
+  constexpr int64_t size = 256;
+  const std::string serialized = CreateLargeModel(num_layers, if_interval, size);
+
+  if (phase == LoadPhase::kSession) {
+    OrtSessionOptions* session_options = nullptr;
+    ORT_BREAK_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+    ORT_BREAK_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, threads));
+    ORT_BREAK_ON_ERROR(g_ort->AddSessionConfigEntry(session_options, kOrtSessionOptionsConfigParallelModelLoad,
+                                                    threads > 1 ? "1" : "0"));
+    for (auto _ : state) {
+      OrtSession* session = nullptr;
+      OrtStatus* status = g_ort->CreateSessionFromArray(env, serialized.data(), serialized.size(), session_options,
+                                                        &session);
+      if (status != nullptr) {
+        g_ort->ReleaseSessionOptions(session_options);
+      }
+      ORT_BREAK_ON_ERROR(status);
+      state.PauseTiming();
+      g_ort->ReleaseSession(session);
+      state.ResumeTiming();
+    }
+    g_ort->ReleaseSessionOptions(session_options);
+    return;
+  }
+
+  std::unique_ptr<concurrency::ThreadPool> tp;
+  if (threads > 1) {
+    OrtThreadPoolParams tpo;
+    tpo.thread_pool_size = threads;
+    tpo.auto_set_affinity = true;
+    tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+  }
+
+  auto logger = env->GetLoggingManager()->CreateLogger("test");
+  ModelOptions model_options;
+  model_options.thread_pool = tp.get();
+  Graph::ResolveOptions resolve_options;
+  resolve_options.no_proto_sync_required = true;
+  resolve_options.thread_pool = tp.get();
+
+  for (auto _ : state) {
+    ONNX_NAMESPACE::ModelProto model_proto;
+    if (phase != LoadPhase::kParse) {
+      state.PauseTiming();
+    }
+    if (!model_proto.ParseFromString(serialized)) {
+      state.SkipWithError("Failed to parse the model.");
+      return;
+    }
+    if (phase == LoadPhase::kParse) {
+      continue;
+    }
+
+    if (phase == LoadPhase::kConstruct) {
+      state.ResumeTiming();
+    }
+    auto model = std::make_unique<Model>(std::move(model_proto), PathString(), nullptr, *logger, model_options);
+
+    if (phase == LoadPhase::kConstruct) {
+      state.PauseTiming();
+    } else {
+      state.ResumeTiming();
+      auto status = model->MainGraph().Resolve(resolve_options);
+      state.PauseTiming();
+      if (!status.IsOK()) {
+        state.SkipWithError(status.ErrorMessage().c_str());
+        return;
+      }
+    }
+
+    model.reset();
+    state.ResumeTiming();
+  }
+}
+
+BENCHMARK(BM_ModelLoad)
+    ->ArgNames({"Phase", "Threads", "Layers", "IfInterval"})
+    ->ArgsProduct({
+        {static_cast<int64_t>(LoadPhase::kParse), static_cast<int64_t>(LoadPhase::kConstruct),
+         static_cast<int64_t>(LoadPhase::kResolve), static_cast<int64_t>(LoadPhase::kSession)},
+        {1, 4, 8},
+        {64, 512},
+        {4},
+    })
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMillisecond);
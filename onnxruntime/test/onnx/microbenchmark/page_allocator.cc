@@ -0,0 +1,132 @@
+#include "core/framework/cpu_page_allocator.h"
+#include "core/mlas/inc/mlas_qnbit.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace onnxruntime;
+
+// Runs the MatMulNBits kernel on the weights of several layers, with the weights allocated by a CPUPageAllocator.
+// A decode step (M = 1) streams every weight once per token. With regular pages each 4 KB of weights needs its own
+// TLB entry, and the weights of a large model are far beyond the TLB reach, so the step takes a TLB miss per page.
+// Compare the huge page modes to quantify the effect.
+static void BM_MatMulNBitsWeightPages(benchmark::State& state) {
+  constexpr size_t BlkBitWidth = 4;
+  constexpr size_t BlkLen = 32;
+  const auto huge_pages = static_cast<HugePageMode>(state.range(0));
+  const size_t num_layers = static_cast<size_t>(state.range(1));
+  const size_t M = static_cast<size_t>(state.range(2));
+  const size_t N = static_cast<size_t>(state.range(3));
+  const size_t K = static_cast<size_t>(state.range(4));
+  const auto compute_type = static_cast<MLAS_QNBIT_GEMM_COMPUTE_TYPE>(state.range(5));
+
+  if (!MlasIsQNBitGemmAvailable(BlkBitWidth, BlkLen, compute_type)) {
+    state.SkipWithMessage("QNBitGemm is not available with the given configuration on the current machine.");
+    return;
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> tp(
+      concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP));
+
+  CPUPageAllocatorOptions options;
+  options.huge_pages = huge_pages;
+  CPUPageAllocator allocator(OrtMemoryInfo(CPU, OrtDeviceAllocator), options);
+
+  const size_t block_count_k = (K + BlkLen - 1) / BlkLen;
+  const size_t quant_b_data_size = N * block_count_k * BlkLen * BlkBitWidth / 8;
+  const size_t quant_b_scale_size = N * block_count_k;
+  const size_t packed_b_data_size = MlasQNBitGemmPackQuantBDataSize(N, K, BlkBitWidth, BlkLen, false, compute_type);
+
+  std::default_random_engine generator(42);
+  std::uniform_int_distribution<int> data_distribution(0, 255);
+  std::uniform_real_distribution<float> scale_distribution(0.01f, 0.1f);
+
+  std::vector<uint8_t> quant_b_data(quant_b_data_size);
+  for (auto& value : quant_b_data) {
+    value = static_cast<uint8_t>(data_distribution(generator));
+  }
+
+  struct Layer {
+    void* b_data;
+    float* b_scale;
+  };
+
+  std::vector<Layer> layers(num_layers);
+  for (auto& layer : layers) {
+    layer.b_scale = static_cast<float*>(allocator.Alloc(quant_b_scale_size * sizeof(float)));
+    for (size_t i = 0; i < quant_b_scale_size; ++i) {
+      layer.b_scale[i] = scale_distribution(generator);
+    }
+
+    if (packed_b_data_size > 0) {
+      layer.b_data = allocator.Alloc(packed_b_data_size);
+      MlasQNBitGemmPackQuantBData(N, K, BlkBitWidth, BlkLen, compute_type, quant_b_data.data(), layer.b_data,
+                                  layer.b_scale, false, nullptr, tp.get());
+    } else {
+      layer.b_data = allocator.Alloc(quant_b_data_size);
+      memcpy(layer.b_data, quant_b_data.data(), quant_b_data_size);
+    }
+  }
+
+  std::vector<float> a(M * K, 0.5f);
+  std::vector<float> c(M * N);
+
+  std::unique_ptr<std::byte[]> workspace;
+  if (const auto workspace_size = MlasQNBitGemmBatchWorkspaceSize(M, N, K, 1, BlkBitWidth, BlkLen, false,
+                                                                  compute_type);
+      workspace_size > 0) {
+    workspace = std::make_unique<std::byte[]>(workspace_size);
+  }
+
+  const auto run_layers = [&]() {
+    for (const auto& layer : layers) {
+      MLAS_QNBIT_GEMM_DATA_PARAMS<float> params{};
+      params.A = a.data();
+      params.lda = K;
+      params.QuantBDataWorkspace = layer.b_data;
+      params.PackedQuantBData = packed_b_data_size > 0 ? static_cast<const std::byte*>(layer.b_data) : nullptr;
+      params.QuantBScale = layer.b_scale;
+      params.C = c.data();
+      params.ldc = N;
+      MlasQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, compute_type, &params, workspace.get(), tp.get());
+    }
+  };
+
+  // warm up run
+  run_layers();
+
+  for (auto _ : state) {
+    run_layers();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * num_layers *
+                                               (packed_b_data_size > 0 ? packed_b_data_size : quant_b_data_size)));
+
+  for (auto& layer : layers) {
+    allocator.Free(layer.b_data);
+    allocator.Free(layer.b_scale);
+  }
+}
+
+BENCHMARK(BM_MatMulNBitsWeightPages)
+    ->ArgNames({"HugePages", "Layers", "M", "N", "K", "ComputeType"})
+    ->ArgsProduct({
+        {static_cast<int64_t>(HugePageMode::kNone), static_cast<int64_t>(HugePageMode::kTransparent),
+         static_cast<int64_t>(HugePageMode::kExplicit2MB), static_cast<int64_t>(HugePageMode::kExplicit1GB)},
+        {1, 32},
+        {1},
+        {4096},
+        {4096, 11008},
+        {int64_t{SQNBIT_CompFp32}, int64_t{SQNBIT_CompInt8}},
+    })
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
@@ -22,6 +22,7 @@
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/mlas/inc/mlas_q4.h"
+#include "core/mlas/inc/mlas_qnbit.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
@@ -8307,6 +8308,69 @@ TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   }
 }
 
+TEST_F(GraphTransformationTests, SkipLayerNormQuantizeFusion) {
+  constexpr int64_t M = 3, K = 64, N = 16;
+  constexpr int64_t bits = 4;
+
+  auto add_matmul = [&](ModelTestBuilder& builder, NodeArg* A, int64_t block_size, bool with_zero_points,
+                        int64_t accuracy_level) {
+    const int64_t k_blocks = (K + block_size - 1) / block_size;
+    std::vector<NodeArg*> inputs{
+        A,
+        builder.MakeInitializer<uint8_t>({N, k_blocks, block_size * bits / 8}, uint8_t{0}, uint8_t{255}),
+        builder.MakeInitializer<float>({N, k_blocks}, 0.01f, 0.05f)};
+    if (with_zero_points) {
+      inputs.push_back(builder.MakeInitializer<uint8_t>({N, (k_blocks * bits + 7) / 8}, uint8_t{0}, uint8_t{255}));
+    }
+
+    auto& matmul = builder.AddNode("MatMulNBits", inputs, {builder.MakeOutput()}, kMSDomain);
+    matmul.AddAttribute("N", N);
+    matmul.AddAttribute("K", K);
+    matmul.AddAttribute("bits", bits);
+    matmul.AddAttribute("block_size", block_size);
+    matmul.AddAttribute("accuracy_level", accuracy_level);
+  };
+
+  for (bool simplified : {false, true}) {
+    for (bool with_zero_points : {false, true}) {
+      SCOPED_TRACE(MakeString("simplified:", simplified, ", with_zero_points:", with_zero_points));
+
+      auto build_test_case = [&](ModelTestBuilder& builder) {
+        auto* input = builder.MakeInput<float>({1, M, K}, -1.0f, 1.0f);
+        auto* skip = builder.MakeInput<float>({1, M, K}, -1.0f, 1.0f);
+        auto* gamma = builder.MakeInitializer<float>({K}, 0.5f, 1.5f);
+        auto* norm_output = builder.MakeIntermediate();
+        auto& norm = builder.AddNode(simplified ? "SkipSimplifiedLayerNormalization" : "SkipLayerNormalization",
+                                     {input, skip, gamma}, {norm_output}, kMSDomain);
+        norm.AddAttribute("epsilon", 1e-5f);
+
+        // The two consumers with the same B quantization share the quantized output, the others quantize it themselves.
+        add_matmul(builder, norm_output, 32, with_zero_points, 4);
+        add_matmul(builder, norm_output, 32, with_zero_points, 4);
+        add_matmul(builder, norm_output, 16, with_zero_points, 4);
+        add_matmul(builder, norm_output, 32, with_zero_points, 0);
+      };
+
+      // The int8 A layout is only available on some platforms.
+      const bool is_fusable = MlasQNBitGemmQuantizedASize(M, K, bits, 32, with_zero_points, SQNBIT_CompInt8) > 0;
+
+      auto check_graph = [&](InferenceSessionWrapper& session) {
+        int fused_matmul_count = 0;
+        for (const auto& node : session.GetGraph().Nodes()) {
+          if (node.OpType() == "MatMulNBits" && node.InputDefs().size() > 6 && node.InputDefs()[6]->Exists()) {
+            ++fused_matmul_count;
+          }
+        }
+        EXPECT_EQ(fused_matmul_count, is_fusable ? 2 : 0);
+      };
+
+      // The MatMulNBits nodes read the same int8 blocks as when they quantize the output of the norm themselves.
+      TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 21,
+                        1e-5, 1e-5);
+    }
+  }
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
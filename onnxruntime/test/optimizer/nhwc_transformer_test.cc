@@ -8,7 +8,9 @@
 #include "graph_transform_test_builder.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -533,6 +535,59 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+TEST(NhwcTransformerTests, ConvFp32) {
+  DNNL_GTEST_SKIP();
+
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       bool enable_nhwc_fp32_conv, bool nchwc_supported = false) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.0f, 1.0f);
+      auto* conv_output_arg = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>(weights_shape, -1.0f, 1.0f);
+
+      builder.AddConvNode(input_arg, weight_arg, conv_output_arg);
+      builder.AddNode("Relu", {conv_output_arg}, {output_arg});
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      if (enable_nhwc_fp32_conv) {
+        EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+        EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 0);
+        EXPECT_EQ(op_to_count["Transpose"], 2);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 0);
+        // Otherwise the NCHWc layout transformer claims the convolution on the platforms that support it.
+        if (nchwc_supported && MlasNchwcGetBlockSize() > 1) {
+          EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 1);
+        }
+      }
+    };
+
+    auto add_session_options = [&](SessionOptions& session_options) {
+      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableNhwcFp32Conv,
+                                                                     enable_nhwc_fp32_conv ? "1" : "0"));
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12,
+                      1e-4,
+                      1e-4,
+                      nullptr,
+                      add_session_options);
+  };
+
+  test_case({1, 12, 37}, {32, 12, 5}, true);
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3}, true);
+  test_case({2, 16, 9, 9}, {16, 16, 1, 1}, true, true);
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3}, false);
+  test_case({2, 16, 9, 9}, {16, 16, 1, 1}, false, true);
+}
+
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 static std::vector<MLFloat16> ARangeOfFP16Values(const std::vector<int64_t>& shape, MLFloat16 min, MLFloat16 max) {
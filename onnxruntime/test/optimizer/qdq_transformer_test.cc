@@ -2767,6 +2767,145 @@ TEST(QDQTransformerTests, Sigmoid_U8S8) {
   QDQTransformerSigmoidTests<uint8_t, int8_t>();
 }
 
+TEST(QDQTransformerTests, Gelu) {
+  auto test_case = [&](const std::string& domain, int opset_version) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({1, 12, 37}, -4.f, 4.f);
+      auto* output_arg = builder.MakeOutput();
+      auto* dq_output = AddQDQNodePair<int8_t>(builder, input_arg, .032f, 0);
+      auto* gelu_output = builder.MakeIntermediate();
+      builder.AddNode("Gelu", {dq_output}, {gelu_output}, domain);
+
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<int8_t>(gelu_output, .032f, -100, q_output);
+      builder.AddDequantizeLinearNode<int8_t>(q_output, .032f, -100, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 1);
+      EXPECT_EQ(op_to_count["Gelu"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.Gelu"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      opset_version,
+                      0.04 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case(kMSDomain, 18);
+  test_case(kOnnxDomain, 20);
+}
+
+TEST(QDQTransformerTests, LayerNormalization) {
+  auto test_case = [&](bool has_bias) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({2, 3, 16}, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      auto* dq_output = AddQDQNodePair<int8_t>(builder, input_arg, .008f, 0);
+
+      auto* scale = builder.MakeInitializer<int8_t>({16}, 32, 127);
+      auto* dq_scale_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<int8_t>(scale, .01f, 0, dq_scale_output);
+      std::vector<NodeArg*> input_args{dq_output, dq_scale_output};
+
+      if (has_bias) {
+        auto* bias = builder.MakeInitializer<int32_t>({16}, -500, 500);
+        auto* dq_bias_output = builder.MakeIntermediate();
+        builder.AddDequantizeLinearNode<int32_t>(bias, .00008f, 0, dq_bias_output);
+        input_args.push_back(dq_bias_output);
+      }
+
+      auto* layer_norm_output = builder.MakeIntermediate();
+      auto& layer_norm_node = builder.AddNode("LayerNormalization", input_args, {layer_norm_output});
+      layer_norm_node.AddAttribute("axis", static_cast<int64_t>(-1));
+
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<int8_t>(layer_norm_output, .03f, 0, q_output);
+      builder.AddDequantizeLinearNode<int8_t>(q_output, .03f, 0, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 1);
+      EXPECT_EQ(op_to_count["LayerNormalization"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      17 /*opset_version*/,
+                      0.04 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case(false);
+  test_case(true);
+}
+
+// QLinearLayerNormalization has no B zero point input and only supports per-tensor quantization parameters
+TEST(QDQTransformerTests, LayerNormalization_NotFused) {
+  auto test_case = [&](bool per_channel_scale, int32_t bias_zero_point) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({2, 3, 16}, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      auto* dq_output = AddQDQNodePair<int8_t>(builder, input_arg, .008f, 0);
+
+      auto* scale = builder.MakeInitializer<int8_t>({16}, 32, 127);
+      auto* dq_scale_output = builder.MakeIntermediate();
+      if (per_channel_scale) {
+        builder.AddDequantizeLinearNode<int8_t>(scale, std::vector<float>(16, .01f), std::vector<int8_t>(16, 0),
+                                                dq_scale_output)
+            .AddAttribute("axis", static_cast<int64_t>(0));
+      } else {
+        builder.AddDequantizeLinearNode<int8_t>(scale, .01f, 0, dq_scale_output);
+      }
+
+      auto* bias = builder.MakeInitializer<int32_t>({16}, -500, 500);
+      auto* dq_bias_output = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<int32_t>(bias, .00008f, bias_zero_point, dq_bias_output);
+
+      auto* layer_norm_output = builder.MakeIntermediate();
+      auto& layer_norm_node = builder.AddNode("LayerNormalization", {dq_output, dq_scale_output, dq_bias_output},
+                                              {layer_norm_output});
+      layer_norm_node.AddAttribute("axis", static_cast<int64_t>(-1));
+
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<int8_t>(layer_norm_output, .03f, 0, q_output);
+      builder.AddDequantizeLinearNode<int8_t>(q_output, .03f, 0, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 0);
+      EXPECT_EQ(op_to_count["LayerNormalization"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      17 /*opset_version*/,
+                      0.04 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case(true, 0);
+  test_case(false, 20);
+}
+
 TEST(QDQTransformerTests, ConvTranspose_QBackward) {
   DNNL_GTEST_SKIP();
 
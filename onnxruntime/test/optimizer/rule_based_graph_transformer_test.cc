@@ -6,10 +6,15 @@
 #include "gtest/gtest.h"
 
 #include "asserts.h"
+#include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/graph_transformer_utils.h"
+#include "core/optimizer/identity_elimination.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "dummy_graph_transformer.h"
 #include "test/framework/test_utils.h"
 #include "test/test_environment.h"
@@ -71,5 +76,175 @@ TEST(RuleBasedGraphTransformerTest, TestSettingStepsInGraphTransformerManager) {
   ASSERT_STATUS_OK(graph_transformation_mgr.GetSteps(steps_queried));
   ASSERT_EQ(steps_queried, static_cast<unsigned>(10));
 }
+
+namespace {
+// Graph transformer that does nothing, but declares the op types it targets.
+class TargetedGraphTransformer : public GraphTransformer {
+ public:
+  TargetedGraphTransformer(const std::string& name, InlinedVector<std::string> target_op_types)
+      : GraphTransformer(name), target_op_types_(std::move(target_op_types)) {}
+
+  InlinedVector<std::string> TargetOpTypes() const override { return target_op_types_; }
+
+ private:
+  Status ApplyImpl(Graph& /*graph*/, bool& /*modified*/, int /*graph_level*/, const logging::Logger&) const override {
+    return Status::OK();
+  }
+
+  const InlinedVector<std::string> target_op_types_;
+};
+
+// Graph transformer that makes the shape input of the Reshape nodes the constant {4}, so that resolving the graph
+// refines the shapes of the nodes downstream.
+class ConstantReshapeTransformer : public GraphTransformer {
+ public:
+  ConstantReshapeTransformer() : GraphTransformer("ConstantReshapeTransformer") {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/, const logging::Logger&) const override {
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() != "Reshape" || graph_utils::IsConstantInitializer(graph, node.InputDefs()[1]->Name())) {
+        continue;
+      }
+
+      TensorProto shape;
+      shape.set_name(graph.GenerateNodeArgName("reshape_shape"));
+      shape.set_data_type(TensorProto_DataType_INT64);
+      shape.add_dims(1);
+      shape.add_int64_data(4);
+      graph_utils::ReplaceNodeInput(node, 1, graph_utils::AddInitializer(graph, shape));
+      modified = true;
+    }
+    return Status::OK();
+  }
+};
+}  // namespace
+
+TEST(RuleBasedGraphTransformerTest, TestIncrementalStepsSkipUnaffectedTransformers) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("graph", false, logger);
+  Graph& graph = model.MainGraph();
+
+  // X -> Identity -> Relu -> Y
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& identity_out = graph.GetOrCreateNodeArg("identity_out", &tensor_float);
+  auto& y = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("identity", "Identity", "", {&x}, {&identity_out});
+  graph.AddNode("relu", "Relu", "", {&identity_out}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto rule_transformer = std::make_unique<RuleBasedGraphTransformer>("IdentityTransformer");
+  ASSERT_STATUS_OK(rule_transformer->Register(std::make_unique<EliminateIdentity>()));
+
+  // register the transformers that do nothing first, so they see the changes made by the rule-based transformer
+  // in the next step.
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<TargetedGraphTransformer>("AnyOpTransformer", InlinedVector<std::string>{}),
+      TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<TargetedGraphTransformer>("GemmTransformer", InlinedVector<std::string>{"Gemm"}),
+      TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(rule_transformer), TransformerLevel::Level1));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, logger));
+  ASSERT_TRUE(graph_transformation_mgr.IsGraphModified());
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+
+  // The Identity node was removed in the first step. In the second step only the Relu node changed, so the
+  // transformers that target other op types are skipped, and the transformer without target op types is applied.
+  const auto& stats = graph_transformation_mgr.GetTransformerStats();
+  ASSERT_EQ(stats.at("IdentityTransformer").num_runs, 1u);
+  ASSERT_EQ(stats.at("IdentityTransformer").num_skipped, 1u);
+  ASSERT_EQ(stats.at("IdentityTransformer").num_modified, 1u);
+  ASSERT_EQ(stats.at("GemmTransformer").num_runs, 1u);
+  ASSERT_EQ(stats.at("GemmTransformer").num_skipped, 1u);
+  ASSERT_EQ(stats.at("AnyOpTransformer").num_runs, 2u);
+  ASSERT_EQ(stats.at("AnyOpTransformer").num_skipped, 0u);
+}
+
+TEST(RuleBasedGraphTransformerTest, TestIncrementalStepsRevisitRefinedShapes) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("graph", false, logger);
+  Graph& graph = model.MainGraph();
+
+  // X, S -> Reshape -> Relu -> Relu -> Expand({4}) -> Relu -> Y
+  // The output of the Reshape has an unknown dimension while its shape input S is not constant.
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto tensor_int64;
+  tensor_int64.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  tensor_int64.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  TensorProto expand_shape;
+  expand_shape.set_name("expand_shape");
+  expand_shape.set_data_type(TensorProto_DataType_INT64);
+  expand_shape.add_dims(1);
+  expand_shape.add_int64_data(4);
+  graph.AddInitializedTensor(expand_shape);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &tensor_float);
+  auto& s = graph.GetOrCreateNodeArg("S", &tensor_int64);
+  auto& reshape_out = graph.GetOrCreateNodeArg("reshape_out", nullptr);
+  auto& relu1_out = graph.GetOrCreateNodeArg("relu1_out", nullptr);
+  auto& relu2_out = graph.GetOrCreateNodeArg("relu2_out", nullptr);
+  auto& expand_out = graph.GetOrCreateNodeArg("expand_out", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("reshape", "Reshape", "", {&x, &s}, {&reshape_out});
+  graph.AddNode("relu1", "Relu", "", {&reshape_out}, {&relu1_out});
+  graph.AddNode("relu2", "Relu", "", {&relu1_out}, {&relu2_out});
+  graph.AddNode("expand", "Expand", "", {&relu2_out, graph.GetNodeArg("expand_shape")}, {&expand_out});
+  graph.AddNode("relu3", "Relu", "", {&expand_out}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_EQ(CountOpsInGraph(graph)["Expand"], 1);
+
+  // The Expand is eliminated in the second step, after the Reshape two nodes away became constant in the first
+  // step and resolving the graph refined the input shape of the Expand.
+  auto rule_transformer = std::make_unique<RuleBasedGraphTransformer>("ExpandTransformer");
+  ASSERT_STATUS_OK(rule_transformer->Register(std::make_unique<ExpandElimination>()));
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(rule_transformer), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ConstantReshapeTransformer>(),
+                                                     TransformerLevel::Level1));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, logger));
+  ASSERT_EQ(CountOpsInGraph(graph)["Expand"], 0);
+  ASSERT_EQ(graph_transformation_mgr.GetTransformerStats().at("ExpandTransformer").num_modified, 1u);
+}
+
+TEST(RuleBasedGraphTransformerTest, TestIncrementalStepsMatchFullSteps) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  auto model_uri = ORT_TSTR("testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx");
+  CPUExecutionProvider cpu_ep(CPUExecutionProviderInfo{});
+
+  auto optimize = [&](bool incremental, OpCountMap& op_counts) {
+    std::shared_ptr<Model> model;
+    ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, logger));
+    Graph& graph = model->MainGraph();
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    graph_transformation_mgr.SetIncremental(incremental);
+    for (auto level : {TransformerLevel::Level1, TransformerLevel::Level2}) {
+      for (auto& transformer : optimizer_utils::GenerateTransformers(level, {}, cpu_ep, logger)) {
+        ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(transformer), level));
+      }
+      ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, level, logger));
+    }
+
+    op_counts = CountOpsInGraph(graph);
+  };
+
+  OpCountMap full_op_counts;
+  OpCountMap incremental_op_counts;
+  optimize(false, full_op_counts);
+  optimize(true, incremental_op_counts);
+  ASSERT_EQ(full_op_counts, incremental_op_counts);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
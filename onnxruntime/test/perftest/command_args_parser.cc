@@ -39,6 +39,15 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding. Free dimensions are treated as 1 unless overridden using -f.\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-a [arrival]: Issue requests in an open loop on an arrival schedule instead of back to back. "
+      "Value could be 'poisson:<requests per second>', 'constant:<requests per second>' or 'trace:<file>'.\n"
+      "\t\tA trace file has one arrival time in seconds per line. The requests are served by the number of threads "
+      "given by -c, and the response time of each request is measured from its scheduled arrival, so that queueing "
+      "delay is included.\n"
+      "\t-k [p99_latency_slo_ms]: With -a, search for the highest arrival rate whose P99 response time is within "
+      "the given number of milliseconds, starting from the rate given by -a. Each rate runs for the duration given by -t "
+      "or the number of requests given by -r.\n"
+      "\t-H [histogram_file]: Write the latency distribution to a file in the HdrHistogram percentile format (.hgrm).\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|dml|acl|nnapi|coreml|qnn|snpe|rocm|migraphx|xnnpack|vitisai|webgpu]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'nvtensorrtrtx', 'openvino', 'dml', 'acl', 'nnapi', 'coreml', 'qnn', 'snpe', 'rocm', 'migraphx', 'xnnpack', 'vitisai' or 'webgpu'. "
       "Default:'cpu'.\n"
@@ -173,6 +182,38 @@ static const ORTCHAR_T* overrideDelimiter = L":";
 #else
 static const ORTCHAR_T* overrideDelimiter = ":";
 #endif
+static bool ParseArrivalMode(PerformanceTestConfig& test_config) {
+  std::basic_string<ORTCHAR_T> arrival_str(optarg);
+  size_t delimiter_location = arrival_str.find(overrideDelimiter);
+  if (delimiter_location == std::basic_string<ORTCHAR_T>::npos || delimiter_location >= arrival_str.size() - 1) {
+    return false;
+  }
+  std::string mode = ToUTF8String(arrival_str.substr(0, delimiter_location));
+  std::basic_string<ORTCHAR_T> value = arrival_str.substr(delimiter_location + 1);
+
+  if (mode == "trace") {
+    test_config.run_config.arrival_mode = ArrivalMode::kTrace;
+    test_config.run_config.arrival_trace_file = value;
+    return true;
+  }
+
+  if (mode == "poisson") {
+    test_config.run_config.arrival_mode = ArrivalMode::kPoisson;
+  } else if (mode == "constant") {
+    test_config.run_config.arrival_mode = ArrivalMode::kConstant;
+  } else {
+    return false;
+  }
+
+  ORT_TRY {
+    test_config.run_config.arrival_rate = std::stod(ToUTF8String(value));
+  }
+  ORT_CATCH(...) {
+    return false;
+  }
+  return test_config.run_config.arrival_rate > 0;
+}
+
 static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier, int64_t& override_val) {
   std::basic_string<ORTCHAR_T> free_dim_str(optarg);
   size_t delimiter_location = free_dim_str.find(overrideDelimiter);
@@ -195,7 +236,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqznlgR:X"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:a:k:H:AMPIDZvhsqznlgR:X"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -404,6 +445,25 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       case 'X':
         test_config.run_config.use_extensions = true;
         break;
+      case 'a':
+        if (!ParseArrivalMode(test_config)) {
+          return false;
+        }
+        break;
+      case 'k':
+        ORT_TRY {
+          test_config.run_config.latency_slo_p99_ms = std::stod(ToUTF8String(optarg));
+        }
+        ORT_CATCH(...) {
+          return false;
+        }
+        if (test_config.run_config.latency_slo_p99_ms <= 0) {
+          return false;
+        }
+        break;
+      case 'H':
+        test_config.run_config.histogram_file = optarg;
+        break;
       case '?':
       case 'h':
       default:
@@ -426,6 +486,12 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       return false;
   }
 
+  // the rate sweep needs an open loop arrival schedule
+  if (test_config.run_config.latency_slo_p99_ms > 0 &&
+      test_config.run_config.arrival_mode == ArrivalMode::kClosedLoop) {
+    return false;
+  }
+
   test_config.model_info.model_file_path = argv[0];
 
   return true;
@@ -0,0 +1,181 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+int MostSignificantBit(uint64_t value) {
+  int bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram(int sub_bucket_bits)
+    : sub_bucket_bits_(sub_bucket_bits),
+      sub_bucket_count_(uint64_t{1} << sub_bucket_bits),
+      sub_bucket_half_count_(uint64_t{1} << (sub_bucket_bits - 1)) {
+  // the exact range, then one half-sized set of sub-buckets for each power of two up to 2^63
+  const size_t ranges = static_cast<size_t>(64 - sub_bucket_bits);
+  counts_.resize(static_cast<size_t>(sub_bucket_count_ + ranges * sub_bucket_half_count_));
+}
+
+size_t LatencyHistogram::IndexOf(uint64_t value) const {
+  if (value < sub_bucket_count_) {
+    return static_cast<size_t>(value);
+  }
+
+  const int shift = MostSignificantBit(value) - (sub_bucket_bits_ - 1);
+  const uint64_t sub_bucket = value >> shift;
+  return static_cast<size_t>(sub_bucket_count_ + (shift - 1) * sub_bucket_half_count_ +
+                             (sub_bucket - sub_bucket_half_count_));
+}
+
+uint64_t LatencyHistogram::LowestEquivalentValue(size_t index) const {
+  if (index < sub_bucket_count_) {
+    return index;
+  }
+
+  const uint64_t shift = (index - sub_bucket_count_) / sub_bucket_half_count_ + 1;
+  const uint64_t sub_bucket = (index - sub_bucket_count_) % sub_bucket_half_count_ + sub_bucket_half_count_;
+  return sub_bucket << shift;
+}
+
+uint64_t LatencyHistogram::HighestEquivalentValue(size_t index) const {
+  if (index < sub_bucket_count_) {
+    return index;
+  }
+
+  const uint64_t shift = (index - sub_bucket_count_) / sub_bucket_half_count_ + 1;
+  return LowestEquivalentValue(index) + (uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::Record(double seconds) {
+  const uint64_t value = static_cast<uint64_t>(std::max(seconds, 0.0) * 1e9);
+  counts_[IndexOf(value)]++;
+  total_count_++;
+  min_value_ = std::min(min_value_, value);
+  max_value_ = std::max(max_value_, value);
+  sum_ += static_cast<double>(value);
+  sum_of_squares_ += static_cast<double>(value) * static_cast<double>(value);
+}
+
+void LatencyHistogram::Reset() {
+  std::fill(counts_.begin(), counts_.end(), uint64_t{0});
+  total_count_ = 0;
+  min_value_ = UINT64_MAX;
+  max_value_ = 0;
+  sum_ = 0;
+  sum_of_squares_ = 0;
+}
+
+double LatencyHistogram::Min() const {
+  return total_count_ == 0 ? 0.0 : static_cast<double>(min_value_) * 1e-9;
+}
+
+double LatencyHistogram::Max() const {
+  return static_cast<double>(max_value_) * 1e-9;
+}
+
+double LatencyHistogram::Mean() const {
+  return total_count_ == 0 ? 0.0 : sum_ / static_cast<double>(total_count_) * 1e-9;
+}
+
+double LatencyHistogram::StdDeviation() const {
+  if (total_count_ == 0) {
+    return 0.0;
+  }
+
+  const double mean = sum_ / static_cast<double>(total_count_);
+  const double variance = sum_of_squares_ / static_cast<double>(total_count_) - mean * mean;
+  return std::sqrt(std::max(variance, 0.0)) * 1e-9;
+}
+
+uint64_t LatencyHistogram::ValueAtCount(uint64_t count) const {
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    cumulative += counts_[i];
+    if (cumulative >= count) {
+      return std::min(HighestEquivalentValue(i), max_value_);
+    }
+  }
+  return max_value_;
+}
+
+double LatencyHistogram::ValueAtPercentile(double percentile) const {
+  if (total_count_ == 0) {
+    return 0.0;
+  }
+
+  const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t count = static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(total_count_)));
+  count = std::min(std::max(count, uint64_t{1}), total_count_);
+  return static_cast<double>(ValueAtCount(count)) * 1e-9;
+}
+
+void LatencyHistogram::OutputPercentileDistribution(std::ostream& os, int ticks_per_half_distance) const {
+  constexpr double kNanosecondsPerMillisecond = 1e6;
+  char line[256];
+
+  snprintf(line, sizeof(line), "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+  os << line;
+
+  if (total_count_ > 0) {
+    double percentile = 0.0;
+    for (;;) {
+      uint64_t count = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_count_)));
+      count = std::min(std::max(count, uint64_t{1}), total_count_);
+      const uint64_t value = ValueAtCount(count);
+
+      // the number of recorded values that are equivalent to or below value
+      uint64_t cumulative = 0;
+      const size_t value_index = IndexOf(value);
+      for (size_t i = 0; i <= value_index; ++i) {
+        cumulative += counts_[i];
+      }
+
+      if (cumulative >= total_count_) {
+        break;
+      }
+
+      snprintf(line, sizeof(line), "%12.3f %2.12f %10llu %14.2f\n",
+               static_cast<double>(value) / kNanosecondsPerMillisecond, percentile / 100.0,
+               static_cast<unsigned long long>(cumulative), 1.0 / (1.0 - percentile / 100.0));
+      os << line;
+
+      // report with increasing resolution as the percentile approaches 100
+      const double half_distance = std::floor(std::log2(100.0 / (100.0 - percentile))) + 1;
+      const double ticks = ticks_per_half_distance * std::pow(2.0, half_distance);
+      percentile += 100.0 / ticks;
+    }
+
+    snprintf(line, sizeof(line), "%12.3f %2.12f %10llu\n", static_cast<double>(max_value_) / kNanosecondsPerMillisecond,
+             1.0, static_cast<unsigned long long>(total_count_));
+    os << line;
+  }
+
+  snprintf(line, sizeof(line), "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", Mean() * 1e3,
+           StdDeviation() * 1e3);
+  os << line;
+  snprintf(line, sizeof(line), "#[Max     = %12.3f, Total count    = %12llu]\n", Max() * 1e3,
+           static_cast<unsigned long long>(total_count_));
+  os << line;
+  snprintf(line, sizeof(line), "#[Buckets = %12llu, SubBuckets     = %12llu]\n",
+           static_cast<unsigned long long>(64 - sub_bucket_bits_ + 1),
+           static_cast<unsigned long long>(sub_bucket_count_));
+  os << line;
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace onnxruntime {
+namespace perftest {
+
+// LatencyHistogram records latencies with a bounded relative error in the manner of HdrHistogram.
+// Values are recorded in nanoseconds. Values below 2^sub_bucket_bits are counted exactly, and each power of two
+// range above that is split into 2^(sub_bucket_bits - 1) linear sub-buckets, so the relative error of a reported
+// value is below 2^-(sub_bucket_bits - 1). The default of 11 bits keeps 3 significant decimal digits.
+class LatencyHistogram {
+ public:
+  explicit LatencyHistogram(int sub_bucket_bits = 11);
+
+  void Record(double seconds);
+  void Reset();
+
+  uint64_t TotalCount() const { return total_count_; }
+  double Min() const;
+  double Max() const;
+  double Mean() const;
+  double StdDeviation() const;
+
+  // Returns the latency in seconds at or below which the given percentage of the recorded values fall.
+  double ValueAtPercentile(double percentile) const;
+
+  // Writes the percentile distribution in the HdrHistogram text format (.hgrm) that the HdrHistogram plotter reads.
+  // Values are written in milliseconds.
+  void OutputPercentileDistribution(std::ostream& os, int ticks_per_half_distance = 5) const;
+
+ private:
+  size_t IndexOf(uint64_t value) const;
+  uint64_t LowestEquivalentValue(size_t index) const;
+  uint64_t HighestEquivalentValue(size_t index) const;
+  uint64_t ValueAtCount(uint64_t count) const;
+
+  int sub_bucket_bits_;
+  uint64_t sub_bucket_count_;
+  uint64_t sub_bucket_half_count_;
+  std::vector<uint64_t> counts_;
+  uint64_t total_count_{0};
+  uint64_t min_value_{UINT64_MAX};
+  uint64_t max_value_{0};
+  double sum_{0};
+  double sum_of_squares_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -7,7 +7,13 @@
 #endif
 
 #include "performance_runner.h"
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <limits>
+#include <thread>
+
+#include "latency_histogram.h"
 
 #include "TestCase.h"
 #include "utils.h"
@@ -109,6 +115,30 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
 
     output_stats(std::cout);
   }
+
+  if (!response_times.empty() && f_include_statistics) {
+    LatencyHistogram histogram;
+    for (double response_time : response_times) {
+      histogram.Record(response_time);
+    }
+
+    auto output_response_stats = [&](std::ostream& ostream) {
+      ostream << "Arrival rate: " << arrival_rate << " requests/s\n";
+      ostream << "Response time is measured from the scheduled arrival of each request\n";
+      ostream << "P50 Response Time: " << histogram.ValueAtPercentile(50) << " s\n";
+      ostream << "P90 Response Time: " << histogram.ValueAtPercentile(90) << " s\n";
+      ostream << "P99 Response Time: " << histogram.ValueAtPercentile(99) << " s\n";
+      ostream << "P999 Response Time: " << histogram.ValueAtPercentile(99.9) << " s\n";
+      ostream << "Max Response Time: " << histogram.Max() << " s" << std::endl;
+    };
+
+    if (have_file) {
+      outfile << std::endl;
+      output_response_stats(outfile);
+    }
+
+    output_response_stats(std::cout);
+  }
 }
 
 void PerformanceRunner::LogSessionCreationTime() {
@@ -131,17 +161,28 @@ Status PerformanceRunner::Run() {
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  const auto& run_config = performance_test_config_.run_config;
+  if (run_config.arrival_mode != ArrivalMode::kClosedLoop) {
+    // the open loop runs record their own start and end, as the rate sweep keeps the result of one of its runs
+    if (run_config.latency_slo_p99_ms > 0) {
+      ORT_RETURN_IF_ERROR(FindMaxArrivalRate());
+    } else {
+      ORT_RETURN_IF_ERROR(RunOpenLoop(run_config.arrival_mode == ArrivalMode::kTrace ? arrival_trace_rate_
+                                                                                     : run_config.arrival_rate));
+    }
+  } else {
+    switch (run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
+    performance_result_.end = std::chrono::high_resolution_clock::now();
   }
-  performance_result_.end = std::chrono::high_resolution_clock::now();
 
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
   performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
@@ -165,6 +206,10 @@ Status PerformanceRunner::Run() {
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
 
+  if (!run_config.histogram_file.empty()) {
+    ORT_RETURN_IF_ERROR(WriteHistogram());
+  }
+
   return Status::OK();
 }
 
@@ -255,6 +300,198 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::GenerateArrivals(double arrival_rate, std::vector<double>& arrivals) {
+  const auto& run_config = performance_test_config_.run_config;
+  ORT_RETURN_IF_NOT(arrival_rate > 0, "Arrival rate must be positive.");
+
+  // the schedule covers the test duration or the requested number of runs
+  const bool fix_duration = run_config.test_mode == TestMode::kFixDurationMode;
+  const double duration = static_cast<double>(run_config.duration_in_seconds);
+  const size_t max_requests = fix_duration ? std::numeric_limits<size_t>::max() : run_config.repeated_times;
+
+  arrivals.clear();
+  if (run_config.arrival_mode == ArrivalMode::kTrace) {
+    // replay the trace compressed or stretched in time to the requested rate
+    const double scale = arrival_trace_rate_ / arrival_rate;
+    for (double arrival : arrival_trace_) {
+      const double scheduled = (arrival - arrival_trace_.front()) * scale;
+      if (arrivals.size() >= max_requests || (fix_duration && scheduled >= duration)) {
+        break;
+      }
+      arrivals.push_back(scheduled);
+    }
+    return Status::OK();
+  }
+
+  std::exponential_distribution<double> poisson_interval(arrival_rate);
+  double scheduled = 0;
+  while (arrivals.size() < max_requests && !(fix_duration && scheduled >= duration)) {
+    arrivals.push_back(scheduled);
+    scheduled += run_config.arrival_mode == ArrivalMode::kPoisson ? poisson_interval(arrival_generator_)
+                                                                  : 1.0 / arrival_rate;
+  }
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunOpenLoop(double arrival_rate) {
+  using clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+
+  std::vector<double> arrivals;
+  ORT_RETURN_IF_ERROR(GenerateArrivals(arrival_rate, arrivals));
+
+  performance_result_.arrival_rate = arrival_rate;
+  performance_result_.response_times.reserve(arrivals.size());
+  performance_result_.time_costs.reserve(arrivals.size());
+
+  // the scheduled arrival of the requests waiting to be served
+  std::deque<clock::time_point> pending;
+  bool arrivals_done = false;
+  size_t workers = std::max(run_config.concurrent_session_runs, size_t{1});
+  std::mutex m;
+  std::condition_variable pending_cv;
+  std::condition_variable done_cv;
+
+  // create a threadpool with one thread per concurrent request
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(workers));
+  for (size_t i = 0, num_workers = workers; i != num_workers; ++i) {
+    tpool->Schedule([this, &pending, &arrivals_done, &workers, &m, &pending_cv, &done_cv]() {
+      for (;;) {
+        clock::time_point scheduled;
+        {
+          std::unique_lock<std::mutex> lock(m);
+          pending_cv.wait(lock, [&]() { return !pending.empty() || arrivals_done; });
+          if (pending.empty()) {
+            break;
+          }
+          scheduled = pending.front();
+          pending.pop_front();
+        }
+
+        auto status = RunOneIteration<false>();
+        if (!status.IsOK())
+          std::cerr << status.ErrorMessage();
+
+        // measuring from the scheduled arrival rather than the start of the run includes the time the request
+        // waited, which a closed loop omits as it doesn't issue requests while the previous ones are slow.
+        std::chrono::duration<double> response_time = clock::now() - scheduled;
+        std::lock_guard<std::mutex> guard(results_mutex_);
+        performance_result_.response_times.push_back(response_time.count());
+      }
+
+      // Simplified version of Eigen::Barrier
+      std::lock_guard<std::mutex> lg(m);
+      workers--;
+      done_cv.notify_all();
+    });
+  }
+
+  // issue the requests on schedule, whether or not the earlier requests have completed
+  performance_result_.start = clock::now();
+  for (double arrival : arrivals) {
+    const auto scheduled = performance_result_.start +
+                           std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(arrival));
+    std::this_thread::sleep_until(scheduled);
+    {
+      std::lock_guard<std::mutex> lg(m);
+      pending.push_back(scheduled);
+    }
+    pending_cv.notify_one();
+  }
+
+  {
+    std::lock_guard<std::mutex> lg(m);
+    arrivals_done = true;
+  }
+  pending_cv.notify_all();
+
+  // Join
+  std::unique_lock<std::mutex> lock(m);
+  done_cv.wait(lock, [&workers]() { return workers == 0; });
+  performance_result_.end = clock::now();
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::FindMaxArrivalRate() {
+  const auto& run_config = performance_test_config_.run_config;
+  const double slo = run_config.latency_slo_p99_ms / 1000.0;
+
+  // stop when the highest passing and lowest failing rates are within 5% of each other
+  constexpr int kMaxRuns = 16;
+  constexpr double kRateTolerance = 0.05;
+
+  double arrival_rate = run_config.arrival_mode == ArrivalMode::kTrace ? arrival_trace_rate_
+                                                                       : run_config.arrival_rate;
+  double passing_rate = 0;
+  double failing_rate = 0;
+  PerformanceResult passing_result;
+
+  for (int i = 0; i < kMaxRuns; ++i) {
+    performance_result_.time_costs.clear();
+    performance_result_.response_times.clear();
+    performance_result_.total_time_cost = 0;
+    ORT_RETURN_IF_ERROR(RunOpenLoop(arrival_rate));
+
+    LatencyHistogram histogram;
+    for (double response_time : performance_result_.response_times) {
+      histogram.Record(response_time);
+    }
+    const double p99 = histogram.ValueAtPercentile(99);
+    const bool pass = p99 <= slo;
+    std::cout << "Arrival rate: " << arrival_rate << " requests/s, P99 response time: " << p99 * 1000 << " ms"
+              << (pass ? " (within SLO)" : " (exceeds SLO)") << std::endl;
+
+    if (pass) {
+      passing_rate = arrival_rate;
+      passing_result = performance_result_;
+    } else {
+      failing_rate = arrival_rate;
+    }
+
+    if (passing_rate > 0 && failing_rate > 0 && failing_rate - passing_rate <= kRateTolerance * passing_rate) {
+      break;
+    }
+
+    // double until a rate fails, halve until a rate passes, then bisect
+    if (failing_rate == 0) {
+      arrival_rate *= 2;
+    } else if (passing_rate == 0) {
+      arrival_rate /= 2;
+    } else {
+      arrival_rate = (passing_rate + failing_rate) / 2;
+    }
+  }
+
+  if (passing_rate == 0) {
+    std::cout << "No arrival rate tried has a P99 response time within " << run_config.latency_slo_p99_ms << " ms"
+              << std::endl;
+    return Status::OK();
+  }
+
+  std::cout << "Max arrival rate with P99 response time within " << run_config.latency_slo_p99_ms
+            << " ms: " << passing_rate << " requests/s" << std::endl;
+  performance_result_ = std::move(passing_result);
+  return Status::OK();
+}
+
+Status PerformanceRunner::WriteHistogram() const {
+  // in the open loop the response times include the time spent waiting, which is the latency a client sees
+  const auto& latencies = performance_result_.response_times.empty() ? performance_result_.time_costs
+                                                                     : performance_result_.response_times;
+  LatencyHistogram histogram;
+  for (double latency : latencies) {
+    histogram.Record(latency);
+  }
+
+  const auto& path = performance_test_config_.run_config.histogram_file;
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  ORT_RETURN_IF_NOT(outfile.good(), "failed to open histogram file '", ToUTF8String(path), "'");
+  histogram.OutputPercentileDistribution(outfile);
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   const auto& file_path = performance_test_config_.model_info.model_file_path;
 #if !defined(ORT_MINIMAL_BUILD)
@@ -272,7 +509,8 @@ static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfi
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
     : performance_test_config_(test_config),
-      test_model_info_(CreateModelInfo(test_config)) {
+      test_model_info_(CreateModelInfo(test_config)),
+      arrival_generator_(rd()) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
@@ -295,6 +533,27 @@ bool PerformanceRunner::Initialize() {
   std::string narrow_model_name = ToUTF8String(model_name);
   performance_result_.model_name = narrow_model_name;
 
+  if (performance_test_config_.run_config.arrival_mode == ArrivalMode::kTrace) {
+    const auto& trace_path = performance_test_config_.run_config.arrival_trace_file;
+    std::ifstream trace_file(trace_path);
+    if (!trace_file.good()) {
+      std::cout << "failed to open arrival trace file '" << ToUTF8String(trace_path) << "'" << std::endl;
+      return false;
+    }
+    double arrival;
+    while (trace_file >> arrival) {
+      arrival_trace_.push_back(arrival);
+    }
+    std::sort(arrival_trace_.begin(), arrival_trace_.end());
+    const double span = arrival_trace_.empty() ? 0.0 : arrival_trace_.back() - arrival_trace_.front();
+    if (arrival_trace_.size() < 2 || span <= 0) {
+      std::cout << "arrival trace file '" << ToUTF8String(trace_path) << "' needs at least two distinct arrival times"
+                << std::endl;
+      return false;
+    }
+    arrival_trace_rate_ = static_cast<double>(arrival_trace_.size() - 1) / span;
+  }
+
   // ownership semantics are a little unexpected here as the test case takes ownership of the model info
   TestModelInfo* test_model_info = test_model_info_.get();
   test_case_ = CreateOnnxTestCase(narrow_model_name, std::move(test_model_info_), 0.0, 0.0);
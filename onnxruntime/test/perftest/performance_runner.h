@@ -34,6 +34,10 @@ struct PerformanceResult {
   short average_CPU_usage{0};
   double total_time_cost{0};
   std::vector<double> time_costs;
+  // open loop only: the time from the scheduled arrival of each request to its completion, which includes the time
+  // the request waited to be served.
+  std::vector<double> response_times;
+  double arrival_rate{0};
   std::string model_name;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
@@ -91,6 +95,11 @@ class PerformanceRunner {
   Status ForkJoinRepeat();
   Status RunParallelDuration();
 
+  Status GenerateArrivals(double arrival_rate, std::vector<double>& arrivals);
+  Status RunOpenLoop(double arrival_rate);
+  Status FindMaxArrivalRate();
+  Status WriteHistogram() const;
+
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
       ORT_RETURN_IF_ERROR(RunOneIteration<false>());
@@ -115,6 +124,9 @@ class PerformanceRunner {
   std::unique_ptr<TestSession> session_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
+  std::mt19937 arrival_generator_;
+  std::vector<double> arrival_trace_;
+  double arrival_trace_rate_{0};
 
   std::mutex results_mutex_;
 };
@@ -19,6 +19,15 @@ enum class TestMode : std::uint8_t {
   KFixRepeatedTimesMode
 };
 
+// How requests are issued. In the closed loop a new request is issued as soon as a previous one completes.
+// In the open loop requests arrive on a schedule that doesn't depend on the completion of earlier requests.
+enum class ArrivalMode : std::uint8_t {
+  kClosedLoop = 0,
+  kConstant,
+  kPoisson,
+  kTrace
+};
+
 enum class Platform : std::uint8_t {
   kWindows = 0,
   kLinux
@@ -68,6 +77,11 @@ struct RunConfig {
   std::basic_string<ORTCHAR_T> register_custom_op_path;
   bool enable_cuda_io_binding{false};
   bool use_extensions = false;
+  ArrivalMode arrival_mode{ArrivalMode::kClosedLoop};
+  double arrival_rate{0};  // requests per second
+  std::basic_string<ORTCHAR_T> arrival_trace_file;
+  double latency_slo_p99_ms{0};
+  std::basic_string<ORTCHAR_T> histogram_file;
 };
 
 struct PerformanceTestConfig {
@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <set>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -510,6 +512,44 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestDegreeOfParallelismLimit) {
+  CreateThreadPoolAndTest("TestDegreeOfParallelismLimit", 4, [](ThreadPool* tp) {
+    ASSERT_EQ(ThreadPool::MaxThreadsIncludingCaller(tp), 4);
+    const int unlimited = ThreadPool::DegreeOfParallelism(tp);
+    const int granularity = unlimited / 4;
+
+    const auto threads_used = [tp]() {
+      std::mutex mutex;
+      std::set<std::thread::id> thread_ids;
+      ThreadPool::TrySimpleParallelFor(tp, 1000, [&](std::ptrdiff_t) {
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      });
+      return thread_ids;
+    };
+
+    {
+      ThreadPool::DegreeOfParallelismLimit limit(2);
+      ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp), 2 * granularity);
+      ASSERT_LE(threads_used().size(), 2u);
+
+      {
+        // The innermost limit applies, and the limit never raises the degree of parallelism above the pool size.
+        ThreadPool::DegreeOfParallelismLimit inner_limit(8);
+        ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp), unlimited);
+      }
+      ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp), 2 * granularity);
+
+      ThreadPool::DegreeOfParallelismLimit single_thread(1);
+      const auto thread_ids = threads_used();
+      ASSERT_EQ(thread_ids.size(), 1u);
+      ASSERT_EQ(*thread_ids.begin(), std::this_thread::get_id());
+    }
+
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp), unlimited);
+  });
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -1041,6 +1041,85 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// Loop carried vars that are passed through to other loop carried vars and scan outputs must not be overwritten when
+// the loop carried vars alternate between two buffers. With a loop invariant condition the scan outputs are written
+// directly into the Loop output.
+static void RunFibonacciLoop(bool loop_invariant_condition) {
+  auto create_subgraph = [loop_invariant_condition]() {
+    Model model("Fibonacci subgraph", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, a_in, b_in.
+
+       a_in  b_in         a_in          cond_in
+         |    |             |              |
+          [Add]         [Identity]   [Identity] or [And]
+            |               |              |
+          a_out           b_out         cond_out
+
+       a_in is also the scan output.
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& a_in = graph.GetOrCreateNodeArg("a_in", &float_tensor);
+    auto& b_in = graph.GetOrCreateNodeArg("b_in", &float_tensor);
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& a_out = graph.GetOrCreateNodeArg("a_out", &float_tensor);
+    auto& b_out = graph.GetOrCreateNodeArg("b_out", &float_tensor);
+
+    graph.AddNode("add", "Add", "a + b", {&a_in, &b_in}, {&a_out});
+    graph.AddNode("b_out_identity", "Identity", "Forward a_in to b_out", {&a_in}, {&b_out});
+    if (loop_invariant_condition) {
+      graph.AddNode("cond_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    } else {
+      graph.AddNode("cond_and", "And", "Forward cond_in to cond_out", {&cond_in, &cond_in}, {&cond_out});
+    }
+
+    graph.SetInputs({&iter_num_in, &cond_in, &a_in, &b_in});
+    graph.SetOutputs({&cond_out, &a_out, &b_out, &a_in});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  test.AddAttribute<GraphProto>("body", create_subgraph());
+  test.AddInput<int64_t>("M", {1}, {4});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("a", {2}, {1.f, 2.f});
+  test.AddInput<float>("b", {2}, {1.f, 1.f});
+
+  test.AddOutput<float>("a_final", {2}, {8.f, 13.f});
+  test.AddOutput<float>("b_final", {2}, {5.f, 8.f});
+  test.AddOutput<float>("a_per_iteration", {4, 2}, {1.f, 2.f, 2.f, 3.f, 3.f, 5.f, 5.f, 8.f});
+
+  test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig();
+}
+
+TEST(Loop, LoopCarriedVarsPassedThrough) {
+  RunFibonacciLoop(false);
+}
+
+TEST(Loop, ScanOutputsWithLoopInvariantCondition) {
+  RunFibonacciLoop(true);
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // test that when part of the subgraph run on CUDA/ROCm it executes successfully
 TEST(Loop, MixedExecutionProviders) {
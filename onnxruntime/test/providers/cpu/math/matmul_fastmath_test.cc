@@ -10,8 +10,9 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "default_providers.h"
+#include "core/mlas/inc/mlas.h"
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SUPPORTS_SBGEMM)
 
 namespace onnxruntime {
 namespace test {
@@ -295,6 +296,57 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights_FastMath) {
 
 #endif
 
+// Gemm uses the bfloat16 GEMM for the product and adds the broadcast bias afterwards.
+// The inputs are small integers, so the bfloat16 products are exact.
+void RunGemmFastMathTest(bool is_b_constant, const std::vector<int64_t>& c_dims, float beta) {
+  constexpr int64_t M = 4, N = 16, K = 8;
+  const std::vector<float> a_vals = ValueRange<float>(M * K);
+  const std::vector<float> b_vals = ValueRange<float>(K * N);
+  const int64_t c_size = TensorShape(c_dims).Size();
+  const std::vector<float> c_vals = ValueRange<float>(c_size, 1.0f);
+
+  std::vector<float> expected_vals(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+      // C is (N,) or (M, 1) here.
+      const float c = c_vals[c_size == N ? n : m];
+      expected_vals[m * N + n] = sum + beta * c;
+    }
+  }
+
+  OpTester test("Gemm", 13);
+  test.AddAttribute("beta", beta);
+  test.AddInput<float>("A", {M, K}, a_vals);
+  test.AddInput<float>("B", {K, N}, b_vals, is_b_constant);
+  test.AddInput<float>("C", c_dims, c_vals);
+  test.AddOutput<float>("Y", {M, N}, expected_vals);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(
+      kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16, "1"));
+  test.Config(so)
+      .Config(run_with_tunable_op)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
+TEST(MathOpTest, GemmFloatType_FastMath) {
+  RunGemmFastMathTest(false, {16}, 1.0f);
+  RunGemmFastMathTest(false, {4, 1}, 0.5f);
+}
+
+TEST(MathOpTest, GemmFloatTypeInitializer_FastMath) {
+  RunGemmFastMathTest(true, {16}, 1.0f);
+  RunGemmFastMathTest(true, {4, 1}, 2.0f);
+}
+
 // Dummy run to disable the FastMath mode for the current session
 TEST(MathOpTest, MatMulUint64Type_DisableFastMath) {
   RunMatMulTest<uint64_t>(9, false, false, true);
@@ -302,4 +354,4 @@ TEST(MathOpTest, MatMulUint64Type_DisableFastMath) {
 
 }  // namespace test
 }  // namespace onnxruntime
-#endif  // defined(__aarch64__) && defined(__linux__)
+#endif  // defined(MLAS_SUPPORTS_SBGEMM)
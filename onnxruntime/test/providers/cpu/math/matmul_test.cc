@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 
 #include "test/providers/provider_test_utils.h"
@@ -600,6 +601,81 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   }
 }
 
+// B is an initializer that is pruned to a 2:4 pattern along K (block_sparse == false), or whose 4x16 blocks are
+// mostly zero (block_sparse == true), so that MatMul and Gemm prepack it for the sparse SGEMM. The result must match
+// the dense computation with and without the sparse packing enabled. Gemm covers a transposed B, alpha and the bias.
+static void RunSparseWeightsTest(const char* op, bool block_sparse, const char* enable_sparse_gemm) {
+  constexpr int64_t M = 5, K = 38, N = 37;
+  const bool is_gemm = std::string(op) == "Gemm";
+  const float alpha = is_gemm ? 0.5f : 1.0f;
+
+  std::vector<float> b_values(static_cast<size_t>(K * N));
+  for (int64_t k = 0; k < K; ++k) {
+    for (int64_t n = 0; n < N; ++n) {
+      const bool keep = block_sparse ? ((k / 4 + n / 16) % 3 == 0)
+                                     : (k % 4 == n % 4 || k % 4 == (n + 1 + k / 4) % 4);
+      b_values[static_cast<size_t>(k * N + n)] = keep ? static_cast<float>((k * 7 + n * 3) % 11 - 5) * 0.125f : 0.0f;
+    }
+  }
+
+  std::vector<float> a_values(static_cast<size_t>(M * K));
+  for (size_t i = 0; i < a_values.size(); ++i) {
+    a_values[i] = static_cast<float>(static_cast<int64_t>(i * 5 % 13) - 6) * 0.25f;
+  }
+
+  std::vector<float> bias_values(static_cast<size_t>(N));
+  for (size_t i = 0; i < bias_values.size(); ++i) {
+    bias_values[i] = static_cast<float>(i % 3) - 1.0f;
+  }
+
+  std::vector<float> y_values(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; ++k) {
+        sum += a_values[static_cast<size_t>(m * K + k)] * b_values[static_cast<size_t>(k * N + n)];
+      }
+      y_values[static_cast<size_t>(m * N + n)] = alpha * sum + (is_gemm ? bias_values[static_cast<size_t>(n)] : 0.0f);
+    }
+  }
+
+  OpTester test(op, 13);
+  test.AddInput<float>("A", {M, K}, a_values);
+  if (is_gemm) {
+    std::vector<float> b_transposed(b_values.size());
+    for (int64_t k = 0; k < K; ++k) {
+      for (int64_t n = 0; n < N; ++n) {
+        b_transposed[static_cast<size_t>(n * K + k)] = b_values[static_cast<size_t>(k * N + n)];
+      }
+    }
+    test.AddAttribute<int64_t>("transB", 1);
+    test.AddAttribute<float>("alpha", alpha);
+    test.AddInput<float>("B", {N, K}, b_transposed, true);
+    test.AddInput<float>("C", {N}, bias_values);
+  } else {
+    test.AddInput<float>("B", {K, N}, b_values, true);
+  }
+  test.AddOutput<float>("Y", {M, N}, y_values);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasSparseGemm, enable_sparse_gemm));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
+TEST(MathOpTest, MatMulSparseWeights) {
+  for (const char* op : {"MatMul", "Gemm"}) {
+    for (bool block_sparse : {false, true}) {
+      RunSparseWeightsTest(op, block_sparse, "1");
+      RunSparseWeightsTest(op, block_sparse, "0");
+    }
+  }
+}
+
 #endif
 
 }  // namespace test
@@ -3,6 +3,7 @@
 #include "core/graph/constants.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "default_providers.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -1046,5 +1047,81 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// Adds a 3x3 convolution with a constant filter and enough channels to be computed by the
+// Winograd convolution on the CPU EP. The padding leaves partial tiles at the edges.
+static void AddConvWinogradTestData(OpTester& test, const std::vector<std::string>* X_dim_params = nullptr) {
+  constexpr int64_t N = 2, C = 16, M = 24, H = 13, W = 11;
+
+  vector<float> X(N * C * H * W);
+  vector<float> Wt(M * C * 3 * 3);
+  vector<float> B(M);
+  for (size_t i = 0; i < X.size(); i++) X[i] = static_cast<float>(static_cast<int>(i % 13) - 6) / 8.0f;
+  for (size_t i = 0; i < Wt.size(); i++) Wt[i] = static_cast<float>(static_cast<int>(i % 7) - 3) / 16.0f;
+  for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<float>(i) / 32.0f;
+
+  vector<float> Y(N * M * H * W);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t oh = 0; oh < H; oh++) {
+        for (int64_t ow = 0; ow < W; ow++) {
+          double sum = B[m];
+          for (int64_t c = 0; c < C; c++) {
+            for (int64_t kh = 0; kh < 3; kh++) {
+              for (int64_t kw = 0; kw < 3; kw++) {
+                const int64_t ih = oh + kh - 1;
+                const int64_t iw = ow + kw - 1;
+                if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                  sum += double(X[((n * C + c) * H + ih) * W + iw]) * Wt[((m * C + c) * 3 + kh) * 3 + kw];
+                }
+              }
+            }
+          }
+          Y[((n * M + m) * H + oh) * W + ow] = static_cast<float>(sum);
+        }
+      }
+    }
+  }
+
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<float>("X", {N, C, H, W}, X, false, X_dim_params);
+  test.AddInput<float>("W", {M, C, 3, 3}, Wt, true);
+  test.AddInput<float>("B", {M}, B, true);
+  test.AddOutput<float>("Y", {N, M, H, W}, Y);
+  test.SetOutputTolerance(1e-4f);
+}
+
+TEST(ConvTest, Conv2D_3x3_WinogradShape) {
+  OpTester test("Conv", 11);
+  AddConvWinogradTestData(test);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kQnnExecutionProvider});
+}
+
+#ifndef ENABLE_TRAINING
+// Prepacking is disabled in full training build so no need to test the feature in a training build.
+
+TEST(ConvTest, Conv2D_3x3_WinogradPrePack) {
+  // With a static input shape only the Winograd filter is kept, so W is released after prepacking.
+  {
+    OpTester test("Conv", 11);
+    AddConvWinogradTestData(test);
+    size_t number_of_pre_packed_weights = 0;
+    test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig(&number_of_pre_packed_weights);
+    EXPECT_EQ(number_of_pre_packed_weights, static_cast<size_t>(1));
+  }
+
+  // Otherwise W stays available for the input shapes that use MlasConv.
+  {
+    OpTester test("Conv", 11);
+    const std::vector<std::string> X_dim_params = {"batch", "16", "seq", "11"};
+    AddConvWinogradTestData(test, &X_dim_params);
+    size_t number_of_pre_packed_weights = 0;
+    test.ConfigEp(DefaultCpuExecutionProvider()).RunWithConfig(&number_of_pre_packed_weights);
+    EXPECT_EQ(number_of_pre_packed_weights, static_cast<size_t>(0));
+  }
+}
+
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
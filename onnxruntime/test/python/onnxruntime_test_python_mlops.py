@@ -58,6 +58,26 @@ class TestInferenceSession(unittest.TestCase):
         res = sess.run([output_name], {x_name: x})
         self.assertEqual(output_expected, res[0])
 
+    def test_zip_map_columnar(self):
+        so = onnxrt.SessionOptions()
+        so.add_session_config_entry("optimization.zipmap_columnar_output", "1")
+        models = [("zipmap_stringfloat.onnx", ["class1", "class2", "class3"]), ("zipmap_int64float.onnx", [10, 20, 30])]
+        for model, labels in models:
+            with self.subTest(model=model):
+                sess = onnxrt.InferenceSession(get_name(model), so, providers=["CPUExecutionProvider"])
+                self.assertEqual(sess.get_outputs()[0].type, "tensor(float)")
+                self.assertEqual(sess.get_zipmap_labels("Z"), labels)
+
+                x = np.array([1.0, 0.0, 3.0, 44.0, 23.0, 11.0], dtype=np.float32).reshape((2, 3))
+                res = sess.run(["Z"], {"X": x})
+                np.testing.assert_array_equal(res[0], x)
+
+                rows = sess.zipmap_view("Z", res[0])
+                self.assertEqual(len(rows), 2)
+                self.assertEqual(list(rows[1].keys()), labels)
+                self.assertEqual(dict(rows[1]), {labels[0]: 44.0, labels[1]: 23.0, labels[2]: 11.0})
+                self.assertEqual(rows[0][labels[2]], 3.0)
+
     def test_dict_vectorizer(self):
         sess = onnxrt.InferenceSession(
             get_name("pipeline_vectorize.onnx"),
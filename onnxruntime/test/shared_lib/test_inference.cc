@@ -2171,6 +2171,143 @@ TEST(CApiTest, io_binding) {
   binding.ClearBoundOutputs();
 }
 
+TEST(CApiTest, io_binding_output_allocator) {
+  Ort::SessionOptions session_options;
+  Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CPU(session_options, 1));
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value bound_x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                                x_shape.data(), x_shape.size());
+
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  MockedOrtAllocator output_allocator;
+  {
+    Ort::IoBinding binding(session);
+    binding.BindInput("X", bound_x);
+
+    for (size_t run = 1; run <= 2; ++run) {
+      // the output is allocated from the bound allocator by the kernel producing it
+      binding.BindOutput("Y", &output_allocator);
+      session.Run(Ort::RunOptions(), binding);
+      ASSERT_EQ(output_allocator.NumAllocations(), run);
+
+      std::vector<Ort::Value> output_values = binding.GetOutputValues();
+      ASSERT_EQ(output_values.size(), 1U);
+      const Ort::Value& Y_value = output_values[0];
+      ASSERT_TRUE(Y_value.IsTensor());
+      auto count = Y_value.GetTensorTypeAndShapeInfo().GetElementCount();
+      ASSERT_EQ(expected_y.size(), count);
+      const float* values = Y_value.GetTensorData<float>();
+      ASSERT_TRUE(std::equal(values, values + count, std::begin(expected_y)));
+    }
+
+    binding.ClearBoundInputs();
+    binding.ClearBoundOutputs();
+  }
+
+  // all outputs were returned to the allocator once released
+  output_allocator.LeakCheck();
+}
+
+#if !defined(DISABLE_ML_OPS) && !defined(DISABLE_CONTRIB_OPS)
+TEST(CApiTest, zipmap_columnar_output) {
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry(kOrtSessionOptionsZipMapColumnarOutput, "1");
+  Ort::Session session(*ort_env, TSTR("testdata/zipmap_stringfloat.onnx"), session_options);
+
+  // the output is a float tensor instead of a sequence of maps
+  Ort::TypeInfo type_info = session.GetOutputTypeInfo(0);
+  ASSERT_EQ(type_info.GetONNXType(), ONNX_TYPE_TENSOR);
+  ASSERT_EQ(type_info.GetTensorTypeAndShapeInfo().GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value labels = session.GetOutputZipMapLabels(0, allocator);
+  ASSERT_TRUE(labels.IsTensor());
+  ASSERT_EQ(labels.GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>{3});
+  const std::vector<std::string> expected_labels = {"class1", "class2", "class3"};
+  for (size_t i = 0; i < expected_labels.size(); ++i) {
+    ASSERT_EQ(labels.GetStringTensorElement(i), expected_labels[i]);
+  }
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {2, 3};
+  std::array<float, 2 * 3> x_values = {1.f, 0.f, 3.f, 44.f, 23.f, 11.f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Z"};
+  auto outputs = session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+  ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{2, 3}));
+  const float* z_values = outputs[0].GetTensorData<float>();
+  ASSERT_TRUE(std::equal(x_values.begin(), x_values.end(), z_values));
+}
+
+TEST(CApiTest, zipmap_columnar_output_disabled) {
+  Ort::Session session(*ort_env, TSTR("testdata/zipmap_stringfloat.onnx"), Ort::SessionOptions{});
+  ASSERT_EQ(session.GetOutputTypeInfo(0).GetONNXType(), ONNX_TYPE_SEQUENCE);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value labels = session.GetOutputZipMapLabels(0, allocator);
+  ASSERT_EQ(static_cast<OrtValue*>(labels), nullptr);
+}
+
+// the rewrite needs ORT_ENABLE_EXTENDED, below that the option is ignored with a warning
+TEST(CApiTest, zipmap_columnar_output_basic_optimization_level) {
+  Ort::SessionOptions session_options;
+  session_options.SetGraphOptimizationLevel(ORT_ENABLE_BASIC);
+  session_options.AddConfigEntry(kOrtSessionOptionsZipMapColumnarOutput, "1");
+  Ort::Session session(*ort_env, TSTR("testdata/zipmap_stringfloat.onnx"), session_options);
+  ASSERT_EQ(session.GetOutputTypeInfo(0).GetONNXType(), ONNX_TYPE_SEQUENCE);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value labels = session.GetOutputZipMapLabels(0, allocator);
+  ASSERT_EQ(static_cast<OrtValue*>(labels), nullptr);
+}
+#endif  // !defined(DISABLE_ML_OPS) && !defined(DISABLE_CONTRIB_OPS)
+
+TEST(CApiTest, env_resource_limits) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(4);
+  session_options.AddConfigEntry(kOrtSessionOptionsResourcePriority, "high");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  ort_env->SetResourceLimits(2, 1);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  auto outputs = session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1U);
+
+  // the session is limited to the whole budget as it is the only one running
+  Ort::KeyValuePairs usage = session.GetResourceUsage();
+  ASSERT_STREQ(usage.GetValue("priority"), "high");
+  ASSERT_STREQ(usage.GetValue("max_threads"), "4");
+  ASSERT_STREQ(usage.GetValue("thread_grant"), "2");
+  ASSERT_STREQ(usage.GetValue("active_runs"), "0");
+  ASSERT_NE(usage.GetValue("arena_bytes_reserved"), nullptr);
+  ASSERT_NE(usage.GetValue("arena_bytes_reclaimed"), nullptr);
+
+  // without a budget the session uses its whole intra-op thread pool
+  ort_env->SetResourceLimits(0, 0);
+  ASSERT_STREQ(session.GetResourceUsage().GetValue("thread_grant"), "4");
+
+  ASSERT_THROW(ort_env->SetResourceLimits(-1, 0), Ort::Exception);
+
+  Ort::SessionOptions invalid_options;
+  invalid_options.AddConfigEntry(kOrtSessionOptionsResourcePriority, "urgent");
+  ASSERT_THROW(Ort::Session(*ort_env, MODEL_URI, invalid_options), Ort::Exception);
+}
+
 #if defined(USE_CUDA) || defined(USE_TENSORRT)
 TEST(CApiTest, io_binding_cuda) {
   Ort::SessionOptions session_options;
@@ -4624,6 +4761,128 @@ TEST(CApiTest, RunAsyncFail) {
   EXPECT_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, output_values, 1, CallbackFail, nullptr), std::exception);
 }
 
+struct PipelinedRunState {
+  std::atomic_int completed{0};
+  std::atomic_int failed{0};
+};
+
+void CallbackPipelined(void* user_data, OrtValue** /*outputs*/, size_t num_outputs, OrtStatusPtr status_ptr) {
+  auto* state = reinterpret_cast<PipelinedRunState*>(user_data);
+  Ort::Status status(status_ptr);
+  if (!status.IsOK() || num_outputs != 1) {
+    state->failed++;
+  }
+  state->completed++;
+}
+
+TEST(CApiTest, RunAsyncPipelined) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  session_options.AddConfigEntry(kOrtSessionOptionsRunAsyncPipelineStages, "3");
+  session_options.AddConfigEntry(kOrtSessionOptionsRunAsyncMaxInFlight, "2");
+  Ort::Session session(*ort_env, TSTR("testdata/mnist.onnx"), session_options);
+
+  const char* input_names[] = {"Input3"};
+  const char* output_names[] = {"Plus214_Output_0"};
+  std::vector<float> x_value(28 * 28);
+  for (size_t i = 0; i < x_value.size(); ++i) {
+    x_value[i] = static_cast<float>(i % 255) / 255.0f;
+  }
+  int64_t x_dim[] = {1, 1, 28, 28};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value input_tensors[1] = {
+      Ort::Value::CreateTensor<float>(memory_info, x_value.data(), x_value.size(), x_dim, 4),
+  };
+
+  Ort::RunOptions run_options;
+  auto expected = session.Run(run_options, input_names, input_tensors, 1, output_names, 1);
+  ASSERT_EQ(expected.size(), 1u);
+  const float* expected_data = expected[0].GetTensorData<float>();
+
+  // submit more requests than can be in flight, so that some wait for others to complete
+  constexpr int num_requests = 8;
+  PipelinedRunState state;
+  std::vector<Ort::Value> output_values;
+  for (int i = 0; i < num_requests; ++i) {
+    output_values.emplace_back(nullptr);
+  }
+
+  for (int i = 0; i < num_requests; ++i) {
+    EXPECT_NO_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, &output_values[i], 1,
+                                     CallbackPipelined, &state));
+  }
+
+  std::chrono::duration<double, std::milli> dur{100};
+  // timeout in about 10 secs
+  for (int i = 0; i < 100 && state.completed.load() < num_requests; ++i) {
+    std::this_thread::sleep_for(dur);
+  }
+
+  ASSERT_EQ(state.completed.load(), num_requests);
+  EXPECT_EQ(state.failed.load(), 0);
+  for (const auto& output_value : output_values) {
+    ASSERT_TRUE(output_value.IsTensor());
+    const float* data = output_value.GetTensorData<float>();
+    for (size_t j = 0; j < 10; ++j) {
+      EXPECT_FLOAT_EQ(data[j], expected_data[j]);
+    }
+  }
+}
+
+// With profiling enabled, RunAsync requests are executed with Run, so that they are recorded in the profile.
+TEST(CApiTest, RunAsyncPipelined_ProfilingEnabled) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  session_options.AddConfigEntry(kOrtSessionOptionsRunAsyncPipelineStages, "3");
+#ifdef _WIN32
+  session_options.EnableProfiling(L"run_async_pipelined_profile");
+#else
+  session_options.EnableProfiling("run_async_pipelined_profile");
+#endif
+  Ort::Session session(*ort_env, TSTR("testdata/mnist.onnx"), session_options);
+
+  const char* input_names[] = {"Input3"};
+  const char* output_names[] = {"Plus214_Output_0"};
+  std::vector<float> x_value(28 * 28, 0.5f);
+  int64_t x_dim[] = {1, 1, 28, 28};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value input_tensors[1] = {
+      Ort::Value::CreateTensor<float>(memory_info, x_value.data(), x_value.size(), x_dim, 4),
+  };
+
+  constexpr int num_requests = 4;
+  PipelinedRunState state;
+  std::vector<Ort::Value> output_values;
+  for (int i = 0; i < num_requests; ++i) {
+    output_values.emplace_back(nullptr);
+  }
+
+  Ort::RunOptions run_options;
+  for (int i = 0; i < num_requests; ++i) {
+    EXPECT_NO_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, &output_values[i], 1,
+                                     CallbackPipelined, &state));
+  }
+
+  std::chrono::duration<double, std::milli> dur{100};
+  // timeout in about 10 secs
+  for (int i = 0; i < 100 && state.completed.load() < num_requests; ++i) {
+    std::this_thread::sleep_for(dur);
+  }
+
+  ASSERT_EQ(state.completed.load(), num_requests);
+  EXPECT_EQ(state.failed.load(), 0);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto profile_file = session.EndProfilingAllocated(allocator);
+  std::ifstream profile_stream(profile_file.get());
+  const std::string profile((std::istreambuf_iterator<char>(profile_stream)), std::istreambuf_iterator<char>());
+  int num_model_runs = 0;
+  for (size_t pos = profile.find("model_run"); pos != std::string::npos; pos = profile.find("model_run", pos + 1)) {
+    ++num_model_runs;
+  }
+  EXPECT_EQ(num_model_runs, num_requests);
+}
+
 static void TestRunWithLoraAdapter(const Ort::LoraAdapter& adapter) {
   constexpr const ORTCHAR_T* model_path = TSTR("testdata/lora/two_params_lora_model.onnx");
 
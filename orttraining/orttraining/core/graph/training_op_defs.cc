@@ -1652,8 +1652,9 @@ void RegisterTrainingOpSchemas() {
           "Constrain gradients' types.")
       .TypeConstraint(
           "S_MOMENT",
-          {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))"},
-          "Constrain momentums' types.")
+          {"seq(tensor(float16))", "seq(tensor(float))", "seq(tensor(double))", "seq(tensor(bfloat16))"},
+          "Constrain momentums' types. The CPU kernel stores float16 or bfloat16 momentums for float weights to "
+          "save memory, and updates them in float.")
       .TypeConstraint(
           "T_BOOL",
           {"tensor(bool)"},
@@ -200,9 +200,10 @@ class AdamWOptimizer(_OptimizerBase):
 class _Optimizer(onnxblock_module.ForwardBlock):
     """Base class for building optimizer onnxblocks."""
 
-    def __init__(self, clip_grad=None):
+    def __init__(self, clip_grad=None, moment_dtype=None):
         super().__init__()
         self._clip_grad = clip_grad
+        self._moment_dtype = moment_dtype
 
     def build(self, parameters):
         onnx_model = self.base
@@ -214,6 +215,7 @@ class _Optimizer(onnxblock_module.ForwardBlock):
         first_order_moments_name = "first_order_moments"
 
         trainable_parameters, _ = parameters
+        moment_dtype = self._moment_data_type(trainable_parameters)
 
         onnx_model.graph.input.extend(
             [
@@ -222,10 +224,13 @@ class _Optimizer(onnxblock_module.ForwardBlock):
             ]
         )
 
-        for input_name in [params_name, gradients_name, first_order_moments_name]:
+        for input_name in [params_name, gradients_name]:
             onnx_model.graph.input.append(
                 onnx.helper.make_tensor_sequence_value_info(input_name, trainable_parameters[0].data_type, None)
             )
+        onnx_model.graph.input.append(
+            onnx.helper.make_tensor_sequence_value_info(first_order_moments_name, moment_dtype, None)
+        )
 
         if self._clip_grad is not None:
             gradients_name = self._clip_grad(gradients_name)
@@ -236,6 +241,10 @@ class _Optimizer(onnxblock_module.ForwardBlock):
 
         return updated_flag_name
 
+    def _moment_data_type(self, trainable_parameters: list[onnx.TensorProto]) -> int:
+        """Returns the data type that the moments are stored in, which defaults to the data type of the parameters."""
+        return self._moment_dtype if self._moment_dtype is not None else trainable_parameters[0].data_type
+
     def _optimizer_specific_logic(
         self,
         learning_rate_name: str,
@@ -247,10 +256,17 @@ class _Optimizer(onnxblock_module.ForwardBlock):
 
 
 class AdamW(_Optimizer):
-    """Builds AdamW optimizer onnxblock for the given training parameters."""
+    """Builds AdamW optimizer onnxblock for the given training parameters.
 
-    def __init__(self, bias_correction=True, betas=(0.9, 0.999), eps=1e-6, weight_decay=0.0, clip_grad=None):
-        super().__init__(clip_grad)
+    moment_dtype is the onnx.TensorProto data type that the first and second order moments are stored in.
+    It defaults to the data type of the parameters. onnx.TensorProto.FLOAT16 or onnx.TensorProto.BFLOAT16 halve
+    the memory of the optimizer states of float parameters on the CPU, which updates the moments in float.
+    """
+
+    def __init__(
+        self, bias_correction=True, betas=(0.9, 0.999), eps=1e-6, weight_decay=0.0, clip_grad=None, moment_dtype=None
+    ):
+        super().__init__(clip_grad, moment_dtype)
         self._adamw = AdamWOptimizer(
             bias_correction=bias_correction,
             betas=betas,
@@ -273,7 +289,7 @@ class AdamW(_Optimizer):
         # Prepare the tensor sequence inputs for moments
         onnx_model.graph.input.append(
             onnx.helper.make_tensor_sequence_value_info(
-                second_order_moments_name, trainable_parameters[0].data_type, None
+                second_order_moments_name, self._moment_data_type(trainable_parameters), None
             )
         )
 
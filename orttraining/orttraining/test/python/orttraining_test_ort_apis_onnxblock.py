@@ -564,6 +564,33 @@ def test_adamw_optimizer_execution():
         _ = ort_session.run(ort_output_names, ort_inputs)
 
 
+def test_adamw_optimizer_moment_dtype():
+    # Given
+    device = "cpu"
+    batch_size, input_size, hidden_size, output_size = 64, 784, 500, 10
+    pt_model, base_model = _get_models(device, batch_size, input_size, hidden_size, output_size)
+
+    simple_block = SimpleTrainingBlockWithMSELoss()
+    for name, _ in pt_model.named_parameters():
+        simple_block.requires_grad(name)
+
+    with onnxblock.base(base_model):
+        _ = simple_block(base_model.graph.output[0].name)
+
+    # When
+    optimizer = onnxblock.optim.AdamW(moment_dtype=onnx.TensorProto.BFLOAT16)
+    with onnxblock.empty_base() as accessor:
+        _ = optimizer(simple_block.parameters())
+        optimizer_model = accessor.model
+
+    # Then the moments are declared as bfloat16 while the parameters and gradients keep their float type
+    graph_inputs = {graph_input.name: graph_input.type for graph_input in optimizer_model.graph.input}
+    for name in ["params", "gradients"]:
+        assert graph_inputs[name].sequence_type.elem_type.tensor_type.elem_type == onnx.TensorProto.FLOAT
+    for name in ["first_order_moments", "second_order_moments"]:
+        assert graph_inputs[name].sequence_type.elem_type.tensor_type.elem_type == onnx.TensorProto.BFLOAT16
+
+
 @pytest.mark.parametrize(
     "block",
     [SimpleTrainingBlockWithMSELoss, SimpleTrainingBlockWithCrossEntropyLoss, SimpleTrainingBlockWithBCEWithLogitsLoss],
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -581,4 +582,151 @@ TEST(CheckpointApiTest, SaveOnnxModelAsCheckpoint_ThenLoad_WithExternalData) {
   }
 }
 
+namespace {
+
+void CreateAsyncCheckpointTestState(CheckpointState& state) {
+  const std::vector<std::pair<std::string, std::vector<int64_t>>> params = {
+      {"fc1.weight", {64, 128}}, {"fc1.bias", {64}}, {"fc2.weight", {10, 64}}, {"fc2.bias", {10}}};
+
+  auto group_state = std::make_shared<GroupOptimizerState>();
+  group_state->step = 7;
+  group_state->initial_lr = 0.01f;
+  for (const auto& [name, dims] : params) {
+    OrtValue value;
+    GenerateRandomInput(dims, value);
+    state.module_checkpoint_state.named_parameters.insert({name, std::make_shared<Parameter>(name, value, true)});
+
+    GenerateRandomInput(dims, group_state->param_named_optimizer_states[name]["momentum0"]);
+    GenerateRandomInput(dims, group_state->param_named_optimizer_states[name]["momentum1"]);
+  }
+  state.optimizer_checkpoint_state.group_named_optimizer_states.insert({"group0", group_state});
+  state.property_bag.AddProperty("epoch", int64_t{3});
+}
+
+void ExpectTensorsEqual(const OrtValue& expected_ort_value, const OrtValue& restored_ort_value) {
+  const Tensor& expected_tensor = expected_ort_value.Get<Tensor>();
+  const Tensor& restored_tensor = restored_ort_value.Get<Tensor>();
+  ASSERT_EQ(expected_tensor.DataType(), restored_tensor.DataType());
+  ASSERT_EQ(expected_tensor.Shape(), restored_tensor.Shape());
+  ASSERT_EQ(std::memcmp(expected_tensor.DataRaw(), restored_tensor.DataRaw(), expected_tensor.SizeInBytes()), 0);
+}
+
+void ExpectCheckpointStatesEqual(const CheckpointState& expected, const CheckpointState& restored) {
+  const auto& expected_params = expected.module_checkpoint_state.named_parameters;
+  const auto& restored_params = restored.module_checkpoint_state.named_parameters;
+  ASSERT_EQ(expected_params.size(), restored_params.size());
+  for (const auto& [name, param] : expected_params) {
+    ASSERT_TRUE(restored_params.find(name) != restored_params.end());
+    ExpectTensorsEqual(param->Data(), restored_params.at(name)->Data());
+  }
+
+  const auto& expected_group = expected.optimizer_checkpoint_state.group_named_optimizer_states.at("group0");
+  const auto& restored_group = restored.optimizer_checkpoint_state.group_named_optimizer_states.at("group0");
+  ASSERT_EQ(expected_group->step, restored_group->step);
+  ASSERT_EQ(expected_group->initial_lr, restored_group->initial_lr);
+  for (const auto& [name, momentums] : expected_group->param_named_optimizer_states) {
+    for (const auto& [momentum_name, momentum] : momentums) {
+      ExpectTensorsEqual(momentum, restored_group->param_named_optimizer_states.at(name).at(momentum_name));
+    }
+  }
+
+  ASSERT_EQ(restored.property_bag.GetProperty<int64_t>("epoch"), 3);
+}
+
+}  // namespace
+
+/**
+ * Save a checkpoint state asynchronously, update the state while the save is in flight,
+ * Then load it into ORT, compare with the state values at the time of the save.
+ */
+TEST(CheckpointApiTest, SaveCheckpointAsync_ThenLoad) {
+  CheckpointState state;
+  CreateAsyncCheckpointTestState(state);
+
+  CheckpointState expected_state;
+  CreateAsyncCheckpointTestState(expected_state);
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("async_ckpt"))};
+
+  ASSERT_STATUS_OK(SaveCheckpointAsync(state, checkpoint_path, true));
+  // The save works on a snapshot, so updating the state does not change the checkpoint.
+  auto& weight = state.module_checkpoint_state.named_parameters.at("fc1.weight")->Data();
+  std::fill_n(weight.GetMutable<Tensor>()->MutableData<float>(), weight.Get<Tensor>().Shape().Size(), 42.f);
+  ASSERT_STATUS_OK(WaitForCheckpoint(state));
+
+  ASSERT_TRUE(std::filesystem::exists(ExternalCheckpointDataPath(checkpoint_path)));
+
+  CheckpointState restored_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, restored_state));
+  ASSERT_TRUE(restored_state.has_external_data);
+  ExpectCheckpointStatesEqual(expected_state, restored_state);
+}
+
+/**
+ * Save a checkpoint state asynchronously twice to the same path, updating one parameter in between,
+ * Then load it into ORT, compare with the state values at the time of the second save.
+ */
+TEST(CheckpointApiTest, SaveCheckpointAsync_Incremental_ThenLoad) {
+  CheckpointState state;
+  CreateAsyncCheckpointTestState(state);
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("async_ckpt"))};
+  const PathString data_path = ExternalCheckpointDataPath(checkpoint_path);
+
+  ASSERT_STATUS_OK(SaveCheckpointAsync(state, checkpoint_path, true));
+  ASSERT_STATUS_OK(WaitForCheckpoint(state));
+  const auto data_file_size = std::filesystem::file_size(data_path);
+
+  auto& bias = state.module_checkpoint_state.named_parameters.at("fc2.bias")->Data();
+  std::fill_n(bias.GetMutable<Tensor>()->MutableData<float>(), bias.Get<Tensor>().Shape().Size(), -1.f);
+  auto& momentum = state.optimizer_checkpoint_state.group_named_optimizer_states.at("group0")
+                       ->param_named_optimizer_states.at("fc1.weight")
+                       .at("momentum1");
+  std::fill_n(momentum.GetMutable<Tensor>()->MutableData<float>(), momentum.Get<Tensor>().Shape().Size(), 0.5f);
+
+  ASSERT_STATUS_OK(SaveCheckpointAsync(state, checkpoint_path, true));
+  ASSERT_STATUS_OK(WaitForCheckpoint(state));
+  // The changed tensors are rewritten in place.
+  ASSERT_EQ(std::filesystem::file_size(data_path), data_file_size);
+
+  CheckpointState restored_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, restored_state));
+  ExpectCheckpointStatesEqual(state, restored_state);
+}
+
+/**
+ * Save a checkpoint state asynchronously, overwrite the checkpoint with another state of the same layout,
+ * Then save the first state again with a small change, load it into ORT, compare with the first state.
+ */
+TEST(CheckpointApiTest, SaveCheckpointAsync_AfterOtherSave_ThenLoad) {
+  CheckpointState state;
+  CreateAsyncCheckpointTestState(state);
+
+  CheckpointState other_state;
+  CreateAsyncCheckpointTestState(other_state);
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("async_ckpt"))};
+
+  ASSERT_STATUS_OK(SaveCheckpointAsync(state, checkpoint_path, true));
+  ASSERT_STATUS_OK(WaitForCheckpoint(state));
+  ASSERT_STATUS_OK(SaveCheckpointAsync(other_state, checkpoint_path, true));
+  ASSERT_STATUS_OK(WaitForCheckpoint(other_state));
+
+  // The external data file was written by the other save, so it must not be updated in place.
+  auto& bias = state.module_checkpoint_state.named_parameters.at("fc2.bias")->Data();
+  std::fill_n(bias.GetMutable<Tensor>()->MutableData<float>(), bias.Get<Tensor>().Shape().Size(), -1.f);
+  ASSERT_STATUS_OK(SaveCheckpointAsync(state, checkpoint_path, true));
+  ASSERT_STATUS_OK(WaitForCheckpoint(state));
+
+  CheckpointState restored_state;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, restored_state));
+  ExpectCheckpointStatesEqual(state, restored_state);
+}
+
 }  // namespace onnxruntime::training::test
@@ -1,11 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <fstream>
 
 #include "gtest/gtest.h"
 
 #include "nlohmann/json.hpp"
+#include "test/common/random_generator.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 #include "orttraining/test/training_ops/cuda/optimizer/common.h"
@@ -361,6 +363,108 @@ TEST(AdamWTest, HFAdamWMultipleWeightsStrictTest_Loop10Steps) {
   HFAdamWMultipleWeightsTestLoop10Steps(true);
 }
 
+// Scalar reference of the AdamW update of one element with bias correction.
+void AdamWReference(int64_t adam_mode, float lr, int64_t step, float alpha, float beta, float epsilon,
+                    float weight_decay, float g, float& w, float& m1, float& m2) {
+  const float alpha_correction = 1.f - static_cast<float>(std::pow(alpha, step));
+  const float beta_correction = 1.f - static_cast<float>(std::pow(beta, step));
+  if (adam_mode == 0) {
+    w -= w * lr * weight_decay;
+  }
+
+  m1 = alpha * m1 + (1.f - alpha) * g;
+  m2 = beta * m2 + (1.f - beta) * g * g;
+
+  if (adam_mode == 0) {
+    w -= lr * m1 / (alpha_correction * (std::sqrt(m2 / beta_correction) + epsilon));
+  } else {
+    const float lr_corrected = lr * std::sqrt(beta_correction) / alpha_correction;
+    w -= lr_corrected * m1 / (std::sqrt(m2) + epsilon);
+    w -= lr * weight_decay * w;
+  }
+}
+
+// Runs the CPU kernel on weights that span several chunks of the multi-tensor apply, with a size that is not a
+// multiple of the tile size, next to small weights. TMoment is the type that the momentums are stored in.
+template <typename TMoment>
+void CpuAdamWChunkedTest(int64_t adam_mode, float momentum_rtol) {
+  constexpr float lr = 1e-3f;
+  constexpr int64_t step = 3;
+  constexpr float alpha = 0.9f;
+  constexpr float beta = 0.999f;
+  constexpr float epsilon = 1e-8f;
+  constexpr float weight_decay = 1e-2f;
+
+  const std::vector<VectorInt64> shapes{{5}, {3, 70001}, {64, 1024}, {1}};
+  RandomValueGenerator random{};
+
+  SeqTensors<float> weights, gradients, updated_weights;
+  SeqTensors<TMoment> momentums_1, momentums_2, updated_momentums_1, updated_momentums_2;
+  for (const auto& shape : shapes) {
+    std::vector<float> w = random.Uniform<float>(shape, -1.f, 1.f);
+    std::vector<float> g = random.Uniform<float>(shape, -1.f, 1.f);
+    std::vector<TMoment> m1 = random.Uniform<TMoment>(shape, -0.1f, 0.1f);
+    std::vector<TMoment> m2 = random.Uniform<TMoment>(shape, 0.f, 0.01f);
+    weights.AddTensor(shape, w);
+    gradients.AddTensor(shape, g);
+    momentums_1.AddTensor(shape, m1);
+    momentums_2.AddTensor(shape, m2);
+
+    for (size_t i = 0; i < w.size(); ++i) {
+      float m1_value = static_cast<float>(m1[i]);
+      float m2_value = static_cast<float>(m2[i]);
+      AdamWReference(adam_mode, lr, step, alpha, beta, epsilon, weight_decay, g[i], w[i], m1_value, m2_value);
+      m1[i] = TMoment(m1_value);
+      m2[i] = TMoment(m2_value);
+    }
+    updated_weights.AddTensor(shape, w);
+    updated_momentums_1.AddTensor(shape, m1);
+    updated_momentums_2.AddTensor(shape, m2);
+  }
+
+  OpTester test("AdamWOptimizer", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("alpha", alpha);
+  test.AddAttribute("beta", beta);
+  test.AddAttribute("epsilon", epsilon);
+  test.AddAttribute("weight_decay", weight_decay);
+  test.AddAttribute("adam_mode", adam_mode);
+  test.AddAttribute("correct_bias", static_cast<int64_t>(1));
+
+  test.AddInput<float>("lr", {}, {lr});
+  test.AddInput<int64_t>("step", {}, {step});
+  test.AddSeqInput("weights", weights);
+  test.AddSeqInput("gradients", gradients);
+  test.AddSeqInput("momentums_1", momentums_1);
+  test.AddSeqInput("momentums_2", momentums_2);
+
+  test.AddOutput<bool>("updated_flag", {}, {1});
+  test.AddSeqOutput("updated_weights", updated_weights, 1e-4f, 1e-6f);
+  test.AddSeqOutput("updated_momentums_1", updated_momentums_1, momentum_rtol, 1e-6f);
+  test.AddSeqOutput("updated_momentums_2", updated_momentums_2, momentum_rtol, 1e-7f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(AdamWTest, CpuTorchAdamWChunkedTest) {
+  CpuAdamWChunkedTest<float>(0, 1e-4f);
+}
+
+TEST(AdamWTest, CpuHFAdamWChunkedTest) {
+  CpuAdamWChunkedTest<float>(1, 1e-4f);
+}
+
+// The momentums are rounded to bfloat16/float16 after the update, which the reference does as well, so the
+// tolerance only needs to cover a rounding to the neighboring value.
+TEST(AdamWTest, CpuHFAdamWBFloat16MomentumsTest) {
+  CpuAdamWChunkedTest<BFloat16>(1, 1e-2f);
+}
+
+TEST(AdamWTest, CpuHFAdamWFloat16MomentumsTest) {
+  CpuAdamWChunkedTest<MLFloat16>(1, 2e-3f);
+}
+
 }  // namespace
 
 }  // namespace optimizer
@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 
 #include "nlohmann/json.hpp"
+#include "test/common/random_generator.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 #include "orttraining/test/training_ops/cuda/optimizer/common.h"
@@ -296,6 +297,36 @@ TEST(SGDOptimizerV2Test, SGDMultipleWeightsNoUpdateTest_Loop10Steps) {
   SGDMultipleWeightsTestLoop10Steps(true, &update_signal);
 }
 
+// Runs the CPU kernel on a weight that spans several chunks of the multi-tensor apply next to small weights.
+TEST(SGDOptimizerV2Test, CpuSGDChunkedTest) {
+  constexpr float lr = 1e-2f;
+  const std::vector<VectorInt64> shapes{{5}, {3, 70001}, {1}};
+  RandomValueGenerator random{};
+
+  SeqTensors<float> weights, gradients, updated_weights;
+  for (const auto& shape : shapes) {
+    std::vector<float> w = random.Uniform<float>(shape, -1.f, 1.f);
+    std::vector<float> g = random.Uniform<float>(shape, -1.f, 1.f);
+    weights.AddTensor(shape, w);
+    gradients.AddTensor(shape, g);
+    for (size_t i = 0; i < w.size(); ++i) {
+      w[i] -= lr * g[i];
+    }
+    updated_weights.AddTensor(shape, w);
+  }
+
+  OpTester test("SGDOptimizerV2", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("lr", {}, {lr});
+  test.AddSeqInput("weights", weights);
+  test.AddSeqInput("gradients", gradients);
+  test.AddOutput<bool>("update_completed", {}, {true});
+  test.AddSeqOutput("updated_weights", updated_weights, 1e-5f, 1e-6f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 }  // namespace
 
 }  // namespace optimizer
@@ -3,11 +3,22 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
+#include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/murmurhash3.h"
 #include "core/graph/graph_flatbuffers_utils.h"
 #include "core/framework/tensor_external_data_info.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime::training::api {
 
@@ -18,19 +29,31 @@ PathString ExternalCheckpointDataPath(const PathString& checkpoint_path) {
 namespace {
 
 /**
- * @brief Helper method to read data from an external file.
- * @param external_data_stream Stream that data will be read from.
- * @param offset Offset in the external data file to begin reading from.
- * @param output_buffer Buffer to store the read data.
+ * @brief Helper method to map the external data file of a checkpoint into memory.
+ * @param checkpoint_path Path to the checkpoint file.
+ * @param mapped_data Mapped contents of the external data file.
+ * @param external_data_reader Delegate to read tensor data from the mapped file. Valid as long as mapped_data is.
  * @return Status of the operation.
  */
-Status ReadFromExternalFileHelper(std::ifstream& external_data_stream,
-                                  uint64_t offset, gsl::span<uint8_t> output_buffer) {
-  external_data_stream.seekg(offset);
-  external_data_stream.read(reinterpret_cast<char*>(output_buffer.data()), output_buffer.size());
-
-  const auto [err, msg] = GetErrnoInfo();
-  ORT_RETURN_IF(external_data_stream.fail(), "Failed reading external checkpoint data. ", msg, " errno:", errno);
+Status MapExternalDataFile(const PathString& checkpoint_path, Env::MappedMemoryPtr& mapped_data,
+                           fbs::utils::ExternalDataReader& external_data_reader) {
+  const auto data_path = ExternalCheckpointDataPath(checkpoint_path);
+  size_t num_bytes = 0;
+  Status status = Env::Default().GetFileLength(data_path.c_str(), num_bytes);
+  if (status.IsOK()) {
+    status = Env::Default().MapFileIntoMemory(data_path.c_str(), 0, num_bytes, mapped_data);
+  }
+  ORT_RETURN_IF_NOT(status.IsOK(), "Failed to open checkpoint's external data file: ", ToUTF8String(data_path),
+                    " error:", status.ErrorMessage());
+
+  const char* data = mapped_data.get();
+  external_data_reader = [data, num_bytes](uint64_t offset, gsl::span<uint8_t> output_buffer) {
+    ORT_RETURN_IF(offset > num_bytes || output_buffer.size() > num_bytes - offset,
+                  "Checkpoint external data is out of bounds. Offset: ", offset, " size: ", output_buffer.size(),
+                  " file size: ", num_bytes);
+    std::memcpy(output_buffer.data(), data + offset, output_buffer.size());
+    return Status::OK();
+  };
 
   return Status::OK();
 }
@@ -43,7 +66,7 @@ Status ReadFromExternalFileHelper(std::ifstream& external_data_stream,
  * @param offset Modified to be the offset in the external data file where the data was written.
  * @return Status of the operation.
  */
-Status WriteToExternalFileHelper(std::ofstream& external_data_stream,
+Status WriteToExternalFileHelper(std::ostream& external_data_stream,
                                  int32_t data_type, gsl::span<const uint8_t> bytes, uint64_t& offset) {
   // for now align everything to 4 or 8 bytes. we can optimize this later if needed.
   int32_t alignment = 4;
@@ -438,11 +461,13 @@ Status FromModuleState(const ModuleCheckpointState& module_state,
  *                        and second order momentums ...).
  * @param builder Flatbuffer builder.
  * @param fbs_optimizer_groups Flatbuffer optimizer groups to be populated.
+ * @param external_data_writer Optional delegate to write tensor data to an external file.
  * @return Status of the operation.
  */
 Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
                           flatbuffers::FlatBufferBuilder& builder,
-                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups) {
+                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups,
+                          fbs::utils::ExternalDataWriter external_data_writer = nullptr) {
   if (optimizer_state.group_named_optimizer_states.empty()) {
     return Status::OK();
   }
@@ -462,7 +487,7 @@ Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
       ORT_RETURN_IF_ERROR(FlatbufferTensorsFromOrtValues(
           param_optimizer_state,
           optimizer_state.optimizer_session_data_transfer_mgr,
-          builder, momentums));
+          builder, momentums, external_data_writer));
 
       const auto fbs_param_name = builder.CreateString(param_name);
       const auto fbs_momentums = builder.CreateVector(momentums);
@@ -547,33 +572,20 @@ Status FromPropertyBag(const PropertyBag& property_bag, flatbuffers::FlatBufferB
 }
 
 /**
- * @brief Save from a checkpoint state to a checkpoint file.
+ * @brief Build a flatbuffer checkpoint from a checkpoint state.
  *
  * @param state parameter/optimizer and other user defined training states.
- * @param checkpoint_path file where checkpoint is saved.
  * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
+ * @param external_data_writer Optional delegate to write the tensor data to an external file.
+ * @param write_optimizer_state_to_external_data Whether the optimizer state tensors are written with
+ *                                               external_data_writer as well.
+ * @param builder Flatbuffer builder that the checkpoint is finished in.
  * @return Status of the operation.
  */
 Status FromCheckpointState(
-    const CheckpointState& state, const PathString& checkpoint_path, const bool include_optimizer_state) {
-  flatbuffers::FlatBufferBuilder builder(1024);
-
-  fbs::utils::ExternalDataWriter external_data_writer = nullptr;
-  std::optional<std::ofstream> external_data_stream;
-  if (state.has_external_data) {
-    auto data_path = ExternalCheckpointDataPath(checkpoint_path);
-    external_data_stream = std::ofstream(data_path, std::ios::binary);
-
-    ORT_RETURN_IF(external_data_stream->fail(), "Failed to create checkpoint's external data file: ",
-                  ToUTF8String(data_path));
-
-    // setup the data writer to write aligned data to external_data_stream
-    external_data_writer = [&external_data_stream](int32_t data_type, gsl::span<const uint8_t> bytes,
-                                                   uint64_t& offset) {
-      return WriteToExternalFileHelper(external_data_stream.value(), data_type, bytes, offset);
-    };
-  }
-
+    const CheckpointState& state, const bool include_optimizer_state,
+    fbs::utils::ExternalDataWriter external_data_writer, const bool write_optimizer_state_to_external_data,
+    flatbuffers::FlatBufferBuilder& builder) {
   // Write weight tensors files.
   flatbuffers::Offset<fbs::ModuleState> module_state;
   ORT_RETURN_IF_ERROR(FromModuleState(state.module_checkpoint_state, builder, module_state, external_data_writer));
@@ -581,7 +593,8 @@ Status FromCheckpointState(
   // Write optimizer state tensors files.
   std::vector<flatbuffers::Offset<fbs::OptimizerGroup>> optimizer_groups;
   if (include_optimizer_state) {
-    ORT_RETURN_IF_ERROR(FromOptimizerState(state.optimizer_checkpoint_state, builder, optimizer_groups));
+    ORT_RETURN_IF_ERROR(FromOptimizerState(state.optimizer_checkpoint_state, builder, optimizer_groups,
+                                           write_optimizer_state_to_external_data ? external_data_writer : nullptr));
   }
 
   flatbuffers::Offset<fbs::PropertyBag> property_bag;
@@ -597,6 +610,38 @@ Status FromCheckpointState(
   const auto checkpoint = checkpoint_builder.Finish();
   builder.Finish(checkpoint, fbs::CheckpointIdentifier());
 
+  return Status::OK();
+}
+
+/**
+ * @brief Save from a checkpoint state to a checkpoint file.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param checkpoint_path file where checkpoint is saved.
+ * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
+ * @return Status of the operation.
+ */
+Status FromCheckpointState(
+    const CheckpointState& state, const PathString& checkpoint_path, const bool include_optimizer_state) {
+  fbs::utils::ExternalDataWriter external_data_writer = nullptr;
+  std::optional<std::ofstream> external_data_stream;
+  if (state.has_external_data) {
+    auto data_path = ExternalCheckpointDataPath(checkpoint_path);
+    external_data_stream = std::ofstream(data_path, std::ios::binary);
+
+    ORT_RETURN_IF(external_data_stream->fail(), "Failed to create checkpoint's external data file: ",
+                  ToUTF8String(data_path));
+
+    // setup the data writer to write aligned data to external_data_stream
+    external_data_writer = [&external_data_stream](int32_t data_type, gsl::span<const uint8_t> bytes,
+                                                   uint64_t& offset) {
+      return WriteToExternalFileHelper(external_data_stream.value(), data_type, bytes, offset);
+    };
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  ORT_RETURN_IF_ERROR(FromCheckpointState(state, include_optimizer_state, external_data_writer, false, builder));
+
   return save::ToFile(checkpoint_path, builder);
 }
 
@@ -605,24 +650,20 @@ Status FromCheckpointState(
 namespace load {
 
 /**
- * @brief Load checkpoint flatbuffer from file.
+ * @brief Map checkpoint flatbuffer from file into memory.
  * @param checkpoint_path Path to the checkpoint file.
- * @param checkpoint_bytes Contents of the checkpoint file in bytes.
- * @param checkpoint_span Checkpoint bytes represented as a span.
+ * @param mapped_checkpoint Mapped contents of the checkpoint file.
+ * @param checkpoint_bytes Checkpoint bytes represented as a span. Valid as long as mapped_checkpoint is.
  * @return Status of the operation.
  *
  */
-Status FromFile(const PathString& checkpoint_path, InlinedVector<uint8_t>& checkpoint_bytes) {
+Status FromFile(const PathString& checkpoint_path, Env::MappedMemoryPtr& mapped_checkpoint,
+                gsl::span<const uint8_t>& checkpoint_bytes) {
   size_t num_bytes = 0;
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(checkpoint_path.c_str(), num_bytes));
-  checkpoint_bytes.resize(num_bytes);
-
-  std::ifstream bytes_stream(checkpoint_path, std::ifstream::in | std::ifstream::binary);
-  bytes_stream.read(reinterpret_cast<char*>(checkpoint_bytes.data()), num_bytes);
-
-  ORT_RETURN_IF_NOT(bytes_stream, "Loading checkpoint from ", ToUTF8String(checkpoint_path), " failed. Only ",
-                    bytes_stream.gcount(), "/", num_bytes, " bytes could be read.");
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(checkpoint_path.c_str(), 0, num_bytes, mapped_checkpoint));
 
+  checkpoint_bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_checkpoint.get()), num_bytes);
   return Status::OK();
 }
 
@@ -806,17 +847,10 @@ Status ToModelProto(gsl::span<const uint8_t> checkpoint_bytes,
                 "Expected: Complete checkpoint. Actual: Nominal checkpoint.");
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  Env::MappedMemoryPtr mapped_external_data;
 
   if (module_state->has_external_data()) {
-    auto data_path = ExternalCheckpointDataPath(checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-    ORT_RETURN_IF(external_data_stream->fail(),
-                  "Failed to open checkpoint's external data file: ", ToUTF8String(data_path));
-
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
-    };
+    ORT_RETURN_IF_ERROR(MapExternalDataFile(checkpoint_path, mapped_external_data, external_data_reader));
   }
 
   InlinedHashMap<std::string, ONNX_NAMESPACE::TensorProto> param_tensor_protos;
@@ -876,26 +910,14 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
   const auto* fbs_module_state = fbs_checkpoint->module_state();
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  Env::MappedMemoryPtr mapped_external_data;
 
   state.has_external_data = false;
   if (nullptr != fbs_module_state && fbs_module_state->has_external_data()) {
     state.has_external_data = true;
     ORT_RETURN_IF_NOT(checkpoint_path.has_value(),
                       "External data is present in the checkpoint but the checkpoint path is not provided. External data with loading from buffer is not supported yet.");
-    auto data_path = ExternalCheckpointDataPath(*checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-
-    if (external_data_stream.value().fail()) {
-      const auto [err, errmsg] = GetErrnoInfo();
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                             "Failed to open checkpoint's external data file: ", ToUTF8String(data_path),
-                             " error:", errmsg, " errno:", err);
-    }
-
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
-    };
+    ORT_RETURN_IF_ERROR(MapExternalDataFile(*checkpoint_path, mapped_external_data, external_data_reader));
   }
 
   if (nullptr != fbs_module_state) {
@@ -932,8 +954,310 @@ InlinedVector<ONNX_NAMESPACE::TensorProto> Nominalize(gsl::span<const ONNX_NAMES
 }
 #endif
 
+/**
+ * @brief Copy a tensor OrtValue to a new tensor on CPU.
+ *
+ * @param src OrtValue to copy.
+ * @param data_transfer_manager Data transfer manager to copy a non-CPU tensor to CPU.
+ * @param dst OrtValue to be populated with the copy.
+ * @return Status of the operation.
+ */
+Status SnapshotOrtValue(const OrtValue& src, const DataTransferManager* data_transfer_manager, OrtValue& dst) {
+  ORT_RETURN_IF_NOT(src.IsTensor(), "Only tensor OrtValues can be saved to a checkpoint.");
+  const Tensor& src_tensor = src.Get<Tensor>();
+  ORT_RETURN_IF(src_tensor.IsDataTypeString(), "String tensors cannot be saved to a checkpoint asynchronously.");
+
+  Tensor::InitOrtValue(src_tensor.DataType(), src_tensor.Shape(), std::make_shared<CPUAllocator>(), dst);
+  Tensor& dst_tensor = *dst.GetMutable<Tensor>();
+  if (src_tensor.Location().device.Type() == OrtDevice::CPU) {
+    if (src_tensor.SizeInBytes() > 0) {
+      std::memcpy(dst_tensor.MutableDataRaw(), src_tensor.DataRaw(), src_tensor.SizeInBytes());
+    }
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_NOT(data_transfer_manager,
+                    "Cannot save OrtValue to a checkpoint. Expected: A valid data transfer manager. ",
+                    "Actual: nullptr.");
+  return data_transfer_manager->CopyTensor(src_tensor, dst_tensor);
+}
+
+/**
+ * @brief Copy the tensors of a checkpoint state to CPU, so that the copy can be saved while the state is updated.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param include_optimizer_state Whether to copy the optimizer state.
+ * @param snapshot Checkpoint state to be populated with the copy.
+ * @return Status of the operation.
+ */
+Status SnapshotCheckpointState(const CheckpointState& state, const bool include_optimizer_state,
+                               CheckpointState& snapshot) {
+  const auto& module_state = state.module_checkpoint_state;
+  for (const auto& [name, param] : module_state.named_parameters) {
+    OrtValue value;
+    ORT_RETURN_IF_ERROR(SnapshotOrtValue(param->Data(), module_state.train_session_data_transfer_mgr, value));
+    snapshot.module_checkpoint_state.named_parameters.insert(
+        {name, std::make_shared<Parameter>(name, value, param->RequiresGrad())});
+  }
+  snapshot.module_checkpoint_state.train_session_data_transfer_mgr = nullptr;
+  snapshot.module_checkpoint_state.is_nominal_state = module_state.is_nominal_state;
+
+  snapshot.optimizer_checkpoint_state.optimizer_session_data_transfer_mgr = nullptr;
+  if (include_optimizer_state) {
+    const auto& optimizer_state = state.optimizer_checkpoint_state;
+    for (const auto& [group_name, group_state] : optimizer_state.group_named_optimizer_states) {
+      auto group_snapshot = std::make_shared<GroupOptimizerState>();
+      group_snapshot->step = group_state->step;
+      group_snapshot->initial_lr = group_state->initial_lr;
+      group_snapshot->learning_rate = group_state->learning_rate;
+      for (const auto& [param_name, param_optimizer_state] : group_state->param_named_optimizer_states) {
+        auto& param_snapshot = group_snapshot->param_named_optimizer_states[param_name];
+        for (const auto& [momentum_name, momentum] : param_optimizer_state) {
+          ORT_RETURN_IF_ERROR(SnapshotOrtValue(momentum, optimizer_state.optimizer_session_data_transfer_mgr,
+                                               param_snapshot[momentum_name]));
+        }
+      }
+      snapshot.optimizer_checkpoint_state.group_named_optimizer_states.insert({group_name, group_snapshot});
+    }
+  }
+
+  snapshot.property_bag = state.property_bag;
+  snapshot.has_external_data = true;
+
+  return Status::OK();
+}
+
 }  // namespace
 
+/**
+ * @brief Saves checkpoint state snapshots on a background thread.
+ *
+ * The tensor data of a snapshot is written to the external data file, followed by a footer with a generation number
+ * that is unique to the save. The saver remembers the offset and a hash of every tensor it wrote, so the next save to
+ * the same checkpoint path with the same tensors only rewrites the tensors whose hash changed, in place. The footer
+ * guards against updating a file that was written by someone else since, e.g. by a synchronous SaveCheckpoint.
+ *
+ * In-place updates are limited to small changes, as a failure in the middle leaves a partially updated checkpoint.
+ * Larger changes are written to temporary files that then replace the checkpoint.
+ */
+class AsyncCheckpointSaver {
+ public:
+  AsyncCheckpointSaver() : next_generation_{(uint64_t{std::random_device{}()} << 32) | std::random_device{}()} {}
+
+  ~AsyncCheckpointSaver() {
+    ORT_IGNORE_RETURN_VALUE(Wait());
+  }
+
+  /**
+   * @brief Start saving the snapshot. The previous save must have been waited for.
+   */
+  void Start(std::unique_ptr<CheckpointState> snapshot, const PathString& checkpoint_path,
+             const bool include_optimizer_state) {
+    worker_ = std::thread([this, snapshot = std::move(snapshot), checkpoint_path, include_optimizer_state]() {
+      ORT_TRY {
+        status_ = WriteSnapshot(*snapshot, checkpoint_path, include_optimizer_state);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          status_ = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Saving checkpoint failed: ", ex.what());
+        });
+      }
+
+      if (!status_.IsOK()) {
+        // The external data file is in an unknown state. Write it in full on the next save.
+        last_checkpoint_path_.clear();
+        last_records_.clear();
+      }
+    });
+  }
+
+  /**
+   * @brief Wait for the current save to finish.
+   * @return Status of the save. OK if there is no save in flight.
+   */
+  Status Wait() {
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+
+    Status status = status_;
+    status_ = Status::OK();
+    return status;
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncCheckpointSaver);
+
+  struct TensorRecord {
+    int32_t data_type;
+    size_t num_bytes;
+    uint64_t offset;
+    std::array<uint32_t, 4> hash;
+  };
+
+  // Footer at the end of the external data file: magic number followed by the generation of the save.
+  static constexpr uint64_t kFooterMagic = 0x4e45474b43545241;  // "ARTCKGEN"
+  static constexpr size_t kFooterSize = 2 * sizeof(uint64_t);
+
+  // Rewrite the external data file when more than 1/kMaxInPlaceUpdateDivisor of it changed.
+  static constexpr size_t kMaxInPlaceUpdateDivisor = 2;
+
+  static Status WriteFooter(std::ostream& stream, uint64_t generation) {
+    const std::array<uint64_t, 2> footer{kFooterMagic, generation};
+    stream.write(reinterpret_cast<const char*>(footer.data()), kFooterSize);
+    ORT_RETURN_IF(stream.fail(), "Failed writing external checkpoint data.");
+    return Status::OK();
+  }
+
+  static bool ReadFooter(const PathString& data_path, uint64_t& generation) {
+    std::ifstream stream(data_path, std::ios::binary);
+    std::array<uint64_t, 2> footer{};
+    stream.seekg(-static_cast<std::streamoff>(kFooterSize), std::ios::end);
+    stream.read(reinterpret_cast<char*>(footer.data()), kFooterSize);
+    if (stream.fail() || footer[0] != kFooterMagic) {
+      return false;
+    }
+
+    generation = footer[1];
+    return true;
+  }
+
+  static Status ReplaceFile(const PathString& from, const PathString& to) {
+    std::error_code error;
+    std::filesystem::rename(from, to, error);
+    ORT_RETURN_IF(error, "Failed to replace checkpoint file ", ToUTF8String(to), ". error: ", error.message());
+    return Status::OK();
+  }
+
+  Status WriteSnapshot(const CheckpointState& snapshot, const PathString& checkpoint_path,
+                       const bool include_optimizer_state) {
+    const PathString temp_checkpoint_path = checkpoint_path + ORT_TSTR(".tmp");
+
+    // Without module state the checkpoint has no external data.
+    if (snapshot.module_checkpoint_state.named_parameters.empty()) {
+      flatbuffers::FlatBufferBuilder builder(1024);
+      ORT_RETURN_IF_ERROR(save::FromCheckpointState(snapshot, include_optimizer_state, nullptr, false, builder));
+      last_checkpoint_path_.clear();
+      last_records_.clear();
+      ORT_RETURN_IF_ERROR(save::ToFile(temp_checkpoint_path, builder));
+      return ReplaceFile(temp_checkpoint_path, checkpoint_path);
+    }
+
+    // Hash the tensors in the order that they are written.
+    std::vector<TensorRecord> records;
+    {
+      flatbuffers::FlatBufferBuilder builder(1024);
+      auto hash_tensor = [&records](int32_t data_type, gsl::span<const uint8_t> bytes, uint64_t& offset) {
+        TensorRecord record{data_type, bytes.size(), 0, {}};
+        MurmurHash3::x86_128(bytes.data(), bytes.size(), 0, record.hash.data());
+        records.push_back(record);
+        offset = 0;
+        return Status::OK();
+      };
+      ORT_RETURN_IF_ERROR(save::FromCheckpointState(snapshot, include_optimizer_state, hash_tensor, true, builder));
+    }
+
+    const auto data_path = ExternalCheckpointDataPath(checkpoint_path);
+    size_t data_file_size = 0;
+    uint64_t file_generation = 0;
+    bool incremental =
+        checkpoint_path == last_checkpoint_path_ && records.size() == last_records_.size() &&
+        std::equal(records.begin(), records.end(), last_records_.begin(),
+                   [](const TensorRecord& lhs, const TensorRecord& rhs) {
+                     return lhs.data_type == rhs.data_type && lhs.num_bytes == rhs.num_bytes;
+                   }) &&
+        Env::Default().GetFileLength(data_path.c_str(), data_file_size).IsOK() &&
+        data_file_size == last_data_file_size_ && ReadFooter(data_path, file_generation) &&
+        file_generation == last_generation_;
+
+    if (incremental) {
+      size_t changed_bytes = 0;
+      for (size_t i = 0; i < records.size(); ++i) {
+        changed_bytes += records[i].hash != last_records_[i].hash ? records[i].num_bytes : 0;
+      }
+      incremental = changed_bytes <= data_file_size / kMaxInPlaceUpdateDivisor;
+    }
+
+    const uint64_t generation = next_generation_++;
+    const PathString temp_data_path = data_path + ORT_TSTR(".tmp");
+    std::fstream external_data_stream;
+    if (incremental) {
+      external_data_stream.open(data_path, std::ios::in | std::ios::out | std::ios::binary);
+      ORT_RETURN_IF(external_data_stream.fail(), "Failed to open checkpoint's external data file: ",
+                    ToUTF8String(data_path));
+
+      // Invalidate the footer first, so that a failed update is not mistaken for the last save.
+      external_data_stream.seekp(static_cast<std::streamoff>(data_file_size - kFooterSize));
+      ORT_RETURN_IF_ERROR(WriteFooter(external_data_stream, 0));
+      external_data_stream.flush();
+    } else {
+      external_data_stream.open(temp_data_path, std::ios::out | std::ios::trunc | std::ios::binary);
+      ORT_RETURN_IF(external_data_stream.fail(), "Failed to open checkpoint's external data file: ",
+                    ToUTF8String(temp_data_path));
+    }
+
+    size_t index = 0;
+    auto write_tensor = [&](int32_t data_type, gsl::span<const uint8_t> bytes, uint64_t& offset) {
+      ORT_RETURN_IF(index >= records.size(), "Checkpoint tensors changed while saving.");
+      TensorRecord& record = records[index];
+      if (!incremental) {
+        ORT_RETURN_IF_ERROR(WriteToExternalFileHelper(external_data_stream, data_type, bytes, offset));
+      } else {
+        const TensorRecord& last_record = last_records_[index];
+        offset = last_record.offset;
+        if (record.hash != last_record.hash) {
+          external_data_stream.seekp(static_cast<std::streamoff>(offset));
+          external_data_stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+          ORT_RETURN_IF(external_data_stream.fail(), "Failed writing external checkpoint data.");
+        }
+      }
+      record.offset = offset;
+      ++index;
+      return Status::OK();
+    };
+
+    flatbuffers::FlatBufferBuilder builder(1024);
+    ORT_RETURN_IF_ERROR(save::FromCheckpointState(snapshot, include_optimizer_state, write_tensor, true, builder));
+    ORT_RETURN_IF(index != records.size(), "Checkpoint tensors changed while saving.");
+
+    if (incremental) {
+      external_data_stream.seekp(static_cast<std::streamoff>(data_file_size - kFooterSize));
+    } else {
+      external_data_stream.seekp(0, std::ios::end);
+    }
+    ORT_RETURN_IF_ERROR(WriteFooter(external_data_stream, generation));
+
+    external_data_stream.close();
+    ORT_RETURN_IF(external_data_stream.fail(), "Failed writing external checkpoint data.");
+
+    ORT_RETURN_IF_ERROR(save::ToFile(temp_checkpoint_path, builder));
+    if (!incremental) {
+      ORT_RETURN_IF_ERROR(ReplaceFile(temp_data_path, data_path));
+    }
+    ORT_RETURN_IF_ERROR(ReplaceFile(temp_checkpoint_path, checkpoint_path));
+    ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(data_path.c_str(), data_file_size));
+
+    last_checkpoint_path_ = checkpoint_path;
+    last_records_ = std::move(records);
+    last_data_file_size_ = data_file_size;
+    last_generation_ = generation;
+
+    return Status::OK();
+  }
+
+  std::thread worker_;
+  Status status_;
+
+  // Generation written to the footer of the next save.
+  uint64_t next_generation_;
+
+  // Layout of the external data file written by the last successful save.
+  PathString last_checkpoint_path_;
+  std::vector<TensorRecord> last_records_;
+  size_t last_data_file_size_{0};
+  uint64_t last_generation_{0};
+};
+
 #if !defined(ORT_MINIMAL_BUILD)
 Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_tensor_protos,
                       gsl::span<const ONNX_NAMESPACE::TensorProto> non_trainable_tensor_protos,
@@ -954,11 +1278,32 @@ Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoin
   return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state);
 }
 
+Status SaveCheckpointAsync(CheckpointState& state, const PathString& checkpoint_path,
+                           const bool include_optimizer_state) {
+  ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
+
+  if (!state.async_checkpoint_saver) {
+    state.async_checkpoint_saver = std::make_shared<AsyncCheckpointSaver>();
+  }
+  ORT_RETURN_IF_ERROR(state.async_checkpoint_saver->Wait());
+
+  auto snapshot = std::make_unique<CheckpointState>();
+  ORT_RETURN_IF_ERROR(SnapshotCheckpointState(state, include_optimizer_state, *snapshot));
+  state.async_checkpoint_saver->Start(std::move(snapshot), checkpoint_path, include_optimizer_state);
+
+  return Status::OK();
+}
+
+Status WaitForCheckpoint(CheckpointState& state) {
+  return state.async_checkpoint_saver ? state.async_checkpoint_saver->Wait() : Status::OK();
+}
+
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
-  InlinedVector<uint8_t> checkpoint_bytes;
-  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
+  Env::MappedMemoryPtr mapped_checkpoint;
+  gsl::span<const uint8_t> checkpoint_bytes;
+  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, mapped_checkpoint, checkpoint_bytes));
   return load::ToCheckpointState(checkpoint_bytes, checkpoint_states, checkpoint_path);
 }
 
@@ -973,8 +1318,9 @@ Status LoadCheckpointToModel(const PathString& checkpoint_path,
                              ONNX_NAMESPACE::ModelProto& model_proto) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
-  InlinedVector<uint8_t> checkpoint_bytes;
-  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, checkpoint_bytes));
+  Env::MappedMemoryPtr mapped_checkpoint;
+  gsl::span<const uint8_t> checkpoint_bytes;
+  ORT_RETURN_IF_ERROR(load::FromFile(checkpoint_path, mapped_checkpoint, checkpoint_bytes));
   return load::ToModelProto(checkpoint_bytes, model_proto, checkpoint_path);
 }
 #endif
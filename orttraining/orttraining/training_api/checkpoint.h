@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "core/platform/path_lib.h"
 #include "orttraining/training_api/checkpoint_property.h"
 #include "orttraining/training_api/module.h"
@@ -25,12 +27,16 @@
 
 namespace onnxruntime::training::api {
 
+class AsyncCheckpointSaver;
+
 struct CheckpointState {
  public:
   ModuleCheckpointState module_checkpoint_state;
   OptimizerCheckpointState optimizer_checkpoint_state;
   PropertyBag property_bag;
   bool has_external_data = false;
+  // Background save started by SaveCheckpointAsync. Created on the first asynchronous save.
+  std::shared_ptr<AsyncCheckpointSaver> async_checkpoint_saver;
 };
 
 /**
@@ -50,6 +56,34 @@ PathString ExternalCheckpointDataPath(const PathString& checkpoint_path);
 Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint_path,
                       const bool include_optimizer_state);
 
+/**
+ * @brief Save training states as ORT checkpoint on a background thread.
+ *
+ * The tensors of the state are copied to a CPU snapshot before the function returns, so training can continue
+ * to update the state while the snapshot is serialized and written. The tensor data is written to the external
+ * data file of the checkpoint (see ExternalCheckpointDataPath). If the previous asynchronous save of the state
+ * went to the same checkpoint path with the same tensors, and the file has not been written since, the external
+ * data file is updated in place and only the tensors whose contents changed since then, as detected by a hash of
+ * each tensor, are rewritten. Larger changes are written to temporary files that then replace the checkpoint.
+ *
+ * A state has at most one asynchronous save in flight. A new save waits for the previous one to finish.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param checkpoint_path file where checkpoint is saved.
+ * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
+ * @return Status of starting the save, or the error of the previous asynchronous save if it failed.
+ */
+Status SaveCheckpointAsync(CheckpointState& state, const PathString& checkpoint_path,
+                           const bool include_optimizer_state);
+
+/**
+ * @brief Wait for the asynchronous save of the state to finish.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @return Status of the save. OK if no asynchronous save was started.
+ */
+Status WaitForCheckpoint(CheckpointState& state);
+
 #if !defined(ORT_MINIMAL_BUILD)
 /**
  * @brief Save ONNX initializers as ORT checkpoint.
@@ -75,6 +109,8 @@ Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_ten
 /**
  * @brief Load training states from ORT checkpoint.
  *
+ * The checkpoint file and its external data file are mapped into memory rather than read into a buffer.
+ *
  * @param checkpoint_path file where checkpoint is stored.
  * @param checkpoint_states parameter/optimizer and other user defined training states.
  * @return Status
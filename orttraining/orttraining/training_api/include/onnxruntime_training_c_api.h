@@ -724,6 +724,41 @@ struct OrtTrainingApi {
                   _Outptr_ OrtValue** parameter);
 
   /// @}
+
+  /// \name Accessing The Training Session State
+  /// @{
+
+  /** \brief Save the given state to a checkpoint file on disk in the background.
+   *
+   * The tensors of the checkpoint state are copied to CPU before the function returns. The copy is then
+   * written to the checkpoint file and its external data file on a background thread, so training can continue
+   * while the checkpoint is being written. If the previous asynchronous save of the state was to the same
+   * checkpoint path and the checkpoint has not been written since, only the tensors that changed are rewritten.
+   *
+   * Only one asynchronous save of a checkpoint state is in flight at a time. This function waits for the previous
+   * one to finish and returns its error if it failed. Call OrtTrainingApi::WaitForCheckpoint before loading the
+   * checkpoint or releasing the state.
+   *
+   * \param[in] checkpoint_state The checkpoint state to save.
+   * \param[in] checkpoint_path Path to the checkpoint file.
+   * \param[in] include_optimizer_state Flag to indicate whether to save the optimizer state or not.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   */
+  ORT_API2_STATUS(SaveCheckpointAsync, _Inout_ OrtCheckpointState* checkpoint_state,
+                  _In_ const ORTCHAR_T* checkpoint_path, const bool include_optimizer_state);
+
+  /** \brief Wait for the asynchronous save of the given state to finish.
+   *
+   * \param[in] checkpoint_state The checkpoint state that is being saved by OrtTrainingApi::SaveCheckpointAsync.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   */
+  ORT_API2_STATUS(WaitForCheckpoint, _Inout_ OrtCheckpointState* checkpoint_state);
+
+  /// @}
 };
 
 typedef struct OrtTrainingApi OrtTrainingApi;
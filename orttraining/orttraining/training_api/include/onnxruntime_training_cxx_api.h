@@ -114,6 +114,28 @@ class CheckpointState : public detail::Base<OrtCheckpointState> {
                              const std::basic_string<ORTCHAR_T>& path_to_checkpoint,
                              const bool include_optimizer_state = false);
 
+  /** \brief Save the given state to a checkpoint file on disk in the background.
+   *
+   * The tensors of the state are copied before the function returns and written on a background thread.
+   * Consecutive saves to the same path only rewrite the tensors that changed. Call
+   * Ort::CheckpointState::WaitForCheckpoint to wait for the save to finish.
+   *
+   * \param[in] checkpoint_state The checkpoint state to save.
+   * \param[in] path_to_checkpoint Path to the checkpoint file.
+   * \param[in] include_optimizer_state Flag to indicate whether to save the optimizer state or not.
+   *
+   */
+  static void SaveCheckpointAsync(CheckpointState& checkpoint_state,
+                                  const std::basic_string<ORTCHAR_T>& path_to_checkpoint,
+                                  const bool include_optimizer_state = false);
+
+  /** \brief Wait for the asynchronous save of this state to finish.
+   *
+   * Throws the error of the save if it failed.
+   *
+   */
+  void WaitForCheckpoint();
+
   /** \brief Adds or updates the given property to/in the checkpoint state.
    *
    * Runtime properties such as epoch, training step, best score, and others can be added to the checkpoint
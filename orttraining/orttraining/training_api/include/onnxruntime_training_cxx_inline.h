@@ -206,6 +206,17 @@ inline void CheckpointState::SaveCheckpoint(const CheckpointState& checkpoint_st
                                                include_optimizer_state));
 }
 
+inline void CheckpointState::SaveCheckpointAsync(CheckpointState& checkpoint_states,
+                                                 const std::basic_string<ORTCHAR_T>& path_to_checkpoint,
+                                                 const bool include_optimizer_state) {
+  ThrowOnError(GetTrainingApi().SaveCheckpointAsync(checkpoint_states, path_to_checkpoint.c_str(),
+                                                    include_optimizer_state));
+}
+
+inline void CheckpointState::WaitForCheckpoint() {
+  ThrowOnError(GetTrainingApi().WaitForCheckpoint(p_));
+}
+
 inline void TrainingSession::ExportModelForInferencing(const std::basic_string<ORTCHAR_T>& inference_model_path,
                                                        const std::vector<std::string>& graph_output_names) {
   std::vector<const char*> output_names;
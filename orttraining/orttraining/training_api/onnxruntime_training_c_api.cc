@@ -652,6 +652,26 @@ ORT_API_STATUS_IMPL(OrtTrainingApis::GetParameter, _In_ const OrtCheckpointState
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtTrainingApis::SaveCheckpointAsync, _Inout_ OrtCheckpointState* checkpoint_state,
+                    _In_ const ORTCHAR_T* checkpoint_path, const bool include_optimizer_state) {
+  API_IMPL_BEGIN
+  auto chkpt_state = reinterpret_cast<onnxruntime::training::api::CheckpointState*>(checkpoint_state);
+  ORT_API_RETURN_IF_STATUS_NOT_OK(
+      onnxruntime::training::api::SaveCheckpointAsync(*chkpt_state, checkpoint_path, include_optimizer_state));
+
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtTrainingApis::WaitForCheckpoint, _Inout_ OrtCheckpointState* checkpoint_state) {
+  API_IMPL_BEGIN
+  auto chkpt_state = reinterpret_cast<onnxruntime::training::api::CheckpointState*>(checkpoint_state);
+  ORT_API_RETURN_IF_STATUS_NOT_OK(onnxruntime::training::api::WaitForCheckpoint(*chkpt_state));
+
+  return nullptr;
+  API_IMPL_END
+}
+
 static constexpr OrtTrainingApi ort_training_api = {
     // NOTE: The C# bindings depend on the API order within this struct. Since Training APIs are not officially
     // released, it is OK to change the order here, however a corresponding matching change should also be done in the
@@ -688,7 +708,9 @@ static constexpr OrtTrainingApi ort_training_api = {
     &OrtTrainingApis::LoadCheckpointFromBuffer,
     &OrtTrainingApis::GetParameterTypeAndShape,
     &OrtTrainingApis::UpdateParameter,
-    &OrtTrainingApis::GetParameter};
+    &OrtTrainingApis::GetParameter,
+    &OrtTrainingApis::SaveCheckpointAsync,
+    &OrtTrainingApis::WaitForCheckpoint};
 
 ORT_API(const OrtTrainingApi*, OrtTrainingApis::GetTrainingApi, uint32_t) {
   // No constraints on the API version yet.
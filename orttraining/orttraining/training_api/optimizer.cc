@@ -21,6 +21,35 @@ namespace {
 constexpr char GROUP_ZERO_NAME[] = "group0";
 static constexpr std::array CommonOptimizerInputs{"learning_rate", "step", "params", "gradients"};
 
+// Returns the element type of the tensors in the sequence graph input with the given name,
+// or nullptr if the model does not specify it.
+MLDataType GetSequenceInputElementType(const InferenceSession& session, const std::string& input_name) {
+  const auto [status, inputs] = session.GetModelInputs();
+  if (!status.IsOK() || inputs == nullptr) {
+    return nullptr;
+  }
+
+  for (const NodeArg* input : *inputs) {
+    if (input->Name() != input_name) {
+      continue;
+    }
+
+    const ONNX_NAMESPACE::TypeProto* type = input->TypeAsProto();
+    if (type == nullptr || !type->has_sequence_type() || !type->sequence_type().elem_type().has_tensor_type()) {
+      return nullptr;
+    }
+
+    const auto elem_type = type->sequence_type().elem_type().tensor_type().elem_type();
+    if (elem_type == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+      return nullptr;
+    }
+
+    return DataTypeImpl::TensorTypeFromONNXEnum(elem_type)->GetElementType();
+  }
+
+  return nullptr;
+}
+
 Status GraphInputsAreExpected(gsl::span<const std::string> actual_graph_inputs,
                               gsl::span<const std::string> expected_graph_inputs) {
   const auto stringify = [](const auto& container) {
@@ -102,15 +131,27 @@ Status Optimizer::GenerateMomentumNamedStates(OptimizerCheckpointState& optimize
 
   auto& param_named_optimizer_states = optimizer_state_->param_named_optimizer_states;
   auto& optim_sess_state = optim_sess_->GetSessionState();
+
+  // The optimizer model may store the momentums in a lower precision than the parameters to save memory.
+  // Momentum i is fed to the optimizer states input i of the optimizer model.
+  InlinedVector<MLDataType> momentum_types(optimizer_algo_ptr_->momentum_keys.size(), nullptr);
+  for (size_t m_index = 0; m_index < momentum_types.size(); ++m_index) {
+    momentum_types[m_index] =
+        GetSequenceInputElementType(*optim_sess_, optimizer_algo_ptr_->optimizer_states_inputs[m_index]);
+  }
+
   for (auto& pair : state_->module_checkpoint_state.named_parameters) {
     if (pair.second->RequiresGrad()) {
       param_named_optimizer_states.insert({pair.first, ParameterOptimizerState()});
       ParameterOptimizerState& cur_param_optimizer_states = param_named_optimizer_states[pair.first];
-      for (auto& state_name : optimizer_algo_ptr_->momentum_keys) {
+      for (size_t m_index = 0; m_index < optimizer_algo_ptr_->momentum_keys.size(); ++m_index) {
+        const OrtValue& param = pair.second->Data();
+        const MLDataType element_type = momentum_types[m_index] != nullptr ? momentum_types[m_index]
+                                                                           : param.Get<Tensor>().DataType();
         OrtValue param_state;
-        ORT_ENFORCE(utils::CreateZeroValuedOrtValueLike(optim_sess_state, pair.second->Data(), param_state).IsOK(),
+        ORT_ENFORCE(utils::CreateZeroValuedOrtValueLike(optim_sess_state, param, element_type, param_state).IsOK(),
                     "Error generating moment state for ", pair.first);
-        cur_param_optimizer_states.insert({state_name, std::move(param_state)});
+        cur_param_optimizer_states.insert({optimizer_algo_ptr_->momentum_keys[m_index], std::move(param_state)});
       }
     }
   }
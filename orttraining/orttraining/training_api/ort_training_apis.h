@@ -104,4 +104,9 @@ ORT_API_STATUS_IMPL(GetParameter, _In_ const OrtCheckpointState* checkpoint_stat
                     _In_ const char* parameter_name, _Inout_ OrtAllocator* allocator,
                     _Outptr_ OrtValue** parameter);
 
+ORT_API_STATUS_IMPL(SaveCheckpointAsync, _Inout_ OrtCheckpointState* checkpoint_state,
+                    _In_ const ORTCHAR_T* checkpoint_path, const bool include_optimizer_state);
+
+ORT_API_STATUS_IMPL(WaitForCheckpoint, _Inout_ OrtCheckpointState* checkpoint_state);
+
 }  // namespace OrtTrainingApis
@@ -58,12 +58,16 @@ bool GetParamNameFromGradient(const std::string& grad_name, std::string& param_n
 }
 
 Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val) {
+  return CreateZeroValuedOrtValueLike(sess_state, input_val, input_val.template Get<Tensor>().DataType(), output_val);
+}
+
+Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val,
+                                    MLDataType element_type, OrtValue& output_val) {
   const auto& param_tensor = input_val.template Get<Tensor>();
   const TensorShape& shape = param_tensor.Shape();
   auto& tensor_location = param_tensor.Location();
   AllocatorPtr allocator = sess_state.GetAllocator(tensor_location);
 
-  auto element_type = param_tensor.DataType();
   auto p_tensor = std::make_unique<Tensor>(element_type, shape, allocator);
 
   if (tensor_location.device.Type() == OrtDevice::CPU ||
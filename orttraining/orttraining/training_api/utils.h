@@ -61,6 +61,10 @@ bool GetParamNameFromGradient(const std::string& grad_name, std::string& param_n
 // Allocate OrtValue like the input ortvalue on the same device
 Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val, OrtValue& output_val);
 
+// Allocate OrtValue with the shape of the input ortvalue on the same device, but with the given element type
+Status CreateZeroValuedOrtValueLike(const SessionState& sess_state, const OrtValue& input_val,
+                                    MLDataType element_type, OrtValue& output_val);
+
 // Create OrtValue from a single value of type T
 template <typename T>
 void WrapInOrtValue(T value,
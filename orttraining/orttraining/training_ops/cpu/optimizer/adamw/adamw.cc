@@ -1,14 +1,21 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include "orttraining/training_ops/cpu/optimizer/adamw/adamw.h"
 #include "orttraining/training_ops/cpu/optimizer/common.h"
+#include "orttraining/training_ops/cpu/optimizer/multi_tensor_apply.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -32,6 +39,14 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
   ORT_RETURN_IF_NOT(num_of_gradients == num_of_momentums_1, "Number of gradients and momentums_1 mismatch.");
   ORT_RETURN_IF_NOT(num_of_momentums_1 == num_of_momentums_2, "Number of momentums_1 and momentums_2 mismatch.");
 
+  // Weights and gradients are float. The momentums may be stored in a lower precision to save memory, which the
+  // kernels check against the precisions they support.
+  ORT_RETURN_IF_NOT(prepare.weights->DataType() == DataTypeImpl::GetType<float>() &&
+                        prepare.gradients->DataType() == DataTypeImpl::GetType<float>(),
+                    "Weights and gradients must be float tensors.");
+  ORT_RETURN_IF_NOT(prepare.momentums_1->DataType() == prepare.momentums_2->DataType(),
+                    "Type of momentums_1 and momentums_2 mismatch.");
+
   prepare.grouped_tensor_sizes.resize(prepare.num_of_weights);
   prepare.grouped_tensor_pointers.resize(prepare.num_of_weights);
 
@@ -58,10 +73,10 @@ Status AdamWOptimizerBase::PrepareForCompute(OpKernelContext* ctx, AdamWOptimize
           prepare.grouped_tensor_sizes[i] = static_cast<int>(weight_tensor.Shape().Size());
 
           prepare.grouped_tensor_pointers[i] = {
-              const_cast<float*>(weight_tensor.Data<float>()),
-              const_cast<float*>(gradient_tensor.Data<float>()),
-              const_cast<float*>(momentum_1_tensor.Data<float>()),
-              const_cast<float*>(momentum_2_tensor.Data<float>())};
+              const_cast<void*>(weight_tensor.DataRaw()),
+              const_cast<void*>(gradient_tensor.DataRaw()),
+              const_cast<void*>(momentum_1_tensor.DataRaw()),
+              const_cast<void*>(momentum_2_tensor.DataRaw())};
         }
       });
 
@@ -89,47 +104,117 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes()),
     AdamWOptimizer<float>);
 
+namespace {
+
+// The momentums are updated in float. Momentums that are stored in a lower precision are converted one tile at a
+// time, so that the conversion buffers stay in the L1 cache.
+void LoadMomentums(const MLFloat16* src, float* dst, size_t count) {
+  MlasConvertHalfToFloatBuffer(reinterpret_cast<const MLAS_FP16*>(src), dst, count);
+}
+
+void LoadMomentums(const BFloat16* src, float* dst, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = src[i].ToFloat();
+  }
+}
+
+void StoreMomentums(const float* src, MLFloat16* dst, size_t count) {
+  MlasConvertFloatToHalfBuffer(src, reinterpret_cast<MLAS_FP16*>(dst), count);
+}
+
+void StoreMomentums(const float* src, BFloat16* dst, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = BFloat16(src[i]);
+  }
+}
+
+}  // namespace
+
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float alpha_correction, float beta_correction) const {
+void AdamWOptimizer<T>::AdamWComputeMode0(T* weight, const T* gradient, T* momentums_1, T* momentums_2,
+                                          std::ptrdiff_t count, float lr, float alpha_correction,
+                                          float beta_correction) const {
+  EigenVectorArrayMap<T> w(weight, count);
+  ConstEigenVectorArrayMap<T> g(gradient, count);
+  EigenVectorArrayMap<T> m1(momentums_1, count);
+  EigenVectorArrayMap<T> m2(momentums_2, count);
+
   // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (MakeEigenArrayMap<T>(weight) * lr * weight_decay_);
+  w = w - (w * lr * weight_decay_);
 
   // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
+  m1 = alpha_ * m1 + (1.f - alpha_) * g;
 
   // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+  m2 = beta_ * m2 + (1.f - beta_) * g * g;
 
   // Compute the new weight.
-  auto denom = (MakeEigenArrayMap<T>(momentums_2) / beta_correction).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr * MakeEigenArrayMap<T>(momentums_1)) / (alpha_correction * denom);
-
-  return Status::OK();
+  auto denom = (m2 / beta_correction).sqrt() + epsilon_;
+  w = w - (lr * m1) / (alpha_correction * denom);
 }
 
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float lr_corrected) const {
+void AdamWOptimizer<T>::AdamWComputeMode1(T* weight, const T* gradient, T* momentums_1, T* momentums_2,
+                                          std::ptrdiff_t count, float lr, float lr_corrected) const {
+  EigenVectorArrayMap<T> w(weight, count);
+  ConstEigenVectorArrayMap<T> g(gradient, count);
+  EigenVectorArrayMap<T> m1(momentums_1, count);
+  EigenVectorArrayMap<T> m2(momentums_2, count);
+
   // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
+  m1 = alpha_ * m1 + (1.f - alpha_) * g;
 
   // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+  m2 = beta_ * m2 + (1.f - beta_) * g * g;
 
-  auto denom = MakeEigenArrayMap<T>(momentums_2).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr_corrected * MakeEigenArrayMap<T>(momentums_1) / denom);
+  auto denom = m2.sqrt() + epsilon_;
+  w = w - (lr_corrected * m1 / denom);
 
   // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (lr * weight_decay_ * MakeEigenArrayMap<T>(weight));
+  w = w - (lr * weight_decay_ * w);
+}
 
-  return Status::OK();
+template <typename T>
+template <typename TMoment>
+void AdamWOptimizer<T>::AdamWCompute(concurrency::ThreadPool* tp, const AdamWOptimizerBase::Prepare& p,
+                                     gsl::span<const int64_t> tensor_sizes, float lr, float alpha_correction,
+                                     float beta_correction, float lr_corrected) const {
+  const auto compute_tile = [&](T* weight, const T* gradient, T* momentums_1, T* momentums_2, std::ptrdiff_t count) {
+    if (adam_mode_ == 0) {
+      AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, count, lr, alpha_correction, beta_correction);
+    } else {
+      AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, count, lr, lr_corrected);
+    }
+  };
+
+  // Rough cost of the update of one element in cycles, including the sqrt and the division.
+  static constexpr double cost_per_element = 16.0;
+
+  MultiTensorApply(
+      tp, tensor_sizes, kMultiTensorApplyChunkSize, cost_per_element,
+      [&](size_t tensor_index, int64_t begin, int64_t end) {
+        const auto& pointers = p.grouped_tensor_pointers[tensor_index];
+        T* weight = static_cast<T*>(pointers[0]);
+        const T* gradient = static_cast<const T*>(pointers[1]);
+        TMoment* momentums_1 = static_cast<TMoment*>(pointers[2]);
+        TMoment* momentums_2 = static_cast<TMoment*>(pointers[3]);
+
+        for (int64_t tile_begin = begin; tile_begin < end; tile_begin += kMultiTensorApplyTileSize) {
+          const auto count = static_cast<std::ptrdiff_t>(std::min(kMultiTensorApplyTileSize, end - tile_begin));
+          if constexpr (std::is_same_v<TMoment, T>) {
+            compute_tile(weight + tile_begin, gradient + tile_begin, momentums_1 + tile_begin,
+                         momentums_2 + tile_begin, count);
+          } else {
+            T momentums_1_tile[kMultiTensorApplyTileSize];
+            T momentums_2_tile[kMultiTensorApplyTileSize];
+            LoadMomentums(momentums_1 + tile_begin, momentums_1_tile, static_cast<size_t>(count));
+            LoadMomentums(momentums_2 + tile_begin, momentums_2_tile, static_cast<size_t>(count));
+            compute_tile(weight + tile_begin, gradient + tile_begin, momentums_1_tile, momentums_2_tile, count);
+            StoreMomentums(momentums_1_tile, momentums_1 + tile_begin, static_cast<size_t>(count));
+            StoreMomentums(momentums_2_tile, momentums_2 + tile_begin, static_cast<size_t>(count));
+          }
+        }
+      });
 }
 
 template <typename T>
@@ -165,21 +250,22 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
     //         weight decay is applied after weight is updated.
 
+    std::vector<int64_t> tensor_sizes(p.num_of_weights);
     for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-      Tensor& momentums_1 = const_cast<Tensor&>(p.momentums_1->Get(weight_index));
-      Tensor& momentums_2 = const_cast<Tensor&>(p.momentums_2->Get(weight_index));
-
-      if (adam_mode_ == 0) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction));
-      } else if (adam_mode_ == 1) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, lr, lr_corrected));
-      } else {
-        ORT_THROW("Unsupported Adamw optimizer mode.");
-      }
+      tensor_sizes[weight_index] = p.weights->Get(weight_index).Shape().Size();
+    }
+
+    auto* tp = ctx->GetOperatorThreadPool();
+    const MLDataType moment_type = p.momentums_1->DataType();
+    if (moment_type == DataTypeImpl::GetType<T>()) {
+      AdamWCompute<T>(tp, p, tensor_sizes, lr, alpha_correction, beta_correction, lr_corrected);
+    } else if (moment_type == DataTypeImpl::GetType<MLFloat16>()) {
+      AdamWCompute<MLFloat16>(tp, p, tensor_sizes, lr, alpha_correction, beta_correction, lr_corrected);
+    } else if (moment_type == DataTypeImpl::GetType<BFloat16>()) {
+      AdamWCompute<BFloat16>(tp, p, tensor_sizes, lr, alpha_correction, beta_correction, lr_corrected);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Unsupported momentum type for AdamWOptimizer: ", DataTypeImpl::ToString(moment_type));
     }
 
     *updated_flag_ptr = true;
@@ -21,11 +21,17 @@ class AdamWOptimizer final : public OpKernel, public AdamWOptimizerBase {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float alpha_correction,
-                           float beta_correction) const;
-  Status AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2, float lr,
-                           float lr_corrected) const;
+  // Updates the momentums and weights of the whole group of tensors in chunks on the thread pool.
+  // TMoment is the type that the momentums are stored in.
+  template <typename TMoment>
+  void AdamWCompute(concurrency::ThreadPool* tp, const AdamWOptimizerBase::Prepare& p,
+                    gsl::span<const int64_t> tensor_sizes, float lr, float alpha_correction, float beta_correction,
+                    float lr_corrected) const;
+
+  void AdamWComputeMode0(T* weight, const T* gradient, T* momentums_1, T* momentums_2, std::ptrdiff_t count,
+                         float lr, float alpha_correction, float beta_correction) const;
+  void AdamWComputeMode1(T* weight, const T* gradient, T* momentums_1, T* momentums_2, std::ptrdiff_t count,
+                         float lr, float lr_corrected) const;
 };
 
 }  // namespace contrib
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Number of elements that a single task of MultiTensorApply updates.
+constexpr int64_t kMultiTensorApplyChunkSize = 65536;
+
+// Number of elements that an optimizer updates at a time within a chunk, so that the weight, gradient and optimizer
+// states of the tile stay in the L1 cache across the passes of the update.
+constexpr int64_t kMultiTensorApplyTileSize = 1024;
+
+// The CPU counterpart of launch_multi_tensor_functor for the CUDA optimizers.
+// Splits the elements of a group of tensors into chunks of at most chunk_size elements and calls
+// fn(tensor_index, begin, end) for each chunk on the thread pool. Unlike parallelizing over the tensors, a single
+// large tensor such as an embedding is spread over all the threads.
+template <typename TFunc>
+void MultiTensorApply(concurrency::ThreadPool* tp, gsl::span<const int64_t> tensor_sizes, int64_t chunk_size,
+                      double cost_per_element, TFunc&& fn) {
+  struct Chunk {
+    size_t tensor_index;
+    int64_t begin;
+    int64_t end;
+  };
+
+  std::vector<Chunk> chunks;
+  for (size_t i = 0; i < tensor_sizes.size(); ++i) {
+    for (int64_t begin = 0; begin < tensor_sizes[i]; begin += chunk_size) {
+      chunks.push_back({i, begin, std::min(begin + chunk_size, tensor_sizes[i])});
+    }
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(chunks.size()), static_cast<double>(chunk_size) * cost_per_element,
+      [&chunks, &fn](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i != last; ++i) {
+          const Chunk& chunk = chunks[static_cast<size_t>(i)];
+          fn(chunk.tensor_index, chunk.begin, chunk.end);
+        }
+      });
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
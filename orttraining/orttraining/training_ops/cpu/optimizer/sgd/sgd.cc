@@ -3,10 +3,12 @@
 
 #include "orttraining/training_ops/cpu/optimizer/sgd/sgd.h"
 #include "orttraining/training_ops/cpu/optimizer/common.h"
+#include "orttraining/training_ops/cpu/optimizer/multi_tensor_apply.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -64,15 +66,23 @@ Status SGDOptimizerV2<T>::Compute(OpKernelContext* ctx) const {
   if (update_signal == nullptr || *update_signal->template Data<bool>()) {
     const float lr = *p.learning_rate->template Data<float>();
 
+    std::vector<int64_t> tensor_sizes(p.num_of_weights);
     for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-
-      // new_weight = weight - lr * gradient
-      const auto& delta = -lr * MakeEigenArrayMap<T>(gradient);
-      MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) + delta;
+      tensor_sizes[weight_index] = p.weights->Get(weight_index).Shape().Size();
     }
 
+    static constexpr double cost_per_element = 1.0;
+    MultiTensorApply(ctx->GetOperatorThreadPool(), tensor_sizes, kMultiTensorApplyChunkSize, cost_per_element,
+                     [&p, lr](size_t tensor_index, int64_t begin, int64_t end) {
+                       const auto& pointers = p.grouped_tensor_pointers[tensor_index];
+                       const auto count = static_cast<std::ptrdiff_t>(end - begin);
+                       EigenVectorArrayMap<T> weight(static_cast<T*>(pointers[0]) + begin, count);
+                       ConstEigenVectorArrayMap<T> gradient(static_cast<const T*>(pointers[1]) + begin, count);
+
+                       // new_weight = weight - lr * gradient
+                       weight = weight - lr * gradient;
+                     });
+
     *updated_flag_ptr = true;
   } else {
     *updated_flag_ptr = false;
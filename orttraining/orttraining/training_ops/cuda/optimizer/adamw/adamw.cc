@@ -34,6 +34,8 @@ ONNX_OPERATOR_KERNEL_EX(
 Status AdamWOptimizer::ComputeInternal(OpKernelContext* ctx) const {
   AdamWOptimizerBase::Prepare p;
   ORT_RETURN_IF_ERROR(PrepareForCompute(ctx, p));
+  ORT_RETURN_IF_NOT(p.momentums_1->DataType() == DataTypeImpl::GetType<float>(),
+                    "AdamWOptimizer on CUDA only supports float momentums.");
 
   bool* updated_flag_ptr = p.updated_flag->template MutableData<bool>();
 